@@ -7,16 +7,24 @@
  * openblack is licensed under the GNU General Public License version 3.
  *******************************************************************************/
 
+#include <cinttypes>
 #include <cstdlib>
 #include <cstring>
 
 #include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <span>
 #include <stack>
 #include <string>
+#include <vector>
 
+#include <L3DCookedFile.h>
 #include <L3DFile.h>
+#include <L3DMeshOptimizer.h>
 #include <cxxopts.hpp>
+#include <zlib.h>
 
 #define TINYGLTF_IMPLEMENTATION
 #define TINYGLTF_USE_CPP14
@@ -551,6 +559,53 @@ int PrintExtraMetricsValues(openblack::l3d::L3DFile& l3d)
 	return EXIT_SUCCESS;
 }
 
+int PrintVertexStats(openblack::l3d::L3DFile& l3d)
+{
+	using openblack::l3d::L3DCookedFile;
+
+	// Cook twice to compare the original index order with the optimized one
+	L3DCookedFile original;
+	L3DCookedFile optimized;
+	auto result = original.Cook(l3d, 0, nullptr, false);
+	if (result == openblack::l3d::L3DResult::Success)
+	{
+		result = optimized.Cook(l3d, 0);
+	}
+	if (result != openblack::l3d::L3DResult::Success)
+	{
+		std::cerr << openblack::l3d::ResultToStr(result) << "\n";
+		return EXIT_FAILURE;
+	}
+
+	constexpr auto k_FullStride = static_cast<uint32_t>(sizeof(openblack::l3d::L3DCookedVertex));
+	constexpr auto k_CompactStride = static_cast<uint32_t>(sizeof(openblack::l3d::L3DCookedCompactVertex));
+	std::printf("submesh   vertices    indices  full bytes  compact bytes   saved  ACMR before  ACMR after"
+	            "  overfetch full  overfetch compact\n");
+	uint64_t totalFullBytes = 0;
+	uint64_t totalCompactBytes = 0;
+	for (uint32_t i = 0; i < optimized.GetSubmeshes().size(); ++i)
+	{
+		const auto& submesh = optimized.GetSubmeshes()[i];
+		const auto vertexCount = static_cast<uint32_t>(optimized.GetVertices(submesh).size());
+		const auto indices = optimized.GetIndices(submesh);
+		const auto originalIndices = original.GetIndices(original.GetSubmeshes()[i]);
+		const uint64_t fullBytes = static_cast<uint64_t>(vertexCount) * k_FullStride;
+		const uint64_t compactBytes = static_cast<uint64_t>(vertexCount) * k_CompactStride;
+		totalFullBytes += fullBytes;
+		totalCompactBytes += compactBytes;
+		const double saved =
+		    fullBytes == 0 ? 0.0 : 100.0 * static_cast<double>(fullBytes - compactBytes) / static_cast<double>(fullBytes);
+		std::printf("%7u %10u %10zu %11" PRIu64 " %14" PRIu64 " %6.1f%% %12.3f %11.3f %15.3f %18.3f\n", i, vertexCount,
+		            indices.size(), fullBytes, compactBytes, saved,
+		            static_cast<double>(openblack::l3d::AverageCacheMissRatio(originalIndices, vertexCount)),
+		            static_cast<double>(openblack::l3d::AverageCacheMissRatio(indices, vertexCount)),
+		            static_cast<double>(openblack::l3d::VertexFetchOverfetch(indices, vertexCount, k_FullStride)),
+		            static_cast<double>(openblack::l3d::VertexFetchOverfetch(indices, vertexCount, k_CompactStride)));
+	}
+	std::printf("total vertex bytes: full %" PRIu64 ", compact %" PRIu64 "\n", totalFullBytes, totalCompactBytes);
+	return EXIT_SUCCESS;
+}
+
 struct Arguments
 {
 	enum class Mode : uint8_t
@@ -569,8 +624,10 @@ struct Arguments
 		Uv2,
 		Name,
 		ExtraMetrics,
+		VertexStats,
 		Write,
 		Extract,
+		Cook,
 	};
 	Mode mode;
 	struct Read
@@ -587,6 +644,11 @@ struct Arguments
 		std::filesystem::path inFilename;
 		std::filesystem::path gltfFile;
 	} extract;
+	struct Cook
+	{
+		std::vector<std::filesystem::path> filenames;
+		std::filesystem::path cacheDirectory;
+	} cook;
 };
 
 namespace details
@@ -1203,6 +1265,82 @@ int ExtractFile(const Arguments::Extract& args) noexcept
 	return EXIT_SUCCESS;
 }
 
+int CookFiles(const Arguments::Cook& args) noexcept
+{
+	std::error_code ec;
+	std::filesystem::create_directories(args.cacheDirectory, ec);
+	if (ec)
+	{
+		std::cerr << "Could not create " << args.cacheDirectory.generic_string() << ": " << ec.message() << '\n';
+		return EXIT_FAILURE;
+	}
+
+	int returnCode = EXIT_SUCCESS;
+	for (const auto& filename : args.filenames)
+	{
+		std::ifstream stream(filename, std::ios::binary);
+		const std::vector<uint8_t> source((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+		if (!stream.good() && !stream.eof())
+		{
+			std::cerr << "Could not read " << filename.generic_string() << '\n';
+			returnCode = EXIT_FAILURE;
+			continue;
+		}
+
+		// Compressed meshes start with their decompressed size, the cache is keyed by the file as found on disk
+		std::vector<uint8_t> inflated;
+		std::span<const uint8_t> data = source;
+		if (filename.extension() == ".zzz" || filename.extension() == ".ZZZ")
+		{
+			uint32_t inflatedSize = 0;
+			if (source.size() < sizeof(inflatedSize))
+			{
+				std::cerr << filename.generic_string() << ": file too small\n";
+				returnCode = EXIT_FAILURE;
+				continue;
+			}
+			std::memcpy(&inflatedSize, source.data(), sizeof(inflatedSize));
+			inflated.resize(inflatedSize);
+			auto destLen = static_cast<uLongf>(inflatedSize);
+			if (uncompress(inflated.data(), &destLen, source.data() + sizeof(inflatedSize),
+			               static_cast<uLong>(source.size() - sizeof(inflatedSize))) != Z_OK ||
+			    destLen != inflatedSize)
+			{
+				std::cerr << filename.generic_string() << ": could not decompress\n";
+				returnCode = EXIT_FAILURE;
+				continue;
+			}
+			data = inflated;
+		}
+
+		openblack::l3d::L3DFile l3d;
+		auto result = l3d.Open(data);
+		if (result == openblack::l3d::L3DResult::Success)
+		{
+			// Hulls are optimized by the engine when the cooked file is loaded
+			openblack::l3d::L3DCookedFile cooked;
+			const auto sourceHash = openblack::l3d::L3DCookedFile::HashSource(source);
+			result = cooked.Cook(l3d, sourceHash);
+			if (result == openblack::l3d::L3DResult::Success)
+			{
+				const auto outFilename = args.cacheDirectory / openblack::l3d::L3DCookedFile::GetCacheFilename(sourceHash);
+				result = cooked.Write(outFilename);
+				if (result == openblack::l3d::L3DResult::Success)
+				{
+					std::printf("%s -> %s\n", filename.generic_string().c_str(), outFilename.generic_string().c_str());
+				}
+			}
+		}
+		if (result != openblack::l3d::L3DResult::Success)
+		{
+			std::cerr << filename.generic_string() << ": " << openblack::l3d::ResultToStr(result) << '\n';
+			returnCode = EXIT_FAILURE;
+		}
+	}
+
+	return returnCode;
+}
+
 bool parseOptions(int argc, char** argv, Arguments& args, int& returnCode) noexcept
 {
 	cxxopts::Options options("l3dtool", "Inspect and extract files from LionHead L3D files.");
@@ -1211,7 +1349,7 @@ bool parseOptions(int argc, char** argv, Arguments& args, int& returnCode) noexc
 	    ("h,help", "Display this help message.")                     //
 	    ("subcommand", "Subcommand.", cxxopts::value<std::string>()) //
 	    ;
-	options.positional_help("[read|write|extract] [OPTION...]");
+	options.positional_help("[read|write|extract|cook] [OPTION...]");
 	options.add_options("read")                                                                                       //
 	    ("H,header", "Print Header Contents.", cxxopts::value<std::vector<std::filesystem::path>>())                  //
 	    ("m,mesh-header", "Print Mesh Headers.", cxxopts::value<std::vector<std::filesystem::path>>())                //
@@ -1227,11 +1365,17 @@ bool parseOptions(int argc, char** argv, Arguments& args, int& returnCode) noexc
 	    ("f,footprint-data", "Print Footprint Data.", cxxopts::value<std::vector<std::string>>())                     //
 	    ("n,name-data", "Print Name Data.", cxxopts::value<std::vector<std::string>>())                               //
 	    ("extra-metrics", "Print Extra Metrics.", cxxopts::value<std::vector<std::string>>())                         //
+	    ("vertex-stats", "Print vertex sizes and index order quality of the cooked submeshes.",                       //
+	     cxxopts::value<std::vector<std::filesystem::path>>())                                                        //
 	    ;
 	options.add_options("write/extract from and to glTF format")                            //
 	    ("o,output", "Output file (required).", cxxopts::value<std::filesystem::path>())    //
 	    ("i,input-mesh", "Input file (required).", cxxopts::value<std::filesystem::path>()) //
 	    ;
+	options.add_options("cook meshes into the engine's mesh cache")                                                //
+	    ("c,cook", "L3D or ZZZ files to cook (required).", cxxopts::value<std::vector<std::filesystem::path>>())    //
+	    ("d,cache-dir", "Mesh cache directory (required).", cxxopts::value<std::filesystem::path>())                //
+	    ;
 
 	options.parse_positional({"subcommand"});
 
@@ -1334,6 +1478,12 @@ bool parseOptions(int argc, char** argv, Arguments& args, int& returnCode) noexc
 			args.read.filenames = result["extra-metrics"].as<std::vector<std::filesystem::path>>();
 			return true;
 		}
+		if (result["vertex-stats"].count() > 0)
+		{
+			args.mode = Arguments::Mode::VertexStats;
+			args.read.filenames = result["vertex-stats"].as<std::vector<std::filesystem::path>>();
+			return true;
+		}
 	}
 	else if (result["subcommand"].as<std::string>() == "write")
 	{
@@ -1364,6 +1514,17 @@ bool parseOptions(int argc, char** argv, Arguments& args, int& returnCode) noexc
 		}
 	}
 
+	else if (result["subcommand"].as<std::string>() == "cook")
+	{
+		if (result["cook"].count() > 0 && result["cache-dir"].count() > 0)
+		{
+			args.mode = Arguments::Mode::Cook;
+			args.cook.filenames = result["cook"].as<std::vector<std::filesystem::path>>();
+			args.cook.cacheDirectory = result["cache-dir"].as<std::filesystem::path>();
+			return true;
+		}
+	}
+
 	std::cerr << options.help() << '\n';
 	returnCode = EXIT_FAILURE;
 	return false;
@@ -1388,6 +1549,11 @@ int main(int argc, char* argv[]) noexcept
 		return ExtractFile(args.extract);
 	}
 
+	if (args.mode == Arguments::Mode::Cook)
+	{
+		return CookFiles(args.cook);
+	}
+
 	for (auto& filename : args.read.filenames)
 	{
 		openblack::l3d::L3DFile l3d;
@@ -1459,6 +1625,10 @@ int main(int argc, char* argv[]) noexcept
 			std::printf("file: %s\n", filename.generic_string().c_str());
 			returnCode |= PrintExtraMetricsValues(l3d);
 			break;
+		case Arguments::Mode::VertexStats:
+			std::printf("file: %s\n", filename.generic_string().c_str());
+			returnCode |= PrintVertexStats(l3d);
+			break;
 		default:
 			returnCode = EXIT_FAILURE;
 			break;
@@ -9,11 +9,14 @@
 
 #include <cstdlib>
 
+#include <chrono>
 #include <format>
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <vector>
 
+#include <LHVM.h>
 #include <LHVMFile.h>
 #include <cxxopts.hpp>
 
@@ -34,7 +37,8 @@ struct Arguments
 		Stack,
 		VarValues,
 		Tasks,
-		RuntimeInfo
+		RuntimeInfo,
+		Benchmark
 	};
 	Mode mode {Mode::Header};
 	struct Read
@@ -42,6 +46,10 @@ struct Arguments
 		std::filesystem::path filename;
 		std::string objName;
 	} read;
+	struct Benchmark
+	{
+		uint32_t iterations;
+	} benchmark;
 };
 
 int PrintInfo(const LHVMFile& file)
@@ -479,6 +487,55 @@ int PrintRuntimeInfo(const LHVMFile& file)
 	return EXIT_SUCCESS;
 }
 
+int Benchmark(const std::filesystem::path& filename, uint32_t iterations)
+{
+	std::ifstream stream(filename, std::ios::binary | std::ios::ate);
+	if (!stream.is_open() || iterations == 0)
+	{
+		return EXIT_FAILURE;
+	}
+	std::vector<uint8_t> buffer(static_cast<size_t>(stream.tellg()));
+	stream.seekg(0);
+	stream.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+
+	using Clock = std::chrono::steady_clock;
+	const auto report = [iterations](const char* name, Clock::duration time) {
+		const auto microseconds = std::chrono::duration_cast<std::chrono::duration<double, std::micro>>(time).count();
+		std::printf("%-16s %12.1f us/iteration\n", name, microseconds / iterations);
+	};
+
+	bool hasStatus = false;
+	auto start = Clock::now();
+	for (uint32_t i = 0; i < iterations; ++i)
+	{
+		LHVMFile file;
+		file.Open(buffer);
+		if (!file.IsLoaded())
+		{
+			std::fprintf(stderr, "Could not parse %s\n", filename.string().c_str());
+			return EXIT_FAILURE;
+		}
+		hasStatus = file.HasStatus();
+	}
+	report("Parse", Clock::now() - start);
+
+	// Load runs the autostart scripts of a CHL, restore rebuilds the tasks of a SAV
+	LHVM vm;
+	start = Clock::now();
+	for (uint32_t i = 0; i < iterations; ++i)
+	{
+		if ((hasStatus ? vm.RestoreState(buffer) : vm.LoadBinary(buffer)) != EXIT_SUCCESS)
+		{
+			return EXIT_FAILURE;
+		}
+	}
+	report(hasStatus ? "Restore" : "Load", Clock::now() - start);
+	std::printf("%zu bytes, %zu instructions, %zu scripts, %zu tasks\n", buffer.size(), vm.GetInstructions().size(),
+	            vm.GetScripts().size(), vm.GetTasks().size());
+
+	return EXIT_SUCCESS;
+}
+
 bool parseOptions(int argc, char** argv, Arguments& args, int& returnCode) noexcept
 {
 	cxxopts::Options options("lhvmtool", "Inspect and extract files from LionHead Virtual Machine files.");
@@ -487,7 +544,7 @@ bool parseOptions(int argc, char** argv, Arguments& args, int& returnCode) noexc
 	    ("h,help", "Display this help message.")                     //
 	    ("subcommand", "Subcommand.", cxxopts::value<std::string>()) //
 	    ;
-	options.positional_help("[read] [OPTION...]");
+	options.positional_help("[read|benchmark] [OPTION...]");
 	options.add_options("read")                                                     //
 	    ("I,info", "Print info.", cxxopts::value<std::string>())                    //
 	    ("A,all", "Print all relevant data.", cxxopts::value<std::string>())        //
@@ -503,6 +560,11 @@ bool parseOptions(int argc, char** argv, Arguments& args, int& returnCode) noexc
 	    ("R,rtinfo", "Print runtime info.", cxxopts::value<std::string>())          //
 	    ("n,name", "Object name", cxxopts::value<std::string>()->default_value("")) //
 	    ;
+	options.add_options("benchmark")                                                                      //
+	    ("f,file", "Time parsing and loading of a CHL, or restoring of a SAV.", cxxopts::value<std::string>()) //
+	    ("i,iterations", "Number of times each step is repeated.",
+	     cxxopts::value<uint32_t>()->default_value("100")) //
+	    ;
 
 	options.parse_positional({"subcommand"});
 	auto result = options.parse(argc, argv);
@@ -595,6 +657,16 @@ bool parseOptions(int argc, char** argv, Arguments& args, int& returnCode) noexc
 			return true;
 		}
 	}
+	if (result["subcommand"].as<std::string>() == "benchmark")
+	{
+		if (result["file"].count() > 0)
+		{
+			args.mode = Arguments::Mode::Benchmark;
+			args.read.filename = result["file"].as<std::string>();
+			args.benchmark.iterations = result["iterations"].as<uint32_t>();
+			return true;
+		}
+	}
 	std::cerr << options.help() << '\n';
 	returnCode = EXIT_FAILURE;
 	return false;
@@ -609,9 +681,15 @@ int main(int argc, char* argv[]) noexcept
 		return returnCode;
 	}
 
-	LHVMFile file;
 	std::printf("Filename: %s\n", args.read.filename.string().c_str());
 
+	if (args.mode == Arguments::Mode::Benchmark)
+	{
+		return Benchmark(args.read.filename, args.benchmark.iterations);
+	}
+
+	LHVMFile file;
+
 	// Open file
 	file.Open(args.read.filename);
 
@@ -10,13 +10,18 @@
 #include <cassert>
 #include <cstdlib>
 
+#include <algorithm>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <limits>
 #include <string>
+#include <system_error>
 
+#include <AssetArchive.h>
 #include <PackFile.h>
 #include <cxxopts.hpp>
+#include <zlib.h>
 
 int PrintRawBytes(const void* data, std::size_t size)
 {
@@ -394,6 +399,104 @@ int WriteSoundFile(const std::filesystem::path& outFilename) noexcept
 	return EXIT_SUCCESS;
 }
 
+int WriteArchive(const std::filesystem::path& outFilename, const std::filesystem::path& gamePath, bool compress) noexcept
+{
+	using openblack::pack::AssetArchiveResult;
+	using openblack::pack::AssetCompression;
+
+	std::error_code ec;
+	std::vector<std::filesystem::path> filenames;
+	for (auto iter = std::filesystem::recursive_directory_iterator(gamePath, ec);
+	     !ec && iter != std::filesystem::recursive_directory_iterator(); iter.increment(ec))
+	{
+		if (iter->is_regular_file(ec))
+		{
+			filenames.push_back(iter->path());
+		}
+	}
+	if (ec)
+	{
+		std::fprintf(stderr, "Could not list game directory \"%s\": %s\n", gamePath.string().c_str(), ec.message().c_str());
+		return EXIT_FAILURE;
+	}
+	// The same directory always gives the same archive
+	std::sort(filenames.begin(), filenames.end());
+
+	openblack::pack::AssetArchiveWriter writer;
+	auto result = writer.Open(outFilename);
+	uint64_t totalSize = 0;
+	uint64_t storedSize = 0;
+	for (const auto& filename : filenames)
+	{
+		std::ifstream file(filename, std::ios::binary);
+		const auto size = std::filesystem::file_size(filename, ec);
+		if (!file.is_open() || ec)
+		{
+			std::fprintf(stderr, "Could not open source file \"%s\"\n", filename.string().c_str());
+			return EXIT_FAILURE;
+		}
+		std::vector<uint8_t> data(static_cast<size_t>(size));
+		file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+		if (!file)
+		{
+			// The writer removes the unfinished archive
+			std::fprintf(stderr, "Could not read source file \"%s\"\n", filename.string().c_str());
+			return EXIT_FAILURE;
+		}
+
+		const auto name = filename.lexically_relative(gamePath).generic_string();
+		std::vector<uint8_t> deflated;
+		if (compress && !data.empty())
+		{
+			auto deflatedSize = compressBound(static_cast<uLong>(data.size()));
+			deflated.resize(deflatedSize);
+			if (compress2(deflated.data(), &deflatedSize, data.data(), static_cast<uLong>(data.size()), Z_BEST_COMPRESSION) ==
+			    Z_OK)
+			{
+				deflated.resize(deflatedSize);
+			}
+			else
+			{
+				deflated.clear();
+			}
+		}
+
+		// Leave entries which barely shrink uncompressed so they can be read without a copy
+		if (!deflated.empty() && deflated.size() < data.size() - data.size() / 10)
+		{
+			result = writer.Add(name, deflated, AssetCompression::Zlib, data.size());
+			storedSize += deflated.size();
+		}
+		else
+		{
+			result = writer.Add(name, data, AssetCompression::None, data.size());
+			storedSize += data.size();
+		}
+		totalSize += data.size();
+
+		if (result != AssetArchiveResult::Success)
+		{
+			break;
+		}
+	}
+	if (result == AssetArchiveResult::Success)
+	{
+		result = writer.Finish();
+	}
+	if (result != AssetArchiveResult::Success)
+	{
+		std::fprintf(stderr, "Could not write archive \"%s\": %s\n", outFilename.string().c_str(),
+		             std::string(openblack::pack::ResultToStr(result)).c_str());
+		return EXIT_FAILURE;
+	}
+
+	std::printf("%u files, %llu bytes stored as %llu bytes in %s\n", static_cast<uint32_t>(filenames.size()),
+	            static_cast<unsigned long long>(totalSize), static_cast<unsigned long long>(storedSize),
+	            outFilename.string().c_str());
+
+	return EXIT_SUCCESS;
+}
+
 struct Arguments
 {
 	enum class Mode : uint8_t
@@ -414,12 +517,14 @@ struct Arguments
 		WriteRaw,
 		WriteMeshPack,
 		WriteAnimationPack,
+		WriteArchive,
 	};
 	std::vector<std::filesystem::path> filenames;
 	Mode mode;
 	std::string block;
 	uint32_t blockId;
 	std::filesystem::path outFilename;
+	bool compress;
 };
 
 std::string parseRange(std::string range, uint32_t currentSize, uint32_t& start, uint32_t& length)
@@ -495,6 +600,9 @@ bool parseOptions(int argc, char** argv, Arguments& args, int& returnCode) noexc
 	    ("write-mesh", "Create Mesh Pack (file.l3d[[:START]:LENGTH]...).",                                  //
 	     cxxopts::value<std::filesystem::path>())                                                           //
 	    ("write-animation", "Create Mesh Pack.", cxxopts::value<std::filesystem::path>())                   //
+	    ("write-archive", "Create Asset Archive of a game directory, used with -g.",                        //
+	     cxxopts::value<std::filesystem::path>())                                                           //
+	    ("archive-compress", "Compress the entries of the Asset Archive with zlib.")                        //
 	    ("pack-files", "Pack Files.", cxxopts::value<std::vector<std::filesystem::path>>())                 //
 	    ;
 
@@ -522,6 +630,20 @@ bool parseOptions(int argc, char** argv, Arguments& args, int& returnCode) noexc
 		returnCode = EXIT_FAILURE;
 		return false;
 	}
+	if (result["write-archive"].count() > 0)
+	{
+		args.mode = Arguments::Mode::WriteArchive;
+		args.outFilename = result["write-archive"].as<std::filesystem::path>();
+		args.filenames = result["pack-files"].as<std::vector<std::filesystem::path>>();
+		args.compress = result["archive-compress"].as<bool>();
+		if (args.filenames.size() != 1)
+		{
+			std::cerr << "Option \"write-archive\" takes a single game directory\n";
+			returnCode = EXIT_FAILURE;
+			return false;
+		}
+		return true;
+	}
 	if (result["write-mesh"].count() > 0)
 	{
 		args.mode = Arguments::Mode::WriteMeshPack;
@@ -695,6 +817,11 @@ int main(int argc, char* argv[]) noexcept
 		return WriteAnimationFile(args.outFilename);
 	}
 
+	if (args.mode == Arguments::Mode::WriteArchive)
+	{
+		return WriteArchive(args.outFilename, args.filenames.front(), args.compress);
+	}
+
 	for (auto& filename : args.filenames)
 	{
 		openblack::pack::PackFile pack;
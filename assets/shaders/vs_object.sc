@@ -18,6 +18,19 @@ SAMPLER2D(s_heightmap, 1);
 uniform vec4 u_islandExtent;
 #endif // USE_HEIGHT_MAP
 
+#ifdef USE_COMPACT_VERTICES
+// Position offset, position scale and texture coordinate offset and scale of the submesh
+uniform vec4 u_vertexDecode[3];
+
+vec3 decodeOctahedral(vec2 e)
+{
+	vec3 n = vec3(e, 1.0f - abs(e.x) - abs(e.y));
+	float t = max(-n.z, 0.0f);
+	n.xy += mix(vec2_splat(t), vec2_splat(-t), step(vec2_splat(0.0f), n.xy));
+	return normalize(n);
+}
+#endif // USE_COMPACT_VERTICES
+
 void main()
 {
 	// Unpack
@@ -32,7 +45,17 @@ void main()
 	uint modelIndex = uint(max(0, a_indices.x));
 #endif
 
-	v_position = mul(u_model[modelIndex], vec4(a_position.xyz, 1.0f));
+#ifdef USE_COMPACT_VERTICES
+	vec3 position = u_vertexDecode[0].xyz + a_position.xyz * u_vertexDecode[1].xyz;
+	vec2 texcoord = u_vertexDecode[2].xy + a_texcoord0 * u_vertexDecode[2].zw;
+	vec3 normal = decodeOctahedral(a_normal.xy);
+#else
+	vec3 position = a_position.xyz;
+	vec2 texcoord = a_texcoord0;
+	vec3 normal = a_normal;
+#endif // USE_COMPACT_VERTICES
+
+	v_position = mul(u_model[modelIndex], vec4(position, 1.0f));
 
 #ifdef USE_INSTANCING
 	mat4 model;
@@ -55,7 +78,7 @@ void main()
 	v_position.y += terrain_height - original_height;
 #endif // USE_HEIGHT_MAP
 
-	v_texcoord0 = vec4(a_texcoord0, 0.0f, 0.0f);
-	v_normal = a_normal;
+	v_texcoord0 = vec4(texcoord, 0.0f, 0.0f);
+	v_normal = normal;
 	gl_Position = mul(u_viewProj, v_position);
 }
@@ -0,0 +1,3 @@
+#define USE_COMPACT_VERTICES 1
+
+#include "vs_object_hm_instanced.sc"
@@ -15,10 +15,17 @@
 #include <filesystem>
 #include <functional>
 #include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <span>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "LHVMFile.h"
+#include "LHVMProfiler.h"
 
 namespace openblack::lhvm
 {
@@ -27,6 +34,18 @@ class LHVM
 {
 protected:
 	static constexpr const std::array<char, 4> k_Magic = {'L', 'H', 'V', 'M'};
+	static constexpr const size_t k_TimerWheelSize = 256;
+
+	/// A task taken off the ready list until it can make progress again
+	struct ParkedTask
+	{
+		/// Turns allowed for the task type when it was parked, the difference is added to its ticks when it resumes
+		uint32_t allowedTurns;
+		/// Turns a sleeping task would spend evaluating its sleep to false
+		uint32_t sleepTurns;
+		/// Turn of the timer wheel slot holding a sleeping task
+		uint32_t wakeTurn;
+	};
 
 	std::vector<std::string> _variablesNames;
 	std::vector<VMInstruction> _instructions;
@@ -44,6 +63,22 @@ class LHVM
 	uint32_t _highestScriptId {0};
 	uint32_t _executedInstructions {0};
 
+	// Scheduler, LookIn only visits the ready tasks while sleeping and waiting tasks are parked
+	std::set<uint32_t> _readyTasks;
+	std::unordered_map<uint32_t, ParkedTask> _parkedTasks;
+	/// Waiting tasks by the task they are waiting for
+	std::unordered_map<uint32_t, std::vector<uint32_t>> _waitingTasks;
+	/// Waiting tasks whose awaited task has stopped, resumed by the next turn allowing their type
+	std::vector<uint32_t> _unblockedTasks;
+	std::vector<uint32_t> _stoppedTasks;
+	/// Sleeping tasks by the turn they are due, in slot turn % k_TimerWheelSize
+	std::array<std::vector<std::pair<uint32_t, uint32_t>>, k_TimerWheelSize> _timerWheel;
+	/// Number of turns which allowed each script type to run
+	std::map<ScriptType, uint32_t> _allowedTurns;
+	/// Task whose normal code is being run by LookIn, all tasks before it are done with their turn
+	uint32_t _lookInTaskId {0};
+	ScriptType _lookInMask {ScriptType::None};
+
 	const std::vector<NativeFunction>* _functions {nullptr};
 	std::function<void(const uint32_t func)> _nativeCallEnterCallback;
 	std::function<void(const uint32_t func)> _nativeCallExitCallback;
@@ -51,6 +86,7 @@ class LHVM
 	std::function<void(const ErrorCode code, const std::string v0, const uint32_t v1)> _errorCallback;
 	std::function<void(const uint32_t objId)> _addReference;
 	std::function<void(const uint32_t objId)> _removeReference;
+	std::unique_ptr<LHVMProfiler> _profiler;
 
 	std::array<void (LHVM::*)(VMTask& task, const VMInstruction& instruction), static_cast<size_t>(Opcode::_Count)>
 	    _opcodesImpl {};
@@ -109,6 +145,15 @@ class LHVM
 	void PrintInstruction(const VMTask& task, const VMInstruction& instruction);
 	void CpuLoop(VMTask& task);
 
+	void ResetScheduler();
+	uint32_t NextReadyTask(uint32_t taskId) const;
+	std::optional<uint32_t> GetSleepLoopDuration(const VMTask& task) const;
+	void ParkTask(VMTask& task, uint32_t sleepTurns);
+	void ResumeTask(VMTask& task);
+	void CatchUpParkedTask(VMTask& task, ParkedTask& parked);
+	void WakeSleepingTasks();
+	void SettleParkedTasks();
+
 	static float Fmod(float a, float b);
 
 public:
@@ -126,13 +171,23 @@ class LHVM
 	/// Read CHL file from the filesystem
 	int LoadBinary(const std::filesystem::path& filepath);
 
-	int LoadBinary(const std::vector<uint8_t>& buffer);
+	/// Read CHL file from a buffer, such as a file mapped in memory
+	int LoadBinary(std::span<const uint8_t> buffer);
 
 	int LoadBinary(const LHVMFile& file);
 
+	/// Take the code and data of a parsed CHL file without copying them
+	int LoadBinary(LHVMFile&& file);
+
 	/// Read SAV file from the filesystem
 	int RestoreState(const std::filesystem::path& filepath);
 
+	/// Read SAV file from a buffer, such as a file mapped in memory
+	int RestoreState(std::span<const uint8_t> buffer);
+
+	/// Take the code, data and tasks of a parsed SAV file without copying them
+	int RestoreState(LHVMFile&& file);
+
 	VMValue Pop(DataType& type);
 	VMValue Pop();
 	float Popf();
@@ -151,6 +206,9 @@ class LHVM
 	/// Write SAV file to filesystem
 	int SaveState(const std::filesystem::path& filepath);
 
+	/// Copy the code, data and tasks as they would be written to a SAV file, to be given back to RestoreState
+	[[nodiscard]] LHVMFile SaveState();
+
 	void LookIn(ScriptType allowedScriptTypesMask);
 
 	uint32_t StartScript(const std::string& name, ScriptType allowedScriptTypesMask);
@@ -163,12 +221,18 @@ class LHVM
 
 	void StopTasksOfType(ScriptType typesMask);
 
+	/// Measure the time spent in each script, task and native function, disabling drops the measures
+	void SetProfilerEnabled(bool enabled);
+	[[nodiscard]] LHVMProfiler* GetProfiler() { return _profiler.get(); }
+	[[nodiscard]] const LHVMProfiler* GetProfiler() const { return _profiler.get(); }
+
 	[[nodiscard]] std::string GetString(uint32_t offset);
 	[[nodiscard]] const std::vector<NativeFunction>* GetFunctions() const { return _functions; };
 
 	[[nodiscard]] const std::vector<VMVar>& GetVariables() const { return _variables; }
 	[[nodiscard]] const std::vector<VMInstruction>& GetInstructions() const { return _instructions; }
 	[[nodiscard]] const std::vector<VMScript>& GetScripts() const { return _scripts; }
+	/// The ticks and stack counters of sleeping and waiting tasks are brought up to date when they resume or the state is saved
 	[[nodiscard]] const std::map<uint32_t, VMTask>& GetTasks() const { return _tasks; }
 	[[nodiscard]] const std::vector<char>& GetData() const { return _data; }
 };
@@ -13,6 +13,7 @@
 
 #include <array>
 #include <filesystem>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -45,21 +46,25 @@ class LHVMFile
 	uint32_t _highestScriptId {0};
 	uint32_t _executedInstructions {0};
 
-	/// Read file from the input source
-	void ReadFile(std::istream& stream);
-
-	int LoadVariablesNames(std::istream& stream, std::vector<std::string>& variables);
-	int LoadCode(std::istream& stream);
-	int LoadAuto(std::istream& stream);
-	int LoadScripts(std::istream& stream);
-	int LoadScript(std::istream& stream, VMScript& script);
-	int LoadData(std::istream& stream);
-	int LoadStatus(std::istream& stream);
-	int LoadStack(std::istream& stream, VMStack& stack);
-	int LoadVariableValues(std::istream& stream, std::vector<VMVar>& variables);
-	int LoadTasks(std::istream& stream);
-	int LoadTask(std::istream& stream, VMTask& task);
-	int LoadRuntimeInfo(std::istream& stream);
+	/// Parse the whole file held in memory
+	void ReadFile(std::span<const uint8_t> stream);
+
+	// Each block is parsed from the front of the stream, which is then advanced past it
+	int LoadVariablesNames(std::span<const uint8_t>& stream, std::vector<std::string>& variables);
+	int LoadCode(std::span<const uint8_t>& stream);
+	int LoadAuto(std::span<const uint8_t>& stream);
+	int LoadScripts(std::span<const uint8_t>& stream);
+	int LoadScript(std::span<const uint8_t>& stream, VMScript& script);
+	int LoadData(std::span<const uint8_t>& stream);
+	int LoadStatus(std::span<const uint8_t>& stream);
+	int LoadStack(std::span<const uint8_t>& stream, VMStack& stack);
+	int LoadVariableValues(std::span<const uint8_t>& stream, std::vector<VMVar>& variables);
+	int LoadTasks(std::span<const uint8_t>& stream);
+	int LoadTask(std::span<const uint8_t>& stream, VMTask& task);
+	int LoadRuntimeInfo(std::span<const uint8_t>& stream);
+
+	/// Takes the contents of the file by move
+	friend class LHVM;
 
 public:
 	LHVMFile();
@@ -79,8 +84,8 @@ class LHVMFile
 	/// Read lhvm file from the filesystem
 	void Open(const std::filesystem::path& filepath);
 
-	/// Read lhvm file from a buffer
-	void Open(const std::vector<uint8_t>& buffer);
+	/// Read lhvm file from a buffer, such as a file mapped in memory, which is not referenced once parsed
+	void Open(std::span<const uint8_t> buffer);
 
 	void Write(const std::filesystem::path& filepath);
 
@@ -0,0 +1,71 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <chrono>
+#include <map>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "LHVMTypes.h"
+
+namespace openblack::lhvm
+{
+
+/// Scoped timing of the time spent running each script, task and native function
+class LHVMProfiler
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	struct Entry
+	{
+		/// Number of times the task was given the cpu or the native function was called
+		uint32_t calls {0};
+		uint64_t instructions {0};
+		/// Total time, including native functions called by scripts
+		Clock::duration time {0};
+		/// Part of the time spent in native functions
+		Clock::duration nativeTime {0};
+
+		[[nodiscard]] Clock::duration SelfTime() const { return time - nativeTime; }
+	};
+
+	void Reset();
+
+	void AddTaskRun(const VMTask& task, uint32_t instructions, Clock::duration time);
+	void AddNativeCall(const VMTask* task, uint32_t function, Clock::duration time);
+
+	/// By script id
+	[[nodiscard]] const std::map<uint32_t, Entry>& GetScripts() const { return _scripts; }
+	/// By task id, each task is also counted in its script
+	[[nodiscard]] const std::map<uint32_t, Entry>& GetTasks() const { return _tasks; }
+	/// By native function id
+	[[nodiscard]] const std::map<uint32_t, Entry>& GetNativeFunctions() const { return _nativeFunctions; }
+	[[nodiscard]] uint32_t GetTurns() const { return _turns; }
+	void AddTurn() { ++_turns; }
+
+	/// Write "script;native microseconds" lines, the collapsed stacks format read by flamegraph tools
+	void WriteCollapsedStacks(std::ostream& stream, const std::vector<VMScript>& scripts,
+	                          const std::vector<NativeFunction>* functions) const;
+
+private:
+	std::map<uint32_t, Entry> _scripts;
+	std::map<uint32_t, Entry> _tasks;
+	std::map<uint32_t, Entry> _nativeFunctions;
+	/// Native functions by the script calling them, script id 0 is for calls made outside of any task
+	std::map<std::pair<uint32_t, uint32_t>, Entry> _nativeCallers;
+	uint32_t _turns {0};
+};
+
+} // namespace openblack::lhvm
@@ -14,53 +14,13 @@
 #include <cstdlib>
 #include <cstring>
 
-#include <fstream>
+#include <algorithm>
 #include <stdexcept>
 
 #include "LHVMFile.h"
 
 namespace openblack::lhvm
 {
-// Adapted from https://stackoverflow.com/a/13059195/10604387
-//          and https://stackoverflow.com/a/46069245/10604387
-struct membuf: std::streambuf
-{
-	membuf(char const* base, size_t size)
-	{
-		char* p(const_cast<char*>(base));
-		this->setg(p, p, p + size);
-	}
-	std::streampos seekoff(off_type off, std::ios_base::seekdir way, [[maybe_unused]] std::ios_base::openmode which) override
-	{
-		if (way == std::ios_base::cur)
-		{
-			gbump(static_cast<int>(off));
-		}
-		else if (way == std::ios_base::end)
-		{
-			setg(eback(), egptr() + off, egptr());
-		}
-		else if (way == std::ios_base::beg)
-		{
-			setg(eback(), eback() + off, egptr());
-		}
-		return gptr() - eback();
-	}
-
-	std::streampos seekpos([[maybe_unused]] pos_type pos, [[maybe_unused]] std::ios_base::openmode which) override
-	{
-		return seekoff(pos - static_cast<off_type>(0), std::ios_base::beg, which);
-	}
-};
-struct imemstream: virtual membuf, std::istream
-{
-	imemstream(char const* base, size_t size)
-	    : membuf(base, size)
-	    , std::istream(dynamic_cast<std::streambuf*>(this))
-	{
-	}
-};
-
 LHVM::LHVM()
 {
 	_currentStack = &_mainStack;
@@ -121,17 +81,22 @@ int LHVM::LoadBinary(const std::filesystem::path& filepath)
 {
 	LHVMFile file;
 	file.Open(filepath);
-	return LoadBinary(file);
+	return LoadBinary(std::move(file));
 }
 
-int LHVM::LoadBinary(const std::vector<uint8_t>& buffer)
+int LHVM::LoadBinary(std::span<const uint8_t> buffer)
 {
 	LHVMFile file;
 	file.Open(buffer);
-	return LoadBinary(file);
+	return LoadBinary(std::move(file));
 }
 
 int LHVM::LoadBinary(const LHVMFile& file)
+{
+	return LoadBinary(LHVMFile(file));
+}
+
+int LHVM::LoadBinary(LHVMFile&& file)
 {
 	if (!file.IsLoaded() || file.HasStatus())
 	{
@@ -140,15 +105,15 @@ int LHVM::LoadBinary(const LHVMFile& file)
 
 	StopAllTasks();
 
-	_instructions = file.GetInstructions();
-	_scripts = file.GetScripts();
-	_data = file.GetData();
+	_instructions = std::move(file._instructions);
+	_scripts = std::move(file._scripts);
+	_data = std::move(file._data);
 	_mainStack.count = 0;
 	_mainStack.pushCount = 0;
 	_mainStack.popCount = 0;
 	_currentStack = &_mainStack;
 
-	_variablesNames = file.GetVariablesNames();
+	_variablesNames = std::move(file._variablesNames);
 	_variables.clear();
 	_variables.reserve(_variablesNames.size() + 1);
 	_variables.emplace_back(DataType::Float, VMValue(0.0f), "Null variable");
@@ -163,8 +128,9 @@ int LHVM::LoadBinary(const LHVMFile& file)
 	_highestTaskId = 0;
 	_highestScriptId = _scripts.size();
 	_executedInstructions = 0;
+	ResetScheduler();
 
-	_auto = file.GetAutostart();
+	_auto = std::move(file._autostart);
 	for (const auto scriptId : _auto)
 	{
 		if (scriptId > 0 && scriptId <= _scripts.size())
@@ -183,8 +149,20 @@ int LHVM::LoadBinary(const LHVMFile& file)
 
 int LHVM::RestoreState(const std::filesystem::path& filepath)
 {
-	auto file = LHVMFile();
+	LHVMFile file;
 	file.Open(filepath);
+	return RestoreState(std::move(file));
+}
+
+int LHVM::RestoreState(std::span<const uint8_t> buffer)
+{
+	LHVMFile file;
+	file.Open(buffer);
+	return RestoreState(std::move(file));
+}
+
+int LHVM::RestoreState(LHVMFile&& file)
+{
 	if (!file.IsLoaded() || !file.HasStatus())
 	{
 		return EXIT_FAILURE;
@@ -192,27 +170,29 @@ int LHVM::RestoreState(const std::filesystem::path& filepath)
 
 	StopAllTasks();
 
-	_instructions = file.GetInstructions();
-	_scripts = file.GetScripts();
-	_data = file.GetData();
-	_mainStack = file.GetStack();
+	_instructions = std::move(file._instructions);
+	_scripts = std::move(file._scripts);
+	_data = std::move(file._data);
+	_mainStack = file._stack;
 	_currentStack = &_mainStack;
-	_variablesNames = file.GetVariablesNames();
-	_variables = file.GetVariablesValues();
+	_variablesNames = std::move(file._variablesNames);
+	_variables = std::move(file._variableValues);
 
-	_auto = file.GetAutostart();
+	_auto = std::move(file._autostart);
 
 	_tasks.clear();
-	for (const auto& task : file.GetTasks())
+	for (auto& task : file._tasks)
 	{
-		_tasks.emplace(task.id, task);
+		const auto id = task.id;
+		_tasks.emplace(id, std::move(task));
 	}
 
-	_ticks = file.GetTicks();
-	_currentLineNumber = file.GetCurrentLineNumber();
-	_highestTaskId = file.GetHighestTaskId();
-	_highestScriptId = file.GetHighestScriptId();
-	_executedInstructions = file.GetExecutedInstructions();
+	_ticks = file._ticks;
+	_currentLineNumber = file._currentLineNumber;
+	_highestTaskId = file._highestTaskId;
+	_highestScriptId = file._highestScriptId;
+	_executedInstructions = file._executedInstructions;
+	ResetScheduler();
 
 	return EXIT_SUCCESS;
 }
@@ -298,6 +278,7 @@ void LHVM::Reboot()
 	_highestScriptId = 0;
 	_currentLineNumber = 0;
 	_executedInstructions = 0;
+	ResetScheduler();
 
 	_mainStack.popCount += _mainStack.count;
 	_mainStack.count = 0;
@@ -315,6 +296,14 @@ int LHVM::SaveBinary(const std::filesystem::path& filepath)
 
 int LHVM::SaveState(const std::filesystem::path& filepath)
 {
+	SaveState().Write(filepath);
+	return EXIT_SUCCESS;
+}
+
+LHVMFile LHVM::SaveState()
+{
+	SettleParkedTasks();
+
 	std::vector<VMTask> tasks;
 	tasks.reserve(_tasks.size());
 	for (const auto& [id, task] : _tasks)
@@ -322,17 +311,23 @@ int LHVM::SaveState(const std::filesystem::path& filepath)
 		tasks.emplace_back(task);
 	}
 
-	LHVMFile file(LHVMVersion::BlackAndWhite, _variablesNames, _instructions, _auto, _scripts, _data, _mainStack, _variables,
-	              tasks, _ticks, _currentLineNumber, _highestTaskId, _highestScriptId, _executedInstructions);
-	file.Write(filepath);
-	return EXIT_SUCCESS;
+	return {LHVMVersion::BlackAndWhite, _variablesNames, _instructions, _auto, _scripts, _data, _mainStack, _variables,
+	        tasks, _ticks, _currentLineNumber, _highestTaskId, _highestScriptId, _executedInstructions};
 }
 
 void LHVM::LookIn(const ScriptType allowedScriptTypesMask)
 {
+	if (_profiler != nullptr)
+	{
+		_profiler->AddTurn();
+	}
+
+	WakeSleepingTasks();
+
 	// execute exception handlers first
-	for (auto& [id, task] : _tasks)
+	for (auto id = NextReadyTask(0); id != 0; id = NextReadyTask(id))
 	{
+		auto& task = _tasks.at(id);
 		if (task.type & allowedScriptTypesMask)
 		{
 			_currentStack = &task.stack;
@@ -354,9 +349,12 @@ void LHVM::LookIn(const ScriptType allowedScriptTypesMask)
 		}
 	}
 
-	// execute normal code
-	for (auto& [id, task] : _tasks)
+	// execute normal code, tasks started on the way have higher ids and run in this same pass
+	_lookInMask = allowedScriptTypesMask;
+	for (auto id = NextReadyTask(0); id != 0; id = NextReadyTask(id))
 	{
+		_lookInTaskId = id;
+		auto& task = _tasks.at(id);
 		if (task.type & allowedScriptTypesMask)
 		{
 			_currentStack = &task.stack;
@@ -366,35 +364,218 @@ void LHVM::LookIn(const ScriptType allowedScriptTypesMask)
 			}
 		}
 	}
+	_lookInTaskId = UINT32_MAX;
 
 	// handle tasks termination
-	for (auto iter = _tasks.begin(); iter != _tasks.end();)
-	{
-		auto& task = (*iter++).second;
-		if (task.stop)
+	std::ranges::sort(_stoppedTasks);
+	const auto duplicates = std::ranges::unique(_stoppedTasks);
+	_stoppedTasks.erase(duplicates.begin(), duplicates.end());
+	const auto stoppedTasks = std::move(_stoppedTasks);
+	_stoppedTasks.clear();
+	for (const auto id : stoppedTasks)
+	{
+		if (TaskExists(id))
 		{
-			StopTask(task.id);
+			StopTask(id);
 		}
 	}
 
-	// unlock waiting tasks
-	for (auto& [id, task] : _tasks)
+	// unlock waiting tasks and park the tasks which can't make progress
+	for (auto& [type, turns] : _allowedTurns)
+	{
+		if (type & allowedScriptTypesMask)
+		{
+			turns++;
+		}
+	}
+	for (auto id = NextReadyTask(0); id != 0; id = NextReadyTask(id))
 	{
+		auto& task = _tasks.at(id);
 		if (task.type & allowedScriptTypesMask)
 		{
 			task.ticks++;
-			if (task.waitingTaskId != 0 && !TaskExists(task.waitingTaskId))
+			if (task.waitingTaskId != 0)
+			{
+				if (TaskExists(task.waitingTaskId))
+				{
+					ParkTask(task, 0);
+					_waitingTasks[task.waitingTaskId].emplace_back(id);
+				}
+				else
+				{
+					task.waitingTaskId = 0;
+					task.instructionAddress++;
+				}
+			}
+			else if (const auto duration = GetSleepLoopDuration(task); duration.has_value() && *duration >= task.ticks)
 			{
-				task.waitingTaskId = 0;
-				task.instructionAddress++;
+				// Each turn the task would fail its sleep until its ticks exceed the duration
+				const auto sleepTurns = *duration - task.ticks + 1;
+				ParkTask(task, sleepTurns);
+				auto& parked = _parkedTasks.at(id);
+				parked.wakeTurn = _ticks + 1 + sleepTurns;
+				_timerWheel.at(parked.wakeTurn % k_TimerWheelSize).emplace_back(parked.wakeTurn, id);
 			}
 		}
 	}
+	std::erase_if(_unblockedTasks, [this, allowedScriptTypesMask](const uint32_t id) {
+		const auto iter = _tasks.find(id);
+		if (iter == _tasks.end() || !_parkedTasks.contains(id))
+		{
+			return true;
+		}
+		auto& task = iter->second;
+		if (!(task.type & allowedScriptTypesMask))
+		{
+			return false;
+		}
+		ResumeTask(task);
+		task.waitingTaskId = 0;
+		task.instructionAddress++;
+		return true;
+	});
 
+	_lookInTaskId = 0;
 	_ticks++;
 	_currentStack = &_mainStack;
 }
 
+void LHVM::ResetScheduler()
+{
+	_readyTasks.clear();
+	_parkedTasks.clear();
+	_waitingTasks.clear();
+	_unblockedTasks.clear();
+	_stoppedTasks.clear();
+	for (auto& slot : _timerWheel)
+	{
+		slot.clear();
+	}
+	_allowedTurns.clear();
+
+	for (auto& [id, task] : _tasks)
+	{
+		_allowedTurns.try_emplace(task.type, 0);
+		if (task.stop)
+		{
+			_stoppedTasks.emplace_back(id);
+		}
+		_readyTasks.insert(id);
+	}
+	// Sleeping tasks are parked again after their next turn, waiting tasks right away
+	for (auto& [id, task] : _tasks)
+	{
+		if (task.waitingTaskId != 0 && TaskExists(task.waitingTaskId))
+		{
+			ParkTask(task, 0);
+			_waitingTasks[task.waitingTaskId].emplace_back(id);
+		}
+	}
+}
+
+uint32_t LHVM::NextReadyTask(const uint32_t taskId) const
+{
+	// Looked up from the id rather than kept as an iterator, tasks may be started or stopped by the previous task
+	const auto iter = _readyTasks.upper_bound(taskId);
+	return iter != _readyTasks.end() ? *iter : 0;
+}
+
+std::optional<uint32_t> LHVM::GetSleepLoopDuration(const VMTask& task) const
+{
+	// Only the plain "wait N seconds" loop is skipped, anything else in the loop could have side effects:
+	//   PUSHF N
+	//   SLEEP
+	//   JZ <first instruction>
+	if (!task.sleeping || !task.iield || task.stop || task.inExceptionHandler || !task.exceptionHandlerIps.empty() ||
+	    task.stack.count >= VMStack::k_Size)
+	{
+		return std::nullopt;
+	}
+	const auto ip = task.instructionAddress;
+	if (ip + 2 >= _instructions.size())
+	{
+		return std::nullopt;
+	}
+	const auto& push = _instructions[ip];
+	const auto& sleep = _instructions[ip + 1];
+	const auto& jump = _instructions[ip + 2];
+	if (push.code != Opcode::Push || push.mode != VMMode::Immediate || sleep.code != Opcode::Sleep ||
+	    jump.code != Opcode::Wait || jump.mode != VMMode::Backward || jump.data.uintVal != ip)
+	{
+		return std::nullopt;
+	}
+	return static_cast<uint32_t>(push.data.floatVal * 10.0f);
+}
+
+void LHVM::ParkTask(VMTask& task, const uint32_t sleepTurns)
+{
+	_readyTasks.erase(task.id);
+	_parkedTasks[task.id] = {.allowedTurns = _allowedTurns[task.type], .sleepTurns = sleepTurns, .wakeTurn = 0};
+}
+
+void LHVM::ResumeTask(VMTask& task)
+{
+	CatchUpParkedTask(task, _parkedTasks.at(task.id));
+	_parkedTasks.erase(task.id);
+	_readyTasks.insert(task.id);
+}
+
+void LHVM::WakeSleepingTasks()
+{
+	auto& slot = _timerWheel.at(_ticks % k_TimerWheelSize);
+	std::vector<std::pair<uint32_t, uint32_t>> late;
+	std::erase_if(slot, [this, &late](const std::pair<uint32_t, uint32_t>& entry) {
+		const auto [wakeTurn, id] = entry;
+		if (wakeTurn > _ticks)
+		{
+			return false;
+		}
+		const auto parked = _parkedTasks.find(id);
+		if (parked == _parkedTasks.end() || parked->second.wakeTurn != wakeTurn)
+		{
+			return true;
+		}
+		// Turns which did not allow the task type delay its wake up
+		auto& task = _tasks.at(id);
+		const auto elapsed = _allowedTurns.at(task.type) - parked->second.allowedTurns;
+		if (elapsed < parked->second.sleepTurns)
+		{
+			parked->second.wakeTurn = _ticks + parked->second.sleepTurns - elapsed;
+			late.emplace_back(parked->second.wakeTurn, id);
+			return true;
+		}
+		ResumeTask(task);
+		return true;
+	});
+	for (const auto& entry : late)
+	{
+		_timerWheel.at(entry.first % k_TimerWheelSize).emplace_back(entry);
+	}
+}
+
+void LHVM::CatchUpParkedTask(VMTask& task, ParkedTask& parked)
+{
+	const auto turns = _allowedTurns.at(task.type) - parked.allowedTurns;
+	task.ticks += turns;
+	if (parked.sleepTurns > 0)
+	{
+		// Every skipped turn ran PUSHF, SLEEP and JZ, pushing and popping twice
+		task.stack.pushCount += 2 * turns;
+		task.stack.popCount += 2 * turns;
+		_executedInstructions += 3 * turns;
+		parked.sleepTurns -= turns;
+	}
+	parked.allowedTurns += turns;
+}
+
+void LHVM::SettleParkedTasks()
+{
+	for (auto& [id, parked] : _parkedTasks)
+	{
+		CatchUpParkedTask(_tasks.at(id), parked);
+	}
+}
+
 uint32_t LHVM::StartScript(const std::string& name, const ScriptType allowedScriptTypesMask)
 {
 	const auto* const script = GetScript(name);
@@ -456,6 +637,8 @@ uint32_t LHVM::StartScript(const VMScript& script)
 	                          stack, script.name, script.filename, script.type);
 
 	_tasks.emplace(taskNumber, task);
+	_readyTasks.insert(taskNumber);
+	_allowedTurns.try_emplace(script.type, 0);
 
 	return taskNumber;
 }
@@ -490,8 +673,19 @@ void LHVM::StopTask(uint32_t taskNumber)
 {
 	if (TaskExists(taskNumber))
 	{
-		InvokeStopTaskCallback(taskNumber);
 		auto& task = _tasks.at(taskNumber);
+		if (const auto parked = _parkedTasks.find(taskNumber); parked != _parkedTasks.end())
+		{
+			CatchUpParkedTask(task, parked->second);
+			// Stopped by a task of higher id, its sleep would have already been evaluated this turn
+			if (parked->second.sleepTurns > 0 && taskNumber < _lookInTaskId && task.type & _lookInMask)
+			{
+				task.stack.pushCount += 2;
+				task.stack.popCount += 2;
+				_executedInstructions += 3;
+			}
+		}
+		InvokeStopTaskCallback(taskNumber);
 		for (auto& var : task.localVars)
 		{
 			if (var.type == DataType::Object)
@@ -506,6 +700,13 @@ void LHVM::StopTask(uint32_t taskNumber)
 		}
 
 		_tasks.erase(taskNumber);
+		_readyTasks.erase(taskNumber);
+		_parkedTasks.erase(taskNumber);
+		if (const auto waiting = _waitingTasks.find(taskNumber); waiting != _waitingTasks.end())
+		{
+			_unblockedTasks.insert(_unblockedTasks.end(), waiting->second.begin(), waiting->second.end());
+			_waitingTasks.erase(waiting);
+		}
 	}
 	else
 	{
@@ -513,6 +714,18 @@ void LHVM::StopTask(uint32_t taskNumber)
 	}
 }
 
+void LHVM::SetProfilerEnabled(bool enabled)
+{
+	if (!enabled)
+	{
+		_profiler.reset();
+	}
+	else if (_profiler == nullptr)
+	{
+		_profiler = std::make_unique<LHVMProfiler>();
+	}
+}
+
 void LHVM::StopTasksOfType(const ScriptType typesMask)
 {
 	std::vector<uint32_t> ids;
@@ -719,11 +932,14 @@ void LHVM::PrintInstruction(const VMTask& task, const VMInstruction& instruction
 void LHVM::CpuLoop(VMTask& task)
 {
 	const auto wasExceptionHandler = task.inExceptionHandler;
+	const auto start = _profiler != nullptr ? LHVMProfiler::Clock::now() : LHVMProfiler::Clock::time_point {};
+	uint32_t instructions = 0;
 	task.iield = false;
 	while (task.waitingTaskId == 0)
 	{
 		_currentTask = &task;
 		_executedInstructions++;
+		instructions++;
 		const auto& instruction = _instructions.at(task.instructionAddress);
 
 		// PrintInstruction(task, instruction); // just for debug purposes
@@ -737,6 +953,11 @@ void LHVM::CpuLoop(VMTask& task)
 		task.instructionAddress++;
 	}
 	_currentTask = nullptr;
+
+	if (_profiler != nullptr && instructions > 0)
+	{
+		_profiler->AddTaskRun(task, instructions, LHVMProfiler::Clock::now() - start);
+	}
 }
 
 float LHVM::Fmod(float a, float b)
@@ -747,6 +968,7 @@ float LHVM::Fmod(float a, float b)
 void LHVM::Opcode00End(VMTask& task, const VMInstruction& /*instruction*/)
 {
 	task.stop = true;
+	_stoppedTasks.emplace_back(task.id);
 }
 
 void LHVM::Opcode01Jz(VMTask& task, const VMInstruction& instruction)
@@ -857,7 +1079,12 @@ void LHVM::Opcode05Sys(VMTask& /*task*/, const VMInstruction& instruction)
 			_currentStack->pushCount = 0;
 			_currentStack->popCount = 0;
 			InvokeNativeCallEnterCallback(id);
+			const auto start = _profiler != nullptr ? LHVMProfiler::Clock::now() : LHVMProfiler::Clock::time_point {};
 			func.impl();
+			if (_profiler != nullptr)
+			{
+				_profiler->AddNativeCall(_currentTask, id, LHVMProfiler::Clock::now() - start);
+			}
 			InvokeNativeCallExitCallback(id);
 		}
 		else // if impl not provided, then just adjust the stack
@@ -107,7 +107,7 @@
 #include <cstring>
 
 #include <fstream>
-#include <stdexcept>
+#include <type_traits>
 
 #include "LHVMTypes.h"
 
@@ -115,45 +115,48 @@ using namespace openblack::lhvm;
 
 namespace
 {
-// Adapted from https://stackoverflow.com/a/13059195/10604387
-//          and https://stackoverflow.com/a/46069245/10604387
-struct membuf: std::streambuf
+template <typename T>
+bool Read(std::span<const uint8_t>& stream, T& value)
 {
-	membuf(char const* base, size_t size)
+	static_assert(std::is_trivially_copyable_v<T>);
+	if (stream.size() < sizeof(T))
 	{
-		char* p(const_cast<char*>(base));
-		this->setg(p, p, p + size);
+		return false;
 	}
-	std::streampos seekoff(off_type off, std::ios_base::seekdir way, [[maybe_unused]] std::ios_base::openmode which) override
+	std::memcpy(&value, stream.data(), sizeof(T));
+	stream = stream.subspan(sizeof(T));
+	return true;
+}
+
+template <typename T>
+bool Read(std::span<const uint8_t>& stream, T* values, size_t count)
+{
+	static_assert(std::is_trivially_copyable_v<T>);
+	if (stream.size() / sizeof(T) < count)
 	{
-		if (way == std::ios_base::cur)
-		{
-			gbump(static_cast<int>(off));
-		}
-		else if (way == std::ios_base::end)
-		{
-			setg(eback(), egptr() + off, egptr());
-		}
-		else if (way == std::ios_base::beg)
-		{
-			setg(eback(), eback() + off, egptr());
-		}
-		return gptr() - eback();
+		return false;
 	}
-
-	std::streampos seekpos([[maybe_unused]] pos_type pos, [[maybe_unused]] std::ios_base::openmode which) override
+	if (count > 0)
 	{
-		return seekoff(pos - static_cast<off_type>(0), std::ios_base::beg, which);
+		std::memcpy(values, stream.data(), sizeof(T) * count);
 	}
-};
-struct imemstream: virtual membuf, std::istream
+	stream = stream.subspan(sizeof(T) * count);
+	return true;
+}
+
+/// Null terminated string, found with a single memchr instead of reading one character at a time
+bool Read(std::span<const uint8_t>& stream, std::string& string)
 {
-	imemstream(char const* base, size_t size)
-	    : membuf(base, size)
-	    , std::istream(dynamic_cast<std::streambuf*>(this))
+	const auto* end = static_cast<const uint8_t*>(std::memchr(stream.data(), '\0', stream.size()));
+	if (end == nullptr)
 	{
+		return false;
 	}
-};
+	const auto size = static_cast<size_t>(end - stream.data());
+	string.assign(reinterpret_cast<const char*>(stream.data()), size);
+	stream = stream.subspan(size + 1);
+	return true;
+}
 } // namespace
 
 LHVMFile::LHVMFile()
@@ -194,32 +197,24 @@ LHVMFile::LHVMFile(const LHVMVersion version, const std::vector<std::string>& va
 
 LHVMFile::~LHVMFile() = default;
 
-void LHVMFile::ReadFile(std::istream& stream)
+void LHVMFile::ReadFile(std::span<const uint8_t> stream)
 {
 	assert(!_isLoaded);
 
-	// Total file size
-	std::size_t fsize = 0;
-	if (stream.seekg(0, std::ios_base::end))
-	{
-		fsize = static_cast<std::size_t>(stream.tellg());
-		stream.seekg(0);
-	}
-
-	if (fsize < 8)
+	if (stream.size() < 8)
 	{
 		return; // File too small to be a valid LHVM file.
 	}
 
 	// First 8 bytes
 	std::array<char, 4> magic;
-	stream.read(reinterpret_cast<char*>(magic.data()), 4);
+	Read(stream, magic);
 	if (magic != k_Magic)
 	{
 		return; // Unrecognized LHVM header
 	}
 
-	stream.read(reinterpret_cast<char*>(&_version), sizeof(_version));
+	Read(stream, _version);
 	/* only support bw1 at the moment */
 	if (_version != LHVMVersion::BlackAndWhite)
 	{
@@ -260,23 +255,29 @@ void LHVMFile::Open(const std::filesystem::path& filepath)
 {
 	assert(!_isLoaded);
 
-	std::ifstream stream(filepath, std::ios::binary);
+	std::ifstream stream(filepath, std::ios::binary | std::ios::ate);
 
 	if (!stream.is_open())
 	{
 		return; // Could not open file.
 	}
 
-	ReadFile(stream);
+	// Read the whole file at once, it is then parsed in memory
+	std::vector<uint8_t> buffer(static_cast<size_t>(stream.tellg()));
+	stream.seekg(0);
+	if (!stream.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size())))
+	{
+		return; // Could not read file.
+	}
+
+	ReadFile(buffer);
 }
 
-void LHVMFile::Open(const std::vector<uint8_t>& buffer)
+void LHVMFile::Open(std::span<const uint8_t> buffer)
 {
 	assert(!_isLoaded);
 
-	imemstream stream(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(buffer[0]));
-
-	ReadFile(stream);
+	ReadFile(buffer);
 }
 
 void LHVMFile::Write([[maybe_unused]] const std::filesystem::path& filepath)
@@ -291,11 +292,11 @@ void LHVMFile::Write([[maybe_unused]] const std::filesystem::path& filepath)
 	}
 }
 
-int LHVMFile::LoadVariablesNames(std::istream& stream, std::vector<std::string>& variables)
+int LHVMFile::LoadVariablesNames(std::span<const uint8_t>& stream, std::vector<std::string>& variables)
 {
 	int32_t count;
 
-	if (!stream.read(reinterpret_cast<char*>(&count), sizeof(count)))
+	if (!Read(stream, count))
 	{
 		return EXIT_FAILURE; // Error reading variable count
 	}
@@ -306,33 +307,28 @@ int LHVMFile::LoadVariablesNames(std::istream& stream, std::vector<std::string>&
 		return EXIT_SUCCESS;
 	}
 
-	// preallocate a buffer to reuse for each variable
-	std::array<char, 255> buffer;
+	// Every name takes at least its null terminator
+	if (static_cast<size_t>(count) > stream.size())
+	{
+		return EXIT_FAILURE; // Invalid variable count
+	}
 
-	variables.reserve(count);
-	for (int32_t i = 0; i < count; i++)
+	variables.resize(count);
+	for (auto& variable : variables)
 	{
-		// reset cur pointer to 0
-		char* cur = buffer.data();
-		do
+		if (!Read(stream, variable))
 		{
-			if (!stream.read(cur++, sizeof(*cur)))
-			{
-				return EXIT_FAILURE; // Error reading variable
-			}
-		} while (*(cur - 1) != '\0');
-
-		// throw it into the std::string vector
-		variables.emplace_back(buffer.data());
+			return EXIT_FAILURE; // Error reading variable
+		}
 	}
 
 	return EXIT_SUCCESS;
 }
 
-int LHVMFile::LoadCode(std::istream& stream)
+int LHVMFile::LoadCode(std::span<const uint8_t>& stream)
 {
 	int32_t count;
-	if (!stream.read(reinterpret_cast<char*>(&count), sizeof(count)))
+	if (!Read(stream, count))
 	{
 		return EXIT_FAILURE; // Error reading code count
 	}
@@ -343,19 +339,20 @@ int LHVMFile::LoadCode(std::istream& stream)
 		return EXIT_SUCCESS;
 	}
 
-	_instructions.resize(count);
-	if (!stream.read(reinterpret_cast<char*>(_instructions.data()), sizeof(VMInstruction) * _instructions.size()))
+	if (static_cast<size_t>(count) > stream.size() / sizeof(VMInstruction))
 	{
 		return EXIT_FAILURE; // Error reading instructions
 	}
+	_instructions.resize(count);
+	Read(stream, _instructions.data(), _instructions.size());
 
 	return EXIT_SUCCESS;
 }
 
-int LHVMFile::LoadAuto(std::istream& stream)
+int LHVMFile::LoadAuto(std::span<const uint8_t>& stream)
 {
 	int32_t count;
-	if (!stream.read(reinterpret_cast<char*>(&count), sizeof(count)))
+	if (!Read(stream, count))
 	{
 		return EXIT_FAILURE; // error reading id count
 	}
@@ -366,19 +363,20 @@ int LHVMFile::LoadAuto(std::istream& stream)
 		return EXIT_SUCCESS;
 	}
 
-	_autostart.resize(count);
-	if (!stream.read(reinterpret_cast<char*>(_autostart.data()), sizeof(_autostart[0]) * _autostart.size()))
+	if (static_cast<size_t>(count) > stream.size() / sizeof(_autostart[0]))
 	{
 		return EXIT_FAILURE; // error reading ids
 	}
+	_autostart.resize(count);
+	Read(stream, _autostart.data(), _autostart.size());
 
 	return EXIT_SUCCESS;
 }
 
-int LHVMFile::LoadScripts(std::istream& stream)
+int LHVMFile::LoadScripts(std::span<const uint8_t>& stream)
 {
 	int32_t count;
-	if (!stream.read(reinterpret_cast<char*>(&count), sizeof(count)))
+	if (!Read(stream, count))
 	{
 		return EXIT_FAILURE; // error reading script count
 	}
@@ -389,6 +387,11 @@ int LHVMFile::LoadScripts(std::istream& stream)
 		return EXIT_SUCCESS;
 	}
 
+	if (static_cast<size_t>(count) > stream.size())
+	{
+		return EXIT_FAILURE; // Invalid script count
+	}
+
 	_scripts.reserve(count);
 	for (int32_t i = 0; i < count; i++)
 	{
@@ -401,37 +404,24 @@ int LHVMFile::LoadScripts(std::istream& stream)
 	return EXIT_SUCCESS;
 }
 
-int LHVMFile::LoadScript(std::istream& stream, VMScript& script)
+int LHVMFile::LoadScript(std::span<const uint8_t>& stream, VMScript& script)
 {
-	std::array<char, 256> scriptName;
-	std::array<char, 256> filename;
-
-	char* cur = scriptName.data();
-	do
+	if (!Read(stream, script.name))
 	{
-		if (!stream.read(cur++, sizeof(*cur)))
-		{
-			return EXIT_FAILURE; // Error script name
-		}
-	} while (*(cur - 1) != '\0');
-	script.name = std::string(scriptName.data());
+		return EXIT_FAILURE; // Error script name
+	}
 
-	cur = filename.data();
-	do
+	if (!Read(stream, script.filename))
 	{
-		if (!stream.read(cur++, sizeof(*cur)))
-		{
-			return EXIT_FAILURE; // Error reading script filename
-		}
-	} while (*(cur - 1) != '\0');
-	script.filename = std::string(filename.data());
+		return EXIT_FAILURE; // Error reading script filename
+	}
 
-	if (!stream.read(reinterpret_cast<char*>(&script.type), sizeof(script.type)))
+	if (!Read(stream, script.type))
 	{
 		return EXIT_FAILURE; // Error reading script type
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&script.variablesOffset), sizeof(script.variablesOffset)))
+	if (!Read(stream, script.variablesOffset))
 	{
 		return EXIT_FAILURE; // Error reading script variables offset
 	}
@@ -441,17 +431,17 @@ int LHVMFile::LoadScript(std::istream& stream, VMScript& script)
 		return EXIT_FAILURE;
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&script.instructionAddress), sizeof(script.instructionAddress)))
+	if (!Read(stream, script.instructionAddress))
 	{
 		return EXIT_FAILURE; // Error reading instruction address
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&script.parameterCount), sizeof(script.parameterCount)))
+	if (!Read(stream, script.parameterCount))
 	{
 		return EXIT_FAILURE; // Error reading parameter count
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&script.scriptId), sizeof(script.scriptId)))
+	if (!Read(stream, script.scriptId))
 	{
 		return EXIT_FAILURE; // Error reading script_id
 	}
@@ -459,27 +449,25 @@ int LHVMFile::LoadScript(std::istream& stream, VMScript& script)
 	return EXIT_SUCCESS;
 }
 
-int LHVMFile::LoadData(std::istream& stream)
+int LHVMFile::LoadData(std::span<const uint8_t>& stream)
 {
 	int32_t size;
-	if (!stream.read(reinterpret_cast<char*>(&size), sizeof(size)))
+	if (!Read(stream, size))
 	{
 		return EXIT_FAILURE; // Error reading data size
 	}
 
-	_data.resize(size);
-	if (size > 0)
+	if (size < 0 || static_cast<size_t>(size) > stream.size())
 	{
-		if (!stream.read(reinterpret_cast<char*>(_data.data()), sizeof(_data[0]) * _data.size()))
-		{
-			return EXIT_FAILURE; // Error reading data
-		}
+		return EXIT_FAILURE; // Error reading data
 	}
+	_data.resize(size);
+	Read(stream, _data.data(), _data.size());
 
 	return EXIT_SUCCESS;
 }
 
-int LHVMFile::LoadStatus(std::istream& stream)
+int LHVMFile::LoadStatus(std::span<const uint8_t>& stream)
 {
 	const int rc = LoadStack(stream, _stack);
 	if (rc == EXIT_FAILURE)
@@ -508,14 +496,15 @@ int LHVMFile::LoadStatus(std::istream& stream)
 	return EXIT_SUCCESS;
 }
 
-int LHVMFile::LoadStack(std::istream& stream, VMStack& stack)
+int LHVMFile::LoadStack(std::span<const uint8_t>& stream, VMStack& stack)
 {
-	if (!stream.read(reinterpret_cast<char*>(&stack.count), sizeof(stack.count)))
+	if (stream.empty())
+	{
+		return EOF;
+	}
+
+	if (!Read(stream, stack.count))
 	{
-		if (stream.eof())
-		{
-			return EOF;
-		}
 		return EXIT_FAILURE; // Error reading stack count
 	}
 	if (stack.count > VMStack::k_Size)
@@ -523,86 +512,87 @@ int LHVMFile::LoadStack(std::istream& stream, VMStack& stack)
 		return EXIT_FAILURE; // Invalid stack count
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&stack.pushCount), sizeof(stack.pushCount)))
+	if (!Read(stream, stack.pushCount))
 	{
 		return EXIT_FAILURE; // Error reading stack push count
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&stack.popCount), sizeof(stack.popCount)))
+	if (!Read(stream, stack.popCount))
 	{
 		return EXIT_FAILURE; // Error reading stack pop count
 	}
 
-	for (int i = 0; i < stack.count; i++)
+	if (!Read(stream, stack.values.data(), stack.count))
 	{
-		if (!stream.read(reinterpret_cast<char*>(&stack.values.at(i)), sizeof(stack.values[0])))
-		{
-			return EXIT_FAILURE; // Error reading stack values
-		}
+		return EXIT_FAILURE; // Error reading stack values
 	}
 
-	for (int i = 0; i < stack.count; i++)
+	if (!Read(stream, stack.types.data(), stack.count))
 	{
-		if (!stream.read(reinterpret_cast<char*>(&stack.types.at(i)), sizeof(stack.types[0])))
-		{
-			return EXIT_FAILURE; // Error reading stack types
-		}
+		return EXIT_FAILURE; // Error reading stack types
 	}
 
 	return EXIT_SUCCESS;
 }
 
-int LHVMFile::LoadVariableValues(std::istream& stream, std::vector<VMVar>& variables)
+int LHVMFile::LoadVariableValues(std::span<const uint8_t>& stream, std::vector<VMVar>& variables)
 {
 	uint32_t count;
 	uint8_t type;
 	VMValue value;
-	std::array<char, 256> name;
+	std::string name;
 
-	if (!stream.read(reinterpret_cast<char*>(&count), sizeof(count)))
+	if (!Read(stream, count))
 	{
 		return EXIT_FAILURE; // Error reading variables count
 	}
 
+	// Every variable takes at least its type, its value and a null terminator
+	if (count > stream.size() / (sizeof(type) + sizeof(value) + 1))
+	{
+		return EXIT_FAILURE; // Invalid variables count
+	}
+
 	variables.reserve(count);
-	for (int i = 0; i < count; i++)
+	for (uint32_t i = 0; i < count; i++)
 	{
-		if (!stream.read(reinterpret_cast<char*>(&type), sizeof(type)))
+		if (!Read(stream, type))
 		{
 			return EXIT_FAILURE; // Error reading variable type
 		}
 
-		if (!stream.read(reinterpret_cast<char*>(&value), sizeof(value)))
+		if (!Read(stream, value))
 		{
 			return EXIT_FAILURE; // Error reading variable value
 		}
 
-		char* cur = name.data();
-		do
+		if (!Read(stream, name))
 		{
-			if (!stream.read(cur++, sizeof(*cur)))
-			{
-				return EXIT_FAILURE; // Error reading variable name
-			}
-		} while (*(cur - 1) != '\0');
+			return EXIT_FAILURE; // Error reading variable name
+		}
 
-		variables.emplace_back(DataType(type), value, std::string(name.data()));
+		variables.emplace_back(DataType(type), value, name);
 	}
 
 	return EXIT_SUCCESS;
 }
 
-int LHVMFile::LoadTasks(std::istream& stream)
+int LHVMFile::LoadTasks(std::span<const uint8_t>& stream)
 {
 	uint32_t count;
 
-	if (!stream.read(reinterpret_cast<char*>(&count), sizeof(count)))
+	if (!Read(stream, count))
 	{
 		return EXIT_FAILURE; // Error reading tasks count
 	}
 
+	if (count > stream.size())
+	{
+		return EXIT_FAILURE; // Invalid tasks count
+	}
+
 	_tasks.reserve(count);
-	for (int i = 0; i < count; i++)
+	for (uint32_t i = 0; i < count; i++)
 	{
 		if (LoadTask(stream, _tasks.emplace_back()) != EXIT_SUCCESS)
 		{
@@ -613,74 +603,74 @@ int LHVMFile::LoadTasks(std::istream& stream)
 	return EXIT_SUCCESS;
 }
 
-int LHVMFile::LoadTask(std::istream& stream, VMTask& task)
+int LHVMFile::LoadTask(std::span<const uint8_t>& stream, VMTask& task)
 {
 	if (LoadVariableValues(stream, task.localVars) != EXIT_SUCCESS)
 	{
 		return EXIT_FAILURE;
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&task.id), sizeof(task.id)))
+	if (!Read(stream, task.id))
 	{
 		return EXIT_FAILURE; // Error reading task number
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&task.instructionAddress), sizeof(task.instructionAddress)))
+	if (!Read(stream, task.instructionAddress))
 	{
 		return EXIT_FAILURE; // Error reading instruction address
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&task.pevInstructionAddress), sizeof(task.pevInstructionAddress)))
+	if (!Read(stream, task.pevInstructionAddress))
 	{
 		return EXIT_FAILURE; // Error reading prev instruction address
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&task.waitingTaskId), sizeof(task.waitingTaskId)))
+	if (!Read(stream, task.waitingTaskId))
 	{
 		return EXIT_FAILURE; // Error reading waiting task
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&task.variablesOffset), sizeof(task.variablesOffset)))
+	if (!Read(stream, task.variablesOffset))
 	{
 		return EXIT_FAILURE; // Error reading var offset
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&task.currentExceptionHandlerIndex), sizeof(task.currentExceptionHandlerIndex)))
+	if (!Read(stream, task.currentExceptionHandlerIndex))
 	{
 		return EXIT_FAILURE; // Error reading current exception handler index
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&task.ticks), sizeof(task.ticks)))
+	if (!Read(stream, task.ticks))
 	{
 		return EXIT_FAILURE; // Error reading ticks
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&task.scriptId), sizeof(task.scriptId)))
+	if (!Read(stream, task.scriptId))
 	{
 		return EXIT_FAILURE; // Error reading script id
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&task.type), sizeof(task.type)))
+	if (!Read(stream, task.type))
 	{
 		return EXIT_FAILURE; // Error reading type
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&task.inExceptionHandler), sizeof(task.inExceptionHandler)))
+	if (!Read(stream, task.inExceptionHandler))
 	{
 		return EXIT_FAILURE; // Error reading 'in exception handler'
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&task.stop), sizeof(task.stop)))
+	if (!Read(stream, task.stop))
 	{
 		return EXIT_FAILURE; // Error reading stop
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&task.iield), sizeof(task.iield)))
+	if (!Read(stream, task.iield))
 	{
 		return EXIT_FAILURE; // Error reading yield
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&task.sleeping), sizeof(task.sleeping)))
+	if (!Read(stream, task.sleeping))
 	{
 		return EXIT_FAILURE; // Error reading sleeping
 	}
@@ -691,17 +681,18 @@ int LHVMFile::LoadTask(std::istream& stream, VMTask& task)
 	}
 
 	uint32_t exceptStructCount;
-	if (!stream.read(reinterpret_cast<char*>(&exceptStructCount), sizeof(exceptStructCount)))
+	if (!Read(stream, exceptStructCount))
 	{
 		return EXIT_FAILURE; // Error reading except struct count
 	}
-	task.exceptionHandlerIps.resize(exceptStructCount);
-	if (!stream.read(reinterpret_cast<char*>(task.exceptionHandlerIps.data()), sizeof(uint32_t) * exceptStructCount))
+	if (exceptStructCount > stream.size() / sizeof(uint32_t))
 	{
 		return EXIT_FAILURE; // Error reading except struct
 	}
+	task.exceptionHandlerIps.resize(exceptStructCount);
+	Read(stream, task.exceptionHandlerIps.data(), exceptStructCount);
 
-	if (task.scriptId < 1 || task.scriptId >= _scripts.size())
+	if (task.scriptId < 1 || task.scriptId > _scripts.size())
 	{
 		return EXIT_FAILURE; // Script not found
 	}
@@ -712,29 +703,29 @@ int LHVMFile::LoadTask(std::istream& stream, VMTask& task)
 	return EXIT_SUCCESS;
 }
 
-int LHVMFile::LoadRuntimeInfo(std::istream& stream)
+int LHVMFile::LoadRuntimeInfo(std::span<const uint8_t>& stream)
 {
-	if (!stream.read(reinterpret_cast<char*>(&_ticks), sizeof(_ticks)))
+	if (!Read(stream, _ticks))
 	{
 		return EXIT_FAILURE; // Error reading clock ticks
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&_currentLineNumber), sizeof(_currentLineNumber)))
+	if (!Read(stream, _currentLineNumber))
 	{
 		return EXIT_FAILURE; // Error reading current line number
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&_highestTaskId), sizeof(_highestTaskId)))
+	if (!Read(stream, _highestTaskId))
 	{
 		return EXIT_FAILURE; // Error reading highest task id
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&_highestScriptId), sizeof(_highestScriptId)))
+	if (!Read(stream, _highestScriptId))
 	{
 		return EXIT_FAILURE; // Error reading highest script id
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&_executedInstructions), sizeof(_executedInstructions)))
+	if (!Read(stream, _executedInstructions))
 	{
 		return EXIT_FAILURE; // Error reading script instruction count
 	}
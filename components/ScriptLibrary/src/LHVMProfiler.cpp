@@ -0,0 +1,100 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "LHVMProfiler.h"
+
+#include <string>
+
+using namespace openblack::lhvm;
+
+namespace
+{
+std::string ScriptFrame(const std::vector<VMScript>& scripts, uint32_t scriptId)
+{
+	if (scriptId > 0 && scriptId <= scripts.size())
+	{
+		return scripts[scriptId - 1].name;
+	}
+	return scriptId == 0 ? "<no task>" : "<script " + std::to_string(scriptId) + ">";
+}
+
+std::string NativeFrame(const std::vector<NativeFunction>* functions, uint32_t function)
+{
+	if (functions != nullptr && function < functions->size())
+	{
+		return (*functions)[function].name;
+	}
+	return "<native " + std::to_string(function) + ">";
+}
+
+long long Microseconds(LHVMProfiler::Clock::duration time)
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(time).count();
+}
+} // namespace
+
+void LHVMProfiler::Reset()
+{
+	_scripts.clear();
+	_tasks.clear();
+	_nativeFunctions.clear();
+	_nativeCallers.clear();
+	_turns = 0;
+}
+
+void LHVMProfiler::AddTaskRun(const VMTask& task, uint32_t instructions, Clock::duration time)
+{
+	for (auto* entry : {&_scripts[task.scriptId], &_tasks[task.id]})
+	{
+		entry->calls++;
+		entry->instructions += instructions;
+		entry->time += time;
+	}
+}
+
+void LHVMProfiler::AddNativeCall(const VMTask* task, uint32_t function, Clock::duration time)
+{
+	auto& native = _nativeFunctions[function];
+	native.calls++;
+	native.time += time;
+
+	const auto scriptId = task != nullptr ? task->scriptId : 0;
+	auto& caller = _nativeCallers[{scriptId, function}];
+	caller.calls++;
+	caller.time += time;
+
+	// The task run is only added once the task yields
+	if (task != nullptr)
+	{
+		_scripts[task->scriptId].nativeTime += time;
+		_tasks[task->id].nativeTime += time;
+	}
+}
+
+void LHVMProfiler::WriteCollapsedStacks(std::ostream& stream, const std::vector<VMScript>& scripts,
+                                        const std::vector<NativeFunction>* functions) const
+{
+	for (const auto& [scriptId, entry] : _scripts)
+	{
+		const auto self = Microseconds(entry.SelfTime());
+		if (self > 0)
+		{
+			stream << "LHVM;" << ScriptFrame(scripts, scriptId) << ' ' << self << '\n';
+		}
+	}
+	for (const auto& [key, entry] : _nativeCallers)
+	{
+		const auto time = Microseconds(entry.time);
+		if (time > 0)
+		{
+			stream << "LHVM;" << ScriptFrame(scripts, key.first) << ';' << NativeFrame(functions, key.second) << ' ' << time
+			       << '\n';
+		}
+	}
+}
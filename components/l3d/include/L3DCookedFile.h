@@ -0,0 +1,246 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <array>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "L3DFile.h"
+
+namespace openblack::l3d
+{
+
+/// Byte range of a block of a cooked file
+struct L3DCookedBlock
+{
+	uint32_t offset;
+	uint32_t size;
+};
+static_assert(sizeof(L3DCookedBlock) == 8);
+
+struct L3DCookedHeader
+{
+	std::array<char, 4> magic;
+	/// Version of the layout and of the cooking, files of any other version are rejected
+	uint32_t version;
+	/// Hash of the L3D, or of the compressed L3D, the file was cooked from
+	uint64_t sourceHash;
+	/// Size of the whole file
+	uint32_t size;
+	L3DMeshFlags flags;
+	uint32_t hasDoorPosition;
+	L3DPoint doorPosition;
+	/// True if the hull points were reduced to the vertices of the convex hull
+	uint32_t hullOptimized;
+	uint32_t footprintWidth;
+	uint32_t footprintHeight;
+	L3DCookedBlock submeshes;    ///< L3DCookedSubmesh
+	L3DCookedBlock skins;        ///< L3DTexture
+	L3DCookedBlock footprints;   ///< L3DCookedFootprint
+	L3DCookedBlock bones;        ///< L3DBone
+	L3DCookedBlock extraMetrics; ///< 3x4 matrices
+	L3DCookedBlock hullPoints;   ///< L3DPoint
+	L3DCookedBlock nameData;     ///< chars
+	uint32_t reserved;
+};
+static_assert(sizeof(L3DCookedHeader) == 112);
+
+/// Vertex as uploaded to the GPU: position, texture coordinates, normal and the bone indices
+struct L3DCookedVertex
+{
+	L3DPoint position;
+	L3DPoint2D texCoord;
+	L3DPoint normal;
+	std::array<int16_t, 2> boneIndices;
+};
+static_assert(sizeof(L3DCookedVertex) == 36);
+
+/// Quantized vertex, decoded in the vertex shader with the position and texture coordinate ranges of its submesh
+struct L3DCookedCompactVertex
+{
+	std::array<int16_t, 4> position; ///< Normalized within the submesh's position range, w is unused
+	std::array<int16_t, 2> normal;   ///< Normalized octahedral encoding
+	std::array<int16_t, 2> texCoord; ///< Normalized within the submesh's texture coordinate range
+	std::array<int16_t, 2> boneIndices;
+};
+static_assert(sizeof(L3DCookedCompactVertex) == 20);
+
+struct L3DCookedPrimitive
+{
+	uint32_t skinID;
+	/// Range of the primitive in the indices of its submesh
+	uint32_t indicesOffset;
+	uint32_t indicesCount;
+	L3DMaterial::Type materialType;
+	uint32_t alphaCutoutThreshold;
+};
+static_assert(sizeof(L3DCookedPrimitive) == 20);
+
+struct L3DCookedSubmesh
+{
+	L3DSubmeshHeader::Flags flags;
+	/// Bounds of the vertices once placed by their bones
+	L3DPoint minima;
+	L3DPoint maxima;
+	/// Compact positions decode to positionOffset + position * positionScale
+	L3DPoint positionOffset;
+	L3DPoint positionScale;
+	/// Compact texture coordinates decode to texCoordOffset + texCoord * texCoordScale
+	L3DPoint2D texCoordOffset;
+	L3DPoint2D texCoordScale;
+	L3DCookedBlock vertices;        ///< L3DCookedVertex
+	L3DCookedBlock compactVertices; ///< L3DCookedCompactVertex, the same vertices as vertices
+	L3DCookedBlock indices;         ///< uint16_t, relative to the first vertex of the submesh
+	L3DCookedBlock primitives;      ///< L3DCookedPrimitive
+};
+static_assert(sizeof(L3DCookedSubmesh) == 100);
+
+struct L3DCookedFootprintVertex
+{
+	L3DPoint2D position;
+	L3DPoint2D texCoord;
+};
+static_assert(sizeof(L3DCookedFootprintVertex) == 16);
+
+struct L3DCookedFootprint
+{
+	L3DCookedBlock vertices; ///< L3DCookedFootprintVertex, three per triangle
+	L3DCookedBlock pixels;   ///< uint16_t
+};
+static_assert(sizeof(L3DCookedFootprint) == 16);
+
+/**
+  A L3D mesh with all the work needed to draw it already done: vertices expanded to the layout used on the GPU,
+  indices merged per submesh, bounds placed by the bones and the points of the physics hull.
+  Vertices are also stored quantized, and indices are reordered for the post-transform cache and vertex fetches.
+
+  Every block is aligned so the file can be mapped in memory and its blocks handed to the GPU without copies.
+ */
+class L3DCookedFile
+{
+public:
+	static constexpr const std::array<char, 4> k_Magic = {'L', '3', 'D', 'C'};
+	/// Bump whenever the layout or the cooking changes, so that caches are rebuilt
+	static constexpr uint32_t k_Version = 2;
+	static constexpr uint32_t k_BlockAlignment = 16;
+
+	/// Reduce points to the vertices of their convex hull
+	using HullOptimizer = std::function<std::vector<L3DPoint>(std::span<const L3DPoint> points)>;
+
+	L3DCookedFile() noexcept;
+	~L3DCookedFile() noexcept;
+
+	/// Hash identifying a source file in caches
+	[[nodiscard]] static uint64_t HashSource(std::span<const uint8_t> source) noexcept;
+	/// Name of the cooked file of a source in a cache directory
+	[[nodiscard]] static std::string GetCacheFilename(uint64_t sourceHash) noexcept;
+
+	/// Cook a loaded L3D, the hull is kept as is without an optimizer
+	/// \param optimizeIndices Reorder indices and vertices, only disabled to measure the optimization
+	L3DResult Cook(const L3DFile& l3d, uint64_t sourceHash, const HullOptimizer& optimizeHull = nullptr,
+	               bool optimizeIndices = true) noexcept;
+
+	/// Read cooked file from a buffer, such as a file mapped in memory, which must outlive this object
+	L3DResult Open(std::span<const uint8_t> buffer) noexcept;
+
+	/// Read cooked file from the filesystem
+	L3DResult Open(const std::filesystem::path& filepath) noexcept;
+
+	/// Write cooked file to path on the filesystem
+	L3DResult Write(const std::filesystem::path& filepath) const noexcept;
+
+	[[nodiscard]] bool IsLoaded() const noexcept { return !_buffer.empty(); }
+	[[nodiscard]] std::span<const uint8_t> GetBuffer() const noexcept { return _buffer; }
+
+	// The accessors below are only valid once the file is loaded
+	[[nodiscard]] const L3DCookedHeader& GetHeader() const noexcept
+	{
+		return *reinterpret_cast<const L3DCookedHeader*>(_buffer.data());
+	}
+	[[nodiscard]] L3DMeshFlags GetFlags() const noexcept { return GetHeader().flags; }
+	[[nodiscard]] std::optional<L3DPoint> GetDoorPosition() const noexcept;
+	[[nodiscard]] bool IsHullOptimized() const noexcept { return GetHeader().hullOptimized != 0; }
+
+	[[nodiscard]] std::span<const L3DCookedSubmesh> GetSubmeshes() const noexcept
+	{
+		return Get<L3DCookedSubmesh>(&L3DCookedHeader::submeshes);
+	}
+	[[nodiscard]] std::span<const L3DCookedVertex> GetVertices(const L3DCookedSubmesh& submesh) const noexcept
+	{
+		return Get<L3DCookedVertex>(submesh.vertices);
+	}
+	[[nodiscard]] std::span<const L3DCookedCompactVertex> GetCompactVertices(const L3DCookedSubmesh& submesh) const noexcept
+	{
+		return Get<L3DCookedCompactVertex>(submesh.compactVertices);
+	}
+	[[nodiscard]] std::span<const uint16_t> GetIndices(const L3DCookedSubmesh& submesh) const noexcept
+	{
+		return Get<uint16_t>(submesh.indices);
+	}
+	[[nodiscard]] std::span<const L3DCookedPrimitive> GetPrimitives(const L3DCookedSubmesh& submesh) const noexcept
+	{
+		return Get<L3DCookedPrimitive>(submesh.primitives);
+	}
+	[[nodiscard]] std::span<const L3DTexture> GetSkins() const noexcept { return Get<L3DTexture>(&L3DCookedHeader::skins); }
+	[[nodiscard]] std::span<const L3DCookedFootprint> GetFootprints() const noexcept
+	{
+		return Get<L3DCookedFootprint>(&L3DCookedHeader::footprints);
+	}
+	[[nodiscard]] std::span<const L3DCookedFootprintVertex>
+	GetFootprintVertices(const L3DCookedFootprint& footprint) const noexcept
+	{
+		return Get<L3DCookedFootprintVertex>(footprint.vertices);
+	}
+	[[nodiscard]] std::span<const uint16_t> GetFootprintPixels(const L3DCookedFootprint& footprint) const noexcept
+	{
+		return Get<uint16_t>(footprint.pixels);
+	}
+	[[nodiscard]] std::span<const L3DBone> GetBones() const noexcept { return Get<L3DBone>(&L3DCookedHeader::bones); }
+	[[nodiscard]] std::span<const std::array<float, 3 * 4>> GetExtraMetrics() const noexcept
+	{
+		return Get<std::array<float, 3 * 4>>(&L3DCookedHeader::extraMetrics);
+	}
+	[[nodiscard]] std::span<const L3DPoint> GetHullPoints() const noexcept
+	{
+		return Get<L3DPoint>(&L3DCookedHeader::hullPoints);
+	}
+	[[nodiscard]] std::string_view GetNameData() const noexcept;
+
+private:
+	template <typename T>
+	[[nodiscard]] std::span<const T> Get(L3DCookedBlock block) const noexcept
+	{
+		// Blocks are validated when the file is opened or cooked
+		return {reinterpret_cast<const T*>(_buffer.data() + block.offset), block.size / sizeof(T)};
+	}
+
+	template <typename T>
+	[[nodiscard]] std::span<const T> Get(L3DCookedBlock L3DCookedHeader::*block) const noexcept
+	{
+		return Get<T>(GetHeader().*block);
+	}
+
+	/// Check the header and that every block is within the buffer, unloads the file if not
+	L3DResult Validate() noexcept;
+
+	/// Set when the file was cooked or read from the filesystem, otherwise the buffer is owned by the caller
+	std::vector<uint8_t> _ownedBuffer;
+	std::span<const uint8_t> _buffer;
+};
+
+} // namespace openblack::l3d
@@ -48,6 +48,8 @@ enum class L3DResult : uint8_t
 	ErrBadFootprintMeshOffset,
 	ErrBadFootprintTextureOffset,
 	ErrBadFootprintPixelOffset,
+	ErrCookedVersionMismatch,
+	ErrBadCookedBlock,
 };
 
 std::string_view ResultToStr(L3DResult result);
@@ -346,7 +348,7 @@ class L3DFile
 	L3DResult Open(const std::filesystem::path& filepath) noexcept;
 
 	/// Read l3d file from a buffer
-	L3DResult Open(const std::vector<uint8_t>& buffer) noexcept;
+	L3DResult Open(std::span<const uint8_t> buffer) noexcept;
 
 	/// Write l3d file to path on the filesystem
 	L3DResult Write(const std::filesystem::path& filepath) noexcept;
@@ -394,6 +396,7 @@ class L3DFile
 	void AddPrimitives(const std::vector<L3DPrimitiveHeader>& headers) noexcept;
 	void AddVertices(const std::vector<L3DVertex>& vertices) noexcept;
 	void AddIndices(const std::vector<uint16_t>& indices) noexcept;
+	void AddVertexGroups(const std::vector<L3DVertexGroup>& vertexGroups) noexcept;
 	void AddBones(const std::vector<L3DBone>& bones) noexcept;
 };
 
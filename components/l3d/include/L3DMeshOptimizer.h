@@ -0,0 +1,57 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <array>
+#include <span>
+#include <vector>
+
+#include "L3DFile.h"
+
+namespace openblack::l3d
+{
+
+/// Size of the post-transform vertex cache simulated to measure index orders
+constexpr uint32_t k_VertexCacheSize = 16;
+/// Size of the cache lines and number of lines simulated to measure vertex fetches
+constexpr uint32_t k_VertexFetchLineSize = 64;
+constexpr uint32_t k_VertexFetchLineCount = 64;
+
+/**
+  Reorder the triangles of a triangle list so that vertices are reused while they are in the post-transform cache.
+
+  Uses Tom Forsyth's linear-speed vertex cache optimisation. The triangles are only reordered, their winding is kept.
+ */
+void OptimizeVertexCache(std::span<uint16_t> indices, uint32_t vertexCount) noexcept;
+
+/**
+  Number vertices in the order in which they are first referenced so that vertex fetches are mostly sequential.
+
+  Indices are rewritten in place. Vertices which are never referenced are kept, after all the referenced ones.
+  Returns the new position of each vertex, the vertices themselves are to be moved by the caller.
+ */
+std::vector<uint32_t> OptimizeVertexFetch(std::span<uint16_t> indices, uint32_t vertexCount) noexcept;
+
+/// Average number of vertices transformed per triangle with a FIFO cache of k_VertexCacheSize, 0.5 is optimal
+[[nodiscard]] float AverageCacheMissRatio(std::span<const uint16_t> indices, uint32_t vertexCount) noexcept;
+
+/// Bytes read from vertex memory with a FIFO cache of cache lines, relative to the size of the referenced vertices
+[[nodiscard]] float VertexFetchOverfetch(std::span<const uint16_t> indices, uint32_t vertexCount,
+                                         uint32_t vertexStride) noexcept;
+
+/// Map a normal to two components in [-1, 1] by projecting it onto an octahedron
+[[nodiscard]] std::array<float, 2> EncodeOctahedral(const L3DPoint& normal) noexcept;
+
+/// Quantize a value in [-1, 1] to a normalized 16 bit integer
+[[nodiscard]] int16_t QuantizeSnorm16(float value) noexcept;
+
+} // namespace openblack::l3d
@@ -0,0 +1,626 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+/*
+ * The layout of a cooked L3D File is as follows:
+ *
+ * - 112 byte header (see L3DCookedHeader)
+ *         magic number, containing 4 chars "L3DC"
+ *         version - files of other versions are rejected and cooked again
+ *         source hash - 8 bytes, hash of the file the mesh was cooked from
+ *         size - size of the whole file
+ *         flags - flags of the L3D header
+ *         door position - 4 bytes boolean followed by a point
+ *         hull optimized - 4 bytes boolean
+ *         footprint texture width and height
+ *         submesh, skin, footprint, bone, extra metrics, hull and name blocks,
+ *         each as an offset and a size in bytes
+ *
+ * Every block starts at a multiple of 16 bytes from the start of the file.
+ *
+ * ------------------------ start of submesh data blocks -----------------------
+ *
+ * - For each submesh, in order:
+ *         vertices - 36 bytes * vertex count, position, uv, normal and two
+ *                    16 bit bone indices
+ *         compact vertices - 20 bytes * vertex count, the same vertices with
+ *                            16 bit normalized position, octahedral normal
+ *                            and uv, followed by the bone indices
+ *         indices - 2 bytes * index count, relative to the first vertex of
+ *                   the submesh, in the order of the post-transform cache
+ *         primitives - 20 bytes * primitive count, skin id, first index,
+ *                      index count, material type and alpha cutout threshold
+ *
+ * ------------------------ start of submesh block -----------------------------
+ *
+ * - 100 bytes * submesh count, each record containing:
+ *         flags
+ *         minimum and maximum of the bounding box, with bones applied
+ *         offset and scale decoding compact positions and uvs
+ *         vertex, compact vertex, index and primitive blocks
+ *
+ * ------------------------ start of skin block --------------------------------
+ *
+ * - 131076 bytes * skin count, as in the L3D
+ *
+ * ------------------------ start of footprint blocks --------------------------
+ *
+ * - For each footprint entry:
+ *         vertices - 16 bytes * 3 * triangle count, position and uv
+ *         pixels - 2 bytes * texture width * texture height
+ * - 16 bytes * footprint entry count, vertex and pixel blocks
+ *
+ * ------------------------ start of remaining blocks --------------------------
+ *
+ * - bones - 60 bytes * bone count, as in the L3D
+ * - extra metrics - 48 bytes * matrix count, as in the L3D
+ * - hull points - 12 bytes * point count, the vertices of the last physics
+ *                 submesh, reduced to their convex hull if hull optimized is set
+ * - name - name data of the L3D, not null terminated
+ */
+
+#include "L3DCookedFile.h"
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <utility>
+
+#include "L3DMeshOptimizer.h"
+
+using namespace openblack::l3d;
+
+namespace
+{
+/// Buffer to which blocks are appended at aligned offsets
+class Builder
+{
+public:
+	explicit Builder(size_t headerSize)
+	    : _buffer(headerSize)
+	{
+	}
+
+	template <typename T>
+	L3DCookedBlock Append(std::span<const T> items)
+	{
+		Align();
+		const auto offset = static_cast<uint32_t>(_buffer.size());
+		const auto* bytes = reinterpret_cast<const uint8_t*>(items.data());
+		_buffer.insert(_buffer.end(), bytes, bytes + items.size_bytes());
+		return {offset, static_cast<uint32_t>(items.size_bytes())};
+	}
+
+	void Align()
+	{
+		constexpr size_t k_Mask = L3DCookedFile::k_BlockAlignment - 1;
+		_buffer.resize((_buffer.size() + k_Mask) & ~k_Mask);
+	}
+
+	[[nodiscard]] std::vector<uint8_t>& GetBuffer() { return _buffer; }
+
+private:
+	std::vector<uint8_t> _buffer;
+};
+
+/// Rotation stored by columns, followed by a translation
+struct Transform
+{
+	std::array<float, 9> rotation {1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+	L3DPoint translation {0.0f, 0.0f, 0.0f};
+
+	[[nodiscard]] L3DPoint Rotate(const L3DPoint& point) const
+	{
+		return {
+		    rotation[0] * point.x + rotation[3] * point.y + rotation[6] * point.z,
+		    rotation[1] * point.x + rotation[4] * point.y + rotation[7] * point.z,
+		    rotation[2] * point.x + rotation[5] * point.y + rotation[8] * point.z,
+		};
+	}
+
+	[[nodiscard]] L3DPoint Apply(const L3DPoint& point) const
+	{
+		const auto rotated = Rotate(point);
+		return {rotated.x + translation.x, rotated.y + translation.y, rotated.z + translation.z};
+	}
+
+	/// This transform applied after other
+	[[nodiscard]] Transform operator*(const Transform& other) const
+	{
+		Transform result;
+		for (uint32_t column = 0; column < 3; ++column)
+		{
+			const auto* axis = &other.rotation.at(column * 3);
+			const auto rotated = Rotate({axis[0], axis[1], axis[2]});
+			result.rotation[column * 3] = rotated.x;
+			result.rotation[column * 3 + 1] = rotated.y;
+			result.rotation[column * 3 + 2] = rotated.z;
+		}
+		result.translation = Apply(other.translation);
+		return result;
+	}
+};
+
+/// The bone's orientation, translated by its position expressed in the orientation's frame
+Transform BoneTransform(const L3DBone& bone)
+{
+	Transform transform;
+	transform.rotation = bone.orientation;
+	const L3DPoint translation = {
+	    bone.position.x * bone.orientation[0] + bone.position.y * bone.orientation[1] + bone.position.z * bone.orientation[2],
+	    bone.position.x * bone.orientation[3] + bone.position.y * bone.orientation[4] + bone.position.z * bone.orientation[5],
+	    bone.position.x * bone.orientation[6] + bone.position.y * bone.orientation[7] + bone.position.z * bone.orientation[8],
+	};
+	transform.translation = transform.Rotate(translation);
+	return transform;
+}
+
+void Expand(L3DCookedSubmesh& submesh, const L3DPoint& position)
+{
+	submesh.minima = {std::min(submesh.minima.x, position.x), std::min(submesh.minima.y, position.y),
+	                  std::min(submesh.minima.z, position.z)};
+	submesh.maxima = {std::max(submesh.maxima.x, position.x), std::max(submesh.maxima.y, position.y),
+	                  std::max(submesh.maxima.z, position.z)};
+}
+
+bool HasFlag(L3DMeshFlags flags, L3DMeshFlags flag)
+{
+	return (static_cast<uint32_t>(flags) & static_cast<uint32_t>(flag)) != 0;
+}
+
+/// Offset and scale mapping [-1, 1] to [minimum, maximum]
+std::pair<float, float> QuantizationRange(float minimum, float maximum)
+{
+	const float scale = (maximum - minimum) * 0.5f;
+	return {minimum + scale, scale > 0.0f ? scale : 1.0f};
+}
+
+std::vector<L3DCookedCompactVertex> Quantize(L3DCookedSubmesh& submesh, std::span<const L3DCookedVertex> vertices)
+{
+	constexpr auto k_Max = std::numeric_limits<float>::max();
+	constexpr auto k_Lowest = std::numeric_limits<float>::lowest();
+	std::array<float, 5> minima = {k_Max, k_Max, k_Max, k_Max, k_Max};
+	std::array<float, 5> maxima = {k_Lowest, k_Lowest, k_Lowest, k_Lowest, k_Lowest};
+	for (const auto& vertex : vertices)
+	{
+		const std::array<float, 5> values = {
+		    vertex.position.x, vertex.position.y, vertex.position.z, vertex.texCoord.x, vertex.texCoord.y,
+		};
+		for (uint32_t i = 0; i < values.size(); ++i)
+		{
+			minima.at(i) = std::min(minima.at(i), values.at(i));
+			maxima.at(i) = std::max(maxima.at(i), values.at(i));
+		}
+	}
+
+	std::array<std::pair<float, float>, 5> ranges;
+	for (uint32_t i = 0; i < ranges.size(); ++i)
+	{
+		ranges.at(i) = QuantizationRange(minima.at(i), maxima.at(i));
+	}
+	submesh.positionOffset = {ranges[0].first, ranges[1].first, ranges[2].first};
+	submesh.positionScale = {ranges[0].second, ranges[1].second, ranges[2].second};
+	submesh.texCoordOffset = {ranges[3].first, ranges[4].first};
+	submesh.texCoordScale = {ranges[3].second, ranges[4].second};
+
+	const auto quantize = [&ranges](uint32_t i, float value) {
+		return QuantizeSnorm16((value - ranges.at(i).first) / ranges.at(i).second);
+	};
+	std::vector<L3DCookedCompactVertex> compact;
+	compact.reserve(vertices.size());
+	for (const auto& vertex : vertices)
+	{
+		const auto normal = EncodeOctahedral(vertex.normal);
+		compact.push_back({
+		    {quantize(0, vertex.position.x), quantize(1, vertex.position.y), quantize(2, vertex.position.z), 0},
+		    {QuantizeSnorm16(normal[0]), QuantizeSnorm16(normal[1])},
+		    {quantize(3, vertex.texCoord.x), quantize(4, vertex.texCoord.y)},
+		    vertex.boneIndices,
+		});
+	}
+	return compact;
+}
+
+/// Submeshes without vertices or indices are kept with empty blocks, they can't be drawn
+L3DCookedSubmesh CookSubmesh(const L3DFile& l3d, uint32_t meshIndex, bool optimizeIndices, Builder& builder)
+{
+	const auto& header = l3d.GetSubmeshHeaders()[meshIndex];
+	const auto& primitiveSpan = l3d.GetPrimitiveSpan(meshIndex);
+	const auto& verticesSpan = l3d.GetVertexSpan(meshIndex);
+	const auto& indexSpan = l3d.GetIndexSpan(meshIndex);
+	const auto& vertexGroupSpans = l3d.GetVertexGroupSpan(meshIndex);
+	const auto& boneSpans = l3d.GetBoneSpan(meshIndex);
+
+	L3DCookedSubmesh submesh {};
+	submesh.flags = header.flags;
+	constexpr auto k_Max = std::numeric_limits<float>::max();
+	constexpr auto k_Lowest = std::numeric_limits<float>::lowest();
+	submesh.minima = {k_Max, k_Max, k_Max};
+	submesh.maxima = {k_Lowest, k_Lowest, k_Lowest};
+
+	// Count vertices and indices
+	uint32_t nVertices = 0;
+	uint32_t nIndices = 0;
+	for (const auto& primitive : primitiveSpan)
+	{
+		nVertices += primitive.numVertices;
+		nIndices += primitive.numTriangles * 3;
+	}
+	if (nVertices > verticesSpan.size() || nIndices > indexSpan.size())
+	{
+		return submesh;
+	}
+
+	// Construct bounding box
+	if (submesh.flags.hasBones)
+	{
+		for (const auto& primitive : primitiveSpan)
+		{
+			uint32_t vertexOffset = 0;
+			for (uint32_t i = 0; i < primitive.numGroups && i < vertexGroupSpans.size(); ++i)
+			{
+				Transform transform;
+				for (uint32_t parent = vertexGroupSpans[i].boneIndex; parent < boneSpans.size();
+				     parent = boneSpans[parent].parent)
+				{
+					transform = BoneTransform(boneSpans[parent]) * transform;
+				}
+
+				for (uint32_t j = 0; j < vertexGroupSpans[i].vertexCount && vertexOffset + j < nVertices; ++j)
+				{
+					Expand(submesh, transform.Apply(verticesSpan[vertexOffset + j].position));
+				}
+				vertexOffset += vertexGroupSpans[i].vertexCount;
+			}
+		}
+	}
+	else
+	{
+		for (uint32_t i = 0; i < nVertices; i++)
+		{
+			Expand(submesh, verticesSpan[i].position);
+		}
+	}
+
+	if (nVertices == 0 || nIndices == 0)
+	{
+		return submesh;
+	}
+
+	std::vector<L3DCookedVertex> vertices(nVertices);
+	for (uint32_t i = 0; i < nVertices; ++i)
+	{
+		// TODO(bwrsandman): build normals from mesh
+		vertices[i] = {verticesSpan[i].position, verticesSpan[i].texCoord, verticesSpan[i].normal, {-1, -1}};
+	}
+
+	// Fill bone index
+	uint32_t vertexIndex = 0;
+	for (const auto& vertexGroupSpan : vertexGroupSpans)
+	{
+		for (uint32_t i = 0; i < vertexGroupSpan.vertexCount && vertexIndex < nVertices; ++i)
+		{
+			vertices[vertexIndex].boneIndices = {static_cast<int16_t>(vertexGroupSpan.boneIndex), -1};
+			vertexIndex++;
+		}
+	}
+
+	// Fix indices for merged vertex buffer
+	std::vector<uint16_t> indices(nIndices);
+	std::vector<L3DCookedPrimitive> primitives;
+	primitives.reserve(primitiveSpan.size());
+	uint16_t startIndex = 0;
+	uint16_t startVertex = 0;
+	for (const auto& primitive : primitiveSpan)
+	{
+		for (uint32_t j = 0; j < primitive.numTriangles * 3; j++)
+		{
+			indices[startIndex + j] = static_cast<uint16_t>(indexSpan[startIndex + j] + startVertex);
+		}
+
+		primitives.push_back({
+		    primitive.material.skinID,
+		    startIndex,
+		    primitive.numTriangles * 3,
+		    primitive.material.type,
+		    primitive.material.alphaCutoutThreshold,
+		});
+
+		startVertex += static_cast<uint16_t>(primitive.numVertices);
+		startIndex += static_cast<uint16_t>(primitive.numTriangles * 3);
+	}
+
+	// Triangles can only move within their primitive, vertices are then numbered in the order they are first used
+	const bool indicesInRange = std::ranges::all_of(indices, [nVertices](uint16_t index) { return index < nVertices; });
+	if (optimizeIndices && indicesInRange)
+	{
+		for (const auto& primitive : primitives)
+		{
+			OptimizeVertexCache(std::span(indices).subspan(primitive.indicesOffset, primitive.indicesCount), nVertices);
+		}
+		const auto remap = OptimizeVertexFetch(indices, nVertices);
+		std::vector<L3DCookedVertex> reordered(nVertices);
+		for (uint32_t i = 0; i < nVertices; ++i)
+		{
+			reordered[remap[i]] = vertices[i];
+		}
+		vertices = std::move(reordered);
+	}
+
+	submesh.vertices = builder.Append<L3DCookedVertex>(vertices);
+	submesh.compactVertices = builder.Append<L3DCookedCompactVertex>(Quantize(submesh, vertices));
+	submesh.indices = builder.Append<uint16_t>(indices);
+	submesh.primitives = builder.Append<L3DCookedPrimitive>(primitives);
+	return submesh;
+}
+
+template <typename T>
+bool IsValid(const L3DCookedBlock& block, size_t bufferSize)
+{
+	return block.offset % alignof(T) == 0 && block.size % sizeof(T) == 0 && block.offset <= bufferSize &&
+	       block.size <= bufferSize - block.offset;
+}
+} // namespace
+
+L3DCookedFile::L3DCookedFile() noexcept = default;
+L3DCookedFile::~L3DCookedFile() noexcept = default;
+
+uint64_t L3DCookedFile::HashSource(std::span<const uint8_t> source) noexcept
+{
+	// FNV-1a
+	uint64_t hash = 0xcbf29ce484222325;
+	for (const auto byte : source)
+	{
+		hash = (hash ^ byte) * 0x100000001b3;
+	}
+	return hash;
+}
+
+std::string L3DCookedFile::GetCacheFilename(uint64_t sourceHash) noexcept
+{
+	std::array<char, 32> name;
+	std::snprintf(name.data(), name.size(), "%016llx.l3dc", static_cast<unsigned long long>(sourceHash));
+	return name.data();
+}
+
+L3DResult L3DCookedFile::Cook(const L3DFile& l3d, uint64_t sourceHash, const HullOptimizer& optimizeHull,
+                               bool optimizeIndices) noexcept
+{
+	Builder builder(sizeof(L3DCookedHeader));
+	L3DCookedHeader header {};
+	header.magic = k_Magic;
+	header.version = k_Version;
+	header.sourceHash = sourceHash;
+	header.flags = l3d.GetHeader().flags;
+
+	if (HasFlag(header.flags, L3DMeshFlags::HasDoorPosition) && !l3d.GetExtraPoints().empty())
+	{
+		header.hasDoorPosition = 1;
+		header.doorPosition = l3d.GetExtraPoints()[0];
+	}
+
+	std::vector<L3DCookedSubmesh> submeshes;
+	std::vector<L3DPoint> hullPoints;
+	submeshes.reserve(l3d.GetSubmeshHeaders().size());
+	for (uint32_t i = 0; i < l3d.GetSubmeshHeaders().size(); ++i)
+	{
+		const auto& submesh = submeshes.emplace_back(CookSubmesh(l3d, i, optimizeIndices, builder));
+		// FIXME(bwrsandman): Some meshes have multiple physics meshes
+		if (submesh.flags.isPhysics && submesh.vertices.size > 0)
+		{
+			const auto& verticesSpan = l3d.GetVertexSpan(i);
+			hullPoints.resize(verticesSpan.size());
+			for (size_t j = 0; j < verticesSpan.size(); ++j)
+			{
+				hullPoints[j] = verticesSpan[j].position;
+			}
+		}
+	}
+	header.submeshes = builder.Append<L3DCookedSubmesh>(submeshes);
+	header.skins = builder.Append<L3DTexture>(l3d.GetSkins());
+
+	if (HasFlag(header.flags, L3DMeshFlags::ContainsLandscapeFeature) && l3d.GetFootprint().has_value())
+	{
+		const auto& footprint = *l3d.GetFootprint();
+		header.footprintWidth = footprint.header.width;
+		header.footprintHeight = footprint.header.height;
+
+		std::vector<L3DCookedFootprint> footprints;
+		footprints.reserve(footprint.entries.size());
+		for (const auto& entry : footprint.entries)
+		{
+			std::vector<L3DCookedFootprintVertex> vertices;
+			vertices.reserve(entry.triangles.size() * 3);
+			for (const auto& triangle : entry.triangles)
+			{
+				for (uint32_t k = 0; k < 3; ++k)
+				{
+					const auto& uv = triangle.texture.at(k);
+					vertices.push_back({
+					    triangle.world.at(k),
+					    {uv.x / static_cast<float>(footprint.header.width), uv.y / static_cast<float>(footprint.header.height)},
+					});
+				}
+			}
+			auto& cooked = footprints.emplace_back();
+			cooked.vertices = builder.Append<L3DCookedFootprintVertex>(vertices);
+			cooked.pixels = builder.Append<uint16_t>(entry.pixels);
+		}
+		header.footprints = builder.Append<L3DCookedFootprint>(footprints);
+	}
+
+	header.bones = builder.Append<L3DBone>(l3d.GetBones());
+	if (HasFlag(header.flags, L3DMeshFlags::ContainsExtraMetrics))
+	{
+		header.extraMetrics = builder.Append<std::array<float, 3 * 4>>(l3d.GetExtraMetrics());
+	}
+
+	if (optimizeHull && !hullPoints.empty())
+	{
+		hullPoints = optimizeHull(hullPoints);
+		header.hullOptimized = 1;
+	}
+	header.hullPoints = builder.Append<L3DPoint>(hullPoints);
+	header.nameData = builder.Append<char>(l3d.GetNameData());
+
+	builder.Align();
+	auto& buffer = builder.GetBuffer();
+	header.size = static_cast<uint32_t>(buffer.size());
+	std::memcpy(buffer.data(), &header, sizeof(header));
+
+	_ownedBuffer = std::move(buffer);
+	_buffer = _ownedBuffer;
+	return Validate();
+}
+
+L3DResult L3DCookedFile::Open(std::span<const uint8_t> buffer) noexcept
+{
+	_ownedBuffer.clear();
+	_buffer = buffer;
+	return Validate();
+}
+
+L3DResult L3DCookedFile::Open(const std::filesystem::path& filepath) noexcept
+{
+	std::ifstream stream(filepath, std::ios::binary | std::ios::ate);
+	if (!stream.is_open())
+	{
+		return L3DResult::ErrCantOpen;
+	}
+
+	std::vector<uint8_t> buffer(static_cast<size_t>(stream.tellg()));
+	stream.seekg(0);
+	if (!stream.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size())))
+	{
+		return L3DResult::ErrFileTooSmall;
+	}
+
+	_ownedBuffer = std::move(buffer);
+	_buffer = _ownedBuffer;
+	return Validate();
+}
+
+L3DResult L3DCookedFile::Write(const std::filesystem::path& filepath) const noexcept
+{
+	assert(IsLoaded());
+
+	std::ofstream stream(filepath, std::ios::binary);
+	if (!stream.is_open())
+	{
+		return L3DResult::ErrCantOpen;
+	}
+
+	stream.write(reinterpret_cast<const char*>(_buffer.data()), static_cast<std::streamsize>(_buffer.size()));
+	return stream ? L3DResult::Success : L3DResult::ErrCantOpen;
+}
+
+std::optional<L3DPoint> L3DCookedFile::GetDoorPosition() const noexcept
+{
+	if (GetHeader().hasDoorPosition == 0)
+	{
+		return std::nullopt;
+	}
+	return GetHeader().doorPosition;
+}
+
+std::string_view L3DCookedFile::GetNameData() const noexcept
+{
+	const auto name = Get<char>(&L3DCookedHeader::nameData);
+	return {name.data(), name.size()};
+}
+
+L3DResult L3DCookedFile::Validate() noexcept
+{
+	const auto result = [this]() {
+		if (_buffer.size() < sizeof(L3DCookedHeader))
+		{
+			return L3DResult::ErrFileTooSmall;
+		}
+		if (reinterpret_cast<uintptr_t>(_buffer.data()) % alignof(L3DCookedHeader) != 0)
+		{
+			return L3DResult::ErrBadCookedBlock;
+		}
+
+		const auto& header = GetHeader();
+		if (header.magic != k_Magic)
+		{
+			return L3DResult::ErrBadHeader;
+		}
+		if (header.version != k_Version)
+		{
+			return L3DResult::ErrCookedVersionMismatch;
+		}
+		if (header.size != _buffer.size())
+		{
+			return L3DResult::ErrFileTooSmall;
+		}
+
+		const auto size = _buffer.size();
+		if (!IsValid<L3DCookedSubmesh>(header.submeshes, size) || !IsValid<L3DTexture>(header.skins, size) ||
+		    !IsValid<L3DCookedFootprint>(header.footprints, size) || !IsValid<L3DBone>(header.bones, size) ||
+		    !IsValid<std::array<float, 3 * 4>>(header.extraMetrics, size) || !IsValid<L3DPoint>(header.hullPoints, size) ||
+		    !IsValid<char>(header.nameData, size))
+		{
+			return L3DResult::ErrBadCookedBlock;
+		}
+
+		for (const auto& submesh : GetSubmeshes())
+		{
+			if (!IsValid<L3DCookedVertex>(submesh.vertices, size) ||
+			    !IsValid<L3DCookedCompactVertex>(submesh.compactVertices, size) ||
+			    !IsValid<uint16_t>(submesh.indices, size) || !IsValid<L3DCookedPrimitive>(submesh.primitives, size))
+			{
+				return L3DResult::ErrBadCookedBlock;
+			}
+			if (GetCompactVertices(submesh).size() != GetVertices(submesh).size())
+			{
+				return L3DResult::ErrBadCookedBlock;
+			}
+			const auto indexCount = GetIndices(submesh).size();
+			for (const auto& primitive : GetPrimitives(submesh))
+			{
+				if (primitive.indicesOffset > indexCount || primitive.indicesCount > indexCount - primitive.indicesOffset)
+				{
+					return L3DResult::ErrBadTriangleCount;
+				}
+				if (primitive.materialType >= L3DMaterial::Type::_Count)
+				{
+					return L3DResult::ErrBadPrimitiveCount;
+				}
+			}
+		}
+
+		const auto pixelCount = static_cast<size_t>(header.footprintWidth) * header.footprintHeight;
+		for (const auto& footprint : GetFootprints())
+		{
+			if (!IsValid<L3DCookedFootprintVertex>(footprint.vertices, size) || !IsValid<uint16_t>(footprint.pixels, size))
+			{
+				return L3DResult::ErrBadCookedBlock;
+			}
+			if (GetFootprintPixels(footprint).size() < pixelCount)
+			{
+				return L3DResult::ErrBadFootprintPixelOffset;
+			}
+		}
+
+		return L3DResult::Success;
+	}();
+
+	if (result != L3DResult::Success)
+	{
+		// Leave the file unloaded
+		_ownedBuffer.clear();
+		_buffer = {};
+	}
+	return result;
+}
@@ -290,6 +290,10 @@ std::string_view openblack::l3d::ResultToStr(L3DResult result)
 		return "Footprint texture data go beyond footprint data.";
 	case L3DResult::ErrBadFootprintPixelOffset:
 		return "Footprint pixel data go beyond footprint data.";
+	case L3DResult::ErrCookedVersionMismatch:
+		return "Cooked file was made by another version.";
+	case L3DResult::ErrBadCookedBlock:
+		return "Cooked data is beyond the size of the file.";
 	}
 	std::unreachable();
 }
@@ -872,11 +876,11 @@ L3DResult L3DFile::Open(const std::filesystem::path& filepath) noexcept
 	return ReadFile(stream);
 }
 
-L3DResult L3DFile::Open(const std::vector<uint8_t>& buffer) noexcept
+L3DResult L3DFile::Open(std::span<const uint8_t> buffer) noexcept
 {
 	assert(!_isLoaded);
 
-	imemstream stream(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(buffer[0]));
+	imemstream stream(reinterpret_cast<const char*>(buffer.data()), buffer.size_bytes());
 
 	return ReadFile(stream);
 }
@@ -995,6 +999,16 @@ void L3DFile::AddIndices(const std::vector<uint16_t>& indices) noexcept
 	_indexSpans.emplace_back(&_indices[static_cast<uint32_t>(size)], static_cast<uint32_t>(indices.size()));
 }
 
+void L3DFile::AddVertexGroups(const std::vector<L3DVertexGroup>& vertexGroups) noexcept
+{
+	auto size = _vertexGroups.size();
+	for (const auto& vertexGroup : vertexGroups)
+	{
+		_vertexGroups.push_back(vertexGroup);
+	}
+	_vertexGroupSpans.emplace_back(&_vertexGroups[static_cast<uint32_t>(size)], static_cast<uint32_t>(vertexGroups.size()));
+}
+
 void L3DFile::AddBones(const std::vector<L3DBone>& bones) noexcept
 {
 	auto size = _boneSpans.size();
@@ -0,0 +1,278 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "L3DMeshOptimizer.h"
+
+#include <cmath>
+
+#include <algorithm>
+#include <deque>
+#include <limits>
+
+using namespace openblack::l3d;
+
+namespace
+{
+// Scoring constants from the original description of the algorithm
+constexpr uint32_t k_ScoringCacheSize = 32;
+constexpr float k_CacheDecayPower = 1.5f;
+constexpr float k_LastTriangleScore = 0.75f;
+constexpr float k_ValenceBoostScale = 2.0f;
+constexpr float k_ValenceBoostPower = 0.5f;
+constexpr int32_t k_NotCached = -1;
+
+float VertexScore(int32_t cachePosition, uint32_t liveTriangles)
+{
+	if (liveTriangles == 0)
+	{
+		// No triangle needs this vertex anymore
+		return -1.0f;
+	}
+
+	float score = 0.0f;
+	if (cachePosition >= 0)
+	{
+		if (cachePosition < 3)
+		{
+			// Vertices of the last triangle get a fixed score so that the next triangle doesn't simply reuse its edge
+			score = k_LastTriangleScore;
+		}
+		else
+		{
+			const float scaler = 1.0f / static_cast<float>(k_ScoringCacheSize - 3);
+			score = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scaler, k_CacheDecayPower);
+		}
+	}
+
+	// Finish off vertices with few triangles left so they don't linger
+	score += k_ValenceBoostScale * std::pow(static_cast<float>(liveTriangles), -k_ValenceBoostPower);
+	return score;
+}
+} // namespace
+
+void openblack::l3d::OptimizeVertexCache(std::span<uint16_t> indices, uint32_t vertexCount) noexcept
+{
+	const auto triangleCount = static_cast<uint32_t>(indices.size() / 3);
+	if (triangleCount < 2)
+	{
+		return;
+	}
+
+	// Triangles of each vertex, the first liveTriangles[v] entries are the ones not yet emitted
+	std::vector<uint32_t> liveTriangles(vertexCount, 0);
+	for (uint32_t i = 0; i < triangleCount * 3; ++i)
+	{
+		++liveTriangles[indices[i]];
+	}
+	std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+	for (uint32_t v = 0; v < vertexCount; ++v)
+	{
+		adjacencyOffsets[v + 1] = adjacencyOffsets[v] + liveTriangles[v];
+	}
+	std::vector<uint32_t> adjacency(adjacencyOffsets[vertexCount]);
+	std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+	for (uint32_t t = 0; t < triangleCount; ++t)
+	{
+		for (uint32_t k = 0; k < 3; ++k)
+		{
+			adjacency[fill[indices[t * 3 + k]]++] = t;
+		}
+	}
+
+	std::vector<float> vertexScores(vertexCount);
+	for (uint32_t v = 0; v < vertexCount; ++v)
+	{
+		vertexScores[v] = VertexScore(k_NotCached, liveTriangles[v]);
+	}
+	std::vector<bool> emitted(triangleCount, false);
+	std::vector<uint16_t> result;
+	result.reserve(triangleCount * 3);
+	std::vector<uint32_t> cache;
+	std::vector<uint32_t> newCache;
+	cache.reserve(k_ScoringCacheSize + 3);
+	newCache.reserve(k_ScoringCacheSize + 3);
+
+	uint32_t bestTriangle = std::numeric_limits<uint32_t>::max();
+	uint32_t cursor = 0;
+	for (uint32_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount)
+	{
+		if (bestTriangle == std::numeric_limits<uint32_t>::max())
+		{
+			// Nothing in the cache is connected to what is left, start again from the next triangle
+			while (emitted[cursor])
+			{
+				++cursor;
+			}
+			bestTriangle = cursor;
+		}
+
+		const auto triangle = bestTriangle;
+		emitted[triangle] = true;
+		newCache.clear();
+		for (uint32_t k = 0; k < 3; ++k)
+		{
+			const auto vertex = indices[triangle * 3 + k];
+			result.push_back(vertex);
+			newCache.push_back(vertex);
+
+			// Remove the triangle from the live triangles of the vertex
+			auto* begin = &adjacency[adjacencyOffsets[vertex]];
+			auto* end = begin + liveTriangles[vertex];
+			std::iter_swap(std::find(begin, end, triangle), end - 1);
+			--liveTriangles[vertex];
+		}
+		for (const auto vertex : cache)
+		{
+			if (std::find(newCache.begin(), newCache.end(), vertex) == newCache.end())
+			{
+				newCache.push_back(vertex);
+			}
+		}
+		for (uint32_t i = k_ScoringCacheSize; i < newCache.size(); ++i)
+		{
+			vertexScores[newCache[i]] = VertexScore(k_NotCached, liveTriangles[newCache[i]]);
+		}
+		newCache.resize(std::min<size_t>(newCache.size(), k_ScoringCacheSize));
+		std::swap(cache, newCache);
+
+		for (uint32_t i = 0; i < cache.size(); ++i)
+		{
+			vertexScores[cache[i]] = VertexScore(static_cast<int32_t>(i), liveTriangles[cache[i]]);
+		}
+
+		// Only the triangles of cached vertices changed score
+		float bestScore = -1.0f;
+		bestTriangle = std::numeric_limits<uint32_t>::max();
+		for (const auto vertex : cache)
+		{
+			for (uint32_t i = 0; i < liveTriangles[vertex]; ++i)
+			{
+				const auto t = adjacency[adjacencyOffsets[vertex] + i];
+				const float score =
+				    vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+				if (score > bestScore)
+				{
+					bestScore = score;
+					bestTriangle = t;
+				}
+			}
+		}
+	}
+
+	std::copy(result.begin(), result.end(), indices.begin());
+}
+
+std::vector<uint32_t> openblack::l3d::OptimizeVertexFetch(std::span<uint16_t> indices, uint32_t vertexCount) noexcept
+{
+	constexpr auto k_Unmapped = std::numeric_limits<uint32_t>::max();
+	std::vector<uint32_t> remap(vertexCount, k_Unmapped);
+	uint32_t next = 0;
+	for (auto& index : indices)
+	{
+		if (remap[index] == k_Unmapped)
+		{
+			remap[index] = next++;
+		}
+		index = static_cast<uint16_t>(remap[index]);
+	}
+	for (auto& position : remap)
+	{
+		if (position == k_Unmapped)
+		{
+			position = next++;
+		}
+	}
+	return remap;
+}
+
+float openblack::l3d::AverageCacheMissRatio(std::span<const uint16_t> indices, uint32_t vertexCount) noexcept
+{
+	if (indices.size() < 3)
+	{
+		return 0.0f;
+	}
+
+	std::vector<uint32_t> insertedAt(vertexCount, 0);
+	uint32_t misses = 0;
+	for (const auto index : indices)
+	{
+		// A vertex is still cached if fewer than k_VertexCacheSize other vertices were inserted since it was
+		if (insertedAt[index] == 0 || misses + 1 - insertedAt[index] > k_VertexCacheSize)
+		{
+			++misses;
+			insertedAt[index] = misses;
+		}
+	}
+	return static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+}
+
+float openblack::l3d::VertexFetchOverfetch(std::span<const uint16_t> indices, uint32_t vertexCount,
+                                           uint32_t vertexStride) noexcept
+{
+	std::vector<bool> referenced(vertexCount, false);
+	uint32_t referencedCount = 0;
+	std::deque<uint32_t> lines;
+	uint64_t fetched = 0;
+	for (const auto index : indices)
+	{
+		if (!referenced[index])
+		{
+			referenced[index] = true;
+			++referencedCount;
+		}
+
+		const uint32_t first = index * vertexStride / k_VertexFetchLineSize;
+		const uint32_t last = (index * vertexStride + vertexStride - 1) / k_VertexFetchLineSize;
+		for (uint32_t line = first; line <= last; ++line)
+		{
+			if (std::find(lines.begin(), lines.end(), line) == lines.end())
+			{
+				fetched += k_VertexFetchLineSize;
+				lines.push_back(line);
+				if (lines.size() > k_VertexFetchLineCount)
+				{
+					lines.pop_front();
+				}
+			}
+		}
+	}
+
+	if (referencedCount == 0)
+	{
+		return 0.0f;
+	}
+	return static_cast<float>(fetched) / static_cast<float>(static_cast<uint64_t>(referencedCount) * vertexStride);
+}
+
+std::array<float, 2> openblack::l3d::EncodeOctahedral(const L3DPoint& normal) noexcept
+{
+	const float length = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+	if (length == 0.0f)
+	{
+		return {0.0f, 0.0f};
+	}
+
+	float x = normal.x / length;
+	float y = normal.y / length;
+	if (normal.z < 0.0f)
+	{
+		// Fold the lower half of the octahedron over the upper one
+		const float foldedX = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+		const float foldedY = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+		x = foldedX;
+		y = foldedY;
+	}
+	return {x, y};
+}
+
+int16_t openblack::l3d::QuantizeSnorm16(float value) noexcept
+{
+	constexpr float k_Max = std::numeric_limits<int16_t>::max();
+	return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * k_Max));
+}
@@ -0,0 +1,137 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+ * Single file archive of a game directory, designed to be memory mapped.
+ *
+ * Layout:
+ * - AssetArchiveHeader
+ * - entry data, uncompressed entries start on a k_AssetArchiveAlignment boundary
+ * - name table: the relative path of each entry with forward slashes, not null terminated
+ * - table of contents: AssetArchiveEntry sorted by case insensitive name
+ */
+
+namespace openblack::pack
+{
+
+enum class AssetArchiveResult : uint8_t
+{
+	Success = 0,
+	ErrCantOpen,
+	ErrFileTooSmall,
+	ErrUnrecognizedHeader,
+	ErrUnsupportedVersion,
+	ErrMisalignedTableOfContents,
+	ErrEntryOutOfBounds,
+	ErrUnsortedEntries,
+	ErrDuplicateEntry,
+	ErrWriteFailed,
+};
+
+std::string_view ResultToStr(AssetArchiveResult result);
+
+enum class AssetCompression : uint32_t
+{
+	None = 0,
+	Zlib = 1,
+};
+
+constexpr uint32_t k_AssetArchiveVersion = 1;
+/// Page size of most platforms, lets uncompressed entries be handed out or mapped without any copy
+constexpr uint64_t k_AssetArchiveAlignment = 0x1000;
+
+struct AssetArchiveHeader
+{
+	std::array<char, 4> magic;
+	uint32_t version;
+	uint32_t entryCount;
+	uint32_t nameTableSize;
+	uint64_t nameTableOffset;
+	uint64_t tableOfContentsOffset;
+};
+static_assert(sizeof(AssetArchiveHeader) == 32);
+
+struct AssetArchiveEntry
+{
+	uint64_t offset;
+	uint64_t storedSize;
+	uint64_t size;
+	uint32_t nameOffset;
+	uint32_t nameSize;
+	AssetCompression compression;
+	uint32_t reserved;
+};
+static_assert(sizeof(AssetArchiveEntry) == 40);
+
+/// Read only view of an archive held in memory, nothing is copied out of the data given to Open
+class AssetArchive
+{
+public:
+	/// Validate the header and table of contents of archive data which must outlive this object
+	AssetArchiveResult Open(std::span<const uint8_t> data) noexcept;
+
+	/// Case insensitive lookup of a relative path with forward slashes
+	[[nodiscard]] const AssetArchiveEntry* Find(std::string_view path) const noexcept;
+	/// Entries whose path starts with the directory, recursively
+	[[nodiscard]] std::span<const AssetArchiveEntry> FindDirectory(std::string_view directory) const noexcept;
+
+	[[nodiscard]] std::span<const AssetArchiveEntry> GetEntries() const noexcept { return _entries; }
+	[[nodiscard]] std::string_view GetName(const AssetArchiveEntry& entry) const noexcept;
+	/// Data as stored, compressed entries have to be inflated to entry.size bytes
+	[[nodiscard]] std::span<const uint8_t> GetStoredData(const AssetArchiveEntry& entry) const noexcept;
+
+	/// Ordering of the table of contents, ASCII case insensitive
+	[[nodiscard]] static int Compare(std::string_view left, std::string_view right) noexcept;
+
+private:
+	std::span<const uint8_t> _data;
+	std::span<const AssetArchiveEntry> _entries;
+	std::string_view _names;
+};
+
+/// Streams entries to disk as they are added, the table of contents is written by Finish
+/// The output is removed on the first error and when the writer is destroyed before Finish, so a failed write never
+/// leaves a file which looks like an archive
+class AssetArchiveWriter
+{
+public:
+	AssetArchiveWriter() = default;
+	AssetArchiveWriter(const AssetArchiveWriter&) = delete;
+	AssetArchiveWriter& operator=(const AssetArchiveWriter&) = delete;
+	~AssetArchiveWriter();
+
+	AssetArchiveResult Open(const std::filesystem::path& path) noexcept;
+	/// Add the data of an entry, compressed by the caller when compression is not None
+	AssetArchiveResult Add(std::string_view path, std::span<const uint8_t> storedData, AssetCompression compression,
+	                       uint64_t size) noexcept;
+	AssetArchiveResult Finish() noexcept;
+
+private:
+	AssetArchiveResult Discard(AssetArchiveResult result) noexcept;
+
+	std::filesystem::path _path;
+	std::ofstream _stream;
+	std::vector<AssetArchiveEntry> _entries;
+	std::string _names;
+	uint64_t _offset = 0;
+};
+
+} // namespace openblack::pack
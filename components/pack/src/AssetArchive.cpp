@@ -0,0 +1,298 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "AssetArchive.h"
+
+#include <cassert>
+#include <cstring>
+
+#include <algorithm>
+
+using namespace openblack::pack;
+
+namespace
+{
+constexpr std::array<char, 4> k_Magic = {'O', 'B', 'A', 'R'};
+
+constexpr char ToLower(char c) noexcept
+{
+	return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+bool StartsWith(std::string_view string, std::string_view prefix) noexcept
+{
+	return string.size() >= prefix.size() && AssetArchive::Compare(string.substr(0, prefix.size()), prefix) == 0;
+}
+} // namespace
+
+std::string_view openblack::pack::ResultToStr(AssetArchiveResult result)
+{
+	switch (result)
+	{
+	case AssetArchiveResult::Success:
+		return "Success";
+	case AssetArchiveResult::ErrCantOpen:
+		return "Could not open file.";
+	case AssetArchiveResult::ErrFileTooSmall:
+		return "File too small to be a valid asset archive.";
+	case AssetArchiveResult::ErrUnrecognizedHeader:
+		return "Unrecognized asset archive header.";
+	case AssetArchiveResult::ErrUnsupportedVersion:
+		return "Unsupported asset archive version.";
+	case AssetArchiveResult::ErrMisalignedTableOfContents:
+		return "Table of contents is not aligned.";
+	case AssetArchiveResult::ErrEntryOutOfBounds:
+		return "Entry lies outside of the archive.";
+	case AssetArchiveResult::ErrUnsortedEntries:
+		return "Table of contents is not sorted.";
+	case AssetArchiveResult::ErrDuplicateEntry:
+		return "Two entries have the same path.";
+	case AssetArchiveResult::ErrWriteFailed:
+		return "Could not write to file.";
+	}
+	return "Unknown error.";
+}
+
+int AssetArchive::Compare(std::string_view left, std::string_view right) noexcept
+{
+	const auto size = std::min(left.size(), right.size());
+	for (size_t i = 0; i < size; ++i)
+	{
+		const auto l = ToLower(left[i]);
+		const auto r = ToLower(right[i]);
+		if (l != r)
+		{
+			return static_cast<unsigned char>(l) < static_cast<unsigned char>(r) ? -1 : 1;
+		}
+	}
+	if (left.size() == right.size())
+	{
+		return 0;
+	}
+	return left.size() < right.size() ? -1 : 1;
+}
+
+AssetArchiveResult AssetArchive::Open(std::span<const uint8_t> data) noexcept
+{
+	if (data.size() < sizeof(AssetArchiveHeader))
+	{
+		return AssetArchiveResult::ErrFileTooSmall;
+	}
+	AssetArchiveHeader header;
+	std::memcpy(&header, data.data(), sizeof(header));
+	if (header.magic != k_Magic)
+	{
+		return AssetArchiveResult::ErrUnrecognizedHeader;
+	}
+	if (header.version != k_AssetArchiveVersion)
+	{
+		return AssetArchiveResult::ErrUnsupportedVersion;
+	}
+
+	const auto tocSize = static_cast<uint64_t>(header.entryCount) * sizeof(AssetArchiveEntry);
+	if (header.nameTableOffset > data.size() || header.nameTableSize > data.size() - header.nameTableOffset ||
+	    header.tableOfContentsOffset > data.size() || tocSize > data.size() - header.tableOfContentsOffset)
+	{
+		return AssetArchiveResult::ErrEntryOutOfBounds;
+	}
+	const auto* toc = data.data() + header.tableOfContentsOffset;
+	if (reinterpret_cast<uintptr_t>(toc) % alignof(AssetArchiveEntry) != 0)
+	{
+		return AssetArchiveResult::ErrMisalignedTableOfContents;
+	}
+
+	_data = data;
+	_entries = {reinterpret_cast<const AssetArchiveEntry*>(toc), header.entryCount};
+	_names = {reinterpret_cast<const char*>(data.data() + header.nameTableOffset), header.nameTableSize};
+
+	for (size_t i = 0; i < _entries.size(); ++i)
+	{
+		const auto& entry = _entries[i];
+		if (entry.offset > data.size() || entry.storedSize > data.size() - entry.offset ||
+		    entry.nameOffset > _names.size() || entry.nameSize > _names.size() - entry.nameOffset ||
+		    (entry.compression == AssetCompression::None && entry.storedSize != entry.size))
+		{
+			*this = {};
+			return AssetArchiveResult::ErrEntryOutOfBounds;
+		}
+		if (i > 0 && Compare(GetName(_entries[i - 1]), GetName(entry)) >= 0)
+		{
+			*this = {};
+			return AssetArchiveResult::ErrUnsortedEntries;
+		}
+	}
+
+	return AssetArchiveResult::Success;
+}
+
+const AssetArchiveEntry* AssetArchive::Find(std::string_view path) const noexcept
+{
+	const auto iter = std::ranges::lower_bound(
+	    _entries, path, [](std::string_view left, std::string_view right) { return Compare(left, right) < 0; },
+	    [this](const AssetArchiveEntry& entry) { return GetName(entry); });
+	if (iter == _entries.end() || Compare(GetName(*iter), path) != 0)
+	{
+		return nullptr;
+	}
+	return &*iter;
+}
+
+std::span<const AssetArchiveEntry> AssetArchive::FindDirectory(std::string_view directory) const noexcept
+{
+	if (directory.empty())
+	{
+		return _entries;
+	}
+
+	std::string prefix(directory);
+	if (prefix.back() != '/')
+	{
+		prefix += '/';
+	}
+	const auto less = [](std::string_view left, std::string_view right) { return Compare(left, right) < 0; };
+	const auto name = [this](const AssetArchiveEntry& entry) { return GetName(entry); };
+	const auto first = std::ranges::lower_bound(_entries, std::string_view(prefix), less, name);
+	const auto last = std::find_if(first, _entries.end(), [&name, &prefix](const AssetArchiveEntry& entry) {
+		return !StartsWith(name(entry), prefix);
+	});
+	return {first, last};
+}
+
+std::string_view AssetArchive::GetName(const AssetArchiveEntry& entry) const noexcept
+{
+	return _names.substr(entry.nameOffset, entry.nameSize);
+}
+
+std::span<const uint8_t> AssetArchive::GetStoredData(const AssetArchiveEntry& entry) const noexcept
+{
+	return _data.subspan(entry.offset, entry.storedSize);
+}
+
+AssetArchiveWriter::~AssetArchiveWriter()
+{
+	if (_stream.is_open())
+	{
+		Discard(AssetArchiveResult::ErrWriteFailed);
+	}
+}
+
+AssetArchiveResult AssetArchiveWriter::Discard(AssetArchiveResult result) noexcept
+{
+	_stream.close();
+	std::error_code ec;
+	std::filesystem::remove(_path, ec);
+	_entries.clear();
+	_names.clear();
+	return result;
+}
+
+AssetArchiveResult AssetArchiveWriter::Open(const std::filesystem::path& path) noexcept
+{
+	_path = path;
+	_stream.open(path, std::ios::binary);
+	if (!_stream.is_open())
+	{
+		return AssetArchiveResult::ErrCantOpen;
+	}
+
+	// Written for real once the table of contents is known
+	const AssetArchiveHeader header {};
+	_stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	_offset = sizeof(header);
+	_entries.clear();
+	_names.clear();
+
+	return _stream.good() ? AssetArchiveResult::Success : Discard(AssetArchiveResult::ErrWriteFailed);
+}
+
+AssetArchiveResult AssetArchiveWriter::Add(std::string_view path, std::span<const uint8_t> storedData,
+                                           AssetCompression compression, uint64_t size) noexcept
+{
+	assert(compression != AssetCompression::None || storedData.size() == size);
+	if (!_stream.is_open())
+	{
+		return AssetArchiveResult::ErrWriteFailed;
+	}
+
+	if (compression == AssetCompression::None)
+	{
+		const auto padding = (k_AssetArchiveAlignment - _offset % k_AssetArchiveAlignment) % k_AssetArchiveAlignment;
+		const std::array<char, k_AssetArchiveAlignment> zeros {};
+		_stream.write(zeros.data(), static_cast<std::streamsize>(padding));
+		_offset += padding;
+	}
+
+	_entries.push_back({
+	    .offset = _offset,
+	    .storedSize = storedData.size(),
+	    .size = size,
+	    .nameOffset = static_cast<uint32_t>(_names.size()),
+	    .nameSize = static_cast<uint32_t>(path.size()),
+	    .compression = compression,
+	    .reserved = 0,
+	});
+	_names += path;
+
+	_stream.write(reinterpret_cast<const char*>(storedData.data()), static_cast<std::streamsize>(storedData.size()));
+	_offset += storedData.size();
+
+	return _stream.good() ? AssetArchiveResult::Success : Discard(AssetArchiveResult::ErrWriteFailed);
+}
+
+AssetArchiveResult AssetArchiveWriter::Finish() noexcept
+{
+	if (!_stream.is_open())
+	{
+		return AssetArchiveResult::ErrWriteFailed;
+	}
+
+	const auto name = [this](const AssetArchiveEntry& entry) {
+		return std::string_view(_names).substr(entry.nameOffset, entry.nameSize);
+	};
+	std::ranges::sort(_entries, [&name](const auto& left, const auto& right) {
+		return AssetArchive::Compare(name(left), name(right)) < 0;
+	});
+	const auto duplicate = std::ranges::adjacent_find(_entries, [&name](const auto& left, const auto& right) {
+		return AssetArchive::Compare(name(left), name(right)) == 0;
+	});
+	if (duplicate != _entries.end())
+	{
+		return Discard(AssetArchiveResult::ErrDuplicateEntry);
+	}
+
+	AssetArchiveHeader header {
+	    .magic = k_Magic,
+	    .version = k_AssetArchiveVersion,
+	    .entryCount = static_cast<uint32_t>(_entries.size()),
+	    .nameTableSize = static_cast<uint32_t>(_names.size()),
+	    .nameTableOffset = _offset,
+	    .tableOfContentsOffset = 0,
+	};
+	_stream.write(_names.data(), static_cast<std::streamsize>(_names.size()));
+	_offset += _names.size();
+
+	const auto padding = (alignof(AssetArchiveEntry) - _offset % alignof(AssetArchiveEntry)) % alignof(AssetArchiveEntry);
+	const std::array<char, alignof(AssetArchiveEntry)> zeros {};
+	_stream.write(zeros.data(), static_cast<std::streamsize>(padding));
+	_offset += padding;
+
+	header.tableOfContentsOffset = _offset;
+	_stream.write(reinterpret_cast<const char*>(_entries.data()),
+	              static_cast<std::streamsize>(_entries.size() * sizeof(AssetArchiveEntry)));
+
+	_stream.seekp(0);
+	_stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	if (!_stream.good())
+	{
+		return Discard(AssetArchiveResult::ErrWriteFailed);
+	}
+	_stream.close();
+
+	return _stream.good() ? AssetArchiveResult::Success : Discard(AssetArchiveResult::ErrWriteFailed);
+}
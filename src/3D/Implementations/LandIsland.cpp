@@ -22,6 +22,8 @@
 #include <stb_image_write.h>
 
 #include "3D/LandBlock.h"
+#include "Common/JobSystem.h"
+#include "Common/MemoryTracker.h"
 #include "Dynamics/LandBlockBulletMeshInterface.h"
 #include "FileSystem/FileSystemInterface.h"
 #include "Graphics/FrameBuffer.h"
@@ -38,6 +40,7 @@ const float LandIslandInterface::k_CellSize = 10.0f;
 
 LandIsland::LandIsland(const std::filesystem::path& path)
 {
+	const MemoryTracker::Scope memory(MemoryTag::Terrain);
 	LoadFromFile(path);
 }
 
@@ -138,10 +141,18 @@ void LandIsland::LoadFromFile(const std::filesystem::path& path)
 	                        Filter::Linear, lnd.GetExtra().bump.texels.data(),
 	                        static_cast<uint32_t>(sizeof(lnd.GetExtra().bump.texels[0]) * lnd.GetExtra().bump.texels.size()));
 
-	// build the meshes (we could move this elsewhere)
-	for (auto& block : _landBlocks)
+	// build the vertices of the blocks in parallel, then the meshes which create bgfx buffers on the main thread
+	std::vector<const bgfx::Memory*> vertices(_landBlocks.size());
+	auto& jobs = Locator::jobs::value();
+	jobs.ParallelFor("LandBlock::BuildVertexList", _landBlocks.size(), 4, [this, &vertices](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+		{
+			vertices[i] = _landBlocks[i].BuildVertexList(*this);
+		}
+	});
+	for (size_t i = 0; i < _landBlocks.size(); ++i)
 	{
-		block.BuildMesh(*this);
+		_landBlocks[i].BuildMesh(vertices[i]);
 	}
 	bgfx::frame();
 }
@@ -10,6 +10,7 @@
 #pragma once
 
 #include <map>
+#include <memory>
 
 #include <glm/vec3.hpp>
 
@@ -22,15 +23,23 @@
 namespace openblack
 {
 
+class TempleRoomStreamer;
+
 class TempleInterior final: public TempleInteriorInterface
 {
 public:
+	~TempleInterior();
+
 	[[nodiscard]] bool Active() const override { return _active; }
 	[[nodiscard]] glm::vec3 GetPosition() const override { return _templePosition; }
 	void Activate() override;
 	void Deactivate() override;
+	void Update() override;
+	[[nodiscard]] bool IsRoomVisible(ecs::components::TempleRoom room) const override;
 
 private:
+	/// Started on the first activation
+	std::unique_ptr<TempleRoomStreamer> _streamer;
 	bool _active;
 	glm::vec3 _templePosition;
 	glm::vec3 _templeRotation;
@@ -9,10 +9,14 @@
 
 #include "L3DMesh.h"
 
+#include <cstring>
+
 #include <filesystem>
+#include <span>
 #include <stdexcept>
 
 #include <BulletCollision/CollisionShapes/btConvexHullShape.h>
+#include <L3DCookedFile.h>
 #include <L3DFile.h>
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtx/vec_swizzle.hpp>
@@ -20,7 +24,10 @@
 #include <spdlog/spdlog.h>
 
 #include "3D/L3DSubMesh.h"
+#include "Common/Zip.h"
+#include "EngineConfig.h"
 #include "FileSystem/FileSystemInterface.h"
+#include "FileSystem/MappedFile.h"
 #include "Graphics/Texture2D.h"
 #include "Graphics/VertexBuffer.h"
 #include "Locator.h"
@@ -28,6 +35,26 @@
 using namespace openblack;
 using namespace openblack::graphics;
 
+namespace
+{
+/// Reduce the physics hull to the vertices of its convex hull so that it is cooked in its final form
+std::vector<l3d::L3DPoint> OptimizeHull(std::span<const l3d::L3DPoint> points)
+{
+	btConvexHullShape shape(reinterpret_cast<const btScalar*>(points.data()), static_cast<int>(points.size()),
+	                        static_cast<int>(sizeof(points[0])));
+	shape.optimizeConvexHull();
+
+	std::vector<l3d::L3DPoint> result;
+	result.reserve(static_cast<size_t>(shape.getNumPoints()));
+	for (int i = 0; i < shape.getNumPoints(); ++i)
+	{
+		const auto& point = shape.getUnscaledPoints()[i];
+		result.push_back({point.x(), point.y(), point.z()});
+	}
+	return result;
+}
+} // namespace
+
 L3DMesh::L3DMesh(std::string debugName) noexcept
     : _flags(static_cast<l3d::L3DMeshFlags>(0))
     , _debugName(std::move(debugName))
@@ -37,89 +64,75 @@ L3DMesh::L3DMesh(std::string debugName) noexcept
 L3DMesh::~L3DMesh() noexcept = default;
 
 bool L3DMesh::Load(const l3d::L3DFile& l3d) noexcept
+{
+	l3d::L3DCookedFile cooked;
+	const auto result = cooked.Cook(l3d, 0, OptimizeHull);
+	if (result != l3d::L3DResult::Success)
+	{
+		SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Failed to cook l3d mesh {}: {}", _debugName, l3d::ResultToStr(result));
+		return false;
+	}
+
+	return Load(cooked);
+}
+
+bool L3DMesh::Load(const l3d::L3DCookedFile& cooked) noexcept
 {
 	bool result = true;
 
-	_flags = static_cast<l3d::L3DMeshFlags>(l3d.GetHeader().flags);
-	_nameData = l3d.GetNameData();
-	for (const auto& skin : l3d.GetSkins())
+	_flags = cooked.GetFlags();
+	_nameData = cooked.GetNameData();
+	for (const auto& skin : cooked.GetSkins())
 	{
+		const auto size = static_cast<uint32_t>(skin.texels.size() * sizeof(skin.texels[0]));
 		_skins[skin.id] = std::make_unique<Texture2D>(_debugName.c_str());
 		_skins[skin.id]->Create(l3d::L3DTexture::k_Width, l3d::L3DTexture::k_Height, 1, Format::BGRA4, Wrapping::Repeat,
-		                        Filter::Linear, skin.texels.data(),
-		                        static_cast<uint32_t>(skin.texels.size() * sizeof(skin.texels[0])));
+		                        Filter::Linear, bgfx::copy(skin.texels.data(), size));
 	}
 
-	if (HasDoorPosition() && !l3d.GetExtraPoints().empty())
+	if (const auto doorPos = cooked.GetDoorPosition(); doorPos.has_value())
 	{
-		_doorPos = glm::vec3(l3d.GetExtraPoints()[0].x, l3d.GetExtraPoints()[0].y, l3d.GetExtraPoints()[0].z);
+		_doorPos = glm::vec3(doorPos->x, doorPos->y, doorPos->z);
 	}
 
-	if (ContainsLandscapeFeature() && l3d.GetFootprint().has_value())
+	if (!cooked.GetFootprints().empty())
 	{
-		struct FootprintVertex
-		{
-			glm::vec2 pos;
-			glm::vec2 texCoord;
-		};
 		VertexDecl decl;
-		decl.reserve(1);
+		decl.reserve(2);
 		decl.emplace_back(VertexAttrib::Attribute::Position, static_cast<uint8_t>(2), VertexAttrib::Type::Float);
 		decl.emplace_back(VertexAttrib::Attribute::TexCoord0, static_cast<uint8_t>(2), VertexAttrib::Type::Float);
 
-		const auto& footprint = *l3d.GetFootprint();
+		const auto& header = cooked.GetHeader();
 
 		// TODO (#749) use use std::views::enumerate
-		for (uint32_t i = 1; const auto& entry : footprint.entries)
+		for (uint32_t i = 1; const auto& footprint : cooked.GetFootprints())
 		{
+			const auto pixels = cooked.GetFootprintPixels(footprint);
+			const auto vertices = cooked.GetFootprintVertices(footprint);
+
 			auto texture = std::make_unique<Texture2D>("footprints/texture/" + _debugName + "/" + std::to_string(i));
 			++i;
-			texture->Create(static_cast<uint16_t>(footprint.header.width), static_cast<uint16_t>(footprint.header.height), 1,
-			                graphics::Format::BGRA4, Wrapping::ClampEdge, Filter::Linear, entry.pixels.data(),
-			                static_cast<uint32_t>(entry.pixels.size() * sizeof(entry.pixels[0])));
-
-			const bgfx::Memory* verticesMem =
-			    bgfx::alloc(static_cast<uint32_t>(sizeof(FootprintVertex) * entry.triangles.size() * 3));
-			auto* vertices = reinterpret_cast<FootprintVertex*>(verticesMem->data);
-			// TODO (#749) Maybe use std::views::enumerate
-			for (uint8_t j = 0; const auto& t : entry.triangles)
-			{
-				for (uint8_t k = 0; k < 3; ++k)
-				{
-					// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index): access is bound to size
-					auto& vertex = vertices[j];
-					++j;
-
-					// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index): access is bound to size
-					const auto& world = t.world[k];
-					// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index): access is bound to size
-					const auto& uv = t.texture[k];
-
-					vertex.pos.x = world.x;
-					vertex.pos.y = world.y;
-					vertex.texCoord.x = uv.x / footprint.header.width;
-					vertex.texCoord.y = uv.y / footprint.header.height;
-				}
-			}
+			texture->Create(static_cast<uint16_t>(header.footprintWidth), static_cast<uint16_t>(header.footprintHeight), 1,
+			                graphics::Format::BGRA4, Wrapping::ClampEdge, Filter::Linear,
+			                bgfx::copy(pixels.data(), static_cast<uint32_t>(pixels.size_bytes())));
 
-			auto* vertexBuffer = new VertexBuffer("footprints/quad/" + _debugName + "/" + std::to_string(i), verticesMem, decl);
+			const auto* verticesMem = bgfx::copy(vertices.data(), static_cast<uint32_t>(vertices.size_bytes()));
+			auto* vertexBuffer =
+			    new VertexBuffer("footprints/quad/" + _debugName + "/" + std::to_string(i), verticesMem, decl);
 			auto mesh = std::make_unique<Mesh>(vertexBuffer);
 			_footprints.emplace_back(Footprint {std::move(texture), std::move(mesh)});
 		}
 	}
 
-	if (ContainsExtraMetrics() && !l3d.GetExtraMetrics().empty())
+	const auto& extraMetrics = cooked.GetExtraMetrics();
+	_extraMetrics.reserve(extraMetrics.size());
+	for (const auto& e : extraMetrics)
 	{
-		const auto& extraMetrics = l3d.GetExtraMetrics();
-		_extraMetrics.reserve(extraMetrics.size());
-		for (const auto& e : extraMetrics)
-		{
-			_extraMetrics.emplace_back(static_cast<glm::mat4>(glm::make_mat4x3(e.data())));
-		}
+		_extraMetrics.emplace_back(static_cast<glm::mat4>(glm::make_mat4x3(e.data())));
 	}
 
 	std::map<uint32_t, glm::mat4> matrices;
-	const auto& bones = l3d.GetBones();
+	const auto& bones = cooked.GetBones();
 	_bonesParents.resize(bones.size());
 	for (uint32_t i = 0; i < bones.size(); ++i)
 	{
@@ -139,25 +152,19 @@ bool L3DMesh::Load(const l3d::L3DFile& l3d) noexcept
 		matrices.emplace(i, matrix);
 	}
 
-	auto submeshCount = l3d.GetSubmeshHeaders().size();
+	auto submeshCount = static_cast<uint32_t>(cooked.GetSubmeshes().size());
 	for (uint32_t i = 0; i < submeshCount; ++i)
 	{
 		auto subMesh = std::make_unique<L3DSubMesh>(*this);
-		if (!subMesh->Load(l3d, i))
+		if (!subMesh->Load(cooked, i))
 		{
 			SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Failed to open L3DSubMesh");
 			result = false;
 			continue;
 		}
-		if (subMesh->GetFlags().isPhysics)
+		if (!subMesh->IsPhysics() && subMesh->GetFlags().status == 0)
 		{
-			const auto& verticesSpan = l3d.GetVertexSpan(i);
-			auto* physicsMesh =
-			    new btConvexHullShape(reinterpret_cast<const btScalar*>(verticesSpan.data()),
-			                          static_cast<int>(verticesSpan.size()), static_cast<int>(sizeof(verticesSpan[0])));
-			physicsMesh->optimizeConvexHull();
-			_physicsMesh.reset(physicsMesh);
-			// FIXME(bwrsandman): Some meshes have multiple physics meshes
+			_lodMask |= static_cast<uint8_t>(subMesh->GetFlags().lodMask);
 		}
 		const auto& bb = subMesh->GetBoundingBox();
 		_boundingBox.minima = glm::min(_boundingBox.minima, bb.minima);
@@ -165,10 +172,21 @@ bool L3DMesh::Load(const l3d::L3DFile& l3d) noexcept
 
 		_subMeshes.emplace_back(std::move(subMesh));
 	}
+
+	// FIXME(bwrsandman): Some meshes have multiple physics meshes, only the last one is cooked
+	if (const auto& hullPoints = cooked.GetHullPoints(); !hullPoints.empty())
+	{
+		auto* physicsMesh = new btConvexHullShape(reinterpret_cast<const btScalar*>(hullPoints.data()),
+		                                          static_cast<int>(hullPoints.size()), static_cast<int>(sizeof(hullPoints[0])));
+		if (!cooked.IsHullOptimized())
+		{
+			physicsMesh->optimizeConvexHull();
+		}
+		_physicsMesh.reset(physicsMesh);
+	}
 	// TODO(bwrsandman): if no physics mesh was found, make physics mesh the bounding box
 
 	// TODO(bwrsandman): store vertex and index buffers at mesh level
-	bgfx::frame();
 
 	return result;
 }
@@ -176,11 +194,11 @@ bool L3DMesh::Load(const l3d::L3DFile& l3d) noexcept
 bool L3DMesh::LoadFromFilesystem(const std::filesystem::path& path) noexcept
 {
 	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading L3DMesh from file: {}", path.generic_string());
-	l3d::L3DFile l3d;
 
+	std::vector<uint8_t> data;
 	try
 	{
-		l3d.ReadFile(*Locator::filesystem::value().GetData(path));
+		data = Locator::filesystem::value().ReadAll(path);
 	}
 	catch (std::runtime_error& err)
 	{
@@ -189,8 +207,7 @@ bool L3DMesh::LoadFromFilesystem(const std::filesystem::path& path) noexcept
 		return false;
 	}
 
-	Load(l3d);
-	return true;
+	return LoadFromBuffer(data);
 }
 
 bool L3DMesh::LoadFromFile(const std::filesystem::path& path) noexcept
@@ -215,20 +232,113 @@ bool L3DMesh::LoadFromFile(const std::filesystem::path& path) noexcept
 	return true;
 }
 
-bool L3DMesh::LoadFromBuffer(const std::vector<uint8_t>& data) noexcept
+bool L3DMesh::LoadFromBuffer(std::span<const uint8_t> data, bool compressed) noexcept
 {
-	l3d::L3DFile l3d;
+	const auto cachePath = Locator::config::has_value() ? Locator::config::value().meshCachePath : std::filesystem::path {};
+	const auto sourceHash = l3d::L3DCookedFile::HashSource(data);
+	const auto cookedPath = cachePath / l3d::L3DCookedFile::GetCacheFilename(sourceHash);
 
-	const auto result = l3d.Open(data);
+	if (!cachePath.empty() && std::filesystem::exists(cookedPath))
+	{
+		try
+		{
+			const filesystem::MappedFile mapping(cookedPath);
+			l3d::L3DCookedFile cooked;
+			const auto result = cooked.Open(mapping.GetData());
+			if (result == l3d::L3DResult::Success && cooked.GetHeader().sourceHash == sourceHash)
+			{
+				if (!Load(cooked))
+				{
+					SPDLOG_LOGGER_WARN(spdlog::get("game"), "Some issues were seen while loading cooked l3d mesh {}.",
+					                   cookedPath.generic_string());
+				}
+				return true;
+			}
+			SPDLOG_LOGGER_INFO(spdlog::get("game"), "Cooking {} again, the cached file is stale: {}", _debugName,
+			                   l3d::ResultToStr(result));
+		}
+		catch (std::runtime_error& err)
+		{
+			SPDLOG_LOGGER_WARN(spdlog::get("game"), "Failed to map cooked l3d mesh {}: {}", cookedPath.generic_string(),
+			                   err.what());
+		}
+	}
+
+	l3d::L3DCookedFile cooked;
+	if (!Cook(data, compressed, _debugName, cooked))
+	{
+		return false;
+	}
+
+	if (!Load(cooked))
+	{
+		SPDLOG_LOGGER_WARN(spdlog::get("game"), "Some issues were seen while loading l3d mesh from buffer.");
+	}
+
+	return true;
+}
+
+bool L3DMesh::Cook(std::span<const uint8_t> data, bool compressed, const std::string& debugName,
+                   l3d::L3DCookedFile& cooked) noexcept
+{
+	const auto cachePath = Locator::config::has_value() ? Locator::config::value().meshCachePath : std::filesystem::path {};
+	const auto sourceHash = l3d::L3DCookedFile::HashSource(data);
+	const auto cookedPath = cachePath / l3d::L3DCookedFile::GetCacheFilename(sourceHash);
+
+	// Read rather than mapped so that the cooked file can be handed over to another thread, stale files are cooked again
+	if (!cachePath.empty() && std::filesystem::exists(cookedPath) &&
+	    cooked.Open(cookedPath) == l3d::L3DResult::Success && cooked.GetHeader().sourceHash == sourceHash)
+	{
+		return true;
+	}
+
+	std::vector<uint8_t> inflated;
+	if (compressed)
+	{
+		// Compressed meshes start with their decompressed size
+		uint32_t inflatedSize = 0;
+		if (data.size() < sizeof(inflatedSize))
+		{
+			SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Failed to open compressed l3d mesh from buffer: too small");
+			return false;
+		}
+		std::memcpy(&inflatedSize, data.data(), sizeof(inflatedSize));
+		try
+		{
+			inflated = zip::Inflate(data.subspan(sizeof(inflatedSize)), inflatedSize);
+		}
+		catch (std::runtime_error& err)
+		{
+			SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Failed to decompress l3d mesh from buffer: {}", err.what());
+			return false;
+		}
+	}
+
+	l3d::L3DFile l3d;
+	auto result = l3d.Open(compressed ? std::span<const uint8_t>(inflated) : data);
 	if (result != l3d::L3DResult::Success)
 	{
 		SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Failed to open l3d mesh from buffer: {}", l3d::ResultToStr(result));
 		return false;
 	}
 
-	if (!Load(l3d))
+	result = cooked.Cook(l3d, sourceHash, OptimizeHull);
+	if (result != l3d::L3DResult::Success)
 	{
-		SPDLOG_LOGGER_WARN(spdlog::get("game"), "Some issues were seen while loading l3d mesh from buffer.");
+		SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Failed to cook l3d mesh {}: {}", debugName, l3d::ResultToStr(result));
+		return false;
+	}
+
+	if (!cachePath.empty())
+	{
+		std::error_code ec;
+		std::filesystem::create_directories(cachePath, ec);
+		result = cooked.Write(cookedPath);
+		if (result != l3d::L3DResult::Success)
+		{
+			SPDLOG_LOGGER_WARN(spdlog::get("game"), "Failed to write cooked l3d mesh {}: {}", cookedPath.generic_string(),
+			                   l3d::ResultToStr(result));
+		}
 	}
 
 	return true;
@@ -12,6 +12,7 @@
 #include <filesystem>
 #include <limits>
 #include <optional>
+#include <span>
 #include <unordered_map>
 #include <vector>
 
@@ -28,6 +29,7 @@ namespace openblack
 {
 namespace l3d
 {
+class L3DCookedFile;
 class L3DFile;
 }
 
@@ -91,10 +93,17 @@ class L3DMesh
 	explicit L3DMesh(std::string debugName = "") noexcept;
 	virtual ~L3DMesh() noexcept;
 
+	/// Cook the mesh in memory and load it, bypassing the mesh cache
 	bool Load(const l3d::L3DFile& l3d) noexcept;
+	/// Buffers and textures are copied for the renderer, the cooked file can be released as soon as this returns
+	bool Load(const l3d::L3DCookedFile& cooked) noexcept;
 	bool LoadFromFilesystem(const std::filesystem::path& path) noexcept;
 	bool LoadFromFile(const std::filesystem::path& path) noexcept;
-	bool LoadFromBuffer(const std::vector<uint8_t>& data) noexcept;
+	/// Load a mesh from the mesh cache, or cook it and add it to the cache, compressed meshes start with their size
+	bool LoadFromBuffer(std::span<const uint8_t> data, bool compressed = false) noexcept;
+	/// Read a mesh from the mesh cache, or cook it and add it to the cache. Doesn't touch the GPU so it can run on any thread
+	static bool Cook(std::span<const uint8_t> data, bool compressed, const std::string& debugName,
+	                 l3d::L3DCookedFile& cooked) noexcept;
 
 	[[nodiscard]] uint8_t GetNumSubMeshes() const { return static_cast<uint8_t>(_subMeshes.size()); }
 	[[nodiscard]] const std::vector<std::unique_ptr<L3DSubMesh>>& GetSubMeshes() const { return _subMeshes; }
@@ -109,6 +118,8 @@ class L3DMesh
 	[[nodiscard]] const btConvexShape& GetPhysicsMesh() const { return *_physicsMesh; }
 	[[nodiscard]] float GetMass() const { return _physicsMass; }
 	[[nodiscard]] AxisAlignedBoundingBox GetBoundingBox() const { return _boundingBox; }
+	/// Levels of detail for which at least one drawable submesh exists, as a submesh lodMask
+	[[nodiscard]] uint8_t GetLodMask() const { return _lodMask; }
 
 private:
 	l3d::L3DMeshFlags _flags;
@@ -124,6 +135,7 @@ class L3DMesh
 	/// Bounding box if no physics mesh was found
 	std::unique_ptr<btConvexShape> _physicsMesh;
 	float _physicsMass {1.0f}; // TODO(bwrsandman): Find somewhere in file a value
+	uint8_t _lodMask {0};
 	AxisAlignedBoundingBox _boundingBox {
 	    {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()},
 	    {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()},
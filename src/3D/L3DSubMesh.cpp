@@ -9,219 +9,173 @@
 
 #include "L3DSubMesh.h"
 
+#include <cassert>
+
+#include <array>
+
 #include <glm/gtc/type_ptr.hpp>
-#include <glm/gtx/component_wise.hpp>
-#include <glm/gtx/vec_swizzle.hpp>
 #include <spdlog/spdlog.h>
 
-#include "Graphics/IndexBuffer.h"
+#include "EngineConfig.h"
+#include "Graphics/RendererInterface.h"
 #include "Graphics/ShaderProgram.h"
 #include "Graphics/VertexBuffer.h"
 #include "L3DMesh.h"
+#include "Locator.h"
 
 using namespace openblack::graphics;
 
 namespace openblack
 {
 
-struct EnhancedL3DVertex
-{
-	glm::vec3 pos;
-	glm::vec2 uv;
-	glm::vec3 norm;
-	glm::i16vec2 index;
-};
-
 L3DSubMesh::L3DSubMesh(L3DMesh& mesh) noexcept
     : _l3dMesh(mesh)
 {
 }
 
-L3DSubMesh::~L3DSubMesh() noexcept = default;
-
-bool L3DSubMesh::Load(const l3d::L3DFile& l3d, uint32_t meshIndex) noexcept
+L3DSubMesh::~L3DSubMesh() noexcept
 {
-	const auto& header = l3d.GetSubmeshHeaders()[meshIndex];
-	const auto primitiveSpan = l3d.GetPrimitiveSpan(meshIndex);
-	const auto& verticesSpan = l3d.GetVertexSpan(meshIndex);
-	const auto& indexSpan = l3d.GetIndexSpan(meshIndex);
-	const auto& vertexGroupSpans = l3d.GetVertexGroupSpan(meshIndex);
-	const auto& boneSpans = l3d.GetBoneSpan(meshIndex);
-
-	_flags = header.flags;
-
-	// Count vertices and indices
-	uint32_t nVertices = 0;
-	uint32_t nIndices = 0;
-	for (auto& primitive : primitiveSpan)
-	{
-		nVertices += primitive.numVertices;
-		nIndices += primitive.numTriangles * 3;
-	}
-
-	// Construct bounding box
-	_boundingBox.maxima = glm::vec3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
-	_boundingBox.minima = glm::vec3(FLT_MAX, FLT_MAX, FLT_MAX);
-	if (_flags.hasBones)
+	// The pools are destroyed with the renderer, along with what meshes outliving it had in them
+	if (!Locator::rendererInterface::has_value())
 	{
-		for (auto& primitive : primitiveSpan)
-		{
-			uint32_t vertexOffset = 0;
-			for (uint32_t i = 0; i < primitive.numGroups; ++i)
-			{
-				auto matrix = glm::identity<glm::mat4>();
-				for (uint32_t parent = vertexGroupSpans[i].boneIndex; parent != std::numeric_limits<uint32_t>::max();
-				     parent = boneSpans[parent].parent)
-				{
-					const auto& bone = boneSpans[parent];
-					const auto orientation = glm::make_mat3(bone.orientation.data());
-					const auto translation = glm::make_vec3(&bone.position.x) * orientation;
-					const auto local = glm::translate(glm::mat4(orientation), translation);
-					matrix = local * matrix;
-				}
-
-				for (uint32_t j = 0; j < vertexGroupSpans[i].vertexCount; ++j)
-				{
-					const auto& vertex = verticesSpan[vertexOffset + j];
-					const auto position = glm::xyz(matrix * glm::vec4(glm::make_vec3(&vertex.position.x), 1.0f));
-					_boundingBox.maxima = glm::max(_boundingBox.maxima, position);
-					_boundingBox.minima = glm::min(_boundingBox.minima, position);
-				}
-				vertexOffset += vertexGroupSpans[i].vertexCount;
-			}
-		}
+		return;
 	}
-	else
+	for (size_t i = 0; i < _allocations.size(); ++i)
 	{
-		for (uint32_t i = 0; i < nVertices; i++)
+		if (_allocations[i].has_value())
 		{
-			const auto position = glm::make_vec3(&verticesSpan[i].position.x);
-			_boundingBox.maxima = glm::max(_boundingBox.maxima, position);
-			_boundingBox.minima = glm::min(_boundingBox.minima, position);
+			Locator::rendererInterface::value().GetL3DMeshPool(static_cast<L3DVertexFormat>(i)).Free(*_allocations[i]);
 		}
 	}
+}
 
-	if (nVertices == 0)
+VertexDecl L3DSubMesh::GetVertexDecl(L3DVertexFormat format)
+{
+	VertexDecl decl;
+	decl.reserve(4);
+	if (format == L3DVertexFormat::Compact)
 	{
-		return false;
+		decl.emplace_back(VertexAttrib::Attribute::Position, static_cast<uint8_t>(4), VertexAttrib::Type::Int16, true);
+		decl.emplace_back(VertexAttrib::Attribute::Normal, static_cast<uint8_t>(2), VertexAttrib::Type::Int16, true);
+		decl.emplace_back(VertexAttrib::Attribute::TexCoord0, static_cast<uint8_t>(2), VertexAttrib::Type::Int16, true);
 	}
-
-	// Get vertices
-	const bgfx::Memory* verticesMem = bgfx::alloc(sizeof(EnhancedL3DVertex) * nVertices);
-	auto* verticesMemAccess = reinterpret_cast<EnhancedL3DVertex*>(verticesMem->data);
-	for (uint32_t i = 0; i < nVertices; ++i)
+	else
 	{
-		verticesMemAccess[i].pos = glm::make_vec3(&verticesSpan[i].position.x);
-		verticesMemAccess[i].uv = glm::make_vec2(&verticesSpan[i].texCoord.x);
-		// TODO(bwrsandman): build normals from mesh
-		verticesMemAccess[i].norm = glm::make_vec3(&verticesSpan[i].normal.x);
-		verticesMemAccess[i].index.x = -1;
-		verticesMemAccess[i].index.y = -1;
+		decl.emplace_back(VertexAttrib::Attribute::Position, static_cast<uint8_t>(3), VertexAttrib::Type::Float);
+		decl.emplace_back(VertexAttrib::Attribute::TexCoord0, static_cast<uint8_t>(2), VertexAttrib::Type::Float);
+		decl.emplace_back(VertexAttrib::Attribute::Normal, static_cast<uint8_t>(3), VertexAttrib::Type::Float);
 	}
+	decl.emplace_back(VertexAttrib::Attribute::Indices, static_cast<uint8_t>(2), VertexAttrib::Type::Int16);
+	return decl;
+}
 
-	if (nIndices == 0)
-	{
-		return false;
-	}
+bool L3DSubMesh::Load(const l3d::L3DCookedFile& cooked, uint32_t meshIndex) noexcept
+{
+	const auto& submesh = cooked.GetSubmeshes()[meshIndex];
+	const auto vertices = cooked.GetVertices(submesh);
+	const auto indices = cooked.GetIndices(submesh);
 
-	// Get Indices
-	const bgfx::Memory* indicesMem = bgfx::alloc(sizeof(uint16_t) * nIndices);
-	auto* indices = reinterpret_cast<uint16_t*>(indicesMem->data);
+	_flags = submesh.flags;
+	_boundingBox.minima = glm::make_vec3(&submesh.minima.x);
+	_boundingBox.maxima = glm::make_vec3(&submesh.maxima.x);
 
-	// Fill bone index
-	uint32_t vertexIndex = 0;
-	for (auto& vertexGroupSpan : vertexGroupSpans)
+	if (vertices.empty() || indices.empty())
 	{
-		for (uint32_t i = 0; i < vertexGroupSpan.vertexCount; ++i)
-		{
-			verticesMemAccess[vertexIndex].index[0] = vertexGroupSpan.boneIndex;
-			verticesMemAccess[vertexIndex].index[1] = -1;
-			vertexIndex++;
-		}
+		return false;
 	}
 
-	uint16_t startIndex = 0;
-	uint16_t startVertex = 0;
-	for (auto& primitive : primitiveSpan)
+	struct MaterialTypeLutEntry
 	{
-		// Fix indices for merged vertex buffer
-		for (uint32_t j = 0; j < primitive.numTriangles * 3; j++)
-		{
-			indices[startIndex + j] = indexSpan[startIndex + j] + startVertex;
-		}
-
-		struct MaterialTypeLutEntry
-		{
-			bool depthWrite;
-			bool alphaTest;
-			L3DSubMesh::Primitive::BlendMode blend;
-			bool modulateAlpha;  ///< Multiply ouput alpha by a uniform
-			bool thresholdAlpha; ///< Dismiss fragments below a certain threshold
-		};
-		static const std::array<MaterialTypeLutEntry, static_cast<uint32_t>(l3d::L3DMaterial::Type::_Count)> materialTypeLut = {
-		    {
-		        {true, false, L3DSubMesh::Primitive::BlendMode::Disabled, false, false},  // Smooth
-		        {true, false, L3DSubMesh::Primitive::BlendMode::Standard, false, false},  // SmoothAlpha
-		        {true, false, L3DSubMesh::Primitive::BlendMode::Disabled, false, false},  // Textured
-		        {true, false, L3DSubMesh::Primitive::BlendMode::Standard, true, false},   // TexturedAlpha
-		        {true, false, L3DSubMesh::Primitive::BlendMode::Standard, false, false},  // AlphaTextured
-		        {true, false, L3DSubMesh::Primitive::BlendMode::Standard, true, false},   // AlphaTexturedAlpha
-		        {false, false, L3DSubMesh::Primitive::BlendMode::Standard, true, false},  // AlphaTexturedAlphaNz
-		        {false, false, L3DSubMesh::Primitive::BlendMode::Standard, false, false}, // SmoothAlphaNz
-		        {false, false, L3DSubMesh::Primitive::BlendMode::Standard, true, false},  // TexturedAlphaNz
-		        {true, true, L3DSubMesh::Primitive::BlendMode::Standard, false, true},    // TexturedChroma
-		        {true, true, L3DSubMesh::Primitive::BlendMode::Additive, true, true},     // AlphaTexturedAlphaAdditiveChroma
-		        {false, true, L3DSubMesh::Primitive::BlendMode::Additive, true, true},    // AlphaTexturedAlphaAdditiveChromaNz
-		        {true, false, L3DSubMesh::Primitive::BlendMode::Additive, true, false},   // AlphaTexturedAlphaAdditive
-		        {false, false, L3DSubMesh::Primitive::BlendMode::Additive, true, false},  // AlphaTexturedAlphaAdditiveNz
-		        {false, false, L3DSubMesh::Primitive::BlendMode::Disabled, false, false}, // 0xe
-		        {true, true, L3DSubMesh::Primitive::BlendMode::Standard, true, true},     // TexturedChromaAlpha
-		        {false, true, L3DSubMesh::Primitive::BlendMode::Standard, true, true},    // TexturedChromaAlphaNz
-		        {false, false, L3DSubMesh::Primitive::BlendMode::Disabled, false, false}, // 0x11
-		        {true, true, L3DSubMesh::Primitive::BlendMode::Standard, false, true},    // ChromaJustZ
-		    }};
-
-		assert(static_cast<uint32_t>(primitive.material.type) != 0xe);
-		assert(static_cast<uint32_t>(primitive.material.type) != 0x11);
-		const auto& lutEntry = materialTypeLut.at(static_cast<uint32_t>(primitive.material.type));
+		bool depthWrite;
+		bool alphaTest;
+		L3DSubMesh::Primitive::BlendMode blend;
+		bool modulateAlpha;  ///< Multiply ouput alpha by a uniform
+		bool thresholdAlpha; ///< Dismiss fragments below a certain threshold
+	};
+	static const std::array<MaterialTypeLutEntry, static_cast<uint32_t>(l3d::L3DMaterial::Type::_Count)> materialTypeLut = {
+	    {
+	        {true, false, L3DSubMesh::Primitive::BlendMode::Disabled, false, false},  // Smooth
+	        {true, false, L3DSubMesh::Primitive::BlendMode::Standard, false, false},  // SmoothAlpha
+	        {true, false, L3DSubMesh::Primitive::BlendMode::Disabled, false, false},  // Textured
+	        {true, false, L3DSubMesh::Primitive::BlendMode::Standard, true, false},   // TexturedAlpha
+	        {true, false, L3DSubMesh::Primitive::BlendMode::Standard, false, false},  // AlphaTextured
+	        {true, false, L3DSubMesh::Primitive::BlendMode::Standard, true, false},   // AlphaTexturedAlpha
+	        {false, false, L3DSubMesh::Primitive::BlendMode::Standard, true, false},  // AlphaTexturedAlphaNz
+	        {false, false, L3DSubMesh::Primitive::BlendMode::Standard, false, false}, // SmoothAlphaNz
+	        {false, false, L3DSubMesh::Primitive::BlendMode::Standard, true, false},  // TexturedAlphaNz
+	        {true, true, L3DSubMesh::Primitive::BlendMode::Standard, false, true},    // TexturedChroma
+	        {true, true, L3DSubMesh::Primitive::BlendMode::Additive, true, true},     // AlphaTexturedAlphaAdditiveChroma
+	        {false, true, L3DSubMesh::Primitive::BlendMode::Additive, true, true},    // AlphaTexturedAlphaAdditiveChromaNz
+	        {true, false, L3DSubMesh::Primitive::BlendMode::Additive, true, false},   // AlphaTexturedAlphaAdditive
+	        {false, false, L3DSubMesh::Primitive::BlendMode::Additive, true, false},  // AlphaTexturedAlphaAdditiveNz
+	        {false, false, L3DSubMesh::Primitive::BlendMode::Disabled, false, false}, // 0xe
+	        {true, true, L3DSubMesh::Primitive::BlendMode::Standard, true, true},     // TexturedChromaAlpha
+	        {false, true, L3DSubMesh::Primitive::BlendMode::Standard, true, true},    // TexturedChromaAlphaNz
+	        {false, false, L3DSubMesh::Primitive::BlendMode::Disabled, false, false}, // 0x11
+	        {true, true, L3DSubMesh::Primitive::BlendMode::Standard, false, true},    // ChromaJustZ
+	    }};
+
+	for (const auto& primitive : cooked.GetPrimitives(submesh))
+	{
+		assert(static_cast<uint32_t>(primitive.materialType) != 0xe);
+		assert(static_cast<uint32_t>(primitive.materialType) != 0x11);
+		const auto& lutEntry = materialTypeLut.at(static_cast<uint32_t>(primitive.materialType));
 
 		// TODO(bwrsandman): Interpret cull mode, color byte ordering and render mode, then store in primitive
 		_primitives.emplace_back(Primitive {
-		    primitive.material.skinID,
-		    startIndex,
-		    primitive.numTriangles * 3,
+		    primitive.skinID,
+		    primitive.indicesOffset,
+		    primitive.indicesCount,
 		    lutEntry.depthWrite,
 		    lutEntry.alphaTest,
 		    lutEntry.blend,
 		    lutEntry.modulateAlpha,
 		    lutEntry.thresholdAlpha,
-		    primitive.material.alphaCutoutThreshold / 255.0f,
+		    static_cast<float>(primitive.alphaCutoutThreshold) / 255.0f,
 		});
-
-		startVertex += static_cast<uint16_t>(primitive.numVertices);
-		startIndex += static_cast<uint16_t>(primitive.numTriangles * 3);
 	}
 
-	VertexDecl decl;
-	decl.reserve(4);
-	decl.emplace_back(VertexAttrib::Attribute::Position, static_cast<uint8_t>(3), VertexAttrib::Type::Float);
-	decl.emplace_back(VertexAttrib::Attribute::TexCoord0, static_cast<uint8_t>(2), VertexAttrib::Type::Float);
-	decl.emplace_back(VertexAttrib::Attribute::Normal, static_cast<uint8_t>(3), VertexAttrib::Type::Float);
-	decl.emplace_back(VertexAttrib::Attribute::Indices, static_cast<uint8_t>(2), VertexAttrib::Type::Int16);
-
-	// build our buffers
-	auto* vertexBuffer = new VertexBuffer(_l3dMesh.GetDebugName(), verticesMem, decl);
-	auto* indexBuffer = new IndexBuffer(_l3dMesh.GetDebugName(), indicesMem, IndexBuffer::Type::Uint16);
-	_mesh = std::make_unique<graphics::Mesh>(vertexBuffer, indexBuffer);
+	_vertexCount = static_cast<uint32_t>(vertices.size());
+	_indexCount = static_cast<uint32_t>(indices.size());
+	_vertexDecode = {
+	    glm::vec4(glm::make_vec3(&submesh.positionOffset.x), 0.0f),
+	    glm::vec4(glm::make_vec3(&submesh.positionScale.x), 0.0f),
+	    glm::vec4(glm::make_vec2(&submesh.texCoordOffset.x), glm::make_vec2(&submesh.texCoordScale.x)),
+	};
+
+	// Formats switched between at runtime are both loaded
+	const bool hasConfig = Locator::config::has_value();
+	const bool loadCompact = hasConfig && Locator::config::value().loadCompactMeshVertices;
+	const bool loadFull = !hasConfig || Locator::config::value().loadFullMeshVertices || !loadCompact;
+
+	// Copied, as the cooked file is usually a mapping released before the renderer consumes the memory
+	const auto compactVertices = cooked.GetCompactVertices(submesh);
+	for (const auto format : {L3DVertexFormat::Full, L3DVertexFormat::Compact})
+	{
+		const bool compact = format == L3DVertexFormat::Compact;
+		if (!(compact ? loadCompact : loadFull))
+		{
+			continue;
+		}
+		const bgfx::Memory* verticesMem =
+		    compact ? bgfx::copy(compactVertices.data(), static_cast<uint32_t>(compactVertices.size_bytes()))
+		            : bgfx::copy(vertices.data(), static_cast<uint32_t>(vertices.size_bytes()));
+		const bgfx::Memory* indicesMem = bgfx::copy(indices.data(), static_cast<uint32_t>(indices.size_bytes()));
+
+		// Copy into the shared buffers, indices stay relative to the submesh's first vertex
+		auto allocation = Locator::rendererInterface::value().GetL3DMeshPool(format).Allocate(verticesMem, indicesMem);
+		if (!allocation.has_value())
+		{
+			SPDLOG_LOGGER_ERROR(spdlog::get("graphics"), "{} submesh {}: failed to allocate {} verts and {} indices",
+			                    _l3dMesh.GetDebugName(), meshIndex, _vertexCount, _indexCount);
+			return false;
+		}
+		_allocations.at(static_cast<size_t>(format)) = allocation;
+	}
 
 	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "{} submesh {} with {} verts and {} indices", _l3dMesh.GetDebugName(), meshIndex,
-	                    nVertices, nIndices);
+	                    _vertexCount, _indexCount);
 	return true;
 }
 
-Mesh& L3DSubMesh::GetMesh() const
-{
-	return *_mesh;
-}
-
 } // namespace openblack
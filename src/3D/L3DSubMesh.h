@@ -11,22 +11,32 @@
 
 #include <cstdint>
 
+#include <array>
 #include <memory>
+#include <optional>
 #include <vector>
 
-#include <L3DFile.h>
+#include <L3DCookedFile.h>
 #include <bgfx/bgfx.h>
 
 #include "AxisAlignedBoundingBox.h"
 
+#include "../Graphics/MeshPool.h"
 #include "../Graphics/RenderPass.h"
 
 namespace openblack::graphics
 {
 class L3DMesh;
-class Mesh;
 class ShaderProgram;
 
+/// Layout of the vertices of L3D submeshes, each stored in its own \ref MeshPool
+enum class L3DVertexFormat : uint8_t
+{
+	Full,    ///< Floating point positions, normals and texture coordinates
+	Compact, ///< 16 bit positions and texture coordinates within the submesh's ranges, octahedral normals
+	_Count,
+};
+
 class L3DSubMesh
 {
 	struct Primitive
@@ -53,11 +63,35 @@ class L3DSubMesh
 	explicit L3DSubMesh(graphics::L3DMesh& mesh) noexcept;
 	~L3DSubMesh() noexcept;
 
-	bool Load(const l3d::L3DFile& l3d, uint32_t meshIndex) noexcept;
+	/// Vertex layout of all L3D submeshes of a format, shared by the renderer's L3D \ref MeshPool of that format
+	static VertexDecl GetVertexDecl(L3DVertexFormat format);
+
+	bool Load(const l3d::L3DCookedFile& cooked, uint32_t meshIndex) noexcept;
 
 	[[nodiscard]] openblack::l3d::L3DSubmeshHeader::Flags GetFlags() const { return _flags; }
 	[[nodiscard]] bool IsPhysics() const { return _flags.isPhysics; }
-	[[nodiscard]] graphics::Mesh& GetMesh() const;
+	[[nodiscard]] bool HasVertexFormat(L3DVertexFormat format) const
+	{
+		return _allocations.at(static_cast<size_t>(format)).has_value();
+	}
+	/// The preferred format if it was loaded, otherwise the one that was
+	[[nodiscard]] L3DVertexFormat SelectVertexFormat(L3DVertexFormat preferred) const
+	{
+		if (HasVertexFormat(preferred))
+		{
+			return preferred;
+		}
+		return preferred == L3DVertexFormat::Full ? L3DVertexFormat::Compact : L3DVertexFormat::Full;
+	}
+	/// Location of the submesh's vertices and indices within the L3D \ref MeshPool of a loaded format
+	[[nodiscard]] const MeshPool::Allocation& GetAllocation(L3DVertexFormat format) const
+	{
+		return *_allocations.at(static_cast<size_t>(format));
+	}
+	/// Position offset and scale, then texture coordinate offset and scale decoding compact vertices in the shaders
+	[[nodiscard]] const std::array<glm::vec4, 3>& GetVertexDecode() const { return _vertexDecode; }
+	[[nodiscard]] uint32_t GetVertexCount() const { return _vertexCount; }
+	[[nodiscard]] uint32_t GetIndexCount() const { return _indexCount; }
 	[[nodiscard]] const AxisAlignedBoundingBox& GetBoundingBox() const { return _boundingBox; }
 	[[nodiscard]] const std::vector<Primitive>& GetPrimitives() const { return _primitives; }
 
@@ -66,7 +100,10 @@ class L3DSubMesh
 
 	openblack::l3d::L3DSubmeshHeader::Flags _flags;
 
-	std::unique_ptr<graphics::Mesh> _mesh;
+	std::array<std::optional<MeshPool::Allocation>, static_cast<size_t>(L3DVertexFormat::_Count)> _allocations;
+	std::array<glm::vec4, 3> _vertexDecode {};
+	uint32_t _vertexCount {0};
+	uint32_t _indexCount {0};
 	std::vector<Primitive> _primitives;
 
 	AxisAlignedBoundingBox _boundingBox;
@@ -35,7 +35,7 @@ LandVertex::LandVertex(const glm::vec3& position, const glm::vec3& weight, const
 {
 }
 
-void LandBlock::BuildMesh(LandIslandInterface& island)
+void LandBlock::BuildMesh(const bgfx::Memory* vertices)
 {
 	if (_mesh != nullptr)
 	{
@@ -58,13 +58,11 @@ void LandBlock::BuildMesh(LandIslandInterface& island)
 	// water alpha
 	decl.emplace_back(VertexAttrib::Attribute::Color3, static_cast<uint8_t>(1), VertexAttrib::Type::Float, true);
 
-	const auto* verts = BuildVertexList(island);
-
-	auto* vertexBuffer = new VertexBuffer("LandBlock", verts, decl);
+	auto* vertexBuffer = new VertexBuffer("LandBlock", vertices, decl);
 	_mesh = std::make_unique<Mesh>(vertexBuffer);
 
-	_dynamicsMeshInterface =
-	    std::make_unique<dynamics::LandBlockBulletMeshInterface>(verts->data, verts->size, vertexBuffer->GetStrideBytes());
+	_dynamicsMeshInterface = std::make_unique<dynamics::LandBlockBulletMeshInterface>(vertices->data, vertices->size,
+	                                                                                  vertexBuffer->GetStrideBytes());
 
 	_physicsMesh = std::make_unique<btBvhTriangleMeshShape>(_dynamicsMeshInterface.get(), true);
 	_rigidBody = std::make_unique<btRigidBody>(0.0f, nullptr, _physicsMesh.get());
@@ -76,7 +74,7 @@ void LandBlock::BuildMesh(LandIslandInterface& island)
 	_rigidBody->setUserIndex(-1);
 }
 
-const bgfx::Memory* LandBlock::BuildVertexList(LandIslandInterface& island)
+const bgfx::Memory* LandBlock::BuildVertexList(LandIslandInterface& island) const
 {
 	// reserve 16*16 quads of 2 tris with 3 verts = 1536
 	const bgfx::Memory* verticesMem = bgfx::alloc(sizeof(LandVertex) * 1536);
@@ -62,7 +62,10 @@ class LandBlock
 {
 public:
 	LandBlock() = default;
-	void BuildMesh(LandIslandInterface& island);
+	/// Only reads the island, so the blocks can build their vertices on any thread
+	[[nodiscard]] const bgfx::Memory* BuildVertexList(LandIslandInterface& island) const;
+	/// Takes the vertices built by BuildVertexList, to be called from the main thread
+	void BuildMesh(const bgfx::Memory* vertices);
 
 	[[nodiscard]] const graphics::Mesh& GetMesh() const { return *_mesh; }
 	[[nodiscard]] const lnd::LNDCell* GetCells() const;
@@ -78,7 +81,5 @@ class LandBlock
 	std::unique_ptr<dynamics::LandBlockBulletMeshInterface> _dynamicsMeshInterface;
 	std::unique_ptr<btBvhTriangleMeshShape> _physicsMesh;
 	std::unique_ptr<btRigidBody> _rigidBody;
-
-	const bgfx::Memory* BuildVertexList(LandIslandInterface& island);
 };
 } // namespace openblack
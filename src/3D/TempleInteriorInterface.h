@@ -13,6 +13,10 @@
 
 namespace openblack
 {
+namespace ecs::components
+{
+enum class TempleRoom;
+}
 
 enum class TempleRoom
 {
@@ -33,5 +37,9 @@ class TempleInteriorInterface
 	[[nodiscard]] virtual glm::vec3 GetPosition() const = 0;
 	virtual void Activate() = 0;
 	virtual void Deactivate() = 0;
+	/// Load and unload the rooms around the camera while active
+	virtual void Update() = 0;
+	/// Whether the parts of a room are drawn, rooms which are not loaded yet have no parts
+	[[nodiscard]] virtual bool IsRoomVisible(ecs::components::TempleRoom room) const = 0;
 };
 } // namespace openblack
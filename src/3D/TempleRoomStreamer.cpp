@@ -0,0 +1,504 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "TempleRoomStreamer.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#include <L3DCookedFile.h>
+#include <entt/core/hashed_string.hpp>
+#include <fmt/format.h>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/matrix.hpp>
+#include <spdlog/spdlog.h>
+
+#include "3D/L3DMesh.h"
+#include "3D/L3DSubMesh.h"
+#include "3D/Light.h"
+#include "ECS/Archetypes/GlowArchetype.h"
+#include "ECS/Components/Mesh.h"
+#include "ECS/Components/Transform.h"
+#include "ECS/Registry.h"
+#include "EngineConfig.h"
+#include "FileSystem/FileSystemInterface.h"
+#include "Graphics/MeshPool.h"
+#include "Graphics/RendererInterface.h"
+#include "Locator.h"
+#include "Log.h"
+#include "Resources/ResourcesInterface.h"
+
+using namespace openblack;
+
+using Room = TempleRoomStreamer::Room;
+
+namespace
+{
+const std::unordered_multimap<Room, std::string_view> k_TempleInteriorParts {
+    {Room::ChallengeRoom, "challenge_l3d"},
+    // {"challengelo_l3d", Room::ChallengeLO},
+    {Room::ChallengeRoom, "challengedome_l3d"},
+    {Room::ChallengeRoom, "challengefloor_l3d"},
+    // {"challengefloorlo_l3d", Room::ChallengeFloorLO},
+    {
+        Room::CreatureCave,
+        "creature_l3d",
+    },
+    // {"creaturelo_l3d", Room::CreatureCaveLO},
+    {Room::CreatureCave, "creaturewater_l3d"},
+    // {"creaturewaterlo_l3d", Room::CreatureCaveWaterLO},
+    {Room::CreditsRoom, "credits_l3d"},
+    // {"creditslo_l3d", Room::CreditsLO},
+    {Room::CreditsRoom, "creditsdome_l3d"},
+    {Room::CreditsRoom, "creditsfloor_l3d"},
+    // {"creditsfloorlo_l3d", Room::CreditsFloorLO},
+    {Room::MainRoom, "main_l3d"},
+    // {"mainlo_l3d", Room::MainLO},
+    {Room::MainRoom, "mainfloor_l3d"},
+    // {"mainfloorlo_l3d", Room::MainFloorLO},
+    {Room::MainRoom, "mainwater_l3d"},
+    // {"mainwaterlo_l3d", Room::MainWaterLO},
+    // {"movement_l3d", Room::Movement}, // Navmesh
+    {Room::MultiplayerRoom, "multi_l3d"},
+    // {"multilo_l3d", Room::MultiLO},
+    {Room::MultiplayerRoom, "multidome_l3d"},
+    {Room::MultiplayerRoom, "multifloor_l3d"},
+    // {"multifloorlo_l3d", Room::MultiFloorLO},
+    {Room::OptionsRoom, "options_l3d"},
+    // {"optionslo_l3d", Room::OptionsLO},
+    {Room::OptionsRoom, "optionsdome_l3d"},
+    {Room::OptionsRoom, "optionsfloor_l3d"},
+    // {"optionsfloorlo_l3d", Room::OptionsFloorLO},
+    {Room::SaveGameRoom, "savegame_l3d"},
+    // {"savegamelo_l3d", Room::SaveGameLO},
+    {Room::SaveGameRoom, "savegamedome_l3d"},
+    {Room::SaveGameRoom, "savegamefloor_l3d"},
+    // {"savegamefloorlo_l3d", Room::SaveGameFloorLO},
+};
+
+const std::unordered_map<Room, std::string_view> k_TempleInteriorGlows {
+    {Room::ChallengeRoom, "challenge"}, //
+    {Room::CreatureCave, "creature"},   //
+    {Room::CreditsRoom, "credits"},     //
+    {Room::MainRoom, "main"},           //
+    {Room::MultiplayerRoom, "multi"},   //
+    {Room::OptionsRoom, "options"},     //
+    {Room::SaveGameRoom, "savegame"},   //
+};
+
+constexpr uint8_t RoomBit(Room room)
+{
+	return static_cast<uint8_t>(1u << static_cast<uint8_t>(room));
+}
+
+/// Rooms reachable from each room without going through another, every room opens onto the main room
+constexpr std::array<uint8_t, TempleRoomStreamer::k_RoomCount> k_RoomNeighbours {
+    RoomBit(Room::MainRoom), // ChallengeRoom
+    RoomBit(Room::MainRoom), // CreatureCave
+    RoomBit(Room::MainRoom), // CreditsRoom
+    RoomBit(Room::ChallengeRoom) | RoomBit(Room::CreatureCave) | RoomBit(Room::CreditsRoom) |
+        RoomBit(Room::MultiplayerRoom) | RoomBit(Room::OptionsRoom) | RoomBit(Room::SaveGameRoom), // MainRoom
+    RoomBit(Room::MainRoom),                                                                      // MultiplayerRoom
+    RoomBit(Room::MainRoom),                                                                      // OptionsRoom
+    RoomBit(Room::MainRoom),                                                                      // SaveGameRoom
+};
+
+/// Bytes the submeshes of a mesh take up in the L3D mesh pools, in every vertex format they were loaded with
+uint64_t GetPoolSize(const graphics::L3DMesh& mesh)
+{
+	const auto& renderer = Locator::rendererInterface::value();
+	uint64_t size = 0;
+	for (const auto& subMesh : mesh.GetSubMeshes())
+	{
+		for (const auto format : {graphics::L3DVertexFormat::Full, graphics::L3DVertexFormat::Compact})
+		{
+			if (subMesh->HasVertexFormat(format))
+			{
+				size += renderer.GetL3DMeshPool(format).GetSizeInBytes(subMesh->GetAllocation(format));
+			}
+		}
+	}
+	return size;
+}
+
+/// Distance from the camera to a neighbouring room under which the room is loaded ahead of being entered
+constexpr float k_PrefetchDistance = 50.0f;
+/// Frames after which the renderer has consumed the buffers of an upload
+constexpr uint32_t k_UploadFrames = 2;
+/// Cells along each side of the grid of rooms
+constexpr uint32_t k_LookupResolution = 128;
+} // namespace
+
+TempleRoomStreamer::TempleRoomStreamer()
+    : _directory(Locator::filesystem::value().GetPath<filesystem::Path::Citadel>() / "engine")
+{
+}
+
+TempleRoomStreamer::~TempleRoomStreamer()
+{
+	// The loads in flight write their results to the streamer. Without the job system, they were run as it shut down.
+	if (Locator::jobs::has_value())
+	{
+		for (const auto& load : _loads)
+		{
+			Locator::jobs::value().Wait(load);
+		}
+	}
+}
+
+void TempleRoomStreamer::Start(const glm::vec3& position, const glm::mat3& rotation)
+{
+	_position = position;
+	_rotation = rotation;
+	_currentRoom = Room::MainRoom;
+	Enqueue(Room::MainRoom);
+
+	// Read the other rooms once for their bounds, they are only kept if wanted by the time they are ready
+	if (!_lookup.has_value())
+	{
+		for (size_t i = 0; i < _rooms.size(); ++i)
+		{
+			if (!_rooms[i].boundsRead)
+			{
+				Enqueue(static_cast<Room>(i));
+			}
+		}
+	}
+}
+
+void TempleRoomStreamer::Stop()
+{
+	// Loads in flight cannot be cancelled, their results are dropped when they arrive
+	++_generation;
+	{
+		const std::lock_guard lock(_mutex);
+		_results.clear();
+	}
+
+	for (size_t i = 0; i < _rooms.size(); ++i)
+	{
+		if (_rooms[i].state == RoomState::Loaded)
+		{
+			Unload(static_cast<Room>(i));
+		}
+		_rooms[i].state = RoomState::Unloaded;
+	}
+	_currentRoom = Room::MainRoom;
+}
+
+void TempleRoomStreamer::Update(const glm::vec3& cameraPosition)
+{
+	++_frame;
+	while (!_uploads.empty() && _frame - _uploads.front().first > k_UploadFrames)
+	{
+		_uploads.pop_front();
+	}
+
+	std::vector<Result> results;
+	{
+		const std::lock_guard lock(_mutex);
+		std::swap(results, _results);
+	}
+	std::erase_if(results, [this](const Result& result) { return result.generation != _generation; });
+
+	// Bounds are kept even when the room is not wanted anymore
+	for (const auto& result : results)
+	{
+		auto& entry = _rooms.at(static_cast<size_t>(result.room));
+		entry.bounds = result.bounds;
+		entry.boundsRead = true;
+	}
+	if (!_lookup.has_value() && std::ranges::all_of(_rooms, [](const RoomEntry& entry) { return entry.boundsRead; }))
+	{
+		BuildLookup();
+	}
+
+	const auto localPosition = glm::transpose(_rotation) * (cameraPosition - _position);
+	const auto currentRoom = FindRoom(localPosition);
+	if (currentRoom != _currentRoom)
+	{
+		_currentRoom = currentRoom;
+		Locator::entitiesRegistry::value().SetDirty();
+	}
+
+	// Visible rooms and the neighbours of the current room the camera is getting close to
+	const auto neighbours = k_RoomNeighbours.at(static_cast<size_t>(_currentRoom));
+	for (size_t i = 0; i < _rooms.size(); ++i)
+	{
+		const auto room = static_cast<Room>(i);
+		auto& entry = _rooms[i];
+		bool wanted = IsVisible(room);
+		if (!wanted && (neighbours & RoomBit(room)) != 0 && entry.bounds.has_value())
+		{
+			const auto closest = glm::clamp(localPosition, entry.bounds->minima, entry.bounds->maxima);
+			wanted = glm::distance(closest, localPosition) < k_PrefetchDistance;
+		}
+		if (wanted)
+		{
+			entry.lastUsed = _frame;
+			Enqueue(room);
+		}
+	}
+
+	for (auto& result : results)
+	{
+		auto& entry = _rooms.at(static_cast<size_t>(result.room));
+		if (entry.lastUsed == _frame)
+		{
+			Upload(result);
+		}
+		else
+		{
+			entry.state = RoomState::Unloaded;
+		}
+	}
+
+	// Unload the rooms which were wanted the longest time ago until the others fit in the budget
+	const uint64_t budget = Locator::config::value().templeRoomMemoryBudget;
+	uint64_t total = 0;
+	for (const auto& entry : _rooms)
+	{
+		total += entry.size;
+	}
+	while (total > budget)
+	{
+		auto oldest = _rooms.end();
+		for (auto it = _rooms.begin(); it != _rooms.end(); ++it)
+		{
+			if (it->state == RoomState::Loaded && it->lastUsed != _frame &&
+			    (oldest == _rooms.end() || it->lastUsed < oldest->lastUsed))
+			{
+				oldest = it;
+			}
+		}
+		if (oldest == _rooms.end())
+		{
+			break;
+		}
+		total -= oldest->size;
+		Unload(static_cast<Room>(std::distance(_rooms.begin(), oldest)));
+	}
+}
+
+void TempleRoomStreamer::Enqueue(Room room)
+{
+	auto& entry = _rooms.at(static_cast<size_t>(room));
+	if (entry.state != RoomState::Unloaded)
+	{
+		return;
+	}
+	entry.state = RoomState::Loading;
+
+	std::erase_if(_loads, &JobSystem::IsDone);
+	const Request request {room, _generation};
+	_loads.push_back(Locator::jobs::value().Schedule("TempleRoomStreamer::LoadRoom", [this, request]() {
+		auto result = LoadRoom(request);
+		const std::lock_guard lock(_mutex);
+		_results.emplace_back(std::move(result));
+	}));
+}
+
+TempleRoomStreamer::Result TempleRoomStreamer::LoadRoom(const Request& request) const
+{
+	auto& fileSystem = Locator::filesystem::value();
+	Result result {request.room, request.generation, {}, nullptr, std::nullopt};
+
+	const auto [first, last] = k_TempleInteriorParts.equal_range(request.room);
+	for (auto it = first; it != last; ++it)
+	{
+		const auto& assetName = it->second;
+		SPDLOG_LOGGER_DEBUG(GetLogger(LoggingSubsystem::game), "Loading interior temple mesh: {}", assetName);
+		auto cooked = std::make_unique<l3d::L3DCookedFile>();
+		try
+		{
+			const auto data = fileSystem.ReadAll(_directory / fmt::format("{}.zzz", assetName));
+			if (!graphics::L3DMesh::Cook(data, true, std::string(assetName), *cooked))
+			{
+				continue;
+			}
+		}
+		catch (std::runtime_error& err)
+		{
+			SPDLOG_LOGGER_ERROR(GetLogger(LoggingSubsystem::game), "{}", err.what());
+			continue;
+		}
+
+		for (const auto& submesh : cooked->GetSubmeshes())
+		{
+			const auto minima = glm::vec3(submesh.minima.x, submesh.minima.y, submesh.minima.z);
+			const auto maxima = glm::vec3(submesh.maxima.x, submesh.maxima.y, submesh.maxima.z);
+			result.bounds = result.bounds.has_value()
+			                    ? AxisAlignedBoundingBox {glm::min(result.bounds->minima, minima),
+			                                              glm::max(result.bounds->maxima, maxima)}
+			                    : AxisAlignedBoundingBox {minima, maxima};
+		}
+		result.parts.emplace_back(assetName, std::move(cooked));
+	}
+
+	const auto& glowName = k_TempleInteriorGlows.at(request.room);
+	SPDLOG_LOGGER_DEBUG(GetLogger(LoggingSubsystem::game), "Loading interior temple glows: {}", glowName);
+	try
+	{
+		result.glows = resources::LightLoader {}(resources::LightLoader::FromBufferTag {},
+		                                         fileSystem.ReadAll(_directory / fmt::format("{}.glw", glowName)));
+	}
+	catch (std::runtime_error& err)
+	{
+		SPDLOG_LOGGER_ERROR(GetLogger(LoggingSubsystem::game), "{}", err.what());
+	}
+
+	return result;
+}
+
+void TempleRoomStreamer::Upload(Result& result)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	auto& meshManager = Locator::resources::value().GetMeshes();
+	auto& entry = _rooms.at(static_cast<size_t>(result.room));
+
+	uint64_t size = 0;
+	for (auto& [assetName, cooked] : result.parts)
+	{
+		const auto name = fmt::format("temple/interior/{}", assetName);
+		meshManager.Load(name, resources::L3DLoader::FromCookedTag {}, std::string(assetName), *cooked);
+		_uploads.emplace_back(_frame, std::move(cooked));
+		if (const auto mesh = meshManager.Handle(resources::HashIdentifier(name)))
+		{
+			size += GetPoolSize(*mesh);
+		}
+
+		const auto entity = registry.Create();
+		registry.Assign<ecs::components::TempleInteriorPart>(entity, result.room);
+		registry.Assign<ecs::components::Transform>(entity, _position, _rotation, glm::vec3(1.0f));
+		registry.Assign<ecs::components::Mesh>(entity, resources::HashIdentifier(name), static_cast<int8_t>(0),
+		                                       static_cast<int8_t>(0));
+		entry.entities.push_back(entity);
+	}
+
+	if (result.glows != nullptr)
+	{
+		for (const auto& glow : result.glows->emitters)
+		{
+			const auto entities = ecs::archetypes::GlowArchetype::Create(glow, result.room);
+			entry.entities.insert(entry.entities.end(), entities.begin(), entities.end());
+		}
+	}
+
+	entry.state = RoomState::Loaded;
+	entry.size = size;
+	SPDLOG_LOGGER_DEBUG(GetLogger(LoggingSubsystem::game), "Temple room {} loaded, {} bytes", static_cast<int>(result.room),
+	                    entry.size);
+}
+
+void TempleRoomStreamer::Unload(Room room)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	auto& meshManager = Locator::resources::value().GetMeshes();
+	auto& entry = _rooms.at(static_cast<size_t>(room));
+
+	registry.Destroy(entry.entities.begin(), entry.entities.end());
+	registry.SetDirty();
+	entry.entities.clear();
+
+	const auto [first, last] = k_TempleInteriorParts.equal_range(room);
+	for (auto it = first; it != last; ++it)
+	{
+		meshManager.Erase(fmt::format("temple/interior/{}", it->second));
+	}
+
+	entry.state = RoomState::Unloaded;
+	entry.size = 0;
+	SPDLOG_LOGGER_DEBUG(GetLogger(LoggingSubsystem::game), "Temple room {} unloaded", static_cast<int>(room));
+}
+
+void TempleRoomStreamer::BuildLookup()
+{
+	auto minima = glm::vec2(std::numeric_limits<float>::max());
+	auto maxima = glm::vec2(std::numeric_limits<float>::lowest());
+	for (const auto& entry : _rooms)
+	{
+		if (entry.bounds.has_value())
+		{
+			minima = glm::min(minima, glm::vec2(entry.bounds->minima.x, entry.bounds->minima.z));
+			maxima = glm::max(maxima, glm::vec2(entry.bounds->maxima.x, entry.bounds->maxima.z));
+		}
+	}
+	if (minima.x > maxima.x)
+	{
+		// No room could be read, the camera stays in the main room
+		_lookup = RoomLookup {};
+		return;
+	}
+
+	RoomLookup lookup {
+	    minima,
+	    glm::max(maxima - minima, glm::vec2(1.0f)) / static_cast<float>(k_LookupResolution),
+	    k_LookupResolution,
+	    k_LookupResolution,
+	    std::vector<uint8_t>(k_LookupResolution * k_LookupResolution, RoomLookup::k_NoRoom),
+	};
+	for (uint32_t y = 0; y < lookup.height; ++y)
+	{
+		for (uint32_t x = 0; x < lookup.width; ++x)
+		{
+			// Rooms overlap the main room, the smallest room containing the cell is the most specific one
+			const auto center =
+			    lookup.origin + (glm::vec2(static_cast<float>(x), static_cast<float>(y)) + 0.5f) * lookup.cellSize;
+			float smallest = std::numeric_limits<float>::max();
+			for (size_t i = 0; i < _rooms.size(); ++i)
+			{
+				if (!_rooms[i].bounds.has_value())
+				{
+					continue;
+				}
+				const auto& bounds = *_rooms[i].bounds;
+				const auto size = bounds.Size();
+				if (center.x >= bounds.minima.x && center.x <= bounds.maxima.x && center.y >= bounds.minima.z &&
+				    center.y <= bounds.maxima.z && size.x * size.z < smallest)
+				{
+					smallest = size.x * size.z;
+					lookup.cells[x + y * lookup.width] = static_cast<uint8_t>(i);
+				}
+			}
+		}
+	}
+	_lookup = std::move(lookup);
+}
+
+Room TempleRoomStreamer::FindRoom(const glm::vec3& localPosition) const
+{
+	// Until the bounds of every room are known the camera is considered to be in the main room
+	if (!_lookup.has_value() || _lookup->cells.empty())
+	{
+		return Room::MainRoom;
+	}
+
+	const auto cell = glm::floor((glm::vec2(localPosition.x, localPosition.z) - _lookup->origin) / _lookup->cellSize);
+	if (cell.x < 0.0f || cell.y < 0.0f || cell.x >= static_cast<float>(_lookup->width) ||
+	    cell.y >= static_cast<float>(_lookup->height))
+	{
+		return Room::MainRoom;
+	}
+
+	const auto index = _lookup->cells[static_cast<uint32_t>(cell.x) + static_cast<uint32_t>(cell.y) * _lookup->width];
+	if (index == RoomLookup::k_NoRoom)
+	{
+		return Room::MainRoom;
+	}
+	const auto& bounds = *_rooms.at(index).bounds;
+	if (localPosition.y < bounds.minima.y || localPosition.y > bounds.maxima.y)
+	{
+		return Room::MainRoom;
+	}
+	return static_cast<Room>(index);
+}
@@ -0,0 +1,146 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <array>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <entt/entity/entity.hpp>
+#include <glm/mat3x3.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include "3D/AxisAlignedBoundingBox.h"
+#include "Common/JobSystem.h"
+#include "ECS/Components/Temple.h"
+
+namespace openblack::l3d
+{
+class L3DCookedFile;
+}
+
+namespace openblack
+{
+struct Lights;
+
+/**
+  Loads the rooms of the temple interior around the camera instead of the whole temple.
+
+  Rooms are read and cooked by a job when the camera enters a room or nears one next to it, then uploaded and given their
+  entities on the main thread. Rooms away from the camera are unloaded, least recently used first, when the meshes of the
+  loaded rooms take up more of the L3D mesh pools than the memory budget.
+
+  The room of the camera is found with a grid over the temple, built once the bounds of every room are known. The bounds
+  of all rooms are read in the background when the temple is first entered.
+ */
+class TempleRoomStreamer
+{
+public:
+	using Room = ecs::components::TempleRoom;
+	static constexpr size_t k_RoomCount = static_cast<size_t>(Room::SaveGameRoom) + 1;
+
+	enum class RoomState : uint8_t
+	{
+		Unloaded,
+		Loading,
+		Loaded,
+	};
+
+	TempleRoomStreamer();
+	~TempleRoomStreamer();
+
+	/// Start streaming rooms of a temple placed at position with rotation, starting with the main room
+	void Start(const glm::vec3& position, const glm::mat3& rotation);
+	/// Unload every room and drop the requests in flight
+	void Stop();
+	/// Upload finished rooms, then request and unload rooms for a camera at position
+	void Update(const glm::vec3& cameraPosition);
+
+	/// The main room and the room of the camera are drawn, other loaded rooms are only kept ready
+	[[nodiscard]] bool IsVisible(Room room) const { return room == Room::MainRoom || room == _currentRoom; }
+	[[nodiscard]] RoomState GetState(Room room) const { return _rooms.at(static_cast<size_t>(room)).state; }
+	/// Bytes the meshes of a loaded room take up in the L3D mesh pools
+	[[nodiscard]] uint64_t GetSize(Room room) const { return _rooms.at(static_cast<size_t>(room)).size; }
+
+private:
+	struct RoomEntry
+	{
+		RoomState state {RoomState::Unloaded};
+		uint64_t size {0};
+		/// Frame at which the room was last wanted
+		uint32_t lastUsed {0};
+		/// Bounds of the room's meshes, only missing if none of them could be read
+		std::optional<AxisAlignedBoundingBox> bounds;
+		bool boundsRead {false};
+		std::vector<entt::entity> entities;
+	};
+
+	struct Request
+	{
+		Room room;
+		uint32_t generation;
+	};
+
+	/// Everything read and cooked for a room by its job
+	struct Result
+	{
+		Room room;
+		uint32_t generation;
+		std::vector<std::pair<std::string_view, std::unique_ptr<l3d::L3DCookedFile>>> parts;
+		std::shared_ptr<Lights> glows;
+		std::optional<AxisAlignedBoundingBox> bounds;
+	};
+
+	/// Room index of each cell of a grid over the temple, from above
+	struct RoomLookup
+	{
+		static constexpr uint8_t k_NoRoom = 0xFF;
+		glm::vec2 origin {0.0f};
+		glm::vec2 cellSize {1.0f};
+		uint32_t width {0};
+		uint32_t height {0};
+		std::vector<uint8_t> cells;
+	};
+
+	[[nodiscard]] Result LoadRoom(const Request& request) const;
+	void Enqueue(Room room);
+	void Upload(Result& result);
+	void Unload(Room room);
+	void BuildLookup();
+	[[nodiscard]] Room FindRoom(const glm::vec3& localPosition) const;
+
+	std::filesystem::path _directory;
+	glm::vec3 _position {0.0f};
+	glm::mat3 _rotation {1.0f};
+	std::array<RoomEntry, k_RoomCount> _rooms;
+	Room _currentRoom {Room::MainRoom};
+	std::optional<RoomLookup> _lookup;
+	uint32_t _frame {0};
+	/// Incremented on Stop so that results requested before are dropped
+	uint32_t _generation {0};
+	/// Cooked files referenced by buffers which the renderer has not consumed yet, with the frame they were uploaded at
+	std::deque<std::pair<uint32_t, std::unique_ptr<l3d::L3DCookedFile>>> _uploads;
+
+	/// Jobs loading rooms, which may still be running
+	std::vector<JobSystem::JobHandle> _loads;
+	std::mutex _mutex;
+	std::vector<Result> _results;
+};
+
+} // namespace openblack
@@ -11,6 +11,8 @@
 
 #include <spdlog/spdlog.h>
 
+#include "Log.h"
+
 extern "C" {
 #include <AL/al.h>
 }
@@ -42,6 +44,6 @@ void openblack::audio::AlErrorCheck(std::string message, std::string file, uint6
 		errorMessage = "UNKNOWN AL ERROR: " + std::to_string(error);
 	}
 
-	SPDLOG_LOGGER_ERROR(spdlog::get("audio"), R"(OpenAL error: {} with call "{}" at file "{}" on line {})", errorMessage,
-	                    message, file, line);
+	SPDLOG_LOGGER_ERROR(GetLogger(LoggingSubsystem::audio), R"(OpenAL error: {} with call "{}" at file "{}" on line {})",
+	                    errorMessage, message, file, line);
 }
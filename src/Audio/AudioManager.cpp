@@ -22,6 +22,7 @@
 #include "ECS/Registry.h"
 #include "FileSystem/FileSystemInterface.h"
 #include "Locator.h"
+#include "Log.h"
 #include "MpegAudioDecoder.h"
 #include "Resources/Resources.h"
 #include "WavAudioDecoder.h"
@@ -177,7 +178,7 @@ void AudioManager::CreateBuffer(Sound& sound)
 		}
 		else
 		{
-			SPDLOG_LOGGER_ERROR(spdlog::get("audio"), "Unable to decode sound");
+			SPDLOG_LOGGER_ERROR(GetLogger(LoggingSubsystem::audio), "Unable to decode sound");
 		}
 	}
 	sound.bufferId = CreateBuffer(sound.channelLayout, decodeBuffer, sound.sampleRate);
@@ -18,8 +18,11 @@
 #include <spdlog/spdlog.h>
 
 #include "AlCheck.h"
+#include "Log.h"
 
 using namespace openblack::audio;
+using openblack::GetLogger;
+using openblack::LoggingSubsystem;
 
 void ALC_APIENTRY AudioPlayerAlLogger([[maybe_unused]] void* userptr, char level, const char* message,
                                       [[maybe_unused]] int length) noexcept
@@ -28,17 +31,17 @@ void ALC_APIENTRY AudioPlayerAlLogger([[maybe_unused]] void* userptr, char level
 	{
 	case 'E':
 	{
-		SPDLOG_LOGGER_ERROR(spdlog::get("audio"), "{}", message);
+		SPDLOG_LOGGER_ERROR(GetLogger(LoggingSubsystem::audio), "{}", message);
 	}
 	break;
 	case 'W':
 	{
-		SPDLOG_LOGGER_WARN(spdlog::get("audio"), "{}", message);
+		SPDLOG_LOGGER_WARN(GetLogger(LoggingSubsystem::audio), "{}", message);
 	}
 	break;
 	case 'I':
 	{
-		SPDLOG_LOGGER_INFO(spdlog::get("audio"), "{}", message);
+		SPDLOG_LOGGER_INFO(GetLogger(LoggingSubsystem::audio), "{}", message);
 	}
 	break;
 	}
@@ -54,8 +57,8 @@ void AudioPlayer::SetupLogging()
 	}
 	else
 	{
-		SPDLOG_LOGGER_WARN(spdlog::get("audio"), "Could not set openal logging callback");
-		SPDLOG_LOGGER_WARN(spdlog::get("audio"), "Falling back to tracing directly in openal");
+		SPDLOG_LOGGER_WARN(GetLogger(LoggingSubsystem::audio), "Could not set openal logging callback");
+		SPDLOG_LOGGER_WARN(GetLogger(LoggingSubsystem::audio), "Falling back to tracing directly in openal");
 		enum class LogLevel
 		{
 			Disable,
@@ -64,7 +67,7 @@ void AudioPlayer::SetupLogging()
 			Trace
 		};
 		LogLevel level;
-		switch (spdlog::get("audio")->level())
+		switch (GetLogger(LoggingSubsystem::audio)->level())
 		{
 		case spdlog::level::trace:
 		case spdlog::level::debug:
@@ -98,7 +101,7 @@ void AudioPlayer::Initialize()
 	ALCint minorVersion;
 	alcGetIntegerv(_device.get(), ALC_MAJOR_VERSION, 1, &majorVersion);
 	alcGetIntegerv(_device.get(), ALC_MINOR_VERSION, 1, &minorVersion);
-	SPDLOG_LOGGER_INFO(spdlog::get("audio"), "ALC Version {}.{}", majorVersion, minorVersion);
+	SPDLOG_LOGGER_INFO(GetLogger(LoggingSubsystem::audio), "ALC Version {}.{}", majorVersion, minorVersion);
 	alCheckCall(alcMakeContextCurrent(_context.get()));
 }
 
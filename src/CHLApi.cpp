@@ -12,6 +12,7 @@
 #include <cmath>
 #include <cstdint>
 
+#include <limits>
 #include <sstream>
 #include <string>
 #include <unordered_set>
@@ -27,11 +28,18 @@
 #include "3D/TempleInteriorInterface.h"
 #include "Camera/Camera.h"
 #include "ECS/Archetypes/MobileStaticArchetype.h"
+#include "ECS/Components/Abode.h"
+#include "ECS/Components/LivingAction.h"
+#include "ECS/Components/ScriptControlled.h"
+#include "ECS/Components/Town.h"
 #include "ECS/Components/Transform.h"
+#include "ECS/Components/Villager.h"
 #include "ECS/Registry.h"
 #include "ECS/Systems/HandSystemInterface.h"
+#include "ECS/Systems/SpatialQuerySystemInterface.h"
 #include "Enums.h"
 #include "Locator.h"
+#include "Log.h"
 #include "ScriptHeaders/ScriptEnums.h"
 
 namespace openblack::chlapi
@@ -41,12 +49,23 @@ using namespace openblack::ecs::archetypes;
 
 using openblack::Locator;
 using openblack::MobileStaticInfo;
+using openblack::ecs::SpatialQueryFilter;
+using openblack::ecs::components::Abode;
+using openblack::ecs::components::LivingAction;
+using openblack::ecs::components::ScriptControlled;
+using openblack::ecs::components::Town;
 using openblack::ecs::components::Transform;
+using openblack::ecs::components::Villager;
 using openblack::ecs::systems::HandSystemInterface;
 using openblack::lhvm::DataType;
 using openblack::lhvm::VMValue;
 using openblack::script::ObjectType;
 
+/// Scripts tend to call natives in loops, so each missing one is reported once and then at most once per interval
+#define CHLAPI_NOT_IMPLEMENTED()                                                                                            \
+	OPENBLACK_LOG_RATE_LIMITED(GetLogger(LoggingSubsystem::scripting), spdlog::level::err,                                  \
+	                           "CHLApi Function {}() not implemented.", __func__)
+
 #define CREATE_FUNCTION_BINDING(NAME, STACKIN, STACKOUT, FUNCTION)       \
 	{                                                                    \
 		_functionsTable.emplace_back(FUNCTION, STACKIN, STACKOUT, NAME); \
@@ -115,11 +134,53 @@ entt::entity CreateScriptObject(const ObjectType type, uint32_t subtype, const g
 		return MobileStaticArchetype::Create(position, static_cast<MobileStaticInfo>(subtype), altitude, xAngleRadians,
 		                                     yAngleRadians, zAngleRadians, scale);
 	default:
-		SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "CreateScriptObject not implemented for type {}", static_cast<int>(type));
+		OPENBLACK_LOG_RATE_LIMITED(GetLogger(LoggingSubsystem::game), spdlog::level::debug,
+		                           "CreateScriptObject not implemented for type {}", static_cast<int>(type));
 	}
 	return static_cast<entt::entity>(0);
 }
 
+/// Whether an object is in a container given to a script, such as a villager or an abode of a town. 0 is no container.
+bool IsInContainer(entt::entity entity, uint32_t container)
+{
+	if (container == 0)
+	{
+		return true;
+	}
+	const auto& registry = Locator::entitiesRegistry::value();
+	const auto containerEntity = static_cast<entt::entity>(container);
+	if (const auto* villager = registry.TryGet<Villager>(entity); villager != nullptr)
+	{
+		return villager->town == containerEntity;
+	}
+	if (const auto* abode = registry.TryGet<Abode>(entity); abode != nullptr)
+	{
+		const auto* town = registry.TryGet<Town>(containerEntity);
+		return town != nullptr && abode->townId == town->id;
+	}
+	return false;
+}
+
+/// Filter of the objects a script looks for, a negative subtype matches every subtype
+SpatialQueryFilter MakeScriptFilter(ObjectType type, int32_t subtype, bool excludingScripted)
+{
+	SpatialQueryFilter filter;
+	filter.type = type;
+	if (subtype >= 0)
+	{
+		filter.subtype = subtype;
+	}
+	filter.excludeScripted = excludingScripted;
+	return filter;
+}
+
+/// Closest object matching a filter at a distance between the min and max radius, or 0 if there is none
+uint32_t FindNearestObject(const glm::vec3& position, const SpatialQueryFilter& filter, float minRadius, float maxRadius)
+{
+	const auto found = Locator::spatialQuerySystem::value().FindNearest(position, 1, filter, minRadius, maxRadius);
+	return found.empty() ? 0 : static_cast<uint32_t>(found.front());
+}
+
 VMValue Pop(DataType& type)
 {
 	auto& lhvm = Locator::vm::value();
@@ -207,7 +268,7 @@ void MoveCameraPosition() // 003 MOVE_CAMERA_POSITION
 	// const auto time = Popf();
 	// const auto position = PopVec();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void MoveCameraFocus() // 004 MOVE_CAMERA_FOCUS
@@ -215,7 +276,7 @@ void MoveCameraFocus() // 004 MOVE_CAMERA_FOCUS
 	// const auto time = Popf();
 	// const auto position = PopVec();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetCameraPosition() // 005 GET_CAMERA_POSITION
@@ -236,14 +297,14 @@ void SpiritEject() // 007 SPIRIT_EJECT
 {
 	// const auto spirit = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SpiritHome() // 008 SPIRIT_HOME
 {
 	// const auto spirit = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SpiritPointPos() // 009 SPIRIT_POINT_POS
@@ -252,7 +313,7 @@ void SpiritPointPos() // 009 SPIRIT_POINT_POS
 	// const auto position = PopVec();
 	// const auto spirit = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SpiritPointGameThing() // 010 SPIRIT_POINT_GAME_THING
@@ -261,14 +322,14 @@ void SpiritPointGameThing() // 010 SPIRIT_POINT_GAME_THING
 	// const auto target = Pop().uintVal;
 	// const auto spirit = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GameThingFieldOfView() // 011 GAME_THING_FIELD_OF_VIEW
 {
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -276,7 +337,7 @@ void PosFieldOfView() // 012 POS_FIELD_OF_VIEW
 {
 	// const auto position = PopVec();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -286,7 +347,7 @@ void RunText() // 013 RUN_TEXT
 	// const auto textID = Pop().intVal;
 	// const auto singleLine = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void TempText() // 014 TEMP_TEXT
@@ -295,13 +356,13 @@ void TempText() // 014 TEMP_TEXT
 	// const auto string = PopString();
 	// const auto singleLine = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void TextRead() // 015 TEXT_READ
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -309,7 +370,7 @@ void GameThingClicked() // 016 GAME_THING_CLICKED
 {
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -318,7 +379,7 @@ void SetScriptState() // 017 SET_SCRIPT_STATE
 	// const auto state = Pop().intVal;
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetScriptStatePos() // 018 SET_SCRIPT_STATE_POS
@@ -326,7 +387,7 @@ void SetScriptStatePos() // 018 SET_SCRIPT_STATE_POS
 	// const auto position = PopVec();
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetScriptFloat() // 019 SET_SCRIPT_FLOAT
@@ -334,7 +395,7 @@ void SetScriptFloat() // 019 SET_SCRIPT_FLOAT
 	// const auto value = Popf();
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetScriptUlong() // 020 SET_SCRIPT_ULONG
@@ -343,7 +404,7 @@ void SetScriptUlong() // 020 SET_SCRIPT_ULONG
 	// const auto animation = Pop().intVal;
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetProperty() // 021 GET_PROPERTY
@@ -351,7 +412,7 @@ void GetProperty() // 021 GET_PROPERTY
 	// const auto object = Pop().uintVal;
 	// const auto prop = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushi(0);
 }
 
@@ -361,7 +422,7 @@ void SetProperty() // 022 SET_PROPERTY
 	// const auto object = Pop().uintVal;
 	// const auto prop = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetPosition() // 023 GET_POSITION
@@ -396,6 +457,7 @@ void SetPosition() // 024 SET_POSITION
 		if (transform != nullptr)
 		{
 			transform->position = position;
+			Locator::spatialQuerySystem::value().Refresh(static_cast<entt::entity>(objId));
 		}
 	}
 }
@@ -415,7 +477,7 @@ void Call() // 026 CALL
 	// const auto subtype = Pop().intVal;
 	// const auto type = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -426,6 +488,10 @@ void Create() // 027 CREATE
 	const auto type = static_cast<ObjectType>(Pop().intVal);
 
 	const auto object = CreateScriptObject(type, subtype, position, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+	if (object != static_cast<entt::entity>(0))
+	{
+		Locator::entitiesRegistry::value().AssignOrReplace<ScriptControlled>(object);
+	}
 
 	Pusho(static_cast<uint32_t>(object));
 }
@@ -447,21 +513,21 @@ void DllGettime() // 029 DLL_GETTIME
 void StartCameraControl() // 030 START_CAMERA_CONTROL
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
 void EndCameraControl() // 031 END_CAMERA_CONTROL
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetWidescreen() // 032 SET_WIDESCREEN
 {
 	// const auto enabled = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void MoveGameThing() // 033 MOVE_GAME_THING
@@ -470,7 +536,7 @@ void MoveGameThing() // 033 MOVE_GAME_THING
 	// const auto position = PopVec();
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetFocus() // 034 SET_FOCUS
@@ -478,13 +544,13 @@ void SetFocus() // 034 SET_FOCUS
 	// const auto position = PopVec();
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void HasCameraArrived() // 035 HAS_CAMERA_ARRIVED
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -492,7 +558,7 @@ void FlockCreate() // 036 FLOCK_CREATE
 {
 	// const auto position = PopVec();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -502,7 +568,7 @@ void FlockAttach() // 037 FLOCK_ATTACH
 	// const auto flock = Pop().uintVal;
 	// const auto obj = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -511,7 +577,7 @@ void FlockDetach() // 038 FLOCK_DETACH
 	// const auto flock = Pop().uintVal;
 	// const auto obj = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -519,14 +585,14 @@ void FlockDisband() // 039 FLOCK_DISBAND
 {
 	// const auto flock = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void IdSize() // 040 ID_SIZE
 {
 	// const auto container = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -535,7 +601,7 @@ void FlockMember() // 041 FLOCK_MEMBER
 	// const auto flock = Pop().uintVal;
 	// const auto obj = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -554,20 +620,20 @@ void PlaySoundEffect() // 043 PLAY_SOUND_EFFECT
 	// const auto soundbank = Pop().intVal;
 	// const auto sound = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void StartMusic() // 044 START_MUSIC
 {
 	// const auto music = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void StopMusic() // 045 STOP_MUSIC
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void AttachMusic() // 046 ATTACH_MUSIC
@@ -575,14 +641,14 @@ void AttachMusic() // 046 ATTACH_MUSIC
 	// const auto target = Pop().uintVal;
 	// const auto music = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void DetachMusic() // 047 DETACH_MUSIC
 {
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void ObjectDelete() // 048 OBJECT_DELETE
@@ -590,21 +656,21 @@ void ObjectDelete() // 048 OBJECT_DELETE
 	// const auto withFade = Pop().intVal;
 	// const auto obj = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void FocusFollow() // 049 FOCUS_FOLLOW
 {
 	// const auto target = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void PositionFollow() // 050 POSITION_FOLLOW
 {
 	// const auto target = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void CallNear() // 051 CALL_NEAR
@@ -615,7 +681,7 @@ void CallNear() // 051 CALL_NEAR
 	// const auto subtype = Pop().intVal;
 	// const auto type = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -625,7 +691,7 @@ void SpecialEffectPosition() // 052 SPECIAL_EFFECT_POSITION
 	// const auto position = PopVec();
 	// const auto effect = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -635,7 +701,7 @@ void SpecialEffectObject() // 053 SPECIAL_EFFECT_OBJECT
 	// const auto target = Pop().uintVal;
 	// const auto effect = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -646,7 +712,7 @@ void DanceCreate() // 054 DANCE_CREATE
 	// const auto type = Pop().intVal;
 	// const auto obj = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -657,7 +723,7 @@ void CallIn() // 055 CALL_IN
 	// const auto subtype = Pop().intVal;
 	// const auto type = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -668,7 +734,7 @@ void ChangeInnerOuterProperties() // 056 CHANGE_INNER_OUTER_PROPERTIES
 	// const auto inner = Popf();
 	// const auto obj = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void Snapshot() // 057 SNAPSHOT
@@ -684,14 +750,14 @@ void Snapshot() // 057 SNAPSHOT
 	// const auto position = PopVec();
 	// const auto quest = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetAlignment() // 058 GET_ALIGNMENT
 {
 	// const auto zero = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -700,7 +766,7 @@ void SetAlignment() // 059 SET_ALIGNMENT
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void InfluenceObject() // 060 INFLUENCE_OBJECT
@@ -710,7 +776,7 @@ void InfluenceObject() // 060 INFLUENCE_OBJECT
 	// const auto radius = Popf();
 	// const auto target = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -721,7 +787,7 @@ void InfluencePosition() // 061 INFLUENCE_POSITION
 	// const auto radius = Popf();
 	// const auto position = PopVec();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -731,7 +797,7 @@ void GetInfluence() // 062 GET_INFLUENCE
 	// const auto raw = static_cast<bool>(Pop().intVal);
 	// const auto player = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -739,14 +805,14 @@ void SetInterfaceInteraction() // 063 SET_INTERFACE_INTERACTION
 {
 	// const auto level = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void Played() // 064 PLAYED
 {
 	// const auto obj = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -755,7 +821,7 @@ void RandomUlong() // 065 RANDOM_ULONG
 	// const auto max = Pop().intVal;
 	// const auto min = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushi(0);
 }
 
@@ -763,20 +829,21 @@ void SetGamespeed() // 066 SET_GAMESPEED
 {
 	// const auto speed = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void CallInNear() // 067 CALL_IN_NEAR
 {
-	// const auto excludingScripted = static_cast<bool>(Pop().intVal);
-	// const auto radius = Popf();
-	// const auto pos = PopVec();
-	// const auto container = Pop().uintVal;
-	// const auto subtype = Pop().intVal;
-	// const auto type = Pop().intVal;
-	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
-	Pusho(0);
+	const auto excludingScripted = static_cast<bool>(Pop().intVal);
+	const auto radius = Popf();
+	const auto pos = PopVec();
+	const auto container = Pop().uintVal;
+	const auto subtype = Pop().intVal;
+	const auto type = static_cast<ObjectType>(Pop().intVal);
+
+	auto filter = MakeScriptFilter(type, subtype, excludingScripted);
+	filter.predicate = [container](entt::entity entity) { return IsInContainer(entity, container); };
+	Pusho(FindNearestObject(pos, filter, 0.0f, radius));
 }
 
 void OverrideStateAnimation() // 068 OVERRIDE_STATE_ANIMATION
@@ -784,7 +851,7 @@ void OverrideStateAnimation() // 068 OVERRIDE_STATE_ANIMATION
 	// const auto animType = Pop().intVal;
 	// const auto obj = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void CreatureCreateRelativeToCreature() // 069 CREATURE_CREATE_RELATIVE_TO_CREATURE
@@ -794,7 +861,7 @@ void CreatureCreateRelativeToCreature() // 069 CREATURE_CREATE_RELATIVE_TO_CREAT
 	// const auto scale = Popf();
 	// const auto creature = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -802,7 +869,7 @@ void CreatureLearnEverything() // 070 CREATURE_LEARN_EVERYTHING
 {
 	// const auto creature = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void CreatureSetKnowsAction() // 071 CREATURE_SET_KNOWS_ACTION
@@ -812,7 +879,7 @@ void CreatureSetKnowsAction() // 071 CREATURE_SET_KNOWS_ACTION
 	// const auto typeOfAction = Pop().intVal;
 	// const auto creature = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void CreatureSetAgendaPriority() // 072 CREATURE_SET_AGENDA_PRIORITY
@@ -820,14 +887,14 @@ void CreatureSetAgendaPriority() // 072 CREATURE_SET_AGENDA_PRIORITY
 	// const auto priority = Popf();
 	// const auto creature = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void CreatureTurnOffAllDesires() // 073 CREATURE_TURN_OFF_ALL_DESIRES
 {
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void CreatureLearnDistinctionAboutActivityObject() // 074 CREATURE_LEARN_DISTINCTION_ABOUT_ACTIVITY_OBJECT
@@ -837,7 +904,7 @@ void CreatureLearnDistinctionAboutActivityObject() // 074 CREATURE_LEARN_DISTINC
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void CreatureDoAction() // 075 CREATURE_DO_ACTION
@@ -847,7 +914,7 @@ void CreatureDoAction() // 075 CREATURE_DO_ACTION
 	// const auto unk1 = Pop().intVal;
 	// const auto creature = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void InCreatureHand() // 076 IN_CREATURE_HAND
@@ -855,7 +922,7 @@ void InCreatureHand() // 076 IN_CREATURE_HAND
 	// const auto creature = Pop().uintVal;
 	// const auto obj = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -865,7 +932,7 @@ void CreatureSetDesireValue() // 077 CREATURE_SET_DESIRE_VALUE
 	// const auto desire = Pop().intVal;
 	// const auto creature = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void CreatureSetDesireActivated78() // 078 CREATURE_SET_DESIRE_ACTIVATED
@@ -874,7 +941,7 @@ void CreatureSetDesireActivated78() // 078 CREATURE_SET_DESIRE_ACTIVATED
 	// const auto desire = Pop().intVal;
 	// const auto creature = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void CreatureSetDesireActivated79() // 079 CREATURE_SET_DESIRE_ACTIVATED
@@ -882,7 +949,7 @@ void CreatureSetDesireActivated79() // 079 CREATURE_SET_DESIRE_ACTIVATED
 	// const auto active = Pop().intVal;
 	// const auto creature = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void CreatureSetDesireMaximum() // 080 CREATURE_SET_DESIRE_MAXIMUM
@@ -891,14 +958,14 @@ void CreatureSetDesireMaximum() // 080 CREATURE_SET_DESIRE_MAXIMUM
 	// const auto desire = Pop().intVal;
 	// const auto creature = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void ConvertCameraPosition() // 081 CONVERT_CAMERA_POSITION
 {
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushv(0.0f); // x
 	Pushv(0.0f); // y
 	Pushv(0.0f); // z
@@ -908,7 +975,7 @@ void ConvertCameraFocus() // 082 CONVERT_CAMERA_FOCUS
 {
 	// const auto camera_enum = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushv(0.0f); // x
 	Pushv(0.0f); // y
 	Pushv(0.0f); // z
@@ -918,14 +985,14 @@ void CreatureSetPlayer() // 083 CREATURE_SET_PLAYER
 {
 	// const auto creature = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void StartCountdownTimer() // 084 START_COUNTDOWN_TIMER
 {
 	// const auto timeout = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void CreatureInitialiseNumTimesPerformedAction() // 085 CREATURE_INITIALISE_NUM_TIMES_PERFORMED_ACTION
@@ -933,7 +1000,7 @@ void CreatureInitialiseNumTimesPerformedAction() // 085 CREATURE_INITIALISE_NUM_
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void CreatureGetNumTimesActionPerformed() // 086 CREATURE_GET_NUM_TIMES_ACTION_PERFORMED
@@ -941,21 +1008,21 @@ void CreatureGetNumTimesActionPerformed() // 086 CREATURE_GET_NUM_TIMES_ACTION_P
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
 void RemoveCountdownTimer() // 087 REMOVE_COUNTDOWN_TIMER
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetObjectDropped() // 088 GET_OBJECT_DROPPED
 {
 	// const auto creature = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -963,7 +1030,7 @@ void ClearDroppedByObject() // 089 CLEAR_DROPPED_BY_OBJECT
 {
 	// const auto creature = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void CreateReaction() // 090 CREATE_REACTION
@@ -971,20 +1038,20 @@ void CreateReaction() // 090 CREATE_REACTION
 	// const auto reaction = Pop().intVal;
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void RemoveReaction() // 091 REMOVE_REACTION
 {
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetCountdownTimer() // 092 GET_COUNTDOWN_TIMER
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -993,7 +1060,7 @@ void StartDualCamera() // 093 START_DUAL_CAMERA
 	// const auto obj2 = Pop().uintVal;
 	// const auto obj1 = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void UpdateDualCamera() // 094 UPDATE_DUAL_CAMERA
@@ -1001,27 +1068,27 @@ void UpdateDualCamera() // 094 UPDATE_DUAL_CAMERA
 	// const auto obj2 = Pop().uintVal;
 	// const auto obj1 = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void ReleaseDualCamera() // 095 RELEASE_DUAL_CAMERA
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetCreatureHelp() // 096 SET_CREATURE_HELP
 {
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetTargetObject() // 097 GET_TARGET_OBJECT
 {
 	// const auto obj = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -1030,14 +1097,14 @@ void CreatureDesireIs() // 098 CREATURE_DESIRE_IS
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushi(0);
 }
 
 void CountdownTimerExists() // 099 COUNTDOWN_TIMER_EXISTS
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -1046,14 +1113,14 @@ void LookGameThing() // 100 LOOK_GAME_THING
 	// const auto target = Pop().uintVal;
 	// const auto spirit = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetObjectDestination() // 101 GET_OBJECT_DESTINATION
 {
 	// const auto obj = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushv(0.0f); // x
 	Pushv(0.0f); // y
 	Pushv(0.0f); // z
@@ -1063,20 +1130,20 @@ void CreatureForceFinish() // 102 CREATURE_FORCE_FINISH
 {
 	// const auto creature = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void HideCountdownTimer() // 103 HIDE_COUNTDOWN_TIMER
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetActionTextForObject() // 104 GET_ACTION_TEXT_FOR_OBJECT
 {
 	// const auto obj = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushi(0);
 }
 
@@ -1085,7 +1152,7 @@ void CreateDualCameraWithPoint() // 105 CREATE_DUAL_CAMERA_WITH_POINT
 	// const auto position = PopVec();
 	// const auto obj = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetCameraToFaceObject() // 106 SET_CAMERA_TO_FACE_OBJECT
@@ -1093,7 +1160,7 @@ void SetCameraToFaceObject() // 106 SET_CAMERA_TO_FACE_OBJECT
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void MoveCameraToFaceObject() // 107 MOVE_CAMERA_TO_FACE_OBJECT
@@ -1102,13 +1169,13 @@ void MoveCameraToFaceObject() // 107 MOVE_CAMERA_TO_FACE_OBJECT
 	// const auto distance = Popf();
 	// const auto target = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetMoonPercentage() // 108 GET_MOON_PERCENTAGE
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -1119,14 +1186,14 @@ void PopulateContainer() // 109 POPULATE_CONTAINER
 	// const auto quantity = Popf();
 	// const auto obj = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void AddReference() // 110 ADD_REFERENCE
 {
 	const auto objId = Pop().uintVal;
 	// TODO(Daniels118): implement this - HIGH PRIORITY
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(objId);
 }
 
@@ -1134,7 +1201,7 @@ void RemoveReference() // 111 REMOVE_REFERENCE
 {
 	const auto objId = Pop().uintVal;
 	// TODO(Daniels118): implement this - HIGH PRIORITY
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(objId);
 }
 
@@ -1142,48 +1209,48 @@ void SetGameTime() // 112 SET_GAME_TIME
 {
 	// const auto time = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetGameTime() // 113 GET_GAME_TIME
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
 void GetRealTime() // 114 GET_REAL_TIME
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
 void GetRealDay115() // 115 GET_REAL_DAY
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
 void GetRealDay116() // 116 GET_REAL_DAY
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
 void GetRealMonth() // 117 GET_REAL_MONTH
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
 void GetRealYear() // 118 GET_REAL_YEAR
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -1191,26 +1258,26 @@ void RunCameraPath() // 119 RUN_CAMERA_PATH
 {
 	// const auto cameraEnum = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void StartDialogue() // 120 START_DIALOGUE
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
 void EndDialogue() // 121 END_DIALOGUE
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void IsDialogueReady() // 122 IS_DIALOGUE_READY
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -1223,7 +1290,7 @@ void ChangeWeatherProperties() // 123 CHANGE_WEATHER_PROPERTIES
 	// const auto temperature = Popf();
 	// const auto storm = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void ChangeLightningProperties() // 124 CHANGE_LIGHTNING_PROPERTIES
@@ -1234,7 +1301,7 @@ void ChangeLightningProperties() // 124 CHANGE_LIGHTNING_PROPERTIES
 	// const auto sheetmin = Popf();
 	// const auto storm = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void ChangeTimeFadeProperties() // 125 CHANGE_TIME_FADE_PROPERTIES
@@ -1243,7 +1310,7 @@ void ChangeTimeFadeProperties() // 125 CHANGE_TIME_FADE_PROPERTIES
 	// const auto duration = Popf();
 	// const auto storm = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void ChangeCloudProperties() // 126 CHANGE_CLOUD_PROPERTIES
@@ -1253,7 +1320,7 @@ void ChangeCloudProperties() // 126 CHANGE_CLOUD_PROPERTIES
 	// const auto numClouds = Popf();
 	// const auto storm = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetHeadingAndSpeed() // 127 SET_HEADING_AND_SPEED
@@ -1262,19 +1329,19 @@ void SetHeadingAndSpeed() // 127 SET_HEADING_AND_SPEED
 	// const auto position = PopVec();
 	// const auto unk0 = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void StartGameSpeed() // 128 START_GAME_SPEED
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void EndGameSpeed() // 129 END_GAME_SPEED
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void BuildBuilding() // 130 BUILD_BUILDING
@@ -1282,7 +1349,7 @@ void BuildBuilding() // 130 BUILD_BUILDING
 	// const auto desire = Popf();
 	// const auto position = PopVec();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetAffectedByWind() // 131 SET_AFFECTED_BY_WIND
@@ -1290,13 +1357,13 @@ void SetAffectedByWind() // 131 SET_AFFECTED_BY_WIND
 	// const auto object = Pop().uintVal;
 	// const auto enabled = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void WidescreenTransistionFinished() // 132 WIDESCREEN_TRANSISTION_FINISHED
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -1305,7 +1372,7 @@ void GetResource() // 133 GET_RESOURCE
 	// const auto container = Pop().uintVal;
 	// const auto resource = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -1315,7 +1382,7 @@ void AddResource() // 134 ADD_RESOURCE
 	// const auto quantity = Popf();
 	// const auto resource = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -1325,7 +1392,7 @@ void RemoveResource() // 135 REMOVE_RESOURCE
 	// const auto quantity = Popf();
 	// const auto resource = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -1336,7 +1403,7 @@ void GetTargetRelativePos() // 136 GET_TARGET_RELATIVE_POS
 	// const auto to = PopVec();
 	// const auto from = PopVec();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushv(0.0f); // x
 	Pushv(0.0f); // y
 	Pushv(0.0f); // z
@@ -1346,14 +1413,14 @@ void StopPointing() // 137 STOP_POINTING
 {
 	// const auto spirit = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void StopLooking() // 138 STOP_LOOKING
 {
 	// const auto spirit = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void LookAtPosition() // 139 LOOK_AT_POSITION
@@ -1361,7 +1428,7 @@ void LookAtPosition() // 139 LOOK_AT_POSITION
 	// const auto position = PopVec();
 	// const auto spirit = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void PlaySpiritAnim() // 140 PLAY_SPIRIT_ANIM
@@ -1372,41 +1439,42 @@ void PlaySpiritAnim() // 140 PLAY_SPIRIT_ANIM
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void CallInNotNear() // 141 CALL_IN_NOT_NEAR
 {
-	// const auto excludingScripted = static_cast<bool>(Pop().intVal);
-	// const auto radius = Popf();
-	// const auto pos = PopVec();
-	// const auto container = Pop().uintVal;
-	// const auto subtype = Pop().intVal;
-	// const auto type = Pop().intVal;
-	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
-	Pusho(0);
+	const auto excludingScripted = static_cast<bool>(Pop().intVal);
+	const auto radius = Popf();
+	const auto pos = PopVec();
+	const auto container = Pop().uintVal;
+	const auto subtype = Pop().intVal;
+	const auto type = static_cast<ObjectType>(Pop().intVal);
+
+	auto filter = MakeScriptFilter(type, subtype, excludingScripted);
+	filter.predicate = [container](entt::entity entity) { return IsInContainer(entity, container); };
+	Pusho(FindNearestObject(pos, filter, radius, std::numeric_limits<float>::infinity()));
 }
 
 void SetCameraZone() // 142 SET_CAMERA_ZONE
 {
 	// const auto filename = PopString();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetObjectState() // 143 GET_OBJECT_STATE
 {
 	// const auto obj = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushi(0);
 }
 
 void RevealCountdownTimer() // 144 REVEAL_COUNTDOWN_TIMER
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetTimerTime() // 145 SET_TIMER_TIME
@@ -1414,14 +1482,14 @@ void SetTimerTime() // 145 SET_TIMER_TIME
 	// const auto time = Popf();
 	// const auto timer = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void CreateTimer() // 146 CREATE_TIMER
 {
 	// const auto timeout = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -1429,7 +1497,7 @@ void GetTimerTimeRemaining() // 147 GET_TIMER_TIME_REMAINING
 {
 	// const auto timer = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -1437,7 +1505,7 @@ void GetTimerTimeSinceSet() // 148 GET_TIMER_TIME_SINCE_SET
 {
 	// const auto timer = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -1446,13 +1514,13 @@ void MoveMusic() // 149 MOVE_MUSIC
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetInclusionDistance() // 150 GET_INCLUSION_DISTANCE
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -1509,13 +1577,13 @@ void StopScript() // 155 STOP_SCRIPT
 void ClearClickedObject() // 156 CLEAR_CLICKED_OBJECT
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void ClearClickedPosition() // 157 CLEAR_CLICKED_POSITION
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void PositionClicked() // 158 POSITION_CLICKED
@@ -1525,21 +1593,25 @@ void PositionClicked() // 158 POSITION_CLICKED
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
 void ReleaseFromScript() // 159 RELEASE_FROM_SCRIPT
 {
-	// const auto obj = Pop().uintVal;
-	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	const auto obj = static_cast<entt::entity>(Pop().uintVal);
+	auto& registry = Locator::entitiesRegistry::value();
+	if (registry.Valid(obj))
+	{
+		registry.Remove<ScriptControlled>(obj);
+		Locator::spatialQuerySystem::value().Refresh(obj);
+	}
 }
 
 void GetObjectHandIsOver() // 160 GET_OBJECT_HAND_IS_OVER
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -1547,7 +1619,7 @@ void IdPoisonedSize() // 161 ID_POISONED_SIZE
 {
 	// const auto container = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -1555,7 +1627,7 @@ void IsPoisoned() // 162 IS_POISONED
 {
 	// const auto obj = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -1566,7 +1638,7 @@ void CallPoisonedIn() // 163 CALL_POISONED_IN
 	// const auto subtype = Pop().intVal;
 	// const auto type = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -1577,7 +1649,7 @@ void CallNotPoisonedIn() // 164 CALL_NOT_POISONED_IN
 	// const auto subtype = Pop().intVal;
 	// const auto type = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -1585,7 +1657,7 @@ void SpiritPlayed() // 165 SPIRIT_PLAYED
 {
 	// const auto spirit = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -1595,7 +1667,7 @@ void ClingSpirit() // 166 CLING_SPIRIT
 	// const auto xPercent = Popf();
 	// const auto spirit = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void FlySpirit() // 167 FLY_SPIRIT
@@ -1604,7 +1676,7 @@ void FlySpirit() // 167 FLY_SPIRIT
 	// const auto xPercent = Popf();
 	// const auto spirit = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetIdMoveable() // 168 SET_ID_MOVEABLE
@@ -1612,7 +1684,7 @@ void SetIdMoveable() // 168 SET_ID_MOVEABLE
 	// const auto obj = Pop().uintVal;
 	// const auto moveable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetIdPickupable() // 169 SET_ID_PICKUPABLE
@@ -1620,14 +1692,14 @@ void SetIdPickupable() // 169 SET_ID_PICKUPABLE
 	// const auto obj = Pop().uintVal;
 	// const auto pickupable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void IsOnFire() // 170 IS_ON_FIRE
 {
 	// const auto obj = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -1636,7 +1708,7 @@ void IsFireNear() // 171 IS_FIRE_NEAR
 	// const auto radius = Popf();
 	// const auto position = PopVec();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -1656,7 +1728,7 @@ void SetPoisoned() // 173 SET_POISONED
 	// const auto obj = Pop().uintVal;
 	// const auto poisoned = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetTemperature() // 174 SET_TEMPERATURE
@@ -1664,7 +1736,7 @@ void SetTemperature() // 174 SET_TEMPERATURE
 	// const auto temperature = Popf();
 	// const auto obj = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetOnFire() // 175 SET_ON_FIRE
@@ -1673,7 +1745,7 @@ void SetOnFire() // 175 SET_ON_FIRE
 	// const auto object = Pop().uintVal;
 	// const auto enable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetTarget() // 176 SET_TARGET
@@ -1682,7 +1754,7 @@ void SetTarget() // 176 SET_TARGET
 	// const auto position = PopVec();
 	// const auto obj = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void WalkPath() // 177 WALK_PATH
@@ -1693,7 +1765,7 @@ void WalkPath() // 177 WALK_PATH
 	// const auto forward = static_cast<bool>(Pop().intVal);
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void FocusAndPositionFollow() // 178 FOCUS_AND_POSITION_FOLLOW
@@ -1701,14 +1773,14 @@ void FocusAndPositionFollow() // 178 FOCUS_AND_POSITION_FOLLOW
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetWalkPathPercentage() // 179 GET_WALK_PATH_PERCENTAGE
 {
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -1719,7 +1791,7 @@ void CameraProperties() // 180 CAMERA_PROPERTIES
 	// const auto speed = Popf();
 	// const auto distance = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void EnableDisableMusic() // 181 ENABLE_DISABLE_MUSIC
@@ -1727,14 +1799,14 @@ void EnableDisableMusic() // 181 ENABLE_DISABLE_MUSIC
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetMusicObjDistance() // 182 GET_MUSIC_OBJ_DISTANCE
 {
 	// const auto source = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -1742,7 +1814,7 @@ void GetMusicEnumDistance() // 183 GET_MUSIC_ENUM_DISTANCE
 {
 	// const auto type = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -1753,7 +1825,7 @@ void SetMusicPlayPosition() // 184 SET_MUSIC_PLAY_POSITION
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void AttachObjectLeashToObject() // 185 ATTACH_OBJECT_LEASH_TO_OBJECT
@@ -1761,21 +1833,21 @@ void AttachObjectLeashToObject() // 185 ATTACH_OBJECT_LEASH_TO_OBJECT
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void AttachObjectLeashToHand() // 186 ATTACH_OBJECT_LEASH_TO_HAND
 {
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void DetachObjectLeash() // 187 DETACH_OBJECT_LEASH
 {
 	// const auto creature = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetCreatureOnlyDesire() // 188 SET_CREATURE_ONLY_DESIRE
@@ -1784,28 +1856,28 @@ void SetCreatureOnlyDesire() // 188 SET_CREATURE_ONLY_DESIRE
 	// const auto desire = Pop().intVal;
 	// const auto creature = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetCreatureOnlyDesireOff() // 189 SET_CREATURE_ONLY_DESIRE_OFF
 {
 	// const auto creature = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void RestartMusic() // 190 RESTART_MUSIC
 {
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void MusicPlayed191() // 191 MUSIC_PLAYED
 {
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushi(0);
 }
 
@@ -1815,21 +1887,21 @@ void IsOfType() // 192 IS_OF_TYPE
 	// const auto type = Pop().intVal;
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
 void ClearHitObject() // 193 CLEAR_HIT_OBJECT
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GameThingHit() // 194 GAME_THING_HIT
 {
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -1842,7 +1914,7 @@ void SpellAtThing() // 195 SPELL_AT_THING
 	// const auto target = Pop().uintVal;
 	// const auto spell = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -1855,7 +1927,7 @@ void SpellAtPos() // 196 SPELL_AT_POS
 	// const auto target = PopVec();
 	// const auto spell = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -1863,7 +1935,7 @@ void CallPlayerCreature() // 197 CALL_PLAYER_CREATURE
 {
 	// const auto player = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -1871,21 +1943,21 @@ void GetSlowestSpeed() // 198 GET_SLOWEST_SPEED
 {
 	// const auto flock = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
 void GetObjectHeld199() // 199 GET_OBJECT_HELD
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
 void HelpSystemOn() // 200 HELP_SYSTEM_ON
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -1896,7 +1968,7 @@ void ShakeCamera() // 201 SHAKE_CAMERA
 	// const auto radius = Popf();
 	// const auto position = PopVec();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetAnimationModify() // 202 SET_ANIMATION_MODIFY
@@ -1904,7 +1976,7 @@ void SetAnimationModify() // 202 SET_ANIMATION_MODIFY
 	// const auto creature = Pop().uintVal;
 	// const auto enable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetAviSequence() // 203 SET_AVI_SEQUENCE
@@ -1912,7 +1984,7 @@ void SetAviSequence() // 203 SET_AVI_SEQUENCE
 	// const auto aviSequence = Pop().intVal;
 	// const auto enable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void PlayGesture() // 204 PLAY_GESTURE
@@ -1923,27 +1995,27 @@ void PlayGesture() // 204 PLAY_GESTURE
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void DevFunction() // 205 DEV_FUNCTION
 {
 	// const auto func = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void HasMouseWheel() // 206 HAS_MOUSE_WHEEL
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
 void NumMouseButtons() // 207 NUM_MOUSE_BUTTONS
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -1952,7 +2024,7 @@ void SetCreatureDevStage() // 208 SET_CREATURE_DEV_STAGE
 	// const auto stage = Pop().intVal;
 	// const auto creature = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetFixedCamRotation() // 209 SET_FIXED_CAM_ROTATION
@@ -1962,7 +2034,7 @@ void SetFixedCamRotation() // 209 SET_FIXED_CAM_ROTATION
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SwapCreature() // 210 SWAP_CREATURE
@@ -1970,7 +2042,7 @@ void SwapCreature() // 210 SWAP_CREATURE
 	// const auto toCreature = Pop().uintVal;
 	// const auto fromCreature = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetArena() // 211 GET_ARENA
@@ -1981,7 +2053,7 @@ void GetArena() // 211 GET_ARENA
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -1989,7 +2061,7 @@ void GetFootballPitch() // 212 GET_FOOTBALL_PITCH
 {
 	// const auto town = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -1997,7 +2069,7 @@ void StopAllGames() // 213 STOP_ALL_GAMES
 {
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void AttachToGame() // 214 ATTACH_TO_GAME
@@ -2006,7 +2078,7 @@ void AttachToGame() // 214 ATTACH_TO_GAME
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void DetachFromGame() // 215 DETACH_FROM_GAME
@@ -2015,7 +2087,7 @@ void DetachFromGame() // 215 DETACH_FROM_GAME
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void DetachUndefinedFromGame() // 216 DETACH_UNDEFINED_FROM_GAME
@@ -2023,7 +2095,7 @@ void DetachUndefinedFromGame() // 216 DETACH_UNDEFINED_FROM_GAME
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetOnlyForScripts() // 217 SET_ONLY_FOR_SCRIPTS
@@ -2031,7 +2103,7 @@ void SetOnlyForScripts() // 217 SET_ONLY_FOR_SCRIPTS
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void StartMatchWithReferee() // 218 START_MATCH_WITH_REFEREE
@@ -2039,7 +2111,7 @@ void StartMatchWithReferee() // 218 START_MATCH_WITH_REFEREE
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GameTeamSize() // 219 GAME_TEAM_SIZE
@@ -2047,14 +2119,14 @@ void GameTeamSize() // 219 GAME_TEAM_SIZE
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GameType() // 220 GAME_TYPE
 {
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushi(0);
 }
 
@@ -2062,7 +2134,7 @@ void GameSubType() // 221 GAME_SUB_TYPE
 {
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushi(0);
 }
 
@@ -2070,7 +2142,7 @@ void IsLeashed() // 222 IS_LEASHED
 {
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -2079,33 +2151,33 @@ void SetCreatureHome() // 223 SET_CREATURE_HOME
 	// const auto position = PopVec();
 	// const auto creature = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetHitObject() // 224 GET_HIT_OBJECT
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
 void GetObjectWhichHit() // 225 GET_OBJECT_WHICH_HIT
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
 void GetNearestTownOfPlayer() // 226 GET_NEAREST_TOWN_OF_PLAYER
 {
-	// const auto unk4 = Pop().intVal;
-	// const auto unk3 = Pop().intVal;
-	// const auto unk2 = Pop().intVal;
-	// const auto unk1 = Pop().intVal;
-	// const auto unk0 = Pop().intVal;
-	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
-	Pusho(0);
+	const auto radius = Popf();
+	const auto player = Pop().intVal;
+	const auto position = PopVec();
+
+	SpatialQueryFilter filter;
+	filter.type = ObjectType::Town;
+	filter.owner = static_cast<PlayerNames>(player);
+	Pusho(FindNearestObject(position, filter, 0.0f, radius));
 }
 
 void SpellAtPoint() // 227 SPELL_AT_POINT
@@ -2114,7 +2186,7 @@ void SpellAtPoint() // 227 SPELL_AT_POINT
 	// const auto position = PopVec();
 	// const auto spell = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -2123,14 +2195,14 @@ void SetAttackOwnTown() // 228 SET_ATTACK_OWN_TOWN
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void IsFighting() // 229 IS_FIGHTING
 {
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -2139,7 +2211,7 @@ void SetMagicRadius() // 230 SET_MAGIC_RADIUS
 	// const auto radius = Popf();
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void TempTextWithNumber() // 231 TEMP_TEXT_WITH_NUMBER
@@ -2149,7 +2221,7 @@ void TempTextWithNumber() // 231 TEMP_TEXT_WITH_NUMBER
 	// const auto format = PopString();
 	// const auto singleLine = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void RunTextWithNumber() // 232 RUN_TEXT_WITH_NUMBER
@@ -2159,7 +2231,7 @@ void RunTextWithNumber() // 232 RUN_TEXT_WITH_NUMBER
 	// const auto string = Pop().intVal;
 	// const auto singleLine = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void CreatureSpellReversion() // 233 CREATURE_SPELL_REVERSION
@@ -2167,7 +2239,7 @@ void CreatureSpellReversion() // 233 CREATURE_SPELL_REVERSION
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetDesire() // 234 GET_DESIRE
@@ -2175,7 +2247,7 @@ void GetDesire() // 234 GET_DESIRE
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -2183,7 +2255,7 @@ void GetEventsPerSecond() // 235 GET_EVENTS_PER_SECOND
 {
 	// const auto type = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -2191,7 +2263,7 @@ void GetTimeSince() // 236 GET_TIME_SINCE
 {
 	// const auto type = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -2199,7 +2271,7 @@ void GetTotalEvents() // 237 GET_TOTAL_EVENTS
 {
 	// const auto type = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -2213,7 +2285,7 @@ void UpdateSnapshot() // 238 UPDATE_SNAPSHOT
 	// const auto alignment = Popf();
 	// const auto success = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void CreateReward() // 239 CREATE_REWARD
@@ -2222,7 +2294,7 @@ void CreateReward() // 239 CREATE_REWARD
 	// const auto position = PopVec();
 	// const auto reward = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -2233,7 +2305,7 @@ void CreateRewardInTown() // 240 CREATE_REWARD_IN_TOWN
 	// const auto town = Pop().uintVal;
 	// const auto reward = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -2244,20 +2316,20 @@ void SetFade() // 241 SET_FADE
 	// const auto green = Popf();
 	// const auto red = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetFadeIn() // 242 SET_FADE_IN
 {
 	// const auto duration = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void FadeFinished() // 243 FADE_FINISHED
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -2267,7 +2339,7 @@ void SetPlayerMagic() // 244 SET_PLAYER_MAGIC
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void HasPlayerMagic() // 245 HAS_PLAYER_MAGIC
@@ -2275,7 +2347,7 @@ void HasPlayerMagic() // 245 HAS_PLAYER_MAGIC
 	// const auto player = Popf();
 	// const auto spell = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -2284,7 +2356,7 @@ void SpiritSpeaks() // 246 SPIRIT_SPEAKS
 	// const auto textID = Pop().intVal;
 	// const auto spirit = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -2293,7 +2365,7 @@ void BeliefForPlayer() // 247 BELIEF_FOR_PLAYER
 	// const auto player = Popf();
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -2301,7 +2373,7 @@ void GetHelp() // 248 GET_HELP
 {
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -2310,14 +2382,14 @@ void SetLeashWorks() // 249 SET_LEASH_WORKS
 	// const auto creature = Pop().uintVal;
 	// const auto enable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void LoadMyCreature() // 250 LOAD_MY_CREATURE
 {
 	// const auto position = PopVec();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void ObjectRelativeBelief() // 251 OBJECT_RELATIVE_BELIEF
@@ -2326,7 +2398,7 @@ void ObjectRelativeBelief() // 251 OBJECT_RELATIVE_BELIEF
 	// const auto player = Popf();
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void CreateWithAngleAndScale() // 252 CREATE_WITH_ANGLE_AND_SCALE
@@ -2346,7 +2418,7 @@ void SetHelpSystem() // 253 SET_HELP_SYSTEM
 {
 	// const auto enable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetVirtualInfluence() // 254 SET_VIRTUAL_INFLUENCE
@@ -2354,7 +2426,7 @@ void SetVirtualInfluence() // 254 SET_VIRTUAL_INFLUENCE
 	// const auto player = Popf();
 	// const auto enable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetActive() // 255 SET_ACTIVE
@@ -2362,7 +2434,7 @@ void SetActive() // 255 SET_ACTIVE
 	// const auto object = Pop().uintVal;
 	// const auto active = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void ThingValid() // 256 THING_VALID
@@ -2382,7 +2454,7 @@ void VortexFadeOut() // 257 VORTEX_FADE_OUT
 {
 	// const auto vortex = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void RemoveReactionOfType() // 258 REMOVE_REACTION_OF_TYPE
@@ -2390,7 +2462,7 @@ void RemoveReactionOfType() // 258 REMOVE_REACTION_OF_TYPE
 	// const auto reaction = Pop().intVal;
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void CreatureLearnEverythingExcluding() // 259 CREATURE_LEARN_EVERYTHING_EXCLUDING
@@ -2398,14 +2470,14 @@ void CreatureLearnEverythingExcluding() // 259 CREATURE_LEARN_EVERYTHING_EXCLUDI
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void PlayedPercentage() // 260 PLAYED_PERCENTAGE
 {
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -2414,7 +2486,7 @@ void ObjectCastByObject() // 261 OBJECT_CAST_BY_OBJECT
 	// const auto caster = Pop().uintVal;
 	// const auto spellInstance = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -2422,7 +2494,7 @@ void IsWindMagicAtPos() // 262 IS_WIND_MAGIC_AT_POS
 {
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -2436,7 +2508,7 @@ void CreateMist() // 263 CREATE_MIST
 	// const auto scale = Popf();
 	// const auto pos = PopVec();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -2449,14 +2521,14 @@ void SetMistFade() // 264 SET_MIST_FADE
 	// const auto startScale = Popf();
 	// const auto mist = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetObjectFade() // 265 GET_OBJECT_FADE
 {
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -2466,13 +2538,13 @@ void PlayHandDemo() // 266 PLAY_HAND_DEMO
 	// const auto withPause = static_cast<bool>(Pop().intVal);
 	// const auto string = PopString();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void IsPlayingHandDemo() // 267 IS_PLAYING_HAND_DEMO
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -2480,7 +2552,7 @@ void GetArsePosition() // 268 GET_ARSE_POSITION
 {
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushv(0.0f); // x
 	Pushv(0.0f); // y
 	Pushv(0.0f); // z
@@ -2491,7 +2563,7 @@ void IsLeashedToObject() // 269 IS_LEASHED_TO_OBJECT
 	// const auto target = Pop().uintVal;
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -2499,7 +2571,7 @@ void GetInteractionMagnitude() // 270 GET_INTERACTION_MAGNITUDE
 {
 	// const auto creature = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -2507,7 +2579,7 @@ void IsCreatureAvailable() // 271 IS_CREATURE_AVAILABLE
 {
 	// const auto type = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -2517,7 +2589,7 @@ void CreateHighlight() // 272 CREATE_HIGHLIGHT
 	// const auto position = PopVec();
 	// const auto type = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -2525,7 +2597,7 @@ void GetObjectHeld273() // 273 GET_OBJECT_HELD
 {
 	// const auto creature = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -2534,7 +2606,7 @@ void GetActionCount() // 274 GET_ACTION_COUNT
 	// const auto creature = Pop().uintVal;
 	// const auto action = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -2542,7 +2614,7 @@ void GetObjectLeashType() // 275 GET_OBJECT_LEASH_TYPE
 {
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushi(0);
 }
 
@@ -2550,14 +2622,14 @@ void SetFocusFollow() // 276 SET_FOCUS_FOLLOW
 {
 	// const auto target = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetPositionFollow() // 277 SET_POSITION_FOLLOW
 {
 	// const auto target = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetFocusAndPositionFollow() // 278 SET_FOCUS_AND_POSITION_FOLLOW
@@ -2565,14 +2637,14 @@ void SetFocusAndPositionFollow() // 278 SET_FOCUS_AND_POSITION_FOLLOW
 	// const auto distance = Popf();
 	// const auto target = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetCameraLens() // 279 SET_CAMERA_LENS
 {
 	// const auto lens = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void MoveCameraLens() // 280 MOVE_CAMERA_LENS
@@ -2580,7 +2652,7 @@ void MoveCameraLens() // 280 MOVE_CAMERA_LENS
 	// const auto time = Popf();
 	// const auto lens = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void CreatureReaction() // 281 CREATURE_REACTION
@@ -2588,7 +2660,7 @@ void CreatureReaction() // 281 CREATURE_REACTION
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void CreatureInDevScript() // 282 CREATURE_IN_DEV_SCRIPT
@@ -2596,26 +2668,26 @@ void CreatureInDevScript() // 282 CREATURE_IN_DEV_SCRIPT
 	// const auto creature = Pop().uintVal;
 	// const auto enable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void StoreCameraDetails() // 283 STORE_CAMERA_DETAILS
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void RestoreCameraDetails() // 284 RESTORE_CAMERA_DETAILS
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void StartAngleSound285() // 285 START_ANGLE_SOUND
 {
 	// const auto enable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetCameraPosFocLens() // 286 SET_CAMERA_POS_FOC_LENS
@@ -2628,7 +2700,7 @@ void SetCameraPosFocLens() // 286 SET_CAMERA_POS_FOC_LENS
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void MoveCameraPosFocLens() // 287 MOVE_CAMERA_POS_FOC_LENS
@@ -2642,14 +2714,14 @@ void MoveCameraPosFocLens() // 287 MOVE_CAMERA_POS_FOC_LENS
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GameTimeOnOff() // 288 GAME_TIME_ON_OFF
 {
 	// const auto enable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void MoveGameTime() // 289 MOVE_GAME_TIME
@@ -2657,7 +2729,7 @@ void MoveGameTime() // 289 MOVE_GAME_TIME
 	// const auto duration = Popf();
 	// const auto hourOfTheDay = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetHighGraphicsDetail() // 290 SET_HIGH_GRAPHICS_DETAIL
@@ -2665,7 +2737,7 @@ void SetHighGraphicsDetail() // 290 SET_HIGH_GRAPHICS_DETAIL
 	// const auto object = Pop().uintVal;
 	// const auto enable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetSkeleton() // 291 SET_SKELETON
@@ -2673,14 +2745,14 @@ void SetSkeleton() // 291 SET_SKELETON
 	// const auto object = Pop().uintVal;
 	// const auto enable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void IsSkeleton() // 292 IS_SKELETON
 {
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -2688,7 +2760,7 @@ void PlayerSpellCastTime() // 293 PLAYER_SPELL_CAST_TIME
 {
 	// const auto player = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -2696,7 +2768,7 @@ void PlayerSpellLastCast() // 294 PLAYER_SPELL_LAST_CAST
 {
 	// const auto player = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushi(0);
 }
 
@@ -2704,7 +2776,7 @@ void GetLastSpellCastPos() // 295 GET_LAST_SPELL_CAST_POS
 {
 	// const auto player = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushv(0.0f); // x
 	Pushv(0.0f); // y
 	Pushv(0.0f); // z
@@ -2715,7 +2787,7 @@ void AddSpotVisualTargetPos() // 296 ADD_SPOT_VISUAL_TARGET_POS
 	// const auto position = PopVec();
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void AddSpotVisualTargetObject() // 297 ADD_SPOT_VISUAL_TARGET_OBJECT
@@ -2723,7 +2795,7 @@ void AddSpotVisualTargetObject() // 297 ADD_SPOT_VISUAL_TARGET_OBJECT
 	// const auto target = Pop().uintVal;
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetIndestructable() // 298 SET_INDESTRUCTABLE
@@ -2731,7 +2803,7 @@ void SetIndestructable() // 298 SET_INDESTRUCTABLE
 	// const auto object = Pop().uintVal;
 	// const auto indestructible = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetGraphicsClipping() // 299 SET_GRAPHICS_CLIPPING
@@ -2739,21 +2811,21 @@ void SetGraphicsClipping() // 299 SET_GRAPHICS_CLIPPING
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SpiritAppear() // 300 SPIRIT_APPEAR
 {
 	// const auto spirit = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SpiritDisappear() // 301 SPIRIT_DISAPPEAR
 {
 	// const auto spirit = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetFocusOnObject() // 302 SET_FOCUS_ON_OBJECT
@@ -2761,20 +2833,20 @@ void SetFocusOnObject() // 302 SET_FOCUS_ON_OBJECT
 	// const auto target = Pop().uintVal;
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void ReleaseObjectFocus() // 303 RELEASE_OBJECT_FOCUS
 {
 	// const auto creature = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void ImmersionExists() // 304 IMMERSION_EXISTS
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -2782,14 +2854,14 @@ void SetDrawLeash() // 305 SET_DRAW_LEASH
 {
 	// const auto enable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetDrawHighlight() // 306 SET_DRAW_HIGHLIGHT
 {
 	// const auto enable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetOpenClose() // 307 SET_OPEN_CLOSE
@@ -2797,14 +2869,14 @@ void SetOpenClose() // 307 SET_OPEN_CLOSE
 	// const auto object = Pop().uintVal;
 	// const auto open = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetIntroBuilding() // 308 SET_INTRO_BUILDING
 {
 	// const auto enable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void CreatureForceFriends() // 309 CREATURE_FORCE_FRIENDS
@@ -2813,7 +2885,7 @@ void CreatureForceFriends() // 309 CREATURE_FORCE_FRIENDS
 	// const auto creature = Pop().uintVal;
 	// const auto enable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void MoveComputerPlayerPosition() // 310 MOVE_COMPUTER_PLAYER_POSITION
@@ -2823,7 +2895,7 @@ void MoveComputerPlayerPosition() // 310 MOVE_COMPUTER_PLAYER_POSITION
 	// const auto position = PopVec();
 	// const auto player = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void EnableDisableComputerPlayer311() // 311 ENABLE_DISABLE_COMPUTER_PLAYER
@@ -2831,14 +2903,14 @@ void EnableDisableComputerPlayer311() // 311 ENABLE_DISABLE_COMPUTER_PLAYER
 	// const auto player = Popf();
 	// const auto enable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetComputerPlayerPosition() // 312 GET_COMPUTER_PLAYER_POSITION
 {
 	// const auto player = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushv(0.0f); // x
 	Pushv(0.0f); // y
 	Pushv(0.0f); // z
@@ -2850,13 +2922,13 @@ void SetComputerPlayerPosition() // 313 SET_COMPUTER_PLAYER_POSITION
 	// const auto position = PopVec();
 	// const auto player = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetStoredCameraPosition() // 314 GET_STORED_CAMERA_POSITION
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushv(0.0f); // x
 	Pushv(0.0f); // y
 	Pushv(0.0f); // z
@@ -2865,7 +2937,7 @@ void GetStoredCameraPosition() // 314 GET_STORED_CAMERA_POSITION
 void GetStoredCameraFocus() // 315 GET_STORED_CAMERA_FOCUS
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushv(0.0f); // x
 	Pushv(0.0f); // y
 	Pushv(0.0f); // z
@@ -2873,22 +2945,27 @@ void GetStoredCameraFocus() // 315 GET_STORED_CAMERA_FOCUS
 
 void CallNearInState() // 316 CALL_NEAR_IN_STATE
 {
-	// const auto excludingScripted = static_cast<bool>(Pop().intVal);
-	// const auto radius = Popf();
-	// const auto position = PopVec();
-	// const auto state = Pop().intVal;
-	// const auto subtype = Pop().intVal;
-	// const auto type = Pop().intVal;
-	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
-	Pusho(0);
+	const auto excludingScripted = static_cast<bool>(Pop().intVal);
+	const auto radius = Popf();
+	const auto position = PopVec();
+	const auto state = Pop().intVal;
+	const auto subtype = Pop().intVal;
+	const auto type = static_cast<ObjectType>(Pop().intVal);
+
+	auto filter = MakeScriptFilter(type, subtype, excludingScripted);
+	filter.predicate = [state](entt::entity entity) {
+		const auto* action = Locator::entitiesRegistry::value().TryGet<LivingAction>(entity);
+		return action != nullptr &&
+		       action->states[static_cast<size_t>(LivingAction::Index::Top)] == static_cast<uint8_t>(state);
+	};
+	Pusho(FindNearestObject(position, filter, 0.0f, radius));
 }
 
 void SetCreatureSound() // 317 SET_CREATURE_SOUND
 {
 	// const auto enable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void CreatureInteractingWith() // 318 CREATURE_INTERACTING_WITH
@@ -2896,7 +2973,7 @@ void CreatureInteractingWith() // 318 CREATURE_INTERACTING_WITH
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -2904,14 +2981,14 @@ void SetSunDraw() // 319 SET_SUN_DRAW
 {
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void ObjectInfoBits() // 320 OBJECT_INFO_BITS
 {
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -2920,7 +2997,7 @@ void SetHurtByFire() // 321 SET_HURT_BY_FIRE
 	// const auto object = Pop().uintVal;
 	// const auto enable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void ConfinedObject() // 322 CONFINED_OBJECT
@@ -2931,21 +3008,21 @@ void ConfinedObject() // 322 CONFINED_OBJECT
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void ClearConfinedObject() // 323 CLEAR_CONFINED_OBJECT
 {
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetObjectFlock() // 324 GET_OBJECT_FLOCK
 {
 	// const auto member = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -2955,21 +3032,21 @@ void SetPlayerBelief() // 325 SET_PLAYER_BELIEF
 	// const auto player = Popf();
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void PlayJcSpecial() // 326 PLAY_JC_SPECIAL
 {
 	// const auto feature = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void IsPlayingJcSpecial() // 327 IS_PLAYING_JC_SPECIAL
 {
 	// const auto feature = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -2982,7 +3059,7 @@ void VortexParameters() // 328 VORTEX_PARAMETERS
 	// const auto town = Pop().uintVal;
 	// const auto vortex = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void LoadCreature() // 329 LOAD_CREATURE
@@ -2992,14 +3069,14 @@ void LoadCreature() // 329 LOAD_CREATURE
 	// const auto mindFilename = PopString();
 	// const auto type = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void IsSpellCharging() // 330 IS_SPELL_CHARGING
 {
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -3008,7 +3085,7 @@ void IsThatSpellCharging() // 331 IS_THAT_SPELL_CHARGING
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -3016,7 +3093,7 @@ void OpposingCreature() // 332 OPPOSING_CREATURE
 {
 	// const auto god = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushi(0);
 }
 
@@ -3024,7 +3101,7 @@ void FlockWithinLimits() // 333 FLOCK_WITHIN_LIMITS
 {
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -3034,21 +3111,21 @@ void HighlightProperties() // 334 HIGHLIGHT_PROPERTIES
 	// const auto text = Pop().intVal;
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void LastMusicLine() // 335 LAST_MUSIC_LINE
 {
 	// const auto line = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
 void HandDemoTrigger() // 336 HAND_DEMO_TRIGGER
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -3056,7 +3133,7 @@ void GetBellyPosition() // 337 GET_BELLY_POSITION
 {
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushv(0.0f); // x
 	Pushv(0.0f); // y
 	Pushv(0.0f); // z
@@ -3070,7 +3147,7 @@ void SetCreatureCreedProperties() // 338 SET_CREATURE_CREED_PROPERTIES
 	// const auto handGlow = Pop().intVal;
 	// const auto creature = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GameThingCanViewCamera() // 339 GAME_THING_CAN_VIEW_CAMERA
@@ -3078,7 +3155,7 @@ void GameThingCanViewCamera() // 339 GAME_THING_CAN_VIEW_CAMERA
 	// const auto degrees = Popf();
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -3089,7 +3166,7 @@ void GamePlaySaySoundEffect() // 340 GAME_PLAY_SAY_SOUND_EFFECT
 	// const auto sound = Pop().intVal;
 	// const auto extra = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetTownDesireBoost() // 341 SET_TOWN_DESIRE_BOOST
@@ -3098,14 +3175,14 @@ void SetTownDesireBoost() // 341 SET_TOWN_DESIRE_BOOST
 	// const auto desire = Pop().intVal;
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void IsLockedInteraction() // 342 IS_LOCKED_INTERACTION
 {
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -3114,14 +3191,14 @@ void SetCreatureName() // 343 SET_CREATURE_NAME
 	// const auto textID = Pop().intVal;
 	// const auto creature = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void ComputerPlayerReady() // 344 COMPUTER_PLAYER_READY
 {
 	// const auto player = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -3130,14 +3207,14 @@ void EnableDisableComputerPlayer345() // 345 ENABLE_DISABLE_COMPUTER_PLAYER
 	// const auto player = Popf();
 	// const auto pause = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void ClearActorMind() // 346 CLEAR_ACTOR_MIND
 {
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void EnterExitCitadel() // 347 ENTER_EXIT_CITADEL
@@ -3161,7 +3238,7 @@ void EnterExitCitadel() // 347 ENTER_EXIT_CITADEL
 	}
 	else
 	{
-		SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "No temple");
+		SPDLOG_LOGGER_DEBUG(GetLogger(LoggingSubsystem::game), "No temple");
 	}
 }
 
@@ -3169,7 +3246,7 @@ void StartAngleSound348() // 348 START_ANGLE_SOUND
 {
 	// const auto enable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void ThingJcSpecial() // 349 THING_JC_SPECIAL
@@ -3178,14 +3255,14 @@ void ThingJcSpecial() // 349 THING_JC_SPECIAL
 	// const auto feature = Pop().intVal;
 	// const auto enable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void MusicPlayed350() // 350 MUSIC_PLAYED
 {
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushi(0);
 }
 
@@ -3199,7 +3276,7 @@ void UpdateSnapshotPicture() // 351 UPDATE_SNAPSHOT_PICTURE
 	// const auto focus = PopVec();
 	// const auto position = PopVec();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void StopScriptsInFilesExcluding() // 352 STOP_SCRIPTS_IN_FILES_EXCLUDING
@@ -3220,7 +3297,7 @@ void CreateRandomVillagerOfTribe() // 353 CREATE_RANDOM_VILLAGER_OF_TRIBE
 	// const auto position = PopVec();
 	// const auto tribe = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -3228,7 +3305,7 @@ void ToggleLeash() // 354 TOGGLE_LEASH
 {
 	// const auto player = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GameSetMana() // 355 GAME_SET_MANA
@@ -3236,7 +3313,7 @@ void GameSetMana() // 355 GAME_SET_MANA
 	// const auto mana = Popf();
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetMagicProperties() // 356 SET_MAGIC_PROPERTIES
@@ -3245,21 +3322,21 @@ void SetMagicProperties() // 356 SET_MAGIC_PROPERTIES
 	// const auto magicType = Pop().intVal;
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetGameSound() // 357 SET_GAME_SOUND
 {
 	// const auto enable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SexIsMale() // 358 SEX_IS_MALE
 {
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -3267,7 +3344,7 @@ void GetFirstHelp() // 359 GET_FIRST_HELP
 {
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -3275,7 +3352,7 @@ void GetLastHelp() // 360 GET_LAST_HELP
 {
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -3283,7 +3360,7 @@ void IsActive() // 361 IS_ACTIVE
 {
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -3294,7 +3371,7 @@ void SetBookmarkPosition() // 362 SET_BOOKMARK_POSITION
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetScaffoldProperties() // 363 SET_SCAFFOLD_PROPERTIES
@@ -3304,7 +3381,7 @@ void SetScaffoldProperties() // 363 SET_SCAFFOLD_PROPERTIES
 	// const auto type = Pop().intVal;
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetComputerPlayerPersonality() // 364 SET_COMPUTER_PLAYER_PERSONALITY
@@ -3313,7 +3390,7 @@ void SetComputerPlayerPersonality() // 364 SET_COMPUTER_PLAYER_PERSONALITY
 	// const auto aspect = PopString();
 	// const auto player = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetComputerPlayerSuppression() // 365 SET_COMPUTER_PLAYER_SUPPRESSION
@@ -3322,7 +3399,7 @@ void SetComputerPlayerSuppression() // 365 SET_COMPUTER_PLAYER_SUPPRESSION
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void ForceComputerPlayerAction() // 366 FORCE_COMPUTER_PLAYER_ACTION
@@ -3332,7 +3409,7 @@ void ForceComputerPlayerAction() // 366 FORCE_COMPUTER_PLAYER_ACTION
 	// const auto action = PopString();
 	// const auto player = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void QueueComputerPlayerAction() // 367 QUEUE_COMPUTER_PLAYER_ACTION
@@ -3342,14 +3419,14 @@ void QueueComputerPlayerAction() // 367 QUEUE_COMPUTER_PLAYER_ACTION
 	// const auto action = PopString();
 	// const auto player = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetTownWithId() // 368 GET_TOWN_WITH_ID
 {
 	// const auto id = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -3359,14 +3436,14 @@ void SetDisciple() // 369 SET_DISCIPLE
 	// const auto discipleType = Pop().intVal;
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void ReleaseComputerPlayer() // 370 RELEASE_COMPUTER_PLAYER
 {
 	// const auto player = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetComputerPlayerSpeed() // 371 SET_COMPUTER_PLAYER_SPEED
@@ -3374,28 +3451,28 @@ void SetComputerPlayerSpeed() // 371 SET_COMPUTER_PLAYER_SPEED
 	// const auto speed = Popf();
 	// const auto player = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetFocusFollowComputerPlayer() // 372 SET_FOCUS_FOLLOW_COMPUTER_PLAYER
 {
 	// const auto player = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetPositionFollowComputerPlayer() // 373 SET_POSITION_FOLLOW_COMPUTER_PLAYER
 {
 	// const auto player = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void CallComputerPlayer() // 374 CALL_COMPUTER_PLAYER
 {
 	// const auto player = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -3406,7 +3483,7 @@ void CallBuildingInTown() // 375 CALL_BUILDING_IN_TOWN
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushi(0);
 }
 
@@ -3415,14 +3492,14 @@ void SetCanBuildWorshipsite() // 376 SET_CAN_BUILD_WORSHIPSITE
 	// const auto object = Pop().uintVal;
 	// const auto enable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetFacingCameraPosition() // 377 GET_FACING_CAMERA_POSITION
 {
 	// const auto distance = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushv(0.0f); // x
 	Pushv(0.0f); // y
 	Pushv(0.0f); // z
@@ -3434,7 +3511,7 @@ void SetComputerPlayerAttitude() // 378 SET_COMPUTER_PLAYER_ATTITUDE
 	// const auto player2 = Popf();
 	// const auto player1 = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetComputerPlayerAttitude() // 379 GET_COMPUTER_PLAYER_ATTITUDE
@@ -3442,7 +3519,7 @@ void GetComputerPlayerAttitude() // 379 GET_COMPUTER_PLAYER_ATTITUDE
 	// const auto player2 = Popf();
 	// const auto player1 = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -3451,7 +3528,7 @@ void LoadComputerPlayerPersonality() // 380 LOAD_COMPUTER_PLAYER_PERSONALITY
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SaveComputerPlayerPersonality() // 381 SAVE_COMPUTER_PLAYER_PERSONALITY
@@ -3459,7 +3536,7 @@ void SaveComputerPlayerPersonality() // 381 SAVE_COMPUTER_PLAYER_PERSONALITY
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetPlayerAlly() // 382 SET_PLAYER_ALLY
@@ -3468,7 +3545,7 @@ void SetPlayerAlly() // 382 SET_PLAYER_ALLY
 	// const auto player2 = Popf();
 	// const auto player1 = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void CallFlying() // 383 CALL_FLYING
@@ -3479,7 +3556,7 @@ void CallFlying() // 383 CALL_FLYING
 	// const auto subtype = Pop().intVal;
 	// const auto type = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -3488,14 +3565,14 @@ void SetObjectFadeIn() // 384 SET_OBJECT_FADE_IN
 	// const auto time = Popf();
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void IsAffectedBySpell() // 385 IS_AFFECTED_BY_SPELL
 {
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -3505,14 +3582,14 @@ void SetMagicInObject() // 386 SET_MAGIC_IN_OBJECT
 	// const auto MAGIC_TYPE = Pop().intVal;
 	// const auto enable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void IdAdultSize() // 387 ID_ADULT_SIZE
 {
 	// const auto container = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -3520,7 +3597,7 @@ void ObjectCapacity() // 388 OBJECT_CAPACITY
 {
 	// const auto container = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -3528,7 +3605,7 @@ void ObjectAdultCapacity() // 389 OBJECT_ADULT_CAPACITY
 {
 	// const auto container = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -3537,14 +3614,14 @@ void SetCreatureAutoFighting() // 390 SET_CREATURE_AUTO_FIGHTING
 	// const auto creature = Pop().uintVal;
 	// const auto enable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void IsAutoFighting() // 391 IS_AUTO_FIGHTING
 {
 	// const auto creature = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -3553,7 +3630,7 @@ void SetCreatureQueueFightMove() // 392 SET_CREATURE_QUEUE_FIGHT_MOVE
 	// const auto move = Pop().intVal;
 	// const auto creature = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetCreatureQueueFightSpell() // 393 SET_CREATURE_QUEUE_FIGHT_SPELL
@@ -3561,7 +3638,7 @@ void SetCreatureQueueFightSpell() // 393 SET_CREATURE_QUEUE_FIGHT_SPELL
 	// const auto spell = Pop().intVal;
 	// const auto creature = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetCreatureQueueFightStep() // 394 SET_CREATURE_QUEUE_FIGHT_STEP
@@ -3569,14 +3646,14 @@ void SetCreatureQueueFightStep() // 394 SET_CREATURE_QUEUE_FIGHT_STEP
 	// const auto step = Pop().intVal;
 	// const auto creature = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetCreatureFightAction() // 395 GET_CREATURE_FIGHT_ACTION
 {
 	// const auto creature = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushi(0);
 }
 
@@ -3584,7 +3661,7 @@ void CreatureFightQueueHits() // 396 CREATURE_FIGHT_QUEUE_HITS
 {
 	// const auto creature = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -3604,7 +3681,7 @@ void GetPlayerAlly() // 398 GET_PLAYER_ALLY
 	// const auto player2 = Popf();
 	// const auto player1 = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -3613,7 +3690,7 @@ void SetPlayerWindResistance() // 399 SET_PLAYER_WIND_RESISTANCE
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushi(0);
 }
 
@@ -3622,7 +3699,7 @@ void GetPlayerWindResistance() // 400 GET_PLAYER_WIND_RESISTANCE
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushi(0);
 }
 
@@ -3630,21 +3707,21 @@ void PauseUnpauseClimateSystem() // 401 PAUSE_UNPAUSE_CLIMATE_SYSTEM
 {
 	// const auto enable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void PauseUnpauseStormCreationInClimateSystem() // 402 PAUSE_UNPAUSE_STORM_CREATION_IN_CLIMATE_SYSTEM
 {
 	// const auto enable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetManaForSpell() // 403 GET_MANA_FOR_SPELL
 {
 	// const auto spell = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -3653,13 +3730,13 @@ void KillStormsInArea() // 404 KILL_STORMS_IN_AREA
 	// const auto radius = Popf();
 	// const auto position = PopVec();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void InsideTemple() // 405 INSIDE_TEMPLE
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -3667,7 +3744,7 @@ void RestartObject() // 406 RESTART_OBJECT
 {
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetGameTimeProperties() // 407 SET_GAME_TIME_PROPERTIES
@@ -3676,19 +3753,19 @@ void SetGameTimeProperties() // 407 SET_GAME_TIME_PROPERTIES
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void ResetGameTimeProperties() // 408 RESET_GAME_TIME_PROPERTIES
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SoundExists() // 409 SOUND_EXISTS
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -3696,26 +3773,26 @@ void GetTownWorshipDeaths() // 410 GET_TOWN_WORSHIP_DEATHS
 {
 	// const auto town = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
 void GameClearDialogue() // 411 GAME_CLEAR_DIALOGUE
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GameCloseDialogue() // 412 GAME_CLOSE_DIALOGUE
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetHandState() // 413 GET_HAND_STATE
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushi(0);
 }
 
@@ -3723,20 +3800,20 @@ void SetInterfaceCitadel() // 414 SET_INTERFACE_CITADEL
 {
 	// const auto enable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void MapScriptFunction() // 415 MAP_SCRIPT_FUNCTION
 {
 	// const auto command = PopString();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void WithinRotation() // 416 WITHIN_ROTATION
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -3744,7 +3821,7 @@ void GetPlayerTownTotal() // 417 GET_PLAYER_TOWN_TOTAL
 {
 	// const auto player = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -3754,14 +3831,14 @@ void SpiritScreenPoint() // 418 SPIRIT_SCREEN_POINT
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void KeyDown() // 419 KEY_DOWN
 {
 	// const auto key = Pop().intVal;
 	// TODO(Daniels118): implement this (translate key to physical key code)
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -3769,13 +3846,13 @@ void SetFightExit() // 420 SET_FIGHT_EXIT
 {
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetObjectClicked() // 421 GET_OBJECT_CLICKED
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -3783,7 +3860,7 @@ void GetMana() // 422 GET_MANA
 {
 	// const auto worshipSite = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -3791,7 +3868,7 @@ void ClearPlayerSpellCharging() // 423 CLEAR_PLAYER_SPELL_CHARGING
 {
 	// const auto player = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void StopSoundEffect() // 424 STOP_SOUND_EFFECT
@@ -3800,14 +3877,14 @@ void StopSoundEffect() // 424 STOP_SOUND_EFFECT
 	// const auto sound = Pop().intVal;
 	// const auto alwaysFalse = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetTotemStatue() // 425 GET_TOTEM_STATUE
 {
 	// const auto town = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -3816,7 +3893,7 @@ void SetSetOnFire() // 426 SET_SET_ON_FIRE
 	// const auto object = Pop().uintVal;
 	// const auto enable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetLandBalance() // 427 SET_LAND_BALANCE
@@ -3824,7 +3901,7 @@ void SetLandBalance() // 427 SET_LAND_BALANCE
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetObjectBeliefScale() // 428 SET_OBJECT_BELIEF_SCALE
@@ -3832,34 +3909,34 @@ void SetObjectBeliefScale() // 428 SET_OBJECT_BELIEF_SCALE
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void StartImmersion() // 429 START_IMMERSION
 {
 	// const auto effect = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void StopImmersion() // 430 STOP_IMMERSION
 {
 	// const auto effect = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void StopAllImmersion() // 431 STOP_ALL_IMMERSION
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetCreatureInTemple() // 432 SET_CREATURE_IN_TEMPLE
 {
 	// const auto enable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GameDrawText() // 433 GAME_DRAW_TEXT
@@ -3872,7 +3949,7 @@ void GameDrawText() // 433 GAME_DRAW_TEXT
 	// const auto across = Popf();
 	// const auto textID = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GameDrawTempText() // 434 GAME_DRAW_TEMP_TEXT
@@ -3885,14 +3962,14 @@ void GameDrawTempText() // 434 GAME_DRAW_TEMP_TEXT
 	// const auto across = Popf();
 	// const auto string = PopString();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void FadeAllDrawText() // 435 FADE_ALL_DRAW_TEXT
 {
 	// const auto time = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetDrawTextColour() // 436 SET_DRAW_TEXT_COLOUR
@@ -3901,7 +3978,7 @@ void SetDrawTextColour() // 436 SET_DRAW_TEXT_COLOUR
 	// const auto green = Popf();
 	// const auto red = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetClippingWindow() // 437 SET_CLIPPING_WINDOW
@@ -3912,21 +3989,21 @@ void SetClippingWindow() // 437 SET_CLIPPING_WINDOW
 	// const auto down = Popf();
 	// const auto across = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void ClearClippingWindow() // 438 CLEAR_CLIPPING_WINDOW
 {
 	// const auto time = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SaveGameInSlot() // 439 SAVE_GAME_IN_SLOT
 {
 	// const auto slot = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void SetObjectCarrying() // 440 SET_OBJECT_CARRYING
@@ -3934,14 +4011,14 @@ void SetObjectCarrying() // 440 SET_OBJECT_CARRYING
 	// const auto carriedObj = Pop().intVal;
 	// const auto object = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void PosValidForCreature() // 441 POS_VALID_FOR_CREATURE
 {
 	// const auto position = PopVec();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -3950,7 +4027,7 @@ void GetTimeSinceObjectAttacked() // 442 GET_TIME_SINCE_OBJECT_ATTACKED
 	// const auto town = Pop().uintVal;
 	// const auto player = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -3958,7 +4035,7 @@ void GetTownAndVillagerHealthTotal() // 443 GET_TOWN_AND_VILLAGER_HEALTH_TOTAL
 {
 	// const auto town = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -3967,14 +4044,14 @@ void GameAddForBuilding() // 444 GAME_ADD_FOR_BUILDING
 	// const auto unk1 = Pop().intVal;
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void EnableDisableAlignmentMusic() // 445 ENABLE_DISABLE_ALIGNMENT_MUSIC
 {
 	// const auto enable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetDeadLiving() // 446 GET_DEAD_LIVING
@@ -3982,7 +4059,7 @@ void GetDeadLiving() // 446 GET_DEAD_LIVING
 	// const auto radius = Popf();
 	// const auto position = PopVec();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -3993,7 +4070,7 @@ void AttachSoundTag() // 447 ATTACH_SOUND_TAG
 	// const auto sound = Pop().intVal;
 	// const auto threeD = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void DetachSoundTag() // 448 DETACH_SOUND_TAG
@@ -4002,14 +4079,14 @@ void DetachSoundTag() // 448 DETACH_SOUND_TAG
 	// const auto soundbank = Pop().intVal;
 	// const auto sound = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetSacrificeTotal() // 449 GET_SACRIFICE_TOTAL
 {
 	// const auto worshipSite = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushf(0.0f);
 }
 
@@ -4018,7 +4095,7 @@ void GameSoundPlaying() // 450 GAME_SOUND_PLAYING
 	// const auto soundbank = Pop().intVal;
 	// const auto sound = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -4026,7 +4103,7 @@ void GetTemplePosition() // 451 GET_TEMPLE_POSITION
 {
 	// const auto player = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushv(0.0f); // x
 	Pushv(0.0f); // y
 	Pushv(0.0f); // z
@@ -4038,7 +4115,7 @@ void CreatureAutoscale() // 452 CREATURE_AUTOSCALE
 	// const auto creature = Pop().uintVal;
 	// const auto enable = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetSpellIconInTemple() // 453 GET_SPELL_ICON_IN_TEMPLE
@@ -4046,7 +4123,7 @@ void GetSpellIconInTemple() // 453 GET_SPELL_ICON_IN_TEMPLE
 	// const auto temple = Pop().uintVal;
 	// const auto spell = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -4054,14 +4131,14 @@ void GameClearComputerPlayerActions() // 454 GAME_CLEAR_COMPUTER_PLAYER_ACTIONS
 {
 	// const auto player = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void GetFirstInContainer() // 455 GET_FIRST_IN_CONTAINER
 {
 	// const auto container = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -4070,7 +4147,7 @@ void GetNextInContainer() // 456 GET_NEXT_IN_CONTAINER
 	// const auto after = Pop().uintVal;
 	// const auto container = Pop().uintVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pusho(0);
 }
 
@@ -4080,7 +4157,7 @@ void GetTempleEntrancePosition() // 457 GET_TEMPLE_ENTRANCE_POSITION
 	// const auto radius = Popf();
 	// const auto player = Popf();
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushv(0.0f); // x
 	Pushv(0.0f); // y
 	Pushv(0.0f); // z
@@ -4091,7 +4168,7 @@ void SaySoundEffectPlaying() // 458 SAY_SOUND_EFFECT_PLAYING
 	// const auto sound = Pop().intVal;
 	// const auto alwaysFalse = static_cast<bool>(Pop().intVal);
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
@@ -4099,34 +4176,34 @@ void SetHandDemoKeys() // 459 SET_HAND_DEMO_KEYS
 {
 	// const auto unk0 = Pop().intVal;
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 }
 
 void CanSkipTutorial() // 460 CAN_SKIP_TUTORIAL
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
 void CanSkipCreatureTraining() // 461 CAN_SKIP_CREATURE_TRAINING
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
 void IsKeepingOldCreature() // 462 IS_KEEPING_OLD_CREATURE
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
 void CurrentProfileHasCreature() // 463 CURRENT_PROFILE_HAS_CREATURE
 {
 	// TODO(Daniels118): implement this
-	SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "CHLApi Function {}() not implemented.", __func__);
+	CHLAPI_NOT_IMPLEMENTED();
 	Pushb(false);
 }
 
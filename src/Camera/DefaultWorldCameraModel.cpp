@@ -26,6 +26,7 @@
 #include "ECS/Systems/DynamicsSystemInterface.h"
 #include "Input/GameActionMapInterface.h"
 #include "Locator.h"
+#include "Log.h"
 #include "Windowing/WindowingInterface.h"
 
 using namespace openblack;
@@ -746,7 +747,7 @@ glm::vec3 DefaultWorldCameraModel::GetTargetFocus() const
 
 std::chrono::seconds DefaultWorldCameraModel::GetIdleTime() const
 {
-	SPDLOG_LOGGER_WARN(spdlog::get("game"), "TODO: Idle Time not implemented");
+	OPENBLACK_LOG_RATE_LIMITED(GetLogger(LoggingSubsystem::game), spdlog::level::warn, "TODO: Idle Time not implemented");
 	return {};
 }
 
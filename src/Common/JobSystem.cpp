@@ -0,0 +1,314 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "JobSystem.h"
+
+#include <exception>
+
+#include <spdlog/spdlog.h>
+
+#include "Log.h"
+
+using namespace openblack;
+
+namespace
+{
+struct ThreadInfo
+{
+	const JobSystem* system {nullptr};
+	uint32_t index {0};
+};
+
+thread_local ThreadInfo tThreadInfo;
+} // namespace
+
+uint32_t JobSystem::GetDefaultWorkerCount()
+{
+	const auto hardwareThreads = std::thread::hardware_concurrency();
+	return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+}
+
+JobSystem::JobSystem(uint32_t workerCount)
+    : _mainThread(std::this_thread::get_id())
+{
+	_timelines.resize(workerCount + 1);
+	for (auto& timeline : _timelines)
+	{
+		timeline = std::make_unique<Timeline>();
+	}
+
+	// All of the queues exist before any worker starts stealing from them
+	_workers.resize(workerCount);
+	for (auto& worker : _workers)
+	{
+		worker = std::make_unique<Worker>();
+	}
+	for (uint32_t i = 0; i < workerCount; ++i)
+	{
+		_workers[i]->thread = std::thread(&JobSystem::Work, this, i + 1);
+	}
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		const std::lock_guard lock(_sleepMutex);
+		_stop = true;
+	}
+	_condition.notify_all();
+	for (auto& worker : _workers)
+	{
+		worker->thread.join();
+	}
+}
+
+JobSystem::JobHandle JobSystem::Schedule(const char* name, std::function<void()> function,
+                                         std::span<const JobHandle> dependencies, Affinity affinity)
+{
+	auto job = std::make_shared<Job>(name, std::move(function), affinity, MemoryTracker::GetTag());
+	for (const auto& dependency : dependencies)
+	{
+		if (dependency == nullptr)
+		{
+			continue;
+		}
+		const std::lock_guard lock(dependency->mutex);
+		if (!dependency->done)
+		{
+			job->pendingDependencies.fetch_add(1, std::memory_order_relaxed);
+			dependency->continuations.push_back(job);
+		}
+	}
+
+	// Dependencies which completed while they were added cannot enqueue the job before this
+	if (job->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	{
+		Enqueue(job);
+	}
+	return job;
+}
+
+void JobSystem::Wait(const JobHandle& job)
+{
+	const bool mainThread = std::this_thread::get_id() == _mainThread;
+	const auto thread = GetThreadIndex();
+	while (!IsDone(job))
+	{
+		auto next = mainThread ? TakeMainThreadJob() : nullptr;
+		if (next == nullptr)
+		{
+			next = TakeJob(thread);
+		}
+		if (next != nullptr)
+		{
+			Run(next);
+			continue;
+		}
+
+		std::unique_lock lock(_sleepMutex);
+		_condition.wait(lock, [this, &job, mainThread]() {
+			return IsDone(job) || _queuedJobs.load() > 0 || (mainThread && _queuedMainThreadJobs.load() > 0);
+		});
+	}
+}
+
+bool JobSystem::IsDone(const JobHandle& job)
+{
+	return job == nullptr || job->done.load(std::memory_order_acquire);
+}
+
+void JobSystem::RunMainThreadJobs()
+{
+	// Only the jobs ready now, those they schedule wait for the next frame
+	std::deque<JobHandle> jobs;
+	{
+		const std::lock_guard lock(_mainThreadMutex);
+		jobs.swap(_mainThreadJobs);
+		_queuedMainThreadJobs.fetch_sub(static_cast<uint32_t>(jobs.size()));
+	}
+	for (const auto& job : jobs)
+	{
+		Run(job);
+	}
+}
+
+uint32_t JobSystem::GetThreadIndex() const
+{
+	return tThreadInfo.system == this ? tThreadInfo.index : 0;
+}
+
+void JobSystem::BeginFrame()
+{
+	for (auto& timeline : _timelines)
+	{
+		const std::lock_guard lock(timeline->mutex);
+		timeline->lastFrame.swap(timeline->recording);
+		timeline->recording.clear();
+	}
+}
+
+const std::vector<JobSystem::TimelineEvent>& JobSystem::GetTimeline(uint32_t thread) const
+{
+	return _timelines.at(thread)->lastFrame;
+}
+
+void JobSystem::Enqueue(JobHandle job)
+{
+	// Without workers the main thread runs everything
+	if (job->affinity == Affinity::MainThread || _workers.empty())
+	{
+		{
+			const std::lock_guard lock(_mainThreadMutex);
+			_mainThreadJobs.push_back(std::move(job));
+			_queuedMainThreadJobs.fetch_add(1);
+		}
+		WakeAll();
+		return;
+	}
+
+	// Counted before being pushed so that the count never goes below the jobs a thief can find
+	_queuedJobs.fetch_add(1);
+	const auto thread = GetThreadIndex();
+	const auto index = thread > 0 ? thread - 1 : _nextWorker.fetch_add(1, std::memory_order_relaxed) % _workers.size();
+	{
+		const std::lock_guard lock(_workers[index]->mutex);
+		_workers[index]->jobs.push_back(std::move(job));
+	}
+	WakeAll();
+}
+
+void JobSystem::Run(const JobHandle& job)
+{
+	const auto start = std::chrono::system_clock::now();
+	{
+		const MemoryTracker::Scope memory(job->memoryTag);
+		try
+		{
+			job->function();
+		}
+		catch (const std::exception& e)
+		{
+			if (auto* logger = GetLogger(LoggingSubsystem::game); logger != nullptr)
+			{
+				SPDLOG_LOGGER_ERROR(logger, "Job \"{}\" failed: {}", job->name, e.what());
+			}
+		}
+		// Release what the function holds on to as soon as it is done
+		job->function = nullptr;
+	}
+
+	if (IsRecording())
+	{
+		const auto end = std::chrono::system_clock::now();
+		auto& timeline = *_timelines[GetThreadIndex()];
+		const std::lock_guard lock(timeline.mutex);
+		timeline.recording.push_back({job->name, start, end});
+	}
+
+	std::vector<JobHandle> continuations;
+	{
+		const std::lock_guard lock(job->mutex);
+		job->done.store(true, std::memory_order_release);
+		continuations.swap(job->continuations);
+	}
+	for (auto& continuation : continuations)
+	{
+		if (continuation->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			Enqueue(std::move(continuation));
+		}
+	}
+
+	// Wake the threads waiting for this job
+	WakeAll();
+}
+
+void JobSystem::WakeAll()
+{
+	// Taking the lock orders the change the sleepers check against their wait, so that none of them misses it
+	{
+		const std::lock_guard lock(_sleepMutex);
+	}
+	_condition.notify_all();
+}
+
+JobSystem::JobHandle JobSystem::TakeJob(uint32_t thread)
+{
+	if (_workers.empty() || _queuedJobs.load() == 0)
+	{
+		return nullptr;
+	}
+
+	// Workers take their most recent job, which is the most likely to still be in cache
+	if (thread > 0)
+	{
+		auto& worker = *_workers[thread - 1];
+		const std::lock_guard lock(worker.mutex);
+		if (!worker.jobs.empty())
+		{
+			auto job = std::move(worker.jobs.back());
+			worker.jobs.pop_back();
+			_queuedJobs.fetch_sub(1);
+			return job;
+		}
+	}
+
+	// Steal the oldest job of another worker, which tends to be the one splitting into the most work
+	for (size_t i = 0; i < _workers.size(); ++i)
+	{
+		auto& victim = *_workers[(thread + i) % _workers.size()];
+		const std::lock_guard lock(victim.mutex);
+		if (!victim.jobs.empty())
+		{
+			auto job = std::move(victim.jobs.front());
+			victim.jobs.pop_front();
+			_queuedJobs.fetch_sub(1);
+			return job;
+		}
+	}
+	return nullptr;
+}
+
+JobSystem::JobHandle JobSystem::TakeMainThreadJob()
+{
+	if (_queuedMainThreadJobs.load() == 0)
+	{
+		return nullptr;
+	}
+
+	const std::lock_guard lock(_mainThreadMutex);
+	if (_mainThreadJobs.empty())
+	{
+		return nullptr;
+	}
+	auto job = std::move(_mainThreadJobs.front());
+	_mainThreadJobs.pop_front();
+	_queuedMainThreadJobs.fetch_sub(1);
+	return job;
+}
+
+void JobSystem::Work(uint32_t thread)
+{
+	tThreadInfo = {this, thread};
+	while (true)
+	{
+		if (auto job = TakeJob(thread); job != nullptr)
+		{
+			Run(job);
+			continue;
+		}
+
+		std::unique_lock lock(_sleepMutex);
+		_condition.wait(lock, [this]() { return _stop || _queuedJobs.load() > 0; });
+		if (_stop && _queuedJobs.load() == 0)
+		{
+			return;
+		}
+	}
+}
@@ -0,0 +1,199 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include <entt/entity/entity.hpp>
+
+#include "MemoryTracker.h"
+
+namespace openblack
+{
+
+/**
+  Runs jobs on a fixed pool of worker threads.
+
+  Each worker runs jobs from the back of its own queue and steals from the front of the queues of the others once it runs
+  out. Jobs scheduled by a worker go to its own queue, those scheduled by other threads are spread over the workers.
+
+  A job only starts once the jobs it depends on are done. Jobs with main thread affinity, such as those calling bgfx or
+  OpenAL, are only run by the main thread, either in RunMainThreadJobs or while it waits for a job.
+
+  Waiting for a job runs other jobs instead of blocking, so jobs can schedule jobs and wait for them.
+ */
+class JobSystem
+{
+public:
+	enum class Affinity : uint8_t
+	{
+		Any,
+		MainThread,
+	};
+
+	class Job;
+	using JobHandle = std::shared_ptr<Job>;
+
+	/// A job run by a thread, recorded for the profiler with the same clock as its stages
+	struct TimelineEvent
+	{
+		const char* name;
+		std::chrono::system_clock::time_point start;
+		std::chrono::system_clock::time_point end;
+	};
+
+	/// All but one of the hardware threads, the remaining one being the main thread
+	[[nodiscard]] static uint32_t GetDefaultWorkerCount();
+
+	/// Without workers, every job is run by the main thread as it waits for them
+	explicit JobSystem(uint32_t workerCount = GetDefaultWorkerCount());
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	/// Run function once all of the dependencies are done, name must outlive the job.
+	/// The job allocates under the memory tag of the scope it is scheduled from.
+	JobHandle Schedule(const char* name, std::function<void()> function, std::span<const JobHandle> dependencies = {},
+	                   Affinity affinity = Affinity::Any);
+	/// Run jobs until this one is done, from a worker it must not have main thread affinity
+	void Wait(const JobHandle& job);
+	[[nodiscard]] static bool IsDone(const JobHandle& job);
+	/// Run the jobs with main thread affinity which are ready, to be called by the main thread once per frame
+	void RunMainThreadJobs();
+
+	/// Call function(begin, end) over ranges of at most grainSize splitting [0, count) and wait for all of them
+	template <typename Func>
+	void ParallelFor(const char* name, size_t count, size_t grainSize, Func&& function);
+	/// Call function(entity) for every entity of an entt view, which must not change until it returns
+	template <typename View, typename Func>
+	void ParallelForEach(const char* name, const View& view, size_t grainSize, Func&& function);
+
+	[[nodiscard]] uint32_t GetWorkerCount() const { return static_cast<uint32_t>(_workers.size()); }
+	/// Index of the calling thread in the timelines, 0 for the main thread and any other thread which is not a worker
+	[[nodiscard]] uint32_t GetThreadIndex() const;
+
+	/// Record the jobs run by every thread until disabled
+	void SetRecording(bool recording) { _recording.store(recording, std::memory_order_relaxed); }
+	[[nodiscard]] bool IsRecording() const { return _recording.load(std::memory_order_relaxed); }
+	/// Keep the jobs recorded since the last call for GetTimeline and start recording anew, to be called once per frame
+	void BeginFrame();
+	/// Jobs run by a thread during the last frame, see GetThreadIndex
+	[[nodiscard]] const std::vector<TimelineEvent>& GetTimeline(uint32_t thread) const;
+
+private:
+	struct Timeline
+	{
+		std::mutex mutex;
+		std::vector<TimelineEvent> recording;
+		std::vector<TimelineEvent> lastFrame;
+	};
+
+	struct Worker
+	{
+		std::mutex mutex;
+		std::deque<JobHandle> jobs;
+		std::thread thread;
+	};
+
+	void Enqueue(JobHandle job);
+	void Run(const JobHandle& job);
+	void WakeAll();
+	[[nodiscard]] JobHandle TakeJob(uint32_t thread);
+	[[nodiscard]] JobHandle TakeMainThreadJob();
+	void Work(uint32_t thread);
+
+	const std::thread::id _mainThread;
+	std::vector<std::unique_ptr<Worker>> _workers;
+	/// One for the main thread followed by one per worker
+	std::vector<std::unique_ptr<Timeline>> _timelines;
+	std::atomic<bool> _recording {false};
+	std::atomic<uint32_t> _nextWorker {0};
+
+	std::mutex _mainThreadMutex;
+	std::deque<JobHandle> _mainThreadJobs;
+	std::atomic<uint32_t> _queuedMainThreadJobs {0};
+
+	/// Jobs waiting in the queues of the workers, which sleep while there are none
+	std::atomic<uint32_t> _queuedJobs {0};
+	std::mutex _sleepMutex;
+	std::condition_variable _condition;
+	bool _stop {false};
+};
+
+class JobSystem::Job
+{
+public:
+	Job(const char* name, std::function<void()> function, Affinity affinity, MemoryTag memoryTag)
+	    : name(name)
+	    , function(std::move(function))
+	    , affinity(affinity)
+	    , memoryTag(memoryTag)
+	{
+	}
+
+private:
+	const char* const name;
+	std::function<void()> function;
+	const Affinity affinity;
+	const MemoryTag memoryTag;
+	/// Dependencies which are not done yet, plus one while the job is being scheduled
+	std::atomic<uint32_t> pendingDependencies {1};
+	std::atomic<bool> done {false};
+	/// Guards continuations against the job completing while a dependent job is scheduled
+	std::mutex mutex;
+	std::vector<JobHandle> continuations;
+
+	friend JobSystem;
+};
+
+template <typename Func>
+void JobSystem::ParallelFor(const char* name, size_t count, size_t grainSize, Func&& function)
+{
+	grainSize = std::max<size_t>(grainSize, 1);
+	std::vector<JobHandle> jobs;
+	jobs.reserve((count + grainSize - 1) / grainSize);
+	for (size_t begin = 0; begin < count; begin += grainSize)
+	{
+		const auto end = std::min(begin + grainSize, count);
+		jobs.push_back(Schedule(name, [&function, begin, end]() { function(begin, end); }));
+	}
+	for (const auto& job : jobs)
+	{
+		Wait(job);
+	}
+}
+
+template <typename View, typename Func>
+void JobSystem::ParallelForEach(const char* name, const View& view, size_t grainSize, Func&& function)
+{
+	// Views can only be walked in order, the entities are copied so that they can be split by index
+	const std::vector<entt::entity> entities(view.begin(), view.end());
+	ParallelFor(name, entities.size(), grainSize, [&entities, &function](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+		{
+			function(entities[i]);
+		}
+	});
+}
+
+} // namespace openblack
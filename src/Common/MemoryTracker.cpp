@@ -0,0 +1,236 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "MemoryTracker.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+
+#if defined(OPENBLACK_TRACK_ALLOCATIONS)
+#include <LinearMath/btAlignedAllocator.h>
+#endif
+
+using namespace openblack;
+
+namespace
+{
+struct AtomicCounters
+{
+	std::atomic<uint64_t> allocations;
+	std::atomic<uint64_t> allocatedBytes;
+	std::atomic<uint64_t> frees;
+	std::atomic<uint64_t> freedBytes;
+};
+
+/// Stored right before the memory given out, to find the start of the block and count its free against the right tag
+struct Header
+{
+	uint64_t size;
+	uint32_t offset;
+	MemoryTag tag;
+};
+constexpr size_t k_HeaderSize = 16;
+static_assert(sizeof(Header) <= k_HeaderSize);
+
+// Both are constant initialized, so they are usable by allocations made before main
+std::array<AtomicCounters, static_cast<size_t>(MemoryTag::_count)> gCounters;
+thread_local MemoryTag tTag = MemoryTag::Untagged;
+
+Header* GetHeader(void* pointer)
+{
+	return reinterpret_cast<Header*>(static_cast<std::byte*>(pointer) - k_HeaderSize);
+}
+} // namespace
+
+MemoryTracker::Counters& MemoryTracker::Counters::operator+=(const Counters& rhs)
+{
+	allocations += rhs.allocations;
+	allocatedBytes += rhs.allocatedBytes;
+	frees += rhs.frees;
+	freedBytes += rhs.freedBytes;
+	return *this;
+}
+
+MemoryTracker::Counters& MemoryTracker::Counters::operator-=(const Counters& rhs)
+{
+	allocations -= rhs.allocations;
+	allocatedBytes -= rhs.allocatedBytes;
+	frees -= rhs.frees;
+	freedBytes -= rhs.freedBytes;
+	return *this;
+}
+
+MemoryTracker::Scope::Scope(MemoryTag tag) noexcept
+    : _previous(tTag)
+{
+	tTag = tag;
+}
+
+MemoryTracker::Scope::~Scope() noexcept
+{
+	tTag = _previous;
+}
+
+MemoryTag MemoryTracker::GetTag() noexcept
+{
+	return tTag;
+}
+
+MemoryTracker::Snapshot MemoryTracker::GetSnapshot() noexcept
+{
+	Snapshot snapshot;
+	for (size_t i = 0; i < snapshot.size(); ++i)
+	{
+		snapshot[i].allocations = gCounters[i].allocations.load(std::memory_order_relaxed);
+		snapshot[i].allocatedBytes = gCounters[i].allocatedBytes.load(std::memory_order_relaxed);
+		snapshot[i].frees = gCounters[i].frees.load(std::memory_order_relaxed);
+		snapshot[i].freedBytes = gCounters[i].freedBytes.load(std::memory_order_relaxed);
+	}
+	return snapshot;
+}
+
+MemoryTracker::Snapshot MemoryTracker::GetDifference(const Snapshot& later, const Snapshot& earlier) noexcept
+{
+	auto difference = later;
+	for (size_t i = 0; i < difference.size(); ++i)
+	{
+		difference[i] -= earlier[i];
+	}
+	return difference;
+}
+
+MemoryTracker::Counters MemoryTracker::GetTotal(const Snapshot& snapshot) noexcept
+{
+	Counters total;
+	for (const auto& counters : snapshot)
+	{
+		total += counters;
+	}
+	return total;
+}
+
+void* MemoryTracker::Allocate(size_t size, size_t alignment, MemoryTag tag) noexcept
+{
+	// Room for the header before the first aligned address past it
+	alignment = std::max({alignment, alignof(std::max_align_t), k_HeaderSize});
+	auto* block = static_cast<std::byte*>(std::malloc(size + k_HeaderSize + alignment));
+	if (block == nullptr)
+	{
+		return nullptr;
+	}
+	const auto address = reinterpret_cast<uintptr_t>(block) + k_HeaderSize;
+	const auto aligned = (address + alignment - 1) & ~(alignment - 1);
+	auto* pointer = block + (aligned - reinterpret_cast<uintptr_t>(block));
+
+	auto* header = GetHeader(pointer);
+	header->size = size;
+	header->offset = static_cast<uint32_t>(pointer - block);
+	header->tag = tag;
+
+	auto& counters = gCounters[static_cast<size_t>(tag)];
+	counters.allocations.fetch_add(1, std::memory_order_relaxed);
+	counters.allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+	return pointer;
+}
+
+void* MemoryTracker::Reallocate(void* pointer, size_t size, size_t alignment, MemoryTag tag) noexcept
+{
+	if (pointer == nullptr)
+	{
+		return Allocate(size, alignment, tag);
+	}
+	if (size == 0)
+	{
+		Free(pointer);
+		return nullptr;
+	}
+
+	auto* reallocated = Allocate(size, alignment, tag);
+	if (reallocated != nullptr)
+	{
+		std::memcpy(reallocated, pointer, std::min<size_t>(size, GetHeader(pointer)->size));
+		Free(pointer);
+	}
+	return reallocated;
+}
+
+void MemoryTracker::Free(void* pointer) noexcept
+{
+	if (pointer == nullptr)
+	{
+		return;
+	}
+
+	const auto* header = GetHeader(pointer);
+	auto& counters = gCounters[static_cast<size_t>(header->tag)];
+	counters.frees.fetch_add(1, std::memory_order_relaxed);
+	counters.freedBytes.fetch_add(header->size, std::memory_order_relaxed);
+	std::free(static_cast<std::byte*>(pointer) - header->offset);
+}
+
+#if defined(OPENBLACK_TRACK_ALLOCATIONS)
+
+namespace
+{
+// Installed before main so that no Bullet block is allocated by one allocator and freed by the other.
+// Bullet aligns the blocks itself, so only the size is given.
+[[maybe_unused]] const bool gBulletAllocatorInstalled = []() {
+	btAlignedAllocSetCustom([](size_t size) { return MemoryTracker::Allocate(size, 0, MemoryTag::Physics); },
+	                        [](void* pointer) { MemoryTracker::Free(pointer); });
+	return true;
+}();
+} // namespace
+
+// The nothrow and array forms which are not replaced call these ones
+
+void* operator new(size_t size)
+{
+	auto* pointer = MemoryTracker::Allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__, MemoryTracker::GetTag());
+	if (pointer == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+	return pointer;
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	auto* pointer = MemoryTracker::Allocate(size, static_cast<size_t>(alignment), MemoryTracker::GetTag());
+	if (pointer == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+	return pointer;
+}
+
+void operator delete(void* pointer) noexcept
+{
+	MemoryTracker::Free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t /*alignment*/) noexcept
+{
+	MemoryTracker::Free(pointer);
+}
+
+void operator delete(void* pointer, size_t /*size*/) noexcept
+{
+	MemoryTracker::Free(pointer);
+}
+
+void operator delete(void* pointer, size_t /*size*/, std::align_val_t /*alignment*/) noexcept
+{
+	MemoryTracker::Free(pointer);
+}
+
+#endif
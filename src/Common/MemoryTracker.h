@@ -0,0 +1,109 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+#include <string_view>
+
+namespace openblack
+{
+
+enum class MemoryTag : uint8_t
+{
+	Untagged,
+	Entities,
+	Resources,
+	Terrain,
+	Scripting,
+	Physics,
+	Graphics,
+	Audio,
+
+	_count
+};
+
+constexpr static std::array<std::string_view, static_cast<size_t>(MemoryTag::_count)> k_MemoryTagNames {
+    "Untagged",  //
+    "Entities",  //
+    "Resources", //
+    "Terrain",   //
+    "Scripting", //
+    "Physics",   //
+    "Graphics",  //
+    "Audio",     //
+};
+
+/**
+  Counts the allocations of each subsystem.
+
+  Built with OPENBLACK_TRACK_ALLOCATIONS, operator new and delete as well as the allocators given to Bullet and bgfx
+  count every allocation against the tag of the innermost Scope of the thread which made it. Frees count against the tag
+  of the allocation, wherever they happen. Without it, the scopes are kept but nothing is counted.
+ */
+class MemoryTracker
+{
+public:
+#if defined(OPENBLACK_TRACK_ALLOCATIONS)
+	static constexpr bool k_Enabled = true;
+#else
+	static constexpr bool k_Enabled = false;
+#endif
+
+	struct Counters
+	{
+		uint64_t allocations {0};
+		uint64_t allocatedBytes {0};
+		uint64_t frees {0};
+		uint64_t freedBytes {0};
+
+		/// Bytes allocated and not freed, which can be negative between two snapshots
+		[[nodiscard]] int64_t GetLiveBytes() const
+		{
+			return static_cast<int64_t>(allocatedBytes) - static_cast<int64_t>(freedBytes);
+		}
+		Counters& operator+=(const Counters& rhs);
+		Counters& operator-=(const Counters& rhs);
+	};
+
+	/// Counters of every tag, indexed by MemoryTag
+	using Snapshot = std::array<Counters, static_cast<size_t>(MemoryTag::_count)>;
+
+	/// Tags the allocations of the calling thread until it is destroyed
+	class Scope
+	{
+	public:
+		explicit Scope(MemoryTag tag) noexcept;
+		~Scope() noexcept;
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	private:
+		const MemoryTag _previous;
+	};
+
+	[[nodiscard]] static MemoryTag GetTag() noexcept;
+	/// Counters since the start of the program
+	[[nodiscard]] static Snapshot GetSnapshot() noexcept;
+	/// Counters between two snapshots
+	[[nodiscard]] static Snapshot GetDifference(const Snapshot& later, const Snapshot& earlier) noexcept;
+	[[nodiscard]] static Counters GetTotal(const Snapshot& snapshot) noexcept;
+
+	/// Counted allocations for allocators other than operator new, such as those of Bullet and bgfx.
+	/// Memory from Allocate must be returned to Free or Reallocate, never to free or delete.
+	[[nodiscard]] static void* Allocate(size_t size, size_t alignment, MemoryTag tag) noexcept;
+	[[nodiscard]] static void* Reallocate(void* pointer, size_t size, size_t alignment, MemoryTag tag) noexcept;
+	static void Free(void* pointer) noexcept;
+};
+
+} // namespace openblack
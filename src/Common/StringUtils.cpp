@@ -9,6 +9,9 @@
 
 #include "StringUtils.h"
 
+#include <array>
+#include <cerrno>
+#include <cstdlib>
 #include <string_view>
 #include <vector>
 
@@ -76,3 +79,25 @@ std::string openblack::string_utils::ExtractQuote(std::string& string)
 	size_t const second(string.find('\"', first + 1));
 	return string.substr(first + 1, second - first - 1);
 }
+
+std::optional<float> openblack::string_utils::ParseFloat(std::string_view string)
+{
+	// Floating point std::from_chars is missing from some standard libraries, so strtof is given a NUL-terminated copy.
+	// Anything strtof would read beyond plain decimals (spaces, hex, inf, nan) is rejected like from_chars would.
+	std::array<char, 64> buffer;
+	if (string.empty() || string.size() >= buffer.size() ||
+	    string.find_first_not_of("0123456789+-.eE") != std::string_view::npos)
+	{
+		return std::nullopt;
+	}
+	*std::copy(string.begin(), string.end(), buffer.begin()) = '\0';
+
+	char* end = nullptr;
+	errno = 0;
+	const float value = std::strtof(buffer.data(), &end);
+	if (errno == ERANGE || end != buffer.data() + string.size())
+	{
+		return std::nullopt;
+	}
+	return value;
+}
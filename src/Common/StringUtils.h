@@ -10,7 +10,9 @@
 #pragma once
 
 #include <algorithm>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace openblack::string_utils
@@ -31,4 +33,7 @@ namespace openblack::string_utils
 /// Extract a substring of the characters in between the first two quote of a string
 [[nodiscard]] std::string ExtractQuote(std::string& string);
 
+/// Parse the whole of a decimal string as a float, or nothing if any of it is not part of the number
+[[nodiscard]] std::optional<float> ParseFloat(std::string_view string);
+
 } // namespace openblack::string_utils
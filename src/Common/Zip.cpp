@@ -45,7 +45,7 @@ std::string GetZlibError(int statusCode)
 /*
  * More information found here https://www.zlib.net/zlib_how.html
  */
-std::vector<uint8_t> openblack::zip::Inflate(const std::vector<uint8_t>& deflatedData, size_t inflatedSize)
+std::vector<uint8_t> openblack::zip::Inflate(std::span<const uint8_t> deflatedData, size_t inflatedSize)
 {
 	auto deflatedSize = deflatedData.size();
 	auto inflatedData = std::vector<uint8_t>(inflatedSize);
@@ -87,3 +87,23 @@ std::vector<uint8_t> openblack::zip::Inflate(const std::vector<uint8_t>& deflate
 	inflateEnd(&strm);
 	return inflatedData;
 }
+
+std::vector<uint8_t> openblack::zip::Deflate(std::span<const uint8_t> inflatedData)
+{
+	if (inflatedData.size() > k_MaxBufferSize)
+	{
+		throw std::runtime_error("Data is too large to deflate");
+	}
+
+	auto deflatedSize = compressBound(static_cast<uLong>(inflatedData.size()));
+	auto deflatedData = std::vector<uint8_t>(deflatedSize);
+	const auto returnStatus = compress2(deflatedData.data(), &deflatedSize, inflatedData.data(),
+	                                    static_cast<uLong>(inflatedData.size()), Z_BEST_COMPRESSION);
+	if (returnStatus != Z_OK)
+	{
+		throw std::runtime_error(fmt::format("Failed to deflate: {}", GetZlibError(returnStatus)));
+	}
+
+	deflatedData.resize(deflatedSize);
+	return deflatedData;
+}
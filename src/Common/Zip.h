@@ -12,11 +12,13 @@
 #include <cstddef>
 #include <cstdint>
 
+#include <span>
 #include <vector>
 
 namespace openblack::zip
 {
 
-[[nodiscard]] std::vector<uint8_t> Inflate(const std::vector<uint8_t>& deflatedData, size_t inflatedSize);
+[[nodiscard]] std::vector<uint8_t> Inflate(std::span<const uint8_t> deflatedData, size_t inflatedSize);
+[[nodiscard]] std::vector<uint8_t> Deflate(std::span<const uint8_t> inflatedData);
 
 } // namespace openblack::zip
@@ -508,6 +508,19 @@ bool Gui::ShowMenu() noexcept
 				}
 				ImGui::EndMenu();
 			}
+			ImGui::Separator();
+			if (ImGui::MenuItem("Restart Island"))
+			{
+				game.RestartLevel();
+			}
+			if (ImGui::MenuItem("Quick Save"))
+			{
+				game.QuickSave();
+			}
+			if (ImGui::MenuItem("Quick Load", nullptr, false, game.HasQuickSave()))
+			{
+				game.QuickLoad();
+			}
 			ImGui::EndMenu();
 		}
 
@@ -563,6 +576,8 @@ bool Gui::ShowMenu() noexcept
 				ImGui::Checkbox("Bounding Boxes", &config.drawBoundingBoxes);
 				ImGui::Checkbox("Footpaths", &config.drawFootpaths);
 				ImGui::Checkbox("Streams", &config.drawStreams);
+				ImGui::Checkbox("Wall Hug", &config.drawWallHug);
+				ImGui::Checkbox("Physics", &config.drawPhysics);
 
 				ImGui::EndMenu();
 			}
@@ -866,7 +881,7 @@ void Gui::ShowVillagerNames() noexcept
 		    const std::string stateHelpText = "TODO: STATE HELP TEXT";
 		    std::string details =
 		        fmt::format("{}\nA:{} L:{}%, H:{}%", stateHelpText, villager.age, villager.health, villager.hunger);
-		    const auto& actionSystem = Locator::livingActionSystem::value();
+		    auto& actionSystem = Locator::livingActionSystem::value();
 		    if (config.debugVillagerStates)
 		    {
 			    details +=
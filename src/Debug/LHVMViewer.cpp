@@ -9,6 +9,10 @@
 
 #include "LHVMViewer.h"
 
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
 #include <imgui.h>
 #include <imgui_memory_editor.h>
 #include <imgui_user.h>
@@ -89,6 +93,13 @@ void LHVMViewer::Draw() noexcept
 			ImGui::EndTabItem();
 		}
 
+		if (ImGui::BeginTabItem("Profiler"))
+		{
+			DrawProfilerTab(lhvm);
+
+			ImGui::EndTabItem();
+		}
+
 		ImGui::EndTabBar();
 	}
 }
@@ -419,6 +430,153 @@ void LHVMViewer::DrawTasksTab(const lhvm::LHVM& lhvm) noexcept
 	}
 }
 
+void LHVMViewer::DrawProfilerTab(lhvm::LHVM& lhvm) noexcept
+{
+	using Milliseconds = std::chrono::duration<float, std::milli>;
+
+	bool enabled = lhvm.GetProfiler() != nullptr;
+	if (ImGui::Checkbox("Enabled", &enabled))
+	{
+		lhvm.SetProfilerEnabled(enabled);
+	}
+	auto* profiler = lhvm.GetProfiler();
+	if (profiler == nullptr)
+	{
+		ImGui::TextWrapped("Measures the time spent running each script, task and native function.");
+		return;
+	}
+
+	ImGui::SameLine();
+	if (ImGui::Button("Reset"))
+	{
+		profiler->Reset();
+	}
+	ImGui::SameLine();
+	static constexpr const char* k_ExportPath = "lhvm_profile.folded";
+	if (ImGui::Button("Export collapsed stacks"))
+	{
+		std::ofstream stream(k_ExportPath);
+		profiler->WriteCollapsedStacks(stream, lhvm.GetScripts(), lhvm.GetFunctions());
+	}
+	if (ImGui::IsItemHovered())
+	{
+		ImGui::SetTooltip("Write to %s, to be read by flamegraph tools", k_ExportPath);
+	}
+	const auto turns = std::max(profiler->GetTurns(), 1u);
+	ImGui::Text("Turns: %u", profiler->GetTurns());
+
+	// Most expensive first
+	const auto sorted = [](const std::map<uint32_t, lhvm::LHVMProfiler::Entry>& entries) {
+		std::vector<std::pair<uint32_t, lhvm::LHVMProfiler::Entry>> result(entries.begin(), entries.end());
+		std::ranges::sort(result, [](const auto& a, const auto& b) { return a.second.time > b.second.time; });
+		return result;
+	};
+	const auto& scripts = lhvm.GetScripts();
+	const auto scriptName = [&scripts](uint32_t scriptId) {
+		return scriptId > 0 && scriptId <= scripts.size() ? scripts.at(scriptId - 1).name.c_str() : "?";
+	};
+	constexpr auto k_TableFlags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY;
+	const auto tableSize = ImVec2(0.0f, ImGui::GetTextLineHeightWithSpacing() * 12);
+
+	if (ImGui::CollapsingHeader("Scripts", ImGuiTreeNodeFlags_DefaultOpen) &&
+	    ImGui::BeginTable("##scripts", 6, k_TableFlags, tableSize))
+	{
+		ImGui::TableSetupScrollFreeze(0, 1);
+		ImGui::TableSetupColumn("Script");
+		ImGui::TableSetupColumn("Runs");
+		ImGui::TableSetupColumn("Instructions");
+		ImGui::TableSetupColumn("Total ms");
+		ImGui::TableSetupColumn("Self ms");
+		ImGui::TableSetupColumn("ms / turn");
+		ImGui::TableHeadersRow();
+		for (const auto& [scriptId, entry] : sorted(profiler->GetScripts()))
+		{
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			if (ImGui::TextButtonColored(Disassembly_ColorFuncName, scriptName(scriptId)))
+			{
+				SelectScript(scriptId);
+			}
+			ImGui::TableNextColumn();
+			ImGui::Text("%u", entry.calls);
+			ImGui::TableNextColumn();
+			ImGui::Text("%llu", static_cast<unsigned long long>(entry.instructions));
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", Milliseconds(entry.time).count());
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", Milliseconds(entry.SelfTime()).count());
+			ImGui::TableNextColumn();
+			ImGui::Text("%.4f", Milliseconds(entry.time).count() / static_cast<float>(turns));
+		}
+		ImGui::EndTable();
+	}
+
+	if (ImGui::CollapsingHeader("Native functions", ImGuiTreeNodeFlags_DefaultOpen) &&
+	    ImGui::BeginTable("##natives", 4, k_TableFlags, tableSize))
+	{
+		const auto* functions = lhvm.GetFunctions();
+		ImGui::TableSetupScrollFreeze(0, 1);
+		ImGui::TableSetupColumn("Function");
+		ImGui::TableSetupColumn("Calls");
+		ImGui::TableSetupColumn("Total ms");
+		ImGui::TableSetupColumn("us / call");
+		ImGui::TableHeadersRow();
+		for (const auto& [function, entry] : sorted(profiler->GetNativeFunctions()))
+		{
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(functions != nullptr && function < functions->size() ? functions->at(function).name.c_str()
+			                                                                             : "?");
+			ImGui::TableNextColumn();
+			ImGui::Text("%u", entry.calls);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", Milliseconds(entry.time).count());
+			ImGui::TableNextColumn();
+			ImGui::Text("%.2f", Milliseconds(entry.time).count() * 1000.0f / static_cast<float>(std::max(entry.calls, 1u)));
+		}
+		ImGui::EndTable();
+	}
+
+	if (ImGui::CollapsingHeader("Tasks") && ImGui::BeginTable("##tasks", 5, k_TableFlags, tableSize))
+	{
+		const auto& tasks = lhvm.GetTasks();
+		ImGui::TableSetupScrollFreeze(0, 1);
+		ImGui::TableSetupColumn("Task");
+		ImGui::TableSetupColumn("Script");
+		ImGui::TableSetupColumn("Runs");
+		ImGui::TableSetupColumn("Instructions");
+		ImGui::TableSetupColumn("Total ms");
+		ImGui::TableHeadersRow();
+		for (const auto& [taskId, entry] : sorted(profiler->GetTasks()))
+		{
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			// Tasks which have stopped can't be selected anymore
+			const auto task = tasks.find(taskId);
+			if (task != tasks.end())
+			{
+				if (ImGui::TextButtonColored(Disassembly_ColorFuncName, std::to_string(taskId).c_str()))
+				{
+					SelectTask(taskId);
+				}
+			}
+			else
+			{
+				ImGui::Text("%u", taskId);
+			}
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(task != tasks.end() ? task->second.name.c_str() : "stopped");
+			ImGui::TableNextColumn();
+			ImGui::Text("%u", entry.calls);
+			ImGui::TableNextColumn();
+			ImGui::Text("%llu", static_cast<unsigned long long>(entry.instructions));
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", Milliseconds(entry.time).count());
+		}
+		ImGui::EndTable();
+	}
+}
+
 void LHVMViewer::DrawStack(const openblack::lhvm::VMStack& stack) noexcept
 {
 	ImGui::BeginChild("##stack");
@@ -39,6 +39,8 @@ class LHVMViewer final: public Window
 	void DrawExceptionHandlers(const std::vector<uint32_t>& exceptionHandlerIps) noexcept;
 	void SelectTask(uint32_t idx) noexcept;
 
+	void DrawProfilerTab(lhvm::LHVM& lhvm) noexcept;
+
 	uint32_t _selectedScriptID {1};
 	bool _openScriptTab {false};
 	bool _scrollToSelected {false};
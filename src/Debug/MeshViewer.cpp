@@ -193,8 +193,17 @@ void MeshViewer::Draw() noexcept
 		ImGui::TreePop();
 	}
 
-	auto const& graphicsMesh = submesh->GetMesh();
-	ImGui::Text("Vertices %u, Indices %u", graphicsMesh.GetVertexBuffer().GetCount(), graphicsMesh.GetIndexBuffer().GetCount());
+	ImGui::Text("Vertices %u, Indices %u", submesh->GetVertexCount(), submesh->GetIndexCount());
+	for (const auto format : {L3DVertexFormat::Full, L3DVertexFormat::Compact})
+	{
+		if (submesh->HasVertexFormat(format))
+		{
+			const auto& allocation = submesh->GetAllocation(format);
+			ImGui::Text("%s pool page %u, vertex offset %u, index offset %u",
+			            format == L3DVertexFormat::Full ? "Full" : "Compact", allocation.page, allocation.vertexOffset,
+			            allocation.indexOffset);
+		}
+	}
 
 	if (_selectedSubMesh >= 0 && ImGui::TreeNodeEx("Spawn"))
 	{
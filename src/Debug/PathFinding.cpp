@@ -24,7 +24,9 @@
 #include "ECS/Components/WallHug.h"
 #include "ECS/Map.h"
 #include "ECS/Registry.h"
+#include "ECS/RoutePlanner.h"
 #include "ECS/Systems/HandSystemInterface.h"
+#include "ECS/Systems/PathfindingSystemInterface.h"
 #include "Locator.h"
 #include "Resources/ResourcesInterface.h"
 
@@ -126,6 +128,23 @@ void PathFinding::Draw() noexcept
 				ImGui::EndTabItem();
 			}
 
+			if (ImGui::BeginTabItem("Move On Route"))
+			{
+				ImGui::DragFloat3("Destination", glm::value_ptr(_destination));
+
+				if (ImGui::Button("Execute"))
+				{
+					Locator::pathfindingSystem::value().MoveTo(*_selectedVillager, glm::xz(_destination));
+				}
+
+				const auto stats = Locator::pathfindingSystem::value().GetRoutePlanner().GetStats();
+				ImGui::Text("Graph: %u nodes, %u edges, %u obstacles", stats.nodes, stats.edges, stats.obstacles);
+				ImGui::Text("Cached routes: %u, hits: %llu, misses: %llu", stats.cachedRoutes,
+				            static_cast<unsigned long long>(stats.hits), static_cast<unsigned long long>(stats.misses));
+
+				ImGui::EndTabItem();
+			}
+
 			if (ImGui::BeginTabItem("Move On Footpath"))
 			{
 				ImGui::DragFloat3("Destination", glm::value_ptr(_destination));
@@ -11,15 +11,23 @@
 
 #include <cinttypes>
 
+#include <string>
+#include <utility>
+
 #include <bgfx/bgfx.h>
 #include <imgui_widget_flamegraph.h>
 
+#include "3D/L3DSubMesh.h"
+#include "Common/JobSystem.h"
+#include "Common/MemoryTracker.h"
 #include "ECS/Components/Transform.h"
 #include "ECS/Components/Tree.h"
 #include "ECS/Registry.h"
 #include "EngineConfig.h"
+#include "Graphics/MeshPool.h"
 #include "Graphics/RendererInterface.h"
 #include "Locator.h"
+#include "Resources/ResourceUsage.h"
 
 #include "../Profiler.h"
 
@@ -34,12 +42,14 @@ void Profiler::Open() noexcept
 {
 	Window::Open();
 	Locator::rendererInterface::value().SetProfile(true);
+	Locator::jobs::value().SetRecording(true);
 }
 
 void Profiler::Close() noexcept
 {
 	Window::Close();
 	Locator::rendererInterface::value().SetProfile(false);
+	Locator::jobs::value().SetRecording(false);
 }
 
 void Profiler::Draw() noexcept
@@ -77,6 +87,10 @@ void Profiler::Draw() noexcept
 	ImGui::Checkbox("TestModel", &config.drawTestModel);
 	ImGui::NextColumn();
 	ImGui::Checkbox("Debug Cross", &config.drawDebugCross);
+	ImGui::NextColumn();
+	ImGui::Checkbox("LOD", &config.useLevelsOfDetail);
+	ImGui::NextColumn();
+	ImGui::Checkbox("Compact Meshes", &config.useCompactMeshVertices);
 	ImGui::Columns(1);
 
 	auto width = ImGui::GetColumnWidth() - ImGui::CalcTextSize("Frame").x;
@@ -93,6 +107,15 @@ void Profiler::Draw() noexcept
 	ImGui::Text("Num Buffers Index %u, Vertex %u", stats->numIndexBuffers, stats->numVertexBuffers);
 	ImGui::Text("Num Dynamic Buffers Index %u, Vertex %u", stats->numDynamicIndexBuffers, stats->numDynamicVertexBuffers);
 	ImGui::Text("Num Transient Buffers Index %u, Vertex %u", stats->transientIbUsed, stats->transientVbUsed);
+	for (const auto [format, name] : {std::pair {L3DVertexFormat::Full, "L3D Mesh Pool"},
+	                                  std::pair {L3DVertexFormat::Compact, "L3D Compact Mesh Pool"}})
+	{
+		const auto& pool = Locator::rendererInterface::value().GetL3DMeshPool(format);
+		const auto poolStats = pool.GetStats();
+		ImGui::Text("%s Pages %u, Meshes %u", name, poolStats.pageCount, poolStats.allocationCount);
+		ImGui::Text("%s Vertices %u/%u (%u KiB), Indices %u/%u", name, poolStats.vertexCount, poolStats.vertexCapacity,
+		            poolStats.vertexCount * pool.GetStrideBytes() / 1024, poolStats.indexCount, poolStats.indexCapacity);
+	}
 	ImGui::NextColumn();
 	ImGui::Text("Num Vertex Layouts %u", stats->numVertexLayouts);
 	ImGui::Text("Num Textures %u, FrameBuffers %u", stats->numTextures, stats->numFrameBuffers);
@@ -133,6 +156,41 @@ void Profiler::Draw() noexcept
 	    },
 	    &entry, static_cast<uint8_t>(openblack::Profiler::Stage::_count), 0, "Main Thread", 0, FLT_MAX, ImVec2(width, 0));
 
+	// Jobs run by each thread, on the same scale as the main thread's frame
+	using Timeline = std::pair<const openblack::Profiler::Entry*, const std::vector<openblack::JobSystem::TimelineEvent>*>;
+	const auto getJob = [](float* startTimestamp, float* endTimestamp, ImU8* level, const char** caption, const void* data,
+	                       int idx) -> void {
+		const auto& [entry, events] = *reinterpret_cast<const Timeline*>(data);
+		const auto& event = events->at(idx);
+		if (startTimestamp != nullptr)
+		{
+			const std::chrono::duration<float, std::milli> fltStart = event.start - entry->frameStart;
+			*startTimestamp = fltStart.count();
+		}
+		if (endTimestamp != nullptr)
+		{
+			const std::chrono::duration<float, std::milli> fltEnd = event.end - entry->frameStart;
+			*endTimestamp = fltEnd.count();
+		}
+		if (level != nullptr)
+		{
+			*level = 0;
+		}
+		if (caption != nullptr)
+		{
+			*caption = event.name;
+		}
+	};
+	const auto& jobs = Locator::jobs::value();
+	const std::chrono::duration<float, std::milli> frameDuration = entry.frameEnd - entry.frameStart;
+	for (uint32_t thread = 0; thread <= jobs.GetWorkerCount(); ++thread)
+	{
+		const Timeline timeline {&entry, &jobs.GetTimeline(thread)};
+		const auto label = thread == 0 ? std::string("Main Jobs") : "Worker " + std::to_string(thread);
+		ImGuiWidgetFlameGraph::PlotFlame(label.c_str(), getJob, &timeline, static_cast<int>(timeline.second->size()), 0,
+		                                 nullptr, 0, frameDuration.count(), ImVec2(width, 0));
+	}
+
 	ImGuiWidgetFlameGraph::PlotFlame(
 	    "GPU",
 	    [](float* startTimestamp, float* endTimestamp, ImU8* level, const char** caption, const void* data, int idx) -> void {
@@ -199,6 +257,63 @@ void Profiler::Draw() noexcept
 		ImGui::Text("    Unaccounted: %0.3f", 1000.0f * frameDuration / static_cast<double>(stats->gpuTimerFreq));
 	}
 	ImGui::Columns(1);
+
+	constexpr auto k_TableFlags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg;
+	constexpr auto k_KiB = 1024.0f;
+	if (ImGui::CollapsingHeader("Memory"))
+	{
+		if constexpr (!MemoryTracker::k_Enabled)
+		{
+			ImGui::TextUnformatted("Allocations are only counted in builds with OPENBLACK_TRACK_ALLOCATIONS");
+		}
+		else if (ImGui::BeginTable("##memory", 5, k_TableFlags))
+		{
+			const auto live = MemoryTracker::GetSnapshot();
+			ImGui::TableSetupColumn("Subsystem");
+			ImGui::TableSetupColumn("Live KiB");
+			ImGui::TableSetupColumn("Allocations");
+			ImGui::TableSetupColumn("Frame Allocations");
+			ImGui::TableSetupColumn("Frame KiB");
+			ImGui::TableHeadersRow();
+			for (size_t i = 0; i < openblack::k_MemoryTagNames.size(); ++i)
+			{
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(openblack::k_MemoryTagNames.at(i).data());
+				ImGui::TableNextColumn();
+				ImGui::Text("%.1f", static_cast<float>(live.at(i).GetLiveBytes()) / k_KiB);
+				ImGui::TableNextColumn();
+				ImGui::Text("%" PRIu64, live.at(i).allocations);
+				ImGui::TableNextColumn();
+				ImGui::Text("%" PRIu64, entry.memory.at(i).allocations);
+				ImGui::TableNextColumn();
+				ImGui::Text("%.1f", static_cast<float>(entry.memory.at(i).allocatedBytes) / k_KiB);
+			}
+			ImGui::EndTable();
+		}
+
+		if (ImGui::BeginTable("##caches", 4, k_TableFlags))
+		{
+			ImGui::TableSetupColumn("Resources");
+			ImGui::TableSetupColumn("Count");
+			ImGui::TableSetupColumn("CPU KiB");
+			ImGui::TableSetupColumn("GPU KiB");
+			ImGui::TableHeadersRow();
+			for (const auto& usage : resources::GetCacheUsage(Locator::resources::value()))
+			{
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(usage.name.data());
+				ImGui::TableNextColumn();
+				ImGui::Text("%zu", usage.count);
+				ImGui::TableNextColumn();
+				ImGui::Text("%.1f", static_cast<float>(usage.cpuBytes) / k_KiB);
+				ImGui::TableNextColumn();
+				ImGui::Text("%.1f", static_cast<float>(usage.gpuBytes) / k_KiB);
+			}
+			ImGui::EndTable();
+		}
+	}
 }
 
 void Profiler::Update() noexcept {}
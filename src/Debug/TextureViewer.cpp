@@ -10,7 +10,10 @@
 #include "TextureViewer.h"
 
 #include "Debug/ImGuiUtils.h"
+#include "EngineConfig.h"
+#include "Graphics/MipChain.h"
 #include "Graphics/Texture2D.h"
+#include "Graphics/TextureResidency.h"
 #include "Locator.h"
 #include "Resources/ResourcesInterface.h"
 
@@ -24,8 +27,22 @@ TextureViewer::TextureViewer() noexcept
 
 void TextureViewer::Draw() noexcept
 {
+	constexpr float k_MiB = 1024.0f * 1024.0f;
 	float fontSize = ImGui::GetFontSize();
-	const auto& textures = Locator::resources::value().GetTextures();
+	auto& resources = Locator::resources::value();
+	const auto& textures = resources.GetTextures();
+	auto& config = Locator::config::value();
+
+	const auto& stats = resources.GetTextureResidency().GetStats();
+	ImGui::Text("GPU memory: %.1f / %.1f MiB, %.1f MiB with all mips", static_cast<float>(stats.residentSize) / k_MiB,
+	            static_cast<float>(config.textureMemoryBudget) / k_MiB, static_cast<float>(stats.fullSize) / k_MiB);
+	ImGui::Text("%u of %u textures reduced, last frame: %u mips dropped, %u restored", stats.reducedCount,
+	            stats.textureCount, stats.droppedMips, stats.restoredMips);
+	auto budget = static_cast<int>(config.textureMemoryBudget / (1024 * 1024));
+	if (ImGui::SliderInt("Budget (MiB)", &budget, 1, 4096))
+	{
+		config.textureMemoryBudget = static_cast<uint64_t>(budget) * 1024 * 1024;
+	}
 
 	_filter.Draw();
 
@@ -72,6 +89,19 @@ void TextureViewer::Draw() noexcept
 			formatStr = "RGB8";
 		}
 		ImGui::Text("width: %u, height: %u, format: %s", texture->GetWidth(), texture->GetHeight(), formatStr.c_str());
+		if (const auto* mipChain = texture->GetMipChain(); mipChain != nullptr)
+		{
+			ImGui::Text("mips: %u of %u resident, full size: %ux%u, %.1f of %.1f KiB, last used frame: %u",
+			            static_cast<uint32_t>(texture->GetMipCount()), static_cast<uint32_t>(mipChain->GetLevelCount()),
+			            static_cast<uint32_t>(mipChain->GetWidth()), static_cast<uint32_t>(mipChain->GetHeight()),
+			            static_cast<float>(texture->GetSize()) / 1024.0f, static_cast<float>(mipChain->GetSize()) / 1024.0f,
+			            texture->GetLastUsedFrame());
+		}
+		else
+		{
+			ImGui::Text("mips: %u, %.1f KiB", static_cast<uint32_t>(texture->GetMipCount()),
+			            static_cast<float>(texture->GetSize()) / 1024.0f);
+		}
 		ImGui::Image(texture->GetNativeHandle(), ImVec2(512, 512));
 	}
 
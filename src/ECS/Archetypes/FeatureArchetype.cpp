@@ -42,7 +42,18 @@ entt::entity FeatureArchetype::Create(const glm::vec3& position, FeatureInfo typ
 	const auto resourceId = resources::HashIdentifier(info.meshId);
 	registry.Assign<Mesh>(entity, resourceId, static_cast<int8_t>(0), static_cast<int8_t>(1));
 
-	auto l3dMesh = Locator::resources::value().GetMeshes().Handle(resourceId);
+	CreateRigidBody(entity);
+
+	return entity;
+}
+
+void FeatureArchetype::CreateRigidBody(entt::entity entity)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	const auto& transform = registry.Get<Transform>(entity);
+	const auto& mesh = registry.Get<Mesh>(entity);
+
+	auto l3dMesh = Locator::resources::value().GetMeshes().Handle(mesh.id);
 	if (l3dMesh->HasPhysicsMesh())
 	{
 		auto& shape = l3dMesh->GetPhysicsMesh();
@@ -57,6 +68,4 @@ entt::entity FeatureArchetype::Create(const glm::vec3& position, FeatureInfo typ
 
 		registry.Assign<RigidBody>(entity, rbInfo, startTransform);
 	}
-
-	return entity;
 }
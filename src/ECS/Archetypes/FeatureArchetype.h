@@ -20,6 +20,8 @@ class FeatureArchetype
 {
 public:
 	static entt::entity Create(const glm::vec3& position, FeatureInfo type, float yAngleRadians, float scale);
+	/// Rigid bodies are not part of registry snapshots, they are rebuilt from the feature's mesh after loading one
+	static void CreateRigidBody(entt::entity entity);
 	FeatureArchetype() = delete;
 };
 } // namespace openblack::ecs::archetypes
@@ -9,6 +9,8 @@
 
 #include "TownArchetype.h"
 
+#include <algorithm>
+
 #include "ECS/Components/Town.h"
 #include "ECS/Components/Transform.h"
 #include "ECS/Registry.h"
@@ -18,18 +20,22 @@ using namespace openblack;
 using namespace openblack::ecs::archetypes;
 using namespace openblack::ecs::components;
 
-entt::entity TownArchetype::Create(int id, const glm::vec3& position, [[maybe_unused]] PlayerNames playerOwner, Tribe tribe)
+entt::entity TownArchetype::Create(int id, const glm::vec3& position, PlayerNames playerOwner, Tribe tribe)
 {
 	auto& registry = Locator::entitiesRegistry::value();
 	const auto entity = registry.Create();
 
 	// const auto& info = Game::Instance()->GetInfoConstants().town;
 
-	registry.Assign<Town>(entity, static_cast<uint32_t>(id));
+	registry.Assign<Town>(entity, static_cast<uint32_t>(id), playerOwner);
 	registry.Assign<Tribe>(entity, tribe);
 	registry.Assign<Transform>(entity, position, glm::mat3(1.0f), glm::vec3(1.0f));
 	auto& registryContext = registry.Context();
 	registryContext.towns.insert({id, entity});
+	auto& locations = registryContext.townLocations;
+	locations.insert(std::upper_bound(locations.begin(), locations.end(), position.x,
+	                                  [](float x, const auto& location) { return x < location.position.x; }),
+	                 {position, entity});
 
 	return entity;
 }
@@ -16,6 +16,7 @@ namespace openblack::ecs::components
 
 struct Fixed
 {
+	Fixed() = default;
 	Fixed(const glm::vec2& boundingCenter, float boundingRadius)
 	    : boundingCenter(boundingCenter)
 	    , boundingRadius(boundingRadius)
@@ -32,6 +32,7 @@ struct LivingAction
 	    "Previous",
 	};
 
+	LivingAction() = default;
 	LivingAction(VillagerStates topState, uint16_t turnsUntilStateChange)
 	    : states {static_cast<uint8_t>(topState), static_cast<uint8_t>(VillagerStates::InvalidState),
 	              static_cast<uint8_t>(VillagerStates::InvalidState)}
@@ -19,6 +19,8 @@ struct Mesh
 	entt::id_type id;
 	int8_t submeshId;
 	int8_t bbSubmeshId;
+	/// Level of detail last selected by the rendering system from the mesh's size on screen
+	uint8_t lod {0};
 };
 
 } // namespace openblack::ecs::components
@@ -0,0 +1,20 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+namespace openblack::ecs::components
+{
+
+/// Objects created by a script are under its control until RELEASE_FROM_SCRIPT, other scripts can choose to ignore them
+struct ScriptControlled
+{
+};
+
+} // namespace openblack::ecs::components
@@ -13,15 +13,21 @@
 #include <string>
 #include <unordered_map>
 
+#include "Enums.h"
+
 namespace openblack::ecs::components
 {
 
 struct Town
 {
 	uint32_t id;
+	PlayerNames owner;
 	std::unordered_map<std::string, float> beliefs;
 	bool uninhabitable = false;
 	std::set<entt::entity> homelessVillagers;
+	std::set<entt::entity> abodes;
+	/// Subset of abodes which can take in more villagers, kept up to date by the town system as inhabitants change
+	std::set<entt::entity> abodesWithVacancy;
 };
 
 } // namespace openblack::ecs::components
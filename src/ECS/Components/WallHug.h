@@ -9,9 +9,18 @@
 
 #pragma once
 
+#include <cstdint>
+
+#include <memory>
+
 #include <entt/fwd.hpp>
 #include <glm/vec2.hpp>
 
+namespace openblack::ecs
+{
+struct Route;
+}
+
 namespace openblack::ecs::components
 {
 
@@ -61,4 +70,12 @@ struct WallHug
 	float speed;
 };
 
+/// Waypoints followed one after the other before walking to the destination, the goal of WallHug is the current one
+struct WallHugRoute
+{
+	std::shared_ptr<const Route> route;
+	uint16_t waypoint;
+	glm::vec2 destination;
+};
+
 } // namespace openblack::ecs::components
@@ -37,6 +37,8 @@ class MapInterface
 	[[nodiscard]] virtual const std::unordered_set<entt::entity>& GetFixedInGridCell(const glm::vec3& pos) const = 0;
 	[[nodiscard]] virtual const std::unordered_set<entt::entity>& GetMobileInGridCell(const CellId& cellId) const = 0;
 	[[nodiscard]] virtual const std::unordered_set<entt::entity>& GetMobileInGridCell(const glm::vec3& pos) const = 0;
+	/// Incremented by Rebuild when fixed entities were added, removed or changed their bounds
+	[[nodiscard]] virtual uint32_t GetFixedVersion() const = 0;
 
 	virtual void Rebuild() = 0;
 
@@ -10,6 +10,9 @@
 #define LOCATOR_IMPLEMENTATIONS
 #include "MapProduction.h"
 
+#include <bit>
+
+#include <entt/entity/entity.hpp>
 #include <glm/gtx/component_wise.hpp>
 #include <glm/gtx/norm.hpp>
 #include <glm/gtx/vec_swizzle.hpp>
@@ -24,6 +27,25 @@
 using namespace openblack::ecs;
 using namespace openblack::ecs::components;
 
+namespace
+{
+uint64_t Mix(uint64_t value)
+{
+	// Finalizer of splitmix64
+	value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9;
+	value = (value ^ (value >> 27)) * 0x94D049BB133111EB;
+	return value ^ (value >> 31);
+}
+
+uint64_t HashFixed(entt::entity entity, const Fixed& fixed)
+{
+	auto hash = Mix(entt::to_integral(entity));
+	hash = Mix(hash ^ std::bit_cast<uint32_t>(fixed.boundingCenter.x));
+	hash = Mix(hash ^ std::bit_cast<uint32_t>(fixed.boundingCenter.y));
+	return Mix(hash ^ std::bit_cast<uint32_t>(fixed.boundingRadius));
+}
+} // namespace
+
 const std::unordered_set<entt::entity>& MapProduction::GetFixedInGridCell(const CellId& cellId) const
 {
 	return _fixedGrid.at(cellId.x + cellId.y * k_GridSize.x);
@@ -67,25 +89,37 @@ void MapProduction::Clear()
 void MapProduction::Build()
 {
 	auto& registry = Locator::entitiesRegistry::value();
-	registry.Each<const Fixed, const Transform>([this](entt::entity entity, const Fixed& fixed, const Transform& transform) {
-		// TODO(bwrsandman): This is only in the case of a square bb underling the bounding circle (x/z) <= 1.4
-		const float radius = fixed.boundingRadius * glm::compMax(transform.scale) + 1.0f;
-		const auto min = GetGridCell(fixed.boundingCenter - radius);
-		const auto max = GetGridCell(fixed.boundingCenter + radius);
-
-		for (uint16_t x = min.x; x < max.x + 1; ++x)
-		{
-			for (uint16_t y = min.y; y < max.y + 1; ++y)
-			{
-				const auto cellId = MapProduction::CellId(x, y);
-				if (glm::distance2(GetCellCenter(cellId), fixed.boundingCenter) < radius * radius)
-				{
-					auto& cell = _fixedGrid.at(cellId.x + cellId.y * k_GridSize.x);
-					cell.insert(entity);
-				}
-			}
-		}
-	});
+	uint64_t fixedHash = 0;
+	registry.Each<const Fixed, const Transform>(
+	    [this, &fixedHash](entt::entity entity, const Fixed& fixed, const Transform& transform) {
+		    // Summed so that the hash does not depend on the order of iteration
+		    fixedHash += HashFixed(entity, fixed);
+
+		    // TODO(bwrsandman): This is only in the case of a square bb underling the bounding circle (x/z) <= 1.4
+		    const float radius = fixed.boundingRadius * glm::compMax(transform.scale) + 1.0f;
+		    const auto min = GetGridCell(fixed.boundingCenter - radius);
+		    const auto max = GetGridCell(fixed.boundingCenter + radius);
+
+		    for (uint16_t x = min.x; x < max.x + 1; ++x)
+		    {
+			    for (uint16_t y = min.y; y < max.y + 1; ++y)
+			    {
+				    const auto cellId = MapProduction::CellId(x, y);
+				    if (glm::distance2(GetCellCenter(cellId), fixed.boundingCenter) < radius * radius)
+				    {
+					    auto& cell = _fixedGrid.at(cellId.x + cellId.y * k_GridSize.x);
+					    cell.insert(entity);
+				    }
+			    }
+		    }
+	    });
+
+	if (fixedHash != _fixedHash)
+	{
+		_fixedHash = fixedHash;
+		++_fixedVersion;
+	}
+
 	registry.Each<const Mobile, const Transform>(
 	    [this](entt::entity entity, [[maybe_unused]] const Mobile& mobile, const Transform& transform) {
 		    const auto cellId = GetGridCell(transform.position);
@@ -24,6 +24,7 @@ class MapProduction final: public MapInterface
 	[[nodiscard]] const std::unordered_set<entt::entity>& GetFixedInGridCell(const glm::vec3& pos) const override;
 	[[nodiscard]] const std::unordered_set<entt::entity>& GetMobileInGridCell(const CellId& cellId) const override;
 	[[nodiscard]] const std::unordered_set<entt::entity>& GetMobileInGridCell(const glm::vec3& pos) const override;
+	[[nodiscard]] uint32_t GetFixedVersion() const override { return _fixedVersion; }
 
 	void Rebuild() override;
 
@@ -33,6 +34,9 @@ class MapProduction final: public MapInterface
 
 	std::array<std::unordered_set<entt::entity>, k_GridSize.x * k_GridSize.y> _fixedGrid;
 	std::array<std::unordered_set<entt::entity>, k_GridSize.x * k_GridSize.y> _mobileGrid;
+	/// Hash of the fixed entities and their bounds in the last build
+	uint64_t _fixedHash {0};
+	uint32_t _fixedVersion {0};
 };
 
 } // namespace openblack::ecs
@@ -9,6 +9,11 @@
 
 #pragma once
 
+#include <cstdint>
+
+#include <span>
+#include <vector>
+
 #include <entt/entity/entity.hpp>
 #include <entt/entity/helper.hpp>
 #include <entt/entity/registry.hpp>
@@ -76,10 +81,39 @@ class Registry
 		Remove<Before>(entity);
 		return Assign<After>(entity, std::forward<Args>(args)...);
 	}
+	/// Signals of a component, listeners are called with the entt registry and the entity after an assignment or before a
+	/// removal
+	template <typename Component>
+	decltype(auto) OnConstruct()
+	{
+		return _registry.on_construct<Component>();
+	}
+	template <typename Component>
+	decltype(auto) OnDestroy()
+	{
+		return _registry.on_destroy<Component>();
+	}
+	template <typename Component>
+	decltype(auto) OnUpdate()
+	{
+		return _registry.on_update<Component>();
+	}
+	/// Change a component in place through functions taking it by reference, notifying the listeners of OnUpdate
+	template <typename Component, typename... Func>
+	decltype(auto) Patch(entt::entity entity, Func&&... func)
+	{
+		SetDirty();
+		return _registry.patch<Component>(entity, std::forward<Func>(func)...);
+	}
 	virtual void SetDirty();
 	virtual RegistryContext& Context();
 	[[nodiscard]] virtual const RegistryContext& Context() const;
 	virtual void Reset();
+	/// Binary copy of all entities, their persistent components and the context. Implemented in RegistrySnapshot.cpp
+	[[nodiscard]] std::vector<uint8_t> SaveSnapshot() const;
+	/// Replace everything in the registry with the content of a snapshot made with SaveSnapshot.
+	/// Snapshots from a different version are rejected and leave the registry untouched.
+	bool LoadSnapshot(std::span<const uint8_t> snapshot);
 	template <typename Component>
 	size_t Size()
 	{
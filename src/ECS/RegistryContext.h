@@ -10,8 +10,10 @@
 #pragma once
 
 #include <unordered_map>
+#include <vector>
 
 #include <entt/entity/fwd.hpp>
+#include <glm/vec3.hpp>
 
 #include "Components/Footpath.h"
 #include "Components/Stream.h"
@@ -24,5 +26,13 @@ struct RegistryContext
 	std::unordered_map<components::Footpath::Id, entt::entity> footpaths;
 	std::unordered_map<components::Stream::Id, entt::entity> streams;
 	std::unordered_map<uint32_t, entt::entity> towns;
+
+	struct TownLocation
+	{
+		glm::vec3 position;
+		entt::entity entity;
+	};
+	/// Sorted on x so that closest town queries only visit towns in a narrowing band around the point
+	std::vector<TownLocation> townLocations;
 };
 } // namespace openblack::ecs
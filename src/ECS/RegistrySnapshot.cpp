@@ -0,0 +1,410 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "RegistrySnapshot.h"
+
+#include <cassert>
+#include <cstring>
+
+#include <entt/entity/snapshot.hpp>
+#include <spdlog/spdlog.h>
+
+#include "ECS/Components/AnimatedStatic.h"
+#include "ECS/Components/CameraBookmark.h"
+#include "ECS/Components/Creature.h"
+#include "ECS/Components/Feature.h"
+#include "ECS/Components/Field.h"
+#include "ECS/Components/Fixed.h"
+#include "ECS/Components/Forest.h"
+#include "ECS/Components/Hand.h"
+#include "ECS/Components/LivingAction.h"
+#include "ECS/Components/Mesh.h"
+#include "ECS/Components/Mobile.h"
+#include "ECS/Components/MorphWithTerrain.h"
+#include "ECS/Components/Player.h"
+#include "ECS/Components/Pot.h"
+#include "ECS/Components/ScriptControlled.h"
+#include "ECS/Components/Sprite.h"
+#include "ECS/Components/StoragePit.h"
+#include "ECS/Components/Temple.h"
+#include "ECS/Components/Transform.h"
+#include "ECS/Components/Tree.h"
+#include "ECS/Components/Velocity.h"
+#include "ECS/Components/Villager.h"
+#include "ECS/Components/WallHug.h"
+#include "ECS/Registry.h"
+
+using namespace openblack::ecs;
+using namespace openblack::ecs::components;
+
+namespace
+{
+constexpr uint32_t k_SnapshotMagic = 0x5352424F; // "OBRS" little endian
+/// Bump whenever a persisted component, the context or the list below changes
+constexpr uint32_t k_SnapshotVersion = 2;
+
+template <typename... Components>
+struct ComponentList
+{
+	static constexpr auto k_Count = static_cast<uint32_t>(sizeof...(Components));
+};
+
+// The order of this list is the order of the snapshot, append new components at the end and bump the version.
+// RigidBody and AudioEmitter own physics and audio resources and are not persisted. Sprite only holds a texture handle
+// which is valid for as long as the textures stay loaded, which is the case for the lifetime of the game. WallHugRoute
+// shares routes owned by the route planner, mobiles stop at their current waypoint when a snapshot is loaded.
+using PersistentComponents =
+    ComponentList<Abode, AnimatedStatic, BigForest, CameraBookmark, Creature, Feature, Field, Fixed, Footpath, FootpathLink,
+                  Forest, Hand, LivingAction, Mesh, Mobile, MobileObject, MobileStatic, MorphWithTerrain,
+                  MoveStateArrivedTag, MoveStateExitCircleTag, MoveStateFinalStepTag, MoveStateLinearTag, MoveStateOrbitTag,
+                  MoveStateStepThroughTag, Player, Pot, Sprite, StoragePit, Stream, Temple, TempleInteriorPart, Town,
+                  Transform, Tree, Tribe, Velocity, Villager, WallHug, WallHugObjectReference, ScriptControlled>;
+
+template <typename Snapshot, typename Archive, typename... Components>
+void GetComponents(Snapshot& snapshot, Archive& archive, ComponentList<Components...> /*unused*/)
+{
+	(snapshot.template get<Components>(archive), ...);
+}
+
+/// Read what follows the header of a snapshot, from a copy of the archive so that it can be read again
+bool ReadSnapshotBody(SnapshotInputArchive archive, entt::registry& registry, RegistryContext& context)
+{
+	entt::snapshot_loader loader {registry};
+	loader.get<entt::entity>(archive);
+	GetComponents(loader, archive, PersistentComponents {});
+	loader.orphans();
+	archive(context);
+	return archive.IsGood() && archive.IsAtEnd();
+}
+} // namespace
+
+SnapshotOutputArchive::SnapshotOutputArchive(std::vector<uint8_t>& buffer)
+    : _buffer(buffer)
+{
+}
+
+void SnapshotOutputArchive::Write(const void* data, size_t size)
+{
+	const auto offset = _buffer.size();
+	_buffer.resize(offset + size);
+	std::memcpy(_buffer.data() + offset, data, size);
+}
+
+void SnapshotOutputArchive::Write(const std::string& string)
+{
+	(*this)(static_cast<uint32_t>(string.size()));
+	Write(string.data(), string.size());
+}
+
+template <typename Container>
+void SnapshotOutputArchive::WriteContainer(const Container& container)
+{
+	(*this)(static_cast<uint32_t>(container.size()));
+	for (const auto& element : container)
+	{
+		(*this)(element);
+	}
+}
+
+void SnapshotOutputArchive::Write(const Stream::Node& node)
+{
+	(*this)(node.position);
+	(*this)(static_cast<uint32_t>(node.edges.size()));
+	for (const auto& edge : node.edges)
+	{
+		Write(edge);
+	}
+}
+
+void SnapshotOutputArchive::operator()(std::underlying_type_t<entt::entity> value)
+{
+	Write(&value, sizeof(value));
+}
+
+void SnapshotOutputArchive::operator()(entt::entity entity)
+{
+	Write(&entity, sizeof(entity));
+}
+
+void SnapshotOutputArchive::operator()(const Abode& component)
+{
+	(*this)(component.type);
+	(*this)(component.townId);
+	(*this)(component.foodAmount);
+	(*this)(component.woodAmount);
+	WriteContainer(component.inhabitants);
+}
+
+void SnapshotOutputArchive::operator()(const Footpath& component)
+{
+	WriteContainer(component.nodes);
+}
+
+void SnapshotOutputArchive::operator()(const FootpathLink& component)
+{
+	(*this)(component.position);
+	WriteContainer(component.footpaths);
+}
+
+void SnapshotOutputArchive::operator()(const Stream& component)
+{
+	(*this)(component.id);
+	(*this)(static_cast<uint32_t>(component.nodes.size()));
+	for (const auto& node : component.nodes)
+	{
+		Write(node);
+	}
+}
+
+void SnapshotOutputArchive::operator()(const Town& component)
+{
+	(*this)(component.id);
+	(*this)(component.owner);
+	(*this)(static_cast<uint32_t>(component.beliefs.size()));
+	for (const auto& [name, belief] : component.beliefs)
+	{
+		Write(name);
+		(*this)(belief);
+	}
+	(*this)(component.uninhabitable);
+	WriteContainer(component.homelessVillagers);
+	WriteContainer(component.abodes);
+	WriteContainer(component.abodesWithVacancy);
+}
+
+void SnapshotOutputArchive::operator()(const RegistryContext& context)
+{
+	const auto writeMap = [this](const auto& map) {
+		(*this)(static_cast<uint32_t>(map.size()));
+		for (const auto& [id, entity] : map)
+		{
+			(*this)(id);
+			(*this)(entity);
+		}
+	};
+	writeMap(context.footpaths);
+	writeMap(context.streams);
+	writeMap(context.towns);
+	WriteContainer(context.townLocations);
+}
+
+SnapshotInputArchive::SnapshotInputArchive(std::span<const uint8_t> data)
+    : _data(data)
+{
+}
+
+void SnapshotInputArchive::Read(void* data, size_t size)
+{
+	if (!_good || _data.size() - _offset < size)
+	{
+		_good = false;
+		std::memset(data, 0, size);
+		return;
+	}
+	std::memcpy(data, _data.data() + _offset, size);
+	_offset += size;
+}
+
+uint32_t SnapshotInputArchive::ReadSize()
+{
+	uint32_t size = 0;
+	(*this)(size);
+	// Every element takes at least a byte, anything larger comes from corrupted data
+	if (size > _data.size() - _offset)
+	{
+		_good = false;
+		return 0;
+	}
+	return size;
+}
+
+void SnapshotInputArchive::Read(std::string& string)
+{
+	string.resize(ReadSize());
+	Read(string.data(), string.size());
+}
+
+Stream::Node SnapshotInputArchive::ReadStreamNode()
+{
+	glm::vec3 position;
+	(*this)(position);
+	auto node = Stream::Node(position, {});
+	const auto edgeCount = ReadSize();
+	node.edges.reserve(edgeCount);
+	for (uint32_t i = 0; i < edgeCount; ++i)
+	{
+		node.edges.push_back(ReadStreamNode());
+	}
+	return node;
+}
+
+void SnapshotInputArchive::operator()(std::underlying_type_t<entt::entity>& value)
+{
+	Read(&value, sizeof(value));
+}
+
+void SnapshotInputArchive::operator()(entt::entity& entity)
+{
+	Read(&entity, sizeof(entity));
+	// The loader skips null entities, which prevents corrupted data from assigning components to the same entity twice
+	if (!_good)
+	{
+		entity = entt::null;
+	}
+}
+
+void SnapshotInputArchive::operator()(Abode& component)
+{
+	(*this)(component.type);
+	(*this)(component.townId);
+	(*this)(component.foodAmount);
+	(*this)(component.woodAmount);
+	component.inhabitants.clear();
+	for (auto count = ReadSize(); count > 0; --count)
+	{
+		entt::entity entity;
+		(*this)(entity);
+		component.inhabitants.insert(component.inhabitants.end(), entity);
+	}
+}
+
+void SnapshotInputArchive::operator()(Footpath& component)
+{
+	component.nodes.resize(ReadSize());
+	for (auto& node : component.nodes)
+	{
+		(*this)(node);
+	}
+}
+
+void SnapshotInputArchive::operator()(FootpathLink& component)
+{
+	(*this)(component.position);
+	component.footpaths.resize(ReadSize());
+	for (auto& footpath : component.footpaths)
+	{
+		(*this)(footpath);
+	}
+}
+
+void SnapshotInputArchive::operator()(Stream& component)
+{
+	(*this)(component.id);
+	const auto nodeCount = ReadSize();
+	component.nodes.clear();
+	component.nodes.reserve(nodeCount);
+	for (uint32_t i = 0; i < nodeCount; ++i)
+	{
+		component.nodes.push_back(ReadStreamNode());
+	}
+}
+
+void SnapshotInputArchive::operator()(Town& component)
+{
+	const auto readEntities = [this](std::set<entt::entity>& entities) {
+		entities.clear();
+		for (auto count = ReadSize(); count > 0; --count)
+		{
+			entt::entity entity;
+			(*this)(entity);
+			entities.insert(entities.end(), entity);
+		}
+	};
+
+	(*this)(component.id);
+	(*this)(component.owner);
+	component.beliefs.clear();
+	for (auto count = ReadSize(); count > 0; --count)
+	{
+		std::string name;
+		float belief;
+		Read(name);
+		(*this)(belief);
+		component.beliefs.emplace(std::move(name), belief);
+	}
+	(*this)(component.uninhabitable);
+	readEntities(component.homelessVillagers);
+	readEntities(component.abodes);
+	readEntities(component.abodesWithVacancy);
+}
+
+void SnapshotInputArchive::operator()(RegistryContext& context)
+{
+	const auto readMap = [this](auto& map) {
+		map.clear();
+		for (auto count = ReadSize(); count > 0; --count)
+		{
+			typename std::remove_reference_t<decltype(map)>::key_type id;
+			entt::entity entity;
+			(*this)(id);
+			(*this)(entity);
+			map.emplace(id, entity);
+		}
+	};
+	readMap(context.footpaths);
+	readMap(context.streams);
+	readMap(context.towns);
+	context.townLocations.resize(ReadSize());
+	for (auto& location : context.townLocations)
+	{
+		(*this)(location);
+	}
+}
+
+std::vector<uint8_t> Registry::SaveSnapshot() const
+{
+	std::vector<uint8_t> result;
+	SnapshotOutputArchive archive(result);
+	archive(k_SnapshotMagic);
+	archive(k_SnapshotVersion);
+	archive(PersistentComponents::k_Count);
+
+	entt::snapshot snapshot {_registry};
+	snapshot.get<entt::entity>(archive);
+	GetComponents(snapshot, archive, PersistentComponents {});
+	archive(Context());
+
+	return result;
+}
+
+bool Registry::LoadSnapshot(std::span<const uint8_t> snapshot)
+{
+	SnapshotInputArchive archive(snapshot);
+	uint32_t magic;
+	uint32_t version;
+	uint32_t componentCount;
+	archive(magic);
+	archive(version);
+	archive(componentCount);
+	if (!archive.IsGood() || magic != k_SnapshotMagic || version != k_SnapshotVersion ||
+	    componentCount != PersistentComponents::k_Count)
+	{
+		SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Registry snapshot is not compatible (version {}, expected {})", version,
+		                    k_SnapshotVersion);
+		return false;
+	}
+
+	// Truncated or corrupted data is only found once read, so the snapshot is read into a scratch registry first and the
+	// content of this one is kept when it fails
+	{
+		entt::registry scratch;
+		RegistryContext scratchContext;
+		if (!ReadSnapshotBody(archive, scratch, scratchContext))
+		{
+			SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Registry snapshot is truncated or corrupted");
+			return false;
+		}
+	}
+
+	Reset();
+	[[maybe_unused]] const auto loaded = ReadSnapshotBody(archive, _registry, Context());
+	assert(loaded);
+
+	return true;
+}
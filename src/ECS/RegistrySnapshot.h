@@ -0,0 +1,102 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <entt/entity/fwd.hpp>
+
+#include "ECS/Components/Abode.h"
+#include "ECS/Components/Footpath.h"
+#include "ECS/Components/Stream.h"
+#include "ECS/Components/Town.h"
+#include "ECS/RegistryContext.h"
+
+namespace openblack::ecs
+{
+
+/// Binary archive given to entt::snapshot to write a registry into a byte buffer.
+///
+/// Trivially copyable components are copied as is, components owning containers are written field by field.
+/// Entity references are stored as raw identifiers, which stay valid because a snapshot restores every entity with its
+/// original identifier and version.
+class SnapshotOutputArchive
+{
+public:
+	explicit SnapshotOutputArchive(std::vector<uint8_t>& buffer);
+
+	void operator()(std::underlying_type_t<entt::entity> value);
+	void operator()(entt::entity entity);
+	template <typename Component>
+	    requires std::is_trivially_copyable_v<Component>
+	void operator()(const Component& component)
+	{
+		Write(&component, sizeof(component));
+	}
+	void operator()(const components::Abode& component);
+	void operator()(const components::Footpath& component);
+	void operator()(const components::FootpathLink& component);
+	void operator()(const components::Stream& component);
+	void operator()(const components::Town& component);
+	void operator()(const RegistryContext& context);
+
+private:
+	void Write(const void* data, size_t size);
+	void Write(const std::string& string);
+	void Write(const components::Stream::Node& node);
+	template <typename Container>
+	void WriteContainer(const Container& container);
+
+	std::vector<uint8_t>& _buffer;
+};
+
+/// Binary archive given to entt::snapshot_loader to read back what SnapshotOutputArchive wrote.
+///
+/// Reading past the end of the data does not throw, the archive is flagged as bad and zeros are returned instead.
+class SnapshotInputArchive
+{
+public:
+	explicit SnapshotInputArchive(std::span<const uint8_t> data);
+
+	void operator()(std::underlying_type_t<entt::entity>& value);
+	void operator()(entt::entity& entity);
+	template <typename Component>
+	    requires std::is_trivially_copyable_v<Component>
+	void operator()(Component& component)
+	{
+		Read(&component, sizeof(component));
+	}
+	void operator()(components::Abode& component);
+	void operator()(components::Footpath& component);
+	void operator()(components::FootpathLink& component);
+	void operator()(components::Stream& component);
+	void operator()(components::Town& component);
+	void operator()(RegistryContext& context);
+
+	[[nodiscard]] bool IsGood() const { return _good; }
+	[[nodiscard]] bool IsAtEnd() const { return _offset == _data.size(); }
+
+private:
+	void Read(void* data, size_t size);
+	void Read(std::string& string);
+	[[nodiscard]] components::Stream::Node ReadStreamNode();
+	[[nodiscard]] uint32_t ReadSize();
+
+	std::span<const uint8_t> _data;
+	size_t _offset {0};
+	bool _good {true};
+};
+
+} // namespace openblack::ecs
@@ -0,0 +1,394 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "RoutePlanner.h"
+
+#include <cstddef>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/gtx/norm.hpp>
+#include <glm/gtx/vec_swizzle.hpp>
+
+#include "ECS/Components/Field.h"
+#include "ECS/Components/Fixed.h"
+#include "ECS/Components/Footpath.h"
+#include "ECS/Components/Stream.h"
+#include "ECS/Registry.h"
+
+using namespace openblack::ecs;
+using namespace openblack::ecs::components;
+
+namespace
+{
+/// Closest nodes considered when joining a point to the graph, and how many of them are joined
+constexpr size_t k_EntryCandidates = 16;
+constexpr size_t k_EntryEdges = 4;
+constexpr float k_Infinity = std::numeric_limits<float>::infinity();
+
+float DistanceToSegment2(const glm::vec2& point, const glm::vec2& from, const glm::vec2& to)
+{
+	const auto segment = to - from;
+	const auto length2 = glm::length2(segment);
+	const auto t = length2 > 0.0f ? glm::clamp(glm::dot(point - from, segment) / length2, 0.0f, 1.0f) : 0.0f;
+	return glm::distance2(point, from + t * segment);
+}
+
+float Cross(const glm::vec2& a, const glm::vec2& b)
+{
+	return a.x * b.y - a.y * b.x;
+}
+
+bool SegmentsIntersect(const glm::vec2& p0, const glm::vec2& p1, const glm::vec2& q0, const glm::vec2& q1)
+{
+	const auto r = p1 - p0;
+	const auto s = q1 - q0;
+	const auto denominator = Cross(r, s);
+	if (denominator == 0.0f)
+	{
+		return false; // Parallel, walking alongside a stream does not cross it
+	}
+	const auto t = Cross(q0 - p0, s) / denominator;
+	const auto u = Cross(q0 - p0, r) / denominator;
+	return t >= 0.0f && t <= 1.0f && u >= 0.0f && u <= 1.0f;
+}
+} // namespace
+
+RoutePlanner::RegionId RoutePlanner::GetRegion(const glm::vec2& position)
+{
+	const auto region = glm::clamp(glm::floor(position / k_RegionSize), 0.0f, static_cast<float>(k_RegionCount - 1));
+	return static_cast<RegionId>(region);
+}
+
+uint32_t RoutePlanner::GetRegionIndex(const RegionId& region)
+{
+	return region.x + region.y * static_cast<uint32_t>(k_RegionCount);
+}
+
+std::vector<uint32_t> RoutePlanner::GetRegionsAlong(const glm::vec2& from, const glm::vec2& to)
+{
+	// Sample the segment at a fraction of the region size, corners cut by less than that are missed
+	const auto length = glm::distance(from, to);
+	const auto samples = static_cast<uint32_t>(length / (k_RegionSize * 0.25f)) + 1;
+	std::vector<uint32_t> regions;
+	for (uint32_t i = 0; i <= samples; ++i)
+	{
+		const auto t = static_cast<float>(i) / static_cast<float>(samples);
+		const auto region = GetRegionIndex(GetRegion(glm::mix(from, to, t)));
+		if (std::find(regions.cbegin(), regions.cend(), region) == regions.cend())
+		{
+			regions.push_back(region);
+		}
+	}
+	return regions;
+}
+
+void RoutePlanner::Invalidate()
+{
+	_built = false;
+	_nodes.clear();
+	_edges.clear();
+	_obstacles.clear();
+	_streams.clear();
+	_regions.clear();
+	_cache.clear();
+	_cacheIndex.clear();
+}
+
+uint32_t RoutePlanner::AddNode(const glm::vec2& position)
+{
+	const auto index = static_cast<uint32_t>(_nodes.size());
+	_nodes.push_back(position);
+	_edges.emplace_back();
+	_regions[GetRegionIndex(GetRegion(position))].nodes.push_back(index);
+	return index;
+}
+
+void RoutePlanner::AddEdge(uint32_t from, uint32_t to)
+{
+	const auto cost = glm::distance(_nodes[from], _nodes[to]);
+	_edges[from].push_back({to, cost});
+	_edges[to].push_back({from, cost});
+}
+
+void RoutePlanner::Build(const Registry& registry)
+{
+	Invalidate();
+
+	std::unordered_map<entt::entity, std::vector<uint32_t>> footpathNodes;
+	registry.Each<const Footpath>([this, &footpathNodes](entt::entity entity, const Footpath& footpath) {
+		auto& nodes = footpathNodes[entity];
+		nodes.reserve(footpath.nodes.size());
+		for (const auto& node : footpath.nodes)
+		{
+			nodes.push_back(AddNode(glm::xz(node.position)));
+			if (nodes.size() > 1)
+			{
+				AddEdge(nodes[nodes.size() - 2], nodes.back());
+			}
+		}
+	});
+
+	// Footpaths meet at their links, join each link to the closest node of its footpaths
+	registry.Each<const FootpathLink>([this, &footpathNodes](const FootpathLink& link) {
+		const auto linkNode = AddNode(glm::xz(link.position));
+		for (const auto& id : link.footpaths)
+		{
+			const auto nodes = footpathNodes.find(static_cast<entt::entity>(id));
+			if (nodes == footpathNodes.end() || nodes->second.empty())
+			{
+				continue;
+			}
+			const auto closest = std::ranges::min(nodes->second, {}, [this, linkNode](uint32_t node) {
+				return glm::distance2(_nodes[node], _nodes[linkNode]);
+			});
+			AddEdge(linkNode, closest);
+		}
+	});
+
+	registry.Each<const Stream>([this](const Stream& stream) {
+		for (const auto& node : stream.nodes)
+		{
+			for (const auto& edge : node.edges)
+			{
+				const auto index = static_cast<uint32_t>(_streams.size());
+				_streams.push_back({glm::xz(node.position), glm::xz(edge.position)});
+				for (const auto region : GetRegionsAlong(_streams.back().from, _streams.back().to))
+				{
+					_regions[region].streams.push_back(index);
+				}
+			}
+		}
+	});
+
+	registry.Each<const Fixed>([this, &registry](entt::entity entity, const Fixed& fixed) {
+		// Fields are walked through, as in the wall hug
+		if (registry.AnyOf<Field>(entity))
+		{
+			return;
+		}
+		const auto index = static_cast<uint32_t>(_obstacles.size());
+		_obstacles.push_back({fixed.boundingCenter, fixed.boundingRadius});
+		const auto min = GetRegion(fixed.boundingCenter - fixed.boundingRadius);
+		const auto max = GetRegion(fixed.boundingCenter + fixed.boundingRadius);
+		for (uint16_t y = min.y; y <= max.y; ++y)
+		{
+			for (uint16_t x = min.x; x <= max.x; ++x)
+			{
+				_regions[GetRegionIndex({x, y})].obstacles.push_back(index);
+			}
+		}
+	});
+
+	_built = true;
+}
+
+bool RoutePlanner::IsWalkable(const glm::vec2& from, const glm::vec2& to) const
+{
+	for (const auto region : GetRegionsAlong(from, to))
+	{
+		const auto content = _regions.find(region);
+		if (content == _regions.end())
+		{
+			continue;
+		}
+		for (const auto index : content->second.obstacles)
+		{
+			const auto& obstacle = _obstacles[index];
+			const auto radius2 = obstacle.radius * obstacle.radius;
+			// Mobiles start and end inside of the obstacles they live in or go to, only the others are in the way
+			if (glm::distance2(from, obstacle.center) < radius2 || glm::distance2(to, obstacle.center) < radius2)
+			{
+				continue;
+			}
+			if (DistanceToSegment2(obstacle.center, from, to) < radius2)
+			{
+				return false;
+			}
+		}
+		for (const auto index : content->second.streams)
+		{
+			if (SegmentsIntersect(from, to, _streams[index].from, _streams[index].to))
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+std::vector<RoutePlanner::Edge> RoutePlanner::GetEntryEdges(const glm::vec2& position) const
+{
+	const auto region = GetRegion(position);
+	std::vector<Edge> candidates;
+	for (int32_t y = region.y - 1; y <= region.y + 1; ++y)
+	{
+		for (int32_t x = region.x - 1; x <= region.x + 1; ++x)
+		{
+			if (x < 0 || y < 0 || x >= k_RegionCount || y >= k_RegionCount)
+			{
+				continue;
+			}
+			const auto content = _regions.find(GetRegionIndex(RegionId(x, y)));
+			if (content == _regions.end())
+			{
+				continue;
+			}
+			for (const auto node : content->second.nodes)
+			{
+				candidates.push_back({node, glm::distance(position, _nodes[node])});
+			}
+		}
+	}
+
+	const auto count = std::min(candidates.size(), k_EntryCandidates);
+	std::partial_sort(candidates.begin(), candidates.begin() + static_cast<std::ptrdiff_t>(count), candidates.end(),
+	                  [](const Edge& a, const Edge& b) { return a.cost < b.cost; });
+	candidates.resize(count);
+
+	std::vector<Edge> edges;
+	for (const auto& candidate : candidates)
+	{
+		if (IsWalkable(position, _nodes[candidate.node]))
+		{
+			edges.push_back(candidate);
+			if (edges.size() == k_EntryEdges)
+			{
+				break;
+			}
+		}
+	}
+	return edges;
+}
+
+std::shared_ptr<const Route> RoutePlanner::Plan(const glm::vec2& from, const glm::vec2& to) const
+{
+	if (IsWalkable(from, to))
+	{
+		return nullptr;
+	}
+
+	const auto entries = GetEntryEdges(from);
+	const auto exits = GetEntryEdges(to);
+	if (entries.empty() || exits.empty())
+	{
+		return nullptr;
+	}
+
+	// A* over the footpath graph, from every entry node to the best exit node
+	constexpr auto k_NoNode = std::numeric_limits<uint32_t>::max();
+	std::vector<float> costs(_nodes.size(), k_Infinity);
+	std::vector<float> exitCosts(_nodes.size(), k_Infinity);
+	std::vector<uint32_t> previous(_nodes.size(), k_NoNode);
+	using QueueEntry = std::pair<float, uint32_t>;
+	std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<>> open;
+
+	for (const auto& exit : exits)
+	{
+		exitCosts[exit.node] = exit.cost;
+	}
+	for (const auto& entry : entries)
+	{
+		costs[entry.node] = entry.cost;
+		open.emplace(entry.cost + glm::distance(_nodes[entry.node], to), entry.node);
+	}
+
+	float bestCost = k_Infinity;
+	uint32_t bestNode = k_NoNode;
+	while (!open.empty())
+	{
+		const auto [estimate, node] = open.top();
+		open.pop();
+		if (estimate >= bestCost)
+		{
+			break;
+		}
+		if (estimate > costs[node] + glm::distance(_nodes[node], to))
+		{
+			continue; // Reached through a shorter path since it was queued
+		}
+		if (costs[node] + exitCosts[node] < bestCost)
+		{
+			bestCost = costs[node] + exitCosts[node];
+			bestNode = node;
+		}
+		for (const auto& edge : _edges[node])
+		{
+			const auto cost = costs[node] + edge.cost;
+			if (cost < costs[edge.node])
+			{
+				costs[edge.node] = cost;
+				previous[edge.node] = node;
+				open.emplace(cost + glm::distance(_nodes[edge.node], to), edge.node);
+			}
+		}
+	}
+
+	if (bestNode == k_NoNode)
+	{
+		return nullptr;
+	}
+
+	auto route = std::make_shared<Route>();
+	for (auto node = bestNode; node != k_NoNode; node = previous[node])
+	{
+		route->waypoints.push_back(_nodes[node]);
+	}
+	std::reverse(route->waypoints.begin(), route->waypoints.end());
+	return route;
+}
+
+std::shared_ptr<const Route> RoutePlanner::FindRoute(const glm::vec2& from, const glm::vec2& to)
+{
+	const CacheKey key {GetRegionIndex(GetRegion(from)), GetRegionIndex(GetRegion(to))};
+	if (!_built || key.first == key.second)
+	{
+		return nullptr;
+	}
+
+	if (const auto cached = _cacheIndex.find(key); cached != _cacheIndex.end())
+	{
+		++_hits;
+		_cache.splice(_cache.begin(), _cache, cached->second);
+		return cached->second->second;
+	}
+
+	++_misses;
+	auto route = Plan(from, to);
+	_cache.emplace_front(key, route);
+	_cacheIndex.emplace(key, _cache.begin());
+	if (_cache.size() > k_CacheSize)
+	{
+		_cacheIndex.erase(_cache.back().first);
+		_cache.pop_back();
+	}
+	return route;
+}
+
+RoutePlanner::Stats RoutePlanner::GetStats() const
+{
+	size_t edges = 0;
+	for (const auto& nodeEdges : _edges)
+	{
+		edges += nodeEdges.size();
+	}
+	return {
+	    static_cast<uint32_t>(_nodes.size()),
+	    static_cast<uint32_t>(edges / 2),
+	    static_cast<uint32_t>(_obstacles.size()),
+	    static_cast<uint32_t>(_cache.size()),
+	    _hits,
+	    _misses,
+	};
+}
@@ -0,0 +1,137 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <glm/fwd.hpp>
+#include <glm/vec2.hpp>
+
+namespace openblack::ecs
+{
+class Registry;
+
+/// Waypoints on footpaths between two regions of the map, shared by every mobile going from one to the other
+struct Route
+{
+	std::vector<glm::vec2> waypoints;
+};
+
+/**
+  Plans routes over the footpaths of the map, leaving the steps between waypoints to the wall hug.
+
+  The graph is made of the nodes of the footpaths, joined along each footpath and at footpath links. The start and the
+  destination of a route are joined to the closest nodes they can walk to in a straight line without going through a
+  fixed obstacle or a stream. Routes are cached per pair of regions so that mobiles going between the same places, such
+  as villagers of a town going to their field, share the same route.
+ */
+class RoutePlanner
+{
+public:
+	using RegionId = glm::u16vec2;
+
+	/// Side of a region in world units, 8 cells of the map grid
+	static constexpr float k_RegionSize = 80.0f;
+	static constexpr uint16_t k_RegionCount = 64;
+	/// Maximum number of routes kept, the least recently used are dropped first
+	static constexpr size_t k_CacheSize = 256;
+
+	struct Stats
+	{
+		uint32_t nodes;
+		uint32_t edges;
+		uint32_t obstacles;
+		uint32_t cachedRoutes;
+		uint64_t hits;
+		uint64_t misses;
+	};
+
+	[[nodiscard]] static RegionId GetRegion(const glm::vec2& position);
+
+	/// Read the footpaths, footpath links, streams and fixed obstacles of the registry, dropping cached routes
+	void Build(const Registry& registry);
+	/// Drop the graph and cached routes, the next route will rebuild the graph
+	void Invalidate();
+	[[nodiscard]] bool IsBuilt() const { return _built; }
+
+	/// Route between two points, or nothing if the destination can be walked to in a straight line or is not reachable
+	/// through footpaths
+	[[nodiscard]] std::shared_ptr<const Route> FindRoute(const glm::vec2& from, const glm::vec2& to);
+
+	[[nodiscard]] Stats GetStats() const;
+
+private:
+	struct Edge
+	{
+		uint32_t node;
+		float cost;
+	};
+
+	struct Obstacle
+	{
+		glm::vec2 center;
+		float radius;
+	};
+
+	struct Segment
+	{
+		glm::vec2 from;
+		glm::vec2 to;
+	};
+
+	/// Obstacles, stream segments and nodes overlapping a region
+	struct RegionContent
+	{
+		std::vector<uint32_t> obstacles;
+		std::vector<uint32_t> streams;
+		std::vector<uint32_t> nodes;
+	};
+
+	[[nodiscard]] static uint32_t GetRegionIndex(const RegionId& region);
+	/// Regions crossed by a segment
+	[[nodiscard]] static std::vector<uint32_t> GetRegionsAlong(const glm::vec2& from, const glm::vec2& to);
+
+	uint32_t AddNode(const glm::vec2& position);
+	void AddEdge(uint32_t from, uint32_t to);
+	[[nodiscard]] bool IsWalkable(const glm::vec2& from, const glm::vec2& to) const;
+	/// Nodes close to a point which can be walked to from it, with the distance to walk
+	[[nodiscard]] std::vector<Edge> GetEntryEdges(const glm::vec2& position) const;
+	[[nodiscard]] std::shared_ptr<const Route> Plan(const glm::vec2& from, const glm::vec2& to) const;
+
+	bool _built {false};
+	std::vector<glm::vec2> _nodes;
+	std::vector<std::vector<Edge>> _edges;
+	std::vector<Obstacle> _obstacles;
+	std::vector<Segment> _streams;
+	std::unordered_map<uint32_t, RegionContent> _regions;
+
+	using CacheKey = std::pair<uint32_t, uint32_t>;
+	struct CacheKeyHash
+	{
+		size_t operator()(const CacheKey& key) const
+		{
+			return std::hash<uint64_t> {}((static_cast<uint64_t>(key.first) << 32) | key.second);
+		}
+	};
+	/// Most recently used first
+	std::list<std::pair<CacheKey, std::shared_ptr<const Route>>> _cache;
+	std::unordered_map<CacheKey, decltype(_cache)::iterator, CacheKeyHash> _cacheIndex;
+	uint64_t _hits {0};
+	uint64_t _misses {0};
+};
+
+} // namespace openblack::ecs
@@ -0,0 +1,275 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "SpatialIndex.h"
+
+#include <algorithm>
+#include <queue>
+#include <utility>
+
+#include <glm/common.hpp>
+#include <glm/gtx/norm.hpp>
+#include <glm/vector_relational.hpp>
+
+using namespace openblack::ecs;
+
+SpatialIndex::SpatialIndex()
+    : _cells(k_CellCount * k_CellCount)
+{
+}
+
+uint32_t SpatialIndex::GetCell(const glm::vec2& position)
+{
+	const auto cell = glm::clamp(glm::floor(position / k_CellSize), 0.0f, static_cast<float>(k_CellCount - 1));
+	return static_cast<uint32_t>(cell.x) + static_cast<uint32_t>(cell.y) * k_CellCount;
+}
+
+bool SpatialIndex::Matches(const Object& object, const SpatialQueryFilter& filter)
+{
+	if (filter.type.has_value() && object.type != *filter.type)
+	{
+		return false;
+	}
+	if (filter.subtype.has_value() && object.subtype != *filter.subtype)
+	{
+		return false;
+	}
+	if (filter.owner.has_value() && object.owner != filter.owner)
+	{
+		return false;
+	}
+	if (filter.excludeScripted && object.scripted)
+	{
+		return false;
+	}
+	return !filter.predicate || filter.predicate(object.entity);
+}
+
+void SpatialIndex::AddToCell(uint32_t index, uint32_t cell)
+{
+	auto& objects = _cells[cell];
+	_locations[index] = {cell, static_cast<uint32_t>(objects.size())};
+	objects.push_back(index);
+}
+
+void SpatialIndex::RemoveFromCell(uint32_t index)
+{
+	const auto location = _locations[index];
+	auto& objects = _cells[location.cell];
+	objects[location.slot] = objects.back();
+	_locations[objects[location.slot]].slot = location.slot;
+	objects.pop_back();
+}
+
+void SpatialIndex::Set(const Object& object)
+{
+	const auto [it, inserted] = _indices.try_emplace(object.entity, static_cast<uint32_t>(_objects.size()));
+	if (inserted)
+	{
+		_objects.push_back(object);
+		_locations.emplace_back();
+		AddToCell(it->second, GetCell(object.position));
+		return;
+	}
+
+	_objects[it->second] = object;
+	Move(object.entity, object.position);
+}
+
+void SpatialIndex::Move(entt::entity entity, const glm::vec2& position)
+{
+	const auto it = _indices.find(entity);
+	if (it == _indices.end())
+	{
+		return;
+	}
+	const auto index = it->second;
+	_objects[index].position = position;
+	const auto cell = GetCell(position);
+	if (cell != _locations[index].cell)
+	{
+		RemoveFromCell(index);
+		AddToCell(index, cell);
+	}
+}
+
+void SpatialIndex::Remove(entt::entity entity)
+{
+	const auto it = _indices.find(entity);
+	if (it == _indices.end())
+	{
+		return;
+	}
+	const auto index = it->second;
+	_indices.erase(it);
+	RemoveFromCell(index);
+
+	// Fill the hole with the last object
+	const auto last = static_cast<uint32_t>(_objects.size() - 1);
+	if (index != last)
+	{
+		_objects[index] = _objects[last];
+		_locations[index] = _locations[last];
+		_cells[_locations[index].cell][_locations[index].slot] = index;
+		_indices[_objects[index].entity] = index;
+	}
+	_objects.pop_back();
+	_locations.pop_back();
+}
+
+void SpatialIndex::Clear()
+{
+	_objects.clear();
+	_locations.clear();
+	_indices.clear();
+	for (auto& cell : _cells)
+	{
+		cell.clear();
+	}
+}
+
+const SpatialIndex::Object* SpatialIndex::Find(entt::entity entity) const
+{
+	const auto it = _indices.find(entity);
+	return it != _indices.end() ? &_objects[it->second] : nullptr;
+}
+
+template <typename Func>
+void SpatialIndex::VisitBox(const glm::vec2& min, const glm::vec2& max, Func func) const
+{
+	const auto first = GetCell(min);
+	const auto last = GetCell(max);
+	for (auto y = first / k_CellCount; y <= last / k_CellCount; ++y)
+	{
+		for (auto x = first % k_CellCount; x <= last % k_CellCount; ++x)
+		{
+			for (const auto index : _cells[x + y * k_CellCount])
+			{
+				func(index);
+			}
+		}
+	}
+}
+
+std::vector<entt::entity> SpatialIndex::FindInRadius(const glm::vec2& center, float radius,
+                                                     const SpatialQueryFilter& filter) const
+{
+	return FindInAnnulus(center, 0.0f, radius, filter);
+}
+
+std::vector<entt::entity> SpatialIndex::FindInAnnulus(const glm::vec2& center, float innerRadius, float outerRadius,
+                                                      const SpatialQueryFilter& filter) const
+{
+	std::vector<entt::entity> result;
+	const auto inner2 = innerRadius * innerRadius;
+	const auto outer2 = outerRadius * outerRadius;
+	VisitBox(center - outerRadius, center + outerRadius, [this, &center, inner2, outer2, &filter, &result](uint32_t index) {
+		const auto& object = _objects[index];
+		const auto distance2 = glm::distance2(center, object.position);
+		if (distance2 >= inner2 && distance2 <= outer2 && Matches(object, filter))
+		{
+			result.push_back(object.entity);
+		}
+	});
+	return result;
+}
+
+std::vector<entt::entity> SpatialIndex::FindInBox(const glm::vec2& min, const glm::vec2& max,
+                                                  const SpatialQueryFilter& filter) const
+{
+	std::vector<entt::entity> result;
+	VisitBox(min, max, [this, &min, &max, &filter, &result](uint32_t index) {
+		const auto& object = _objects[index];
+		if (glm::all(glm::greaterThanEqual(object.position, min)) && glm::all(glm::lessThanEqual(object.position, max)) &&
+		    Matches(object, filter))
+		{
+			result.push_back(object.entity);
+		}
+	});
+	return result;
+}
+
+std::vector<entt::entity> SpatialIndex::FindNearest(const glm::vec2& center, size_t count, const SpatialQueryFilter& filter,
+                                                    float minRadius, float maxRadius) const
+{
+	if (count == 0)
+	{
+		return {};
+	}
+
+	const auto min2 = minRadius * minRadius;
+	const auto max2 = maxRadius * maxRadius;
+	// Furthest of the closest objects found so far on top
+	std::priority_queue<std::pair<float, entt::entity>> closest;
+
+	const auto centerCell = GetCell(center);
+	const auto cx = static_cast<int32_t>(centerCell % k_CellCount);
+	const auto cy = static_cast<int32_t>(centerCell / k_CellCount);
+	const auto cellCount = static_cast<int32_t>(k_CellCount);
+	const auto lastRing = std::max({cx, cy, cellCount - 1 - cx, cellCount - 1 - cy});
+
+	const auto visitCell = [this, &center, min2, max2, count, &filter, &closest](int32_t x, int32_t y) {
+		for (const auto index : _cells[x + y * k_CellCount])
+		{
+			const auto& object = _objects[index];
+			const auto distance2 = glm::distance2(center, object.position);
+			if (distance2 < min2 || distance2 > max2 || (closest.size() == count && distance2 >= closest.top().first))
+			{
+				continue;
+			}
+			if (!Matches(object, filter))
+			{
+				continue;
+			}
+			closest.emplace(distance2, object.entity);
+			if (closest.size() > count)
+			{
+				closest.pop();
+			}
+		}
+	};
+
+	for (int32_t ring = 0; ring <= lastRing; ++ring)
+	{
+		if (ring > 0)
+		{
+			// Distance from the point to the inside of the ring, nothing in the ring or beyond it is closer
+			const auto inside = glm::vec2(cx - ring + 1, cy - ring + 1) * k_CellSize;
+			const auto outside = glm::vec2(cx + ring, cy + ring) * k_CellSize;
+			const auto bound = std::max(0.0f, std::min({center.x - inside.x, center.y - inside.y, outside.x - center.x,
+			                                            outside.y - center.y}));
+			if (bound > maxRadius || (closest.size() == count && bound * bound >= closest.top().first))
+			{
+				break;
+			}
+		}
+
+		for (int32_t y = std::max(cy - ring, 0); y <= std::min(cy + ring, cellCount - 1); ++y)
+		{
+			const auto edge = y == cy - ring || y == cy + ring;
+			// Rows on the edge of the ring are visited whole, other rows only at both ends
+			const auto step = edge ? 1 : std::max(2 * ring, 1);
+			for (int32_t x = cx - ring; x <= cx + ring; x += step)
+			{
+				if (x >= 0 && x < cellCount)
+				{
+					visitCell(x, y);
+				}
+			}
+		}
+	}
+
+	std::vector<entt::entity> result(closest.size());
+	for (auto it = result.rbegin(); it != result.rend(); ++it)
+	{
+		*it = closest.top().second;
+		closest.pop();
+	}
+	return result;
+}
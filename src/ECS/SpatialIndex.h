@@ -0,0 +1,111 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <functional>
+#include <limits>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include <entt/entity/entity.hpp>
+#include <glm/vec2.hpp>
+
+#include "Enums.h"
+#include "ScriptHeaders/ScriptEnums.h"
+
+namespace openblack::ecs
+{
+
+/// What a spatial query looks for, fields which are not set match every object
+struct SpatialQueryFilter
+{
+	std::optional<script::ObjectType> type;
+	std::optional<int32_t> subtype;
+	std::optional<PlayerNames> owner;
+	/// Skip objects which are controlled by a script
+	bool excludeScripted {false};
+	/// Checked last, for conditions which are not part of the index such as the state of a living
+	std::function<bool(entt::entity)> predicate;
+};
+
+/**
+  Uniform grid of the objects on the ground, queried in 2D on the x and z axes of the world.
+
+  Objects are added, moved and removed one at a time, each in constant time, so that the grid is kept up to date as the
+  world changes rather than rebuilt for every query. Queries only visit the cells overlapping the area they look at, and
+  nearest queries visit cells in rings around the point until no closer object can be found.
+ */
+class SpatialIndex
+{
+public:
+	struct Object
+	{
+		entt::entity entity;
+		glm::vec2 position;
+		script::ObjectType type;
+		int32_t subtype;
+		std::optional<PlayerNames> owner;
+		bool scripted;
+	};
+
+	/// Side of a cell in world units, 4 cells of the map grid
+	static constexpr float k_CellSize = 40.0f;
+	static constexpr uint32_t k_CellCount = 128;
+
+	SpatialIndex();
+
+	/// Add an object or replace the object of the same entity
+	void Set(const Object& object);
+	void Move(entt::entity entity, const glm::vec2& position);
+	void Remove(entt::entity entity);
+	void Clear();
+
+	[[nodiscard]] const Object* Find(entt::entity entity) const;
+	[[nodiscard]] size_t Size() const { return _objects.size(); }
+
+	[[nodiscard]] std::vector<entt::entity> FindInRadius(const glm::vec2& center, float radius,
+	                                                     const SpatialQueryFilter& filter) const;
+	/// Objects at a distance between the inner and outer radius of a point
+	[[nodiscard]] std::vector<entt::entity> FindInAnnulus(const glm::vec2& center, float innerRadius, float outerRadius,
+	                                                      const SpatialQueryFilter& filter) const;
+	[[nodiscard]] std::vector<entt::entity> FindInBox(const glm::vec2& min, const glm::vec2& max,
+	                                                  const SpatialQueryFilter& filter) const;
+	/// Up to count objects closest to a point with a distance between the min and max radius, closest first
+	[[nodiscard]] std::vector<entt::entity> FindNearest(const glm::vec2& center, size_t count, const SpatialQueryFilter& filter,
+	                                                    float minRadius = 0.0f,
+	                                                    float maxRadius = std::numeric_limits<float>::infinity()) const;
+
+private:
+	struct Location
+	{
+		uint32_t cell;
+		/// Position of the object in its cell
+		uint32_t slot;
+	};
+
+	[[nodiscard]] static uint32_t GetCell(const glm::vec2& position);
+	[[nodiscard]] static bool Matches(const Object& object, const SpatialQueryFilter& filter);
+
+	void AddToCell(uint32_t index, uint32_t cell);
+	void RemoveFromCell(uint32_t index);
+	/// Call a function with the index of every object in the cells overlapping a box
+	template <typename Func>
+	void VisitBox(const glm::vec2& min, const glm::vec2& max, Func func) const;
+
+	std::vector<Object> _objects;
+	std::vector<Location> _locations;
+	std::unordered_map<entt::entity, uint32_t> _indices;
+	std::vector<std::vector<uint32_t>> _cells;
+};
+
+} // namespace openblack::ecs
@@ -10,6 +10,7 @@
 #pragma once
 
 #include <chrono>
+#include <functional>
 #include <optional>
 #include <tuple>
 
@@ -45,6 +46,8 @@ namespace openblack::ecs::systems
 class DynamicsSystemInterface
 {
 public:
+	using DebugLineCallback = std::function<void(const glm::vec3& from, const glm::vec3& to, const glm::vec3& color)>;
+
 	virtual void Reset() = 0;
 	virtual void Update(std::chrono::microseconds& dt) = 0;
 	virtual void AddRigidBody(btRigidBody* object) = 0;
@@ -53,6 +56,8 @@ class DynamicsSystemInterface
 	virtual void UpdatePhysicsTransforms() = 0;
 	[[nodiscard]] virtual std::optional<std::pair<ecs::components::Transform, RigidBodyDetails>>
 	RayCastClosestHit(const glm::vec3& origin, const glm::vec3& direction, float tMax) const = 0;
+	/// Outline the shapes of the rigid bodies of entities, the terrain is left out as it covers the whole island
+	virtual void DebugDraw(const DebugLineCallback& drawLine) const = 0;
 };
 
 } // namespace openblack::ecs::systems
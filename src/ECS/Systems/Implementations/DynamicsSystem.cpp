@@ -11,6 +11,8 @@
 
 #include "DynamicsSystem.h"
 
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
 #include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
@@ -19,6 +21,7 @@
 #include <BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
 #include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolver.h>
 #include <BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
+#include <LinearMath/btIDebugDraw.h>
 #include <glm/gtx/quaternion.hpp>
 #include <glm/gtx/rotate_vector.hpp>
 
@@ -33,6 +36,39 @@ using namespace openblack;
 using namespace openblack::ecs::components;
 using namespace openblack::ecs::systems;
 
+namespace
+{
+/// Bullet's default step, the simulation always advances by whole steps of this duration
+constexpr float k_FixedTimeStep = 1.0f / 60.0f;
+
+/// Forwards the wireframe lines bullet draws for a shape
+class DebugDrawer final: public btIDebugDraw
+{
+public:
+	explicit DebugDrawer(const DynamicsSystemInterface::DebugLineCallback& drawLine)
+	    : _drawLine(drawLine)
+	{
+	}
+
+	void drawLine(const btVector3& from, const btVector3& to, const btVector3& color) override
+	{
+		_drawLine(glm::vec3(from.x(), from.y(), from.z()), glm::vec3(to.x(), to.y(), to.z()),
+		          glm::vec3(color.x(), color.y(), color.z()));
+	}
+	void drawContactPoint(const btVector3& /*pointOnB*/, const btVector3& /*normalOnB*/, btScalar /*distance*/,
+	                      int /*lifeTime*/, const btVector3& /*color*/) override
+	{
+	}
+	void reportErrorWarning(const char* /*warningString*/) override {}
+	void draw3dText(const btVector3& /*location*/, const char* /*textString*/) override {}
+	void setDebugMode(int /*debugMode*/) override {}
+	[[nodiscard]] int getDebugMode() const override { return DBG_DrawWireframe; }
+
+private:
+	const DynamicsSystemInterface::DebugLineCallback& _drawLine;
+};
+} // namespace
+
 DynamicsSystem::DynamicsSystem()
     : _configuration(std::make_unique<btDefaultCollisionConfiguration>())
     , _dispatcher(std::make_unique<btCollisionDispatcher>(_configuration.get()))
@@ -67,7 +103,9 @@ DynamicsSystem::~DynamicsSystem() = default;
 void DynamicsSystem::Update(std::chrono::microseconds& dt)
 {
 	std::chrono::duration<float> seconds = dt;
-	_world->stepSimulation(seconds.count());
+	// Bullet drops the time beyond maxSubSteps steps, allow as many as it takes to cover dt such as for whole turns
+	const auto maxSubSteps = std::max(static_cast<int>(std::ceil(seconds.count() / k_FixedTimeStep)), 1);
+	_world->stepSimulation(seconds.count(), maxSubSteps, k_FixedTimeStep);
 }
 
 void DynamicsSystem::AddRigidBody(btRigidBody* object)
@@ -148,3 +186,20 @@ DynamicsSystem::RayCastClosestHit(const glm::vec3& origin, const glm::vec3& dire
 	    RigidBodyDetails {static_cast<RigidBodyType>(callback.m_collisionObject->getUserIndex()),
 	                      callback.m_collisionObject->getUserIndex2(), callback.m_collisionObject->getUserPointer()}));
 }
+
+void DynamicsSystem::DebugDraw(const DebugLineCallback& drawLine) const
+{
+	DebugDrawer drawer(drawLine);
+	auto* previousDrawer = _world->getDebugDrawer();
+	_world->setDebugDrawer(&drawer);
+	for (int i = 0; i < _world->getNumCollisionObjects(); ++i)
+	{
+		const auto* obj = _world->getCollisionObjectArray()[i];
+		if (static_cast<RigidBodyType>(obj->getUserIndex()) == RigidBodyType::Terrain)
+		{
+			continue;
+		}
+		_world->debugDrawObject(obj->getWorldTransform(), obj->getCollisionShape(), btVector3(0.0f, 1.0f, 1.0f));
+	}
+	_world->setDebugDrawer(previousDrawer);
+}
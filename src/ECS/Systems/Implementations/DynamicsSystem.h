@@ -49,6 +49,7 @@ class DynamicsSystem final: public DynamicsSystemInterface
 	void UpdatePhysicsTransforms() override;
 	[[nodiscard]] std::optional<std::pair<ecs::components::Transform, RigidBodyDetails>>
 	RayCastClosestHit(const glm::vec3& origin, const glm::vec3& direction, float tMax) const override;
+	void DebugDraw(const DebugLineCallback& drawLine) const override;
 
 private:
 	/// collision configuration contains default setup for memory, collision setup
@@ -11,6 +11,12 @@
 
 #include "LivingActionSystem.h"
 
+#include <cassert>
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
 #include <spdlog/spdlog.h>
 
 #include "ECS/Components/LivingAction.h"
@@ -18,6 +24,7 @@
 #include "ECS/Registry.h"
 #include "Enums.h"
 #include "Locator.h"
+#include "Log.h"
 
 using namespace openblack;
 using namespace openblack::ecs::components;
@@ -25,7 +32,7 @@ using namespace openblack::ecs::systems;
 
 uint32_t VillagerInvalidState(LivingAction& action)
 {
-	SPDLOG_LOGGER_ERROR(spdlog::get("ai"), "Villager #{}: Stuck in an invalid state",
+	SPDLOG_LOGGER_ERROR(GetLogger(LoggingSubsystem::ai), "Villager #{}: Stuck in an invalid state",
 	                    static_cast<uint32_t>(Locator::entitiesRegistry::value().ToEntity(action)));
 	assert(false);
 	return 0;
@@ -45,76 +52,79 @@ uint32_t VillagerCreated(LivingAction& action)
 	return 0;
 }
 
+/// State functions are called for every villager every turn, so warnings about the missing ones are rate limited
+#define WARN_UNIMPLEMENTED(...) OPENBLACK_LOG_RATE_LIMITED(GetLogger(LoggingSubsystem::ai), spdlog::level::warn, __VA_ARGS__)
+
 struct VillagerStateTableEntry
 {
-	std::function<uint32_t(LivingAction&)> state = nullptr;
-	std::function<bool(LivingAction&, VillagerStates, VillagerStates)> entryState = nullptr;
-	std::function<bool(LivingAction&)> exitState = nullptr;
-	std::function<bool(LivingAction&)> saveState = nullptr;
-	std::function<bool(LivingAction&)> loadState = nullptr;
-	std::function<bool(LivingAction&)> field0x50 = nullptr;
-	std::function<bool(LivingAction&)> field0x60 = nullptr;
-	std::function<int(LivingAction&)> transitionAnimation = nullptr;
-	std::function<bool(LivingAction&)> validate = nullptr;
+	uint32_t (*state)(LivingAction&) = nullptr;
+	bool (*entryState)(LivingAction&, VillagerStates, VillagerStates) = nullptr;
+	bool (*exitState)(LivingAction&) = nullptr;
+	bool (*saveState)(LivingAction&) = nullptr;
+	bool (*loadState)(LivingAction&) = nullptr;
+	bool (*field0x50)(LivingAction&) = nullptr;
+	bool (*field0x60)(LivingAction&) = nullptr;
+	int (*transitionAnimation)(LivingAction&) = nullptr;
+	bool (*validate)(LivingAction&) = nullptr;
 };
 
 static const VillagerStateTableEntry k_TodoEntry = {
     .state = [](LivingAction& action) -> uint32_t {
-	    SPDLOG_LOGGER_WARN(spdlog::get("ai"), "Villager #{}: TODO: Unimplemented state function: {}",
+	    WARN_UNIMPLEMENTED("Villager #{}: TODO: Unimplemented state function: {}",
 	                       static_cast<uint32_t>(Locator::entitiesRegistry::value().ToEntity(action)),
 	                       k_VillagerStateStrings.at(static_cast<size_t>(
 	                           Locator::livingActionSystem::value().VillagerGetState(action, LivingAction::Index::Top))));
 	    return 0;
     },
     .entryState = [](LivingAction& action, VillagerStates src, VillagerStates dst) -> bool {
-	    SPDLOG_LOGGER_WARN(spdlog::get("ai"), "Villager #{}: TODO: Unimplemented entry state function ({} -> {})",
+	    WARN_UNIMPLEMENTED("Villager #{}: TODO: Unimplemented entry state function ({} -> {})",
 	                       static_cast<uint32_t>(Locator::entitiesRegistry::value().ToEntity(action)),
 	                       k_VillagerStateStrings.at(static_cast<size_t>(src)),
 	                       k_VillagerStateStrings.at(static_cast<size_t>(dst)));
 	    return false;
     },
     .exitState = [](LivingAction& action) -> bool {
-	    SPDLOG_LOGGER_WARN(spdlog::get("ai"), "Villager #{}: TODO: Unimplemented exit state function)",
+	    WARN_UNIMPLEMENTED("Villager #{}: TODO: Unimplemented exit state function)",
 	                       static_cast<uint32_t>(Locator::entitiesRegistry::value().ToEntity(action)));
 	    return false;
     },
     .saveState = [](LivingAction& action) -> bool {
-	    SPDLOG_LOGGER_WARN(spdlog::get("ai"), "Villager #{}: TODO: Unimplemented save state function: {}",
+	    WARN_UNIMPLEMENTED("Villager #{}: TODO: Unimplemented save state function: {}",
 	                       static_cast<uint32_t>(Locator::entitiesRegistry::value().ToEntity(action)),
 	                       k_VillagerStateStrings.at(static_cast<size_t>(
 	                           Locator::livingActionSystem::value().VillagerGetState(action, LivingAction::Index::Top))));
 	    return false;
     },
     .loadState = [](LivingAction& action) -> bool {
-	    SPDLOG_LOGGER_WARN(spdlog::get("ai"), "Villager #{}: TODO: Unimplemented load state function: {}",
+	    WARN_UNIMPLEMENTED("Villager #{}: TODO: Unimplemented load state function: {}",
 	                       static_cast<uint32_t>(Locator::entitiesRegistry::value().ToEntity(action)),
 	                       k_VillagerStateStrings.at(static_cast<size_t>(
 	                           Locator::livingActionSystem::value().VillagerGetState(action, LivingAction::Index::Top))));
 	    return false;
     },
     .field0x50 = [](LivingAction& action) -> bool {
-	    SPDLOG_LOGGER_WARN(spdlog::get("ai"), "Villager #{}: TODO: Unimplemented field0x50 state function: {}",
+	    WARN_UNIMPLEMENTED("Villager #{}: TODO: Unimplemented field0x50 state function: {}",
 	                       static_cast<uint32_t>(Locator::entitiesRegistry::value().ToEntity(action)),
 	                       k_VillagerStateStrings.at(static_cast<size_t>(
 	                           Locator::livingActionSystem::value().VillagerGetState(action, LivingAction::Index::Top))));
 	    return false;
     },
     .field0x60 = [](LivingAction& action) -> bool {
-	    SPDLOG_LOGGER_WARN(spdlog::get("ai"), "Villager #{}: TODO: Unimplemented field0x60 state function: {}",
+	    WARN_UNIMPLEMENTED("Villager #{}: TODO: Unimplemented field0x60 state function: {}",
 	                       static_cast<uint32_t>(Locator::entitiesRegistry::value().ToEntity(action)),
 	                       k_VillagerStateStrings.at(static_cast<size_t>(
 	                           Locator::livingActionSystem::value().VillagerGetState(action, LivingAction::Index::Top))));
 	    return false;
     },
     .transitionAnimation = [](LivingAction& action) -> int {
-	    SPDLOG_LOGGER_WARN(spdlog::get("ai"), "Villager #{}: TODO: Unimplemented transition animation function: {}",
+	    WARN_UNIMPLEMENTED("Villager #{}: TODO: Unimplemented transition animation function: {}",
 	                       static_cast<uint32_t>(Locator::entitiesRegistry::value().ToEntity(action)),
 	                       k_VillagerStateStrings.at(static_cast<size_t>(
 	                           Locator::livingActionSystem::value().VillagerGetState(action, LivingAction::Index::Top))));
 	    return -1;
     },
     .validate = [](LivingAction& action) -> bool {
-	    SPDLOG_LOGGER_WARN(spdlog::get("ai"), "Villager #{}: TODO: Unimplemented validate function: {}",
+	    WARN_UNIMPLEMENTED("Villager #{}: TODO: Unimplemented validate function: {}",
 	                       static_cast<uint32_t>(Locator::entitiesRegistry::value().ToEntity(action)),
 	                       k_VillagerStateStrings.at(static_cast<size_t>(
 	                           Locator::livingActionSystem::value().VillagerGetState(action, LivingAction::Index::Top))));
@@ -386,6 +396,99 @@ const static std::array<VillagerStateTableEntry, static_cast<size_t>(VillagerSta
     /* MOVE_SCAFFOLD_TO_BUILDING_SITE */ k_TodoEntry,
 };
 
+LivingActionSystem::LivingActionSystem()
+{
+	std::ranges::transform(k_VillagerStateTable, _stateFunctions.begin(),
+	                       [](const VillagerStateTableEntry& entry) { return entry.state; });
+}
+
+void LivingActionSystem::BatchVillagers(LivingAction::Index index)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+
+	_unsortedVillagers.clear();
+	_batchOffsets.fill(0);
+	registry.Each<const Villager, const LivingAction>(
+	    [this, index](entt::entity entity, [[maybe_unused]] const Villager& villager, const LivingAction& action) {
+		    const auto state = action.states[static_cast<size_t>(index)];
+		    assert(state < static_cast<size_t>(VillagerStates::_COUNT));
+		    _unsortedVillagers.push_back({static_cast<uint32_t>(_unsortedVillagers.size()), entity, state});
+		    ++_batchOffsets[state + 1];
+	    });
+	std::partial_sum(_batchOffsets.begin(), _batchOffsets.end(), _batchOffsets.begin());
+
+	// Registry order is kept within a state so queued state changes are already mostly sorted
+	auto cursors = _batchOffsets;
+	_batchedVillagers.resize(_unsortedVillagers.size());
+	for (const auto& villager : _unsortedVillagers)
+	{
+		_batchedVillagers[cursors[villager.state]++] = villager;
+	}
+}
+
+void LivingActionSystem::RunBatched(LivingAction::Index index, BatchedCall call)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	BatchVillagers(index);
+
+	// A callback only sees and modifies its own villager and any state change it requests is queued. This makes the result
+	// independent of the order in which states are visited, which is what allows grouping the calls by state.
+	_deferStateChanges = true;
+	for (size_t state = 0; state < k_VillagerStateTable.size(); ++state)
+	{
+		const auto& entry = k_VillagerStateTable[state];
+		const auto begin = _batchedVillagers.begin() + _batchOffsets[state];
+		const auto end = _batchedVillagers.begin() + _batchOffsets[state + 1];
+		switch (call)
+		{
+		case BatchedCall::Validate:
+			if (entry.validate != nullptr)
+			{
+				for (auto it = begin; it != end; ++it)
+				{
+					if (auto* action = registry.TryGet<LivingAction>(it->entity); action != nullptr)
+					{
+						_currentOrder = it->order;
+						entry.validate(*action);
+					}
+				}
+			}
+			break;
+		case BatchedCall::State:
+			if (const auto function = _stateFunctions[state]; function != nullptr)
+			{
+				for (auto it = begin; it != end; ++it)
+				{
+					if (auto* action = registry.TryGet<LivingAction>(it->entity); action != nullptr)
+					{
+						_currentOrder = it->order;
+						function(*action);
+					}
+				}
+			}
+			break;
+		}
+	}
+	_deferStateChanges = false;
+
+	ApplyPendingStateChanges();
+}
+
+void LivingActionSystem::ApplyPendingStateChanges()
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	std::stable_sort(_pendingStateChanges.begin(), _pendingStateChanges.end(),
+	                 [](const PendingStateChange& lhs, const PendingStateChange& rhs) { return lhs.order < rhs.order; });
+	for (const auto& change : _pendingStateChanges)
+	{
+		if (auto* action = registry.TryGet<LivingAction>(change.entity); action != nullptr)
+		{
+			ApplyStateChange(*action, change.index, change.state, change.skipTransition);
+		}
+	}
+	_pendingStateChanges.clear();
+}
+
 void LivingActionSystem::Update()
 {
 	auto& registry = Locator::entitiesRegistry::value();
@@ -394,64 +497,77 @@ void LivingActionSystem::Update()
 
 	// TODO(#475): process food speedup
 
-	registry.Each<const Villager, LivingAction>([this]([[maybe_unused]] const Villager& villager, LivingAction& action) {
-		VillagerCallValidate(action, LivingAction::Index::Top);
-	});
+	RunBatched(LivingAction::Index::Top, BatchedCall::Validate);
 	// TODO(#476): same call but for other types of living
 
-	registry.Each<const Villager, LivingAction>([this]([[maybe_unused]] const Villager& villager, LivingAction& action) {
-		VillagerCallValidate(action, LivingAction::Index::Final);
-	});
+	RunBatched(LivingAction::Index::Final, BatchedCall::Validate);
 	// TODO(#476): same call but for other types of living
 
-	// TODO(bwrsandman): Store result of this call in vector or with tag component
-	registry.Each<const Villager, LivingAction>([this]([[maybe_unused]] const Villager& villager, LivingAction& action) {
-		VillagerCallState(action, LivingAction::Index::Top);
-	});
+	// TODO(bwrsandman): Store result of state calls in vector or with tag component
+	RunBatched(LivingAction::Index::Top, BatchedCall::State);
 	// TODO(#476): same call but for other types of living
 }
 
 VillagerStates LivingActionSystem::VillagerGetState(const LivingAction& action, LivingAction::Index index) const
 {
-	return static_cast<VillagerStates>(action.states.at(static_cast<size_t>(index)));
+	return static_cast<VillagerStates>(action.states[static_cast<size_t>(index)]);
 }
 
 void LivingActionSystem::VillagerSetState(LivingAction& action, LivingAction::Index index, VillagerStates state,
+                                          bool skipTransition)
+{
+	if (_deferStateChanges)
+	{
+		const auto entity = Locator::entitiesRegistry::value().ToEntity(action);
+		_pendingStateChanges.push_back({_currentOrder, entity, index, state, skipTransition});
+		return;
+	}
+	ApplyStateChange(action, index, state, skipTransition);
+}
+
+void LivingActionSystem::ApplyStateChange(LivingAction& action, LivingAction::Index index, VillagerStates state,
                                           bool skipTransition) const
 {
-	const auto previousState = static_cast<VillagerStates>(action.states.at(static_cast<size_t>(index)));
-	if (previousState != state)
+	const auto previousState = static_cast<VillagerStates>(action.states[static_cast<size_t>(index)]);
+	if (previousState == state)
 	{
-		[[maybe_unused]] auto& registry = Locator::entitiesRegistry::value();
-		SPDLOG_LOGGER_TRACE(spdlog::get("ai"), "Villager #{}: Setting state {} -> {}",
-		                    static_cast<int>(registry.ToEntity(action)),
-		                    k_VillagerStateStrings.at(static_cast<size_t>(previousState)),
-		                    k_VillagerStateStrings.at(static_cast<size_t>(state)));
+		return;
+	}
 
-		if (index == LivingAction::Index::Top)
-		{
-			action.turnsSinceStateChange = 0;
-			if (skipTransition)
-			{
-				return;
-			}
+	[[maybe_unused]] auto& registry = Locator::entitiesRegistry::value();
+	SPDLOG_LOGGER_TRACE(GetLogger(LoggingSubsystem::ai), "Villager #{}: Setting state {} -> {}",
+	                    static_cast<int>(registry.ToEntity(action)),
+	                    k_VillagerStateStrings.at(static_cast<size_t>(previousState)),
+	                    k_VillagerStateStrings.at(static_cast<size_t>(state)));
 
-			if (VillagerCallExitState(action, index))
-			{
-				return;
-			}
+	const auto transition = index == LivingAction::Index::Top && !skipTransition;
+	if (index == LivingAction::Index::Top)
+	{
+		action.turnsSinceStateChange = 0;
+	}
+	if (transition && VillagerCallExitState(action, index))
+	{
+		return;
+	}
 
-			VillagerCallEntryState(action, index, previousState, state);
-		}
+	action.states[static_cast<size_t>(index)] = static_cast<uint8_t>(state);
+	if (_stateChangeCallback)
+	{
+		_stateChangeCallback(action, index, previousState, state);
+	}
+
+	if (transition)
+	{
+		VillagerCallEntryState(action, index, previousState, state);
 	}
 }
 
 uint32_t LivingActionSystem::VillagerCallState(LivingAction& action, LivingAction::Index index) const
 {
-	const auto state = action.states.at(static_cast<size_t>(index));
-	const auto& entry = k_VillagerStateTable.at(static_cast<size_t>(state));
-	const auto& callback = entry.state;
-	if (!callback)
+	const auto state = action.states[static_cast<size_t>(index)];
+	assert(state < _stateFunctions.size());
+	const auto callback = _stateFunctions[state];
+	if (callback == nullptr)
 	{
 		return 0;
 	}
@@ -461,8 +577,9 @@ uint32_t LivingActionSystem::VillagerCallState(LivingAction& action, LivingActio
 bool LivingActionSystem::VillagerCallEntryState(LivingAction& action, LivingAction::Index index, VillagerStates src,
                                                 VillagerStates dst) const
 {
-	const auto state = action.states.at(static_cast<size_t>(index));
-	const auto& entry = k_VillagerStateTable.at(static_cast<size_t>(state));
+	const auto state = action.states[static_cast<size_t>(index)];
+	assert(state < k_VillagerStateTable.size());
+	const auto& entry = k_VillagerStateTable[state];
 	const auto& callback = entry.entryState;
 	if (!callback)
 	{
@@ -473,8 +590,9 @@ bool LivingActionSystem::VillagerCallEntryState(LivingAction& action, LivingActi
 
 bool LivingActionSystem::VillagerCallExitState(LivingAction& action, LivingAction::Index index) const
 {
-	const auto& state = action.states.at(static_cast<size_t>(index));
-	const auto& entry = k_VillagerStateTable.at(static_cast<size_t>(state));
+	const auto state = action.states[static_cast<size_t>(index)];
+	assert(state < k_VillagerStateTable.size());
+	const auto& entry = k_VillagerStateTable[state];
 	const auto& callback = entry.exitState;
 	if (!callback)
 	{
@@ -485,8 +603,9 @@ bool LivingActionSystem::VillagerCallExitState(LivingAction& action, LivingActio
 
 int LivingActionSystem::VillagerCallOutOfAnimation(LivingAction& action, LivingAction::Index index) const
 {
-	const auto state = action.states.at(static_cast<size_t>(index));
-	const auto& entry = k_VillagerStateTable.at(static_cast<size_t>(state));
+	const auto state = action.states[static_cast<size_t>(index)];
+	assert(state < k_VillagerStateTable.size());
+	const auto& entry = k_VillagerStateTable[state];
 	const auto& callback = entry.transitionAnimation;
 	if (!callback)
 	{
@@ -497,8 +616,9 @@ int LivingActionSystem::VillagerCallOutOfAnimation(LivingAction& action, LivingA
 
 bool LivingActionSystem::VillagerCallValidate(LivingAction& action, LivingAction::Index index) const
 {
-	const auto state = action.states.at(static_cast<size_t>(index));
-	const auto& entry = k_VillagerStateTable.at(static_cast<size_t>(state));
+	const auto state = action.states[static_cast<size_t>(index)];
+	assert(state < k_VillagerStateTable.size());
+	const auto& entry = k_VillagerStateTable[state];
 	const auto& callback = entry.validate;
 	if (!callback)
 	{
@@ -506,3 +626,13 @@ bool LivingActionSystem::VillagerCallValidate(LivingAction& action, LivingAction
 	}
 	return callback(action);
 }
+
+void LivingActionSystem::SetStateChangeCallback(StateChangeCallback callback)
+{
+	_stateChangeCallback = std::move(callback);
+}
+
+void LivingActionSystem::SetStateFunction(VillagerStates state, StateFunction function)
+{
+	_stateFunctions.at(static_cast<size_t>(state)) = function;
+}
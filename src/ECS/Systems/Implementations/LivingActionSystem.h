@@ -9,6 +9,11 @@
 
 #pragma once
 
+#include <array>
+#include <vector>
+
+#include <entt/fwd.hpp>
+
 #include "ECS/Components/LivingAction.h"
 #include "ECS/Systems/LivingActionSystemInterface.h"
 
@@ -22,17 +27,68 @@ namespace openblack::ecs::systems
 class LivingActionSystem final: public LivingActionSystemInterface
 {
 public:
+	LivingActionSystem();
+
 	void Update() override;
 
 	[[nodiscard]] VillagerStates VillagerGetState(const components::LivingAction& action,
 	                                              components::LivingAction::Index index) const override;
+	/// While a batched pass is running, the change is queued and applied once every villager of the pass was handled.
+	/// Outside of a pass, such as from the debug GUI, there is no order to keep and it is applied right away.
 	void VillagerSetState(components::LivingAction& action, components::LivingAction::Index index, VillagerStates state,
-	                      bool skipTransition) const override;
+	                      bool skipTransition) override;
 	uint32_t VillagerCallState(components::LivingAction& action, components::LivingAction::Index index) const override;
 	bool VillagerCallEntryState(components::LivingAction& action, components::LivingAction::Index index, VillagerStates src,
 	                            VillagerStates dst) const override;
 	bool VillagerCallExitState(components::LivingAction& action, components::LivingAction::Index index) const override;
 	int VillagerCallOutOfAnimation(components::LivingAction& action, components::LivingAction::Index index) const override;
 	bool VillagerCallValidate(components::LivingAction& action, components::LivingAction::Index index) const override;
+	void SetStateChangeCallback(StateChangeCallback callback) override;
+	void SetStateFunction(VillagerStates state, StateFunction function) override;
+
+private:
+	/// Callback of the villager state table run by a batched pass
+	enum class BatchedCall : uint8_t
+	{
+		Validate,
+		State,
+	};
+
+	/// Villagers are kept by entity, callbacks may create or destroy entities which moves the components around
+	struct BatchedVillager
+	{
+		uint32_t order; ///< Position in the registry's iteration order
+		entt::entity entity;
+		uint8_t state; ///< State at the index being batched
+	};
+
+	struct PendingStateChange
+	{
+		uint32_t order;
+		entt::entity entity;
+		components::LivingAction::Index index;
+		VillagerStates state;
+		bool skipTransition;
+	};
+
+	/// Counting sort of all villagers by their state at index so that each state's villagers form a contiguous range
+	void BatchVillagers(components::LivingAction::Index index);
+	/// Call one state table callback for every villager, one state at a time
+	void RunBatched(components::LivingAction::Index index, BatchedCall call);
+	/// Apply queued state changes in the order the villagers would have requested them if processed one by one
+	void ApplyPendingStateChanges();
+	void ApplyStateChange(components::LivingAction& action, components::LivingAction::Index index, VillagerStates state,
+	                      bool skipTransition) const;
+
+	/// State functions of the state table unless replaced by SetStateFunction
+	std::array<StateFunction, static_cast<size_t>(VillagerStates::_COUNT)> _stateFunctions;
+	std::vector<BatchedVillager> _unsortedVillagers;
+	std::vector<BatchedVillager> _batchedVillagers;
+	/// Start of each state's range in _batchedVillagers, the last element is the total count
+	std::array<uint32_t, static_cast<size_t>(VillagerStates::_COUNT) + 1> _batchOffsets {};
+	std::vector<PendingStateChange> _pendingStateChanges;
+	StateChangeCallback _stateChangeCallback;
+	uint32_t _currentOrder {0};
+	bool _deferStateChanges {false};
 };
 } // namespace openblack::ecs::systems
@@ -11,6 +11,7 @@
 
 #include "PathfindingSystem.h"
 
+#include <algorithm>
 #include <optional>
 
 #include <entt/entity/entity.hpp>
@@ -26,6 +27,7 @@
 #include "ECS/Components/WallHug.h"
 #include "ECS/Map.h"
 #include "ECS/Registry.h"
+#include "ECS/RoutePlanner.h"
 #include "Locator.h"
 
 using namespace openblack;
@@ -376,10 +378,79 @@ void ApplyStepGoal(ecs::Registry& registry, Exclude... exclude)
 
 } // namespace
 
+void PathfindingSystem::UpdateRoutePlanner()
+{
+	const auto mapVersion = Locator::entitiesMap::value().GetFixedVersion();
+	if (mapVersion != _mapVersion)
+	{
+		_routePlanner.Invalidate();
+		_mapVersion = mapVersion;
+	}
+}
+
+void PathfindingSystem::Reset()
+{
+	// The fixed entities may hash the same while the footpaths and streams the graph is built from changed
+	_routePlanner.Invalidate();
+	_mapVersion = Locator::entitiesMap::value().GetFixedVersion();
+}
+
+void PathfindingSystem::MoveTo(entt::entity entity, const glm::vec2& destination)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+
+	UpdateRoutePlanner();
+	if (!_routePlanner.IsBuilt())
+	{
+		_routePlanner.Build(registry);
+	}
+
+	const auto position = glm::xz(registry.Get<const Transform>(entity).position);
+	auto& wallHug = registry.Get<WallHug>(entity);
+	registry.Remove<MoveStateLinearTag, MoveStateOrbitTag, MoveStateExitCircleTag, MoveStateStepThroughTag,
+	                MoveStateFinalStepTag, MoveStateArrivedTag, WallHugObjectReference, WallHugRoute>(entity);
+	wallHug.goal = destination;
+	wallHug.step = glm::vec2(0.0f);
+
+	const auto route = _routePlanner.FindRoute(position, destination);
+	if (route != nullptr && !route->waypoints.empty())
+	{
+		// The route may have been planned for another mobile of the region, join it at the closest waypoint
+		const auto closest = std::ranges::min_element(route->waypoints, {}, [&position](const glm::vec2& waypoint) {
+			return glm::distance2(position, waypoint);
+		});
+		const auto waypoint = static_cast<uint16_t>(std::distance(route->waypoints.cbegin(), closest));
+		registry.Assign<WallHugRoute>(entity, route, waypoint, destination);
+		wallHug.goal = *closest;
+	}
+	registry.Assign<MoveStateLinearTag>(entity);
+}
+
 void PathfindingSystem::Update()
 {
 	auto& registry = Locator::entitiesRegistry::value();
 
+	UpdateRoutePlanner();
+
+	// 0.  Mobiles following a route head to the next waypoint once they reached the current one, and to their destination
+	//     after the last one
+	registry.Each<WallHugRoute, WallHug, const MoveStateFinalStepTag>(
+	    [&registry](entt::entity entity, WallHugRoute& route, WallHug& wallHug, const MoveStateFinalStepTag& state) {
+		    ++route.waypoint;
+		    if (route.waypoint < route.route->waypoints.size())
+		    {
+			    wallHug.goal = route.route->waypoints[route.waypoint];
+		    }
+		    else
+		    {
+			    wallHug.goal = route.destination;
+			    registry.Remove<WallHugRoute>(entity);
+		    }
+		    wallHug.step = glm::vec2(0.0f);
+		    registry.Remove<WallHugObjectReference>(entity);
+		    registry.SwapComponents<MoveStateLinearTag>(entity, state);
+	    });
+
 	// 1.  ARRIVED:
 	//         If AreWeThere is false, set to STEP_THROUGH (and it will trigger following steps)
 	registry.Each<const MoveStateArrivedTag, const Transform, const WallHug>(
@@ -9,6 +9,9 @@
 
 #pragma once
 
+#include <cstdint>
+
+#include "ECS/RoutePlanner.h"
 #include "ECS/Systems/PathfindingSystemInterface.h"
 
 #if !defined(LOCATOR_IMPLEMENTATIONS)
@@ -21,5 +24,16 @@ class PathfindingSystem final: public PathfindingSystemInterface
 {
 public:
 	void Update() override;
+	void MoveTo(entt::entity entity, const glm::vec2& destination) override;
+	void Reset() override;
+	[[nodiscard]] const RoutePlanner& GetRoutePlanner() const override { return _routePlanner; }
+
+private:
+	/// Drop the routes planned around fixed entities which changed, and build the graph again if needed
+	void UpdateRoutePlanner();
+
+	RoutePlanner _routePlanner;
+	/// Version of the fixed entities of the map the route planner was built with
+	uint32_t _mapVersion {0};
 };
 } // namespace openblack::ecs::systems
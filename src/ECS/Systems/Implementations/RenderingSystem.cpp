@@ -14,6 +14,7 @@
 #include <glm/gtx/transform.hpp>
 
 #include "3D/L3DMesh.h"
+#include "Common/JobSystem.h"
 #include "ECS/Components/Mesh.h"
 #include "ECS/Components/MorphWithTerrain.h"
 #include "ECS/Components/Stream.h"
@@ -36,18 +37,22 @@ void RenderingSystem::PrepareDrawDescs(bool drawBoundingBox)
 
 	// Count number of instances
 	uint32_t instanceCount = 0;
-	std::unordered_map<entt::id_type, std::pair<uint32_t, bool>> meshIds;
+	std::map<RenderContext::InstancedDrawKey, std::pair<uint32_t, bool>> meshIds;
 
-	auto prep = [&meshIds, &instanceCount](const Mesh& mesh, bool morphWithTerrain) {
-		auto count = meshIds.insert(std::make_pair(mesh.id, std::make_pair(mesh.submeshId, morphWithTerrain)));
+	auto prep = [this, &meshIds, &instanceCount](Mesh& mesh, const Transform& transform, bool morphWithTerrain) {
+		mesh.lod = SelectLevelOfDetail(mesh, transform);
+		auto count = meshIds.insert(std::make_pair(RenderContext::InstancedDrawKey {mesh.id, mesh.lod},
+		                                           std::make_pair(0u, morphWithTerrain)));
 		count.first->second.first++;
 		instanceCount++;
 	};
 
-	registry.Each<const Mesh, const Transform>([&prep](const Mesh& mesh, const Transform& /*unused*/) { prep(mesh, false); },
-	                                           entt::exclude<MorphWithTerrain, TempleInteriorPart>);
-	registry.Each<const Mesh, const Transform, const MorphWithTerrain>(
-	    [&prep](const Mesh& mesh, const Transform& /*unused*/, const MorphWithTerrain& /*unused*/) { prep(mesh, true); });
+	registry.Each<Mesh, const Transform>([&prep](Mesh& mesh, const Transform& transform) { prep(mesh, transform, false); },
+	                                     entt::exclude<MorphWithTerrain, TempleInteriorPart>);
+	registry.Each<Mesh, const Transform, const MorphWithTerrain>(
+	    [&prep](Mesh& mesh, const Transform& transform, const MorphWithTerrain& /*unused*/) {
+		    prep(mesh, transform, true);
+	    });
 
 	if (drawBoundingBox)
 	{
@@ -75,9 +80,9 @@ void RenderingSystem::PrepareDrawDescs(bool drawBoundingBox)
 	// Determine uniform buffer offsets and instance count for draw
 	uint32_t offset = 0;
 	_renderContext.instancedDrawDescs.clear();
-	for (const auto& [meshId, desc] : meshIds)
+	for (const auto& [key, desc] : meshIds)
 	{
-		_renderContext.instancedDrawDescs.emplace(std::piecewise_construct, std::forward_as_tuple(meshId),
+		_renderContext.instancedDrawDescs.emplace(std::piecewise_construct, std::forward_as_tuple(key),
 		                                          std::forward_as_tuple(offset, desc.first, desc.second));
 		offset += desc.first;
 	}
@@ -88,31 +93,58 @@ void RenderingSystem::PrepareDrawUploadUniforms(bool drawBoundingBox)
 	auto& registry = Locator::entitiesRegistry::value();
 
 	// Store offsets of uniforms for descs
-	std::map<entt::id_type, uint32_t> uniformOffsets;
+	std::map<RenderContext::InstancedDrawKey, uint32_t> uniformOffsets;
+	// Bounding boxes of the meshes, looked up once per mesh rather than once per instance
+	std::map<entt::id_type, glm::mat4> boxes;
 
-	// Set transforms for instanced draw at offsets
+	// Give every instance its place in the uniforms, which depends on the order of the registry
+	_instanceSlots.clear();
 	registry.Each<const Mesh, const Transform>(
-	    [this, &uniformOffsets, drawBoundingBox](const Mesh& mesh, const Transform& transform) {
-		    auto offset = uniformOffsets.insert(std::make_pair(mesh.id, 0));
-		    auto desc = _renderContext.instancedDrawDescs.find(mesh.id);
-
-		    auto modelMatrix = glm::mat4(transform.rotation);
-		    modelMatrix = glm::translate(modelMatrix, transform.position * transform.rotation);
-		    modelMatrix = glm::scale(modelMatrix, transform.scale);
+	    [this, &uniformOffsets, &boxes, drawBoundingBox](const Mesh& mesh, const Transform& transform) {
+		    const RenderContext::InstancedDrawKey key {mesh.id, mesh.lod};
+		    auto offset = uniformOffsets.insert(std::make_pair(key, 0));
+		    auto desc = _renderContext.instancedDrawDescs.find(key);
 
-		    const uint32_t idx = desc->second.offset + offset.first->second;
-		    _renderContext.instanceUniforms[idx] = modelMatrix;
+		    const glm::mat4* box = nullptr;
 		    if (drawBoundingBox)
 		    {
-			    auto l3dMesh = entt::locator<resources::ResourcesInterface>::value().GetMeshes().Handle(mesh.id);
-			    auto box = l3dMesh->GetBoundingBox();
-			    auto boxMatrix = modelMatrix * glm::translate(box.Center()) * glm::scale(box.Size());
-			    _renderContext.instanceUniforms[idx + _renderContext.instanceUniforms.size() / 2] = boxMatrix;
+			    auto [it, inserted] = boxes.try_emplace(mesh.id);
+			    if (inserted)
+			    {
+				    auto l3dMesh = entt::locator<resources::ResourcesInterface>::value().GetMeshes().Handle(mesh.id);
+				    auto boundingBox = l3dMesh->GetBoundingBox();
+				    it->second = glm::translate(boundingBox.Center()) * glm::scale(boundingBox.Size());
+			    }
+			    box = &it->second;
 		    }
+
+		    _instanceSlots.push_back({&transform, box, desc->second.offset + offset.first->second});
 		    offset.first->second++;
 	    },
 	    entt::exclude<TempleInteriorPart>);
 
+	// Set transforms for instanced draw at offsets
+	const auto boxOffset = _renderContext.instanceUniforms.size() / 2;
+	Locator::jobs::value().ParallelFor(
+	    "RenderingSystem::PrepareDrawUploadUniforms", _instanceSlots.size(), 256,
+	    [this, boxOffset](size_t begin, size_t end) {
+		    for (size_t i = begin; i < end; ++i)
+		    {
+			    const auto& slot = _instanceSlots[i];
+			    const auto& transform = *slot.transform;
+
+			    auto modelMatrix = glm::mat4(transform.rotation);
+			    modelMatrix = glm::translate(modelMatrix, transform.position * transform.rotation);
+			    modelMatrix = glm::scale(modelMatrix, transform.scale);
+
+			    _renderContext.instanceUniforms[slot.index] = modelMatrix;
+			    if (slot.box != nullptr)
+			    {
+				    _renderContext.instanceUniforms[slot.index + boxOffset] = modelMatrix * *slot.box;
+			    }
+		    }
+	    });
+
 	if (!_renderContext.instanceUniforms.empty())
 	{
 		const auto size = static_cast<uint32_t>(_renderContext.instanceUniforms.size() * sizeof(glm::mat4));
@@ -31,7 +31,19 @@ class RenderingSystem final: public RenderingSystemCommon
 	~RenderingSystem();
 
 private:
+	/// An instance whose uniforms are written by a job, at index and past half of the uniforms for its bounding box
+	struct InstanceSlot
+	{
+		const components::Transform* transform;
+		/// Bounding box of the mesh in model space, null when bounding boxes are not drawn
+		const glm::mat4* box;
+		uint32_t index;
+	};
+
 	void PrepareDrawDescs(bool drawBoundingBox) override;
 	void PrepareDrawUploadUniforms(bool drawBoundingBox) override;
+
+	/// Kept between frames to avoid reallocating it
+	std::vector<InstanceSlot> _instanceSlots;
 };
 } // namespace openblack::ecs::systems
@@ -11,15 +11,21 @@
 
 #include "RenderingSystemCommon.h"
 
+#include <glm/gtx/norm.hpp>
 #include <glm/gtx/transform.hpp>
 
 #include "3D/L3DMesh.h"
+#include "Camera/Camera.h"
 #include "ECS/Components/Mesh.h"
 #include "ECS/Components/MorphWithTerrain.h"
 #include "ECS/Components/Stream.h"
 #include "ECS/Components/Temple.h"
 #include "ECS/Components/Transform.h"
+#include "ECS/Components/WallHug.h"
 #include "ECS/Registry.h"
+#include "ECS/RoutePlanner.h"
+#include "ECS/Systems/DynamicsSystemInterface.h"
+#include "EngineConfig.h"
 #include "Graphics/DebugLines.h"
 #include "Graphics/ShaderManager.h"
 #include "Locator.h"
@@ -42,6 +48,73 @@ RenderContext::~RenderContext()
 	}
 }
 
+float RenderContext::GetScreenSize(float radius, float distance, float projectionScale)
+{
+	return distance > radius ? radius * projectionScale / distance : 1.0f;
+}
+
+uint8_t RenderContext::SelectLevelOfDetail(float screenSize, uint8_t current, uint8_t lodMask,
+                                           std::span<const float, k_LevelsOfDetail - 1> thresholds, float hysteresis)
+{
+	uint8_t lod = 0;
+	while (lod < thresholds.size() && screenSize < thresholds[lod])
+	{
+		++lod;
+	}
+
+	// Only move away from the current level of detail once the size is clear of the hysteresis band
+	current = std::min<uint8_t>(current, static_cast<uint8_t>(thresholds.size()));
+	while (lod > current && screenSize >= thresholds[lod - 1] * (1.0f - hysteresis))
+	{
+		--lod;
+	}
+	while (lod < current && screenSize <= thresholds[lod] * (1.0f + hysteresis))
+	{
+		++lod;
+	}
+
+	return GetClosestLevelOfDetail(lod, lodMask);
+}
+
+uint8_t RenderContext::GetClosestLevelOfDetail(uint8_t lod, uint8_t lodMask)
+{
+	for (int i = lod; i >= 0; --i)
+	{
+		if ((lodMask & (1 << i)) != 0)
+		{
+			return static_cast<uint8_t>(i);
+		}
+	}
+	for (int i = lod + 1; i < k_LevelsOfDetail; ++i)
+	{
+		if ((lodMask & (1 << i)) != 0)
+		{
+			return static_cast<uint8_t>(i);
+		}
+	}
+	return 0;
+}
+
+template <DebugLayer Layer>
+void RenderingSystemCommon::InvalidateDebugLayer([[maybe_unused]] entt::registry& registry,
+                                                 [[maybe_unused]] entt::entity entity)
+{
+	_renderContext.debugLayers.at(static_cast<size_t>(Layer)).Invalidate();
+}
+
+RenderingSystemCommon::RenderingSystemCommon()
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	constexpr auto k_InvalidateFootpaths = &RenderingSystemCommon::InvalidateDebugLayer<DebugLayer::Footpaths>;
+	constexpr auto k_InvalidateStreams = &RenderingSystemCommon::InvalidateDebugLayer<DebugLayer::Streams>;
+	_debugLayerConnections.emplace_back(registry.OnConstruct<Footpath>().connect<k_InvalidateFootpaths>(*this));
+	_debugLayerConnections.emplace_back(registry.OnUpdate<Footpath>().connect<k_InvalidateFootpaths>(*this));
+	_debugLayerConnections.emplace_back(registry.OnDestroy<Footpath>().connect<k_InvalidateFootpaths>(*this));
+	_debugLayerConnections.emplace_back(registry.OnConstruct<Stream>().connect<k_InvalidateStreams>(*this));
+	_debugLayerConnections.emplace_back(registry.OnUpdate<Stream>().connect<k_InvalidateStreams>(*this));
+	_debugLayerConnections.emplace_back(registry.OnDestroy<Stream>().connect<k_InvalidateStreams>(*this));
+}
+
 RenderingSystemCommon::~RenderingSystemCommon() = default;
 
 void RenderingSystemCommon::SetDirty()
@@ -49,79 +122,154 @@ void RenderingSystemCommon::SetDirty()
 	_renderContext.dirty = true;
 }
 
-void RenderingSystemCommon::PrepareDraw(bool drawBoundingBox, bool drawFootpaths, bool drawStreams)
+uint8_t RenderingSystemCommon::SelectLevelOfDetail(const Mesh& mesh, const Transform& transform)
 {
-	auto& registry = Locator::entitiesRegistry::value();
+	const auto& config = Locator::config::value();
 
-	if (_renderContext.dirty || _renderContext.hasBoundingBoxes != drawBoundingBox ||
-	    (_renderContext.footpaths != nullptr) != drawFootpaths || (_renderContext.streams != nullptr) != drawStreams)
+	auto info = _levelOfDetailInfos.find(mesh.id);
+	if (info == _levelOfDetailInfos.end())
 	{
-		PrepareDrawDescs(drawBoundingBox);
-		PrepareDrawUploadUniforms(drawBoundingBox);
+		auto l3dMesh = Locator::resources::value().GetMeshes().Handle(mesh.id);
+		const auto box = l3dMesh->GetBoundingBox();
+		info = _levelOfDetailInfos.emplace(mesh.id, LevelOfDetailInfo {box.Center(), glm::length(box.Size()) * 0.5f,
+		                                                                l3dMesh->GetLodMask()})
+		           .first;
+	}
+	const auto& [center, radius, lodMask] = info->second;
 
-		_renderContext.boundingBox.reset();
-		if (drawBoundingBox)
-		{
-			_renderContext.boundingBox = graphics::DebugLines::CreateBox(glm::vec4(1.0f, 0.0f, 0.0f, 0.5f));
-		}
+	if (!config.useLevelsOfDetail)
+	{
+		return RenderContext::GetClosestLevelOfDetail(0, lodMask);
+	}
 
-		_renderContext.footpaths.reset();
-		if (drawFootpaths)
-		{
-			uint32_t nodeCount = 0;
-			registry.Each<const Footpath>(
-			    [&nodeCount](const Footpath& ent) { nodeCount += 2 * std::max(static_cast<int>(ent.nodes.size()) - 1, 0); });
-
-			std::vector<graphics::DebugLines::Vertex> edges;
-			edges.reserve(nodeCount);
-			registry.Each<const Footpath>([&edges](const Footpath& ent) {
-				const auto color = glm::vec4(0, 1, 0, 1);
-				const auto offset = glm::vec3(0, 1, 0);
-				for (int i = 0; i < static_cast<int>(ent.nodes.size()) - 1; ++i)
-				{
-					edges.push_back({glm::vec4(ent.nodes[i].position + offset, 1.0f), color});
-					edges.push_back({glm::vec4(ent.nodes[i + 1].position + offset, 1.0f), color});
-				}
-			});
-			if (!edges.empty())
+	const auto scale = glm::max(transform.scale.x, glm::max(transform.scale.y, transform.scale.z));
+	const auto worldCenter = transform.position + transform.rotation * (center * transform.scale);
+	const auto distance = glm::distance(worldCenter, _levelOfDetailOrigin);
+	const auto screenSize = RenderContext::GetScreenSize(radius * scale, distance, _levelOfDetailProjectionScale);
+	return RenderContext::SelectLevelOfDetail(screenSize, mesh.lod, lodMask, config.lodScreenSizeThresholds,
+	                                          config.lodHysteresis);
+}
+
+void RenderingSystemCommon::PrepareDraw(const DebugDrawFlags& debug)
+{
+	const auto& camera = Locator::camera::value();
+
+	// Levels of detail depend on the point of view, reselect them when the camera has moved or zoomed noticeably
+	const auto origin = camera.GetOrigin();
+	const auto projectionScale = camera.GetProjectionMatrix()[1][1];
+	const auto useLevelsOfDetail = Locator::config::value().useLevelsOfDetail;
+	if (useLevelsOfDetail != _levelsOfDetailEnabled ||
+	    (useLevelsOfDetail && (glm::distance2(origin, _levelOfDetailOrigin) > 1.0f ||
+	                           glm::abs(projectionScale - _levelOfDetailProjectionScale) > 0.01f * glm::abs(projectionScale))))
+	{
+		_levelOfDetailOrigin = origin;
+		_levelOfDetailProjectionScale = projectionScale;
+		_levelsOfDetailEnabled = useLevelsOfDetail;
+		_renderContext.dirty = true;
+	}
+
+	if (_renderContext.dirty || _renderContext.hasBoundingBoxes != debug.boundingBoxes)
+	{
+		PrepareDrawDescs(debug.boundingBoxes);
+		PrepareDrawUploadUniforms(debug.boundingBoxes);
+
+		_renderContext.dirty = false;
+		_renderContext.hasBoundingBoxes = debug.boundingBoxes;
+	}
+
+	// The box is the same for all instances, only their transforms in the instance uniforms change
+	if (debug.boundingBoxes && !_renderContext.boundingBox)
+	{
+		_renderContext.boundingBox = graphics::DebugLines::CreateBox(glm::vec4(1.0f, 0.0f, 0.0f, 0.5f));
+	}
+
+	PrepareDebugLayers(debug);
+}
+
+void RenderingSystemCommon::PrepareDebugLayers(const DebugDrawFlags& debug)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+
+	auto& footpaths = _renderContext.debugLayers.at(static_cast<size_t>(DebugLayer::Footpaths));
+	if (!debug.footpaths)
+	{
+		footpaths.Reset();
+	}
+	else if (!footpaths.IsValid())
+	{
+		_debugLayerVertices.clear();
+		registry.Each<const Footpath>([this](const Footpath& ent) {
+			const auto color = glm::vec4(0, 1, 0, 1);
+			const auto offset = glm::vec3(0, 1, 0);
+			for (int i = 0; i < static_cast<int>(ent.nodes.size()) - 1; ++i)
 			{
-				_renderContext.footpaths =
-				    graphics::DebugLines::CreateDebugLines(edges.data(), static_cast<uint32_t>(edges.size()));
+				_debugLayerVertices.push_back({glm::vec4(ent.nodes[i].position + offset, 1.0f), color});
+				_debugLayerVertices.push_back({glm::vec4(ent.nodes[i + 1].position + offset, 1.0f), color});
 			}
-		}
+		});
+		footpaths.Upload(_debugLayerVertices);
+	}
 
-		_renderContext.streams.reset();
-		if (drawStreams)
-		{
-			uint32_t edgeCount = 0;
-			registry.Each<const Stream>([&edgeCount](const Stream& ent) {
-				for (const auto& from : ent.nodes)
-				{
-					edgeCount += static_cast<uint32_t>(from.edges.size());
-				}
-			});
-			std::vector<graphics::DebugLines::Vertex> edges;
-			edges.reserve(edgeCount * 2);
-			registry.Each<const Stream>([&edges](const Stream& ent) {
-				const auto color = glm::vec4(1, 0, 0, 1);
-				for (const auto& from : ent.nodes)
+	auto& streams = _renderContext.debugLayers.at(static_cast<size_t>(DebugLayer::Streams));
+	if (!debug.streams)
+	{
+		streams.Reset();
+	}
+	else if (!streams.IsValid())
+	{
+		_debugLayerVertices.clear();
+		registry.Each<const Stream>([this](const Stream& ent) {
+			const auto color = glm::vec4(1, 0, 0, 1);
+			for (const auto& from : ent.nodes)
+			{
+				for (const auto& to : from.edges)
 				{
-					for (const auto& to : from.edges)
-					{
-						edges.push_back({glm::vec4(from.position, 1.0f), color});
-						edges.push_back({glm::vec4(to.position, 1.0f), color});
-					}
+					_debugLayerVertices.push_back({glm::vec4(from.position, 1.0f), color});
+					_debugLayerVertices.push_back({glm::vec4(to.position, 1.0f), color});
 				}
-			});
-
-			if (!edges.empty())
-			{
-				_renderContext.streams =
-				    graphics::DebugLines::CreateDebugLines(edges.data(), static_cast<uint32_t>(edges.size()));
 			}
-		}
+		});
+		streams.Upload(_debugLayerVertices);
+	}
 
-		_renderContext.dirty = false;
-		_renderContext.hasBoundingBoxes = drawBoundingBox;
+	// Mobiles and rigid bodies move all the time, their lines are rebuilt for every frame in a transient buffer
+	auto& lines = _renderContext.transientDebugLines;
+	lines.clear();
+	const auto addLine = [&lines](const glm::vec3& from, const glm::vec3& to, const glm::vec4& color) {
+		lines.push_back({glm::vec4(from, 1.0f), color});
+		lines.push_back({glm::vec4(to, 1.0f), color});
+	};
+
+	if (debug.wallHug)
+	{
+		registry.Each<const Transform, const WallHug>(
+		    [&registry, &addLine](entt::entity entity, const Transform& transform, const WallHug& wallHug) {
+			    const auto offset = glm::vec3(0, 1, 0);
+			    auto from = transform.position + offset;
+			    const auto toGoal = glm::vec3(wallHug.goal.x, from.y, wallHug.goal.y);
+			    addLine(from, toGoal, glm::vec4(1, 1, 0, 1));
+
+			    // Remaining waypoints of a route over the footpaths
+			    if (const auto* route = registry.TryGet<WallHugRoute>(entity); route != nullptr && route->route)
+			    {
+				    from = toGoal;
+				    const auto& waypoints = route->route->waypoints;
+				    for (auto i = static_cast<size_t>(route->waypoint) + 1; i < waypoints.size(); ++i)
+				    {
+					    const auto to = glm::vec3(waypoints[i].x, from.y, waypoints[i].y);
+					    addLine(from, to, glm::vec4(1, 0, 1, 1));
+					    from = to;
+				    }
+				    addLine(from, glm::vec3(route->destination.x, from.y, route->destination.y), glm::vec4(1, 0, 1, 1));
+			    }
+		    });
+	}
+
+	if (debug.physics && Locator::dynamicsSystem::has_value())
+	{
+		Locator::dynamicsSystem::value().DebugDraw(
+		    [&addLine](const glm::vec3& from, const glm::vec3& to, const glm::vec3& color) {
+			    addLine(from, to, glm::vec4(color, 1.0f));
+		    });
 	}
 }
@@ -10,9 +10,11 @@
 #pragma once
 
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 #include <bgfx/bgfx.h>
+#include <entt/signal/sigh.hpp>
 #include <glm/mat4x4.hpp>
 
 #include "3D/AllMeshes.h"
@@ -22,22 +24,56 @@
 #error "Locator interface implementations should only be included in Locator.cpp, use interface instead."
 #endif
 
+namespace openblack::ecs::components
+{
+struct Mesh;
+struct Transform;
+} // namespace openblack::ecs::components
+
 namespace openblack::ecs::systems
 {
 
 class RenderingSystemCommon: public RenderingSystemInterface
 {
 public:
+	RenderingSystemCommon();
 	~RenderingSystemCommon();
 	void SetDirty() override;
-	void PrepareDraw(bool drawBoundingBox, bool drawFootpaths, bool drawStreams) override;
+	void PrepareDraw(const DebugDrawFlags& debug) override;
 	const RenderContext& GetContext() override { return _renderContext; }
 
 private:
 	virtual void PrepareDrawDescs(bool drawBoundingBox) = 0;
 	virtual void PrepareDrawUploadUniforms(bool drawBoundingBox) = 0;
 
+	/// Rebuild the debug layers which were invalidated and refill the transient debug lines
+	void PrepareDebugLayers(const DebugDrawFlags& debug);
+	template <DebugLayer Layer>
+	void InvalidateDebugLayer(entt::registry& registry, entt::entity entity);
+
+	/// Invalidate the debug layers when the components they show are assigned, patched or removed
+	std::vector<entt::scoped_connection> _debugLayerConnections;
+	/// Reused to build the vertices of debug layers
+	std::vector<graphics::DebugLines::Vertex> _debugLayerVertices;
+
+	/// Bounding sphere and available levels of detail of an L3D mesh, cached to avoid a resource lookup per instance
+	struct LevelOfDetailInfo
+	{
+		glm::vec3 center;
+		float radius;
+		uint8_t lodMask;
+	};
+
+	std::unordered_map<entt::id_type, LevelOfDetailInfo> _levelOfDetailInfos;
+	glm::vec3 _levelOfDetailOrigin {0.0f};
+	float _levelOfDetailProjectionScale {0.0f};
+	bool _levelsOfDetailEnabled {false};
+
 protected:
+	/// Pick the level of detail of an instance from the fraction of the screen its bounding sphere covers,
+	/// see \ref RenderContext::SelectLevelOfDetail
+	[[nodiscard]] uint8_t SelectLevelOfDetail(const components::Mesh& mesh, const components::Transform& transform);
+
 	RenderContext _renderContext;
 };
 } // namespace openblack::ecs::systems
@@ -14,7 +14,7 @@
 #include <glm/gtx/transform.hpp>
 
 #include "3D/L3DMesh.h"
-#include "Camera/Camera.h"
+#include "3D/TempleInteriorInterface.h"
 #include "ECS/Components/Mesh.h"
 #include "ECS/Components/Stream.h"
 #include "ECS/Components/Temple.h"
@@ -33,35 +33,24 @@ RenderingSystemTemple::~RenderingSystemTemple() = default;
 void RenderingSystemTemple::PrepareDrawDescs(bool drawBoundingBox)
 {
 	auto& registry = Locator::entitiesRegistry::value();
-	auto& camera = Locator::camera::value();
+	const auto& temple = Locator::temple::value();
 
 	// Count number of instances
 	uint32_t instanceCount = 0;
-	std::unordered_map<entt::id_type, std::pair<uint32_t, bool>> meshIds;
-	std::set<TempleRoom> loadedRooms {TempleRoom::MainRoom};
-	auto roomLoaded = [&loadedRooms, &camera](const Mesh& mesh, const Transform& transform,
-	                                          const TempleInteriorPart& templePart) {
-		auto l3dMesh = entt::locator<resources::ResourcesInterface>::value().GetMeshes().Handle(mesh.id);
-		auto box = l3dMesh->GetBoundingBox();
-		auto cameraInsideRoom = box.Contains(camera.GetOrigin() - transform.position);
-		if (cameraInsideRoom)
-		{
-			loadedRooms.emplace(templePart.room);
-		}
-	};
-	registry.Each<const Mesh, const Transform, const TempleInteriorPart>(roomLoaded);
-	_loadedRooms = loadedRooms;
+	// Temple interiors are always seen from up close and are drawn at their highest level of detail
+	std::map<RenderContext::InstancedDrawKey, std::pair<uint32_t, bool>> meshIds;
 
 	auto prep = [&meshIds, &instanceCount](const Mesh& mesh, bool morphWithTerrain) {
-		auto count = meshIds.insert(std::make_pair(mesh.id, std::make_pair(mesh.submeshId, morphWithTerrain)));
+		auto count = meshIds.insert(
+		    std::make_pair(RenderContext::InstancedDrawKey {mesh.id, 0}, std::make_pair(0u, morphWithTerrain)));
 		count.first->second.first++;
 		instanceCount++;
 	};
 
+	// Parts only exist for loaded rooms, the temple decides which of those are seen from the camera
 	registry.Each<const Mesh, const Transform, const TempleInteriorPart>(
-	    [this, &prep](const Mesh& mesh, const Transform& /* unused */, const TempleInteriorPart& templePart) {
-		    auto l3dMesh = entt::locator<resources::ResourcesInterface>::value().GetMeshes().Handle(mesh.id);
-		    if (_loadedRooms.contains(templePart.room))
+	    [&temple, &prep](const Mesh& mesh, const Transform& /* unused */, const TempleInteriorPart& templePart) {
+		    if (temple.IsRoomVisible(templePart.room))
 		    {
 			    prep(mesh, false);
 		    }
@@ -93,9 +82,9 @@ void RenderingSystemTemple::PrepareDrawDescs(bool drawBoundingBox)
 	// Determine uniform buffer offsets and instance count for draw
 	uint32_t offset = 0;
 	_renderContext.instancedDrawDescs.clear();
-	for (const auto& [meshId, desc] : meshIds)
+	for (const auto& [key, desc] : meshIds)
 	{
-		_renderContext.instancedDrawDescs.emplace(std::piecewise_construct, std::forward_as_tuple(meshId),
+		_renderContext.instancedDrawDescs.emplace(std::piecewise_construct, std::forward_as_tuple(key),
 		                                          std::forward_as_tuple(offset, desc.first, desc.second));
 		offset += desc.first;
 	}
@@ -104,20 +93,22 @@ void RenderingSystemTemple::PrepareDrawDescs(bool drawBoundingBox)
 void RenderingSystemTemple::PrepareDrawUploadUniforms(bool drawBoundingBox)
 {
 	auto& registry = Locator::entitiesRegistry::value();
+	const auto& temple = Locator::temple::value();
 
 	// Store offsets of uniforms for descs
-	std::map<entt::id_type, uint32_t> uniformOffsets;
+	std::map<RenderContext::InstancedDrawKey, uint32_t> uniformOffsets;
 
 	// Set transforms for instanced draw at offsets
 	registry.Each<const Mesh, const Transform, const TempleInteriorPart>(
-	    [this, &uniformOffsets, drawBoundingBox](const Mesh& mesh, const Transform& transform,
-	                                             const TempleInteriorPart& templePart) {
+	    [this, &temple, &uniformOffsets, drawBoundingBox](const Mesh& mesh, const Transform& transform,
+	                                                      const TempleInteriorPart& templePart) {
 		    auto l3dMesh = entt::locator<resources::ResourcesInterface>::value().GetMeshes().Handle(mesh.id);
 
-		    if (_loadedRooms.contains(templePart.room))
+		    if (temple.IsRoomVisible(templePart.room))
 		    {
-			    auto offset = uniformOffsets.insert(std::make_pair(mesh.id, 0));
-			    auto desc = _renderContext.instancedDrawDescs.find(mesh.id);
+			    const RenderContext::InstancedDrawKey key {mesh.id, 0};
+			    auto offset = uniformOffsets.insert(std::make_pair(key, 0));
+			    auto desc = _renderContext.instancedDrawDescs.find(key);
 
 			    auto modelMatrix = glm::mat4(transform.rotation);
 			    modelMatrix = glm::translate(modelMatrix, transform.position * transform.rotation);
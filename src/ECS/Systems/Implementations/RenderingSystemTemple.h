@@ -9,7 +9,6 @@
 
 #pragma once
 
-#include <set>
 #include <vector>
 
 #include <bgfx/bgfx.h>
@@ -34,6 +33,5 @@ class RenderingSystemTemple final: public RenderingSystemCommon
 private:
 	void PrepareDrawDescs(bool drawBoundingBox) override;
 	void PrepareDrawUploadUniforms(bool drawBoundingBox) override;
-	std::set<ecs::components::TempleRoom> _loadedRooms;
 };
 } // namespace openblack::ecs::systems
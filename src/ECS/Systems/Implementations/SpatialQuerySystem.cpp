@@ -0,0 +1,194 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#define LOCATOR_IMPLEMENTATIONS
+
+#include "SpatialQuerySystem.h"
+
+#include <glm/gtx/vec_swizzle.hpp>
+
+#include "ECS/Components/Abode.h"
+#include "ECS/Components/Creature.h"
+#include "ECS/Components/Feature.h"
+#include "ECS/Components/Field.h"
+#include "ECS/Components/Fixed.h"
+#include "ECS/Components/Mobile.h"
+#include "ECS/Components/ScriptControlled.h"
+#include "ECS/Components/Temple.h"
+#include "ECS/Components/Town.h"
+#include "ECS/Components/Transform.h"
+#include "ECS/Components/Tree.h"
+#include "ECS/Components/Villager.h"
+#include "ECS/Registry.h"
+#include "Locator.h"
+
+using namespace openblack;
+using namespace openblack::ecs;
+using namespace openblack::ecs::components;
+using namespace openblack::ecs::systems;
+using script::ObjectType;
+
+namespace
+{
+SpatialIndex::Object Classify(const Registry& registry, entt::entity entity, const Transform& transform)
+{
+	SpatialIndex::Object object {
+	    entity, glm::xz(transform.position), ObjectType::None, 0, std::nullopt, registry.AllOf<ScriptControlled>(entity),
+	};
+
+	if (const auto* villager = registry.TryGet<Villager>(entity); villager != nullptr)
+	{
+		object.type = villager->lifeStage == Villager::LifeStage::Child ? ObjectType::VillagerChild : ObjectType::Villager;
+		object.subtype = static_cast<int32_t>(villager->number);
+	}
+	else if (const auto* abode = registry.TryGet<Abode>(entity); abode != nullptr)
+	{
+		object.type = ObjectType::Abode;
+		object.subtype = static_cast<int32_t>(abode->type);
+	}
+	else if (const auto* town = registry.TryGet<Town>(entity); town != nullptr)
+	{
+		object.type = ObjectType::Town;
+		object.owner = town->owner;
+	}
+	else if (const auto* creature = registry.TryGet<Creature>(entity); creature != nullptr)
+	{
+		object.type = ObjectType::Creature;
+		object.subtype = static_cast<int32_t>(creature->species);
+		object.owner = creature->owner;
+	}
+	else if (const auto* tree = registry.TryGet<Tree>(entity); tree != nullptr)
+	{
+		object.type = ObjectType::Tree;
+		object.subtype = static_cast<int32_t>(tree->type);
+	}
+	else if (const auto* feature = registry.TryGet<Feature>(entity); feature != nullptr)
+	{
+		object.type = ObjectType::Feature;
+		object.subtype = static_cast<int32_t>(feature->type);
+	}
+	else if (registry.AllOf<Field>(entity))
+	{
+		object.type = ObjectType::Field;
+	}
+	else if (const auto* mobileStatic = registry.TryGet<MobileStatic>(entity); mobileStatic != nullptr)
+	{
+		object.type = ObjectType::MobileStatic;
+		object.subtype = static_cast<int32_t>(mobileStatic->type);
+	}
+	else if (const auto* mobileObject = registry.TryGet<MobileObject>(entity); mobileObject != nullptr)
+	{
+		object.type = ObjectType::MobileObject;
+		object.subtype = static_cast<int32_t>(mobileObject->type);
+	}
+	else if (const auto* temple = registry.TryGet<Temple>(entity); temple != nullptr)
+	{
+		object.type = ObjectType::Citadel;
+		object.owner = temple->owner;
+	}
+
+	return object;
+}
+} // namespace
+
+SpatialQuerySystem::SpatialQuerySystem()
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	_constructConnection = registry.OnConstruct<Transform>().connect<&SpatialQuerySystem::OnTransformConstructed>(*this);
+	_destroyConnection = registry.OnDestroy<Transform>().connect<&SpatialQuerySystem::OnTransformDestroyed>(*this);
+
+	// Entities created before the system, such as when a level is reloaded
+	Reset();
+}
+
+void SpatialQuerySystem::OnTransformConstructed([[maybe_unused]] entt::registry& registry, entt::entity entity)
+{
+	// The components which classify the entity may be assigned after its transform
+	_pending.push_back(entity);
+}
+
+void SpatialQuerySystem::OnTransformDestroyed([[maybe_unused]] entt::registry& registry, entt::entity entity)
+{
+	_index.Remove(entity);
+}
+
+void SpatialQuerySystem::IndexPending()
+{
+	if (_pending.empty())
+	{
+		return;
+	}
+
+	const auto& registry = Locator::entitiesRegistry::value();
+	for (const auto entity : _pending)
+	{
+		// Entities may have been destroyed since they were created
+		if (!registry.Valid(entity))
+		{
+			continue;
+		}
+		if (const auto* transform = registry.TryGet<Transform>(entity); transform != nullptr)
+		{
+			_index.Set(Classify(registry, entity, *transform));
+		}
+	}
+	_pending.clear();
+}
+
+void SpatialQuerySystem::Update()
+{
+	IndexPending();
+
+	// Moving a fixed entity goes through Refresh, only the others are followed every turn
+	auto& registry = Locator::entitiesRegistry::value();
+	registry.Each<const Transform>(
+	    [this](entt::entity entity, const Transform& transform) { _index.Move(entity, glm::xz(transform.position)); },
+	    entt::exclude<Fixed>);
+}
+
+void SpatialQuerySystem::Refresh(entt::entity entity)
+{
+	_pending.push_back(entity);
+}
+
+void SpatialQuerySystem::Reset()
+{
+	_index.Clear();
+	_pending.clear();
+	Locator::entitiesRegistry::value().Each<const Transform>(
+	    [this](entt::entity entity, [[maybe_unused]] const Transform& transform) { _pending.push_back(entity); });
+}
+
+std::vector<entt::entity> SpatialQuerySystem::FindInRadius(const glm::vec3& center, float radius,
+                                                           const SpatialQueryFilter& filter)
+{
+	IndexPending();
+	return _index.FindInRadius(glm::xz(center), radius, filter);
+}
+
+std::vector<entt::entity> SpatialQuerySystem::FindInAnnulus(const glm::vec3& center, float innerRadius, float outerRadius,
+                                                            const SpatialQueryFilter& filter)
+{
+	IndexPending();
+	return _index.FindInAnnulus(glm::xz(center), innerRadius, outerRadius, filter);
+}
+
+std::vector<entt::entity> SpatialQuerySystem::FindInBox(const glm::vec2& min, const glm::vec2& max,
+                                                        const SpatialQueryFilter& filter)
+{
+	IndexPending();
+	return _index.FindInBox(min, max, filter);
+}
+
+std::vector<entt::entity> SpatialQuerySystem::FindNearest(const glm::vec3& center, size_t count,
+                                                          const SpatialQueryFilter& filter, float minRadius, float maxRadius)
+{
+	IndexPending();
+	return _index.FindNearest(glm::xz(center), count, filter, minRadius, maxRadius);
+}
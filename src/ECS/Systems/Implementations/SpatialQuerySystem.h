@@ -0,0 +1,63 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <entt/signal/sigh.hpp>
+
+#include "ECS/SpatialIndex.h"
+#include "ECS/Systems/SpatialQuerySystemInterface.h"
+
+#if !defined(LOCATOR_IMPLEMENTATIONS)
+#error "Locator interface implementations should only be included in Locator.cpp, use interface instead."
+#endif
+
+namespace openblack::ecs::systems
+{
+
+/**
+  Keeps a spatial index of every entity with a transform, classified by script object type, subtype and owner.
+
+  Entities are indexed when their transform is assigned and dropped when it is removed, following the signals of the
+  registry. Entities without a Fixed component are moved in the index on every update. Queries first index the entities
+  created since the last update, so that objects created by a script can be found by the next instruction.
+ */
+class SpatialQuerySystem final: public SpatialQuerySystemInterface
+{
+public:
+	SpatialQuerySystem();
+
+	void Update() override;
+	void Refresh(entt::entity entity) override;
+	void Reset() override;
+
+	[[nodiscard]] std::vector<entt::entity> FindInRadius(const glm::vec3& center, float radius,
+	                                                     const SpatialQueryFilter& filter) override;
+	[[nodiscard]] std::vector<entt::entity> FindInAnnulus(const glm::vec3& center, float innerRadius, float outerRadius,
+	                                                      const SpatialQueryFilter& filter) override;
+	[[nodiscard]] std::vector<entt::entity> FindInBox(const glm::vec2& min, const glm::vec2& max,
+	                                                  const SpatialQueryFilter& filter) override;
+	[[nodiscard]] std::vector<entt::entity> FindNearest(const glm::vec3& center, size_t count,
+	                                                    const SpatialQueryFilter& filter, float minRadius,
+	                                                    float maxRadius) override;
+
+private:
+	void OnTransformConstructed(entt::registry& registry, entt::entity entity);
+	void OnTransformDestroyed(entt::registry& registry, entt::entity entity);
+	/// Index the entities which were created or refreshed since the last call
+	void IndexPending();
+
+	SpatialIndex _index;
+	std::vector<entt::entity> _pending;
+	entt::scoped_connection _constructConnection;
+	entt::scoped_connection _destroyConnection;
+};
+} // namespace openblack::ecs::systems
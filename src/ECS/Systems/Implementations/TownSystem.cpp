@@ -11,6 +11,11 @@
 
 #include "TownSystem.h"
 
+#include <algorithm>
+#include <limits>
+
+#include <glm/gtx/norm.hpp>
+
 #include "ECS/Components/Abode.h"
 #include "ECS/Components/Town.h"
 #include "ECS/Components/Transform.h"
@@ -22,44 +27,61 @@
 using namespace openblack::ecs::components;
 using namespace openblack::ecs::systems;
 
-entt::entity TownSystem::FindAbodeWithSpace(entt::entity townEntity) const
+TownSystem::TownSystem()
 {
-	const auto& infoConstants = Locator::infoConstants::value();
-	auto& registry = Locator::entitiesRegistry::value();
-	const auto& town = registry.Get<Town>(townEntity);
-
-	entt::entity result = entt::null;
-	registry.Each<const Abode>([&town, &infoConstants, &result](entt::entity entity, auto component) {
-		if (result != entt::null || component.townId != town.id)
-		{
-			return;
-		}
-		const auto& info = infoConstants.abode.at(static_cast<size_t>(component.type));
-		if (static_cast<uint32_t>(component.inhabitants.size()) < info.maxVillagersInAbode)
-		{
-			result = entity;
-		}
-	});
+	_abodeDestroyConnection =
+	    Locator::entitiesRegistry::value().OnDestroy<Abode>().connect<&TownSystem::OnAbodeDestroyed>(*this);
+}
 
-	return result;
+entt::entity TownSystem::FindAbodeWithSpace(entt::entity townEntity) const
+{
+	const auto& town = Locator::entitiesRegistry::value().Get<Town>(townEntity);
+	if (town.abodesWithVacancy.empty())
+	{
+		return entt::null;
+	}
+	return *town.abodesWithVacancy.begin();
 }
 
 entt::entity TownSystem::FindClosestTown(const glm::vec3& point) const
 {
-	const auto& registry = Locator::entitiesRegistry::value();
+	const auto& locations = Locator::entitiesRegistry::value().Context().townLocations;
 
 	entt::entity result = entt::null;
 	auto closest = std::numeric_limits<float>::infinity();
 
-	registry.Each<const Town, const Transform>(
-	    [&point, &result, &closest](entt::entity entity, [[maybe_unused]] auto& town, [[maybe_unused]] auto& transform) {
-		    float distance2 = glm::dot(point, transform.position);
-		    if (distance2 < closest)
-		    {
-			    closest = distance2;
-			    result = entity;
-		    }
-	    });
+	// Walk away from the point's x in both directions until the distance along x alone exceeds the closest town found
+	const auto visit = [&point, &result, &closest](const openblack::ecs::RegistryContext::TownLocation& location) {
+		const auto dx = location.position.x - point.x;
+		if (dx * dx >= closest)
+		{
+			return false;
+		}
+		const auto distance2 = glm::distance2(point, location.position);
+		if (distance2 < closest)
+		{
+			closest = distance2;
+			result = location.entity;
+		}
+		return true;
+	};
+	const auto middle = std::lower_bound(locations.cbegin(), locations.cend(), point.x,
+	                                     [](const auto& location, float x) { return location.position.x < x; });
+	for (auto it = middle; it != locations.cend(); ++it)
+	{
+		if (!visit(*it))
+		{
+			break;
+		}
+	}
+	for (auto it = middle; it != locations.cbegin();)
+	{
+		--it;
+		if (!visit(*it))
+		{
+			break;
+		}
+	}
 
 	return result;
 }
@@ -77,3 +99,87 @@ void TownSystem::AddHomelessVillagerToTown(entt::entity townEntity, entt::entity
 	town.homelessVillagers.insert(villagerEntity);
 	villager.town = townEntity;
 }
+
+void TownSystem::AddAbodeToTown(entt::entity townEntity, entt::entity abodeEntity)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+
+	auto& town = registry.Get<Town>(townEntity);
+	assert(registry.Get<Abode>(abodeEntity).townId == town.id);
+	town.abodes.insert(abodeEntity);
+	UpdateVacancy(abodeEntity);
+}
+
+void TownSystem::AddVillagerToAbode(entt::entity abodeEntity, entt::entity villagerEntity)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+
+	auto& abode = registry.Get<Abode>(abodeEntity);
+	auto& villager = registry.Get<Villager>(villagerEntity);
+	assert(villager.abode == entt::null);
+	abode.inhabitants.insert(villagerEntity);
+	villager.abode = abodeEntity;
+	UpdateVacancy(abodeEntity);
+}
+
+void TownSystem::RemoveVillagerFromAbode(entt::entity abodeEntity, entt::entity villagerEntity)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+
+	auto& abode = registry.Get<Abode>(abodeEntity);
+	auto& villager = registry.Get<Villager>(villagerEntity);
+	assert(villager.abode == abodeEntity);
+	abode.inhabitants.erase(villagerEntity);
+	villager.abode = entt::null;
+	UpdateVacancy(abodeEntity);
+}
+
+void TownSystem::UpdateVacancy(entt::entity abodeEntity)
+{
+	const auto& infoConstants = Locator::infoConstants::value();
+	auto& registry = Locator::entitiesRegistry::value();
+
+	const auto& abode = registry.Get<Abode>(abodeEntity);
+	auto& town = registry.Get<Town>(registry.Context().towns.at(abode.townId));
+	const auto& info = infoConstants.abode.at(static_cast<size_t>(abode.type));
+	if (static_cast<uint32_t>(abode.inhabitants.size()) < info.maxVillagersInAbode)
+	{
+		town.abodesWithVacancy.insert(abodeEntity);
+	}
+	else
+	{
+		town.abodesWithVacancy.erase(abodeEntity);
+	}
+}
+
+void TownSystem::OnAbodeDestroyed([[maybe_unused]] entt::registry& registry, entt::entity abodeEntity)
+{
+	auto& entitiesRegistry = Locator::entitiesRegistry::value();
+
+	// The town may already be gone when the whole registry is cleared
+	const auto& abode = entitiesRegistry.Get<const Abode>(abodeEntity);
+	const auto& towns = entitiesRegistry.Context().towns;
+	const auto townEntity = towns.find(abode.townId);
+	auto* town = townEntity != towns.cend() && entitiesRegistry.Valid(townEntity->second)
+	                 ? entitiesRegistry.TryGet<Town>(townEntity->second)
+	                 : nullptr;
+	if (town != nullptr)
+	{
+		town->abodes.erase(abodeEntity);
+		town->abodesWithVacancy.erase(abodeEntity);
+	}
+
+	for (const auto villagerEntity : abode.inhabitants)
+	{
+		auto* villager = entitiesRegistry.Valid(villagerEntity) ? entitiesRegistry.TryGet<Villager>(villagerEntity) : nullptr;
+		if (villager == nullptr || villager->abode != abodeEntity)
+		{
+			continue;
+		}
+		villager->abode = entt::null;
+		if (town != nullptr)
+		{
+			town->homelessVillagers.insert(villagerEntity);
+		}
+	}
+}
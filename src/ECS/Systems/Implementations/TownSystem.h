@@ -9,6 +9,8 @@
 
 #pragma once
 
+#include <entt/signal/sigh.hpp>
+
 #include "ECS/Systems/TownSystemInterface.h"
 
 #if !defined(LOCATOR_IMPLEMENTATIONS)
@@ -21,8 +23,21 @@ namespace openblack::ecs::systems
 class TownSystem final: public TownSystemInterface
 {
 public:
+	TownSystem();
+
 	[[nodiscard]] entt::entity FindAbodeWithSpace(entt::entity townEntity) const override;
 	[[nodiscard]] entt::entity FindClosestTown(const glm::vec3& point) const override;
 	void AddHomelessVillagerToTown(entt::entity townEntity, entt::entity villagerEntity) override;
+	void AddAbodeToTown(entt::entity townEntity, entt::entity abodeEntity) override;
+	void AddVillagerToAbode(entt::entity abodeEntity, entt::entity villagerEntity) override;
+	void RemoveVillagerFromAbode(entt::entity abodeEntity, entt::entity villagerEntity) override;
+
+private:
+	/// Add or remove the abode from its town's vacancies according to its number of inhabitants
+	static void UpdateVacancy(entt::entity abodeEntity);
+	/// Drop a destroyed abode from its town, its inhabitants become homeless
+	void OnAbodeDestroyed(entt::registry& registry, entt::entity abodeEntity);
+
+	entt::scoped_connection _abodeDestroyConnection;
 };
 } // namespace openblack::ecs::systems
@@ -9,6 +9,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "ECS/Components/LivingAction.h"
 
 namespace openblack::ecs::systems
@@ -17,18 +19,27 @@ namespace openblack::ecs::systems
 class LivingActionSystemInterface
 {
 public:
+	using StateChangeCallback = std::function<void(const components::LivingAction& action,
+	                                               components::LivingAction::Index index, VillagerStates src,
+	                                               VillagerStates dst)>;
+	using StateFunction = uint32_t (*)(components::LivingAction& action);
+
 	virtual void Update() = 0;
 
 	[[nodiscard]] virtual VillagerStates VillagerGetState(const components::LivingAction& action,
 	                                                      components::LivingAction::Index index) const = 0;
 	virtual void VillagerSetState(components::LivingAction& action, components::LivingAction::Index index, VillagerStates state,
-	                              bool skipTransition) const = 0;
+	                              bool skipTransition) = 0;
 	virtual uint32_t VillagerCallState(components::LivingAction& action, components::LivingAction::Index index) const = 0;
 	virtual bool VillagerCallEntryState(components::LivingAction& action, components::LivingAction::Index index,
 	                                    VillagerStates src, VillagerStates dst) const = 0;
 	virtual bool VillagerCallExitState(components::LivingAction& action, components::LivingAction::Index index) const = 0;
 	virtual int VillagerCallOutOfAnimation(components::LivingAction& action, components::LivingAction::Index index) const = 0;
 	virtual bool VillagerCallValidate(components::LivingAction& action, components::LivingAction::Index index) const = 0;
+	/// Observe every state change once it is applied, in the order they are applied
+	virtual void SetStateChangeCallback(StateChangeCallback callback) = 0;
+	/// Replace the function run every turn for the villagers in a state, such as by tests which script villagers
+	virtual void SetStateFunction(VillagerStates state, StateFunction function) = 0;
 };
 
 } // namespace openblack::ecs::systems
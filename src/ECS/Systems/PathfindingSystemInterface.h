@@ -9,11 +9,24 @@
 
 #pragma once
 
+#include <entt/fwd.hpp>
+#include <glm/fwd.hpp>
+
+namespace openblack::ecs
+{
+class RoutePlanner;
+}
+
 namespace openblack::ecs::systems
 {
 class PathfindingSystemInterface
 {
 public:
 	virtual void Update() = 0;
+	/// Walk a mobile to a destination, following footpaths if it cannot walk there in a straight line
+	virtual void MoveTo(entt::entity entity, const glm::vec2& destination) = 0;
+	/// Drop the routes and graph planned from the previous content of the registry, such as after loading a snapshot
+	virtual void Reset() = 0;
+	[[nodiscard]] virtual const RoutePlanner& GetRoutePlanner() const = 0;
 };
 } // namespace openblack::ecs::systems
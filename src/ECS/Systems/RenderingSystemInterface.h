@@ -9,24 +9,71 @@
 
 #pragma once
 
+#include <array>
 #include <map>
+#include <span>
+#include <vector>
 
 #include <bgfx/bgfx.h>
 #include <entt/fwd.hpp>
 #include <glm/mat4x4.hpp>
 
+#include "Graphics/DebugLines.h"
 #include "Graphics/Mesh.h"
 
 namespace openblack::ecs::systems
 {
+/// Debug geometry kept on the GPU between frames, each rebuilt only when the components it shows change
+enum class DebugLayer : uint8_t
+{
+	Footpaths,
+	Streams,
+
+	_Count
+};
+
+/// Debug geometry to prepare along with the entities
+struct DebugDrawFlags
+{
+	bool boundingBoxes;
+	bool footpaths;
+	bool streams;
+	bool wallHug;
+	bool physics;
+};
+
 struct RenderContext
 {
 	RenderContext();
 	~RenderContext();
+	/// Unit box drawn with the second half of the instance uniforms, created the first time bounding boxes are drawn
 	std::unique_ptr<graphics::Mesh> boundingBox;
-	std::unique_ptr<graphics::Mesh> streams;
-	std::unique_ptr<graphics::Mesh> footpaths;
 	std::unique_ptr<graphics::Mesh> footprints;
+	std::array<graphics::DebugLineBuffer, static_cast<size_t>(DebugLayer::_Count)> debugLayers;
+	/// Lines of things which move every frame, such as wall hug rays and physics shapes, refilled at every \ref PrepareDraw
+	std::vector<graphics::DebugLines::Vertex> transientDebugLines;
+
+	/// L3D submeshes carry a 3 bit mask of the levels of detail they belong to, 0 being the most detailed
+	static constexpr uint8_t k_LevelsOfDetail = 3;
+
+	/// Fraction of the screen height covered by a bounding sphere, all of it when the sphere contains the camera
+	[[nodiscard]] static float GetScreenSize(float radius, float distance, float projectionScale);
+	/// Level of detail for a screen size, the thresholds are widened around the current level so that an instance does
+	/// not flicker between two levels when the camera hovers around a boundary
+	[[nodiscard]] static uint8_t SelectLevelOfDetail(float screenSize, uint8_t current, uint8_t lodMask,
+	                                                 std::span<const float, k_LevelsOfDetail - 1> thresholds,
+	                                                 float hysteresis);
+	/// Not all meshes have every level of detail, fall back to the closest more detailed one, then the closest coarser one
+	[[nodiscard]] static uint8_t GetClosestLevelOfDetail(uint8_t lod, uint8_t lodMask);
+
+	/// Instances are grouped per mesh and per level of detail so each group draws a single set of submeshes
+	struct InstancedDrawKey
+	{
+		entt::id_type meshId;
+		uint8_t lod;
+
+		auto operator<=>(const InstancedDrawKey&) const = default;
+	};
 
 	struct InstancedDrawDesc
 	{
@@ -48,7 +95,7 @@ struct RenderContext
 	/// bounding boxes in the second half of the list.
 	std::vector<glm::mat4> instanceUniforms;
 	/// Stores information for rendering which is prepared at \ref PrepareDraw.
-	std::map<entt::id_type, const InstancedDrawDesc> instancedDrawDescs;
+	std::map<InstancedDrawKey, const InstancedDrawDesc> instancedDrawDescs;
 	/// Not an actual vertex buffer, but a dynamic general purpose buffer which
 	/// stores uniform data as a GPU-side copy of \ref _instanceUniforms and
 	/// which is populated in \ref PrepareDraw and consumed in \ref DrawModels.
@@ -66,7 +113,7 @@ class RenderingSystemInterface
 {
 public:
 	virtual void SetDirty() = 0;
-	virtual void PrepareDraw(bool drawBoundingBox, bool drawFootpaths, bool drawStreams) = 0;
+	virtual void PrepareDraw(const DebugDrawFlags& debug) = 0;
 	virtual const RenderContext& GetContext() = 0;
 	inline ~RenderingSystemInterface() = default;
 };
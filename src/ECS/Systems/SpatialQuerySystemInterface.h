@@ -0,0 +1,48 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+
+#include <limits>
+#include <vector>
+
+#include <entt/fwd.hpp>
+#include <glm/fwd.hpp>
+
+#include "ECS/SpatialIndex.h"
+
+namespace openblack::ecs::systems
+{
+
+/// Queries of the objects around a point of the world, on the ground plane. Positions are in world units.
+class SpatialQuerySystemInterface
+{
+public:
+	/// Index the entities created since the last update and follow the entities which move
+	virtual void Update() = 0;
+	/// Index an entity again after its components changed or after a fixed entity was moved
+	virtual void Refresh(entt::entity entity) = 0;
+	/// Classify and index every entity again, after the content of the registry was replaced
+	virtual void Reset() = 0;
+
+	[[nodiscard]] virtual std::vector<entt::entity> FindInRadius(const glm::vec3& center, float radius,
+	                                                             const SpatialQueryFilter& filter) = 0;
+	[[nodiscard]] virtual std::vector<entt::entity> FindInAnnulus(const glm::vec3& center, float innerRadius,
+	                                                              float outerRadius, const SpatialQueryFilter& filter) = 0;
+	/// Objects in a box on the x and z axes
+	[[nodiscard]] virtual std::vector<entt::entity> FindInBox(const glm::vec2& min, const glm::vec2& max,
+	                                                          const SpatialQueryFilter& filter) = 0;
+	/// Up to count objects closest to a point with a distance between the min and max radius, closest first
+	[[nodiscard]] virtual std::vector<entt::entity>
+	FindNearest(const glm::vec3& center, size_t count, const SpatialQueryFilter& filter, float minRadius = 0.0f,
+	            float maxRadius = std::numeric_limits<float>::infinity()) = 0;
+};
+} // namespace openblack::ecs::systems
@@ -20,5 +20,8 @@ class TownSystemInterface
 	[[nodiscard]] virtual entt::entity FindAbodeWithSpace(entt::entity townEntity) const = 0;
 	[[nodiscard]] virtual entt::entity FindClosestTown(const glm::vec3& point) const = 0;
 	virtual void AddHomelessVillagerToTown(entt::entity townEntity, entt::entity villagerEntity) = 0;
+	virtual void AddAbodeToTown(entt::entity townEntity, entt::entity abodeEntity) = 0;
+	virtual void AddVillagerToAbode(entt::entity abodeEntity, entt::entity villagerEntity) = 0;
+	virtual void RemoveVillagerFromAbode(entt::entity abodeEntity, entt::entity villagerEntity) = 0;
 };
 } // namespace openblack::ecs::systems
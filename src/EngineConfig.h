@@ -9,6 +9,11 @@
 
 #pragma once
 
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <optional>
+
 #include <bgfx/bgfx.h>
 
 #include "Windowing/WindowingInterface.h"
@@ -34,6 +39,14 @@ struct EngineConfig
 	bool drawBoundingBoxes {false};
 	bool drawFootpaths {false};
 	bool drawStreams {false};
+	bool drawWallHug {false};
+	bool drawPhysics {false};
+
+	bool useLevelsOfDetail {true};
+	/// Fraction of the screen height covered by a mesh's bounding sphere under which its next level of detail is used
+	std::array<float, 2> lodScreenSizeThresholds {0.08f, 0.02f};
+	/// Relative band around each threshold inside which an instance keeps its current level of detail
+	float lodHysteresis {0.15f};
 
 	bool vsync {false};
 	bool running {false};
@@ -54,5 +67,23 @@ struct EngineConfig
 	windowing::DisplayMode displayMode {windowing::DisplayMode::Windowed};
 
 	uint32_t numFramesToSimulate {0};
+	/// Turns stepped without rendering, audio or input instead of running the game, see Game::Simulate
+	uint32_t numTurnsToSimulate {0};
+	/// Multiple of the normal speed at which turns are simulated, as fast as possible if 0
+	float simulationSpeed {0.0f};
+	/// Advance every frame by this duration instead of the measured time so that replays are repeatable
+	std::optional<std::chrono::microseconds> fixedFrameDuration;
+
+	/// Directory of the cooked meshes, meshes are cooked on every load if empty
+	std::filesystem::path meshCachePath;
+	/// Vertex formats uploaded for L3D meshes when they are loaded, loading both allows switching between them
+	bool loadFullMeshVertices {true};
+	bool loadCompactMeshVertices {false};
+	/// Draw L3D meshes with their compact vertices when they were loaded
+	bool useCompactMeshVertices {false};
+	/// Bytes of the L3D mesh pools taken up by loaded temple rooms, rooms the camera is away from are unloaded past it
+	uint64_t templeRoomMemoryBudget {64 * 1024 * 1024};
+	/// Bytes of textures kept on the GPU, the largest levels of textures not drawn recently are dropped past it
+	uint64_t textureMemoryBudget {512 * 1024 * 1024};
 };
 } // namespace openblack
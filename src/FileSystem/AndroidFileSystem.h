@@ -38,6 +38,7 @@ class AndroidFileSystem: public FileSystemInterface
 	std::vector<uint8_t> ReadAll(const std::filesystem::path& path) override;
 	void Iterate(const std::filesystem::path& path, bool recursive,
 	             const std::function<void(const std::filesystem::path&)>& function) const override;
+	void InvalidateIndex() override {}
 
 private:
 	JNIEnv* _jniEnv;
@@ -0,0 +1,293 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#define LOCATOR_IMPLEMENTATIONS
+
+#include "ArchiveFileSystem.h"
+
+#include <istream>
+#include <span>
+#include <stdexcept>
+#include <streambuf>
+
+#include <fmt/format.h>
+
+#include "Common/Zip.h"
+#include "MemoryStream.h"
+#include "SpanStream.h"
+
+using namespace openblack::filesystem;
+using openblack::pack::AssetArchive;
+using openblack::pack::AssetArchiveEntry;
+using openblack::pack::AssetArchiveResult;
+using openblack::pack::AssetCompression;
+
+namespace
+{
+/// Read only stream buffer over memory, the istream counterpart of SpanStream
+class SpanStreamBuffer final: public std::streambuf
+{
+public:
+	explicit SpanStreamBuffer(std::span<const uint8_t> data)
+	{
+		// The get area is never written to
+		auto* begin = const_cast<char*>(reinterpret_cast<const char*>(data.data()));
+		setg(begin, begin, begin + data.size());
+	}
+
+protected:
+	pos_type seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode which) override
+	{
+		if ((which & std::ios_base::in) == 0)
+		{
+			return {off_type(-1)};
+		}
+
+		off_type base = 0;
+		if (direction == std::ios_base::cur)
+		{
+			base = gptr() - eback();
+		}
+		else if (direction == std::ios_base::end)
+		{
+			base = egptr() - eback();
+		}
+		const auto position = base + offset;
+		if (position < 0 || position > egptr() - eback())
+		{
+			return {off_type(-1)};
+		}
+		setg(eback(), eback() + position, egptr());
+		return {position};
+	}
+
+	pos_type seekpos(pos_type position, std::ios_base::openmode which) override
+	{
+		return seekoff(off_type(position), std::ios_base::beg, which);
+	}
+};
+
+/// Stream over an entry of the mapping, or over inflated data it owns
+class EntryStream final: public std::istream
+{
+public:
+	explicit EntryStream(std::span<const uint8_t> data)
+	    : std::istream(&_buffer)
+	    , _buffer(data)
+	{
+	}
+
+	explicit EntryStream(std::vector<uint8_t>&& inflated)
+	    : std::istream(&_buffer)
+	    , _inflated(std::move(inflated))
+	    , _buffer(_inflated)
+	{
+	}
+
+private:
+	std::vector<uint8_t> _inflated;
+	SpanStreamBuffer _buffer;
+};
+} // namespace
+
+ArchiveFileSystem::ArchiveFileSystem(const std::filesystem::path& archivePath)
+{
+	SetGamePath(archivePath);
+}
+
+void ArchiveFileSystem::SetGamePath(const std::filesystem::path& path)
+{
+	if (_mapping != nullptr && path == _gamePath)
+	{
+		return;
+	}
+
+	auto mapping = std::make_unique<MappedFile>(path);
+	AssetArchive archive;
+	if (const auto result = archive.Open(mapping->GetData()); result != AssetArchiveResult::Success)
+	{
+		throw std::runtime_error(fmt::format("Failed to open asset archive {}: {}", path.generic_string(),
+		                                     pack::ResultToStr(result)));
+	}
+
+	_gamePath = path;
+	_mapping = std::move(mapping);
+	_archive = archive;
+}
+
+std::optional<std::string> ArchiveFileSystem::ArchiveKey(const std::filesystem::path& path) const
+{
+	auto relative = path;
+	if (path.is_absolute())
+	{
+		// Paths made with GetPath<>(true) are below the archive file
+		relative = path.lexically_relative(_gamePath);
+		if (relative.empty() || *relative.begin() == "..")
+		{
+			return std::nullopt;
+		}
+	}
+
+	auto key = FixPath(relative).lexically_normal().generic_string();
+	while (!key.empty() && key.back() == '/')
+	{
+		key.pop_back();
+	}
+	if (key == ".")
+	{
+		key.clear();
+	}
+	return key;
+}
+
+const AssetArchiveEntry* ArchiveFileSystem::FindEntry(const std::filesystem::path& path) const
+{
+	const auto key = ArchiveKey(path);
+	return key.has_value() ? _archive.Find(*key) : nullptr;
+}
+
+std::vector<uint8_t> ArchiveFileSystem::Inflate(const AssetArchiveEntry& entry) const
+{
+	return zip::Inflate(_archive.GetStoredData(entry), entry.size);
+}
+
+std::filesystem::path ArchiveFileSystem::FindPath(const std::filesystem::path& path) const
+{
+	if (path.empty())
+	{
+		throw std::invalid_argument("empty path");
+	}
+
+	if (const auto key = ArchiveKey(path))
+	{
+		if (const auto* entry = _archive.Find(*key))
+		{
+			return _archive.GetName(*entry);
+		}
+		if (const auto entries = _archive.FindDirectory(*key); !key->empty() && !entries.empty())
+		{
+			// Spelled like the archive does
+			return _archive.GetName(entries.front()).substr(0, key->size());
+		}
+	}
+
+	return _looseFiles.FindPath(path);
+}
+
+bool ArchiveFileSystem::IsPathValid(const std::filesystem::path& path)
+{
+	return _looseFiles.IsPathValid(path);
+}
+
+std::unique_ptr<Stream> ArchiveFileSystem::Open(const std::filesystem::path& path, Stream::Mode mode)
+{
+	if (mode == Stream::Mode::Read)
+	{
+		if (const auto* entry = FindEntry(path))
+		{
+			if (entry->compression == AssetCompression::None)
+			{
+				return std::make_unique<SpanStream>(_archive.GetStoredData(*entry));
+			}
+			return std::make_unique<MemoryStream>(Inflate(*entry));
+		}
+	}
+
+	return _looseFiles.Open(path, mode);
+}
+
+std::unique_ptr<std::istream> ArchiveFileSystem::GetData(const std::filesystem::path& path)
+{
+	if (const auto* entry = FindEntry(path))
+	{
+		if (entry->compression == AssetCompression::None)
+		{
+			return std::make_unique<EntryStream>(_archive.GetStoredData(*entry));
+		}
+		return std::make_unique<EntryStream>(Inflate(*entry));
+	}
+
+	return _looseFiles.GetData(path);
+}
+
+bool ArchiveFileSystem::Exists(const std::filesystem::path& path) const
+{
+	if (path.empty())
+	{
+		return false;
+	}
+
+	if (const auto key = ArchiveKey(path); key.has_value() && !key->empty())
+	{
+		if (_archive.Find(*key) != nullptr || !_archive.FindDirectory(*key).empty())
+		{
+			return true;
+		}
+	}
+
+	return _looseFiles.Exists(path);
+}
+
+void ArchiveFileSystem::AddAdditionalPath(const std::filesystem::path& path)
+{
+	_looseFiles.AddAdditionalPath(path);
+}
+
+std::vector<uint8_t> ArchiveFileSystem::ReadAll(const std::filesystem::path& path)
+{
+	if (const auto* entry = FindEntry(path))
+	{
+		if (entry->compression == AssetCompression::None)
+		{
+			const auto data = _archive.GetStoredData(*entry);
+			return {data.begin(), data.end()};
+		}
+		return Inflate(*entry);
+	}
+
+	return _looseFiles.ReadAll(path);
+}
+
+void ArchiveFileSystem::Iterate(const std::filesystem::path& path, bool recursive,
+                                const std::function<void(const std::filesystem::path&)>& function) const
+{
+	const auto key = ArchiveKey(path);
+	const auto entries = key.has_value() ? _archive.FindDirectory(*key) : std::span<const AssetArchiveEntry> {};
+	if (entries.empty())
+	{
+		_looseFiles.Iterate(path, recursive, function);
+		return;
+	}
+
+	const auto prefixSize = key->empty() ? 0 : key->size() + 1;
+	std::string_view lastDirectory;
+	for (const auto& entry : entries)
+	{
+		const auto name = _archive.GetName(entry);
+		const auto separator = name.find('/', prefixSize);
+		if (recursive || separator == std::string_view::npos)
+		{
+			function(name);
+			continue;
+		}
+
+		// Entries of a sub directory are next to each other in the table of contents
+		const auto directory = name.substr(0, separator);
+		if (AssetArchive::Compare(directory, lastDirectory) != 0)
+		{
+			function(directory);
+			lastDirectory = directory;
+		}
+	}
+}
+
+void ArchiveFileSystem::InvalidateIndex()
+{
+	_looseFiles.InvalidateIndex();
+}
@@ -0,0 +1,63 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <AssetArchive.h>
+
+#include "DefaultFileSystem.h"
+#include "FileSystemInterface.h"
+#include "MappedFile.h"
+
+#if !defined(LOCATOR_IMPLEMENTATIONS)
+#error "Locator interface implementations should only be included in Locator.cpp"
+#endif
+
+namespace openblack::filesystem
+{
+
+/// Game files served from a memory mapped asset archive built by packtool, the game path is the archive file.
+/// Uncompressed entries are read straight from the mapping, anything missing from the archive is looked up on disk.
+class ArchiveFileSystem: public FileSystemInterface
+{
+public:
+	explicit ArchiveFileSystem(const std::filesystem::path& archivePath);
+
+	[[nodiscard]] std::filesystem::path FindPath(const std::filesystem::path& path) const override;
+	[[nodiscard]] bool IsPathValid(const std::filesystem::path& path) override;
+	std::unique_ptr<Stream> Open(const std::filesystem::path& path, Stream::Mode mode) override;
+	std::unique_ptr<std::istream> GetData(const std::filesystem::path& path) override;
+	[[nodiscard]] bool Exists(const std::filesystem::path& path) const override;
+	void SetGamePath(const std::filesystem::path& path) override;
+	[[nodiscard]] const std::filesystem::path& GetGamePath() const override { return _gamePath; }
+	void AddAdditionalPath(const std::filesystem::path& path) override;
+	std::vector<uint8_t> ReadAll(const std::filesystem::path& path) override;
+	/// Archived directories only list files when recursive, as the archive has no directory entries
+	void Iterate(const std::filesystem::path& path, bool recursive,
+	             const std::function<void(const std::filesystem::path&)>& function) const override;
+	void InvalidateIndex() override;
+
+private:
+	/// Path of an entry in the archive, nullopt if an absolute path lies outside of it
+	[[nodiscard]] std::optional<std::string> ArchiveKey(const std::filesystem::path& path) const;
+	[[nodiscard]] const pack::AssetArchiveEntry* FindEntry(const std::filesystem::path& path) const;
+	[[nodiscard]] std::vector<uint8_t> Inflate(const pack::AssetArchiveEntry& entry) const;
+
+	std::filesystem::path _gamePath;
+	std::unique_ptr<MappedFile> _mapping;
+	pack::AssetArchive _archive;
+	DefaultFileSystem _looseFiles;
+};
+
+} // namespace openblack::filesystem
@@ -11,11 +11,14 @@
 
 #include "DefaultFileSystem.h"
 
+#include <algorithm>
+#include <cctype>
 #include <filesystem>
 #include <fstream>
 #include <ios>
 #include <istream>
 #include <memory>
+#include <set>
 #include <system_error>
 
 #include "FileStream.h"
@@ -40,39 +43,119 @@ std::filesystem::path DefaultFileSystem::FindPath(const std::filesystem::path& p
 		throw std::invalid_argument("empty path");
 	}
 
-	// try absolute first
+	if (auto result = Resolve(path))
+	{
+		return *result;
+	}
+
+	throw std::runtime_error("File " + path.string() + " not found");
+}
+
+std::string DefaultFileSystem::IndexKey(const std::filesystem::path& path)
+{
+	auto key = FixPath(path).lexically_normal().generic_string();
+	while (!key.empty() && key.back() == '/')
+	{
+		key.pop_back();
+	}
+	std::ranges::transform(key, key.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+	return key;
+}
+
+std::optional<std::filesystem::path> DefaultFileSystem::Resolve(const std::filesystem::path& path) const
+{
+	std::error_code ec;
 	if (path.is_absolute())
 	{
-		if (std::filesystem::exists(path))
+		if (std::filesystem::exists(path, ec))
 		{
 			return path;
 		}
+		return std::nullopt;
 	}
-	else
+
 	{
-		// try relative to current directory
-		if (std::filesystem::exists(path))
+		const std::lock_guard<std::mutex> lock(_indexMutex);
+		if (!_indexBuilt)
 		{
-			return path;
+			BuildIndex();
+		}
+		const auto key = IndexKey(path);
+		if (const auto iter = _index.find(key); iter != _index.cend())
+		{
+			return iter->second;
 		}
 
-		// try relative to game directory
-		if (std::filesystem::exists(_gamePath / path))
+		// Files created since the index was built are found with the exact case of the path and added to it
+		for (const auto& root : _roots)
 		{
-			return _gamePath / path;
+			if (std::filesystem::exists(root / path, ec))
+			{
+				return _index.try_emplace(key, root / path).first->second;
+			}
 		}
+	}
+
+	// Files outside of the game, relative to the current directory
+	if (std::filesystem::exists(path, ec))
+	{
+		return path;
+	}
 
-		// try relative to additional paths
-		for (const auto& p : _additionalPaths)
+	return std::nullopt;
+}
+
+void DefaultFileSystem::BuildIndex() const
+{
+	_index.clear();
+	_roots.clear();
+
+	const auto indexRoot = [this](const std::filesystem::path& root) {
+		std::error_code ec;
+		if (root.empty() || !std::filesystem::is_directory(root, ec))
 		{
-			if (std::filesystem::exists(p / path))
+			return;
+		}
+		_roots.push_back(root);
+
+		// Directories already walked, so that symlinks to one of their parents or to each other are not followed forever
+		std::set<std::filesystem::path> visited {std::filesystem::canonical(root, ec)};
+		const auto options = std::filesystem::directory_options::follow_directory_symlink |
+		                     std::filesystem::directory_options::skip_permission_denied;
+		for (auto iter = std::filesystem::recursive_directory_iterator(root, options, ec);
+		     !ec && iter != std::filesystem::recursive_directory_iterator(); iter.increment(ec))
+		{
+			// The first root to have a file keeps it
+			_index.try_emplace(IndexKey(iter->path().lexically_relative(root)), iter->path());
+
+			std::error_code entryError;
+			if (iter->is_directory(entryError) && !visited.insert(std::filesystem::canonical(iter->path(), entryError)).second)
 			{
-				return p / path;
+				iter.disable_recursion_pending();
 			}
 		}
+	};
+
+	indexRoot(_gamePath);
+	for (const auto& p : _additionalPaths)
+	{
+		indexRoot(p);
 	}
+	_indexBuilt = true;
+}
 
-	throw std::runtime_error("File " + path.string() + " not found");
+void DefaultFileSystem::InvalidateIndex()
+{
+	const std::lock_guard<std::mutex> lock(_indexMutex);
+	_index.clear();
+	_roots.clear();
+	_indexBuilt = false;
+}
+
+void DefaultFileSystem::AddAdditionalPath(const std::filesystem::path& path)
+{
+	_additionalPaths.push_back(path);
+	InvalidateIndex();
 }
 
 bool DefaultFileSystem::IsPathValid(const std::filesystem::path& path)
@@ -97,15 +180,7 @@ std::unique_ptr<Stream> DefaultFileSystem::Open(const std::filesystem::path& pat
 
 bool DefaultFileSystem::Exists(const std::filesystem::path& path) const
 {
-	try
-	{
-		[[maybe_unused]] auto realPath = FindPath(path);
-		return true;
-	}
-	catch (std::exception&)
-	{
-		return false;
-	}
+	return !path.empty() && Resolve(path).has_value();
 }
 
 std::vector<uint8_t> DefaultFileSystem::ReadAll(const std::filesystem::path& path)
@@ -171,6 +246,8 @@ void DefaultFileSystem::SetGamePath(const std::filesystem::path& path)
 #endif // _WIN32
 	}
 
+	InvalidateIndex();
+
 	if (!_gamePath.empty() && !Exists(_gamePath))
 	{
 		throw std::runtime_error(fmt::format("GamePath does not exist: '{}'", _gamePath.generic_string()));
@@ -10,6 +10,10 @@
 #pragma once
 
 #include <iosfwd>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "FileSystemInterface.h"
@@ -31,14 +35,28 @@ class DefaultFileSystem: public FileSystemInterface
 	[[nodiscard]] bool Exists(const std::filesystem::path& path) const override;
 	void SetGamePath(const std::filesystem::path& path) override;
 	[[nodiscard]] const std::filesystem::path& GetGamePath() const override { return _gamePath; }
-	void AddAdditionalPath(const std::filesystem::path& path) override { _additionalPaths.push_back(path); }
+	void AddAdditionalPath(const std::filesystem::path& path) override;
 	std::vector<uint8_t> ReadAll(const std::filesystem::path& path) override;
 	void Iterate(const std::filesystem::path& path, bool recursive,
 	             const std::function<void(const std::filesystem::path&)>& function) const override;
+	void InvalidateIndex() override;
 
 private:
+	/// Case insensitive form of a relative path with forward slashes, as FixPath produces
+	[[nodiscard]] static std::string IndexKey(const std::filesystem::path& path);
+	[[nodiscard]] std::optional<std::filesystem::path> Resolve(const std::filesystem::path& path) const;
+	void BuildIndex() const;
+
 	std::filesystem::path _gamePath;
 	std::vector<std::filesystem::path> _additionalPaths;
+
+	/// Every file and directory below the game path and additional paths, built on the first lookup.
+	/// The game path comes first so its files shadow the ones of additional paths.
+	mutable std::unordered_map<std::string, std::filesystem::path> _index;
+	/// Paths which were indexed, in order, to look for files created after the index was built
+	mutable std::vector<std::filesystem::path> _roots;
+	mutable bool _indexBuilt = false;
+	mutable std::mutex _indexMutex;
 };
 
 } // namespace openblack::filesystem
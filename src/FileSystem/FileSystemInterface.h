@@ -120,6 +120,9 @@ class FileSystemInterface
 	virtual std::vector<uint8_t> ReadAll(const std::filesystem::path& path) = 0;
 	virtual void Iterate(const std::filesystem::path& path, bool recursive,
 	                     const std::function<void(const std::filesystem::path&)>& function) const = 0;
+	/// Forget what is known of the files on disk. Files added while running are found without it when they are looked up
+	/// with their exact case, it is needed for files which were removed or are looked up with another case.
+	virtual void InvalidateIndex() = 0;
 };
 
 } // namespace openblack::filesystem
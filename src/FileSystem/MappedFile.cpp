@@ -0,0 +1,99 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "MappedFile.h"
+
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace openblack::filesystem;
+
+#ifdef _WIN32
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+	_file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (_file == INVALID_HANDLE_VALUE)
+	{
+		_file = nullptr;
+		throw std::runtime_error(fmt::format("Could not open {}", path.generic_string()));
+	}
+
+	LARGE_INTEGER size;
+	if (GetFileSizeEx(_file, &size) == 0 || size.QuadPart == 0)
+	{
+		CloseHandle(_file);
+		throw std::runtime_error(fmt::format("Could not get the size of {}", path.generic_string()));
+	}
+	_size = static_cast<std::size_t>(size.QuadPart);
+
+	_mapping = CreateFileMappingW(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (_mapping != nullptr)
+	{
+		_data = static_cast<const uint8_t*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+	}
+	if (_data == nullptr)
+	{
+		if (_mapping != nullptr)
+		{
+			CloseHandle(_mapping);
+		}
+		CloseHandle(_file);
+		throw std::runtime_error(fmt::format("Could not map {}", path.generic_string()));
+	}
+}
+
+MappedFile::~MappedFile()
+{
+	UnmapViewOfFile(_data);
+	CloseHandle(_mapping);
+	CloseHandle(_file);
+}
+#else
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+	const int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		throw std::runtime_error(fmt::format("Could not open {}", path.generic_string()));
+	}
+
+	struct stat status = {};
+	if (fstat(fd, &status) != 0 || status.st_size == 0)
+	{
+		close(fd);
+		throw std::runtime_error(fmt::format("Could not get the size of {}", path.generic_string()));
+	}
+	_size = static_cast<std::size_t>(status.st_size);
+
+	auto* data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// The mapping keeps its own reference to the file
+	close(fd);
+	if (data == MAP_FAILED)
+	{
+		throw std::runtime_error(fmt::format("Could not map {}", path.generic_string()));
+	}
+	_data = static_cast<const uint8_t*>(data);
+}
+
+MappedFile::~MappedFile()
+{
+	munmap(const_cast<uint8_t*>(_data), _size);
+}
+#endif
@@ -0,0 +1,41 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <filesystem>
+#include <span>
+
+namespace openblack::filesystem
+{
+
+/// Read only memory mapping of a whole file, pages are loaded by the OS as they are touched
+class MappedFile
+{
+public:
+	explicit MappedFile(const std::filesystem::path& path);
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	[[nodiscard]] std::span<const uint8_t> GetData() const { return {_data, _size}; }
+
+private:
+	const uint8_t* _data = nullptr;
+	std::size_t _size = 0;
+#ifdef _WIN32
+	void* _file = nullptr;
+	void* _mapping = nullptr;
+#endif
+};
+
+} // namespace openblack::filesystem
@@ -0,0 +1,86 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "SpanStream.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace openblack::filesystem;
+
+SpanStream::SpanStream(std::span<const uint8_t> data)
+    : _data(data)
+    , _position(0)
+{
+}
+
+std::size_t SpanStream::Position() const
+{
+	return _position;
+}
+
+std::size_t SpanStream::Size() const
+{
+	return _data.size();
+}
+
+void SpanStream::Seek(std::size_t position, SeekMode seek)
+{
+	switch (seek)
+	{
+	case SeekMode::Begin:
+		_position = position;
+		break;
+	case SeekMode::Current:
+		_position += position;
+		break;
+	case SeekMode::End:
+		_position = _data.size() + position;
+		break;
+	}
+}
+
+Stream& SpanStream::Read(uint8_t* buffer, std::size_t length)
+{
+	if (_position > _data.size() || length > _data.size() - _position)
+	{
+		throw std::runtime_error("Read past the end of stream");
+	}
+	std::copy_n(_data.data() + _position, length, buffer);
+	_position += length;
+	return *this;
+}
+
+Stream& SpanStream::Write(const uint8_t* /*buffer*/, std::size_t /*length*/)
+{
+	throw std::runtime_error("Cannot write to a read only stream");
+}
+
+std::string SpanStream::GetLine()
+{
+	const auto remaining = _data.subspan(std::min(_position, _data.size()));
+	const auto it = std::find(remaining.begin(), remaining.end(), '\n');
+
+	std::string line(remaining.begin(), it);
+	_position += line.size();
+	if (it != remaining.end())
+	{
+		++_position; // move the cursor past the '\n'
+	}
+
+	return line;
+}
+
+bool SpanStream::IsEndOfFile() const
+{
+	return Position() >= Size();
+}
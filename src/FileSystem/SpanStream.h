@@ -0,0 +1,43 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <span>
+
+#include "Stream.h"
+
+namespace openblack::filesystem
+{
+
+/// Read only stream over memory owned by someone else, such as a memory mapped archive
+class SpanStream final: public Stream
+{
+public:
+	explicit SpanStream(std::span<const uint8_t> data);
+
+	[[nodiscard]] std::size_t Position() const override;
+	[[nodiscard]] std::size_t Size() const override;
+	void Seek(std::size_t position, SeekMode seek) override;
+
+	Stream& Read(uint8_t* buffer, std::size_t length) override;
+	Stream& Write(const uint8_t* buffer, std::size_t length) override;
+
+	std::string GetLine() override;
+
+	bool IsEndOfFile() const override;
+
+private:
+	std::span<const uint8_t> _data;
+	std::size_t _position;
+};
+
+} // namespace openblack::filesystem
@@ -9,7 +9,9 @@
 
 #include "Game.h"
 
+#include <fstream>
 #include <string>
+#include <thread>
 
 #include <LHVM.h>
 #include <SDL.h>
@@ -18,8 +20,6 @@
 #include <glm/gtx/euler_angles.hpp>
 #include <glm/gtx/intersect.hpp>
 #include <glm/gtx/transform.hpp>
-#include <spdlog/sinks/basic_file_sink.h>
-#include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/spdlog.h>
 
 #include "3D/CreatureBody.h"
@@ -32,10 +32,14 @@
 #include "CHLApi.h"
 #include "Camera/Camera.h"
 #include "Common/EventManager.h"
+#include "Common/JobSystem.h"
+#include "Common/MemoryTracker.h"
 #include "Common/StringUtils.h"
 #include "Debug/DebugGuiInterface.h"
+#include "ECS/Archetypes/FeatureArchetype.h"
 #include "ECS/Archetypes/PlayerArchetype.h"
 #include "ECS/Components/CameraBookmark.h"
+#include "ECS/Components/Feature.h"
 #include "ECS/Map.h"
 #include "ECS/Registry.h"
 #include "ECS/Systems/CameraBookmarkSystemInterface.h"
@@ -45,23 +49,23 @@
 #include "ECS/Systems/PathfindingSystemInterface.h"
 #include "ECS/Systems/PlayerSystemInterface.h"
 #include "ECS/Systems/RenderingSystemInterface.h"
+#include "ECS/Systems/SpatialQuerySystemInterface.h"
 #include "EngineConfig.h"
 #include "FileSystem/FileSystemInterface.h"
 #include "Graphics/FrameBuffer.h"
 #include "Graphics/RendererInterface.h"
+#include "Graphics/TextureResidency.h"
+#include "InfoConstantsIndex.h"
 #include "Input/GameActionMapInterface.h"
 #include "LHScriptX/Script.h"
 #include "Locator.h"
 #include "Parsers/InfoFile.h"
 #include "Profiler.h"
 #include "Resources/Loaders.h"
+#include "Resources/ResourceUsage.h"
 #include "Resources/ResourcesInterface.h"
 #include "Serializer/FotFile.h"
 
-#ifdef __ANDROID__
-#include <spdlog/sinks/android_sink.h>
-#endif
-
 using namespace openblack;
 using namespace openblack::lhscriptx;
 using namespace std::chrono_literals;
@@ -75,33 +79,14 @@ Game::Game(Arguments&& args) noexcept
     , _startMap(args.startLevel)
     , _handPose(glm::identity<glm::mat4>())
     , _requestScreenshot(args.requestScreenshot)
+    , _recordInputPath(args.recordInput)
+    , _replayInputPath(args.replayInput)
+    , _profileScriptsPath(args.profileScripts)
+    , _memoryReportPath(args.memoryReport)
+    , _seed(args.seed)
 {
 	Locator::camera::emplace(glm::zero<glm::vec3>());
-	std::function<std::shared_ptr<spdlog::logger>(const std::string&)> createLogger;
-#ifdef __ANDROID__
-	if (!args.logFile.empty() && args.logFile == "logcat")
-	{
-		createLogger = [](const std::string& name) { return spdlog::android_logger_mt(name, "spdlog-android"); };
-	}
-	else
-#endif // __ANDROID__
-	{
-		if (!args.logFile.empty() && args.logFile != "stdout")
-		{
-			createLogger = [&args](const std::string& name) { return spdlog::basic_logger_mt(name, args.logFile); };
-		}
-		else
-		{
-			createLogger = [](const std::string& name) { return spdlog::stdout_color_mt(name); };
-		}
-	}
-	// TODO (#749) use std::views::enumerate
-	for (size_t i = 0; const auto& subsystem : k_LoggingSubsystemStrs)
-	{
-		auto logger = createLogger(subsystem.data());
-		logger->set_level(args.logLevels.at(i));
-		++i;
-	}
+	InitializeLoggers(args.logFile, args.logLevels, args.logAsync);
 	sInstance = this;
 
 	auto& config = Locator::config::emplace();
@@ -114,13 +99,19 @@ Game::Game(Arguments&& args) noexcept
 	config.rendererType = args.rendererType;
 	config.vsync = args.vsync;
 	config.guiScale = args.guiScale;
+	config.meshCachePath = args.meshCache;
+	config.loadFullMeshVertices = args.fullMeshVertices;
+	config.loadCompactMeshVertices = args.compactMeshVertices;
+	config.useCompactMeshVertices = args.compactMeshVertices && !args.fullMeshVertices;
+	config.numTurnsToSimulate = args.simulateTurns;
+	config.simulationSpeed = args.simulateSpeed;
 }
 
 Game::~Game() noexcept
 {
 	ShutDownServices();
 	SDL_Quit(); // todo: move to GameWindow
-	spdlog::shutdown();
+	ShutDownLoggers();
 }
 
 bool Game::ProcessEvents(const SDL_Event& event) noexcept
@@ -206,11 +197,6 @@ bool Game::ProcessEvents(const SDL_Event& event) noexcept
 			break;
 		}
 		break;
-	case SDL_MOUSEMOTION:
-	{
-		SDL_GetMouseState(&_mousePosition.x, &_mousePosition.y);
-		break;
-	}
 	case SDL_MOUSEBUTTONUP:
 		switch (event.button.button)
 		{
@@ -238,7 +224,7 @@ bool Game::GameLogicLoop() noexcept
 		return false;
 	}
 
-	const auto currentTime = std::chrono::steady_clock::now();
+	const auto currentTime = GetGameTime();
 	const auto delta = currentTime - _lastGameLoopTime;
 	const auto turnDuration = k_TurnDuration * _gameSpeedMultiplier;
 	// NOLINTNEXTLINE(modernize-use-nullptr): clang-tidy bug
@@ -247,35 +233,54 @@ bool Game::GameLogicLoop() noexcept
 		return false;
 	}
 
+	StepTurn(delta);
+	_lastGameLoopTime = currentTime;
+
+	return false;
+}
+
+void Game::StepTurn(std::chrono::steady_clock::duration delta) noexcept
+{
 	// Build Map Grid Acceleration Structure
 	Locator::entitiesMap::value().Rebuild();
 
 	auto& profiler = Locator::profiler::value();
 
 	{
+		const MemoryTracker::Scope memory(MemoryTag::Entities);
 		auto pathfinding = profiler.BeginScoped(Profiler::Stage::PathfindingUpdate);
 		Locator::pathfindingSystem::value().Update();
 	}
 	{
+		const MemoryTracker::Scope memory(MemoryTag::Entities);
 		auto actions = profiler.BeginScoped(Profiler::Stage::LivingActionUpdate);
 		Locator::livingActionSystem::value().Update();
 	}
+	{
+		const MemoryTracker::Scope memory(MemoryTag::Entities);
+		auto spatialQueries = profiler.BeginScoped(Profiler::Stage::SpatialQueryUpdate);
+		Locator::spatialQuerySystem::value().Update();
+	}
 
-	auto& lhvm = Locator::vm::value();
-	lhvm.LookIn(lhvm::ScriptType::All);
+	{
+		const MemoryTracker::Scope memory(MemoryTag::Scripting);
+		auto scripts = profiler.BeginScoped(Profiler::Stage::ScriptUpdate);
+		Locator::vm::value().LookIn(lhvm::ScriptType::All);
+	}
 
-	_lastGameLoopTime = currentTime;
 	_turnDeltaTime = delta;
 	++_turnCount;
-
-	return false;
 }
 
 bool Game::Update() noexcept
 {
 	auto& profiler = Locator::profiler::value();
+	auto& jobs = Locator::jobs::value();
 
 	profiler.Frame();
+	jobs.BeginFrame();
+	// Jobs which had to wait for the main thread, such as for uploads to bgfx, since the last frame
+	jobs.RunMainThreadJobs();
 
 	auto& camera = Locator::camera::value();
 	auto& config = Locator::config::value();
@@ -287,12 +292,14 @@ bool Game::Update() noexcept
 	{
 		current = previous;
 	}
-	auto deltaTime = std::chrono::duration_cast<std::chrono::microseconds>(current - previous);
+	auto deltaTime =
+	    config.fixedFrameDuration.value_or(std::chrono::duration_cast<std::chrono::microseconds>(current - previous));
 
 	Locator::debugGui::value().SetScale(config.guiScale);
 
 	// Physics
 	{
+		const MemoryTracker::Scope memory(MemoryTag::Physics);
 		auto physics = profiler.BeginScoped(Profiler::Stage::PhysicsUpdate);
 		if (_frameCount > 0)
 		{
@@ -305,10 +312,10 @@ bool Game::Update() noexcept
 	// Input events
 	{
 		auto sdlInput = profiler.BeginScoped(Profiler::Stage::SdlInput);
-		if (!Locator::debugGui::value().StealsFocus())
-		{
-			Locator::gameActionSystem::value().Frame();
-		}
+		auto& gameActionSystem = Locator::gameActionSystem::value();
+		gameActionSystem.Frame(!Locator::debugGui::value().StealsFocus());
+		// The hand follows the mouse position of the input so that it is recorded and replayed along with it
+		_mousePosition = glm::ivec2(gameActionSystem.GetMousePosition());
 		SDL_Event e;
 		while (SDL_PollEvent(&e) != 0)
 		{
@@ -343,8 +350,15 @@ bool Game::Update() noexcept
 		}
 	}
 
+	// Load and unload the rooms of the temple interior around the camera
+	if (Locator::temple::has_value())
+	{
+		Locator::temple::value().Update();
+	}
+
 	// Update Uniforms
 	{
+		const MemoryTracker::Scope memory(MemoryTag::Graphics);
 		auto profilerScopedUpdateUniforms = profiler.BeginScoped(Profiler::Stage::UpdateUniforms);
 
 		// Update Debug Cross
@@ -411,14 +425,15 @@ bool Game::Update() noexcept
 			auto updateEntities = profiler.BeginScoped(Profiler::Stage::UpdateEntities);
 			if (config.drawEntities)
 			{
-				Locator::rendereringSystem::value().PrepareDraw(config.drawBoundingBoxes, config.drawFootpaths,
-				                                                config.drawStreams);
+				Locator::rendereringSystem::value().PrepareDraw({config.drawBoundingBoxes, config.drawFootpaths,
+				                                                 config.drawStreams, config.drawWallHug, config.drawPhysics});
 			}
 		}
 	} // Update Uniforms
 
 	// Update Audio
 	{
+		const MemoryTracker::Scope memory(MemoryTag::Audio);
 		auto updateAudio = profiler.BeginScoped(Profiler::Stage::UpdateAudio);
 		Locator::audio::value().Update();
 	} // Update Audio
@@ -441,11 +456,17 @@ bool Game::Initialize() noexcept
 	}
 
 	using filesystem::Path;
-	if (!InitializeEngine(static_cast<uint8_t>(config.rendererType), config.vsync))
+	if (!InitializeEngine(static_cast<uint8_t>(config.rendererType), config.vsync, config.numTurnsToSimulate == 0))
 	{
 		SPDLOG_LOGGER_CRITICAL(spdlog::get("game"), "Failed to initialize engine services.");
 		return false;
 	}
+	// A game path pointing to a file is an asset archive made by packtool
+	if (std::filesystem::is_regular_file(_gamePath) && !InitializeAssetArchive(_gamePath))
+	{
+		SPDLOG_LOGGER_CRITICAL(spdlog::get("game"), "Failed to open the asset archive.");
+		return false;
+	}
 	auto& fileSystem = Locator::filesystem::value();
 	auto& events = Locator::events::value();
 
@@ -500,13 +521,31 @@ bool Game::Initialize() noexcept
 		return false;
 	}
 
+	if (!_replayInputPath.empty())
+	{
+		if (!InitializeInputReplay(_replayInputPath))
+		{
+			return false;
+		}
+	}
+	else if (!_recordInputPath.empty())
+	{
+		if (!InitializeInputRecording(_recordInputPath))
+		{
+			return false;
+		}
+	}
+	else if (config.numTurnsToSimulate > 0)
+	{
+		InitializeRandomSeed(_seed);
+	}
+
 	auto& resources = Locator::resources::value();
 	auto& meshManager = resources.GetMeshes();
 	auto& textureManager = resources.GetTextures();
 	auto& animationManager = resources.GetAnimations();
 	auto& levelManager = resources.GetLevels();
 	auto& soundManager = resources.GetSounds();
-	auto& glowManager = resources.GetGlows();
 
 	fileSystem.Iterate(
 	    fileSystem.GetPath<Path::Citadel>() / "OutsideMeshes", false, [&meshManager](const std::filesystem::path& f) {
@@ -524,43 +563,7 @@ bool Game::Initialize() noexcept
 		    }
 	    });
 
-	fileSystem.Iterate( //
-	    fileSystem.GetPath<filesystem::Path::Citadel>() / "engine", false,
-	    [&meshManager, &glowManager](const std::filesystem::path& f) {
-		    if (f.extension() == ".zzz")
-		    {
-			    if (f.stem().string().ends_with("lo_l3d"))
-			    {
-				    SPDLOG_LOGGER_WARN(
-				        spdlog::get("game"),
-				        "Skipping lo duplicate lo meshes. See https://github.com/openblack/openblack/issues/727");
-				    return;
-			    }
-			    SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading interior temple mesh: {}", f.stem().string());
-			    try
-			    {
-				    meshManager.Load(fmt::format("temple/interior/{}", f.stem().string()), resources::L3DLoader::FromDiskTag {},
-				                     f);
-			    }
-			    catch (std::runtime_error& err)
-			    {
-				    SPDLOG_LOGGER_ERROR(spdlog::get("game"), "{}", err.what());
-			    }
-		    }
-		    else if (f.extension() == ".glw")
-		    {
-			    SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading interior temple glows: {}", f.stem().string());
-			    try
-			    {
-				    glowManager.Load(fmt::format("temple/interior/glow/{}", f.stem().string()),
-				                     resources::LightLoader::FromDiskTag {}, f);
-			    }
-			    catch (std::runtime_error& err)
-			    {
-				    SPDLOG_LOGGER_ERROR(spdlog::get("game"), "{}", err.what());
-			    }
-		    }
-	    });
+	// The interior of the temple is streamed room by room once it is entered, see TempleRoomStreamer
 
 	pack::PackFile pack;
 
@@ -756,6 +759,7 @@ bool Game::Initialize() noexcept
 			return false;
 		}
 		Locator::infoConstants::reset(result.release());
+		Locator::infoConstantsIndex::emplace<InfoConstantsIndex>(Locator::infoConstants::value());
 	}
 
 	fileSystem.Iterate(fileSystem.GetPath<Path::Textures>(), false, [&textureManager](const std::filesystem::path& f) {
@@ -795,8 +799,10 @@ bool Game::Run() noexcept
 		auto& chlapi = Locator::chlapi::value();
 		auto& lhvm = Locator::vm::value();
 		lhvm.Initialise(&chlapi.GetFunctionsTable(), nullptr, nullptr, nullptr, nullptr, nullptr, nullptr);
+		lhvm.SetProfilerEnabled(!_profileScriptsPath.empty());
 		try
 		{
+			const MemoryTracker::Scope memory(MemoryTag::Scripting);
 			lhvm.LoadBinary(fileSystem.ReadAll(challengePath));
 			lhvm.StartScript("LandControlAll", lhvm::ScriptType::All);
 		}
@@ -816,6 +822,11 @@ bool Game::Run() noexcept
 	// Initialize the Acceleration Structure
 	Locator::entitiesMap::value().Rebuild();
 
+	if (config.numTurnsToSimulate > 0)
+	{
+		return Simulate();
+	}
+
 	if (Locator::windowing::has_value())
 	{
 		const auto size = static_cast<glm::u16vec2>(Locator::windowing::value().GetSize());
@@ -847,6 +858,7 @@ bool Game::Run() noexcept
 		auto duration = std::chrono::high_resolution_clock::now() - lastTime;
 		auto milliseconds = std::chrono::duration_cast<std::chrono::duration<uint32_t, std::milli>>(duration);
 		{
+			const MemoryTracker::Scope memory(MemoryTag::Graphics);
 			auto section = profiler.BeginScoped(Profiler::Stage::SceneDraw);
 
 			const graphics::RendererInterface::DrawSceneDesc drawDesc {
@@ -888,7 +900,11 @@ bool Game::Run() noexcept
 		}
 
 		{
+			const MemoryTracker::Scope memory(MemoryTag::Graphics);
 			auto section = profiler.BeginScoped(Profiler::Stage::RendererFrame);
+			// After everything of the frame was drawn so that its textures count as used
+			auto& resources = Locator::resources::value();
+			resources.GetTextureResidency().Update(resources.GetTextures(), config.textureMemoryBudget);
 			Locator::rendererInterface::value().Frame();
 		}
 
@@ -904,9 +920,134 @@ bool Game::Run() noexcept
 		_frameCount++;
 	}
 
+	WriteScriptProfile();
+
+	return true;
+}
+
+bool Game::Simulate() noexcept
+{
+	const auto& config = Locator::config::value();
+	auto& profiler = Locator::profiler::value();
+	auto& dynamicsSystem = Locator::dynamicsSystem::value();
+	auto& jobs = Locator::jobs::value();
+
+	// Turns are due every turn duration divided by the speed, or back to back without one
+	const auto interval = config.simulationSpeed > 0.0f
+	                          ? std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+	                                std::chrono::duration<float, std::milli>(k_TurnDuration) / config.simulationSpeed)
+	                          : std::chrono::steady_clock::duration::zero();
+	SPDLOG_LOGGER_INFO(GetLogger(LoggingSubsystem::game), "Simulating {} turns at {}", config.numTurnsToSimulate,
+	                   config.simulationSpeed > 0.0f ? fmt::format("{}x speed", config.simulationSpeed) : "full speed");
+
+	_paused = false;
+	profiler.ResetTotals();
+	const auto start = std::chrono::steady_clock::now();
+	auto nextTurn = start;
+	for (uint32_t turn = 0; turn < config.numTurnsToSimulate; ++turn)
+	{
+		if (interval != std::chrono::steady_clock::duration::zero())
+		{
+			std::this_thread::sleep_until(nextTurn);
+			nextTurn += interval;
+		}
+
+		profiler.Frame();
+		jobs.RunMainThreadJobs();
+		{
+			const MemoryTracker::Scope memory(MemoryTag::Physics);
+			auto physics = profiler.BeginScoped(Profiler::Stage::PhysicsUpdate);
+			auto deltaTime = std::chrono::duration_cast<std::chrono::microseconds>(k_TurnDuration);
+			dynamicsSystem.Update(deltaTime);
+			dynamicsSystem.UpdatePhysicsTransforms();
+		}
+		{
+			auto gameLogic = profiler.BeginScoped(Profiler::Stage::GameLogic);
+			StepTurn(k_TurnDuration);
+		}
+	}
+	const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+
+	const auto turnsPerSecond = static_cast<double>(config.numTurnsToSimulate) / elapsed.count();
+	const auto realTimeTurnsPerSecond = 1.0 / std::chrono::duration<double>(k_TurnDuration).count();
+	SPDLOG_LOGGER_INFO(GetLogger(LoggingSubsystem::game),
+	                   "Simulated {} turns in {:.3f} s: {:.1f} turns per second, {:.1f}x real time",
+	                   config.numTurnsToSimulate, elapsed.count(), turnsPerSecond, turnsPerSecond / realTimeTurnsPerSecond);
+	for (size_t i = 0; i < Profiler::k_StageNames.size(); ++i)
+	{
+		const auto stage = static_cast<Profiler::Stage>(i);
+		if (profiler.GetCount(stage) == 0)
+		{
+			continue;
+		}
+		const auto total = std::chrono::duration<double, std::milli>(profiler.GetTotal(stage));
+		SPDLOG_LOGGER_INFO(GetLogger(LoggingSubsystem::game), "{:<22} {:>12.3f} ms {:>10.1f} us per turn",
+		                   Profiler::k_StageNames.at(i), total.count(),
+		                   1000.0 * total.count() / static_cast<double>(config.numTurnsToSimulate));
+	}
+
+	if constexpr (MemoryTracker::k_Enabled)
+	{
+		const auto memory = profiler.GetMemoryTotals();
+		for (size_t i = 0; i < k_MemoryTagNames.size(); ++i)
+		{
+			const auto perTurn =
+			    static_cast<double>(memory.at(i).allocations) / static_cast<double>(config.numTurnsToSimulate);
+			SPDLOG_LOGGER_INFO(GetLogger(LoggingSubsystem::game), "{:<22} {:>12} allocations {:>10.1f} per turn {:>12} bytes",
+			                   k_MemoryTagNames.at(i), memory.at(i).allocations, perTurn, memory.at(i).allocatedBytes);
+		}
+	}
+
+	WriteScriptProfile();
+	WriteMemoryReport();
+
 	return true;
 }
 
+void Game::WriteMemoryReport() const
+{
+	if (_memoryReportPath.empty())
+	{
+		return;
+	}
+
+	std::ofstream stream(_memoryReportPath);
+	stream << "category,name,count,bytes,gpu_bytes\n";
+	// Allocations made while simulating, then those still live since the start, only counted in tracking builds
+	if constexpr (MemoryTracker::k_Enabled)
+	{
+		const auto simulated = Locator::profiler::value().GetMemoryTotals();
+		const auto live = MemoryTracker::GetSnapshot();
+		for (size_t i = 0; i < k_MemoryTagNames.size(); ++i)
+		{
+			stream << "allocations," << k_MemoryTagNames.at(i) << ',' << simulated.at(i).allocations << ','
+			       << simulated.at(i).allocatedBytes << ",0\n";
+		}
+		for (size_t i = 0; i < k_MemoryTagNames.size(); ++i)
+		{
+			stream << "live," << k_MemoryTagNames.at(i) << ',' << live.at(i).allocations - live.at(i).frees << ','
+			       << live.at(i).GetLiveBytes() << ",0\n";
+		}
+	}
+	for (const auto& usage : resources::GetCacheUsage(Locator::resources::value()))
+	{
+		stream << "resources," << usage.name << ',' << usage.count << ',' << usage.cpuBytes << ',' << usage.gpuBytes << '\n';
+	}
+	SPDLOG_LOGGER_INFO(GetLogger(LoggingSubsystem::game), "Wrote the memory report to {}", _memoryReportPath.generic_string());
+}
+
+void Game::WriteScriptProfile() const
+{
+	const auto& lhvm = Locator::vm::value();
+	if (const auto* scriptProfiler = lhvm.GetProfiler(); scriptProfiler != nullptr && !_profileScriptsPath.empty())
+	{
+		std::ofstream stream(_profileScriptsPath);
+		scriptProfiler->WriteCollapsedStacks(stream, lhvm.GetScripts(), lhvm.GetFunctions());
+		SPDLOG_LOGGER_INFO(spdlog::get("game"), "Wrote the script profile of {} turns to {}", scriptProfiler->GetTurns(),
+		                   _profileScriptsPath.generic_string());
+	}
+}
+
 bool Game::LoadMap(const std::filesystem::path& path) noexcept
 {
 	auto& fileSystem = Locator::filesystem::value();
@@ -950,12 +1091,85 @@ bool Game::LoadMap(const std::filesystem::path& path) noexcept
 		                   path.generic_string(), fotPath.generic_string());
 	}
 
-	_lastGameLoopTime = std::chrono::steady_clock::now();
+	_lastGameLoopTime = GetGameTime();
 	_turnDeltaTime = 0ns;
 	SetGameSpeed(Game::k_TurnDurationMultiplierNormal);
 	_turnCount = 0;
 	_paused = true;
 
+	_levelStart = SaveState();
+	_quickSave.reset();
+
+	return true;
+}
+
+void Game::QuickSave() noexcept
+{
+	_quickSave = SaveState();
+	SPDLOG_LOGGER_INFO(spdlog::get("game"), "Quick saved turn {} ({} bytes)", _turnCount, _quickSave->registry.size());
+}
+
+bool Game::QuickLoad() noexcept
+{
+	if (!_quickSave.has_value())
+	{
+		SPDLOG_LOGGER_WARN(spdlog::get("game"), "Nothing to quick load");
+		return false;
+	}
+	return RestoreState(*_quickSave);
+}
+
+bool Game::RestartLevel() noexcept
+{
+	if (!_levelStart.has_value())
+	{
+		SPDLOG_LOGGER_WARN(spdlog::get("game"), "No level loaded to restart");
+		return false;
+	}
+	if (!RestoreState(*_levelStart))
+	{
+		return false;
+	}
+	_paused = true;
+	return true;
+}
+
+Game::SavedState Game::SaveState() const
+{
+	return {Locator::entitiesRegistry::value().SaveSnapshot(), Locator::vm::value().SaveState(), _turnCount};
+}
+
+bool Game::RestoreState(const SavedState& state) noexcept
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	auto& dynamicsSystem = Locator::dynamicsSystem::value();
+
+	// The physics world points into rigid body components which loading the snapshot destroys
+	dynamicsSystem.Reset();
+	const auto loaded = registry.LoadSnapshot(state.registry);
+	if (loaded)
+	{
+		registry.Each<const ecs::components::Feature>([](entt::entity entity, const ecs::components::Feature&) {
+			ecs::archetypes::FeatureArchetype::CreateRigidBody(entity);
+		});
+	}
+	dynamicsSystem.RegisterRigidBodies();
+	dynamicsSystem.RegisterIslandRigidBodies(Locator::terrainSystem::value());
+	if (!loaded)
+	{
+		return false;
+	}
+
+	// Everything derived from the registry refers to the entities it had before, and the scripts hold their ids
+	Locator::entitiesMap::value().Rebuild();
+	Locator::pathfindingSystem::value().Reset();
+	Locator::spatialQuerySystem::value().Reset();
+	Locator::vm::value().RestoreState(lhvm::LHVMFile(state.vm));
+
+	_lastGameLoopTime = GetGameTime();
+	_turnDeltaTime = 0ns;
+	_turnCount = state.turnCount;
+
 	return true;
 }
 
@@ -987,6 +1201,16 @@ void Game::SetTime(float time) noexcept
 	Locator::skySystem::value().SetTime(time);
 }
 
+std::chrono::steady_clock::time_point Game::GetGameTime() const noexcept
+{
+	const auto& config = Locator::config::value();
+	if (config.fixedFrameDuration.has_value())
+	{
+		return std::chrono::steady_clock::time_point(*config.fixedFrameDuration * _frameCount);
+	}
+	return std::chrono::steady_clock::now();
+}
+
 void Game::RequestScreenshot(const std::filesystem::path& path) noexcept
 {
 	_requestScreenshot = std::make_pair(_frameCount, path);
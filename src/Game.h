@@ -10,15 +10,18 @@
 #pragma once
 
 #include <array>
+#include <chrono>
 #include <filesystem>
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
+#include <LHVMFile.h>
 #include <bgfx/bgfx.h>
 #include <glm/mat4x4.hpp>
-#include <spdlog/common.h>
 
+#include "Log.h"
 #include "Windowing/WindowingInterface.h" // For DisplayMode
 
 union SDL_Event;
@@ -26,29 +29,6 @@ union SDL_Event;
 namespace openblack
 {
 
-enum class LoggingSubsystem : uint8_t
-{
-	game,
-	input,
-	graphics,
-	scripting,
-	audio,
-	pathfinding,
-	ai,
-
-	_count
-};
-
-constexpr static std::array<std::string_view, static_cast<size_t>(LoggingSubsystem::_count)> k_LoggingSubsystemStrs {
-    "game",        //
-    "input",       //
-    "graphics",    //
-    "scripting",   //
-    "audio",       //
-    "pathfinding", //
-    "ai",          //
-};
-
 struct Arguments
 {
 	std::string executablePath;
@@ -61,9 +41,23 @@ struct Arguments
 	float guiScale;
 	uint32_t numFramesToSimulate;
 	std::string logFile;
-	std::array<spdlog::level::level_enum, k_LoggingSubsystemStrs.size()> logLevels;
+	LoggingLevels logLevels;
+	bool logAsync {false};
 	std::string startLevel;
 	std::optional<std::pair</* frame number */ uint32_t, /* output */ std::filesystem::path>> requestScreenshot;
+	std::filesystem::path recordInput;
+	std::filesystem::path replayInput;
+	std::filesystem::path profileScripts;
+	/// Write the allocations of each subsystem and the size of the resource caches after --simulate-turns
+	std::filesystem::path memoryReport;
+	std::filesystem::path meshCache;
+	bool fullMeshVertices {true};
+	bool compactMeshVertices {false};
+	/// Step this many turns without rendering, audio or input, then quit
+	uint32_t simulateTurns {0};
+	/// Multiple of the normal speed at which turns are simulated, as fast as possible if 0
+	float simulateSpeed {0.0f};
+	uint32_t seed {0};
 };
 
 class Game
@@ -79,12 +73,21 @@ class Game
 
 	bool ProcessEvents(const SDL_Event& event) noexcept;
 	bool GameLogicLoop() noexcept;
+	/// Advance the game logic by one turn of the given duration
+	void StepTurn(std::chrono::steady_clock::duration delta) noexcept;
 	bool Update() noexcept;
 	bool Initialize() noexcept;
 	bool Run() noexcept;
 
 	bool LoadMap(const std::filesystem::path& path) noexcept;
 	void LoadLandscape(const std::filesystem::path& path);
+	/// Keep a snapshot of the current state of the level in memory
+	void QuickSave() noexcept;
+	/// Go back to the state kept by the last quick save
+	bool QuickLoad() noexcept;
+	/// Go back to the state the level was in right after it was loaded without replaying its script
+	bool RestartLevel() noexcept;
+	[[nodiscard]] bool HasQuickSave() const { return _quickSave.has_value(); }
 
 	void SetTime(float time) noexcept;
 	void SetGameSpeed(float multiplier) { _gameSpeedMultiplier = multiplier; }
@@ -100,6 +103,22 @@ class Game
 	static Game* Instance() { return sInstance; }
 
 private:
+	struct SavedState
+	{
+		std::vector<uint8_t> registry;
+		lhvm::LHVMFile vm;
+		uint32_t turnCount;
+	};
+
+	[[nodiscard]] SavedState SaveState() const;
+	bool RestoreState(const SavedState& state) noexcept;
+	/// Step the turns of EngineConfig::numTurnsToSimulate and log the time taken by each system
+	bool Simulate() noexcept;
+	void WriteScriptProfile() const;
+	void WriteMemoryReport() const;
+	/// Measured time, or time advanced by a fixed duration per frame when replaying input
+	[[nodiscard]] std::chrono::steady_clock::time_point GetGameTime() const noexcept;
+
 	static Game* sInstance;
 
 	/// path to Lionhead Studios Ltd/Black & White folder
@@ -120,5 +139,13 @@ class Game
 	bool _handGripping;
 
 	std::optional<std::pair</* frame number */ uint32_t, /* output */ std::filesystem::path>> _requestScreenshot;
+	std::filesystem::path _recordInputPath;
+	std::filesystem::path _replayInputPath;
+	std::filesystem::path _profileScriptsPath;
+	std::filesystem::path _memoryReportPath;
+	const uint32_t _seed;
+
+	std::optional<SavedState> _levelStart;
+	std::optional<SavedState> _quickSave;
 };
 } // namespace openblack
@@ -9,6 +9,8 @@
 
 #include "DebugLines.h"
 
+#include <cstring>
+
 #include <array>
 
 #include "Mesh.h"
@@ -16,14 +18,43 @@
 
 using namespace openblack::graphics;
 
-std::unique_ptr<Mesh> DebugLines::CreateDebugLines(const Vertex* data, uint32_t vertexCount)
+namespace
+{
+VertexDecl GetVertexDecl()
 {
 	VertexDecl decl;
 	decl.reserve(2);
 	decl.emplace_back(VertexAttrib::Attribute::Position, static_cast<uint8_t>(4), VertexAttrib::Type::Float);
 	decl.emplace_back(VertexAttrib::Attribute::Color0, static_cast<uint8_t>(4), VertexAttrib::Type::Float);
+	return decl;
+}
+} // namespace
+
+const bgfx::VertexLayout& DebugLines::GetVertexLayout()
+{
+	static const auto k_Layout = getBgfxVertexLayout(GetVertexDecl());
+	return k_Layout;
+}
 
-	auto* vertexBuffer = new VertexBuffer("DebugLines", data, vertexCount, decl);
+bool DebugLines::SetTransientVertexBuffer(std::span<const Vertex> vertices)
+{
+	const auto count = static_cast<uint32_t>(vertices.size());
+	const auto& layout = GetVertexLayout();
+	if (count == 0 || bgfx::getAvailTransientVertexBuffer(count, layout) < count)
+	{
+		return false;
+	}
+
+	bgfx::TransientVertexBuffer buffer;
+	bgfx::allocTransientVertexBuffer(&buffer, count, layout);
+	std::memcpy(buffer.data, vertices.data(), vertices.size_bytes());
+	bgfx::setVertexBuffer(0, &buffer);
+	return true;
+}
+
+std::unique_ptr<Mesh> DebugLines::CreateDebugLines(const Vertex* data, uint32_t vertexCount)
+{
+	auto* vertexBuffer = new VertexBuffer("DebugLines", data, vertexCount, GetVertexDecl());
 	bgfx::frame();
 	auto mesh = std::make_unique<Mesh>(vertexBuffer, nullptr, Mesh::Topology::LineList);
 	bgfx::frame();
@@ -76,3 +107,45 @@ std::unique_ptr<Mesh> DebugLines::CreateLine(const glm::vec4& from, const glm::v
 
 	return CreateDebugLines(line.data(), static_cast<uint32_t>(line.size()));
 }
+
+DebugLineBuffer::~DebugLineBuffer()
+{
+	Reset();
+}
+
+void DebugLineBuffer::Upload(std::span<const DebugLines::Vertex> vertices)
+{
+	_vertexCount = static_cast<uint32_t>(vertices.size());
+	_valid = true;
+	if (_vertexCount == 0)
+	{
+		return;
+	}
+
+	if (!bgfx::isValid(_handle))
+	{
+		_handle = bgfx::createDynamicVertexBuffer(_vertexCount, DebugLines::GetVertexLayout(), BGFX_BUFFER_ALLOW_RESIZE);
+	}
+	bgfx::update(_handle, 0, bgfx::copy(vertices.data(), static_cast<uint32_t>(vertices.size_bytes())));
+}
+
+void DebugLineBuffer::Reset()
+{
+	if (bgfx::isValid(_handle))
+	{
+		bgfx::destroy(_handle);
+		_handle = BGFX_INVALID_HANDLE;
+	}
+	_vertexCount = 0;
+	_valid = false;
+}
+
+bool DebugLineBuffer::Bind() const
+{
+	if (_vertexCount == 0)
+	{
+		return false;
+	}
+	bgfx::setVertexBuffer(0, _handle, 0, _vertexCount);
+	return true;
+}
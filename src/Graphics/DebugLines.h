@@ -9,8 +9,12 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include <memory>
+#include <span>
 
+#include <bgfx/bgfx.h>
 #include <glm/vec4.hpp>
 
 #include "RenderPass.h"
@@ -34,6 +38,36 @@ class DebugLines
 	static std::unique_ptr<Mesh> CreateBox(const glm::vec4& color);
 	static std::unique_ptr<Mesh> CreateLine(const glm::vec4& from, const glm::vec4& to, const glm::vec4& color);
 	static std::unique_ptr<Mesh> CreateDebugLines(const Vertex* data, uint32_t vertexCount);
+
+	static const bgfx::VertexLayout& GetVertexLayout();
+	/// Copy lines to a buffer only valid for this frame and set it as the vertex buffer of the next draw call.
+	/// Returns false if there is nothing to draw or not enough transient memory left.
+	static bool SetTransientVertexBuffer(std::span<const Vertex> vertices);
+};
+
+/// Lines kept on the GPU between frames which are only rewritten when what they show changes.
+/// Unlike CreateDebugLines, the buffer is reused as it grows and uploading does not wait on frames to be rendered.
+class DebugLineBuffer
+{
+public:
+	DebugLineBuffer() = default;
+	DebugLineBuffer(const DebugLineBuffer&) = delete;
+	DebugLineBuffer& operator=(const DebugLineBuffer&) = delete;
+	~DebugLineBuffer();
+
+	void Invalidate() { _valid = false; }
+	[[nodiscard]] bool IsValid() const { return _valid; }
+	/// Replace the lines and mark the buffer valid
+	void Upload(std::span<const DebugLines::Vertex> vertices);
+	/// Free the buffer of lines which are not drawn anymore, it is rebuilt when they are drawn again
+	void Reset();
+	/// Set the lines as the vertex buffer of the next draw call, false if there is nothing to draw
+	bool Bind() const;
+
+private:
+	bgfx::DynamicVertexBufferHandle _handle {BGFX_INVALID_HANDLE};
+	uint32_t _vertexCount {0};
+	bool _valid {false};
 };
 
 } // namespace openblack::graphics
@@ -0,0 +1,250 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "MeshPool.h"
+
+#include <cassert>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+#include <spdlog/spdlog.h>
+
+using namespace openblack::graphics;
+
+MeshPool::MeshPool(std::string name, VertexDecl decl, uint32_t verticesPerPage, uint32_t indicesPerPage) noexcept
+    : _name(std::move(name))
+    , _layout(getBgfxVertexLayout(decl))
+    , _layoutHandle(bgfx::createVertexLayout(_layout))
+    , _verticesPerPage(verticesPerPage)
+    , _indicesPerPage(indicesPerPage)
+{
+}
+
+MeshPool::~MeshPool() noexcept
+{
+	Clear();
+	if (bgfx::isValid(_layoutHandle))
+	{
+		bgfx::destroy(_layoutHandle);
+	}
+}
+
+std::optional<size_t> MeshPool::FindRange(const std::vector<Range>& ranges, uint32_t count) noexcept
+{
+	const auto it = std::ranges::find_if(ranges, [count](const Range& range) { return range.count >= count; });
+	if (it == ranges.end())
+	{
+		return std::nullopt;
+	}
+	return static_cast<size_t>(std::distance(ranges.begin(), it));
+}
+
+uint32_t MeshPool::TakeRange(std::vector<Range>& ranges, size_t index, uint32_t count) noexcept
+{
+	auto& range = ranges[index];
+	const auto offset = range.offset;
+	range.offset += count;
+	range.count -= count;
+	if (range.count == 0)
+	{
+		ranges.erase(ranges.begin() + static_cast<std::ptrdiff_t>(index));
+	}
+	return offset;
+}
+
+void MeshPool::ReleaseRange(std::vector<Range>& ranges, Range range) noexcept
+{
+	auto it = std::ranges::lower_bound(ranges, range.offset, {}, &Range::offset);
+	assert(it == ranges.end() || range.offset + range.count <= it->offset);
+	it = ranges.insert(it, range);
+
+	// Merge with the following range, then with the preceding one
+	if (auto next = it + 1; next != ranges.end() && it->offset + it->count == next->offset)
+	{
+		it->count += next->count;
+		ranges.erase(next);
+	}
+	if (it != ranges.begin())
+	{
+		auto previous = it - 1;
+		if (previous->offset + previous->count == it->offset)
+		{
+			previous->count += it->count;
+			ranges.erase(it);
+		}
+	}
+}
+
+std::optional<uint16_t> MeshPool::CreatePage(uint32_t vertexCount, uint32_t indexCount)
+{
+	// Slots of destroyed pages are reused so that the page index of allocations stays small
+	auto slot = std::ranges::find_if(_pages, [](const Page& page) { return !bgfx::isValid(page.vertexBuffer); });
+	if (slot == _pages.end())
+	{
+		if (_pages.size() >= std::numeric_limits<uint16_t>::max())
+		{
+			return std::nullopt;
+		}
+		slot = _pages.insert(_pages.end(), Page {BGFX_INVALID_HANDLE, BGFX_INVALID_HANDLE, 0, 0, 0, 0, 0, {}, {}});
+	}
+	const auto index = static_cast<uint16_t>(std::distance(_pages.begin(), slot));
+
+	// Oversized meshes get a page of their own
+	const auto vertexCapacity = std::max(_verticesPerPage, vertexCount);
+	const auto indexCapacity = std::max(_indicesPerPage, indexCount);
+
+	const auto pageName = fmt::format("{}/{}", _name, index);
+	SPDLOG_LOGGER_DEBUG(spdlog::get("graphics"), "Creating mesh pool page {} with {} vertices and {} indices", pageName,
+	                    vertexCapacity, indexCapacity);
+
+	auto& page = *slot;
+	page.vertexBuffer = bgfx::createDynamicVertexBuffer(vertexCapacity, _layout);
+	page.indexBuffer = bgfx::createDynamicIndexBuffer(indexCapacity);
+	if (!bgfx::isValid(page.vertexBuffer) || !bgfx::isValid(page.indexBuffer))
+	{
+		SPDLOG_LOGGER_ERROR(spdlog::get("graphics"), "Failed to create buffers for mesh pool {}", _name);
+		DestroyPage(page);
+		return std::nullopt;
+	}
+	bgfx::setName(page.vertexBuffer, pageName.c_str());
+	bgfx::setName(page.indexBuffer, pageName.c_str());
+	page.vertexCapacity = vertexCapacity;
+	page.indexCapacity = indexCapacity;
+	page.freeVertices.push_back({0, vertexCapacity});
+	page.freeIndices.push_back({0, indexCapacity});
+
+	return index;
+}
+
+void MeshPool::DestroyPage(Page& page) noexcept
+{
+	if (bgfx::isValid(page.vertexBuffer))
+	{
+		bgfx::destroy(page.vertexBuffer);
+	}
+	if (bgfx::isValid(page.indexBuffer))
+	{
+		bgfx::destroy(page.indexBuffer);
+	}
+	_allocationCount -= page.allocationCount;
+	page = Page {BGFX_INVALID_HANDLE, BGFX_INVALID_HANDLE, 0, 0, 0, 0, 0, {}, {}};
+}
+
+std::optional<MeshPool::Allocation> MeshPool::Allocate(const bgfx::Memory* vertices, const bgfx::Memory* indices) noexcept
+{
+	assert(vertices != nullptr);
+	assert(indices != nullptr);
+
+	const auto vertexCount = vertices->size / _layout.getStride();
+	const auto indexCount = indices->size / static_cast<uint32_t>(sizeof(uint16_t));
+	if (vertexCount == 0 || indexCount == 0)
+	{
+		return std::nullopt;
+	}
+
+	// First page with a free range for both the vertices and the indices
+	std::optional<uint16_t> pageIndex;
+	size_t vertexRange = 0;
+	size_t indexRange = 0;
+	for (size_t i = 0; i < _pages.size(); ++i)
+	{
+		const auto freeVertices = FindRange(_pages[i].freeVertices, vertexCount);
+		const auto freeIndices = FindRange(_pages[i].freeIndices, indexCount);
+		if (freeVertices.has_value() && freeIndices.has_value())
+		{
+			pageIndex = static_cast<uint16_t>(i);
+			vertexRange = *freeVertices;
+			indexRange = *freeIndices;
+			break;
+		}
+	}
+	if (!pageIndex.has_value())
+	{
+		pageIndex = CreatePage(vertexCount, indexCount);
+		if (!pageIndex.has_value())
+		{
+			return std::nullopt;
+		}
+	}
+
+	auto& page = _pages[*pageIndex];
+	const Allocation allocation {
+	    *pageIndex,
+	    TakeRange(page.freeVertices, vertexRange, vertexCount),
+	    vertexCount,
+	    TakeRange(page.freeIndices, indexRange, indexCount),
+	    indexCount,
+	};
+
+	bgfx::update(page.vertexBuffer, allocation.vertexOffset, vertices);
+	bgfx::update(page.indexBuffer, allocation.indexOffset, indices);
+
+	page.vertexCount += vertexCount;
+	page.indexCount += indexCount;
+	++page.allocationCount;
+	++_allocationCount;
+
+	return allocation;
+}
+
+void MeshPool::Free(const Allocation& allocation) noexcept
+{
+	assert(allocation.page < _pages.size());
+	auto& page = _pages[allocation.page];
+	assert(bgfx::isValid(page.vertexBuffer) && page.allocationCount > 0);
+
+	// Nothing is kept in an empty page, its buffers are given back to the renderer
+	if (page.allocationCount == 1)
+	{
+		DestroyPage(page);
+		return;
+	}
+
+	ReleaseRange(page.freeVertices, {allocation.vertexOffset, allocation.vertexCount});
+	ReleaseRange(page.freeIndices, {allocation.indexOffset, allocation.indexCount});
+	page.vertexCount -= allocation.vertexCount;
+	page.indexCount -= allocation.indexCount;
+	--page.allocationCount;
+	--_allocationCount;
+}
+
+void MeshPool::Bind(const Allocation& allocation, uint32_t indexCount, uint32_t indexOffset) const
+{
+	const auto& page = _pages[allocation.page];
+	bgfx::setVertexBuffer(0, page.vertexBuffer, allocation.vertexOffset, allocation.vertexCount, _layoutHandle);
+	bgfx::setIndexBuffer(page.indexBuffer, allocation.indexOffset + indexOffset, indexCount);
+}
+
+void MeshPool::Clear() noexcept
+{
+	for (auto& page : _pages)
+	{
+		DestroyPage(page);
+	}
+	_pages.clear();
+}
+
+MeshPool::Stats MeshPool::GetStats() const noexcept
+{
+	Stats stats {0, _allocationCount, 0, 0, 0, 0};
+	for (const auto& page : _pages)
+	{
+		if (bgfx::isValid(page.vertexBuffer))
+		{
+			++stats.pageCount;
+		}
+		stats.vertexCount += page.vertexCount;
+		stats.vertexCapacity += page.vertexCapacity;
+		stats.indexCount += page.indexCount;
+		stats.indexCapacity += page.indexCapacity;
+	}
+	return stats;
+}
@@ -0,0 +1,134 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <bgfx/bgfx.h>
+
+#include "VertexBuffer.h"
+
+namespace openblack::graphics
+{
+
+/// Shared vertex and index storage for many small meshes of the same vertex layout.
+///
+/// Geometry is sub-allocated from a small number of large pages, each a pair of
+/// dynamic vertex and index buffers. Consecutive draws of different meshes living
+/// in the same page therefore bind the same buffer handles and only change their
+/// offsets, which lets bgfx skip most of the buffer state changes.
+///
+/// Indices are stored relative to the start of their allocation and are rebased
+/// on bind using the vertex stream's start vertex, so 16-bit indices are enough
+/// regardless of where in the page the mesh lands.
+///
+/// Each page keeps lists of its free vertex and index ranges. Allocations are
+/// placed in the first page with room for both and returned with \ref Free when
+/// the mesh owning them is destroyed, so meshes loaded and unloaded over and over
+/// reuse the same space. A page is destroyed once its last allocation is freed.
+class MeshPool
+{
+public:
+	struct Allocation
+	{
+		uint16_t page;
+		uint32_t vertexOffset;
+		uint32_t vertexCount;
+		uint32_t indexOffset;
+		uint32_t indexCount;
+	};
+
+	struct Stats
+	{
+		uint32_t pageCount;
+		uint32_t allocationCount;
+		uint32_t vertexCount;
+		uint32_t vertexCapacity;
+		uint32_t indexCount;
+		uint32_t indexCapacity;
+	};
+
+	static constexpr uint32_t k_DefaultVerticesPerPage = 1 << 18;
+	static constexpr uint32_t k_DefaultIndicesPerPage = 1 << 20;
+
+	MeshPool(std::string name, VertexDecl decl, uint32_t verticesPerPage = k_DefaultVerticesPerPage,
+	         uint32_t indicesPerPage = k_DefaultIndicesPerPage) noexcept;
+	~MeshPool() noexcept;
+
+	// No copying or assignment
+	MeshPool(const MeshPool&) = delete;
+	MeshPool& operator=(const MeshPool&) = delete;
+
+	/// Copy vertices and 16-bit indices into the pool.
+	/// The memory is consumed by bgfx and must not be reused by the caller.
+	[[nodiscard]] std::optional<Allocation> Allocate(const bgfx::Memory* vertices, const bgfx::Memory* indices) noexcept;
+
+	/// Return the space of an allocation to its page. The allocation must not be bound afterwards.
+	void Free(const Allocation& allocation) noexcept;
+
+	/// Set the vertex stream and an index range of an allocation for the next submit.
+	/// \param indexOffset is relative to the start of the allocation's indices.
+	void Bind(const Allocation& allocation, uint32_t indexCount, uint32_t indexOffset) const;
+
+	/// Destroy every page, outstanding allocations must not be bound or freed afterwards
+	void Clear() noexcept;
+
+	[[nodiscard]] uint32_t GetStrideBytes() const noexcept { return _layout.getStride(); }
+	/// Bytes of vertices and indices an allocation takes up in its page
+	[[nodiscard]] uint64_t GetSizeInBytes(const Allocation& allocation) const noexcept
+	{
+		return static_cast<uint64_t>(allocation.vertexCount) * GetStrideBytes() +
+		       static_cast<uint64_t>(allocation.indexCount) * sizeof(uint16_t);
+	}
+	[[nodiscard]] Stats GetStats() const noexcept;
+
+private:
+	struct Range
+	{
+		uint32_t offset;
+		uint32_t count;
+	};
+
+	/// A page without buffers is an empty slot which the next new page takes
+	struct Page
+	{
+		bgfx::DynamicVertexBufferHandle vertexBuffer;
+		bgfx::DynamicIndexBufferHandle indexBuffer;
+		uint32_t vertexCapacity;
+		uint32_t indexCapacity;
+		uint32_t vertexCount;
+		uint32_t indexCount;
+		uint32_t allocationCount;
+		/// Free ranges sorted by offset, adjacent ranges are merged
+		std::vector<Range> freeVertices;
+		std::vector<Range> freeIndices;
+	};
+
+	/// Index of the first free range with at least count elements
+	[[nodiscard]] static std::optional<size_t> FindRange(const std::vector<Range>& ranges, uint32_t count) noexcept;
+	static uint32_t TakeRange(std::vector<Range>& ranges, size_t index, uint32_t count) noexcept;
+	static void ReleaseRange(std::vector<Range>& ranges, Range range) noexcept;
+	[[nodiscard]] std::optional<uint16_t> CreatePage(uint32_t vertexCount, uint32_t indexCount);
+	void DestroyPage(Page& page) noexcept;
+
+	std::string _name;
+	bgfx::VertexLayout _layout;
+	bgfx::VertexLayoutHandle _layoutHandle;
+	uint32_t _verticesPerPage;
+	uint32_t _indicesPerPage;
+	uint32_t _allocationCount {0};
+	std::vector<Page> _pages;
+};
+
+} // namespace openblack::graphics
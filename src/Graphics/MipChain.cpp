@@ -0,0 +1,162 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "MipChain.h"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+using namespace openblack::graphics;
+
+namespace
+{
+uint16_t LevelDimension(uint16_t size, uint8_t level)
+{
+	return static_cast<uint16_t>(std::max(size >> level, 1));
+}
+
+uint8_t GetBytesPerPixel(Format format)
+{
+	switch (format)
+	{
+	case Format::A8:
+	case Format::R8:
+		return 1;
+	case Format::RGB8:
+		return 3;
+	case Format::RGBA8:
+	case Format::BGRA8:
+		return 4;
+	default:
+		throw std::runtime_error("Mip levels can only be generated for 8 bit unorm textures");
+	}
+}
+} // namespace
+
+MipChain::MipChain(uint16_t width, uint16_t height, Format format)
+    : _width(width)
+    , _height(height)
+    , _format(format)
+{
+}
+
+MipChain::MipChain(uint16_t width, uint16_t height, Format format, std::vector<uint8_t> data, uint8_t levelCount)
+    : MipChain(width, height, format)
+{
+	_data = std::move(data);
+
+	uint32_t size = 0;
+	for (uint8_t level = 0; level < levelCount; ++level)
+	{
+		const auto levelSize = GetLevelSize(LevelDimension(width, level), LevelDimension(height, level), format);
+		if (size + levelSize > _data.size())
+		{
+			break;
+		}
+		_offsets.push_back(size);
+		size += levelSize;
+	}
+
+	// bgfx only takes complete chains, partial ones are no better than a single level
+	if (_offsets.size() != CountLevels(width, height))
+	{
+		_offsets.resize(1);
+		size = GetLevelSize(width, height, format);
+	}
+	if (_data.size() < size)
+	{
+		throw std::runtime_error("Not enough data for a texture level");
+	}
+	_data.resize(size);
+}
+
+MipChain MipChain::Generate(uint16_t width, uint16_t height, Format format, std::span<const uint8_t> pixels)
+{
+	const auto bytesPerPixel = GetBytesPerPixel(format);
+	const auto levelCount = CountLevels(width, height);
+	if (pixels.size() < GetLevelSize(width, height, format))
+	{
+		throw std::runtime_error("Not enough data for a texture level");
+	}
+
+	MipChain chain(width, height, format);
+	uint32_t size = 0;
+	for (uint8_t level = 0; level < levelCount; ++level)
+	{
+		chain._offsets.push_back(size);
+		size += GetLevelSize(LevelDimension(width, level), LevelDimension(height, level), format);
+	}
+	chain._data.resize(size);
+	std::copy_n(pixels.begin(), chain._offsets.size() > 1 ? chain._offsets[1] : size, chain._data.begin());
+
+	for (uint8_t level = 1; level < levelCount; ++level)
+	{
+		const auto srcWidth = LevelDimension(width, level - 1);
+		const auto srcHeight = LevelDimension(height, level - 1);
+		const auto dstWidth = LevelDimension(width, level);
+		const auto dstHeight = LevelDimension(height, level);
+		const auto* src = chain._data.data() + chain._offsets[level - 1];
+		auto* dst = chain._data.data() + chain._offsets[level];
+
+		for (uint32_t y = 0; y < dstHeight; ++y)
+		{
+			// Odd sizes drop their last row or column, a 1 texel side is sampled twice
+			const auto y0 = std::min<uint32_t>(2 * y, srcHeight - 1);
+			const auto y1 = std::min<uint32_t>(2 * y + 1, srcHeight - 1);
+			for (uint32_t x = 0; x < dstWidth; ++x)
+			{
+				const auto x0 = std::min<uint32_t>(2 * x, srcWidth - 1);
+				const auto x1 = std::min<uint32_t>(2 * x + 1, srcWidth - 1);
+				for (uint32_t c = 0; c < bytesPerPixel; ++c)
+				{
+					const uint32_t sum = src[(y0 * srcWidth + x0) * bytesPerPixel + c] +
+					                     src[(y0 * srcWidth + x1) * bytesPerPixel + c] +
+					                     src[(y1 * srcWidth + x0) * bytesPerPixel + c] +
+					                     src[(y1 * srcWidth + x1) * bytesPerPixel + c];
+					dst[(y * dstWidth + x) * bytesPerPixel + c] = static_cast<uint8_t>((sum + 2) / 4);
+				}
+			}
+		}
+	}
+
+	return chain;
+}
+
+uint8_t MipChain::CountLevels(uint16_t width, uint16_t height)
+{
+	return static_cast<uint8_t>(std::bit_width(std::max<uint16_t>({width, height, 1})));
+}
+
+uint32_t MipChain::GetLevelSize(uint16_t width, uint16_t height, Format format)
+{
+	bgfx::TextureInfo info;
+	bgfx::calcTextureSize(info, width, height, 1, false, false, 1, getBgfxTextureFormat(format));
+	return info.storageSize;
+}
+
+uint16_t MipChain::GetWidth(uint8_t level) const
+{
+	return LevelDimension(_width, level);
+}
+
+uint16_t MipChain::GetHeight(uint8_t level) const
+{
+	return LevelDimension(_height, level);
+}
+
+uint32_t MipChain::GetSize(uint8_t firstLevel) const
+{
+	return static_cast<uint32_t>(_data.size()) - _offsets.at(firstLevel);
+}
+
+std::span<const uint8_t> MipChain::GetLevels(uint8_t firstLevel) const
+{
+	return std::span(_data).subspan(_offsets.at(firstLevel));
+}
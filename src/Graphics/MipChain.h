@@ -0,0 +1,58 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <span>
+#include <vector>
+
+#include "Texture2D.h"
+
+namespace openblack::graphics
+{
+
+/// Levels of a single layer 2D texture stored one after the other, from the full size level down to 1x1
+class MipChain
+{
+public:
+	/// Take levels which were already generated, such as those stored in a DDS file.
+	/// If data does not hold every level down to 1x1, only the first one is kept.
+	MipChain(uint16_t width, uint16_t height, Format format, std::vector<uint8_t> data, uint8_t levelCount);
+
+	/// Generate every level from uncompressed pixels of one, three or four bytes by averaging 2x2 texels
+	static MipChain Generate(uint16_t width, uint16_t height, Format format, std::span<const uint8_t> pixels);
+
+	/// Number of levels of a complete chain for a texture of that size
+	[[nodiscard]] static uint8_t CountLevels(uint16_t width, uint16_t height);
+	/// Bytes of a single level of a texture of that size
+	[[nodiscard]] static uint32_t GetLevelSize(uint16_t width, uint16_t height, Format format);
+
+	[[nodiscard]] Format GetFormat() const { return _format; }
+	[[nodiscard]] uint8_t GetLevelCount() const { return static_cast<uint8_t>(_offsets.size()); }
+	[[nodiscard]] uint16_t GetWidth(uint8_t level = 0) const;
+	[[nodiscard]] uint16_t GetHeight(uint8_t level = 0) const;
+	/// Bytes of the levels from firstLevel down to the smallest
+	[[nodiscard]] uint32_t GetSize(uint8_t firstLevel = 0) const;
+	/// Data of the levels from firstLevel down to the smallest, as expected by bgfx for a texture of that level's size
+	[[nodiscard]] std::span<const uint8_t> GetLevels(uint8_t firstLevel = 0) const;
+
+private:
+	MipChain(uint16_t width, uint16_t height, Format format);
+
+	uint16_t _width;
+	uint16_t _height;
+	Format _format;
+	std::vector<uint8_t> _data;
+	/// Offset of each level in data
+	std::vector<uint32_t> _offsets;
+};
+
+} // namespace openblack::graphics
@@ -12,10 +12,15 @@
 #include "Renderer.h"
 
 #include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <tuple>
 
 #include <SDL_video.h>
 #include <bgfx/platform.h>
 #include <bimg/bimg.h>
+#include <bx/allocator.h>
 #include <bx/file.h>
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtx/transform.hpp>
@@ -29,6 +34,7 @@
 #include "3D/OceanInterface.h"
 #include "3D/SkyInterface.h"
 #include "Camera/Camera.h"
+#include "Common/MemoryTracker.h"
 #include "ECS/Components/Mesh.h"
 #include "ECS/Components/Sprite.h"
 #include "ECS/Registry.h"
@@ -37,10 +43,12 @@
 #include "Graphics/DebugLines.h"
 #include "Graphics/FrameBuffer.h"
 #include "Graphics/IndexBuffer.h"
+#include "Graphics/MeshPool.h"
 #include "Graphics/Primitive.h"
 #include "Graphics/ShaderManager.h"
 #include "Graphics/VertexBuffer.h"
 #include "Locator.h"
+#include "Log.h"
 #include "Profiler.h"
 #include "Resources/ResourceManager.h"
 #include "Resources/ResourcesInterface.h"
@@ -77,10 +85,11 @@ struct BgfxCallback: public bgfx::CallbackI
 	void fatal(const char* filePath, uint16_t line, bgfx::Fatal::Enum code, const char* str) override
 	{
 		const auto* codeStr = k_CodeLookup.at(code).data();
-		SPDLOG_LOGGER_CRITICAL(spdlog::get("graphics"), "bgfx: {}:{}: FATAL ({}): {}", filePath, line, codeStr, str);
+		SPDLOG_LOGGER_CRITICAL(GetLogger(LoggingSubsystem::graphics), "bgfx: {}:{}: FATAL ({}): {}", filePath, line, codeStr,
+		                       str);
 
 #if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_CRITICAL
-		spdlog::get("graphics")
+		GetLogger(LoggingSubsystem::graphics)
 		    ->log(spdlog::source_loc {filePath, line, SPDLOG_FUNCTION}, spdlog::level::critical, "FATAL ({}): {}", codeStr,
 		          str);
 #endif
@@ -110,13 +119,14 @@ struct BgfxCallback: public bgfx::CallbackI
 			}
 // TODO(bwrsandman): change level to trace
 #if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG
-			spdlog::get("graphics")->log(spdlog::source_loc {filePath, line, SPDLOG_FUNCTION}, spdlog::level::debug, out);
+			GetLogger(LoggingSubsystem::graphics)
+			    ->log(spdlog::source_loc {filePath, line, SPDLOG_FUNCTION}, spdlog::level::debug, out);
 #endif
 		}
 		else
 		{
 #if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_ERROR
-			spdlog::get("graphics")
+			GetLogger(LoggingSubsystem::graphics)
 			    ->log(spdlog::source_loc {filePath, line, SPDLOG_FUNCTION}, spdlog::level::err,
 			          "bgfx: failed to format message: {}", format);
 #endif
@@ -142,7 +152,7 @@ struct BgfxCallback: public bgfx::CallbackI
 	void screenShot(const char* filePath, uint32_t width, uint32_t height, uint32_t pitch, const void* data,
 	                [[maybe_unused]] uint32_t size, bool yflip) override
 	{
-		SPDLOG_LOGGER_INFO(spdlog::get("graphics"), "Taking a screenshot...");
+		SPDLOG_LOGGER_INFO(GetLogger(LoggingSubsystem::graphics), "Taking a screenshot...");
 
 		const auto ext = std::filesystem::path(filePath).extension();
 		if (std::filesystem::path(filePath).extension() == ".png")
@@ -165,30 +175,45 @@ struct BgfxCallback: public bgfx::CallbackI
 
 				bimg::imageWritePng(&writer, width, height, pitch, noAlpha.data(), bimg::TextureFormat::BGRA8, yflip, &err);
 				bx::close(&writer);
-				SPDLOG_LOGGER_INFO(spdlog::get("graphics"), "Screenshot ({}x{}) saved at {}", width, height, filePath);
+				SPDLOG_LOGGER_INFO(GetLogger(LoggingSubsystem::graphics), "Screenshot ({}x{}) saved at {}", width, height,
+				                   filePath);
 			}
 			else
 			{
-				SPDLOG_LOGGER_ERROR(spdlog::get("graphics"), "Failed to save Screenshot ({}x{}) at {}: {}", width, height,
-				                    filePath, std::string(err.getMessage().getCPtr(), err.getMessage().getLength()));
+				SPDLOG_LOGGER_ERROR(GetLogger(LoggingSubsystem::graphics), "Failed to save Screenshot ({}x{}) at {}: {}", width,
+				                    height, filePath, std::string(err.getMessage().getCPtr(), err.getMessage().getLength()));
 			}
 		}
 		else
 		{
-			SPDLOG_LOGGER_WARN(spdlog::get("graphics"), "Not Implemented: {} screenshot ({}x{}) requested at {}", ext.string(),
-			                   width, height, filePath);
+			SPDLOG_LOGGER_WARN(GetLogger(LoggingSubsystem::graphics), "Not Implemented: {} screenshot ({}x{}) requested at {}",
+			                   ext.string(), width, height, filePath);
 		}
 	}
 	// Saving a video
 	void captureBegin(uint32_t width, uint32_t height, [[maybe_unused]] uint32_t pitch,
 	                  [[maybe_unused]] bgfx::TextureFormat::Enum format, [[maybe_unused]] bool yflip) override
 	{
-		SPDLOG_LOGGER_WARN(spdlog::get("graphics"), "Not Implemented: Video Capture Begin ({}x{}) requested", width, height);
+		SPDLOG_LOGGER_WARN(GetLogger(LoggingSubsystem::graphics), "Not Implemented: Video Capture Begin ({}x{}) requested",
+		                   width, height);
+	}
+	void captureEnd() override
+	{
+		SPDLOG_LOGGER_WARN(GetLogger(LoggingSubsystem::graphics), "Not Implemented: Video Capture End requested");
 	}
-	void captureEnd() override { SPDLOG_LOGGER_WARN(spdlog::get("graphics"), "Not Implemented: Video Capture End requested"); }
 	void captureFrame([[maybe_unused]] const void* data, [[maybe_unused]] uint32_t size) override
 	{
-		SPDLOG_LOGGER_WARN(spdlog::get("graphics"), "Not Implemented: Video Capture Frame requested");
+		SPDLOG_LOGGER_WARN(GetLogger(LoggingSubsystem::graphics), "Not Implemented: Video Capture Frame requested");
+	}
+};
+
+/// Counts the memory bgfx allocates for itself against MemoryTag::Graphics
+struct BgfxAllocator final: public bx::AllocatorI
+{
+	void* realloc(void* pointer, size_t size, size_t alignment, [[maybe_unused]] const char* filePath,
+	              [[maybe_unused]] uint32_t line) override
+	{
+		return MemoryTracker::Reallocate(pointer, size, alignment, MemoryTag::Graphics);
 	}
 };
 
@@ -223,17 +248,23 @@ std::unique_ptr<RendererInterface> RendererInterface::Create(bgfx::RendererType:
 	}
 	init.resolution.reset = bgfxReset;
 	init.callback = dynamic_cast<bgfx::CallbackI*>(bgfxCallback.get());
+	if constexpr (MemoryTracker::k_Enabled)
+	{
+		// Outlives bgfx, which frees its last allocations on shutdown
+		static BgfxAllocator sAllocator;
+		init.allocator = &sAllocator;
+	}
 
 	if (!bgfx::init(init))
 	{
-		SPDLOG_LOGGER_CRITICAL(spdlog::get("graphics"), "Failed to initialize bgfx.");
+		SPDLOG_LOGGER_CRITICAL(GetLogger(LoggingSubsystem::graphics), "Failed to initialize bgfx.");
 		return nullptr;
 	}
 
 	const bgfx::Caps* caps = bgfx::getCaps();
 	if ((caps->supported & BGFX_CAPS_TEXTURE_2D_ARRAY) == 0 || caps->limits.maxTextureLayers < 9)
 	{
-		SPDLOG_LOGGER_CRITICAL(spdlog::get("graphics"), "Graphics device must support texture layers.");
+		SPDLOG_LOGGER_CRITICAL(GetLogger(LoggingSubsystem::graphics), "Graphics device must support texture layers.");
 		return nullptr;
 	}
 
@@ -242,10 +273,19 @@ std::unique_ptr<RendererInterface> RendererInterface::Create(bgfx::RendererType:
 
 Renderer::Renderer(uint32_t bgfxReset, std::unique_ptr<BgfxCallback>&& bgfxCallback) noexcept
     : _shaderManager(std::make_unique<ShaderManager>())
+    , _l3dMeshPools({
+          std::make_unique<MeshPool>("L3DMeshPool", L3DSubMesh::GetVertexDecl(L3DVertexFormat::Full)),
+          std::make_unique<MeshPool>("L3DCompactMeshPool", L3DSubMesh::GetVertexDecl(L3DVertexFormat::Compact)),
+      })
     , _bgfxCallback(std::move(bgfxCallback))
     , _bgfxReset(bgfxReset)
 {
 	_shaderManager->LoadShaders();
+	for (const auto* name : {"Object", "ObjectInstanced", "ObjectHeightMapInstanced", "Sky"})
+	{
+		_compactVertexPrograms.emplace(_shaderManager->GetShader(name),
+		                               _shaderManager->GetShader(std::string(name) + "CompactVertices"));
+	}
 	// allocate vertex buffers for our debug draw and for primitives
 	_debugCross = DebugLines::CreateCross();
 	_plane = Primitive::CreatePlane();
@@ -264,6 +304,10 @@ Renderer::~Renderer() noexcept
 	_plane.reset();
 	_shaderManager.reset();
 	_debugCross.reset();
+	for (auto& pool : _l3dMeshPools)
+	{
+		pool.reset();
+	}
 	bgfx::frame();
 	bgfx::shutdown();
 }
@@ -284,6 +328,21 @@ graphics::ShaderManager& Renderer::GetShaderManager() const noexcept
 	return *_shaderManager;
 }
 
+graphics::MeshPool& Renderer::GetL3DMeshPool(L3DVertexFormat format) const noexcept
+{
+	return *_l3dMeshPools.at(static_cast<size_t>(format));
+}
+
+const ShaderProgram* Renderer::GetProgram(const ShaderProgram* program, L3DVertexFormat format) const
+{
+	if (format == L3DVertexFormat::Full)
+	{
+		return program;
+	}
+	const auto variant = _compactVertexPrograms.find(program);
+	return variant != _compactVertexPrograms.end() ? variant->second : nullptr;
+}
+
 void Renderer::UpdateDebugCrossUniforms(const glm::mat4& pose) noexcept
 {
 	_debugCrossPose = pose;
@@ -307,7 +366,7 @@ const Texture2D* GetTexture(uint32_t skinID, const std::unordered_map<SkinId, st
 		}
 		else
 		{
-			SPDLOG_LOGGER_ERROR(spdlog::get("graphics"), "Could not find the texture");
+			SPDLOG_LOGGER_ERROR(GetLogger(LoggingSubsystem::graphics), "Could not find the texture");
 		}
 	}
 
@@ -317,13 +376,21 @@ const Texture2D* GetTexture(uint32_t skinID, const std::unordered_map<SkinId, st
 void Renderer::DrawSubMesh(const graphics::L3DMesh& mesh, const graphics::L3DSubMesh& subMesh, const L3DMeshSubmitDesc& desc,
                            bool preserveState) const
 {
-	assert(&subMesh.GetMesh());
 	// We don't draw physics meshes, we haven't implemented statuses (building and graves) and modern GPUs can handle high lod
 	if (!desc.drawAll && (subMesh.IsPhysics() || subMesh.GetFlags().status != 0 || (subMesh.GetFlags().lodMask & 1) != 1))
 	{
 		return;
 	}
 
+	const auto preferredFormat =
+	    Locator::config::value().useCompactMeshVertices ? L3DVertexFormat::Compact : L3DVertexFormat::Full;
+	const auto vertexFormat = subMesh.SelectVertexFormat(preferredFormat);
+	const auto* program = GetProgram(desc.program, vertexFormat);
+	if (program == nullptr)
+	{
+		return;
+	}
+
 	const auto& island = Locator::terrainSystem::value();
 
 	auto extent = island.GetExtent();
@@ -353,12 +420,17 @@ void Renderer::DrawSubMesh(const graphics::L3DMesh& mesh, const graphics::L3DSub
 			}
 			if (texture != nullptr)
 			{
-				desc.program->SetTextureSampler("s_diffuse", 0, *texture);
+				program->SetTextureSampler("s_diffuse", 0, *texture);
+			}
+			if (vertexFormat == L3DVertexFormat::Compact)
+			{
+				const auto& decode = subMesh.GetVertexDecode();
+				program->SetUniformValue("u_vertexDecode", decode.data(), static_cast<uint16_t>(decode.size())); // vs
 			}
 			if (desc.morphWithTerrain)
 			{
-				desc.program->SetTextureSampler("s_heightmap", 1, heightMap);   // vs
-				desc.program->SetUniformValue("u_islandExtent", &islandExtent); // vs
+				program->SetTextureSampler("s_heightmap", 1, heightMap);   // vs
+				program->SetUniformValue("u_islandExtent", &islandExtent); // vs
 			}
 			if (!desc.isSky)
 			{
@@ -368,7 +440,7 @@ void Renderer::DrawSubMesh(const graphics::L3DMesh& mesh, const graphics::L3DSub
 				    0.0f,
 				    0.0f,
 				};
-				desc.program->SetUniformValue("u_skyAlphaThreshold", &u_skyAlphaThreshold);
+				program->SetUniformValue("u_skyAlphaThreshold", &u_skyAlphaThreshold);
 			}
 		}
 		else
@@ -382,20 +454,14 @@ void Renderer::DrawSubMesh(const graphics::L3DMesh& mesh, const graphics::L3DSub
 			{
 				bgfx::setInstanceDataBuffer(*desc.instanceBuffer, desc.instanceStart, desc.instanceCount);
 			}
-			if (subMesh.GetMesh().IsIndexed() && (skip & Mesh::SkipState::SkipIndexBuffer) == 0)
-			{
-				subMesh.GetMesh().GetIndexBuffer().Bind(prim.indicesCount, prim.indicesOffset);
-			}
-			if ((skip & Mesh::SkipState::SkipVertexBuffer) == 0)
-			{
-				subMesh.GetMesh().GetVertexBuffer().Bind();
-			}
+			// Vertex and index buffers are shared by all submeshes, only the offsets change between primitives
+			GetL3DMeshPool(vertexFormat).Bind(subMesh.GetAllocation(vertexFormat), prim.indicesCount, prim.indicesOffset);
 			if ((skip & Mesh::SkipState::SkipRenderState) == 0)
 			{
 				bgfx::setState(desc.state, desc.rgba);
 			}
 
-			bgfx::submit(static_cast<bgfx::ViewId>(desc.viewId), desc.program->GetRawHandle(), 0,
+			bgfx::submit(static_cast<bgfx::ViewId>(desc.viewId), program->GetRawHandle(), 0,
 			             primitivePreserveState ? BGFX_DISCARD_NONE : BGFX_DISCARD_ALL);
 		}
 		lastPreserveState = primitivePreserveState;
@@ -406,7 +472,8 @@ void Renderer::DrawMesh(const graphics::L3DMesh& mesh, const L3DMeshSubmitDesc&
 {
 	if (mesh.GetNumSubMeshes() == 0)
 	{
-		SPDLOG_LOGGER_WARN(spdlog::get("graphics"), "Mesh {} has no submeshes to draw", mesh.GetDebugName());
+		OPENBLACK_LOG_RATE_LIMITED(GetLogger(LoggingSubsystem::graphics), spdlog::level::warn,
+		                           "Mesh {} has no submeshes to draw", mesh.GetDebugName());
 		return;
 	}
 
@@ -416,8 +483,8 @@ void Renderer::DrawMesh(const graphics::L3DMesh& mesh, const L3DMeshSubmitDesc&
 	{
 		if (subMeshIndex >= mesh.GetNumSubMeshes())
 		{
-			SPDLOG_LOGGER_WARN(spdlog::get("graphics"), "tried to draw submesh out of range ({}/{})", subMeshIndex,
-			                   mesh.GetNumSubMeshes());
+			OPENBLACK_LOG_RATE_LIMITED(GetLogger(LoggingSubsystem::graphics), spdlog::level::warn,
+			                           "tried to draw submesh out of range ({}/{})", subMeshIndex, mesh.GetNumSubMeshes());
 		}
 
 		DrawSubMesh(mesh, *subMeshes[subMeshIndex], desc, false);
@@ -431,6 +498,135 @@ void Renderer::DrawMesh(const graphics::L3DMesh& mesh, const L3DMeshSubmitDesc&
 	}
 }
 
+void Renderer::DrawInstancedMeshes(const DrawSceneDesc& desc, uint64_t state) const
+{
+	const auto& meshManager = Locator::resources::value().GetMeshes();
+	const auto& renderCtx = Locator::rendereringSystem::value().GetContext();
+	const auto* objectShaderInstanced = _shaderManager->GetShader("ObjectInstanced");
+	const auto* objectShaderHeightMapInstanced = _shaderManager->GetShader("ObjectHeightMapInstanced");
+	const auto preferredFormat =
+	    Locator::config::value().useCompactMeshVertices ? L3DVertexFormat::Compact : L3DVertexFormat::Full;
+
+	// Identity transform shared by all non-boned meshes
+	bgfx::Transform identityTransform;
+	const auto identityCache = bgfx::allocTransform(&identityTransform, 1);
+	const auto identity = glm::mat4(1.0f);
+	std::memcpy(identityTransform.data, glm::value_ptr(identity), sizeof(identity));
+
+	// Flatten all primitives of all instanced meshes into a single list
+	_instancedDrawItems.clear();
+	for (const auto& [key, placers] : renderCtx.instancedDrawDescs)
+	{
+		auto mesh = meshManager.Handle(key.meshId);
+
+		auto transformCache = identityCache;
+		uint8_t matrixCount = 1;
+		if (mesh->IsBoned() && !mesh->GetBoneMatrices().empty())
+		{
+			// TODO(bwrsandman): Get animation frame instead of default
+			const auto& bones = mesh->GetBoneMatrices();
+			bgfx::Transform boneTransforms;
+			matrixCount = static_cast<uint8_t>(bones.size());
+			transformCache = bgfx::allocTransform(&boneTransforms, matrixCount);
+			std::memcpy(boneTransforms.data, bones.data(), sizeof(bones[0]) * matrixCount);
+		}
+
+		const auto* baseProgram = placers.morphWithTerrain ? objectShaderHeightMapInstanced : objectShaderInstanced;
+		const auto& skins = mesh->GetSkins();
+
+		for (const auto& subMesh : mesh->GetSubMeshes())
+		{
+			// We don't draw physics meshes and we haven't implemented statuses (building and graves)
+			// The level of detail was selected per instance by the rendering system
+			if (subMesh->IsPhysics() || subMesh->GetFlags().status != 0 || (subMesh->GetFlags().lodMask & (1 << key.lod)) == 0)
+			{
+				continue;
+			}
+			const auto vertexFormat = subMesh->SelectVertexFormat(preferredFormat);
+			const auto* program = GetProgram(baseProgram, vertexFormat);
+			if (program == nullptr)
+			{
+				continue;
+			}
+			const auto& primitives = subMesh->GetPrimitives();
+			for (uint32_t i = 0; i < primitives.size(); ++i)
+			{
+				_instancedDrawItems.emplace_back(InstancedDrawItem {
+				    program,
+				    GetTexture(primitives[i].skinID, skins),
+				    subMesh.get(),
+				    vertexFormat,
+				    placers.morphWithTerrain,
+				    i,
+				    transformCache,
+				    matrixCount,
+				    placers.offset,
+				    placers.count,
+				});
+			}
+		}
+	}
+
+	// Group draws sharing a program, a texture and a buffer page so that consecutive submits change as little as possible
+	const auto sortKey = [](const InstancedDrawItem& item) {
+		return std::make_tuple(item.program->GetRawHandle().idx,
+		                       item.texture != nullptr ? item.texture->GetNativeHandle().idx : bgfx::kInvalidHandle,
+		                       item.subMesh->GetAllocation(item.vertexFormat).page);
+	};
+	std::stable_sort(_instancedDrawItems.begin(), _instancedDrawItems.end(),
+	                 [&sortKey](const auto& a, const auto& b) { return sortKey(a) < sortKey(b); });
+
+	const auto& island = Locator::terrainSystem::value();
+	const auto extent = island.GetExtent();
+	const auto islandExtent = glm::vec4(extent.minimum, extent.maximum);
+	const auto skyType = Locator::skySystem::value().GetCurrentSkyType();
+
+	const ShaderProgram* lastProgram = nullptr;
+	const Texture2D* lastTexture = nullptr;
+	for (const auto& item : _instancedDrawItems)
+	{
+		const auto& prim = item.subMesh->GetPrimitives()[item.primitiveIndex];
+
+		// Bindings are kept between submits, only rebind them when they change
+		if (item.program != lastProgram)
+		{
+			if (item.morphWithTerrain)
+			{
+				item.program->SetTextureSampler("s_heightmap", 1, island.GetHeightMap()); // vs
+			}
+			lastTexture = nullptr;
+		}
+		if (item.texture != nullptr && item.texture != lastTexture)
+		{
+			item.program->SetTextureSampler("s_diffuse", 0, *item.texture);
+		}
+		lastProgram = item.program;
+		lastTexture = item.texture;
+
+		// Uniform values are not part of the draw state, set them on every submit
+		if (item.morphWithTerrain)
+		{
+			item.program->SetUniformValue("u_islandExtent", &islandExtent); // vs
+		}
+		if (item.vertexFormat == L3DVertexFormat::Compact)
+		{
+			const auto& decode = item.subMesh->GetVertexDecode();
+			item.program->SetUniformValue("u_vertexDecode", decode.data(), static_cast<uint16_t>(decode.size())); // vs
+		}
+		const glm::vec4 u_skyAlphaThreshold = {skyType, prim.thresholdAlpha ? prim.alphaCutoutThreshold : 0.0f, 0.0f, 0.0f};
+		item.program->SetUniformValue("u_skyAlphaThreshold", &u_skyAlphaThreshold);
+
+		bgfx::setTransform(item.transformCache, item.matrixCount);
+		bgfx::setInstanceDataBuffer(renderCtx.instanceUniformBuffer, item.instanceStart, item.instanceCount);
+		GetL3DMeshPool(item.vertexFormat).Bind(item.subMesh->GetAllocation(item.vertexFormat), prim.indicesCount,
+		                                       prim.indicesOffset);
+		bgfx::setState(state);
+
+		bgfx::submit(static_cast<bgfx::ViewId>(desc.viewId), item.program->GetRawHandle(), 0, BGFX_DISCARD_NONE);
+	}
+	bgfx::discard(BGFX_DISCARD_ALL);
+}
+
 void Renderer::DrawFootprintPass(const DrawSceneDesc& drawDesc) const
 {
 	const auto viewId = graphics::RenderPass::Footprint;
@@ -453,9 +649,9 @@ void Renderer::DrawFootprintPass(const DrawSceneDesc& drawDesc) const
 		const auto& meshManager = Locator::resources::value().GetMeshes();
 		const auto& renderCtx = Locator::rendereringSystem::value().GetContext();
 		const auto* footprintShaderInstanced = _shaderManager->GetShader("FootprintInstanced");
-		for (const auto& [meshId, placers] : renderCtx.instancedDrawDescs)
+		for (const auto& [key, placers] : renderCtx.instancedDrawDescs)
 		{
-			auto mesh = meshManager.Handle(meshId);
+			auto mesh = meshManager.Handle(key.meshId);
 			if (!mesh->ContainsLandscapeFeature() || mesh->GetFootprints().empty())
 			{
 				continue;
@@ -530,8 +726,6 @@ void Renderer::DrawPass(const DrawSceneDesc& desc) const
 	const auto* debugShader = _shaderManager->GetShader("DebugLine");
 	const auto* spriteShader = _shaderManager->GetShader("Sprite");
 	const auto* debugShaderInstanced = _shaderManager->GetShader("DebugLineInstanced");
-	const auto* objectShaderInstanced = _shaderManager->GetShader("ObjectInstanced");
-	const auto* objectShaderHeightMapInstanced = _shaderManager->GetShader("ObjectHeightMapInstanced");
 
 	const auto skyType = Locator::skySystem::value().GetCurrentSkyType();
 
@@ -640,56 +834,28 @@ void Renderer::DrawPass(const DrawSceneDesc& desc) const
 		                                                                          : Profiler::Stage::MainPassDrawModels);
 		if (desc.drawEntities)
 		{
-			L3DMeshSubmitDesc submitDesc = {};
-			submitDesc.viewId = desc.viewId;
-			submitDesc.program = objectShaderInstanced;
-			submitDesc.state = 0u                              //
+			const auto& renderCtx = Locator::rendereringSystem::value().GetContext();
+
+			// Instance meshes
+			const auto state = 0u                              //
 			                   | BGFX_STATE_WRITE_MASK         //
 			                   | BGFX_STATE_DEPTH_TEST_GREATER //
 			                   | BGFX_STATE_MSAA               //
 			    ;
-			const auto& renderCtx = Locator::rendereringSystem::value().GetContext();
-
-			// Instance meshes
-			for (const auto& [meshId, placers] : renderCtx.instancedDrawDescs)
-			{
-				auto mesh = meshManager.Handle(meshId);
-
-				submitDesc.instanceBuffer = &renderCtx.instanceUniformBuffer;
-				submitDesc.instanceStart = placers.offset;
-				submitDesc.instanceCount = placers.count;
-				if (mesh->IsBoned())
-				{
-					submitDesc.modelMatrices = mesh->GetBoneMatrices().data();
-					submitDesc.matrixCount = static_cast<uint8_t>(mesh->GetBoneMatrices().size());
-					// TODO(bwrsandman): Get animation frame instead of default
-				}
-				else
-				{
-					const static auto identity = glm::mat4(1.0f);
-					submitDesc.modelMatrices = &identity;
-					submitDesc.matrixCount = 1;
-				}
-				submitDesc.isSky = false;
-				submitDesc.morphWithTerrain = placers.morphWithTerrain;
-				submitDesc.program = submitDesc.morphWithTerrain ? objectShaderHeightMapInstanced : objectShaderInstanced;
-
-				// TODO(bwrsandman): choose the correct LOD
-				DrawMesh(*mesh, submitDesc, std::numeric_limits<uint8_t>::max());
-			}
+			DrawInstancedMeshes(desc, state);
 
 			// Debug
 			if (desc.viewId == graphics::RenderPass::Main)
 			{
-				for (const auto& [meshId, placers] : renderCtx.instancedDrawDescs)
+				for (const auto& [key, placers] : renderCtx.instancedDrawDescs)
 				{
-					auto mesh = meshManager.Handle(meshId);
+					auto mesh = meshManager.Handle(key.meshId);
 					if (!mesh->ContainsLandscapeFeature() || mesh->GetFootprints().empty())
 					{
 						continue;
 					}
 				}
-				if (renderCtx.boundingBox)
+				if (renderCtx.hasBoundingBoxes && renderCtx.boundingBox)
 				{
 					const auto boundBoxOffset = static_cast<uint32_t>(renderCtx.instanceUniforms.size() / 2);
 					const auto boundBoxCount = static_cast<uint32_t>(renderCtx.instanceUniforms.size() / 2);
@@ -698,15 +864,16 @@ void Renderer::DrawPass(const DrawSceneDesc& desc) const
 					bgfx::setState(k_BgfxDefaultStateInvertedZ | BGFX_STATE_PT_LINES);
 					bgfx::submit(static_cast<bgfx::ViewId>(desc.viewId), debugShaderInstanced->GetRawHandle());
 				}
-				if (renderCtx.footpaths)
+				for (const auto& layer : renderCtx.debugLayers)
 				{
-					renderCtx.footpaths->GetVertexBuffer().Bind();
-					bgfx::setState(k_BgfxDefaultStateInvertedZ | BGFX_STATE_PT_LINES);
-					bgfx::submit(static_cast<bgfx::ViewId>(desc.viewId), debugShader->GetRawHandle());
+					if (layer.Bind())
+					{
+						bgfx::setState(k_BgfxDefaultStateInvertedZ | BGFX_STATE_PT_LINES);
+						bgfx::submit(static_cast<bgfx::ViewId>(desc.viewId), debugShader->GetRawHandle());
+					}
 				}
-				if (renderCtx.streams)
+				if (DebugLines::SetTransientVertexBuffer(renderCtx.transientDebugLines))
 				{
-					renderCtx.streams->GetVertexBuffer().Bind();
 					bgfx::setState(k_BgfxDefaultStateInvertedZ | BGFX_STATE_PT_LINES);
 					bgfx::submit(static_cast<bgfx::ViewId>(desc.viewId), debugShader->GetRawHandle());
 				}
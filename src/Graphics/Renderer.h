@@ -16,6 +16,7 @@
 #include <filesystem>
 #include <memory>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include <SDL.h>
@@ -23,6 +24,7 @@
 #include <glm/fwd.hpp>
 #include <glm/mat4x4.hpp>
 
+#include "3D/L3DSubMesh.h"
 #include "Graphics/RenderPass.h"
 #include "Graphics/RendererInterface.h"
 
@@ -44,6 +46,8 @@ namespace graphics
 {
 class L3DSubMesh;
 class Mesh;
+class MeshPool;
+class Texture2D;
 
 class Renderer final: public RendererInterface
 {
@@ -52,6 +56,7 @@ class Renderer final: public RendererInterface
 	~Renderer() noexcept final;
 
 	[[nodiscard]] ShaderManager& GetShaderManager() const noexcept final;
+	[[nodiscard]] MeshPool& GetL3DMeshPool(L3DVertexFormat format) const noexcept final;
 
 	void UpdateDebugCrossUniforms(const glm::mat4& pose) noexcept final;
 
@@ -69,11 +74,31 @@ class Renderer final: public RendererInterface
 	void Reset(glm::u16vec2 resolution) const noexcept final;
 
 private:
+	/// A single primitive of an instanced mesh, sorted to minimise state changes between submits
+	struct InstancedDrawItem
+	{
+		const ShaderProgram* program;
+		const Texture2D* texture;
+		const L3DSubMesh* subMesh;
+		L3DVertexFormat vertexFormat;
+		bool morphWithTerrain;
+		uint32_t primitiveIndex;
+		uint32_t transformCache; ///< Index in bgfx's transform cache shared by all primitives of the mesh
+		uint8_t matrixCount;
+		uint32_t instanceStart;
+		uint32_t instanceCount;
+	};
+
+	/// The program itself for full vertices, its variant decoding compact vertices otherwise
+	[[nodiscard]] const ShaderProgram* GetProgram(const ShaderProgram* program, L3DVertexFormat format) const;
 	void DrawFootprintPass(const DrawSceneDesc& drawDesc) const;
 	void DrawSubMesh(const L3DMesh& mesh, const L3DSubMesh& subMesh, const L3DMeshSubmitDesc& desc, bool preserveState) const;
+	void DrawInstancedMeshes(const DrawSceneDesc& desc, uint64_t state) const;
 	void DrawPass(const DrawSceneDesc& desc) const;
 
 	std::unique_ptr<ShaderManager> _shaderManager;
+	std::array<std::unique_ptr<MeshPool>, static_cast<size_t>(L3DVertexFormat::_Count)> _l3dMeshPools;
+	std::unordered_map<const ShaderProgram*, const ShaderProgram*> _compactVertexPrograms;
 	std::unique_ptr<BgfxCallback> _bgfxCallback;
 	uint32_t _bgfxReset;
 	bool _bgfxDebug = false;
@@ -82,6 +107,9 @@ class Renderer final: public RendererInterface
 	std::unique_ptr<Mesh> _debugCross;
 	std::unique_ptr<Mesh> _plane;
 	glm::mat4 _debugCrossPose;
+
+	/// Reused between passes and frames to avoid reallocating the draw list
+	mutable std::vector<InstancedDrawItem> _instancedDrawItems;
 };
 } // namespace graphics
 } // namespace openblack
@@ -32,8 +32,10 @@ namespace openblack::graphics
 {
 class L3DMesh;
 class FrameBuffer;
+class MeshPool;
 class ShaderManager;
 class ShaderProgram;
+enum class L3DVertexFormat : uint8_t;
 
 class RendererInterface
 {
@@ -96,6 +98,8 @@ class RendererInterface
 	virtual void DrawMesh(const L3DMesh& mesh, const L3DMeshSubmitDesc& desc, uint8_t subMeshIndex) const noexcept = 0;
 	// TODO: Should shader manager be available through Locator as a service?
 	[[nodiscard]] virtual graphics::ShaderManager& GetShaderManager() const noexcept = 0;
+	/// Shared vertex and index buffers in which all L3D submeshes of a vertex format are stored
+	[[nodiscard]] virtual graphics::MeshPool& GetL3DMeshPool(L3DVertexFormat format) const noexcept = 0;
 };
 
 } // namespace openblack::graphics
@@ -57,6 +57,12 @@
 #include "ShaderIncluder.h"
 #define SHADER_NAME vs_object_hm_instanced
 #include "ShaderIncluder.h"
+#define SHADER_NAME vs_object_compact
+#include "ShaderIncluder.h"
+#define SHADER_NAME vs_object_instanced_compact
+#include "ShaderIncluder.h"
+#define SHADER_NAME vs_object_hm_instanced_compact
+#include "ShaderIncluder.h"
 #define SHADER_NAME fs_object
 #include "ShaderIncluder.h"
 #define SHADER_NAME fs_sky
@@ -93,10 +99,12 @@ struct ShaderDefinition
 	const std::string_view fragmentShaderName;
 };
 
-const std::array<bgfx::EmbeddedShader, 17> k_EmbeddedShaders = {{
+const std::array<bgfx::EmbeddedShader, 20> k_EmbeddedShaders = {{
     BGFX_EMBEDDED_SHADER(vs_line), BGFX_EMBEDDED_SHADER(vs_line_instanced),                                                   //
     BGFX_EMBEDDED_SHADER(fs_line),                                                                                            //
     BGFX_EMBEDDED_SHADER(vs_object), BGFX_EMBEDDED_SHADER(vs_object_instanced), BGFX_EMBEDDED_SHADER(vs_object_hm_instanced), //
+    BGFX_EMBEDDED_SHADER(vs_object_compact), BGFX_EMBEDDED_SHADER(vs_object_instanced_compact),                               //
+    BGFX_EMBEDDED_SHADER(vs_object_hm_instanced_compact),                                                                     //
     BGFX_EMBEDDED_SHADER(fs_object), BGFX_EMBEDDED_SHADER(fs_sky),                                                            //
     BGFX_EMBEDDED_SHADER(vs_terrain), BGFX_EMBEDDED_SHADER(fs_terrain),                                                       //
     BGFX_EMBEDDED_SHADER(vs_water), BGFX_EMBEDDED_SHADER(fs_water),                                                           //
@@ -113,6 +121,10 @@ constexpr std::array k_Shaders {
     ShaderDefinition {"ObjectInstanced", "vs_object_instanced", "fs_object"},
     ShaderDefinition {"ObjectHeightMapInstanced", "vs_object_hm_instanced", "fs_object"},
     ShaderDefinition {"Sky", "vs_object", "fs_sky"},
+    ShaderDefinition {"ObjectCompactVertices", "vs_object_compact", "fs_object"},
+    ShaderDefinition {"ObjectInstancedCompactVertices", "vs_object_instanced_compact", "fs_object"},
+    ShaderDefinition {"ObjectHeightMapInstancedCompactVertices", "vs_object_hm_instanced_compact", "fs_object"},
+    ShaderDefinition {"SkyCompactVertices", "vs_object_compact", "fs_sky"},
     ShaderDefinition {"Water", "vs_water", "fs_water"},
     ShaderDefinition {"Sprite", "vs_sprite", "fs_sprite"},
     ShaderDefinition {"FootprintInstanced", "vs_footprint_instanced", "fs_footprint"},
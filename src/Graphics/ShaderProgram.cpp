@@ -63,6 +63,7 @@ void ShaderProgram::SetTextureSampler(const char* samplerName, uint8_t bindPoint
 	if (uniform != _uniforms.cend())
 	{
 		bgfx::setTexture(bindPoint, uniform->second, texture.GetNativeHandle());
+		texture.MarkUsed();
 	}
 	else
 	{
@@ -83,12 +84,12 @@ void ShaderProgram::SetTextureSampler(const char* samplerName, uint8_t bindPoint
 	}
 }
 
-void ShaderProgram::SetUniformValue(const char* uniformName, const void* value) const
+void ShaderProgram::SetUniformValue(const char* uniformName, const void* value, uint16_t num) const
 {
 	auto uniform = _uniforms.find(uniformName);
 	if (uniform != _uniforms.cend())
 	{
-		bgfx::setUniform(uniform->second, value);
+		bgfx::setUniform(uniform->second, value, num);
 	}
 	else
 	{
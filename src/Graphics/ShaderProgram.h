@@ -36,7 +36,7 @@ class ShaderProgram
 
 	void SetTextureSampler(const char* samplerName, uint8_t bindPoint, const Texture2D& texture) const;
 	void SetTextureSampler(const char* samplerName, uint8_t bindPoint, const bgfx::TextureHandle& texture) const;
-	void SetUniformValue(const char* uniformName, const void* value) const;
+	void SetUniformValue(const char* uniformName, const void* value, uint16_t num = 1) const;
 
 	[[nodiscard]] bgfx::ProgramHandle GetRawHandle() const { return _program; }
 
@@ -17,6 +17,8 @@
 #include <spdlog/spdlog.h>
 #include <stb_image_write.h>
 
+#include "MipChain.h"
+
 namespace openblack::graphics
 {
 constexpr std::array<bgfx::TextureFormat::Enum,
@@ -95,8 +97,9 @@ Texture2D::~Texture2D()
 	}
 }
 
-void Texture2D::Create(uint16_t width, uint16_t height, uint16_t layers, Format format, Wrapping wrapping, Filter filter,
-                       const bgfx::Memory* memory) noexcept
+namespace
+{
+uint64_t GetSamplerFlags(Wrapping wrapping, Filter filter)
 {
 	uint64_t flags = BGFX_TEXTURE_NONE;
 	switch (wrapping)
@@ -123,7 +126,15 @@ void Texture2D::Create(uint16_t width, uint16_t height, uint16_t layers, Format
 	default:
 		assert(false);
 	}
-	_handle = bgfx::createTexture2D(width, height, false, layers, getBgfxTextureFormat(format), flags, memory);
+	return flags;
+}
+} // namespace
+
+void Texture2D::Create(uint16_t width, uint16_t height, uint16_t layers, Format format, Wrapping wrapping, Filter filter,
+                       const bgfx::Memory* memory) noexcept
+{
+	_flags = GetSamplerFlags(wrapping, filter);
+	_handle = bgfx::createTexture2D(width, height, false, layers, getBgfxTextureFormat(format), _flags, memory);
 	bgfx::setName(_handle, _name.c_str());
 	bgfx::frame();
 
@@ -138,6 +149,35 @@ void Texture2D::Create(uint16_t width, uint16_t height, uint16_t layers, Format
 	Texture2D::Create(width, height, layers, format, wrapping, filter, bgfx::makeRef(data, size));
 }
 
+void Texture2D::Create(Wrapping wrapping, Filter filter, std::unique_ptr<MipChain> mipChain) noexcept
+{
+	_flags = GetSamplerFlags(wrapping, filter);
+	_mipChain = std::move(mipChain);
+	SetFirstResidentMip(0);
+}
+
+void Texture2D::SetFirstResidentMip(uint8_t firstMip) noexcept
+{
+	assert(_mipChain != nullptr && firstMip < _mipChain->GetLevelCount());
+	if (bgfx::isValid(_handle))
+	{
+		bgfx::destroy(_handle);
+	}
+
+	// bgfx reads the levels when it renders the frame, after the texture or the chain may already have been destroyed, so
+	// they are copied rather than referenced
+	const auto levels = _mipChain->GetLevels(firstMip);
+	const auto width = _mipChain->GetWidth(firstMip);
+	const auto height = _mipChain->GetHeight(firstMip);
+	const auto format = getBgfxTextureFormat(_mipChain->GetFormat());
+	const bool hasMips = _mipChain->GetLevelCount() > 1;
+	_handle = bgfx::createTexture2D(width, height, hasMips, 1, format, _flags,
+	                                bgfx::copy(levels.data(), static_cast<uint32_t>(levels.size())));
+	bgfx::setName(_handle, _name.c_str());
+	bgfx::calcTextureSize(_info, width, height, 1, false, hasMips, 1, format);
+	_firstResidentMip = firstMip;
+}
+
 void Texture2D::DumpTexture() const
 {
 	assert(!_name.empty());
@@ -12,6 +12,7 @@
 #include <cstddef>
 #include <cstdint>
 
+#include <memory>
 #include <string>
 
 #include <bgfx/bgfx.h>
@@ -96,6 +97,8 @@ enum class Wrapping : uint8_t
 bgfx::TextureFormat::Enum getBgfxTextureFormat(Format format);
 
 class FrameBuffer;
+class MipChain;
+class TextureResidency;
 
 class Texture2D
 {
@@ -112,6 +115,8 @@ class Texture2D
 	void Create(uint16_t width, uint16_t height, uint16_t layers, Format format = Format::RGBA8,
 	            Wrapping wrapping = Wrapping::ClampEdge, Filter filter = Filter::Linear, const void* data = nullptr,
 	            uint32_t size = 0) noexcept;
+	/// Create a single layer texture from all levels of a chain, which is kept so that its largest levels can be dropped
+	void Create(Wrapping wrapping, Filter filter, std::unique_ptr<MipChain> mipChain) noexcept;
 
 	[[nodiscard]] const std::string& GetName() const { return _name; }
 	[[nodiscard]] const bgfx::TextureHandle& GetNativeHandle() const { return _handle; }
@@ -119,15 +124,36 @@ class Texture2D
 	[[nodiscard]] uint16_t GetHeight() const { return _info.height; }
 	[[nodiscard]] uint16_t GetLayerCount() const { return _info.numLayers; }
 	[[nodiscard]] bgfx::TextureFormat::Enum GetFormat() const { return _info.format; }
+	[[nodiscard]] uint8_t GetMipCount() const { return _info.numMips; }
+	/// Bytes of the levels uploaded to the GPU
+	[[nodiscard]] uint32_t GetSize() const { return _info.storageSize; }
+	/// Levels kept on the CPU from which the largest levels can be restored, null for textures created from raw data
+	[[nodiscard]] const MipChain* GetMipChain() const { return _mipChain.get(); }
+	/// Number of the largest levels of the mip chain which are not uploaded
+	[[nodiscard]] uint8_t GetFirstResidentMip() const { return _firstResidentMip; }
+	/// Frame of the TextureResidency at which the texture was last bound
+	[[nodiscard]] uint32_t GetLastUsedFrame() const { return _lastUsedFrame; }
+
+	/// Record that the texture is bound for a draw submitted this frame
+	void MarkUsed() const { _used = true; }
 
 	void DumpTexture() const;
 
 protected:
+	/// Upload the mip chain starting from firstMip, replacing the previous handle
+	void SetFirstResidentMip(uint8_t firstMip) noexcept;
+
 	std::string _name;
 	bgfx::TextureHandle _handle;
 	bgfx::TextureInfo _info;
+	uint64_t _flags {BGFX_TEXTURE_NONE};
+	std::unique_ptr<MipChain> _mipChain;
+	uint8_t _firstResidentMip {0};
+	uint32_t _lastUsedFrame {0};
+	mutable bool _used {false};
 
 	friend FrameBuffer;
+	friend TextureResidency;
 };
 
 } // namespace openblack::graphics
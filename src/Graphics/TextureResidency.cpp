@@ -0,0 +1,107 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "TextureResidency.h"
+
+#include <algorithm>
+
+#include "MipChain.h"
+#include "Resources/ResourcesInterface.h"
+#include "Texture2D.h"
+
+using namespace openblack::graphics;
+
+void TextureResidency::Update(std::span<Texture2D* const> textures, uint64_t budget)
+{
+	++_frame;
+	_stats = {};
+
+	for (auto* texture : textures)
+	{
+		// Textures count as used when they are first seen so that new ones are not reduced before their first draw
+		if (texture->_used || texture->_lastUsedFrame == 0)
+		{
+			texture->_lastUsedFrame = _frame;
+			texture->_used = false;
+		}
+		_stats.residentSize += texture->GetSize();
+	}
+
+	if (_stats.residentSize > budget)
+	{
+		_candidates.clear();
+		for (auto* texture : textures)
+		{
+			if (_frame - texture->_lastUsedFrame >= k_UnusedFrames && CanDropMip(*texture))
+			{
+				_candidates.push_back(texture);
+			}
+		}
+		std::sort(_candidates.begin(), _candidates.end(), [](const Texture2D* lhs, const Texture2D* rhs) {
+			if (lhs->_lastUsedFrame != rhs->_lastUsedFrame)
+			{
+				return lhs->_lastUsedFrame < rhs->_lastUsedFrame;
+			}
+			return lhs->GetSize() > rhs->GetSize();
+		});
+
+		for (auto* texture : _candidates)
+		{
+			while (_stats.residentSize > budget && CanDropMip(*texture))
+			{
+				_stats.residentSize -= texture->GetSize();
+				texture->SetFirstResidentMip(texture->_firstResidentMip + 1);
+				_stats.residentSize += texture->GetSize();
+				++_stats.droppedMips;
+			}
+			if (_stats.residentSize <= budget)
+			{
+				break;
+			}
+		}
+	}
+
+	for (auto* texture : textures)
+	{
+		const auto* mipChain = texture->GetMipChain();
+		if (mipChain != nullptr && texture->_firstResidentMip > 0 && texture->_lastUsedFrame == _frame)
+		{
+			const uint64_t restoredSize = mipChain->GetSize(texture->_firstResidentMip - 1);
+			if (_stats.residentSize - texture->GetSize() + restoredSize <= budget)
+			{
+				_stats.residentSize -= texture->GetSize();
+				texture->SetFirstResidentMip(texture->_firstResidentMip - 1);
+				_stats.residentSize += texture->GetSize();
+				++_stats.restoredMips;
+			}
+		}
+
+		_stats.fullSize += mipChain != nullptr ? mipChain->GetSize() : texture->GetSize();
+		_stats.reducedCount += texture->_firstResidentMip > 0 ? 1 : 0;
+		++_stats.textureCount;
+	}
+}
+
+void TextureResidency::Update(const resources::TextureManager& textures, uint64_t budget)
+{
+	_textures.clear();
+	textures.Each([this](entt::id_type /*unused*/, auto texture) { _textures.push_back(&*texture); });
+	Update(_textures, budget);
+}
+
+bool TextureResidency::CanDropMip(const Texture2D& texture)
+{
+	const auto* mipChain = texture.GetMipChain();
+	if (mipChain == nullptr || texture._firstResidentMip + 1 >= mipChain->GetLevelCount())
+	{
+		return false;
+	}
+	const auto nextMip = static_cast<uint8_t>(texture._firstResidentMip + 1);
+	return std::max(mipChain->GetWidth(nextMip), mipChain->GetHeight(nextMip)) >= k_MinDimension;
+}
@@ -0,0 +1,74 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <span>
+#include <vector>
+
+namespace openblack::resources
+{
+template <typename ResourceLoader>
+class ResourceManager;
+struct Texture2DLoader;
+} // namespace openblack::resources
+
+namespace openblack::graphics
+{
+class Texture2D;
+
+/**
+  Keeps the textures with a mip chain within a GPU memory budget.
+
+  Textures record when they are bound for a draw. When the textures take more than the budget, the largest levels of
+  the ones which were not bound for a while are dropped, least recently used first. A texture with dropped levels gets
+  one back on every update in which it is bound, as long as it fits in the budget.
+ */
+class TextureResidency
+{
+public:
+	/// Updates a texture must go without being bound before its largest levels can be dropped
+	static constexpr uint32_t k_UnusedFrames = 120;
+	/// Levels are not dropped past the one whose largest side is this size
+	static constexpr uint16_t k_MinDimension = 32;
+
+	struct Stats
+	{
+		/// Bytes of the levels uploaded for all textures
+		uint64_t residentSize {0};
+		/// Bytes the textures would take with all of their levels uploaded
+		uint64_t fullSize {0};
+		uint32_t textureCount {0};
+		/// Textures with some of their largest levels dropped
+		uint32_t reducedCount {0};
+		/// Levels dropped and restored by the last update
+		uint32_t droppedMips {0};
+		uint32_t restoredMips {0};
+	};
+
+	/// Account for the textures bound since the last update, then drop or restore levels, to be called once per frame
+	void Update(std::span<Texture2D* const> textures, uint64_t budget);
+	void Update(const resources::ResourceManager<resources::Texture2DLoader>& textures, uint64_t budget);
+
+	[[nodiscard]] const Stats& GetStats() const { return _stats; }
+	[[nodiscard]] uint32_t GetFrame() const { return _frame; }
+
+private:
+	[[nodiscard]] static bool CanDropMip(const Texture2D& texture);
+
+	uint32_t _frame {0};
+	Stats _stats;
+	/// Reused between updates to avoid reallocating them
+	std::vector<Texture2D*> _textures;
+	std::vector<Texture2D*> _candidates;
+};
+
+} // namespace openblack::graphics
@@ -33,6 +33,19 @@ constexpr std::array<bgfx::Attrib::Enum, 18> k_Attributes {
 
 } // namespace
 
+bgfx::VertexLayout openblack::graphics::getBgfxVertexLayout(const VertexDecl& decl)
+{
+	bgfx::VertexLayout layout;
+	layout.begin();
+	for (const auto& d : decl)
+	{
+		layout.add(k_Attributes.at(static_cast<size_t>(d.attribute)), d.num, k_Types.at(static_cast<size_t>(d.type)),
+		           d.normalized, d.asInt);
+	}
+	layout.end();
+	return layout;
+}
+
 VertexBuffer::VertexBuffer(std::string name, const void* vertices, uint32_t vertexCount, VertexDecl decl) noexcept
     : _name(std::move(name))
     , _vertexCount(vertexCount)
@@ -71,6 +71,8 @@ struct VertexAttrib
 
 using VertexDecl = std::vector<VertexAttrib>;
 
+bgfx::VertexLayout getBgfxVertexLayout(const VertexDecl& decl);
+
 class VertexBuffer
 {
 public:
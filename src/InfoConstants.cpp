@@ -11,27 +11,16 @@
 
 #include <cstring>
 
+#include "InfoConstantsIndex.h"
 #include "Locator.h"
 
 using namespace openblack;
 
 VillagerInfo GVillagerInfo::Find(Tribe tribe, VillagerNumber villagerNumber)
 {
-	bool found = false;
-	auto result = VillagerInfo::None;
-	// TODO (#749) use std::views::enumerate
-	for (size_t i = 0; const auto& villager : Locator::infoConstants::value().villager)
+	if (const auto result = Locator::infoConstantsIndex::value().FindVillager(tribe, villagerNumber))
 	{
-		if (villager.tribeType == tribe && villager.villagerNumber == villagerNumber)
-		{
-			result = static_cast<VillagerInfo>(i);
-			found = true;
-		}
-		++i;
-	}
-	if (found)
-	{
-		return result;
+		return *result;
 	}
 
 	throw std::runtime_error(std::string("Could not find info for ") + k_TribeStrs.at(static_cast<size_t>(tribe)).data() +
@@ -40,16 +29,9 @@ VillagerInfo GVillagerInfo::Find(Tribe tribe, VillagerNumber villagerNumber)
 
 AbodeInfo GAbodeInfo::Find(const std::string& name)
 {
-	// TODO (#749) use std::views::enumerate
-	for (size_t i = 0; const auto& abode : Locator::infoConstants::value().abode)
+	if (const auto result = Locator::infoConstantsIndex::value().FindAbode(name))
 	{
-		const auto tribeName = k_TribeStrs.at(static_cast<uint8_t>(abode.tribeType));
-		const auto abodeName = std::string(abode.debugString.data());
-		if (std::string(tribeName.data()) + "_" + abodeName == name)
-		{
-			return static_cast<AbodeInfo>(i);
-		}
-		++i;
+		return *result;
 	}
 
 	throw std::runtime_error("Could not find info for " + name);
@@ -57,21 +39,9 @@ AbodeInfo GAbodeInfo::Find(const std::string& name)
 
 AbodeInfo GAbodeInfo::Find(Tribe tribe, AbodeNumber abodeNumber)
 {
-	bool found = false;
-	auto result = AbodeInfo::None;
-	// TODO (#749) use std::views::enumerate
-	for (size_t i = 0; const auto& abode : Locator::infoConstants::value().abode)
-	{
-		if ((abode.tribeType == tribe || abode.tribeType == Tribe::NONE) && abode.abodeNumber == abodeNumber)
-		{
-			result = static_cast<AbodeInfo>(i);
-			found = true;
-		}
-		++i;
-	}
-	if (found)
+	if (const auto result = Locator::infoConstantsIndex::value().FindAbode(tribe, abodeNumber))
 	{
-		return result;
+		return *result;
 	}
 
 	throw std::runtime_error(std::string("Could not find info for ") + k_TribeStrs.at(static_cast<size_t>(tribe)).data() +
@@ -80,28 +50,18 @@ AbodeInfo GAbodeInfo::Find(Tribe tribe, AbodeNumber abodeNumber)
 
 FeatureInfo GFeatureInfo::Find(const std::string& name)
 {
-	// TODO (#749) use std::views::enumerate
-	for (size_t i = 0; const auto& feature : Locator::infoConstants::value().feature)
+	if (const auto result = Locator::infoConstantsIndex::value().FindFeature(name))
 	{
-		if (name == feature.debugString.data())
-		{
-			return static_cast<FeatureInfo>(i);
-		}
-		++i;
+		return *result;
 	}
 	throw std::runtime_error("Could not find info for " + name);
 }
 
 AnimatedStaticInfo GAnimatedStaticInfo::Find(const std::string& name)
 {
-	// TODO (#749) use std::views::enumerate
-	for (size_t i = 0; const auto& as : Locator::infoConstants::value().animatedStatic)
+	if (const auto result = Locator::infoConstantsIndex::value().FindAnimatedStatic(name))
 	{
-		if (name == as.debugString.data())
-		{
-			return static_cast<AnimatedStaticInfo>(i);
-		}
-		++i;
+		return *result;
 	}
 	throw std::runtime_error("Could not find info for " + name);
 }
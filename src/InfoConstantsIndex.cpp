@@ -0,0 +1,163 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "InfoConstantsIndex.h"
+
+#include <cstring>
+
+#include <fmt/format.h>
+
+#include "InfoConstants.h"
+
+using namespace openblack;
+
+namespace
+{
+std::string_view DebugString(const std::array<char, 0x30>& debugString)
+{
+	return {debugString.data(), strnlen(debugString.data(), debugString.size())};
+}
+
+/// Row of a tribe in the tables by number, or nothing for values outside of the enum
+std::optional<size_t> TribeRow(Tribe tribe)
+{
+	const auto row = static_cast<int32_t>(tribe) - static_cast<int32_t>(Tribe::NONE);
+	if (row < 0 || row > static_cast<int32_t>(Tribe::_COUNT))
+	{
+		return std::nullopt;
+	}
+	return static_cast<size_t>(row);
+}
+} // namespace
+
+InfoConstantsIndex::InfoConstantsIndex(const InfoConstants& info)
+{
+	for (auto& row : _abodesByNumber)
+	{
+		row.fill(AbodeInfo::None);
+	}
+	for (auto& row : _villagersByNumber)
+	{
+		row.fill(VillagerInfo::None);
+	}
+
+	// Later entries replace earlier ones in the tables by number, and the first entry of a name is kept, as the linear
+	// searches they replace did
+	// TODO (#749) use std::views::enumerate
+	for (size_t i = 0; const auto& abode : info.abode)
+	{
+		const auto id = static_cast<AbodeInfo>(i++);
+		const auto number = static_cast<size_t>(abode.abodeNumber);
+		if (number < static_cast<size_t>(AbodeNumber::_COUNT))
+		{
+			if (abode.tribeType == Tribe::NONE)
+			{
+				for (auto& row : _abodesByNumber)
+				{
+					row.at(number) = id;
+				}
+			}
+			else if (const auto row = TribeRow(abode.tribeType); row.has_value())
+			{
+				_abodesByNumber.at(*row).at(number) = id;
+			}
+		}
+
+		// Scripts only name the abodes of a tribe
+		if (abode.tribeType != Tribe::NONE && TribeRow(abode.tribeType).has_value())
+		{
+			const auto tribeName = k_TribeStrs.at(static_cast<size_t>(abode.tribeType));
+			_abodesByName.try_emplace(fmt::format("{}_{}", tribeName, DebugString(abode.debugString)), id);
+		}
+	}
+
+	for (size_t i = 0; const auto& villager : info.villager)
+	{
+		const auto id = static_cast<VillagerInfo>(i++);
+		const auto number = static_cast<size_t>(villager.villagerNumber);
+		const auto row = TribeRow(villager.tribeType);
+		if (row.has_value() && number < static_cast<size_t>(VillagerNumber::_COUNT))
+		{
+			_villagersByNumber.at(*row).at(number) = id;
+		}
+	}
+
+	for (size_t i = 0; const auto& feature : info.feature)
+	{
+		_featuresByName.try_emplace(std::string(DebugString(feature.debugString)), static_cast<FeatureInfo>(i++));
+	}
+
+	for (size_t i = 0; const auto& animatedStatic : info.animatedStatic)
+	{
+		_animatedStaticsByName.try_emplace(std::string(DebugString(animatedStatic.debugString)),
+		                                   static_cast<AnimatedStaticInfo>(i++));
+	}
+}
+
+std::optional<AbodeInfo> InfoConstantsIndex::FindAbode(std::string_view name) const
+{
+	const auto it = _abodesByName.find(name);
+	if (it == _abodesByName.end())
+	{
+		return std::nullopt;
+	}
+	return it->second;
+}
+
+std::optional<AbodeInfo> InfoConstantsIndex::FindAbode(Tribe tribe, AbodeNumber abodeNumber) const
+{
+	const auto row = TribeRow(tribe);
+	const auto number = static_cast<size_t>(abodeNumber);
+	if (!row.has_value() || number >= static_cast<size_t>(AbodeNumber::_COUNT))
+	{
+		return std::nullopt;
+	}
+	const auto id = _abodesByNumber.at(*row).at(number);
+	if (id == AbodeInfo::None)
+	{
+		return std::nullopt;
+	}
+	return id;
+}
+
+std::optional<VillagerInfo> InfoConstantsIndex::FindVillager(Tribe tribe, VillagerNumber villagerNumber) const
+{
+	const auto row = TribeRow(tribe);
+	const auto number = static_cast<size_t>(villagerNumber);
+	if (!row.has_value() || number >= static_cast<size_t>(VillagerNumber::_COUNT))
+	{
+		return std::nullopt;
+	}
+	const auto id = _villagersByNumber.at(*row).at(number);
+	if (id == VillagerInfo::None)
+	{
+		return std::nullopt;
+	}
+	return id;
+}
+
+std::optional<FeatureInfo> InfoConstantsIndex::FindFeature(std::string_view name) const
+{
+	const auto it = _featuresByName.find(name);
+	if (it == _featuresByName.end())
+	{
+		return std::nullopt;
+	}
+	return it->second;
+}
+
+std::optional<AnimatedStaticInfo> InfoConstantsIndex::FindAnimatedStatic(std::string_view name) const
+{
+	const auto it = _animatedStaticsByName.find(name);
+	if (it == _animatedStaticsByName.end())
+	{
+		return std::nullopt;
+	}
+	return it->second;
+}
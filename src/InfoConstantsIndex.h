@@ -0,0 +1,65 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "Enums.h"
+
+namespace openblack
+{
+namespace v120
+{
+struct InfoConstants;
+}
+using InfoConstants = v120::InfoConstants;
+
+/**
+  Lookups into the info constants by name and by number, built once after info.dat is loaded so that creating the
+  objects of a level does not scan the info arrays and build strings for every candidate.
+ */
+class InfoConstantsIndex
+{
+public:
+	explicit InfoConstantsIndex(const InfoConstants& info);
+
+	/// Abode named as in scripts, the name of its tribe and its debug string joined by an underscore
+	[[nodiscard]] std::optional<AbodeInfo> FindAbode(std::string_view name) const;
+	/// Abode of a tribe, abodes with no tribe are shared by every tribe
+	[[nodiscard]] std::optional<AbodeInfo> FindAbode(Tribe tribe, AbodeNumber abodeNumber) const;
+	[[nodiscard]] std::optional<VillagerInfo> FindVillager(Tribe tribe, VillagerNumber villagerNumber) const;
+	[[nodiscard]] std::optional<FeatureInfo> FindFeature(std::string_view name) const;
+	[[nodiscard]] std::optional<AnimatedStaticInfo> FindAnimatedStatic(std::string_view name) const;
+
+private:
+	struct NameHash
+	{
+		using is_transparent = void;
+		size_t operator()(std::string_view name) const { return std::hash<std::string_view> {}(name); }
+	};
+
+	template <typename T>
+	using NameMap = std::unordered_map<std::string, T, NameHash, std::equal_to<>>;
+
+	static constexpr size_t k_TribeCount = static_cast<size_t>(Tribe::_COUNT) + 1; ///< Tribe::NONE comes first
+
+	std::array<std::array<AbodeInfo, static_cast<size_t>(AbodeNumber::_COUNT)>, k_TribeCount> _abodesByNumber;
+	std::array<std::array<VillagerInfo, static_cast<size_t>(VillagerNumber::_COUNT)>, k_TribeCount> _villagersByNumber;
+	NameMap<AbodeInfo> _abodesByName;
+	NameMap<FeatureInfo> _featuresByName;
+	NameMap<AnimatedStaticInfo> _animatedStaticsByName;
+};
+
+} // namespace openblack
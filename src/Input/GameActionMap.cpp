@@ -20,6 +20,7 @@
 #include "ECS/Registry.h"
 #include "ECS/Systems/HandSystemInterface.h"
 #include "Locator.h"
+#include "Log.h"
 #include "Windowing/WindowingInterface.h"
 
 using namespace openblack::input;
@@ -108,8 +109,13 @@ glm::ivec2 GameActionMap::GetMouseDelta() const
 	return _mouseDelta;
 }
 
-void GameActionMap::Frame()
+void GameActionMap::Frame(bool hasFocus)
 {
+	if (!hasFocus)
+	{
+		return;
+	}
+
 	if ((SDL_GetMouseState(nullptr, nullptr) & (SDL_BUTTON_LMASK | SDL_BUTTON_RMASK)) == (SDL_BUTTON_LMASK | SDL_BUTTON_RMASK))
 	{
 		_unbindableMap = static_cast<UnbindableActionMap>(static_cast<uint8_t>(_unbindableMap) |
@@ -129,15 +135,15 @@ void GameActionMap::Frame()
 
 	if (_bindableMap != BindableActionMap::NONE || _unbindableMap != UnbindableActionMap::NONE)
 	{
-		SPDLOG_LOGGER_DEBUG(spdlog::get("input"), "GameActionMap:");
+		SPDLOG_LOGGER_DEBUG(GetLogger(LoggingSubsystem::input), "GameActionMap:");
 	}
-#define get_print(x)                                               \
-	do                                                             \
-	{                                                              \
-		if (Get(BindableActionMap::x))                             \
-		{                                                          \
-			SPDLOG_LOGGER_DEBUG(spdlog::get("input"), "\t{}", #x); \
-		}                                                          \
+#define get_print(x)                                                             \
+	do                                                                           \
+	{                                                                            \
+		if (Get(BindableActionMap::x))                                           \
+		{                                                                        \
+			SPDLOG_LOGGER_DEBUG(GetLogger(LoggingSubsystem::input), "\t{}", #x); \
+		}                                                                        \
 	} while (0)
 
 	get_print(HELP);
@@ -176,13 +182,13 @@ void GameActionMap::Frame()
 
 #undef get_print
 
-#define get_print(x)                                               \
-	do                                                             \
-	{                                                              \
-		if (Get(UnbindableActionMap::x))                           \
-		{                                                          \
-			SPDLOG_LOGGER_DEBUG(spdlog::get("input"), "\t{}", #x); \
-		}                                                          \
+#define get_print(x)                                                             \
+	do                                                                           \
+	{                                                                            \
+		if (Get(UnbindableActionMap::x))                                         \
+		{                                                                        \
+			SPDLOG_LOGGER_DEBUG(GetLogger(LoggingSubsystem::input), "\t{}", #x); \
+		}                                                                        \
 	} while (0)
 
 	get_print(DOUBLE_CLICK);
@@ -43,7 +43,7 @@ class GameActionMap final: public GameActionInterface
 	[[nodiscard]] glm::ivec2 GetMouseDelta() const final;
 	[[nodiscard]] std::array<std::optional<glm::vec3>, 2> GetHandPositions() const final;
 
-	void Frame() final;
+	void Frame(bool hasFocus) final;
 	void ProcessEvent(const SDL_Event& event) final;
 
 private:
@@ -195,7 +195,8 @@ class GameActionInterface
 	[[nodiscard]] virtual glm::ivec2 GetMouseDelta() const = 0;
 	[[nodiscard]] virtual std::array<std::optional<glm::vec3>, 2> GetHandPositions() const = 0;
 
-	virtual void Frame() = 0;
+	/// Start the next frame, without focus the game keeps seeing the input of the previous frame
+	virtual void Frame(bool hasFocus) = 0;
 	virtual void ProcessEvent(const SDL_Event& event) = 0;
 };
 } // namespace openblack::input
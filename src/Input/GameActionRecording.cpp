@@ -0,0 +1,384 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#define LOCATOR_IMPLEMENTATIONS
+
+#include "GameActionRecording.h"
+
+#include <cstring>
+
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+using namespace openblack::input;
+
+namespace
+{
+enum class FrameField : uint8_t
+{
+	Bindable = 1 << 0,
+	BindablePrevious = 1 << 1,
+	Unbindable = 1 << 2,
+	UnbindablePrevious = 1 << 3,
+	MousePosition = 1 << 4,
+	MouseDelta = 1 << 5,
+	LeftHand = 1 << 6,
+	RightHand = 1 << 7,
+};
+
+template <typename T>
+    requires std::is_trivially_copyable_v<T>
+void Write(std::ofstream& stream, const T& value)
+{
+	stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void Write(std::ofstream& stream, const std::optional<glm::vec3>& position)
+{
+	Write(stream, static_cast<uint8_t>(position.has_value()));
+	if (position.has_value())
+	{
+		Write(stream, *position);
+	}
+}
+
+template <typename T>
+    requires std::is_trivially_copyable_v<T>
+bool Read(const std::vector<uint8_t>& data, size_t& offset, T& value)
+{
+	if (data.size() - offset < sizeof(value))
+	{
+		return false;
+	}
+	std::memcpy(&value, data.data() + offset, sizeof(value));
+	offset += sizeof(value);
+	return true;
+}
+
+bool Read(const std::vector<uint8_t>& data, size_t& offset, std::optional<glm::vec3>& position)
+{
+	uint8_t hasValue;
+	if (!Read(data, offset, hasValue))
+	{
+		return false;
+	}
+	position.reset();
+	if (hasValue != 0)
+	{
+		return Read(data, offset, position.emplace());
+	}
+	return true;
+}
+} // namespace
+
+GameActionRecorder::GameActionRecorder(std::unique_ptr<GameActionInterface>&& input, const std::filesystem::path& path,
+                                       uint32_t seed, std::chrono::microseconds frameDuration)
+    : _input(std::move(input))
+    , _stream(path, std::ios::binary)
+{
+	if (!_stream.is_open())
+	{
+		throw std::runtime_error(fmt::format("Could not open {} to record input", path.string()));
+	}
+	GameActionRecordingHeader header;
+	header.seed = seed;
+	header.frameDurationMicroseconds = static_cast<uint32_t>(frameDuration.count());
+	Write(_stream, header);
+	SPDLOG_LOGGER_INFO(spdlog::get("input"), "Recording input to {} with seed {}", path.string(), seed);
+}
+
+GameActionRecorder::~GameActionRecorder()
+{
+	// The last frame is dropped, the hand system it queries is already shut down at this point
+	SPDLOG_LOGGER_INFO(spdlog::get("input"), "Recorded {} frames of input", _frameCount);
+}
+
+bool GameActionRecorder::GetBindable(BindableActionMap action) const
+{
+	return _input->GetBindable(action);
+}
+
+bool GameActionRecorder::GetUnbindable(UnbindableActionMap action) const
+{
+	return _input->GetUnbindable(action);
+}
+
+bool GameActionRecorder::GetBindableChanged(BindableActionMap action) const
+{
+	return _input->GetBindableChanged(action);
+}
+
+bool GameActionRecorder::GetUnbindableChanged(UnbindableActionMap action) const
+{
+	return _input->GetUnbindableChanged(action);
+}
+
+bool GameActionRecorder::GetBindableRepeat(BindableActionMap action) const
+{
+	return _input->GetBindableRepeat(action);
+}
+
+bool GameActionRecorder::GetUnbindableRepeat(UnbindableActionMap action) const
+{
+	return _input->GetUnbindableRepeat(action);
+}
+
+glm::uvec2 GameActionRecorder::GetMousePosition() const
+{
+	return _input->GetMousePosition();
+}
+
+glm::ivec2 GameActionRecorder::GetMouseDelta() const
+{
+	return _input->GetMouseDelta();
+}
+
+std::array<std::optional<glm::vec3>, 2> GameActionRecorder::GetHandPositions() const
+{
+	return _input->GetHandPositions();
+}
+
+void GameActionRecorder::Frame(bool hasFocus)
+{
+	// Events of a frame are processed after the call to Frame, so what the game saw is only known at the next one.
+	// Frames without focus are written too, as nothing changed they take a single byte and keep the replay in step.
+	if (_frameStarted)
+	{
+		WriteFrame();
+	}
+	_input->Frame(hasFocus);
+	_frameStarted = true;
+}
+
+void GameActionRecorder::ProcessEvent(const SDL_Event& event)
+{
+	_input->ProcessEvent(event);
+}
+
+void GameActionRecorder::WriteFrame()
+{
+	// The previous maps can only be queried through the changed and repeat masks: changed = a ^ b and repeat = a & b
+	constexpr auto k_AllBindable = static_cast<uint64_t>(BindableActionMap::ALL);
+	constexpr auto k_AllUnbindable = static_cast<uint8_t>(UnbindableActionMap::DOUBLE_CLICK) |
+	                                 static_cast<uint8_t>(UnbindableActionMap::TWO_BUTTON_CLICK);
+	uint64_t bindable = 0;
+	uint64_t bindableChanged = 0;
+	for (uint64_t bit = 1; bit <= k_AllBindable && bit != 0; bit <<= 1)
+	{
+		bindable |= _input->GetBindable(static_cast<BindableActionMap>(bit)) ? bit : 0;
+		bindableChanged |= _input->GetBindableChanged(static_cast<BindableActionMap>(bit)) ? bit : 0;
+	}
+	uint8_t unbindable = 0;
+	uint8_t unbindableChanged = 0;
+	for (uint8_t bit = 1; bit <= k_AllUnbindable; bit <<= 1)
+	{
+		unbindable |= _input->GetUnbindable(static_cast<UnbindableActionMap>(bit)) ? bit : 0;
+		unbindableChanged |= _input->GetUnbindableChanged(static_cast<UnbindableActionMap>(bit)) ? bit : 0;
+	}
+
+	const GameActionFrame frame {
+	    .bindable = static_cast<BindableActionMap>(bindable),
+	    .bindablePrevious = static_cast<BindableActionMap>(bindable ^ bindableChanged),
+	    .unbindable = static_cast<UnbindableActionMap>(unbindable),
+	    .unbindablePrevious = static_cast<UnbindableActionMap>(unbindable ^ unbindableChanged),
+	    .mousePosition = _input->GetMousePosition(),
+	    .mouseDelta = _input->GetMouseDelta(),
+	    .handPositions = _input->GetHandPositions(),
+	};
+
+	uint8_t fields = 0;
+	const auto flag = [&fields](bool changed, FrameField field) {
+		fields |= changed ? static_cast<uint8_t>(field) : 0;
+	};
+	flag(frame.bindable != _previousFrame.bindable, FrameField::Bindable);
+	flag(frame.bindablePrevious != _previousFrame.bindablePrevious, FrameField::BindablePrevious);
+	flag(frame.unbindable != _previousFrame.unbindable, FrameField::Unbindable);
+	flag(frame.unbindablePrevious != _previousFrame.unbindablePrevious, FrameField::UnbindablePrevious);
+	flag(frame.mousePosition != _previousFrame.mousePosition, FrameField::MousePosition);
+	flag(frame.mouseDelta != _previousFrame.mouseDelta, FrameField::MouseDelta);
+	flag(frame.handPositions[0] != _previousFrame.handPositions[0], FrameField::LeftHand);
+	flag(frame.handPositions[1] != _previousFrame.handPositions[1], FrameField::RightHand);
+
+	Write(_stream, fields);
+	const auto has = [fields](FrameField field) { return (fields & static_cast<uint8_t>(field)) != 0; };
+	if (has(FrameField::Bindable))
+	{
+		Write(_stream, frame.bindable);
+	}
+	if (has(FrameField::BindablePrevious))
+	{
+		Write(_stream, frame.bindablePrevious);
+	}
+	if (has(FrameField::Unbindable))
+	{
+		Write(_stream, frame.unbindable);
+	}
+	if (has(FrameField::UnbindablePrevious))
+	{
+		Write(_stream, frame.unbindablePrevious);
+	}
+	if (has(FrameField::MousePosition))
+	{
+		Write(_stream, frame.mousePosition);
+	}
+	if (has(FrameField::MouseDelta))
+	{
+		Write(_stream, frame.mouseDelta);
+	}
+	if (has(FrameField::LeftHand))
+	{
+		Write(_stream, frame.handPositions[0]);
+	}
+	if (has(FrameField::RightHand))
+	{
+		Write(_stream, frame.handPositions[1]);
+	}
+
+	_previousFrame = frame;
+	++_frameCount;
+}
+
+GameActionReplay::GameActionReplay(const std::filesystem::path& path)
+{
+	std::ifstream stream(path, std::ios::binary);
+	if (!stream.is_open())
+	{
+		throw std::runtime_error(fmt::format("Could not open input recording {}", path.string()));
+	}
+	_data.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+
+	if (!Read(_data, _offset, _header) || _header.magic != GameActionRecordingHeader::k_Magic)
+	{
+		throw std::runtime_error(fmt::format("{} is not an input recording", path.string()));
+	}
+	if (_header.version != GameActionRecordingHeader::k_Version)
+	{
+		throw std::runtime_error(fmt::format("Input recording {} has version {}, expected {}", path.string(), _header.version,
+		                                     GameActionRecordingHeader::k_Version));
+	}
+	SPDLOG_LOGGER_INFO(spdlog::get("input"), "Replaying input from {} with seed {}", path.string(), _header.seed);
+}
+
+bool GameActionReplay::GetBindable(BindableActionMap action) const
+{
+	return (static_cast<uint64_t>(_frame.bindable) & static_cast<uint64_t>(action)) != 0;
+}
+
+bool GameActionReplay::GetUnbindable(UnbindableActionMap action) const
+{
+	return (static_cast<uint8_t>(_frame.unbindable) & static_cast<uint8_t>(action)) != 0;
+}
+
+bool GameActionReplay::GetBindableChanged(BindableActionMap action) const
+{
+	return ((static_cast<uint64_t>(_frame.bindable) ^ static_cast<uint64_t>(_frame.bindablePrevious)) &
+	        static_cast<uint64_t>(action)) != 0;
+}
+
+bool GameActionReplay::GetUnbindableChanged(UnbindableActionMap action) const
+{
+	return ((static_cast<uint8_t>(_frame.unbindable) ^ static_cast<uint8_t>(_frame.unbindablePrevious)) &
+	        static_cast<uint8_t>(action)) != 0;
+}
+
+bool GameActionReplay::GetBindableRepeat(BindableActionMap action) const
+{
+	return ((static_cast<uint64_t>(_frame.bindable) & static_cast<uint64_t>(_frame.bindablePrevious)) &
+	        static_cast<uint64_t>(action)) != 0;
+}
+
+bool GameActionReplay::GetUnbindableRepeat(UnbindableActionMap action) const
+{
+	return ((static_cast<uint8_t>(_frame.unbindable) & static_cast<uint8_t>(_frame.unbindablePrevious)) &
+	        static_cast<uint8_t>(action)) != 0;
+}
+
+glm::uvec2 GameActionReplay::GetMousePosition() const
+{
+	return _frame.mousePosition;
+}
+
+glm::ivec2 GameActionReplay::GetMouseDelta() const
+{
+	return _frame.mouseDelta;
+}
+
+std::array<std::optional<glm::vec3>, 2> GameActionReplay::GetHandPositions() const
+{
+	return _frame.handPositions;
+}
+
+void GameActionReplay::Frame([[maybe_unused]] bool hasFocus)
+{
+	// Every frame was recorded, including those where the input had no focus
+	if (IsFinished())
+	{
+		_frame = {};
+		return;
+	}
+
+	uint8_t fields = 0;
+	Read(_data, _offset, fields);
+	const auto has = [fields](FrameField field) { return (fields & static_cast<uint8_t>(field)) != 0; };
+	bool good = true;
+	if (has(FrameField::Bindable))
+	{
+		good = good && Read(_data, _offset, _frame.bindable);
+	}
+	if (has(FrameField::BindablePrevious))
+	{
+		good = good && Read(_data, _offset, _frame.bindablePrevious);
+	}
+	if (has(FrameField::Unbindable))
+	{
+		good = good && Read(_data, _offset, _frame.unbindable);
+	}
+	if (has(FrameField::UnbindablePrevious))
+	{
+		good = good && Read(_data, _offset, _frame.unbindablePrevious);
+	}
+	if (has(FrameField::MousePosition))
+	{
+		good = good && Read(_data, _offset, _frame.mousePosition);
+	}
+	if (has(FrameField::MouseDelta))
+	{
+		good = good && Read(_data, _offset, _frame.mouseDelta);
+	}
+	if (has(FrameField::LeftHand))
+	{
+		good = good && Read(_data, _offset, _frame.handPositions[0]);
+	}
+	if (has(FrameField::RightHand))
+	{
+		good = good && Read(_data, _offset, _frame.handPositions[1]);
+	}
+
+	if (!good)
+	{
+		SPDLOG_LOGGER_WARN(spdlog::get("input"), "Input recording is truncated at frame {}", _frameCount);
+		_offset = _data.size();
+		_frame = {};
+		return;
+	}
+	++_frameCount;
+	if (IsFinished())
+	{
+		SPDLOG_LOGGER_INFO(spdlog::get("input"), "Input replay finished after {} frames", _frameCount);
+	}
+}
+
+void GameActionReplay::ProcessEvent([[maybe_unused]] const SDL_Event& event)
+{
+	// The user's input is ignored while replaying
+}
@@ -0,0 +1,135 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include "GameActionMapInterface.h"
+
+#if !defined(LOCATOR_IMPLEMENTATIONS)
+#error "Locator interface implementations should only be included in Locator.cpp"
+#endif
+
+namespace openblack::input
+{
+/// Everything a GameActionInterface exposes for one frame
+struct GameActionFrame
+{
+	BindableActionMap bindable = BindableActionMap::NONE;
+	BindableActionMap bindablePrevious = BindableActionMap::NONE;
+	UnbindableActionMap unbindable = UnbindableActionMap::NONE;
+	UnbindableActionMap unbindablePrevious = UnbindableActionMap::NONE;
+	glm::uvec2 mousePosition {0, 0};
+	glm::ivec2 mouseDelta {0, 0};
+	std::array<std::optional<glm::vec3>, 2> handPositions;
+
+	bool operator==(const GameActionFrame&) const = default;
+};
+
+/// Header of a recording file, frames follow until the end of the file.
+///
+/// Each frame starts with a byte flagging which fields changed since the previous frame followed by these fields only,
+/// which keeps idle frames to a single byte.
+struct GameActionRecordingHeader
+{
+	static constexpr uint32_t k_Magic = 0x5249424F; // "OBIR" little endian
+	static constexpr uint32_t k_Version = 1;
+	/// Time between frames of a recorded session unless the game already runs with a fixed frame duration
+	static constexpr auto k_DefaultFrameDuration = std::chrono::microseconds(16667);
+
+	uint32_t magic = k_Magic;
+	uint32_t version = k_Version;
+	uint32_t seed;
+	uint32_t frameDurationMicroseconds = static_cast<uint32_t>(k_DefaultFrameDuration.count());
+};
+
+/// Forwards to the user's input and writes the state of every frame to a file.
+///
+/// The game must advance every frame by frameDuration while recording, replays advance by the same duration.
+class GameActionRecorder final: public GameActionInterface
+{
+public:
+	GameActionRecorder(std::unique_ptr<GameActionInterface>&& input, const std::filesystem::path& path, uint32_t seed,
+	                   std::chrono::microseconds frameDuration);
+	GameActionRecorder(const GameActionRecorder&) = delete;
+	GameActionRecorder& operator=(const GameActionRecorder&) = delete;
+	~GameActionRecorder();
+
+	[[nodiscard]] bool GetBindable(BindableActionMap action) const final;
+	[[nodiscard]] bool GetUnbindable(UnbindableActionMap action) const final;
+	[[nodiscard]] bool GetBindableChanged(BindableActionMap action) const final;
+	[[nodiscard]] bool GetUnbindableChanged(UnbindableActionMap action) const final;
+	[[nodiscard]] bool GetBindableRepeat(BindableActionMap action) const final;
+	[[nodiscard]] bool GetUnbindableRepeat(UnbindableActionMap action) const final;
+	[[nodiscard]] glm::uvec2 GetMousePosition() const final;
+	[[nodiscard]] glm::ivec2 GetMouseDelta() const final;
+	[[nodiscard]] std::array<std::optional<glm::vec3>, 2> GetHandPositions() const final;
+
+	void Frame(bool hasFocus) final;
+	void ProcessEvent(const SDL_Event& event) final;
+
+private:
+	/// Write the state the game saw during the frame which just ended
+	void WriteFrame();
+
+	std::unique_ptr<GameActionInterface> _input;
+	std::ofstream _stream;
+	GameActionFrame _previousFrame;
+	bool _frameStarted = false;
+	uint32_t _frameCount = 0;
+};
+
+/// Replaces the user's input with the frames of a recording, the input is released once the recording ends
+class GameActionReplay final: public GameActionInterface
+{
+public:
+	explicit GameActionReplay(const std::filesystem::path& path);
+	GameActionReplay(const GameActionReplay&) = delete;
+	GameActionReplay& operator=(const GameActionReplay&) = delete;
+
+	[[nodiscard]] bool GetBindable(BindableActionMap action) const final;
+	[[nodiscard]] bool GetUnbindable(UnbindableActionMap action) const final;
+	[[nodiscard]] bool GetBindableChanged(BindableActionMap action) const final;
+	[[nodiscard]] bool GetUnbindableChanged(UnbindableActionMap action) const final;
+	[[nodiscard]] bool GetBindableRepeat(BindableActionMap action) const final;
+	[[nodiscard]] bool GetUnbindableRepeat(UnbindableActionMap action) const final;
+	[[nodiscard]] glm::uvec2 GetMousePosition() const final;
+	[[nodiscard]] glm::ivec2 GetMouseDelta() const final;
+	[[nodiscard]] std::array<std::optional<glm::vec3>, 2> GetHandPositions() const final;
+
+	void Frame(bool hasFocus) final;
+	void ProcessEvent(const SDL_Event& event) final;
+
+	[[nodiscard]] uint32_t GetSeed() const { return _header.seed; }
+	[[nodiscard]] std::chrono::microseconds GetFrameDuration() const
+	{
+		return std::chrono::microseconds(_header.frameDurationMicroseconds);
+	}
+	[[nodiscard]] bool IsFinished() const { return _offset >= _data.size(); }
+
+private:
+	GameActionRecordingHeader _header;
+	std::vector<uint8_t> _data;
+	size_t _offset = 0;
+	GameActionFrame _frame;
+	uint32_t _frameCount = 0;
+};
+} // namespace openblack::input
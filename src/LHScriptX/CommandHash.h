@@ -0,0 +1,135 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
+namespace openblack::lhscriptx
+{
+
+/// Minimal perfect hash of a fixed set of command names, built with hash and displace.
+/// Names are spread in buckets by a first hash, then each bucket gets the seed of a second hash which gives every name of
+/// the bucket a slot of its own. A lookup costs two hashes and a single name comparison.
+/// The constructor is constexpr so that tables of names known at compile time can be hashed at compile time.
+template <std::size_t N>
+class CommandHash
+{
+public:
+	static_assert(N > 0 && N < UINT16_MAX);
+
+	constexpr explicit CommandHash(const std::array<std::string_view, N>& names)
+	    : _names(names)
+	{
+		std::array<uint16_t, N> bucketOf {};
+		std::array<uint16_t, k_BucketCount> bucketSizes {};
+		for (std::size_t i = 0; i < N; ++i)
+		{
+			bucketOf[i] = static_cast<uint16_t>(Hash(_names[i], 0) % k_BucketCount);
+			++bucketSizes[bucketOf[i]];
+		}
+
+		// Place the largest buckets while most slots are still free
+		std::array<uint16_t, k_BucketCount> order {};
+		for (std::size_t i = 0; i < k_BucketCount; ++i)
+		{
+			order[i] = static_cast<uint16_t>(i);
+		}
+		std::sort(order.begin(), order.end(),
+		          [&bucketSizes](uint16_t left, uint16_t right) { return bucketSizes[left] > bucketSizes[right]; });
+
+		std::array<bool, N> taken {};
+		for (const auto bucket : order)
+		{
+			if (bucketSizes[bucket] == 0)
+			{
+				break;
+			}
+
+			std::array<uint16_t, N> members {};
+			std::size_t memberCount = 0;
+			for (std::size_t i = 0; i < N; ++i)
+			{
+				if (bucketOf[i] == bucket)
+				{
+					members[memberCount++] = static_cast<uint16_t>(i);
+				}
+			}
+
+			for (uint32_t seed = 1;; ++seed)
+			{
+				if (seed == k_MaxSeed)
+				{
+					throw std::logic_error("Could not find a perfect hash, are there duplicate names?");
+				}
+
+				std::array<std::size_t, N> slots {};
+				bool fits = true;
+				for (std::size_t m = 0; m < memberCount && fits; ++m)
+				{
+					slots[m] = Hash(_names[members[m]], seed) % N;
+					fits = !taken[slots[m]] && std::find(slots.begin(), slots.begin() + m, slots[m]) == slots.begin() + m;
+				}
+				if (!fits)
+				{
+					continue;
+				}
+
+				for (std::size_t m = 0; m < memberCount; ++m)
+				{
+					taken[slots[m]] = true;
+					_slots[slots[m]] = members[m];
+				}
+				_seeds[bucket] = seed;
+				break;
+			}
+		}
+	}
+
+	/// Index of the name in the array given to the constructor
+	[[nodiscard]] constexpr std::optional<std::size_t> Find(std::string_view name) const noexcept
+	{
+		const auto seed = _seeds[Hash(name, 0) % k_BucketCount];
+		const auto index = _slots[Hash(name, seed) % N];
+		if (_names[index] != name)
+		{
+			return std::nullopt;
+		}
+		return index;
+	}
+
+private:
+	static constexpr std::size_t k_BucketCount = N / 2 + 1;
+	static constexpr uint32_t k_MaxSeed = 0x10000;
+
+	/// FNV-1a, the seed changes the offset basis
+	[[nodiscard]] static constexpr uint64_t Hash(std::string_view name, uint32_t seed) noexcept
+	{
+		uint64_t hash = 0xcbf29ce484222325 ^ (seed * 0x9e3779b97f4a7c15);
+		for (const auto c : name)
+		{
+			hash ^= static_cast<uint8_t>(c);
+			hash *= 0x100000001b3;
+		}
+		return hash;
+	}
+
+	std::array<std::string_view, N> _names;
+	std::array<uint32_t, k_BucketCount> _seeds {};
+	std::array<uint16_t, N> _slots {};
+};
+
+} // namespace openblack::lhscriptx
@@ -11,8 +11,9 @@
 
 #include <array>
 #include <functional>
+#include <span>
 #include <string>
-#include <vector>
+#include <string_view>
 
 namespace openblack::lhscriptx
 {
@@ -32,10 +33,10 @@ class ScriptCommandParameter
 	    : _type(type)
 	{
 	}
-	explicit ScriptCommandParameter(const std::string& value)
+	explicit ScriptCommandParameter(std::string_view value)
 	    : _type(ParameterType::String)
 	{
-		_string = value;
+		SetString(value);
 	}
 	explicit ScriptCommandParameter(float value)
 	    : _type(ParameterType::Float)
@@ -65,11 +66,25 @@ class ScriptCommandParameter
 		z = _value._vector[2];
 	}
 
-	void SetString(const std::string& value) { _string = value; }
-	void SetFloat(float value) { _value._float = value; };
-	void SetNumber(int32_t value) { _value._number = value; }
+	// Setters change the type so that a parameter can be reused for the next command, keeping the capacity of its string
+	void SetString(std::string_view value)
+	{
+		_type = ParameterType::String;
+		_string.assign(value);
+	}
+	void SetFloat(float value)
+	{
+		_type = ParameterType::Float;
+		_value._float = value;
+	};
+	void SetNumber(int32_t value)
+	{
+		_type = ParameterType::Number;
+		_value._number = value;
+	}
 	void SetVector(float x, float y, float z)
 	{
+		_type = ParameterType::Vector;
 		_value._vector[0] = x;
 		_value._vector[1] = y;
 		_value._vector[2] = z;
@@ -90,7 +105,10 @@ class ScriptCommandParameter
 	std::string _string;
 };
 
-using ScriptCommandParameters = std::vector<ScriptCommandParameter>;
+constexpr std::size_t k_MaxScriptCommandParameters = 9;
+
+/// View of the parameters of the command being run, which are stored by the Script
+using ScriptCommandParameters = std::span<const ScriptCommandParameter>;
 
 using ScriptCommand = std::function<void(const ScriptCommandParameters&)>;
 
@@ -98,6 +116,6 @@ struct ScriptCommandSignature
 {
 	const std::array<char, 0x80> name;
 	const ScriptCommand command;
-	const std::array<ParameterType, 9> parameters;
+	const std::array<ParameterType, k_MaxScriptCommandParameters> parameters;
 };
 } // namespace openblack::lhscriptx
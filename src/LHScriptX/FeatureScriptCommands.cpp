@@ -671,8 +671,8 @@ void FeatureScriptCommands::CreateStreamPoint(int32_t streamId, glm::vec3 positi
 	auto& registry = Locator::entitiesRegistry::value();
 	auto& registryContext = registry.Context();
 
-	Stream& stream = registry.Get<Stream>(registryContext.streams.at(streamId));
-	stream.nodes.emplace_back(position, stream.nodes);
+	registry.Patch<Stream>(registryContext.streams.at(streamId),
+	                       [&position](Stream& stream) { stream.nodes.emplace_back(position, stream.nodes); });
 }
 
 void FeatureScriptCommands::CreateWaterfall([[maybe_unused]] glm::vec3 position)
@@ -700,8 +700,8 @@ void FeatureScriptCommands::CreateFootpathNode(int footpathId, glm::vec3 positio
 {
 	auto& registry = Locator::entitiesRegistry::value();
 	auto& registryContext = registry.Context();
-	auto& footpath = registry.Get<Footpath>(registryContext.footpaths.at(footpathId));
-	footpath.nodes.emplace_back(Footpath::Node {position});
+	registry.Patch<Footpath>(registryContext.footpaths.at(footpathId),
+	                         [&position](Footpath& footpath) { footpath.nodes.emplace_back(Footpath::Node {position}); });
 }
 
 void FeatureScriptCommands::LinkFootpath(int32_t footpathId)
@@ -9,17 +9,16 @@
 
 #include "Lexer.h"
 
-#include <cctype>
+#include <charconv>
 
-#include <utility>
+#include "Common/StringUtils.h"
 
 using namespace openblack::lhscriptx;
 
-Lexer::Lexer(std::string source)
-    : _source(std::move(source))
+Lexer::Lexer(std::string_view source)
+    : _current(source.data())
+    , _end(source.data() + source.size())
 {
-	_current = _source.begin();
-	_end = _source.end();
 }
 
 Token Lexer::GetToken()
@@ -36,22 +35,24 @@ Token Lexer::GetToken()
 		{
 		case '/':
 			// Comment syntax. Ignore the rest of the line
-			if (*(_current + 1) == '/')
+			if (Remaining() >= 2 && _current[1] == '/')
 			{
 				// Skip line
-				while (*_current != '\n' && _current != _end)
+				while (HasMore() && *_current != '\n')
 				{
 					_current++;
 				}
+				break;
 			}
-			break;
+			_current++;
+			throw LexerException("unexpected character: /");
 		case ' ':
 		case '\t':
 		case '\r':
 			_current++;
 
 			// skip over whitespace quickly
-			while (*_current == ' ' || *_current == '\t' || *_current == '\r')
+			while (HasMore() && (*_current == ' ' || *_current == '\t' || *_current == '\r'))
 			{
 				_current++;
 			}
@@ -64,7 +65,7 @@ Token Lexer::GetToken()
 		// not sure if it's **** or just *, this can be drastically improved on
 		// though
 		case '*':
-			while (*_current != '\n')
+			while (HasMore() && *_current != '\n')
 			{
 				_current++;
 			}
@@ -73,10 +74,9 @@ Token Lexer::GetToken()
 		// handle potential rem/REM
 		case 'R':
 		case 'r':
-			// todo: potential out of bounds here:
-			if ((_current[1] == 'e' || _current[1] == 'E') && (_current[2] == 'm' || _current[2] == 'M'))
+			if (Remaining() >= 3 && (_current[1] == 'e' || _current[1] == 'E') && (_current[2] == 'm' || _current[2] == 'M'))
 			{
-				while (*_current != '\n')
+				while (HasMore() && *_current != '\n')
 				{
 					_current++;
 				}
@@ -200,7 +200,7 @@ Token Lexer::GatherIdentifer()
 		_current++;
 	}
 
-	return Token::MakeIdentifierToken(std::string(idStart, _current));
+	return Token::MakeIdentifierToken({idStart, _current});
 }
 
 Token Lexer::GatherNumber()
@@ -214,12 +214,12 @@ Token Lexer::GatherNumber()
 		isNeg = true;
 	}
 
-	auto numberStart = _current;
+	const auto* numberStart = _current;
 
 	// consume all digits and .
 	while (HasMore())
 	{
-		if (std::isdigit(*_current) != 0)
+		if (*_current >= '0' && *_current <= '9')
 		{
 			_current++;
 		}
@@ -236,25 +236,25 @@ Token Lexer::GatherNumber()
 
 	if (isFloat)
 	{
-		float value = std::stof(std::string(numberStart, _current));
-		if (isNeg)
+		const auto value = openblack::string_utils::ParseFloat({numberStart, _current});
+		if (!value.has_value())
 		{
-			value = -value;
+			throw LexerException("invalid number " + std::string(numberStart, _current));
 		}
-		return Token::MakeFloatToken(value);
+		return Token::MakeFloatToken(isNeg ? -*value : *value);
 	}
 
-	int value = std::stoi(std::string(numberStart, _current));
-	if (isNeg)
+	int value;
+	if (std::from_chars(numberStart, _current, value).ec != std::errc())
 	{
-		value = -value;
+		throw LexerException("invalid number " + std::string(numberStart, _current));
 	}
-	return Token::MakeIntegerToken(value);
+	return Token::MakeIntegerToken(isNeg ? -value : value);
 }
 
 Token Lexer::GatherString()
 {
-	auto stringStart = ++_current;
+	const auto* stringStart = ++_current;
 
 	// todo: we should check for unterminated strings
 	while (HasMore() && *_current != '"')
@@ -262,7 +262,12 @@ Token Lexer::GatherString()
 		_current++;
 	}
 
-	return Token::MakeStringToken(std::string(stringStart, _current++));
+	const auto* stringEnd = _current;
+	if (HasMore())
+	{
+		_current++;
+	}
+	return Token::MakeStringToken({stringStart, stringEnd});
 }
 
 void Token::Print(FILE* file) const
@@ -279,10 +284,10 @@ void Token::Print(FILE* file) const
 		fprintf(file, "\n");
 		break;
 	case Type::Identifier:
-		fprintf(file, "identifier \"%s\"", this->_s.c_str());
+		fprintf(file, "identifier \"%.*s\"", static_cast<int>(this->_s.size()), this->_s.data());
 		break;
 	case Type::String:
-		fprintf(file, "quoted string \"%s\"", this->_s.c_str());
+		fprintf(file, "quoted string \"%.*s\"", static_cast<int>(this->_s.size()), this->_s.data());
 		break;
 	case Type::Integer:
 		fprintf(file, "integer %d", this->_u.integerValue);
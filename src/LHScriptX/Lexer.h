@@ -9,8 +9,11 @@
 
 #pragma once
 
+#include <cstdio>
+
 #include <stdexcept>
 #include <string>
+#include <string_view>
 
 #ifdef _MSC_VER
 #define __builtin_unreachable() __assume(0)
@@ -65,13 +68,13 @@ class Token
 	static Token MakeInvalidToken() { return Token(Type::Invalid); }
 	static Token MakeEOFToken() { return Token(Type::EndOfFile); }
 	static Token MakeEOLToken() { return Token(Type::EndOfLine); }
-	static Token MakeIdentifierToken(const std::string& value)
+	static Token MakeIdentifierToken(std::string_view value)
 	{
 		Token tok(Type::Identifier);
 		tok._s = value;
 		return tok;
 	}
-	static Token MakeStringToken(const std::string& value)
+	static Token MakeStringToken(std::string_view value)
 	{
 		Token tok(Type::String);
 		tok._s = value;
@@ -103,8 +106,9 @@ class Token
 	[[nodiscard]] bool IsOP(Operator op) const { return this->_type == Type::Operator && this->_u.op == op; }
 
 	// todo: assert check the type for each of these?
-	[[nodiscard]] const std::string& StringValue() const { return this->_s; }
-	[[nodiscard]] const std::string& Identifier() const { return this->_s; }
+	/// Views into the source given to the Lexer, only valid as long as it is
+	[[nodiscard]] std::string_view StringValue() const { return this->_s; }
+	[[nodiscard]] std::string_view Identifier() const { return this->_s; }
 	[[nodiscard]] const int* IntegerValue() const { return &this->_u.integerValue; }
 	[[nodiscard]] const float* FloatValue() const { return &this->_u.floatValue; }
 	[[nodiscard]] Operator Op() const { return this->_u.op; }
@@ -125,13 +129,14 @@ class Token
 		float floatValue;
 		Operator op;
 	} _u;
-	std::string _s;
+	std::string_view _s;
 };
 
+/// Splits a script into tokens without copying it, the source must outlive the lexer and its tokens
 class Lexer
 {
 public:
-	explicit Lexer(std::string source);
+	explicit Lexer(std::string_view source);
 
 	Token GetToken();
 
@@ -144,9 +149,8 @@ class Lexer
 	Token GatherNumber();
 	Token GatherString();
 
-	std::string _source;
-	std::string::iterator _current;
-	std::string::iterator _end;
+	const char* _current;
+	const char* _end;
 
 	int _currentLine {1};
 };
@@ -10,11 +10,16 @@
 #include "Script.h"
 
 #include <algorithm>
+#include <optional>
 #include <ranges>
+#include <string>
+#include <type_traits>
 
 #include <glm/vec2.hpp>
 
 #include "3D/LandIslandInterface.h"
+#include "Common/StringUtils.h"
+#include "CommandHash.h"
 #include "FeatureScriptCommands.h"
 #include "Lexer.h"
 #include "Locator.h"
@@ -22,9 +27,71 @@
 using namespace openblack;
 using namespace openblack::lhscriptx;
 
+namespace
+{
+/// Parse a component of a vector, allowing the spaces which strtof used to skip
+std::optional<float> ParseFloat(std::string_view string)
+{
+	const auto first = string.find_first_not_of(" \t");
+	if (first == std::string_view::npos)
+	{
+		return std::nullopt;
+	}
+	return string_utils::ParseFloat(string.substr(first, string.find_last_not_of(" \t") - first + 1));
+}
+
+void SetParameter(ScriptCommandParameter& parameter, const Token& argument)
+{
+	const auto type = argument.GetType();
+
+	switch (type)
+	{
+	case Token::Type::Invalid:
+		throw std::runtime_error("Invalid token. Unable to proceed");
+	case Token::Type::EndOfFile:
+		throw std::runtime_error("Unexpected EOF in script");
+	case Token::Type::EndOfLine:
+		throw std::runtime_error("Unexpected EOL in script");
+	case Token::Type::Identifier:
+		parameter.SetString(argument.Identifier());
+		return;
+	case Token::Type::String:
+	{
+		const auto str = argument.StringValue();
+		// Check if it's a vector
+		if (std::ranges::count(str, ',') == 1)
+		{
+			const auto delim = str.find(',');
+			const auto x = ParseFloat(str.substr(0, delim));
+			const auto z = ParseFloat(str.substr(delim + 1));
+			if (x.has_value() && z.has_value())
+			{
+				const auto& island = Locator::terrainSystem::value();
+
+				parameter.SetVector(*x, island.GetHeightAt(glm::vec2(*x, *z)), *z);
+				return;
+			}
+		}
+		parameter.SetString(str);
+		return;
+	}
+	case Token::Type::Integer:
+		parameter.SetNumber(*argument.IntegerValue());
+		return;
+	case Token::Type::Float:
+		parameter.SetFloat(*argument.FloatValue());
+		return;
+	case Token::Type::Operator:
+		throw std::runtime_error("Operator token as an argument is currently not supported");
+	default:
+		throw std::runtime_error("Missing switch case for script token argument");
+	}
+}
+} // namespace
+
 Script::Script() = default;
 
-void Script::Load(const std::string& source)
+void Script::Load(std::string_view source)
 {
 	Lexer lexer(source);
 
@@ -35,20 +102,21 @@ void Script::Load(const std::string& source)
 
 		if (token->IsIdentifier())
 		{
-			const std::string identifier = token->Identifier();
+			const auto identifier = token->Identifier();
 
-			if (!IsCommand(identifier))
+			const auto* signature = FindCommand(identifier);
+			if (signature == nullptr)
 			{
-				throw std::runtime_error("unknown command: " + identifier);
+				throw std::runtime_error("unknown command: " + std::string(identifier));
 			}
 
 			token = this->AdvanceToken(lexer);
 			if (!token->IsOP(Operator::LeftParentheses))
 			{
-				throw std::runtime_error("expected ( after identifier " + identifier);
+				throw std::runtime_error("expected ( after identifier " + std::string(identifier));
 			}
 
-			std::vector<Token> args;
+			std::size_t parameterCount = 0;
 
 			// if it's an immediate right parentheses there are no args
 			token = this->AdvanceToken(lexer);
@@ -56,8 +124,11 @@ void Script::Load(const std::string& source)
 			{
 				while (true)
 				{
-					const Token* peekToken = this->PeekToken(lexer);
-					args.push_back(*peekToken);
+					if (parameterCount == _parameters.size())
+					{
+						throw std::runtime_error("Invalid number of script arguments");
+					}
+					SetParameter(_parameters.at(parameterCount++), *this->PeekToken(lexer));
 
 					// consume the ,
 					token = this->AdvanceToken(lexer);
@@ -78,100 +149,32 @@ void Script::Load(const std::string& source)
 			// move token to whatever is after ')'
 			this->AdvanceToken(lexer);
 
-			RunCommand(identifier, args);
+			RunCommand(*signature, ScriptCommandParameters(_parameters.data(), parameterCount));
 		}
 
 		this->AdvanceToken(lexer);
 	}
 }
 
-bool Script::IsCommand(const std::string& identifier) const
+const ScriptCommandSignature* Script::FindCommand(std::string_view identifier)
 {
-	// TODO(handsomematt): this could be done a lot better
-	return std::any_of(FeatureScriptCommands::k_Signatures.cbegin(), FeatureScriptCommands::k_Signatures.cend(),
-	                   [&identifier](const auto& s) { return s.name.data() == identifier; });
-}
-
-ScriptCommandParameter GetParameter(Token& argument)
-{
-	const auto type = argument.GetType();
-
-	switch (type)
-	{
-	case Token::Type::Invalid:
-		throw std::runtime_error("Invalid token. Unable to proceed");
-	case Token::Type::EndOfFile:
-		throw std::runtime_error("Unexpected EOF in script");
-	case Token::Type::EndOfLine:
-		throw std::runtime_error("Unexpected EOL in script");
-	case Token::Type::Identifier:
-		return ScriptCommandParameter(argument.Identifier());
-	case Token::Type::String:
-	{
-		const auto& str = argument.StringValue();
-		// Check if it's a vector
-		if (std::count_if(str.cbegin(), str.cend(), [](char c) { return c == ','; }) == 1)
-		{
-			const auto delim = str.find(',');
-			char* floatEnd;
-			const auto x = std::strtof(str.c_str(), &floatEnd);
-			if (str.c_str() + delim == floatEnd)
-			{
-				const auto z = std::strtof(floatEnd + 1, &floatEnd);
-				if (static_cast<size_t>(floatEnd - str.c_str()) == static_cast<size_t>(str.length()))
-				{
-					const auto& island = Locator::terrainSystem::value();
-
-					return {x, island.GetHeightAt(glm::vec2(x, z)), z};
-				}
-			}
-		}
-		return ScriptCommandParameter(str);
-	}
-	case Token::Type::Integer:
-		return ScriptCommandParameter(*argument.IntegerValue());
-	case Token::Type::Float:
-		return ScriptCommandParameter(*argument.FloatValue());
-	case Token::Type::Operator:
-		throw std::runtime_error("Operator token as an argument is currently not supported");
-	default:
-		throw std::runtime_error("Missing switch case for script token argument");
-	}
+	const auto& signatures = FeatureScriptCommands::k_Signatures;
+	static const auto k_Lookup = [&signatures] {
+		std::array<std::string_view, std::tuple_size_v<std::remove_cvref_t<decltype(signatures)>>> names;
+		std::ranges::transform(signatures, names.begin(), [](const auto& s) { return std::string_view(s.name.data()); });
+		return CommandHash(names);
+	}();
+
+	const auto index = k_Lookup.Find(identifier);
+	return index.has_value() ? &signatures.at(*index) : nullptr;
 }
 
-void Script::RunCommand(const std::string& identifier, const std::vector<Token>& args)
+void Script::RunCommand(const ScriptCommandSignature& signature, ScriptCommandParameters parameters)
 {
-	const ScriptCommandSignature* commandSignature = nullptr;
-
-	for (const auto& signature : FeatureScriptCommands::k_Signatures)
-	{
-		if (signature.name.data() != identifier)
-		{
-			continue;
-		}
-
-		commandSignature = &signature;
-		break;
-	}
-
-	if (commandSignature == nullptr)
-	{
-		throw std::runtime_error("Missing script command signature");
-	}
-
-	// Turn tokens into parameters
-	auto parameters = ScriptCommandParameters();
-
-	for (auto arg : args)
-	{
-		const ScriptCommandParameter param = GetParameter(arg);
-		parameters.push_back(param);
-	}
-
-	const auto expectedParameters = commandSignature->parameters;
+	const auto& expectedParameters = signature.parameters;
 	uint32_t expectedSize;
 	// TODO (#749) use std::views::enumerate
-	for (expectedSize = 0; const auto& p : commandSignature->parameters)
+	for (expectedSize = 0; const auto& p : expectedParameters)
 	{
 		// Looping until None because parameters is a fixed sized array.
 		// Last Argument is the one before the first None or the 9th
@@ -197,7 +200,7 @@ void Script::RunCommand(const std::string& identifier, const std::vector<Token>&
 		}
 	}
 
-	commandSignature->command(parameters);
+	signature.command(parameters);
 }
 
 const Token* Script::PeekToken(Lexer& lexer)
@@ -9,8 +9,10 @@
 
 #pragma once
 
-#include <vector>
+#include <array>
+#include <string_view>
 
+#include "CommandSignature.h"
 #include "Lexer.h"
 
 namespace openblack::lhscriptx
@@ -21,17 +23,21 @@ class Script
 public:
 	Script();
 
-	void Load(const std::string&);
+	void Load(std::string_view source);
+
+	/// Lookup of a command by name through a perfect hash of the signatures
+	[[nodiscard]] static const ScriptCommandSignature* FindCommand(std::string_view identifier);
 
 private:
-	[[nodiscard]] bool IsCommand(const std::string& identifier) const;
-	void RunCommand(const std::string& identifier, const std::vector<Token>& args);
+	static void RunCommand(const ScriptCommandSignature& signature, ScriptCommandParameters parameters);
 
 	const Token* PeekToken(Lexer&);
 	const Token* AdvanceToken(Lexer&);
 
 	// The current token.
 	Token _token {Token::MakeInvalidToken()};
+	// Arguments of the current command, reused from one line to the next
+	std::array<ScriptCommandParameter, k_MaxScriptCommandParameters> _parameters;
 };
 
 } // namespace openblack::lhscriptx
@@ -11,6 +11,8 @@
 
 #define LOCATOR_IMPLEMENTATIONS
 
+#include <random>
+
 #include <spdlog/spdlog.h>
 
 #include "3D/Implementations/LandIsland.h"
@@ -22,8 +24,11 @@
 #include "Audio/AudioManagerNoOp.h"
 #include "CHLApi.h"
 #include "Common/EventManager.h"
+#include "Common/JobSystem.h"
 #include "Common/RandomNumberManagerProduction.h"
+#include "Common/RandomNumberManagerTesting.h"
 #include "Debug/DebugGuiInterface.h"
+#include "EngineConfig.h"
 #include "ECS/Archetypes/PlayerArchetype.h"
 #include "ECS/MapProduction.h"
 #include "ECS/Registry.h"
@@ -34,9 +39,11 @@
 #include "ECS/Systems/Implementations/PathfindingSystem.h"
 #include "ECS/Systems/Implementations/PlayerSystem.h"
 #include "ECS/Systems/Implementations/RenderingSystem.h"
+#include "ECS/Systems/Implementations/SpatialQuerySystem.h"
 #include "ECS/Systems/Implementations/TownSystem.h"
 #include "Graphics/RendererInterface.h"
 #include "Input/GameActionMap.h"
+#include "Input/GameActionRecording.h"
 #include "LHVM.h"
 #include "Profiler.h"
 #include "Resources/Resources.h"
@@ -44,6 +51,7 @@
 #if __ANDROID__
 #include "FileSystem/AndroidFileSystem.h"
 #else
+#include "FileSystem/ArchiveFileSystem.h"
 #include "FileSystem/DefaultFileSystem.h"
 #endif
 
@@ -51,6 +59,7 @@ using namespace openblack::audio;
 using namespace openblack::filesystem;
 using openblack::LandIsland;
 using openblack::RandomNumberManagerProduction;
+using openblack::RandomNumberManagerTesting;
 using openblack::TempleInterior;
 using openblack::UnloadedIsland;
 using openblack::chlapi::CHLApi;
@@ -67,6 +76,8 @@ using openblack::ecs::systems::RenderingSystem;
 using openblack::ecs::systems::TownSystem;
 using openblack::graphics::RendererInterface;
 using openblack::input::GameActionMap;
+using openblack::input::GameActionRecorder;
+using openblack::input::GameActionReplay;
 using openblack::lhvm::LHVM;
 using openblack::resources::Resources;
 using openblack::windowing::DisplayMode;
@@ -77,12 +88,13 @@ void openblack::InitializeWindow(const std::string& title, int width, int height
 	Locator::windowing::emplace<Sdl2WindowingSystem>(title, width, height, displayMode, extraFlags);
 }
 
-bool openblack::InitializeEngine(uint8_t rendererType, bool vsync) noexcept
+bool openblack::InitializeEngine(uint8_t rendererType, bool vsync, bool audio) noexcept
 {
 	SPDLOG_LOGGER_INFO(spdlog::get("game"), "EnTT version: {}", ENTT_VERSION);
 	SPDLOG_LOGGER_INFO(spdlog::get("game"), GLM_VERSION_MESSAGE);
 
 	Locator::profiler::emplace();
+	Locator::jobs::emplace();
 
 	Locator::rendererInterface::reset(
 	    RendererInterface::Create(static_cast<bgfx::RendererType::Enum>(rendererType), vsync).release());
@@ -100,14 +112,21 @@ bool openblack::InitializeEngine(uint8_t rendererType, bool vsync) noexcept
 	Locator::filesystem::emplace<DefaultFileSystem>();
 #endif
 	Locator::rng::emplace<RandomNumberManagerProduction>();
-	try
+	if (!audio)
 	{
-		Locator::audio::emplace<AudioManager>();
+		Locator::audio::emplace<AudioManagerNoOp>();
 	}
-	catch (std::runtime_error& error)
+	else
 	{
-		SPDLOG_LOGGER_ERROR(spdlog::get("audio"), "Falling back to no-op audio: {}", error.what());
-		Locator::audio::emplace<AudioManagerNoOp>();
+		try
+		{
+			Locator::audio::emplace<AudioManager>();
+		}
+		catch (std::runtime_error& error)
+		{
+			SPDLOG_LOGGER_ERROR(spdlog::get("audio"), "Falling back to no-op audio: {}", error.what());
+			Locator::audio::emplace<AudioManagerNoOp>();
+		}
 	}
 
 	Locator::chlapi::emplace<CHLApi>();
@@ -121,8 +140,9 @@ bool openblack::InitializeGame() noexcept
 	Locator::resources::emplace<Resources>();
 	Locator::playerSystem::emplace<PlayerSystem>();
 	Locator::gameActionSystem::emplace<GameActionMap>();
-	Locator::rendereringSystem::emplace<RenderingSystem>();
 	Locator::entitiesRegistry::emplace<Registry>();
+	// After the registry, the rendering system follows the components shown by its debug layers
+	Locator::rendereringSystem::emplace<RenderingSystem>();
 	Locator::handSystem::emplace<HandSystem>();
 	Locator::temple::emplace<TempleInterior>();
 	Locator::oceanSystem::emplace<Ocean>();
@@ -131,6 +151,72 @@ bool openblack::InitializeGame() noexcept
 	return true;
 }
 
+void openblack::InitializeRandomSeed(uint32_t seed) noexcept
+{
+	auto rng = std::make_unique<RandomNumberManagerTesting>();
+	rng->SetSeed(static_cast<int>(seed));
+	Locator::rng::reset(rng.release());
+}
+
+bool openblack::InitializeInputRecording(const std::filesystem::path& path) noexcept
+{
+	const auto seed = std::random_device()();
+	// Frames of the recording are replayed with a fixed duration, they have to be recorded with the same one
+	auto& config = Locator::config::value();
+	const auto frameDuration = config.fixedFrameDuration.value_or(GameActionRecordingHeader::k_DefaultFrameDuration);
+	try
+	{
+		Locator::gameActionSystem::reset(new GameActionRecorder(std::make_unique<GameActionMap>(), path, seed, frameDuration));
+	}
+	catch (std::runtime_error& error)
+	{
+		SPDLOG_LOGGER_ERROR(spdlog::get("input"), "{}", error.what());
+		return false;
+	}
+
+	InitializeRandomSeed(seed);
+	config.fixedFrameDuration = frameDuration;
+	return true;
+}
+
+bool openblack::InitializeInputReplay(const std::filesystem::path& path) noexcept
+{
+	std::unique_ptr<GameActionReplay> replay;
+	try
+	{
+		replay = std::make_unique<GameActionReplay>(path);
+	}
+	catch (std::runtime_error& error)
+	{
+		SPDLOG_LOGGER_ERROR(spdlog::get("input"), "{}", error.what());
+		return false;
+	}
+
+	InitializeRandomSeed(replay->GetSeed());
+	Locator::config::value().fixedFrameDuration = replay->GetFrameDuration();
+	Locator::gameActionSystem::reset(replay.release());
+	return true;
+}
+
+bool openblack::InitializeAssetArchive(const std::filesystem::path& path) noexcept
+{
+#if __ANDROID__
+	SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Asset archives are not supported on Android: {}", path.generic_string());
+	return false;
+#else
+	try
+	{
+		Locator::filesystem::reset(new ArchiveFileSystem(path));
+	}
+	catch (std::runtime_error& error)
+	{
+		SPDLOG_LOGGER_ERROR(spdlog::get("game"), "{}", error.what());
+		return false;
+	}
+	return true;
+#endif
+}
+
 void openblack::InitializeLevel(const std::filesystem::path& path)
 {
 	Locator::entitiesMap::emplace<MapProduction>();
@@ -138,12 +224,16 @@ void openblack::InitializeLevel(const std::filesystem::path& path)
 	Locator::livingActionSystem::emplace<LivingActionSystem>();
 	Locator::townSystem::emplace<TownSystem>();
 	Locator::pathfindingSystem::emplace<PathfindingSystem>();
+	Locator::spatialQuerySystem::emplace<SpatialQuerySystem>();
 	Locator::cameraBookmarkSystem::emplace<CameraBookmarkSystem>();
 	Locator::terrainSystem::emplace<LandIsland>(path);
 }
 
 void openblack::ShutDownServices()
 {
+	// Let the workers finish the jobs still queued, which may use any of the other services
+	Locator::jobs::reset();
+
 	// Stop all sounds
 	if (Locator::audio::has_value())
 	{
@@ -173,6 +263,7 @@ void openblack::ShutDownServices()
 	Locator::townSystem::reset();
 	Locator::handSystem::reset();
 	Locator::pathfindingSystem::reset();
+	Locator::spatialQuerySystem::reset();
 	Locator::terrainSystem::reset();
 	Locator::filesystem::reset();
 	Locator::gameActionSystem::reset();
@@ -186,6 +277,7 @@ void openblack::ShutDownServices()
 	Locator::events::reset();
 	Locator::camera::reset();
 	Locator::config::reset();
+	Locator::infoConstantsIndex::reset();
 	Locator::infoConstants::reset();
 	Locator::profiler::reset();
 
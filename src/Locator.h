@@ -21,6 +21,8 @@ namespace openblack
 struct EngineConfig;
 class Camera;
 class EventManager;
+class InfoConstantsIndex;
+class JobSystem;
 class LandIslandInterface;
 class OceanInterface;
 class Profiler;
@@ -95,12 +97,23 @@ class LivingActionSystemInterface;
 class PathfindingSystemInterface;
 class PlayerSystemInterface;
 class RenderingSystemInterface;
+class SpatialQuerySystemInterface;
 class TownSystemInterface;
 } // namespace ecs::systems
 
 void InitializeWindow(const std::string& title, int width, int height, windowing::DisplayMode displayMode, uint32_t extraFlags);
-bool InitializeEngine(uint8_t rendererType, bool vsync) noexcept;
+/// Without audio, sounds are loaded but never played, such as when simulating turns without rendering
+bool InitializeEngine(uint8_t rendererType, bool vsync, bool audio) noexcept;
 bool InitializeGame() noexcept;
+/// Replace the random number generator by one which gives the same numbers on every run with the same seed
+void InitializeRandomSeed(uint32_t seed) noexcept;
+/// Write the user's input of every frame to a file, the random number generator gets a seed stored in the recording and
+/// frames get a fixed duration, as they do on replay
+bool InitializeInputRecording(const std::filesystem::path& path) noexcept;
+/// Replace the user's input by a recording, replayed with its seed and a fixed frame duration
+bool InitializeInputReplay(const std::filesystem::path& path) noexcept;
+/// Serve the game files from an asset archive written by packtool instead of the game directory
+bool InitializeAssetArchive(const std::filesystem::path& path) noexcept;
 void InitializeLevel(const std::filesystem::path& path);
 void ShutDownServices();
 
@@ -108,7 +121,9 @@ struct Locator
 {
 	using config = entt::locator<EngineConfig>;
 	using infoConstants = entt::locator<const InfoConstants>;
+	using infoConstantsIndex = entt::locator<const InfoConstantsIndex>;
 	using profiler = entt::locator<Profiler>;
+	using jobs = entt::locator<JobSystem>;
 	using events = entt::locator<EventManager>;
 	using windowing = entt::locator<windowing::WindowingInterface>;
 	using debugGui = entt::locator<debug::gui::DebugGuiInterface>;
@@ -128,6 +143,7 @@ struct Locator
 	using livingActionSystem = entt::locator<ecs::systems::LivingActionSystemInterface>;
 	using townSystem = entt::locator<ecs::systems::TownSystemInterface>;
 	using pathfindingSystem = entt::locator<ecs::systems::PathfindingSystemInterface>;
+	using spatialQuerySystem = entt::locator<ecs::systems::SpatialQuerySystemInterface>;
 	using entitiesRegistry = entt::locator<ecs::Registry>;
 	using entitiesMap = entt::locator<ecs::MapInterface>;
 	using playerSystem = entt::locator<ecs::systems::PlayerSystemInterface>;
@@ -0,0 +1,102 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "Log.h"
+
+#include <memory>
+
+#include <spdlog/async.h>
+#include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#ifdef __ANDROID__
+#include <spdlog/sinks/android_sink.h>
+#endif // __ANDROID__
+
+using namespace openblack;
+
+namespace
+{
+/// Number of messages waiting for the background thread before the oldest are dropped
+constexpr size_t k_AsyncQueueSize = 8192;
+
+std::array<std::shared_ptr<spdlog::logger>, k_LoggingSubsystemStrs.size()> sLoggers;
+
+spdlog::sink_ptr CreateSink(const std::string& logFile)
+{
+#ifdef __ANDROID__
+	if (!logFile.empty() && logFile == "logcat")
+	{
+		return std::make_shared<spdlog::sinks::android_sink_mt>("spdlog-android");
+	}
+#endif // __ANDROID__
+	if (!logFile.empty() && logFile != "stdout")
+	{
+		return std::make_shared<spdlog::sinks::basic_file_sink_mt>(logFile);
+	}
+	return std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+}
+} // namespace
+
+void openblack::InitializeLoggers(const std::string& logFile, const LoggingLevels& levels, bool async)
+{
+	const auto sink = CreateSink(logFile);
+	if (async)
+	{
+		spdlog::init_thread_pool(k_AsyncQueueSize, 1);
+	}
+
+	// TODO (#749) use std::views::enumerate
+	for (size_t i = 0; const auto& subsystem : k_LoggingSubsystemStrs)
+	{
+		std::shared_ptr<spdlog::logger> logger;
+		if (async)
+		{
+			logger = std::make_shared<spdlog::async_logger>(subsystem.data(), sink, spdlog::thread_pool(),
+			                                                spdlog::async_overflow_policy::overrun_oldest);
+		}
+		else
+		{
+			logger = std::make_shared<spdlog::logger>(subsystem.data(), sink);
+		}
+		logger->set_level(levels.at(i));
+		spdlog::register_logger(logger);
+		sLoggers.at(i) = std::move(logger);
+		++i;
+	}
+}
+
+void openblack::ShutDownLoggers()
+{
+	sLoggers.fill(nullptr);
+	spdlog::shutdown();
+}
+
+spdlog::logger* openblack::GetLogger(LoggingSubsystem subsystem)
+{
+	const auto index = static_cast<size_t>(subsystem);
+	if (auto* logger = sLoggers[index].get(); logger != nullptr)
+	{
+		return logger;
+	}
+	return spdlog::get(k_LoggingSubsystemStrs[index].data()).get();
+}
+
+std::optional<uint32_t> LogRateLimiter::Allow(Clock::time_point now)
+{
+	const auto time = now.time_since_epoch().count();
+	auto nextAllowed = _nextAllowed.load(std::memory_order_relaxed);
+	// Only one of the threads racing past the end of the interval lets its message through
+	if (time < nextAllowed ||
+	    !_nextAllowed.compare_exchange_strong(nextAllowed, time + _interval.count(), std::memory_order_relaxed))
+	{
+		_suppressed.fetch_add(1, std::memory_order_relaxed);
+		return std::nullopt;
+	}
+	return _suppressed.exchange(0, std::memory_order_relaxed);
+}
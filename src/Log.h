@@ -0,0 +1,103 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <spdlog/common.h>
+#include <spdlog/spdlog.h>
+
+namespace openblack
+{
+
+enum class LoggingSubsystem : uint8_t
+{
+	game,
+	input,
+	graphics,
+	scripting,
+	audio,
+	pathfinding,
+	ai,
+
+	_count
+};
+
+constexpr static std::array<std::string_view, static_cast<size_t>(LoggingSubsystem::_count)> k_LoggingSubsystemStrs {
+    "game",        //
+    "input",       //
+    "graphics",    //
+    "scripting",   //
+    "audio",       //
+    "pathfinding", //
+    "ai",          //
+};
+
+using LoggingLevels = std::array<spdlog::level::level_enum, k_LoggingSubsystemStrs.size()>;
+
+/// Create and register the logger of every subsystem, all writing to the same sink.
+/// With async, messages are formatted and written by a background thread and the oldest are dropped when it falls behind.
+void InitializeLoggers(const std::string& logFile, const LoggingLevels& levels, bool async);
+/// Flush and drop all loggers, handles returned by GetLogger are invalid afterwards
+void ShutDownLoggers();
+
+/// Logger of a subsystem without the lookup by name and lock of spdlog::get.
+/// Falls back to spdlog::get for loggers registered without InitializeLoggers, such as in tests.
+[[nodiscard]] spdlog::logger* GetLogger(LoggingSubsystem subsystem);
+
+/// Lets a repeated message through at most once per interval, counting the ones it holds back
+class LogRateLimiter
+{
+public:
+	using Clock = std::chrono::steady_clock;
+	static constexpr auto k_DefaultInterval = std::chrono::seconds(5);
+
+	explicit LogRateLimiter(Clock::duration interval = k_DefaultInterval)
+	    : _interval(interval)
+	{
+	}
+
+	/// The number of messages suppressed since the last one let through, or nullopt if this one should be suppressed
+	std::optional<uint32_t> Allow(Clock::time_point now = Clock::now());
+
+private:
+	const Clock::duration _interval;
+	std::atomic<Clock::rep> _nextAllowed {std::numeric_limits<Clock::rep>::min()};
+	std::atomic<uint32_t> _suppressed {0};
+};
+
+} // namespace openblack
+
+/// Log through a rate limiter of the call site, for diagnostics that can repeat every turn or frame
+#define OPENBLACK_LOG_RATE_LIMITED(logger, level, ...)                                                                      \
+	do                                                                                                                      \
+	{                                                                                                                       \
+		auto* rateLimitedLogger = (logger);                                                                                 \
+		if (rateLimitedLogger->should_log(level))                                                                           \
+		{                                                                                                                   \
+			static ::openblack::LogRateLimiter callSiteLimiter;                                                             \
+			if (const auto suppressed = callSiteLimiter.Allow(); suppressed.has_value())                                    \
+			{                                                                                                               \
+				if (*suppressed > 0)                                                                                        \
+				{                                                                                                           \
+					SPDLOG_LOGGER_CALL(rateLimitedLogger, level, "{} similar messages suppressed", *suppressed);            \
+				}                                                                                                           \
+				SPDLOG_LOGGER_CALL(rateLimitedLogger, level, __VA_ARGS__);                                                  \
+			}                                                                                                               \
+		}                                                                                                                   \
+	} while (false)
@@ -30,6 +30,8 @@ void openblack::Profiler::End(Stage stage)
 	assert(entry.level == _currentLevel);
 	entry.end = std::chrono::system_clock::now();
 	entry.finalized = true;
+	_totals.at(static_cast<uint8_t>(stage)) += entry.end - entry.start;
+	++_counts.at(static_cast<uint8_t>(stage));
 }
 
 void openblack::Profiler::Frame()
@@ -37,4 +39,20 @@ void openblack::Profiler::Frame()
 	auto& prevEntry = _entries.at(_currentEntry);
 	_currentEntry = (_currentEntry + 1) % k_BufferSize;
 	prevEntry.frameEnd = _entries.at(_currentEntry).frameStart = std::chrono::system_clock::now();
+
+	const auto memory = MemoryTracker::GetSnapshot();
+	prevEntry.memory = MemoryTracker::GetDifference(memory, _memoryAtFrame);
+	_memoryAtFrame = memory;
+}
+
+openblack::MemoryTracker::Snapshot openblack::Profiler::GetMemoryTotals() const
+{
+	return MemoryTracker::GetDifference(MemoryTracker::GetSnapshot(), _memoryAtReset);
+}
+
+void openblack::Profiler::ResetTotals()
+{
+	_totals.fill(std::chrono::nanoseconds::zero());
+	_counts.fill(0);
+	_memoryAtReset = MemoryTracker::GetSnapshot();
 }
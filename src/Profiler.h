@@ -16,6 +16,8 @@
 #include <map>
 #include <string_view>
 
+#include "Common/MemoryTracker.h"
+
 namespace openblack
 {
 
@@ -27,6 +29,8 @@ class Profiler
 		PhysicsUpdate,
 		PathfindingUpdate,
 		LivingActionUpdate,
+		SpatialQueryUpdate,
+		ScriptUpdate,
 		SdlInput,
 		UpdateUniforms,
 		UpdateEntities,
@@ -59,6 +63,8 @@ class Profiler
 	    "Physics Update",       //
 	    "Pathfinding Update",   //
 	    "Living Action Update", //
+	    "Spatial Query Update", //
+	    "Script Update",        //
 	    "SDL Input",            //
 	    "Update Uniforms",      //
 	    "Entities",             //
@@ -114,6 +120,8 @@ class Profiler
 		std::chrono::system_clock::time_point frameStart;
 		std::chrono::system_clock::time_point frameEnd;
 		std::array<Scope, static_cast<uint8_t>(Stage::_count)> stages;
+		/// Allocations made during the frame, counted with OPENBLACK_TRACK_ALLOCATIONS
+		MemoryTracker::Snapshot memory;
 	};
 
 	void Frame();
@@ -123,6 +131,14 @@ class Profiler
 
 	[[nodiscard]] uint8_t GetEntryIndex(int8_t offset) const { return (_currentEntry + k_BufferSize + offset) % k_BufferSize; }
 
+	/// Time spent in a stage since the last ResetTotals, for runs too long or without a GUI to look at entries
+	[[nodiscard]] std::chrono::nanoseconds GetTotal(Stage stage) const { return _totals.at(static_cast<uint8_t>(stage)); }
+	/// Number of times a stage ran since the last ResetTotals
+	[[nodiscard]] uint32_t GetCount(Stage stage) const { return _counts.at(static_cast<uint8_t>(stage)); }
+	/// Allocations made since the last ResetTotals
+	[[nodiscard]] MemoryTracker::Snapshot GetMemoryTotals() const;
+	void ResetTotals();
+
 	constexpr static uint8_t k_BufferSize = 100;
 	std::array<Entry, k_BufferSize>& GetEntries() { return _entries; }
 	[[nodiscard]] const std::array<Entry, k_BufferSize>& GetEntries() const { return _entries; }
@@ -131,6 +147,10 @@ class Profiler
 	std::array<Entry, k_BufferSize> _entries;
 	uint8_t _currentEntry = k_BufferSize - 1;
 	uint8_t _currentLevel = 0;
+	std::array<std::chrono::nanoseconds, static_cast<uint8_t>(Stage::_count)> _totals {};
+	std::array<uint32_t, static_cast<uint8_t>(Stage::_count)> _counts {};
+	MemoryTracker::Snapshot _memoryAtFrame {};
+	MemoryTracker::Snapshot _memoryAtReset {};
 };
 
 } // namespace openblack
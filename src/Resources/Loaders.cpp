@@ -9,6 +9,7 @@
 
 #include "Resources/Loaders.h"
 
+#include <algorithm>
 #include <iostream>
 #include <ranges>
 #include <utility>
@@ -21,8 +22,8 @@
 #include "3D/Light.h"
 #include "Audio/AudioManagerInterface.h"
 #include "Common/StringUtils.h"
-#include "Common/Zip.h"
 #include "FileSystem/FileSystemInterface.h"
+#include "Graphics/MipChain.h"
 #include "Graphics/Texture2D.h"
 #include "Locator.h"
 
@@ -30,6 +31,18 @@ using namespace openblack;
 using namespace openblack::filesystem;
 using namespace openblack::resources;
 
+L3DLoader::result_type L3DLoader::operator()(FromCookedTag, const std::string& debugName,
+                                             const l3d::L3DCookedFile& cooked) const
+{
+	auto mesh = std::make_shared<graphics::L3DMesh>(debugName);
+	if (!mesh->Load(cooked))
+	{
+		SPDLOG_LOGGER_WARN(spdlog::get("game"), "Some issues were seen while loading cooked l3d mesh {}.", debugName);
+	}
+
+	return mesh;
+}
+
 L3DLoader::result_type L3DLoader::operator()(FromBufferTag, const std::string& debugName,
                                              const std::vector<uint8_t>& data) const
 {
@@ -56,13 +69,8 @@ L3DLoader::result_type L3DLoader::operator()(FromDiskTag, const std::filesystem:
 	}
 	else if (pathExt == ".zzz")
 	{
-		auto stream = Locator::filesystem::value().Open(path, Stream::Mode::Read);
-		uint32_t decompressedSize = 0;
-		stream->Read(&decompressedSize);
-		auto buffer = std::vector<uint8_t>(stream->Size() - sizeof(decompressedSize));
-		stream->Read(buffer.data(), buffer.size());
-		auto decompressedBuffer = zip::Inflate(buffer, decompressedSize);
-		if (!mesh->LoadFromBuffer(decompressedBuffer))
+		// Decompressed by the mesh only when it is missing from the mesh cache
+		if (!mesh->LoadFromBuffer(Locator::filesystem::value().ReadAll(path), true))
 		{
 			throw std::runtime_error("Unable to load decompressed mesh");
 		}
@@ -75,7 +83,7 @@ Texture2DLoader::result_type Texture2DLoader::operator()(FromPackTag, const std:
                                                          const pack::G3DTexture& g3dTexture) const
 {
 	// some assumptions:
-	// - no mipmaps
+	// - mipmaps are only used if the dds data has all of them
 	// - no cubemap or volume textures
 	// - always dxt1 or dxt3
 	// - all are compressed
@@ -98,9 +106,12 @@ Texture2DLoader::result_type Texture2DLoader::operator()(FromPackTag, const std:
 		throw std::runtime_error("Unsupported compressed texture format");
 	}
 
-	texture2D->Create(static_cast<uint16_t>(g3dTexture.ddsHeader.width), static_cast<uint16_t>(g3dTexture.ddsHeader.height), 1,
-	                  internalFormat, graphics::Wrapping::Repeat, graphics::Filter::Linear, g3dTexture.ddsData.data(),
-	                  static_cast<uint32_t>(g3dTexture.ddsData.size()));
+	// Block compressed levels can't be averaged without decoding them, textures without stored mips only have one level
+	const auto levelCount = static_cast<uint8_t>(std::clamp(g3dTexture.ddsHeader.mipMapCount, 1u, 16u));
+	texture2D->Create(graphics::Wrapping::Repeat, graphics::Filter::Linear,
+	                  std::make_unique<graphics::MipChain>(static_cast<uint16_t>(g3dTexture.ddsHeader.width),
+	                                                       static_cast<uint16_t>(g3dTexture.ddsHeader.height),
+	                                                       internalFormat, g3dTexture.ddsData, levelCount));
 	return texture2D;
 }
 
@@ -142,8 +153,8 @@ Texture2DLoader::result_type Texture2DLoader::operator()(FromDiskTag, const std:
 	}
 
 	auto texture = std::make_shared<graphics::Texture2D>(("raw" / rawTexturePath.stem()).string());
-	texture->Create(width, height, 1, format, graphics::Wrapping::Repeat, graphics::Filter::Linear, data.data(),
-	                static_cast<uint32_t>(data.size()));
+	texture->Create(graphics::Wrapping::Repeat, graphics::Filter::Linear,
+	                std::make_unique<graphics::MipChain>(graphics::MipChain::Generate(width, height, format, data)));
 
 	return texture;
 }
@@ -196,6 +207,25 @@ SoundLoader::result_type SoundLoader::operator()(BaseLoader<audio::Sound>::FromB
 	return sound;
 }
 
+namespace
+{
+std::shared_ptr<Lights> ToLights(const glw::GLWFile& glw)
+{
+	auto lights = std::make_shared<Lights>();
+	for (auto entry : glw.GetGlows())
+	{
+		Glow glow;
+		glow.backgroundColour = glm::vec4(entry.red * 0.5f, entry.green * 0.5f, entry.blue * 0.5f, 1.0f);
+		glow.brightSpotColour = glm::vec4 {100.0f / 256.0f, 172 / 256.0f, 146.0f / 256.0f, 1.0f};
+		glow.backgroundScale = (1.0f / 3) * 2.0f;
+		glow.brightSpotScale = 1.3f;
+		glow.position = glm::vec3(entry.posX, entry.posY, entry.posZ);
+		lights->emitters.emplace_back(LightEmitter {glow});
+	}
+	return lights;
+}
+} // namespace
+
 LightLoader::result_type LightLoader::operator()(BaseLoader<Lights>::FromDiskTag, const std::filesystem::path& path) const
 {
 	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading lights from file: {}", path.string());
@@ -208,16 +238,17 @@ LightLoader::result_type LightLoader::operator()(BaseLoader<Lights>::FromDiskTag
 		                    glw::ResultToStr(result));
 		throw glw::ResultToStr(result);
 	}
-	auto lights = std::make_shared<Lights>();
-	for (auto entry : glw.GetGlows())
+	return ToLights(glw);
+}
+
+LightLoader::result_type LightLoader::operator()(BaseLoader<Lights>::FromBufferTag, const std::vector<uint8_t>& data) const
+{
+	glw::GLWFile glw;
+
+	const auto result = glw.Open(data);
+	if (result != glw::GLWResult::Success)
 	{
-		Glow glow;
-		glow.backgroundColour = glm::vec4(entry.red * 0.5f, entry.green * 0.5f, entry.blue * 0.5f, 1.0f);
-		glow.brightSpotColour = glm::vec4 {100.0f / 256.0f, 172 / 256.0f, 146.0f / 256.0f, 1.0f};
-		glow.backgroundScale = (1.0f / 3) * 2.0f;
-		glow.brightSpotScale = 1.3f;
-		glow.position = glm::vec3(entry.posX, entry.posY, entry.posZ);
-		lights->emitters.emplace_back(LightEmitter {glow});
+		throw std::runtime_error(fmt::format("Failed to open glw file from buffer: {}", glw::ResultToStr(result)));
 	}
-	return lights;
+	return ToLights(glw);
 }
@@ -25,6 +25,11 @@ class L3DMesh;
 class Texture2D;
 } // namespace openblack::graphics
 
+namespace openblack::l3d
+{
+class L3DCookedFile;
+} // namespace openblack::l3d
+
 namespace openblack::pack
 {
 struct AudioBankSampleHeader;
@@ -49,6 +54,13 @@ struct BaseLoader
 
 struct L3DLoader final: BaseLoader<graphics::L3DMesh>
 {
+	/// Meshes cooked ahead of time, the cooked file is not referenced once loaded
+	struct FromCookedTag
+	{
+	};
+
+	[[nodiscard]] result_type operator()(FromCookedTag, const std::string& debugName,
+	                                     const l3d::L3DCookedFile& cooked) const;
 	[[nodiscard]] result_type operator()(FromBufferTag, const std::string& debugName, const std::vector<uint8_t>& data) const;
 	[[nodiscard]] result_type operator()(FromDiskTag, const std::filesystem::path& path) const;
 };
@@ -87,6 +99,7 @@ struct SoundLoader final: BaseLoader<audio::Sound>
 
 struct LightLoader final: BaseLoader<Lights>
 {
+	[[nodiscard]] result_type operator()(FromBufferTag, const std::vector<uint8_t>& data) const;
 	[[nodiscard]] result_type operator()(FromDiskTag, const std::filesystem::path& path) const;
 };
 } // namespace openblack::resources
@@ -9,11 +9,19 @@
 
 #pragma once
 
+#include <cstdint>
+
+#include <array>
+#include <limits>
+#include <string>
+
 #include <entt/core/hashed_string.hpp>
 #include <entt/fwd.hpp>
 #include <entt/resource/cache.hpp>
 #include <fmt/format.h>
 
+#include "Common/MemoryTracker.h"
+
 namespace openblack::resources
 {
 template <typename T>
@@ -29,7 +37,17 @@ template <typename T>
 	}
 	else
 	{
-		return entt::hashed_string(fmt::format("{}", static_cast<uint32_t>(identifier)).c_str());
+		// Hash of the decimal representation of the id, written out here so that no string is allocated and
+		// identifiers known at compile time are hashed at compile time
+		auto value = static_cast<uint32_t>(identifier);
+		std::array<char, std::numeric_limits<uint32_t>::digits10 + 1> digits {};
+		auto first = digits.size();
+		do
+		{
+			digits.at(--first) = static_cast<char>('0' + value % 10);
+			value /= 10;
+		} while (value != 0);
+		return entt::hashed_string::value(digits.data() + first, digits.size() - first);
 	}
 }
 
@@ -42,6 +60,7 @@ class ResourceManager
 	template <typename... Args>
 	[[maybe_unused]] decltype(auto) Load(entt::id_type identifier, Args&&... args)
 	{
+		const MemoryTracker::Scope memory(MemoryTag::Resources);
 		return _resourceCache.load(identifier, std::forward<Args>(args)...);
 	}
 
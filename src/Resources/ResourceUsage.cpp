@@ -0,0 +1,109 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "ResourceUsage.h"
+
+#include "3D/L3DMesh.h"
+#include "3D/L3DSubMesh.h"
+#include "Graphics/IndexBuffer.h"
+#include "Graphics/Mesh.h"
+#include "Graphics/MipChain.h"
+#include "Graphics/Texture2D.h"
+#include "Graphics/VertexBuffer.h"
+#include "ResourcesInterface.h"
+
+using namespace openblack;
+using namespace openblack::resources;
+
+namespace
+{
+template <typename Container>
+uint64_t GetContentSize(const Container& container)
+{
+	return container.size() * sizeof(typename Container::value_type);
+}
+
+CacheUsage GetMeshUsage(const MeshManager& meshes)
+{
+	CacheUsage usage {"Meshes", meshes.Size(), 0, 0};
+	meshes.Each([&usage](entt::id_type /*unused*/, const auto& mesh) {
+		usage.cpuBytes += GetContentSize(mesh->GetBoneParents()) + GetContentSize(mesh->GetBoneMatrices()) +
+		                  GetContentSize(mesh->GetExtraMetrics()) + GetContentSize(mesh->GetFootprints());
+		for (const auto& subMesh : mesh->GetSubMeshes())
+		{
+			usage.cpuBytes += sizeof(graphics::L3DSubMesh) + GetContentSize(subMesh->GetPrimitives());
+		}
+		for (const auto& footprint : mesh->GetFootprints())
+		{
+			if (footprint.texture != nullptr)
+			{
+				usage.gpuBytes += footprint.texture->GetSize();
+			}
+			if (footprint.mesh != nullptr)
+			{
+				usage.gpuBytes +=
+				    footprint.mesh->GetVertexBuffer().GetSizeInBytes() + footprint.mesh->GetIndexBuffer().GetSize();
+			}
+		}
+	});
+	return usage;
+}
+
+CacheUsage GetTextureUsage(const TextureManager& textures)
+{
+	CacheUsage usage {"Textures", textures.Size(), 0, 0};
+	textures.Each([&usage](entt::id_type /*unused*/, const auto& texture) {
+		// Textures with a mip chain keep it to restore the levels dropped to fit the budget
+		if (const auto* mipChain = texture->GetMipChain(); mipChain != nullptr)
+		{
+			usage.cpuBytes += mipChain->GetSize();
+		}
+		usage.gpuBytes += texture->GetSize();
+	});
+	return usage;
+}
+
+CacheUsage GetAnimationUsage(const AnimationManager& animations)
+{
+	CacheUsage usage {"Animations", animations.Size(), 0, 0};
+	animations.Each([&usage](entt::id_type /*unused*/, const auto& animation) {
+		usage.cpuBytes += GetContentSize(animation->GetFrames());
+		for (const auto& frame : animation->GetFrames())
+		{
+			usage.cpuBytes += GetContentSize(frame.bones);
+		}
+	});
+	return usage;
+}
+
+CacheUsage GetSoundUsage(const SoundManager& sounds)
+{
+	CacheUsage usage {"Sounds", sounds.Size(), 0, 0};
+	sounds.Each([&usage](entt::id_type /*unused*/, const auto& sound) {
+		for (const auto& buffer : sound->buffer)
+		{
+			usage.cpuBytes += buffer.size();
+		}
+	});
+	return usage;
+}
+} // namespace
+
+std::vector<CacheUsage> openblack::resources::GetCacheUsage(ResourcesInterface& resources)
+{
+	return {
+	    GetMeshUsage(resources.GetMeshes()),
+	    GetTextureUsage(resources.GetTextures()),
+	    GetAnimationUsage(resources.GetAnimations()),
+	    GetSoundUsage(resources.GetSounds()),
+	    {"Levels", resources.GetLevels().Size(), 0, 0},
+	    {"Creature Minds", resources.GetCreatureMinds().Size(), 0, 0},
+	    {"Glows", resources.GetGlows().Size(), 0, 0},
+	};
+}
@@ -0,0 +1,35 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <string_view>
+#include <vector>
+
+namespace openblack::resources
+{
+class ResourcesInterface;
+
+/// Entries of a resource cache with an estimate of the memory they hold, 0 where it is not estimated
+struct CacheUsage
+{
+	std::string_view name;
+	size_t count;
+	/// Bytes of the data the resources keep in main memory
+	uint64_t cpuBytes;
+	/// Bytes of the textures and buffers the resources uploaded, without the vertices of meshes held by the mesh pools
+	uint64_t gpuBytes;
+};
+
+[[nodiscard]] std::vector<CacheUsage> GetCacheUsage(ResourcesInterface& resources);
+
+} // namespace openblack::resources
@@ -11,6 +11,8 @@
 
 #include "ResourcesInterface.h"
 
+#include "Graphics/TextureResidency.h"
+
 #if !defined(LOCATOR_IMPLEMENTATIONS)
 #error "Locator interface implementations should only be included in Locator.cpp, use interface instead."
 #endif
@@ -27,6 +29,7 @@ class Resources final: public ResourcesInterface
 	CreatureMindManager& GetCreatureMinds() override { return _creatureMinds; }
 	SoundManager& GetSounds() override { return _sounds; }
 	GlowManager& GetGlows() override { return _glows; }
+	graphics::TextureResidency& GetTextureResidency() override { return _textureResidency; }
 
 private:
 	MeshManager _meshes;
@@ -36,5 +39,6 @@ class Resources final: public ResourcesInterface
 	CreatureMindManager _creatureMinds;
 	SoundManager _sounds;
 	GlowManager _glows;
+	graphics::TextureResidency _textureResidency;
 };
 } // namespace openblack::resources
@@ -12,6 +12,11 @@
 #include "Loaders.h"
 #include "ResourceManager.h"
 
+namespace openblack::graphics
+{
+class TextureResidency;
+} // namespace openblack::graphics
+
 namespace openblack::resources
 {
 using MeshManager = ResourceManager<L3DLoader>;
@@ -32,6 +37,7 @@ class ResourcesInterface
 	virtual CreatureMindManager& GetCreatureMinds() = 0;
 	virtual SoundManager& GetSounds() = 0;
 	virtual GlowManager& GetGlows() = 0;
+	virtual graphics::TextureResidency& GetTextureResidency() = 0;
 };
 
 } // namespace openblack::resources
@@ -9,6 +9,9 @@
 
 #include "FotFile.h"
 
+#include <optional>
+#include <vector>
+
 #include <spdlog/spdlog.h>
 
 #include "3D/LandIslandInterface.h"
@@ -19,7 +22,6 @@
 #include "Locator.h"
 
 using namespace openblack;
-using namespace openblack::filesystem;
 
 FotFile::FotFile(Game& game)
     : _game(game)
@@ -28,27 +30,38 @@ FotFile::FotFile(Game& game)
 
 void FotFile::Load(const std::filesystem::path& path)
 {
-	auto stream = Locator::filesystem::value().Open(path, Stream::Mode::Read);
-	serializer::GameThingSerializer serializer(*stream);
-	auto footpathLinkSaves = serializer.DeserializeList<serializer::GameThingSerializer::FootpathLinkSave>();
-	auto footpaths = serializer.DeserializeList<serializer::GameThingSerializer::Footpath>();
+	const auto data = Locator::filesystem::value().ReadAll(path);
+	serializer::GameThingReader reader(data);
+	const auto footpathLinkSaves = reader.ReadList(serializer::FootpathLinkSave::k_Type);
+	const auto footpaths = reader.ReadList(serializer::Footpath::k_Type);
+	const auto& things = reader.GetThings();
 	auto& registry = Locator::entitiesRegistry::value();
 	const auto& island = Locator::terrainSystem::value();
 
-	// Keep track of footpath entities in order to associate them to the footpath link saves later
-	std::vector<ecs::components::Footpath::Id> footpathEntities;
+	// Footpath entities by thing id, to associate them to the footpath link saves later
+	std::vector<std::optional<ecs::components::Footpath::Id>> footpathEntities(things.Size() + 1);
 
-	for (const auto& footpath : footpaths)
+	for (const auto id : footpaths)
 	{
+		const auto* footpath = things.Find<serializer::Footpath>(id);
+		if (footpath == nullptr)
+		{
+			continue;
+		}
 		const auto entity = registry.Create();
 		auto& footpathEntt = registry.Assign<ecs::components::Footpath>(entity);
-		footpathEntt.nodes.reserve(footpath.nodes.size());
-		for (const auto& node : footpath.nodes)
+		footpathEntt.nodes.reserve(footpath->nodes.size());
+		for (const auto nodeId : footpath->nodes)
 		{
+			const auto* node = things.Find<serializer::FootpathNode>(nodeId);
+			if (node == nullptr)
+			{
+				continue;
+			}
 			glm::vec3 position = glm::vec3 {
-			    10.0f * node.coords.x / static_cast<float>(0xFFFF),
-			    node.coords.altitude,
-			    10.0f * node.coords.z / static_cast<float>(0xFFFF),
+			    10.0f * node->coords.x / static_cast<float>(0xFFFF),
+			    node->coords.altitude,
+			    10.0f * node->coords.z / static_cast<float>(0xFFFF),
 			};
 
 			// This bit is mainly for visualization, it could be that using these offsets causes uses for path planning
@@ -57,24 +70,35 @@ void FotFile::Load(const std::filesystem::path& path)
 
 			footpathEntt.nodes.push_back({position});
 		}
-		footpathEntities.push_back(static_cast<ecs::components::Footpath::Id>(entity));
+		footpathEntities[id] = static_cast<ecs::components::Footpath::Id>(entity);
 	}
 
-	for (const auto& save : footpathLinkSaves)
+	for (const auto id : footpathLinkSaves)
 	{
+		const auto* save = things.Find<serializer::FootpathLinkSave>(id);
+		const auto* link = save != nullptr ? things.Find<serializer::FootpathLink>(save->link) : nullptr;
+		if (link == nullptr)
+		{
+			continue;
+		}
 		std::vector<ecs::components::Footpath::Id> linkFootpathEntities;
-		for (const auto& footpath : save.link.footpaths)
+		linkFootpathEntities.reserve(link->footpaths.size());
+		for (const auto footpathId : link->footpaths)
 		{
-			// Save links have duplicates to entries in footpaths
-			const auto footpathListItr = std::find(footpaths.cbegin(), footpaths.cend(), footpath);
-			assert(footpathListItr != footpaths.cend());
-			const auto footpathIndex = std::distance(footpaths.cbegin(), footpathListItr);
-			linkFootpathEntities.push_back(footpathEntities[footpathIndex]);
+			// Links refer to the same footpath things as the list of footpaths
+			const auto& footpathEntity = footpathEntities[footpathId];
+			if (!footpathEntity.has_value())
+			{
+				SPDLOG_LOGGER_WARN(spdlog::get("game"), "Footpath link refers to footpath {} which is not in {}",
+				                   footpathId, path.generic_string());
+				continue;
+			}
+			linkFootpathEntities.push_back(*footpathEntity);
 		}
 		glm::vec3 position = glm::vec3 {
-		    10.0f * save.coords.x / static_cast<float>(0xFFFF),
-		    save.coords.altitude,
-		    10.0f * save.coords.z / static_cast<float>(0xFFFF),
+		    10.0f * save->coords.x / static_cast<float>(0xFFFF),
+		    save->coords.altitude,
+		    10.0f * save->coords.z / static_cast<float>(0xFFFF),
 		};
 		const auto entity = registry.Create();
 		registry.Assign<ecs::components::FootpathLink>(entity, position, std::move(linkFootpathEntities));
@@ -9,215 +9,272 @@
 
 #include "GameThingSerializer.h"
 
-#include <cassert>
+#include <cstring>
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <type_traits>
 
 #include <spdlog/fmt/fmt.h>
 #include <spdlog/spdlog.h>
 
-#include "FileSystem/Stream.h"
-
 using namespace openblack::serializer;
-using namespace openblack::filesystem;
 
-template <>
-constexpr GameThingType openblack::serializer::k_GameThingTypeEnum<GameThingSerializer::Footpath> = GameThingType::Footpath;
+namespace
+{
+using ReadFunction = GameThingId (*)(GameThingReader& reader, GameThings& things, uint32_t player);
+using WriteFunction = void (*)(GameThingWriter& writer, const GameThings& things, GameThingId id);
 
-template <>
-constexpr GameThingType openblack::serializer::k_GameThingTypeEnum<GameThingSerializer::FootpathLink> =
-    GameThingType::FootpathLink;
+struct GameThingTypeInfo
+{
+	ReadFunction read;
+	WriteFunction write;
+};
 
-template <>
-constexpr GameThingType openblack::serializer::k_GameThingTypeEnum<GameThingSerializer::FootpathNode> =
-    GameThingType::FootpathNode;
+template <typename T>
+GameThingId ReadThing(GameThingReader& reader, GameThings& things, uint32_t player)
+{
+	// The id is taken before the body is read as things nested in it come after it in the file
+	const auto id = things.Add(T {}, player);
+	T thing {};
+	thing.Read(reader);
+	things.Get<T>(id) = std::move(thing);
+	return id;
+}
 
-template <>
-constexpr GameThingType openblack::serializer::k_GameThingTypeEnum<GameThingSerializer::FootpathLinkSave> =
-    GameThingType::FootpathLinkSave;
+template <typename T>
+void WriteThing(GameThingWriter& writer, const GameThings& things, GameThingId id)
+{
+	things.Get<T>(id).Write(writer);
+}
 
-GameThingSerializer::GameThingSerializer(Stream& stream)
-    : _stream(stream)
+template <typename... Ts>
+constexpr auto MakeTypeTable(std::type_identity<std::tuple<Ts...>> /*unused*/)
+{
+	std::array<GameThingTypeInfo, static_cast<size_t>(GameThingType::_COUNT)> table {};
+	((table.at(static_cast<size_t>(Ts::k_Type)) = {&ReadThing<Ts>, &WriteThing<Ts>}), ...);
+	return table;
+}
+
+constexpr auto k_TypeTable = MakeTypeTable(std::type_identity<GameThingTypes> {});
+
+const GameThingTypeInfo* FindTypeInfo(GameThingType type)
+{
+	const auto index = static_cast<size_t>(type);
+	if (index >= k_TypeTable.size() || k_TypeTable.at(index).read == nullptr)
+	{
+		return nullptr;
+	}
+	return &k_TypeTable.at(index);
+}
+} // namespace
+
+GameThingReader::GameThingReader(std::span<const uint8_t> data)
+    : _data(data)
 {
 }
 
 template <typename T>
-T GameThingSerializer::ReadValue()
+T GameThingReader::ReadValue()
 {
-	auto result = _stream.ReadValue<T>();
-	_checkSum += static_cast<uint32_t>(*reinterpret_cast<uint8_t*>(&result)) + sizeof(result);
+	static_assert(std::is_trivially_copyable_v<T>);
+	if (_data.size() - _position < sizeof(T))
+	{
+		throw std::runtime_error(fmt::format("Unexpected end of GameThing data at 0x{:08x}", _position));
+	}
+	T result;
+	std::memcpy(&result, _data.data() + _position, sizeof(T));
+	// The checksum adds up the first byte and the size of every value
+	_checkSum += static_cast<uint32_t>(_data[_position]) + static_cast<uint32_t>(sizeof(T));
+	_position += sizeof(T);
 	return result;
 }
 
-void GameThingSerializer::ReadChecksum()
+void GameThingReader::ReadChecksum()
 {
 	auto expectedSum = _checkSum;
 	auto readSum = ReadValue<uint32_t>();
 	if (expectedSum != readSum)
 	{
 		SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Failed checksum (expected={:08X}, read={:08X}) at {:08X}", expectedSum,
-		                    readSum, _stream.Position());
+		                    readSum, _position);
 		assert(false);
 	}
 }
 
-std::shared_ptr<GameThingSerializer::GameThing> GameThingSerializer::DeserializeOne(std::optional<GameThingType> requiredType)
+GameThingId GameThingReader::ReadThing(std::optional<GameThingType> requiredType)
 {
-	[[maybe_unused]] const auto offset = _stream.Position();
-	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "offset={}", offset);
-	auto index = ReadValue<uint32_t>();
-	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "index={}, len={}", index, _cache.size());
+	const auto id = ReadValue<GameThingId>();
 
-	if (index == 0)
+	if (id == k_NoGameThing)
 	{
 		// TODO(@bwrsandman): not sure why there are these empty entries
-		return nullptr;
+		return k_NoGameThing;
 	}
 
-	if (index == _cache.size() + 1)
+	if (id <= _things.Size())
 	{
-		auto type = ReadValue<GameThingType>();
-		if (type != requiredType.value_or(type))
-		{
-			throw std::runtime_error(fmt::format("Type mismatch while parsing GameThing: got {} but expected {} at 0x{:08x}",
-			                                     static_cast<uint32_t>(type), static_cast<uint32_t>(*requiredType),
-			                                     _stream.Position() - sizeof(GameThingType)));
-		}
-		[[maybe_unused]] const auto playerId = ReadValue<uint32_t>();
-		ReadChecksum();
-		// TODO(#479): validate checksum by adding up first byte of every read
-
-		std::shared_ptr<GameThing> thing;
-
-		switch (type)
-		{
-		case GameThingType::Footpath:
-			thing = std::make_unique<Footpath>();
-			break;
-		case GameThingType::FootpathLink:
-			thing = std::make_unique<FootpathLink>();
-			break;
-		case GameThingType::FootpathNode:
-			thing = std::make_unique<FootpathNode>();
-			break;
-		case GameThingType::FootpathLinkSave:
-			thing = std::make_unique<FootpathLinkSave>();
-			break;
-		default:
-			assert(false);
-		}
-
-		_cache.push_back(thing);
-
-		if (!thing->Deserialize(*this))
-		{
-			return nullptr;
-		}
-
-		// TODO(@bwrsandman): return something?
-
-		return thing;
+		// Referring to a previously read thing, which a list of another type skips
+		return _things.GetType(id) == requiredType.value_or(_things.GetType(id)) ? id : k_NoGameThing;
 	}
-	if (index > _cache.size())
+
+	if (id != _things.Size() + 1)
 	{
-		assert(false); // weird case
-		return nullptr;
+		throw std::runtime_error(fmt::format("GameThing {} read before GameThing {} at 0x{:08x}", id, _things.Size() + 1,
+		                                     _position - sizeof(GameThingId)));
+	}
+
+	const auto type = ReadValue<GameThingType>();
+	if (type != requiredType.value_or(type))
+	{
+		throw std::runtime_error(fmt::format("Type mismatch while parsing GameThing: got {} but expected {} at 0x{:08x}",
+		                                     static_cast<uint32_t>(type), static_cast<uint32_t>(*requiredType),
+		                                     _position - sizeof(GameThingType)));
+	}
+	const auto* info = FindTypeInfo(type);
+	if (info == nullptr)
+	{
+		throw std::runtime_error(fmt::format("Unsupported GameThing type {} at 0x{:08x}", static_cast<uint32_t>(type),
+		                                     _position - sizeof(GameThingType)));
 	}
-	// referring to a previously seen entry
-	return _cache[index - 1];
+	const auto player = ReadValue<uint32_t>();
+	ReadChecksum();
+
+	return info->read(*this, _things, player);
 }
 
-template <typename T>
-std::vector<T> GameThingSerializer::DeserializeList()
+std::vector<GameThingId> GameThingReader::ReadList(std::optional<GameThingType> requiredType)
 {
-	auto count = ReadValue<uint32_t>();
-	std::vector<T> list;
-	list.reserve(count);
+	const auto count = ReadValue<uint32_t>();
+	// Every entry takes at least an id, which bounds the reservation of a corrupt count
+	std::vector<GameThingId> list;
+	list.reserve(std::min<size_t>(count, (_data.size() - _position) / sizeof(GameThingId)));
 	for (uint32_t i = 0; i < count; ++i)
 	{
-		SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "i={}", i);
-		auto ptr = std::dynamic_pointer_cast<T>(DeserializeOne(k_GameThingTypeEnum<T>));
-		if (ptr)
-		{
-			list.push_back(*ptr);
-		}
+		list.push_back(ReadThing(requiredType));
 	}
 	return list;
 }
 
-bool GameThingSerializer::GameThing::Deserialize(GameThingSerializer& deserializer)
+GameThingWriter::GameThingWriter(const GameThings& things)
+    : _things(things)
+    , _writtenIds(things.Size(), k_NoGameThing)
 {
-	unknown1 = deserializer.ReadValue<uint32_t>();
-	unknown2 = deserializer.ReadValue<uint8_t>();
-	return true;
 }
 
-bool GameThingSerializer::GameThing::operator==(const GameThingSerializer::GameThing& rhs) const
+template <typename T>
+void GameThingWriter::WriteValue(const T& value)
 {
-	return unknown1 == rhs.unknown1 && unknown2 == rhs.unknown2;
+	static_assert(std::is_trivially_copyable_v<T>);
+	const auto offset = _data.size();
+	_data.resize(offset + sizeof(T));
+	std::memcpy(_data.data() + offset, &value, sizeof(T));
+	_checkSum += static_cast<uint32_t>(_data[offset]) + static_cast<uint32_t>(sizeof(T));
 }
 
-bool GameThingSerializer::GameThing::operator!=(const GameThingSerializer::GameThing& rhs) const
+void GameThingWriter::WriteChecksum()
 {
-	return !(*this == rhs);
+	WriteValue(_checkSum);
 }
 
-bool GameThingSerializer::Footpath::Deserialize(GameThingSerializer& deserializer)
+void GameThingWriter::WriteThing(GameThingId id)
 {
-	GameThing::Deserialize(deserializer);
-	nodes = deserializer.DeserializeList<FootpathNode>();
-	unknown = deserializer.ReadValue<uint32_t>();
-	return true;
+	const auto type = _things.GetType(id);
+	if (type == GameThingType::Invalid)
+	{
+		WriteValue(k_NoGameThing);
+		return;
+	}
+
+	auto& writtenId = _writtenIds[id - 1];
+	if (writtenId != k_NoGameThing)
+	{
+		WriteValue(writtenId);
+		return;
+	}
+
+	const auto* info = FindTypeInfo(type);
+	assert(info != nullptr);
+	writtenId = ++_writtenCount;
+	WriteValue(writtenId);
+	WriteValue(type);
+	WriteValue(_things.GetPlayer(id));
+	WriteChecksum();
+	info->write(*this, _things, id);
 }
 
-bool GameThingSerializer::Footpath::operator==(const GameThingSerializer::Footpath& rhs) const
+void GameThingWriter::WriteList(std::span<const GameThingId> ids)
 {
-	return static_cast<const GameThing&>(*this) == static_cast<const GameThing&>(rhs) && nodes == rhs.nodes &&
-	       unknown == rhs.unknown;
+	WriteValue(static_cast<uint32_t>(ids.size()));
+	for (const auto id : ids)
+	{
+		WriteThing(id);
+	}
 }
 
-bool GameThingSerializer::Footpath::operator!=(const GameThingSerializer::Footpath& rhs) const
+void GameThing::Read(GameThingReader& reader)
 {
-	return !(*this == rhs);
+	unknown1 = reader.ReadValue<uint32_t>();
+	unknown2 = reader.ReadValue<uint8_t>();
 }
 
-bool GameThingSerializer::FootpathLink::Deserialize(GameThingSerializer& deserializer)
+void GameThing::Write(GameThingWriter& writer) const
 {
-	GameThing::Deserialize(deserializer);
-	footpaths = deserializer.DeserializeList<Footpath>();
-	return true;
+	writer.WriteValue(unknown1);
+	writer.WriteValue(unknown2);
 }
 
-bool GameThingSerializer::FootpathNode::Deserialize(GameThingSerializer& deserializer)
+void FootpathNode::Read(GameThingReader& reader)
 {
-	GameThing::Deserialize(deserializer);
-	coords = deserializer.ReadValue<MapCoords>();
-	unknown = deserializer.ReadValue<uint8_t>();
-	return true;
+	GameThing::Read(reader);
+	coords = reader.ReadValue<MapCoords>();
+	unknown = reader.ReadValue<uint8_t>();
 }
 
-bool GameThingSerializer::FootpathNode::operator==(const GameThingSerializer::FootpathNode& rhs) const
+void FootpathNode::Write(GameThingWriter& writer) const
 {
-	return static_cast<const GameThing&>(*this) == static_cast<const GameThing&>(rhs) && coords == rhs.coords &&
-	       unknown == rhs.unknown;
+	GameThing::Write(writer);
+	writer.WriteValue(coords);
+	writer.WriteValue(unknown);
 }
 
-bool GameThingSerializer::FootpathNode::operator!=(const GameThingSerializer::FootpathNode& rhs) const
+void Footpath::Read(GameThingReader& reader)
 {
-	return !(*this == rhs);
+	GameThing::Read(reader);
+	nodes = reader.ReadList(FootpathNode::k_Type);
+	unknown = reader.ReadValue<uint32_t>();
 }
 
-bool GameThingSerializer::FootpathLinkSave::Deserialize(GameThingSerializer& deserializer)
+void Footpath::Write(GameThingWriter& writer) const
 {
-	GameThing::Deserialize(deserializer);
-	coords = deserializer.ReadValue<MapCoords>();
-	auto thing = deserializer.DeserializeOne(GameThingType::FootpathLink);
-	if (thing)
-	{
-		assert(dynamic_cast<FootpathLink*>(thing.get()));
-		link = *dynamic_cast<FootpathLink*>(thing.get());
-		return true;
-	}
-	return false;
+	GameThing::Write(writer);
+	writer.WriteList(nodes);
+	writer.WriteValue(unknown);
 }
 
-// Force initialization of template function
-template std::vector<GameThingSerializer::FootpathLinkSave> GameThingSerializer::DeserializeList();
+void FootpathLink::Read(GameThingReader& reader)
+{
+	GameThing::Read(reader);
+	footpaths = reader.ReadList(Footpath::k_Type);
+}
+
+void FootpathLink::Write(GameThingWriter& writer) const
+{
+	GameThing::Write(writer);
+	writer.WriteList(footpaths);
+}
+
+void FootpathLinkSave::Read(GameThingReader& reader)
+{
+	GameThing::Read(reader);
+	coords = reader.ReadValue<MapCoords>();
+	link = reader.ReadThing(FootpathLink::k_Type);
+}
+
+void FootpathLinkSave::Write(GameThingWriter& writer) const
+{
+	GameThing::Write(writer);
+	writer.WriteValue(coords);
+	writer.WriteThing(link);
+}
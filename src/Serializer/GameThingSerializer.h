@@ -9,20 +9,18 @@
 
 #pragma once
 
+#include <cassert>
+#include <cstddef>
 #include <cstdint>
 
-#include <memory>
 #include <optional>
-#include <type_traits>
+#include <span>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #include "Common.h"
 
-namespace openblack::filesystem
-{
-class Stream;
-}
-
 namespace openblack::serializer
 {
 
@@ -33,75 +31,214 @@ enum class GameThingType : uint32_t
 	FootpathLink = 0x2,
 	FootpathNode = 0x3,
 	FootpathLinkSave = 0x4,
+
+	_COUNT
+};
+
+/// Position of a thing in the order it was first written to a file, starting at 1. 0 refers to no thing.
+using GameThingId = uint32_t;
+constexpr GameThingId k_NoGameThing = 0;
+
+class GameThingReader;
+class GameThingWriter;
+
+/*
+  Things are plain structures which refer to other things by id. Supporting a new type of thing takes a value in
+  GameThingType, a structure with its k_Type, Read and Write and adding it to GameThingTypes.
+ */
+
+struct GameThing
+{
+	uint32_t unknown1;
+	uint8_t unknown2;
+
+	void Read(GameThingReader& reader);
+	void Write(GameThingWriter& writer) const;
+	bool operator==(const GameThing& rhs) const = default;
+};
+
+struct FootpathNode final: GameThing
+{
+	static constexpr GameThingType k_Type = GameThingType::FootpathNode;
+
+	MapCoords coords;
+	uint8_t unknown;
+
+	void Read(GameThingReader& reader);
+	void Write(GameThingWriter& writer) const;
+	bool operator==(const FootpathNode& rhs) const = default;
+};
+
+struct Footpath final: GameThing
+{
+	static constexpr GameThingType k_Type = GameThingType::Footpath;
+
+	std::vector<GameThingId> nodes;
+	uint32_t unknown;
+
+	void Read(GameThingReader& reader);
+	void Write(GameThingWriter& writer) const;
+	bool operator==(const Footpath& rhs) const = default;
+};
+
+struct FootpathLink final: GameThing
+{
+	static constexpr GameThingType k_Type = GameThingType::FootpathLink;
+
+	std::vector<GameThingId> footpaths;
+
+	void Read(GameThingReader& reader);
+	void Write(GameThingWriter& writer) const;
+	bool operator==(const FootpathLink& rhs) const = default;
+};
+
+struct FootpathLinkSave final: GameThing
+{
+	static constexpr GameThingType k_Type = GameThingType::FootpathLinkSave;
+
+	MapCoords coords;
+	GameThingId link;
+
+	void Read(GameThingReader& reader);
+	void Write(GameThingWriter& writer) const;
+	bool operator==(const FootpathLinkSave& rhs) const = default;
 };
 
-template <typename T>
-static const GameThingType k_GameThingTypeEnum = GameThingType::Invalid;
+using GameThingTypes = std::tuple<FootpathNode, Footpath, FootpathLink, FootpathLinkSave>;
 
-class GameThingSerializer
+/// Things of a file by id, each type stored contiguously
+class GameThings
 {
 public:
-	struct GameThing
+	[[nodiscard]] size_t Size() const { return _entries.size(); }
+	[[nodiscard]] GameThingType GetType(GameThingId id) const
 	{
-		uint32_t unknown1;
-		uint8_t unknown2;
+		return id == k_NoGameThing || id > _entries.size() ? GameThingType::Invalid : _entries[id - 1].type;
+	}
+	[[nodiscard]] uint32_t GetPlayer(GameThingId id) const { return _entries.at(id - 1).player; }
 
-		virtual ~GameThing() = default;
+	template <typename T>
+	GameThingId Add(T thing, uint32_t player = 0)
+	{
+		auto& storage = GetStorage<T>();
+		_entries.push_back({T::k_Type, static_cast<uint32_t>(storage.size()), player});
+		storage.push_back(std::move(thing));
+		return static_cast<GameThingId>(_entries.size());
+	}
 
-		virtual bool Deserialize(GameThingSerializer& deserializer);
-		bool operator==(const GameThing& rhs) const;
-		bool operator!=(const GameThing& rhs) const;
-	};
+	/// The thing of an id, or nullptr if there is none of that type
+	template <typename T>
+	[[nodiscard]] const T* Find(GameThingId id) const
+	{
+		if (GetType(id) != T::k_Type)
+		{
+			return nullptr;
+		}
+		return &GetStorage<T>()[_entries[id - 1].index];
+	}
 
-	struct FootpathNode final: GameThing
+	template <typename T>
+	[[nodiscard]] const T& Get(GameThingId id) const
 	{
-		MapCoords coords;
-		uint8_t unknown;
+		assert(GetType(id) == T::k_Type);
+		return GetStorage<T>()[_entries[id - 1].index];
+	}
 
-		bool Deserialize(GameThingSerializer& deserializer) override;
-		bool operator==(const FootpathNode& rhs) const;
-		bool operator!=(const FootpathNode& rhs) const;
-	};
+	template <typename T>
+	[[nodiscard]] T& Get(GameThingId id)
+	{
+		assert(GetType(id) == T::k_Type);
+		return GetStorage<T>()[_entries[id - 1].index];
+	}
 
-	struct Footpath final: GameThing
+	/// All things of a type, in the order they were added
+	template <typename T>
+	[[nodiscard]] std::span<const T> GetAll() const
 	{
-		std::vector<FootpathNode> nodes;
-		uint32_t unknown;
+		return GetStorage<T>();
+	}
 
-		bool Deserialize(GameThingSerializer& deserializer) override;
-		bool operator==(const Footpath& rhs) const;
-		bool operator!=(const Footpath& rhs) const;
+private:
+	template <typename Types>
+	struct Storage;
+	template <typename... Ts>
+	struct Storage<std::tuple<Ts...>>
+	{
+		using Type = std::tuple<std::vector<Ts>...>;
 	};
 
-	struct FootpathLink final: GameThing
+	struct Entry
 	{
-		std::vector<Footpath> footpaths;
-
-		bool Deserialize(GameThingSerializer& deserializer) override;
+		GameThingType type;
+		uint32_t index;
+		uint32_t player;
 	};
 
-	struct FootpathLinkSave final: GameThing
+	template <typename T>
+	[[nodiscard]] std::vector<T>& GetStorage()
 	{
-		MapCoords coords;
-		FootpathLink link;
+		return std::get<std::vector<T>>(_storage);
+	}
 
-		bool Deserialize(GameThingSerializer& deserializer) override;
-	};
+	template <typename T>
+	[[nodiscard]] const std::vector<T>& GetStorage() const
+	{
+		return std::get<std::vector<T>>(_storage);
+	}
 
-	explicit GameThingSerializer(filesystem::Stream& stream);
+	std::vector<Entry> _entries;
+	Storage<GameThingTypes>::Type _storage;
+};
+
+/// Reads things from a whole file in memory, resolving references to things already read by their id
+class GameThingReader
+{
+public:
+	explicit GameThingReader(std::span<const uint8_t> data);
 
 	template <typename T>
 	T ReadValue();
 
 	void ReadChecksum();
 
-	std::shared_ptr<GameThing> DeserializeOne(std::optional<GameThingType> requiredType = std::nullopt);
+	/// Read a thing or a reference to a previous one, returning its id
+	GameThingId ReadThing(std::optional<GameThingType> requiredType = std::nullopt);
+	/// Read a count followed by as many things, empty entries are kept as k_NoGameThing
+	std::vector<GameThingId> ReadList(std::optional<GameThingType> requiredType = std::nullopt);
+
+	[[nodiscard]] size_t Position() const { return _position; }
+	[[nodiscard]] const GameThings& GetThings() const { return _things; }
+	[[nodiscard]] GameThings ReleaseThings() { return std::move(_things); }
+
+private:
+	std::span<const uint8_t> _data;
+	size_t _position {0};
+	uint32_t _checkSum {0};
+	GameThings _things;
+};
+
+/// Writes things in the format read by GameThingReader, each thing is written once and referred to by id after that
+class GameThingWriter
+{
+public:
+	explicit GameThingWriter(const GameThings& things);
+
 	template <typename T>
-	std::vector<T> DeserializeList();
+	void WriteValue(const T& value);
+
+	void WriteChecksum();
+
+	void WriteThing(GameThingId id);
+	void WriteList(std::span<const GameThingId> ids);
+
+	[[nodiscard]] const std::vector<uint8_t>& GetData() const { return _data; }
 
 private:
-	filesystem::Stream& _stream;
+	const GameThings& _things;
+	std::vector<uint8_t> _data;
 	uint32_t _checkSum {0};
-	std::vector<std::shared_ptr<GameThing>> _cache;
+	/// Id in the file of each thing, k_NoGameThing until it is written
+	std::vector<GameThingId> _writtenIds;
+	GameThingId _writtenCount {0};
 };
 } // namespace openblack::serializer
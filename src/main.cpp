@@ -10,6 +10,7 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <tuple>
 
 #include <SDL_messagebox.h>
 #include <cxxopts.hpp>
@@ -44,7 +45,7 @@ bool parseOptions(int argc, char** argv, openblack::Arguments& args, int& return
 	// clang-format off
 	options.add_options()
 		("h,help", "Display this help message.")
-		("g,game-path", "Path to the Data/ and Scripts/ directories of the original Black & White game. (Required)", cxxopts::value<std::string>())
+		("g,game-path", "Path to the Data/ and Scripts/ directories of the original Black & White game, or an asset archive made by packtool. (Required)", cxxopts::value<std::string>())
 		("W,width", "Window resolution in the x axis.", cxxopts::value<uint16_t>()->default_value("1280"))
 		("H,height", "Window resolution in the y axis.", cxxopts::value<uint16_t>()->default_value("1024"))
 		("u,ui-scale", "Scaling of the GUI", cxxopts::value<float>()->default_value("1.0"))
@@ -56,8 +57,18 @@ bool parseOptions(int argc, char** argv, openblack::Arguments& args, int& return
 		("l,log-file", "Output file for logs, 'stdout'/'logcat' for terminal output.", cxxopts::value<std::string>()->default_value(defaultLogFile))
 		("L,log-level", "Level (trace, debug, info, warning, error, critical, off) of logging per subsystem (" + loggingSubsystems + ").",
 		    cxxopts::value<std::vector<std::string>>()->default_value("all=debug"))
+		("log-async", "Format and write logs on a background thread, dropping the oldest messages when it falls behind.")
 		("screenshot-frame", "Request a screenshot of the backbuffer at a certain frame number.", cxxopts::value<uint32_t>())
 		("screenshot-path", "Path of the request a screenshot of the backbuffer.", cxxopts::value<std::filesystem::path>()->default_value("screenshot.png"))
+		("record-input", "Record the input of every frame to a file which can be replayed.", cxxopts::value<std::filesystem::path>())
+		("replay-input", "Replay input recorded with --record-input instead of the user's input.", cxxopts::value<std::filesystem::path>())
+		("profile-scripts", "Write the time spent in each script and native function to a file as collapsed stacks on exit.", cxxopts::value<std::filesystem::path>())
+		("memory-report", "Write the allocations of each subsystem and the size of the resource caches to a CSV file after --simulate-turns.", cxxopts::value<std::filesystem::path>())
+		("mesh-cache", "Directory in which meshes are cooked on first load and read from afterwards.", cxxopts::value<std::filesystem::path>())
+		("mesh-vertices", "Vertex formats (full, compact, both) of meshes uploaded to the GPU, both allows switching in the profiler.", cxxopts::value<std::string>()->default_value("full"))
+		("simulate-turns", "Step a number of game turns without rendering, audio or input, then log the time taken by each system and quit.", cxxopts::value<uint32_t>())
+		("simulate-speed", "Multiple of the normal game speed at which --simulate-turns steps turns, as fast as possible if 0.", cxxopts::value<float>()->default_value("0"))
+		("seed", "Seed of the random number generator used by --simulate-turns.", cxxopts::value<uint32_t>()->default_value("0"))
 	;
 	// clang-format on
 
@@ -183,6 +194,58 @@ bool parseOptions(int argc, char** argv, openblack::Arguments& args, int& return
 			                                        result["screenshot-path"].as<std::filesystem::path>());
 		}
 
+		if (result.count("record-input") != 0 && result.count("replay-input") != 0)
+		{
+			std::cerr << "--record-input and --replay-input cannot be used together" << std::endl;
+			returnCode = EXIT_FAILURE;
+			return false;
+		}
+		if (result.count("record-input") != 0)
+		{
+			args.recordInput = result["record-input"].as<std::filesystem::path>();
+		}
+		if (result.count("replay-input") != 0)
+		{
+			args.replayInput = result["replay-input"].as<std::filesystem::path>();
+		}
+		if (result.count("profile-scripts") != 0)
+		{
+			args.profileScripts = result["profile-scripts"].as<std::filesystem::path>();
+		}
+		if (result.count("memory-report") != 0)
+		{
+			args.memoryReport = result["memory-report"].as<std::filesystem::path>();
+		}
+		if (result.count("mesh-cache") != 0)
+		{
+			args.meshCache = result["mesh-cache"].as<std::filesystem::path>();
+		}
+		if (result.count("simulate-turns") != 0)
+		{
+			if (!args.replayInput.empty() || !args.recordInput.empty())
+			{
+				std::cerr << "--simulate-turns cannot be used with --record-input or --replay-input" << std::endl;
+				returnCode = EXIT_FAILURE;
+				return false;
+			}
+			args.simulateTurns = result["simulate-turns"].as<uint32_t>();
+			args.simulateSpeed = result["simulate-speed"].as<float>();
+			args.seed = result["seed"].as<uint32_t>();
+			// Nothing is drawn, the renderer only exists for the resources
+			rendererType = bgfx::RendererType::Noop;
+		}
+		static const std::map<std::string_view, std::pair<bool, bool>> meshVerticesLookup = {
+		    std::pair {"full", std::pair {true, false}},
+		    std::pair {"compact", std::pair {false, true}},
+		    std::pair {"both", std::pair {true, true}},
+		};
+		const auto meshVerticesIter = meshVerticesLookup.find(result["mesh-vertices"].as<std::string>());
+		if (meshVerticesIter == meshVerticesLookup.cend())
+		{
+			throw cxxopts::exceptions::no_such_option(result["mesh-vertices"].as<std::string>());
+		}
+		std::tie(args.fullMeshVertices, args.compactMeshVertices) = meshVerticesIter->second;
+
 		args.windowWidth = result["width"].as<uint16_t>();
 		args.windowHeight = result["height"].as<uint16_t>();
 		args.guiScale = result["ui-scale"].as<float>();
@@ -192,6 +255,7 @@ bool parseOptions(int argc, char** argv, openblack::Arguments& args, int& return
 		args.numFramesToSimulate = result["num-frames-to-simulate"].as<uint32_t>();
 		args.logFile = result["log-file"].as<std::string>();
 		args.logLevels = logLevels;
+		args.logAsync = result["log-async"].as<bool>();
 		args.startLevel = result["start-level"].as<std::string>();
 	}
 	catch (cxxopts::exceptions::parsing& err)
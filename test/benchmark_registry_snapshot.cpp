@@ -0,0 +1,95 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include <ECS/Archetypes/VillagerArchetype.h>
+#include <ECS/Components/Transform.h>
+#include <ECS/Components/Villager.h>
+#include <ECS/Registry.h>
+#include <Game.h>
+#include <Locator.h>
+#include <bgfx/bgfx.h>
+#include <gtest/gtest.h>
+
+using namespace openblack;
+using namespace openblack::ecs::components;
+
+namespace
+{
+/// Villagers added to the mock level so that the snapshot is closer to the size of a real one
+constexpr uint32_t k_VillagerCount = 5000;
+constexpr uint32_t k_Iterations = 20;
+} // namespace
+
+class RegistrySnapshotBenchmark: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		static const auto mockGamePath = std::filesystem::path(TEST_BINARY_DIR) / "mock";
+		auto args = openblack::Arguments {
+		    .rendererType = bgfx::RendererType::Enum::Noop,
+		    .gamePath = mockGamePath.string(),
+		    .numFramesToSimulate = 0,
+		    .logFile = "stdout",
+		    .startLevel = "Land1.txt",
+		};
+		std::fill_n(args.logLevels.begin(), args.logLevels.size(), spdlog::level::warn);
+		_game = std::make_unique<openblack::Game>(std::move(args));
+		ASSERT_TRUE(_game->Initialize());
+
+		auto& registry = Locator::entitiesRegistry::value();
+		const auto origin = registry.Get<const Transform>(registry.Front<const Villager, const Transform>()).position;
+		for (uint32_t i = 0; i < k_VillagerCount; ++i)
+		{
+			const auto position = origin + glm::vec3(static_cast<float>(i % 100), 0.0f, static_cast<float>(i / 100));
+			ecs::archetypes::VillagerArchetype::Create(origin, position, VillagerInfo::CelticHousewifeFemale, 20);
+		}
+	}
+
+	void TearDown() override { _game.reset(); }
+
+	std::unique_ptr<openblack::Game> _game;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(RegistrySnapshotBenchmark, saveAndLoad)
+{
+	using Clock = std::chrono::steady_clock;
+	auto& registry = Locator::entitiesRegistry::value();
+	const auto entityCount = registry.Size<Transform>();
+
+	std::vector<uint8_t> snapshot;
+	Clock::duration saveTime {};
+	Clock::duration loadTime {};
+	for (uint32_t i = 0; i < k_Iterations; ++i)
+	{
+		const auto start = Clock::now();
+		snapshot = registry.SaveSnapshot();
+		const auto saved = Clock::now();
+		ASSERT_TRUE(registry.LoadSnapshot(snapshot));
+		const auto loaded = Clock::now();
+		saveTime += saved - start;
+		loadTime += loaded - saved;
+	}
+	ASSERT_EQ(registry.Size<Transform>(), entityCount);
+
+	const auto toMicroseconds = [](Clock::duration duration) {
+		return std::chrono::duration_cast<std::chrono::microseconds>(duration).count() / k_Iterations;
+	};
+	RecordProperty("entities", static_cast<int>(entityCount));
+	RecordProperty("bytes", static_cast<int>(snapshot.size()));
+	RecordProperty("save_us", static_cast<int>(toMicroseconds(saveTime)));
+	RecordProperty("load_us", static_cast<int>(toMicroseconds(loadTime)));
+}
@@ -0,0 +1,123 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+
+#include <ECS/Archetypes/AbodeArchetype.h>
+#include <ECS/Archetypes/TownArchetype.h>
+#include <ECS/Archetypes/VillagerArchetype.h>
+#include <ECS/Components/Villager.h>
+#include <ECS/Registry.h>
+#include <ECS/Systems/TownSystemInterface.h>
+#include <Game.h>
+#include <InfoConstants.h>
+#include <InfoConstantsIndex.h>
+#include <Locator.h>
+#include <gtest/gtest.h>
+
+using namespace openblack;
+using namespace openblack::ecs::archetypes;
+using namespace openblack::ecs::components;
+
+namespace
+{
+/// Towns on a grid, each with enough abodes for its share of the villagers of a large map
+constexpr uint32_t k_TownsPerSide = 8;
+constexpr uint32_t k_AbodesPerTown = 25;
+constexpr uint32_t k_VillagersPerAbode = 2;
+constexpr uint32_t k_VillagerCount = 2000;
+constexpr uint32_t k_ClosestTownQueries = 100000;
+constexpr float k_TownSpacing = 500.0f;
+} // namespace
+
+class TownSystemBenchmark: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		static const auto mockGamePath = std::filesystem::path(TEST_BINARY_DIR) / "mock";
+		auto args = Arguments {
+		    .rendererType = bgfx::RendererType::Enum::Noop,
+		    .gamePath = mockGamePath.string(),
+		    .numFramesToSimulate = 0,
+		    .logFile = "stdout",
+		};
+		std::fill_n(args.logLevels.begin(), args.logLevels.size(), spdlog::level::warn);
+		_game = std::make_unique<Game>(std::move(args));
+		ASSERT_TRUE(_game->Initialize());
+
+		// The mock abodes have no room for villagers
+		auto infoConstants = std::make_unique<InfoConstants>(Locator::infoConstants::value());
+		infoConstants->abode.at(static_cast<size_t>(AbodeInfo::CelticHut)).maxVillagersInAbode = k_VillagersPerAbode;
+		Locator::infoConstants::reset(infoConstants.release());
+		Locator::infoConstantsIndex::emplace<InfoConstantsIndex>(Locator::infoConstants::value());
+
+		for (uint32_t i = 0; i < k_TownsPerSide * k_TownsPerSide; ++i)
+		{
+			const auto position = TownPosition(i);
+			TownArchetype::Create(static_cast<int>(i), position, PlayerNames::PLAYER_ONE, Tribe::CELTIC);
+			for (uint32_t j = 0; j < k_AbodesPerTown; ++j)
+			{
+				const auto offset = glm::vec3(static_cast<float>(j % 5) * 20.0f, 0.0f, static_cast<float>(j / 5) * 20.0f);
+				AbodeArchetype::Create(i, position + offset, AbodeInfo::CelticHut, 0.0f, 1.0f, 0, 0);
+			}
+		}
+	}
+	void TearDown() override { _game.reset(); }
+
+	static glm::vec3 TownPosition(uint32_t index)
+	{
+		return {static_cast<float>(index % k_TownsPerSide + 1) * k_TownSpacing, 0.0f,
+		        static_cast<float>(index / k_TownsPerSide + 1) * k_TownSpacing};
+	}
+
+	std::unique_ptr<Game> _game;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TownSystemBenchmark, createVillagersAndFindTowns)
+{
+	using Clock = std::chrono::steady_clock;
+	auto& registry = Locator::entitiesRegistry::value();
+	auto& townSystem = Locator::townSystem::value();
+
+	const auto createStart = Clock::now();
+	for (uint32_t i = 0; i < k_VillagerCount; ++i)
+	{
+		const auto position = TownPosition(i % (k_TownsPerSide * k_TownsPerSide));
+		VillagerArchetype::Create(position, position, VillagerInfo::CelticHousewifeFemale, 20);
+	}
+	const auto createTime = Clock::now() - createStart;
+
+	uint32_t housed = 0;
+	registry.Each<const Villager>([&housed](const Villager& villager) { housed += villager.abode != entt::null ? 1 : 0; });
+	ASSERT_EQ(housed, std::min(k_VillagerCount, k_TownsPerSide * k_TownsPerSide * k_AbodesPerTown * k_VillagersPerAbode));
+
+	const auto extent = static_cast<float>(k_TownsPerSide + 1) * k_TownSpacing;
+	uint32_t found = 0;
+	const auto queryStart = Clock::now();
+	for (uint32_t i = 0; i < k_ClosestTownQueries; ++i)
+	{
+		const auto t = static_cast<float>(i) / static_cast<float>(k_ClosestTownQueries);
+		const glm::vec3 point(t * extent, 0.0f, (1.0f - t) * extent);
+		found += townSystem.FindClosestTown(point) != entt::null ? 1 : 0;
+	}
+	const auto queryTime = Clock::now() - queryStart;
+	ASSERT_EQ(found, k_ClosestTownQueries);
+
+	RecordProperty("villagers", static_cast<int>(k_VillagerCount));
+	RecordProperty("create_villagers_us",
+	               static_cast<int>(std::chrono::duration_cast<std::chrono::microseconds>(createTime).count()));
+	RecordProperty("closest_town_ns",
+	               static_cast<int>(std::chrono::duration_cast<std::chrono::nanoseconds>(queryTime).count() /
+	                                k_ClosestTownQueries));
+}
@@ -101,7 +101,7 @@ class MockAction: public openblack::input::GameActionInterface
 	[[nodiscard]] glm::uvec2 GetMousePosition() const override { return k_MockMousePos; }
 	[[nodiscard]] glm::ivec2 GetMouseDelta() const override { return {}; }
 	[[nodiscard]] std::array<std::optional<glm::vec3>, 2> GetHandPositions() const override { return {}; }
-	void Frame() final {}
+	void Frame(bool /*unused*/) final {}
 	void ProcessEvent(const SDL_Event& event) final {}
 
 	uint32_t frameNumber = 0;
@@ -137,6 +137,7 @@ class MockDynamicsSystem: public openblack::ecs::systems::DynamicsSystemInterfac
 		}
 		return {{{{hit->x, terrain.GetHeightAt(*hit), hit->y}}, {}}};
 	}
+	void DebugDraw([[maybe_unused]] const DebugLineCallback& drawLine) const override {}
 
 	[[nodiscard]] std::optional<glm::u16vec2> GetWindowCoordinates(const glm::vec3& position) const
 	{
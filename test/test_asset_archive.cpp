@@ -0,0 +1,174 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <AssetArchive.h>
+#include <gtest/gtest.h>
+
+#include "Common/Zip.h"
+
+// Enable this define because we use the implementation directly
+#define LOCATOR_IMPLEMENTATIONS
+#include <FileSystem/ArchiveFileSystem.h>
+
+using openblack::filesystem::ArchiveFileSystem;
+using openblack::filesystem::Stream;
+using namespace openblack::pack;
+
+namespace
+{
+std::vector<uint8_t> Bytes(const std::string& string)
+{
+	return {string.begin(), string.end()};
+}
+} // namespace
+
+class AssetArchiveFileSystem: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		_root = std::filesystem::temp_directory_path() / "openblack_test_asset_archive";
+		std::filesystem::remove_all(_root);
+		std::filesystem::create_directories(_root / "loose" / "Scripts");
+		std::ofstream(_root / "loose" / "Scripts" / "Loose.txt") << "loose";
+
+		_script = std::string(5000, 'x') + "end";
+
+		AssetArchiveWriter writer;
+		ASSERT_EQ(writer.Open(_root / "game.obar"), AssetArchiveResult::Success);
+		ASSERT_EQ(writer.Add("Scripts/Land1.txt", Bytes(_script), AssetCompression::None, _script.size()),
+		          AssetArchiveResult::Success);
+		ASSERT_EQ(writer.Add("Data/Landscape/Land1.lnd", Bytes("land"), AssetCompression::None, 4),
+		          AssetArchiveResult::Success);
+		ASSERT_EQ(writer.Add("Data/Symbols/Hand.raw", openblack::zip::Deflate(Bytes(_script)), AssetCompression::Zlib,
+		                     _script.size()),
+		          AssetArchiveResult::Success);
+		ASSERT_EQ(writer.Add("Data/info.dat", Bytes("info"), AssetCompression::None, 4), AssetArchiveResult::Success);
+		ASSERT_EQ(writer.Finish(), AssetArchiveResult::Success);
+	}
+
+	void TearDown() override { std::filesystem::remove_all(_root); }
+
+	std::filesystem::path _root;
+	std::string _script;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(AssetArchiveFileSystem, entriesAreSortedAndAligned)
+{
+	ArchiveFileSystem fileSystem(_root / "game.obar");
+	const auto data = fileSystem.ReadAll(_root / "game.obar" / "Data" / "info.dat");
+	ASSERT_EQ(data, Bytes("info"));
+
+	std::ifstream file(_root / "game.obar", std::ios::binary);
+	const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	AssetArchive archive;
+	ASSERT_EQ(archive.Open(bytes), AssetArchiveResult::Success);
+
+	std::vector<std::string_view> names;
+	for (const auto& entry : archive.GetEntries())
+	{
+		names.push_back(archive.GetName(entry));
+		if (entry.compression == AssetCompression::None)
+		{
+			ASSERT_EQ(entry.offset % k_AssetArchiveAlignment, 0);
+		}
+	}
+	const std::vector<std::string_view> expected = {"Data/info.dat", "Data/Landscape/Land1.lnd", "Data/Symbols/Hand.raw",
+	                                                "Scripts/Land1.txt"};
+	ASSERT_EQ(names, expected);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(AssetArchiveFileSystem, lookupsIgnoreCaseAndSeparators)
+{
+	ArchiveFileSystem fileSystem(_root / "game.obar");
+	ASSERT_EQ(fileSystem.FindPath("data\\LANDSCAPE\\land1.LND"), "Data/Landscape/Land1.lnd");
+	ASSERT_EQ(fileSystem.FindPath("scripts/"), "Scripts");
+	ASSERT_TRUE(fileSystem.Exists("Scripts/../Data/Landscape/Land1.lnd"));
+	ASSERT_TRUE(fileSystem.Exists(fileSystem.GetPath<openblack::filesystem::Path::Landscape>(true) / "Land1.lnd"));
+	ASSERT_FALSE(fileSystem.Exists("Scripts/Missing.txt"));
+	ASSERT_FALSE(fileSystem.Exists(""));
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(AssetArchiveFileSystem, readsStoredAndCompressedEntries)
+{
+	ArchiveFileSystem fileSystem(_root / "game.obar");
+	ASSERT_EQ(fileSystem.ReadAll("Scripts/Land1.txt"), Bytes(_script));
+	ASSERT_EQ(fileSystem.ReadAll("Data/Symbols/Hand.raw"), Bytes(_script));
+
+	auto stream = fileSystem.GetData("Scripts/Land1.txt");
+	stream->seekg(-3, std::ios::end);
+	std::string end;
+	*stream >> end;
+	ASSERT_EQ(end, "end");
+
+	auto compressed = fileSystem.Open("Data/Symbols/Hand.raw", Stream::Mode::Read);
+	ASSERT_EQ(compressed->Size(), _script.size());
+	auto stored = fileSystem.Open("Scripts/Land1.txt", Stream::Mode::Read);
+	ASSERT_EQ(stored->GetLine(), _script);
+	ASSERT_TRUE(stored->IsEndOfFile());
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(AssetArchiveFileSystem, iteratesDirectoriesAndFallsBackToLooseFiles)
+{
+	ArchiveFileSystem fileSystem(_root / "game.obar");
+	std::vector<std::filesystem::path> paths;
+	fileSystem.Iterate("Data", false, [&paths](const std::filesystem::path& path) { paths.push_back(path); });
+	const std::vector<std::filesystem::path> expected = {"Data/info.dat", "Data/Landscape", "Data/Symbols"};
+	ASSERT_EQ(paths, expected);
+
+	paths.clear();
+	fileSystem.Iterate("data", true, [&paths](const std::filesystem::path& path) { paths.push_back(path); });
+	ASSERT_EQ(paths.size(), 3);
+
+	fileSystem.AddAdditionalPath(_root / "loose");
+	ASSERT_EQ(fileSystem.ReadAll("Scripts/Loose.txt"), Bytes("loose"));
+	ASSERT_EQ(fileSystem.FindPath("Scripts/Loose.txt"), _root / "loose" / "Scripts" / "Loose.txt");
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(AssetArchiveFileSystem, rejectsOtherFiles)
+{
+	std::ofstream(_root / "bad.obar", std::ios::binary) << std::string(64, 'x');
+	ASSERT_THROW(ArchiveFileSystem fileSystem(_root / "bad.obar"), std::runtime_error);
+
+	AssetArchive archive;
+	const std::vector<uint8_t> tooSmall(8);
+	ASSERT_EQ(archive.Open(tooSmall), AssetArchiveResult::ErrFileTooSmall);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(AssetArchiveFileSystem, failedWritesLeaveNoArchive)
+{
+	{
+		AssetArchiveWriter writer;
+		ASSERT_EQ(writer.Open(_root / "duplicate.obar"), AssetArchiveResult::Success);
+		ASSERT_EQ(writer.Add("Data/info.dat", Bytes("info"), AssetCompression::None, 4), AssetArchiveResult::Success);
+		ASSERT_EQ(writer.Add("DATA/Info.dat", Bytes("info"), AssetCompression::None, 4), AssetArchiveResult::Success);
+		ASSERT_EQ(writer.Finish(), AssetArchiveResult::ErrDuplicateEntry);
+		ASSERT_FALSE(std::filesystem::exists(_root / "duplicate.obar"));
+		ASSERT_EQ(writer.Finish(), AssetArchiveResult::ErrWriteFailed);
+	}
+
+	{
+		AssetArchiveWriter writer;
+		ASSERT_EQ(writer.Open(_root / "unfinished.obar"), AssetArchiveResult::Success);
+		ASSERT_EQ(writer.Add("Data/info.dat", Bytes("info"), AssetCompression::None, 4), AssetArchiveResult::Success);
+	}
+	ASSERT_FALSE(std::filesystem::exists(_root / "unfinished.obar"));
+}
@@ -0,0 +1,105 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <filesystem>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+// Enable this define because we use the implementation directly
+#define LOCATOR_IMPLEMENTATIONS
+#include <FileSystem/DefaultFileSystem.h>
+
+using openblack::filesystem::DefaultFileSystem;
+
+class DefaultFileSystemIndex: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		_root = std::filesystem::temp_directory_path() / "openblack_test_filesystem";
+		std::filesystem::remove_all(_root);
+		CreateFile(_root / "game" / "Data" / "Landscape" / "Land1.lnd");
+		CreateFile(_root / "game" / "Scripts" / "Land1.txt");
+		CreateFile(_root / "mod" / "Scripts" / "Land1.txt");
+		CreateFile(_root / "mod" / "Scripts" / "Extra.txt");
+
+		_fileSystem.SetGamePath(_root / "game");
+		_fileSystem.AddAdditionalPath(_root / "mod");
+	}
+
+	void TearDown() override { std::filesystem::remove_all(_root); }
+
+	static void CreateFile(const std::filesystem::path& path)
+	{
+		std::filesystem::create_directories(path.parent_path());
+		std::ofstream(path) << path.generic_string();
+	}
+
+	std::filesystem::path _root;
+	DefaultFileSystem _fileSystem;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(DefaultFileSystemIndex, lookupsIgnoreCaseAndSeparators)
+{
+	const auto expected = _root / "game" / "Data" / "Landscape" / "Land1.lnd";
+	ASSERT_EQ(_fileSystem.FindPath("Data/Landscape/Land1.lnd"), expected);
+	ASSERT_EQ(_fileSystem.FindPath("data/LANDSCAPE/land1.LND"), expected);
+	ASSERT_EQ(_fileSystem.FindPath("Data\\Landscape\\Land1.lnd"), expected);
+	ASSERT_EQ(_fileSystem.FindPath("Scripts/../Data/Landscape/Land1.lnd"), expected);
+	ASSERT_TRUE(_fileSystem.Exists("Data/Landscape"));
+	ASSERT_TRUE(_fileSystem.Exists(expected));
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(DefaultFileSystemIndex, gamePathShadowsAdditionalPaths)
+{
+	ASSERT_EQ(_fileSystem.FindPath("Scripts/Land1.txt"), _root / "game" / "Scripts" / "Land1.txt");
+	ASSERT_EQ(_fileSystem.FindPath("Scripts/Extra.txt"), _root / "mod" / "Scripts" / "Extra.txt");
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(DefaultFileSystemIndex, missingFilesDoNotThrowOnExists)
+{
+	ASSERT_NO_THROW(ASSERT_FALSE(_fileSystem.Exists("Scripts/Missing.txt")));
+	ASSERT_FALSE(_fileSystem.Exists(""));
+	ASSERT_THROW([[maybe_unused]] auto path = _fileSystem.FindPath("Scripts/Missing.txt"), std::runtime_error);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(DefaultFileSystemIndex, missedLookupsFindNewFiles)
+{
+	ASSERT_FALSE(_fileSystem.Exists("Scripts/New.txt"));
+	CreateFile(_root / "mod" / "Scripts" / "New.txt");
+	ASSERT_EQ(_fileSystem.FindPath("Scripts/New.txt"), _root / "mod" / "Scripts" / "New.txt");
+	// Once found it is in the index, looked up with any case
+	ASSERT_TRUE(_fileSystem.Exists("scripts/NEW.txt"));
+
+	CreateFile(_root / "game" / "Scripts" / "Other.txt");
+	ASSERT_FALSE(_fileSystem.Exists("scripts/other.TXT"));
+	_fileSystem.InvalidateIndex();
+	ASSERT_TRUE(_fileSystem.Exists("scripts/other.TXT"));
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(DefaultFileSystemIndex, symlinkCyclesAreIndexedOnce)
+{
+	std::error_code ec;
+	std::filesystem::create_directory_symlink(_root / "game", _root / "game" / "Data" / "Loop", ec);
+	std::filesystem::create_directory_symlink(_root / "mod" / "Scripts", _root / "mod" / "Scripts" / "Self", ec);
+	if (ec)
+	{
+		GTEST_SKIP() << "Symbolic links cannot be created: " << ec.message();
+	}
+
+	ASSERT_EQ(_fileSystem.FindPath("Data/Landscape/Land1.lnd"), _root / "game" / "Data" / "Landscape" / "Land1.lnd");
+	ASSERT_TRUE(_fileSystem.Exists("Data/Loop"));
+	ASSERT_TRUE(_fileSystem.Exists("Scripts/Self"));
+}
@@ -7,7 +7,22 @@
  * openblack is licensed under the GNU General Public License version 3.
  *******************************************************************************/
 
+#include <cstdint>
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <BulletCollision/CollisionShapes/btSphereShape.h>
+#include <BulletDynamics/Dynamics/btRigidBody.h>
+#include <Common/MemoryTracker.h>
+#include <ECS/Systems/DynamicsSystemInterface.h>
 #include <Game.h>
+#include <Locator.h>
+#include <Profiler.h>
 #include <gtest/gtest.h>
 
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
@@ -44,3 +59,89 @@ TEST(GameInitialize, run0Frames)
 	ASSERT_TRUE(game->Run());
 	game.reset();
 }
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(GameInitialize, simulateTurns)
+{
+	static const auto mockGamePath = std::filesystem::path(TEST_BINARY_DIR) / "mock";
+	auto args = openblack::Arguments {
+	    .rendererType = bgfx::RendererType::Enum::Noop,
+	    .gamePath = mockGamePath.string(),
+	    .numFramesToSimulate = 0,
+	    .logFile = "stdout",
+	    .startLevel = "Land1.txt",
+	    .memoryReport = std::filesystem::temp_directory_path() / "openblack_test_memory_report.csv",
+	    .simulateTurns = 20,
+	    .seed = 7,
+	};
+	const auto memoryReport = args.memoryReport;
+	std::filesystem::remove(memoryReport);
+	std::fill_n(args.logLevels.begin(), args.logLevels.size(), spdlog::level::debug);
+	auto game = std::make_unique<openblack::Game>(std::move(args));
+	ASSERT_TRUE(game->Initialize());
+
+	// A body falling freely far above the island, each turn must step physics by a whole turn
+	btSphereShape shape(1.0f);
+	btVector3 inertia(0.0f, 0.0f, 0.0f);
+	shape.calculateLocalInertia(1.0f, inertia);
+	btRigidBody::btRigidBodyConstructionInfo info(1.0f, nullptr, &shape, inertia);
+	info.m_startWorldTransform.setOrigin(btVector3(0.0f, 10000.0f, 0.0f));
+	btRigidBody body(info);
+	auto& dynamicsSystem = openblack::Locator::dynamicsSystem::value();
+	dynamicsSystem.AddRigidBody(&body);
+
+	ASSERT_TRUE(game->Run());
+	ASSERT_EQ(game->GetTurn(), 20);
+	// 20 turns of 100 ms are 2 s of falling at 10 m/s², or 20 m
+	ASSERT_NEAR(10000.0f - body.getCenterOfMassPosition().y(), 20.0f, 0.5f);
+	dynamicsSystem.Reset();
+	const auto& profiler = openblack::Locator::profiler::value();
+	ASSERT_EQ(profiler.GetCount(openblack::Profiler::Stage::ScriptUpdate), 20);
+	ASSERT_EQ(profiler.GetCount(openblack::Profiler::Stage::PhysicsUpdate), 20);
+	ASSERT_EQ(profiler.GetCount(openblack::Profiler::Stage::SceneDraw), 0);
+	game.reset();
+
+	// The report lists the resource caches, and in tracking builds the allocations of every tag
+	std::ifstream report(memoryReport);
+	ASSERT_TRUE(report.is_open());
+	std::string line;
+	ASSERT_TRUE(std::getline(report, line));
+	ASSERT_EQ(line, "category,name,count,bytes,gpu_bytes");
+	std::map<std::string, std::vector<std::string>> namesByCategory;
+	uint64_t liveBytes = 0;
+	while (std::getline(report, line))
+	{
+		std::istringstream row(line);
+		std::vector<std::string> fields;
+		for (std::string field; std::getline(row, field, ',');)
+		{
+			fields.push_back(field);
+		}
+		ASSERT_EQ(fields.size(), 5) << line;
+		ASSERT_NO_THROW((void)std::stoull(fields[2])) << line;
+		ASSERT_NO_THROW((void)std::stoull(fields[3])) << line;
+		ASSERT_NO_THROW((void)std::stoull(fields[4])) << line;
+		if (fields[0] == "live")
+		{
+			liveBytes += std::stoull(fields[3]);
+		}
+		namesByCategory[fields[0]].push_back(fields[1]);
+	}
+	report.close();
+	std::filesystem::remove(memoryReport);
+
+	ASSERT_FALSE(namesByCategory["resources"].empty());
+	ASSERT_EQ(namesByCategory["resources"].front(), "Meshes");
+	if constexpr (openblack::MemoryTracker::k_Enabled)
+	{
+		const std::vector<std::string> tags(openblack::k_MemoryTagNames.begin(), openblack::k_MemoryTagNames.end());
+		ASSERT_EQ(namesByCategory["allocations"], tags);
+		ASSERT_EQ(namesByCategory["live"], tags);
+		ASSERT_GT(liveBytes, 0);
+	}
+	else
+	{
+		ASSERT_FALSE(namesByCategory.contains("allocations"));
+		ASSERT_FALSE(namesByCategory.contains("live"));
+	}
+}
@@ -0,0 +1,143 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <chrono>
+#include <vector>
+
+#include <Serializer/GameThingSerializer.h>
+#include <gtest/gtest.h>
+
+using namespace openblack::serializer;
+
+namespace
+{
+struct FotThings
+{
+	GameThings things;
+	std::vector<GameThingId> footpathLinkSaves;
+	std::vector<GameThingId> footpaths;
+};
+
+/// Footpaths as in a .fot file, where links hold the footpaths which the list of footpaths then refers back to
+FotThings MakeFotThings(uint32_t footpathCount, uint32_t nodesPerFootpath)
+{
+	FotThings fot;
+	for (uint32_t i = 0; i < footpathCount; ++i)
+	{
+		Footpath footpath {{i, 1}, {}, 0};
+		for (uint32_t j = 0; j < nodesPerFootpath; ++j)
+		{
+			const MapCoords coords {i * 0x1000, j * 0x1000, static_cast<float>(j)};
+			footpath.nodes.push_back(fot.things.Add(FootpathNode {{j, 2}, coords, 3}));
+		}
+		fot.footpaths.push_back(fot.things.Add(std::move(footpath)));
+	}
+	for (uint32_t i = 0; i + 1 < footpathCount; i += 2)
+	{
+		const auto link = fot.things.Add(FootpathLink {{i, 4}, {fot.footpaths[i], fot.footpaths[i + 1]}});
+		fot.footpathLinkSaves.push_back(fot.things.Add(FootpathLinkSave {{i, 5}, {i, i, 0.0f}, link}));
+	}
+	fot.footpathLinkSaves.push_back(k_NoGameThing);
+	return fot;
+}
+
+std::vector<uint8_t> Write(const FotThings& fot)
+{
+	GameThingWriter writer(fot.things);
+	writer.WriteList(fot.footpathLinkSaves);
+	writer.WriteList(fot.footpaths);
+	return writer.GetData();
+}
+} // namespace
+
+TEST(TestGameThingSerializer, RoundTrip)
+{
+	const auto fot = MakeFotThings(4, 3);
+	const auto data = Write(fot);
+
+	GameThingReader reader(data);
+	const auto footpathLinkSaves = reader.ReadList(FootpathLinkSave::k_Type);
+	const auto footpaths = reader.ReadList(Footpath::k_Type);
+	ASSERT_EQ(reader.Position(), data.size());
+
+	const auto& things = reader.GetThings();
+	ASSERT_EQ(things.Size(), fot.things.Size());
+	ASSERT_EQ(footpathLinkSaves.size(), 3);
+	ASSERT_EQ(footpathLinkSaves.back(), k_NoGameThing);
+	ASSERT_EQ(footpaths.size(), 4);
+	ASSERT_EQ(things.GetAll<FootpathNode>().size(), 12);
+
+	// The links are written first, the footpaths they hold keep their id when listed again
+	const auto* save = things.Find<FootpathLinkSave>(footpathLinkSaves[1]);
+	ASSERT_NE(save, nullptr);
+	const auto* link = things.Find<FootpathLink>(save->link);
+	ASSERT_NE(link, nullptr);
+	ASSERT_EQ(link->footpaths, (std::vector<GameThingId> {footpaths[2], footpaths[3]}));
+	ASSERT_EQ(things.Get<Footpath>(footpaths[3]).unknown1, 3);
+	ASSERT_EQ(things.Find<Footpath>(save->link), nullptr);
+
+	const auto* node = things.Find<FootpathNode>(things.Get<Footpath>(footpaths[3]).nodes[2]);
+	ASSERT_NE(node, nullptr);
+	ASSERT_EQ(*node, fot.things.Get<FootpathNode>(fot.things.Get<Footpath>(fot.footpaths[3]).nodes[2]));
+
+	// Writing what was read gives the same file
+	GameThingWriter writer(things);
+	writer.WriteList(footpathLinkSaves);
+	writer.WriteList(footpaths);
+	ASSERT_EQ(writer.GetData(), data);
+}
+
+TEST(TestGameThingSerializer, RejectsCorruptData)
+{
+	const auto fot = MakeFotThings(2, 2);
+	auto data = Write(fot);
+
+	data.resize(data.size() - 1);
+	GameThingReader truncated(data);
+	truncated.ReadList(FootpathLinkSave::k_Type);
+	ASSERT_THROW(truncated.ReadList(Footpath::k_Type), std::runtime_error);
+
+	GameThingReader wrongType(data);
+	ASSERT_THROW(wrongType.ReadList(Footpath::k_Type), std::runtime_error);
+}
+
+TEST(TestGameThingSerializer, LoadLargeFootpathFile)
+{
+	const auto fot = MakeFotThings(4000, 64);
+	const auto data = Write(fot);
+
+	const auto start = std::chrono::steady_clock::now();
+	GameThingReader reader(data);
+	const auto footpathLinkSaves = reader.ReadList(FootpathLinkSave::k_Type);
+	const auto footpaths = reader.ReadList(Footpath::k_Type);
+	// Resolve every link to its footpaths as FotFile does
+	const auto& things = reader.GetThings();
+	std::vector<uint32_t> footpathIndices(things.Size() + 1);
+	for (uint32_t i = 0; const auto id : footpaths)
+	{
+		footpathIndices[id] = i++;
+	}
+	uint64_t resolved = 0;
+	for (const auto id : footpathLinkSaves)
+	{
+		if (const auto* save = things.Find<FootpathLinkSave>(id))
+		{
+			for (const auto footpath : things.Get<FootpathLink>(save->link).footpaths)
+			{
+				resolved += footpathIndices[footpath];
+			}
+		}
+	}
+	const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+	ASSERT_EQ(things.GetAll<FootpathNode>().size(), 4000 * 64);
+	ASSERT_EQ(resolved, 3999 * 4000 / 2);
+	RecordProperty("bytes", static_cast<int>(data.size()));
+	RecordProperty("microseconds", static_cast<int>(elapsed.count()));
+}
@@ -0,0 +1,115 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <cstring>
+
+#include <memory>
+
+#include <3D/AllMeshes.h>
+#include <InfoConstants.h>
+#include <InfoConstantsIndex.h>
+#include <Resources/ResourceManager.h>
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+using namespace openblack;
+
+namespace
+{
+std::unique_ptr<InfoConstants> MakeInfoConstants()
+{
+	auto info = std::make_unique<InfoConstants>();
+	for (auto& abode : info->abode)
+	{
+		abode.tribeType = Tribe::NONE;
+		abode.abodeNumber = AbodeNumber::Invalid;
+	}
+	for (auto& villager : info->villager)
+	{
+		villager.tribeType = Tribe::NONE;
+	}
+	return info;
+}
+
+template <size_t N>
+void SetDebugString(std::array<char, N>& debugString, const char* name)
+{
+	std::strncpy(debugString.data(), name, debugString.size() - 1);
+}
+} // namespace
+
+TEST(TestInfoConstantsIndex, FindAbodeByName)
+{
+	auto info = MakeInfoConstants();
+	auto& hut = info->abode.at(static_cast<size_t>(AbodeInfo::CelticHut));
+	hut.tribeType = Tribe::CELTIC;
+	SetDebugString(hut.debugString, "HUT");
+	auto& totem = info->abode.at(static_cast<size_t>(AbodeInfo::CelticTotem));
+	totem.tribeType = Tribe::CELTIC;
+	SetDebugString(totem.debugString, "HUT"); // A duplicate name resolves to the first abode
+
+	const InfoConstantsIndex index(*info);
+	ASSERT_EQ(index.FindAbode("CELTIC_HUT"), AbodeInfo::CelticHut);
+	ASSERT_FALSE(index.FindAbode("NORSE_HUT").has_value());
+	ASSERT_FALSE(index.FindAbode("HUT").has_value());
+}
+
+TEST(TestInfoConstantsIndex, FindAbodeByNumber)
+{
+	auto info = MakeInfoConstants();
+	auto& shared = info->abode.at(static_cast<size_t>(AbodeInfo::CelticHut));
+	shared.abodeNumber = AbodeNumber::Field;
+	auto& norse = info->abode.at(static_cast<size_t>(AbodeInfo::NorseHut));
+	norse.tribeType = Tribe::NORSE;
+	norse.abodeNumber = AbodeNumber::Field;
+
+	// Abodes without a tribe are shared by all tribes, later abodes take precedence
+	const InfoConstantsIndex index(*info);
+	ASSERT_EQ(index.FindAbode(Tribe::CELTIC, AbodeNumber::Field), AbodeInfo::CelticHut);
+	ASSERT_EQ(index.FindAbode(Tribe::NONE, AbodeNumber::Field), AbodeInfo::CelticHut);
+	ASSERT_EQ(index.FindAbode(Tribe::NORSE, AbodeNumber::Field), AbodeInfo::NorseHut);
+	ASSERT_FALSE(index.FindAbode(Tribe::NORSE, AbodeNumber::Totem).has_value());
+	ASSERT_FALSE(index.FindAbode(Tribe::NORSE, AbodeNumber::Invalid).has_value());
+}
+
+TEST(TestInfoConstantsIndex, FindVillager)
+{
+	auto info = MakeInfoConstants();
+	auto& villager = info->villager.at(static_cast<size_t>(VillagerInfo::CelticHousewifeFemale));
+	villager.tribeType = Tribe::CELTIC;
+	villager.villagerNumber = VillagerNumber::Housewife;
+
+	const InfoConstantsIndex index(*info);
+	ASSERT_EQ(index.FindVillager(Tribe::CELTIC, VillagerNumber::Housewife), VillagerInfo::CelticHousewifeFemale);
+	ASSERT_FALSE(index.FindVillager(Tribe::CELTIC, VillagerNumber::Trader).has_value());
+	ASSERT_FALSE(index.FindVillager(Tribe::AZTEC, VillagerNumber::Housewife).has_value());
+}
+
+TEST(TestInfoConstantsIndex, FindFeatureAndAnimatedStatic)
+{
+	auto info = MakeInfoConstants();
+	SetDebugString(info->feature.at(static_cast<size_t>(FeatureInfo::AztcOlmechead)).debugString, "AZTEC_OLMEC_HEAD");
+	SetDebugString(info->animatedStatic.at(static_cast<size_t>(AnimatedStaticInfo::NorseGate)).debugString,
+	               "NORSE_GATE");
+
+	const InfoConstantsIndex index(*info);
+	ASSERT_EQ(index.FindFeature("AZTEC_OLMEC_HEAD"), FeatureInfo::AztcOlmechead);
+	ASSERT_FALSE(index.FindFeature("NORSE_GATE").has_value());
+	ASSERT_EQ(index.FindAnimatedStatic("NORSE_GATE"), AnimatedStaticInfo::NorseGate);
+	ASSERT_FALSE(index.FindAnimatedStatic("AZTEC_OLMEC_HEAD").has_value());
+}
+
+TEST(TestInfoConstantsIndex, HashIdentifierOfIntegers)
+{
+	static_assert(resources::HashIdentifier(MeshId::Dummy) == entt::hashed_string("0").value());
+	for (const uint32_t id : {0u, 7u, 10u, 493u, 4294967295u})
+	{
+		ASSERT_EQ(resources::HashIdentifier(id), entt::hashed_string(fmt::format("{}", id).c_str()).value());
+	}
+}
@@ -0,0 +1,208 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/spdlog.h>
+
+// Enable this define because we use the implementations directly
+#define LOCATOR_IMPLEMENTATIONS
+#include <Input/GameActionRecording.h>
+
+using namespace openblack::input;
+
+namespace
+{
+constexpr uint32_t k_FrameCount = 300;
+
+/// Input which changes in a different way every frame
+class ScriptedAction final: public GameActionInterface
+{
+public:
+	[[nodiscard]] bool GetBindable(BindableActionMap action) const final
+	{
+		return (Bindable(frameNumber) & static_cast<uint64_t>(action)) != 0;
+	}
+	[[nodiscard]] bool GetUnbindable(UnbindableActionMap action) const final
+	{
+		return (Unbindable(frameNumber) & static_cast<uint8_t>(action)) != 0;
+	}
+	[[nodiscard]] bool GetBindableChanged(BindableActionMap action) const final
+	{
+		return ((Bindable(frameNumber) ^ Bindable(frameNumber - 1)) & static_cast<uint64_t>(action)) != 0;
+	}
+	[[nodiscard]] bool GetUnbindableChanged(UnbindableActionMap action) const final
+	{
+		return ((Unbindable(frameNumber) ^ Unbindable(frameNumber - 1)) & static_cast<uint8_t>(action)) != 0;
+	}
+	[[nodiscard]] bool GetBindableRepeat(BindableActionMap action) const final
+	{
+		return ((Bindable(frameNumber) & Bindable(frameNumber - 1)) & static_cast<uint64_t>(action)) != 0;
+	}
+	[[nodiscard]] bool GetUnbindableRepeat(UnbindableActionMap action) const final
+	{
+		return ((Unbindable(frameNumber) & Unbindable(frameNumber - 1)) & static_cast<uint8_t>(action)) != 0;
+	}
+	[[nodiscard]] glm::uvec2 GetMousePosition() const final { return {(frameNumber / 4) * 3, 600 - frameNumber / 2}; }
+	[[nodiscard]] glm::ivec2 GetMouseDelta() const final
+	{
+		return frameNumber % 7 == 0 ? glm::ivec2(-2, 5) : glm::ivec2(0, 0);
+	}
+	[[nodiscard]] std::array<std::optional<glm::vec3>, 2> GetHandPositions() const final
+	{
+		if (frameNumber % 50 < 10)
+		{
+			return {};
+		}
+		return {{glm::vec3(static_cast<float>(frameNumber / 10), 0.0f, 1.0f), glm::vec3(100.0f, 2.0f, 3.0f)}};
+	}
+
+	void Frame(bool hasFocus) final
+	{
+		if (hasFocus)
+		{
+			++frameNumber;
+		}
+	}
+	void ProcessEvent(const SDL_Event& /*unused*/) final {}
+
+	uint32_t frameNumber = 0;
+
+private:
+	static uint64_t Bindable(uint32_t frame)
+	{
+		return frame % 30 < 10 ? static_cast<uint64_t>(BindableActionMap::MOVE) | (uint64_t {1} << (frame % 33)) : 0;
+	}
+	static uint8_t Unbindable(uint32_t frame)
+	{
+		return frame % 40 == 0 ? static_cast<uint8_t>(UnbindableActionMap::DOUBLE_CLICK) : 0;
+	}
+};
+
+/// Everything the game can query from an input for one frame
+std::vector<bool> Query(const GameActionInterface& input)
+{
+	std::vector<bool> result;
+	for (uint64_t bit = 1; bit <= static_cast<uint64_t>(BindableActionMap::ALL); bit <<= 1)
+	{
+		const auto action = static_cast<BindableActionMap>(bit);
+		result.push_back(input.GetBindable(action));
+		result.push_back(input.GetBindableChanged(action));
+		result.push_back(input.GetBindableRepeat(action));
+	}
+	for (const auto action : {UnbindableActionMap::DOUBLE_CLICK, UnbindableActionMap::TWO_BUTTON_CLICK})
+	{
+		result.push_back(input.GetUnbindable(action));
+		result.push_back(input.GetUnbindableChanged(action));
+		result.push_back(input.GetUnbindableRepeat(action));
+	}
+	return result;
+}
+} // namespace
+
+class InputRecording: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		if (spdlog::get("input") == nullptr)
+		{
+			spdlog::stdout_color_mt("input")->set_level(spdlog::level::warn);
+		}
+		_path = std::filesystem::temp_directory_path() /
+		        (::testing::UnitTest::GetInstance()->current_test_info()->name() + std::string(".obir"));
+	}
+
+	void TearDown() override { std::filesystem::remove(_path); }
+
+	std::filesystem::path _path;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(InputRecording, replayMatchesRecordedInput)
+{
+	constexpr uint32_t k_Seed = 0xC0FFEE;
+	constexpr auto k_FrameDuration = std::chrono::microseconds(33333);
+	ScriptedAction reference;
+	{
+		GameActionRecorder recorder(std::make_unique<ScriptedAction>(), _path, k_Seed, k_FrameDuration);
+		// The state of the last frame is only written once the next one starts
+		for (uint32_t i = 0; i < k_FrameCount + 1; ++i)
+		{
+			recorder.Frame(true);
+		}
+	}
+	// Only changes are written, a recording must be well under the size of the raw frames
+	ASSERT_LT(std::filesystem::file_size(_path), sizeof(GameActionRecordingHeader) + k_FrameCount * sizeof(GameActionFrame) / 2);
+
+	GameActionReplay replay(_path);
+	ASSERT_EQ(replay.GetSeed(), k_Seed);
+	ASSERT_EQ(replay.GetFrameDuration(), k_FrameDuration);
+	for (uint32_t i = 0; i < k_FrameCount; ++i)
+	{
+		ASSERT_FALSE(replay.IsFinished());
+		reference.Frame(true);
+		replay.Frame(true);
+		ASSERT_EQ(Query(replay), Query(reference)) << "on frame " << i;
+		ASSERT_EQ(replay.GetMousePosition(), reference.GetMousePosition()) << "on frame " << i;
+		ASSERT_EQ(replay.GetMouseDelta(), reference.GetMouseDelta()) << "on frame " << i;
+		ASSERT_EQ(replay.GetHandPositions(), reference.GetHandPositions()) << "on frame " << i;
+	}
+	ASSERT_TRUE(replay.IsFinished());
+
+	// Input is released once the recording is over
+	replay.Frame(true);
+	ASSERT_FALSE(replay.Get(BindableActionMap::MOVE));
+	ASSERT_EQ(replay.GetMouseDelta(), glm::ivec2(0, 0));
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(InputRecording, framesWithoutFocusStayInStep)
+{
+	// Such as while the debug GUI has focus, the game keeps seeing the input of the frame before
+	const auto hasFocus = [](uint32_t frame) { return frame % 20 < 12; };
+	{
+		GameActionRecorder recorder(std::make_unique<ScriptedAction>(), _path, 0,
+		                            GameActionRecordingHeader::k_DefaultFrameDuration);
+		for (uint32_t i = 0; i < k_FrameCount + 1; ++i)
+		{
+			recorder.Frame(hasFocus(i));
+		}
+	}
+
+	// Focus on replay does not matter, every recorded frame is consumed
+	ScriptedAction reference;
+	GameActionReplay replay(_path);
+	for (uint32_t i = 0; i < k_FrameCount; ++i)
+	{
+		ASSERT_FALSE(replay.IsFinished());
+		reference.Frame(hasFocus(i));
+		replay.Frame(true);
+		ASSERT_EQ(Query(replay), Query(reference)) << "on frame " << i;
+		ASSERT_EQ(replay.GetMousePosition(), reference.GetMousePosition()) << "on frame " << i;
+		ASSERT_EQ(replay.GetMouseDelta(), reference.GetMouseDelta()) << "on frame " << i;
+		ASSERT_EQ(replay.GetHandPositions(), reference.GetHandPositions()) << "on frame " << i;
+	}
+	ASSERT_TRUE(replay.IsFinished());
+	ASSERT_LT(reference.frameNumber, k_FrameCount);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(InputRecording, rejectsOtherFiles)
+{
+	std::ofstream(_path, std::ios::binary) << "not a recording";
+	ASSERT_THROW(GameActionReplay replay(_path), std::runtime_error);
+	ASSERT_THROW(GameActionReplay replay(_path.parent_path() / "missing.obir"), std::runtime_error);
+}
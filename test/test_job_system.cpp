@@ -0,0 +1,243 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <Common/JobSystem.h>
+#include <Common/MemoryTracker.h>
+#include <entt/entity/registry.hpp>
+#include <gtest/gtest.h>
+
+using namespace openblack;
+
+TEST(TestJobSystem, Dependencies)
+{
+	JobSystem jobs(3);
+	std::vector<int> order;
+	std::mutex mutex;
+	const auto record = [&order, &mutex](int step) {
+		const std::lock_guard lock(mutex);
+		order.push_back(step);
+	};
+
+	const auto first = jobs.Schedule("first", [&record]() {
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		record(1);
+	});
+	const auto second = jobs.Schedule("second", [&record]() { record(2); });
+	const std::vector dependencies {first, second};
+	const auto last = jobs.Schedule("last", [&record]() { record(3); }, dependencies);
+	jobs.Wait(last);
+
+	ASSERT_TRUE(JobSystem::IsDone(first));
+	ASSERT_TRUE(JobSystem::IsDone(second));
+	ASSERT_EQ(order.size(), 3);
+	ASSERT_EQ(order.back(), 3);
+
+	// Depending on a job which is already done does not hold the new one back
+	const auto after = jobs.Schedule("after", []() {}, dependencies);
+	jobs.Wait(after);
+	ASSERT_TRUE(JobSystem::IsDone(after));
+}
+
+TEST(TestJobSystem, ParallelFor)
+{
+	for (const uint32_t workerCount : {0u, 1u, 4u})
+	{
+		JobSystem jobs(workerCount);
+		std::vector<uint64_t> values(10000);
+		jobs.ParallelFor("fill", values.size(), 64, [&values](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+			{
+				values[i] = i * 2;
+			}
+		});
+		ASSERT_EQ(std::accumulate(values.begin(), values.end(), uint64_t {0}), 9999ull * 10000);
+	}
+}
+
+TEST(TestJobSystem, ParallelForEach)
+{
+	struct Value
+	{
+		uint32_t value;
+		uint32_t doubled;
+	};
+	struct Skipped
+	{
+	};
+
+	entt::registry registry;
+	for (uint32_t i = 0; i < 1000; ++i)
+	{
+		const auto entity = registry.create();
+		registry.emplace<Value>(entity, i, 0u);
+		if (i % 3 == 0)
+		{
+			registry.emplace<Skipped>(entity);
+		}
+	}
+
+	JobSystem jobs(4);
+	const auto view = registry.view<Value>(entt::exclude<Skipped>);
+	std::atomic<uint32_t> visited {0};
+	jobs.ParallelForEach("double", view, 16, [&view, &visited](entt::entity entity) {
+		auto& value = view.get<Value>(entity);
+		value.doubled = value.value * 2;
+		++visited;
+	});
+
+	ASSERT_EQ(visited, 666);
+	registry.view<const Value>().each([&registry](entt::entity entity, const Value& value) {
+		ASSERT_EQ(value.doubled, registry.all_of<Skipped>(entity) ? 0 : value.value * 2);
+	});
+}
+
+TEST(TestJobSystem, WorkStealing)
+{
+	constexpr uint32_t k_Children = 16;
+	JobSystem jobs(2);
+	std::atomic<uint32_t> done {0};
+	std::atomic<uint32_t> ranOnProducer {0};
+	uint32_t producerThread = 0;
+	bool allDone = false;
+
+	// The children go to the queue of the producer, which does not run them, so the other worker has to steal them
+	const auto producer = jobs.Schedule("producer", [&]() {
+		producerThread = jobs.GetThreadIndex();
+		for (uint32_t i = 0; i < k_Children; ++i)
+		{
+			jobs.Schedule("child", [&jobs, &done, &ranOnProducer, producerThread]() {
+				ranOnProducer += jobs.GetThreadIndex() == producerThread ? 1 : 0;
+				++done;
+			});
+		}
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+		while (done < k_Children && std::chrono::steady_clock::now() < deadline)
+		{
+			std::this_thread::yield();
+		}
+		allDone = done == k_Children;
+	});
+	// Waiting would let the main thread run the producer or steal the children
+	while (!JobSystem::IsDone(producer))
+	{
+		std::this_thread::yield();
+	}
+
+	ASSERT_NE(producerThread, 0);
+	ASSERT_TRUE(allDone);
+	ASSERT_EQ(ranOnProducer, 0);
+}
+
+TEST(TestJobSystem, MemoryTag)
+{
+	JobSystem jobs(4);
+	std::vector<MemoryTag> tags(64, MemoryTag::_count);
+	const auto before = MemoryTracker::GetSnapshot();
+	{
+		const MemoryTracker::Scope terrain(MemoryTag::Terrain);
+		jobs.ParallelFor("allocate", tags.size(), 1, [&tags](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+			{
+				tags[i] = MemoryTracker::GetTag();
+				const auto buffer = std::make_unique<uint8_t[]>(1000);
+				ASSERT_NE(buffer, nullptr);
+			}
+		});
+	}
+	ASSERT_TRUE(std::ranges::all_of(tags, [](MemoryTag tag) { return tag == MemoryTag::Terrain; }));
+
+	// The tag is captured when scheduling, the workers do not keep it
+	MemoryTag untagged = MemoryTag::_count;
+	jobs.Wait(jobs.Schedule("untagged", [&untagged]() { untagged = MemoryTracker::GetTag(); }));
+	ASSERT_EQ(untagged, MemoryTag::Untagged);
+
+	if constexpr (MemoryTracker::k_Enabled)
+	{
+		const auto difference = MemoryTracker::GetDifference(MemoryTracker::GetSnapshot(), before);
+		const auto& terrain = difference[static_cast<size_t>(MemoryTag::Terrain)];
+		ASSERT_GE(terrain.allocatedBytes, tags.size() * 1000);
+		ASSERT_GE(terrain.freedBytes, tags.size() * 1000);
+	}
+}
+
+TEST(TestJobSystem, NestedJobs)
+{
+	JobSystem jobs(2);
+	std::atomic<uint32_t> count {0};
+	jobs.ParallelFor("outer", 8, 1, [&jobs, &count](size_t /*begin*/, size_t /*end*/) {
+		// Waiting from a worker runs the inner jobs rather than blocking it
+		jobs.ParallelFor("inner", 100, 10, [&count](size_t begin, size_t end) {
+			count += static_cast<uint32_t>(end - begin);
+		});
+	});
+	ASSERT_EQ(count, 800);
+}
+
+TEST(TestJobSystem, MainThreadAffinity)
+{
+	JobSystem jobs(2);
+	const auto mainThread = std::this_thread::get_id();
+	std::thread::id ranOn;
+	const auto background = jobs.Schedule("background", []() {});
+	const std::vector dependencies {background};
+	const auto upload = jobs.Schedule(
+	    "upload", [&ranOn]() { ranOn = std::this_thread::get_id(); }, dependencies, JobSystem::Affinity::MainThread);
+
+	jobs.Wait(background);
+	while (!JobSystem::IsDone(upload))
+	{
+		jobs.RunMainThreadJobs();
+	}
+	ASSERT_EQ(ranOn, mainThread);
+}
+
+TEST(TestJobSystem, FailedJob)
+{
+	JobSystem jobs(1);
+	bool ran = false;
+	const auto failed = jobs.Schedule("failed", []() { throw std::runtime_error("failure"); });
+	const std::vector dependencies {failed};
+	const auto next = jobs.Schedule("next", [&ran]() { ran = true; }, dependencies);
+	jobs.Wait(next);
+	ASSERT_TRUE(ran);
+}
+
+TEST(TestJobSystem, Timeline)
+{
+	JobSystem jobs(2);
+	jobs.SetRecording(true);
+	jobs.ParallelFor("work", 16, 1, [](size_t /*begin*/, size_t /*end*/) {});
+	ASSERT_TRUE(jobs.GetTimeline(0).empty());
+
+	jobs.BeginFrame();
+	size_t events = 0;
+	for (uint32_t thread = 0; thread <= jobs.GetWorkerCount(); ++thread)
+	{
+		for (const auto& event : jobs.GetTimeline(thread))
+		{
+			ASSERT_STREQ(event.name, "work");
+			ASSERT_LE(event.start, event.end);
+			++events;
+		}
+	}
+	ASSERT_EQ(events, 16);
+
+	jobs.BeginFrame();
+	ASSERT_TRUE(jobs.GetTimeline(0).empty());
+}
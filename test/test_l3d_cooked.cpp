@@ -0,0 +1,293 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <L3DCookedFile.h>
+#include <L3DFile.h>
+#include <L3DMeshOptimizer.h>
+
+using namespace openblack::l3d;
+
+namespace
+{
+/// A physics submesh of two quads, each its own primitive, moved by a single bone
+L3DFile BonedQuads()
+{
+	L3DFile l3d;
+
+	L3DSubmeshHeader header {};
+	header.flags.hasBones = 1;
+	header.flags.isPhysics = 1;
+	header.numPrimitives = 2;
+	l3d.AddSubmesh(header);
+
+	L3DPrimitiveHeader primitive {};
+	primitive.material.type = L3DMaterial::Type::Textured;
+	primitive.material.skinID = 3;
+	primitive.material.alphaCutoutThreshold = 128;
+	primitive.numVertices = 4;
+	primitive.numTriangles = 2;
+	primitive.numGroups = 1;
+	l3d.AddPrimitives({primitive, primitive});
+
+	std::vector<L3DVertex> vertices;
+	for (const float z : {0.0f, 1.0f})
+	{
+		for (const auto& [x, y] : {std::pair {0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}})
+		{
+			vertices.push_back({{x, y, z}, {x, y}, {0.0f, 0.0f, 1.0f}});
+		}
+	}
+	l3d.AddVertices(vertices);
+	l3d.AddIndices({0, 1, 2, 0, 2, 3, 0, 1, 2, 0, 2, 3});
+	l3d.AddVertexGroups({{8, 0}});
+
+	L3DBone bone {};
+	bone.parent = std::numeric_limits<uint32_t>::max();
+	bone.orientation = {1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+	bone.position = {10.0f, 0.0f, 0.0f};
+	l3d.AddBones({bone});
+
+	return l3d;
+}
+
+/// A single primitive grid of quads, with its triangles in a scrambled order
+L3DFile ScrambledGrid(uint16_t size)
+{
+	L3DFile l3d;
+
+	L3DSubmeshHeader header {};
+	header.numPrimitives = 1;
+	l3d.AddSubmesh(header);
+
+	std::vector<L3DVertex> vertices;
+	for (uint16_t y = 0; y <= size; ++y)
+	{
+		for (uint16_t x = 0; x <= size; ++x)
+		{
+			const auto fx = static_cast<float>(x);
+			const auto fy = static_cast<float>(y);
+			vertices.push_back({{fx - 3.0f, fy * 2.0f, fx * fy}, {fx / size, 1.0f - fy / size}, {0.6f, -0.8f, 0.0f}});
+		}
+	}
+
+	std::vector<uint16_t> indices;
+	const auto stride = static_cast<uint16_t>(size + 1);
+	const uint32_t quadCount = size * size;
+	for (uint32_t i = 0; i < quadCount; ++i)
+	{
+		// Visit quads with a stride coprime with their count so that neighbours are far apart
+		const auto quad = (i * 7919) % quadCount;
+		const auto corner = static_cast<uint16_t>(quad / size * stride + quad % size);
+		indices.insert(indices.end(), {corner, static_cast<uint16_t>(corner + 1), static_cast<uint16_t>(corner + stride)});
+		indices.insert(indices.end(), {static_cast<uint16_t>(corner + 1), static_cast<uint16_t>(corner + stride + 1),
+		                               static_cast<uint16_t>(corner + stride)});
+	}
+
+	L3DPrimitiveHeader primitive {};
+	primitive.material.type = L3DMaterial::Type::Smooth;
+	primitive.numVertices = static_cast<uint32_t>(vertices.size());
+	primitive.numTriangles = static_cast<uint32_t>(indices.size() / 3);
+	l3d.AddPrimitives({primitive});
+	l3d.AddVertices(vertices);
+	l3d.AddIndices(indices);
+	l3d.AddVertexGroups({{static_cast<uint16_t>(vertices.size()), 0}});
+
+	return l3d;
+}
+
+/// Triangles as their corner positions, rotated to start with the smallest corner and sorted
+std::vector<std::array<float, 9>> Triangles(const L3DCookedFile& file)
+{
+	const auto& submesh = file.GetSubmeshes()[0];
+	const auto vertices = file.GetVertices(submesh);
+	const auto indices = file.GetIndices(submesh);
+	std::vector<std::array<float, 9>> triangles;
+	for (size_t i = 0; i < indices.size(); i += 3)
+	{
+		std::array<std::array<float, 3>, 3> corners;
+		for (size_t k = 0; k < 3; ++k)
+		{
+			const auto& position = vertices[indices[i + k]].position;
+			corners.at(k) = {position.x, position.y, position.z};
+		}
+		std::ranges::rotate(corners, std::ranges::min_element(corners));
+		auto& triangle = triangles.emplace_back();
+		for (size_t k = 0; k < 9; ++k)
+		{
+			triangle.at(k) = corners.at(k / 3).at(k % 3);
+		}
+	}
+	std::ranges::sort(triangles);
+	return triangles;
+}
+} // namespace
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(L3DCookedFile, cookAndReopen)
+{
+	L3DCookedFile cooked;
+	ASSERT_EQ(cooked.Cook(BonedQuads(), 0x1234, nullptr, false), L3DResult::Success);
+
+	// Reopen from a copy, as if the file was mapped from the cache
+	const std::vector<uint8_t> buffer(cooked.GetBuffer().begin(), cooked.GetBuffer().end());
+	L3DCookedFile file;
+	ASSERT_EQ(file.Open(buffer), L3DResult::Success);
+	ASSERT_EQ(file.GetHeader().sourceHash, 0x1234);
+	ASSERT_EQ(buffer.size() % L3DCookedFile::k_BlockAlignment, 0);
+
+	ASSERT_EQ(file.GetSubmeshes().size(), 1);
+	const auto& submesh = file.GetSubmeshes()[0];
+	ASSERT_EQ(submesh.vertices.offset % L3DCookedFile::k_BlockAlignment, 0);
+	ASSERT_EQ(submesh.indices.offset % L3DCookedFile::k_BlockAlignment, 0);
+	ASSERT_FLOAT_EQ(submesh.minima.x, 10.0f);
+	ASSERT_FLOAT_EQ(submesh.maxima.x, 11.0f);
+	ASSERT_FLOAT_EQ(submesh.maxima.z, 1.0f);
+
+	const auto vertices = file.GetVertices(submesh);
+	ASSERT_EQ(vertices.size(), 8);
+	ASSERT_EQ(vertices[7].boneIndices[0], 0);
+	ASSERT_EQ(vertices[7].boneIndices[1], -1);
+
+	// Indices of the second primitive are rebased on its first vertex
+	const auto indices = file.GetIndices(submesh);
+	ASSERT_EQ(indices.size(), 12);
+	ASSERT_EQ(indices[6], 4);
+	ASSERT_EQ(indices[11], 7);
+
+	const auto primitives = file.GetPrimitives(submesh);
+	ASSERT_EQ(primitives.size(), 2);
+	ASSERT_EQ(primitives[1].indicesOffset, 6);
+	ASSERT_EQ(primitives[1].indicesCount, 6);
+	ASSERT_EQ(primitives[1].skinID, 3);
+	ASSERT_EQ(primitives[1].alphaCutoutThreshold, 128);
+
+	// Without an optimizer the hull is the physics submesh's vertices, still in bone space
+	ASSERT_FALSE(file.IsHullOptimized());
+	ASSERT_EQ(file.GetHullPoints().size(), 8);
+	ASSERT_FLOAT_EQ(file.GetHullPoints()[1].x, 1.0f);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(L3DCookedFile, indicesAreOptimized)
+{
+	const auto l3d = ScrambledGrid(24);
+	L3DCookedFile original;
+	ASSERT_EQ(original.Cook(l3d, 0, nullptr, false), L3DResult::Success);
+	L3DCookedFile optimized;
+	ASSERT_EQ(optimized.Cook(l3d, 0), L3DResult::Success);
+
+	// Same triangles with the same winding
+	ASSERT_EQ(Triangles(original), Triangles(optimized));
+
+	const auto& before = original.GetSubmeshes()[0];
+	const auto& after = optimized.GetSubmeshes()[0];
+	const auto vertexCount = static_cast<uint32_t>(optimized.GetVertices(after).size());
+	const auto acmrBefore = AverageCacheMissRatio(original.GetIndices(before), vertexCount);
+	const auto acmrAfter = AverageCacheMissRatio(optimized.GetIndices(after), vertexCount);
+	ASSERT_LT(acmrAfter, 0.8f);
+	ASSERT_LT(acmrAfter, acmrBefore * 0.5f);
+
+	const auto stride = static_cast<uint32_t>(sizeof(L3DCookedVertex));
+	ASSERT_LT(VertexFetchOverfetch(optimized.GetIndices(after), vertexCount, stride),
+	          VertexFetchOverfetch(original.GetIndices(before), vertexCount, stride));
+
+	// Vertices are numbered in the order they are first used
+	uint16_t highest = 0;
+	for (const auto index : optimized.GetIndices(after))
+	{
+		ASSERT_LE(index, highest + 1);
+		highest = std::max(highest, index);
+	}
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(L3DCookedFile, compactVertices)
+{
+	L3DCookedFile cooked;
+	ASSERT_EQ(cooked.Cook(ScrambledGrid(8), 0), L3DResult::Success);
+	const auto& submesh = cooked.GetSubmeshes()[0];
+	const auto vertices = cooked.GetVertices(submesh);
+	const auto compact = cooked.GetCompactVertices(submesh);
+	ASSERT_EQ(compact.size(), vertices.size());
+
+	const auto decode = [](int16_t value, float offset, float scale) {
+		return offset + std::max(static_cast<float>(value) / 32767.0f, -1.0f) * scale;
+	};
+	for (size_t i = 0; i < vertices.size(); ++i)
+	{
+		const auto& position = vertices[i].position;
+		ASSERT_NEAR(decode(compact[i].position[0], submesh.positionOffset.x, submesh.positionScale.x), position.x, 1e-3f);
+		ASSERT_NEAR(decode(compact[i].position[1], submesh.positionOffset.y, submesh.positionScale.y), position.y, 1e-3f);
+		ASSERT_NEAR(decode(compact[i].position[2], submesh.positionOffset.z, submesh.positionScale.z), position.z, 1e-3f);
+		ASSERT_NEAR(decode(compact[i].texCoord[0], submesh.texCoordOffset.x, submesh.texCoordScale.x),
+		            vertices[i].texCoord.x, 1e-4f);
+		ASSERT_NEAR(decode(compact[i].texCoord[1], submesh.texCoordOffset.y, submesh.texCoordScale.y),
+		            vertices[i].texCoord.y, 1e-4f);
+		ASSERT_EQ(compact[i].boneIndices, vertices[i].boneIndices);
+
+		// Unfold the octahedral normal as the vertex shader does
+		float x = decode(compact[i].normal[0], 0.0f, 1.0f);
+		float y = decode(compact[i].normal[1], 0.0f, 1.0f);
+		const float z = 1.0f - std::abs(x) - std::abs(y);
+		const float t = std::max(-z, 0.0f);
+		x += x >= 0.0f ? -t : t;
+		y += y >= 0.0f ? -t : t;
+		const float length = std::sqrt(x * x + y * y + z * z);
+		ASSERT_NEAR(x / length, 0.6f, 1e-3f);
+		ASSERT_NEAR(y / length, -0.8f, 1e-3f);
+		ASSERT_NEAR(z / length, 0.0f, 1e-3f);
+	}
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(L3DCookedFile, hullOptimizer)
+{
+	L3DCookedFile cooked;
+	const auto optimizer = [](std::span<const L3DPoint> points) {
+		return std::vector<L3DPoint>(points.begin(), points.begin() + 4);
+	};
+	ASSERT_EQ(cooked.Cook(BonedQuads(), 0, optimizer), L3DResult::Success);
+	ASSERT_TRUE(cooked.IsHullOptimized());
+	ASSERT_EQ(cooked.GetHullPoints().size(), 4);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(L3DCookedFile, invalidFilesAreRejected)
+{
+	L3DCookedFile cooked;
+	ASSERT_EQ(cooked.Cook(BonedQuads(), 0), L3DResult::Success);
+	const std::vector<uint8_t> buffer(cooked.GetBuffer().begin(), cooked.GetBuffer().end());
+
+	for (const size_t size : {size_t {0}, sizeof(L3DCookedHeader), buffer.size() - L3DCookedFile::k_BlockAlignment})
+	{
+		L3DCookedFile file;
+		ASSERT_NE(file.Open(std::span(buffer.data(), size)), L3DResult::Success) << size;
+		ASSERT_FALSE(file.IsLoaded()) << size;
+	}
+
+	auto stale = buffer;
+	const uint32_t version = L3DCookedFile::k_Version + 1;
+	std::memcpy(stale.data() + offsetof(L3DCookedHeader, version), &version, sizeof(version));
+	L3DCookedFile file;
+	ASSERT_EQ(file.Open(stale), L3DResult::ErrCookedVersionMismatch);
+	ASSERT_FALSE(file.IsLoaded());
+}
@@ -0,0 +1,102 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <array>
+
+#include <ECS/Systems/RenderingSystemInterface.h>
+#include <EngineConfig.h>
+#include <gtest/gtest.h>
+
+using openblack::ecs::systems::RenderContext;
+
+namespace
+{
+constexpr std::array<float, 2> k_Thresholds {0.08f, 0.02f};
+constexpr float k_Hysteresis = 0.15f;
+constexpr uint8_t k_AllLevels = 0b111;
+
+/// Level of detail of a sphere of radius 1 seen from a distance with a projection scale of 1
+uint8_t SelectAtDistance(float distance, uint8_t current = 0, uint8_t lodMask = k_AllLevels)
+{
+	const auto screenSize = RenderContext::GetScreenSize(1.0f, distance, 1.0f);
+	return RenderContext::SelectLevelOfDetail(screenSize, current, lodMask, k_Thresholds, k_Hysteresis);
+}
+} // namespace
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(LevelOfDetail, screenSizeShrinksWithDistance)
+{
+	ASSERT_FLOAT_EQ(RenderContext::GetScreenSize(2.0f, 10.0f, 1.5f), 0.3f);
+	ASSERT_FLOAT_EQ(RenderContext::GetScreenSize(2.0f, 20.0f, 1.5f), 0.15f);
+	// The camera is inside the bounding sphere
+	ASSERT_FLOAT_EQ(RenderContext::GetScreenSize(2.0f, 1.0f, 1.5f), 1.0f);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(LevelOfDetail, distanceThresholds)
+{
+	// Screen sizes of 1, 0.1, 0.05 and 0.01
+	ASSERT_EQ(SelectAtDistance(0.5f), 0);
+	ASSERT_EQ(SelectAtDistance(10.0f), 0);
+	ASSERT_EQ(SelectAtDistance(20.0f, 1), 1);
+	ASSERT_EQ(SelectAtDistance(100.0f, 2), 2);
+
+	// Well clear of the hysteresis band, the current level does not matter
+	for (uint8_t current = 0; current < RenderContext::k_LevelsOfDetail; ++current)
+	{
+		ASSERT_EQ(SelectAtDistance(5.0f, current), 0);
+		ASSERT_EQ(SelectAtDistance(25.0f, current), 1);
+		ASSERT_EQ(SelectAtDistance(200.0f, current), 2);
+	}
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(LevelOfDetail, hysteresisKeepsCurrentLevel)
+{
+	// A screen size of 0.075 is just under the first threshold, 0.0833 just over it
+	ASSERT_EQ(SelectAtDistance(1.0f / 0.075f, 0), 0);
+	ASSERT_EQ(SelectAtDistance(1.0f / 0.075f, 1), 1);
+	ASSERT_EQ(SelectAtDistance(12.0f, 0), 0);
+	ASSERT_EQ(SelectAtDistance(12.0f, 1), 1);
+
+	// A screen size of 0.021 is just over the second threshold
+	ASSERT_EQ(SelectAtDistance(1.0f / 0.021f, 1), 1);
+	ASSERT_EQ(SelectAtDistance(1.0f / 0.021f, 2), 2);
+	ASSERT_EQ(SelectAtDistance(1.0f / 0.021f, 0), 1);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(LevelOfDetail, submeshMaskFallsBackToClosestLevel)
+{
+	// Bit i of the 3 bit submesh mask is set when level i exists
+	ASSERT_EQ(RenderContext::GetClosestLevelOfDetail(2, 0b001), 0);
+	ASSERT_EQ(RenderContext::GetClosestLevelOfDetail(0, 0b100), 2);
+	ASSERT_EQ(RenderContext::GetClosestLevelOfDetail(1, 0b101), 0);
+	ASSERT_EQ(RenderContext::GetClosestLevelOfDetail(0, 0b110), 1);
+	ASSERT_EQ(RenderContext::GetClosestLevelOfDetail(2, 0b011), 1);
+	ASSERT_EQ(RenderContext::GetClosestLevelOfDetail(1, 0b000), 0);
+
+	// Selection applies the mask after the thresholds
+	ASSERT_EQ(SelectAtDistance(100.0f, 2, 0b001), 0);
+	ASSERT_EQ(SelectAtDistance(10.0f, 0, 0b110), 1);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(LevelOfDetail, defaultThresholdsDecrease)
+{
+	const openblack::EngineConfig config;
+	static_assert(std::tuple_size_v<decltype(config.lodScreenSizeThresholds)> == RenderContext::k_LevelsOfDetail - 1);
+	float previous = 1.0f;
+	for (const auto threshold : config.lodScreenSizeThresholds)
+	{
+		ASSERT_GT(threshold, 0.0f);
+		ASSERT_LT(threshold * (1.0f + config.lodHysteresis), previous * (1.0f - config.lodHysteresis));
+		previous = threshold;
+	}
+}
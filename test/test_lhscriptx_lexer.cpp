@@ -0,0 +1,131 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+#include <Common/StringUtils.h>
+#include <LHScriptX/CommandHash.h>
+#include <LHScriptX/FeatureScriptCommands.h>
+#include <LHScriptX/Lexer.h>
+#include <LHScriptX/Script.h>
+
+using namespace openblack::lhscriptx;
+
+namespace
+{
+constexpr std::array<std::string_view, 5> k_Names = {
+    "CREATE_TOWN", "CREATE_ABODE", "CREATE_TREE", "VERSION", "CREATE_TOWN_CENTRE",
+};
+constexpr CommandHash k_Hash(k_Names);
+static_assert(k_Hash.Find("CREATE_ABODE") == 1);
+static_assert(!k_Hash.Find("CREATE_ABOD").has_value());
+} // namespace
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(LHScriptXLexer, tokensViewTheSource)
+{
+	const std::string source = "CREATE_TOWN(4, \"1234.5,  678.25\", -12.5, PLAYER_ONE) // comment\r\nREM whole line\n";
+	Lexer lexer(source);
+
+	auto token = lexer.GetToken();
+	ASSERT_TRUE(token.IsIdentifier());
+	ASSERT_EQ(token.Identifier(), "CREATE_TOWN");
+	ASSERT_GE(token.Identifier().data(), source.data());
+	ASSERT_LT(token.Identifier().data(), source.data() + source.size());
+	ASSERT_TRUE(lexer.GetToken().IsOP(Operator::LeftParentheses));
+
+	token = lexer.GetToken();
+	ASSERT_EQ(token.GetType(), Token::Type::Integer);
+	ASSERT_EQ(*token.IntegerValue(), 4);
+	ASSERT_TRUE(lexer.GetToken().IsOP(Operator::Comma));
+
+	token = lexer.GetToken();
+	ASSERT_TRUE(token.IsString());
+	ASSERT_EQ(token.StringValue(), "1234.5,  678.25");
+	ASSERT_TRUE(lexer.GetToken().IsOP(Operator::Comma));
+
+	token = lexer.GetToken();
+	ASSERT_EQ(token.GetType(), Token::Type::Float);
+	ASSERT_FLOAT_EQ(*token.FloatValue(), -12.5f);
+	ASSERT_TRUE(lexer.GetToken().IsOP(Operator::Comma));
+
+	ASSERT_EQ(lexer.GetToken().Identifier(), "PLAYER_ONE");
+	ASSERT_TRUE(lexer.GetToken().IsOP(Operator::RightParentheses));
+	ASSERT_EQ(lexer.GetToken().GetType(), Token::Type::EndOfLine);
+	ASSERT_EQ(lexer.GetToken().GetType(), Token::Type::EndOfLine);
+	ASSERT_TRUE(lexer.GetToken().IsEOF());
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(LHScriptXLexer, endOfSourceIsNotRead)
+{
+	// Views are not null terminated, nothing past the end may be looked at
+	const std::string source = "VERSION(1)\nCREATE_TREE(2)rem";
+	Lexer lexer(std::string_view(source).substr(0, source.size() - 2));
+	for (int i = 0; i < 5; ++i)
+	{
+		lexer.GetToken();
+	}
+	ASSERT_EQ(lexer.GetToken().Identifier(), "CREATE_TREE");
+	lexer.GetToken();
+	ASSERT_EQ(*lexer.GetToken().IntegerValue(), 2);
+	ASSERT_TRUE(lexer.GetToken().IsOP(Operator::RightParentheses));
+	ASSERT_EQ(lexer.GetToken().Identifier(), "r");
+	ASSERT_TRUE(lexer.GetToken().IsEOF());
+
+	Lexer unterminated("\"never closed");
+	ASSERT_EQ(unterminated.GetToken().StringValue(), "never closed");
+	ASSERT_TRUE(unterminated.GetToken().IsEOF());
+
+	Lexer overflow("99999999999");
+	ASSERT_THROW(overflow.GetToken(), LexerException);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(LHScriptXLexer, perfectHashFindsEveryCommand)
+{
+	for (std::size_t i = 0; i < k_Names.size(); ++i)
+	{
+		ASSERT_EQ(k_Hash.Find(k_Names[i]), i);
+	}
+	ASSERT_FALSE(k_Hash.Find("").has_value());
+	ASSERT_FALSE(k_Hash.Find("create_town").has_value());
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(LHScriptXLexer, scriptFindsEverySignature)
+{
+	for (const auto& signature : FeatureScriptCommands::k_Signatures)
+	{
+		ASSERT_EQ(Script::FindCommand(signature.name.data()), &signature) << signature.name.data();
+	}
+	ASSERT_EQ(Script::FindCommand(""), nullptr);
+	ASSERT_EQ(Script::FindCommand("CREATE_TOWN_"), nullptr);
+	ASSERT_EQ(Script::FindCommand("create_town"), nullptr);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(LHScriptXLexer, floatsParseWithoutFromChars)
+{
+	ASSERT_FLOAT_EQ(*Lexer("1.5").GetToken().FloatValue(), 1.5f);
+	ASSERT_FLOAT_EQ(*Lexer("-0.25").GetToken().FloatValue(), -0.25f);
+	ASSERT_FLOAT_EQ(*Lexer("3.").GetToken().FloatValue(), 3.0f);
+	ASSERT_THROW(Lexer("1.2.3").GetToken(), LexerException);
+
+	ASSERT_EQ(openblack::string_utils::ParseFloat("1234.5"), 1234.5f);
+	ASSERT_FALSE(openblack::string_utils::ParseFloat("").has_value());
+	ASSERT_FALSE(openblack::string_utils::ParseFloat(" 1.5").has_value());
+	ASSERT_FALSE(openblack::string_utils::ParseFloat("1.5x").has_value());
+	ASSERT_FALSE(openblack::string_utils::ParseFloat("inf").has_value());
+	ASSERT_FALSE(openblack::string_utils::ParseFloat("0x1p3").has_value());
+	ASSERT_FALSE(openblack::string_utils::ParseFloat("1e99").has_value());
+}
@@ -0,0 +1,198 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <cstring>
+
+#include <array>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <LHVM.h>
+#include <LHVMFile.h>
+
+using namespace openblack::lhvm;
+
+namespace
+{
+constexpr uint32_t k_ScriptCount = 2000;
+constexpr uint32_t k_VariableCount = 5000;
+
+class Writer
+{
+public:
+	template <typename T>
+	void Write(const T& value)
+	{
+		const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+		buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+	}
+
+	void Write(const std::string& string)
+	{
+		buffer.insert(buffer.end(), string.begin(), string.end());
+		buffer.push_back('\0');
+	}
+
+	std::vector<uint8_t> buffer;
+};
+
+/// A challenge with a script per autostart entry, each one a single END instruction
+Writer LargeChallenge()
+{
+	Writer writer;
+	writer.Write(std::array<char, 4> {'L', 'H', 'V', 'M'});
+	writer.Write(LHVMVersion::BlackAndWhite);
+
+	writer.Write(static_cast<int32_t>(k_VariableCount));
+	for (uint32_t i = 0; i < k_VariableCount; ++i)
+	{
+		writer.Write("global_" + std::to_string(i));
+	}
+
+	writer.Write(static_cast<int32_t>(k_ScriptCount));
+	for (uint32_t i = 0; i < k_ScriptCount; ++i)
+	{
+		writer.Write(VMInstruction(Opcode::End, VMMode::Immediate, DataType::Int, VMValue(0u), i));
+	}
+
+	writer.Write(static_cast<int32_t>(k_ScriptCount));
+	for (uint32_t i = 1; i <= k_ScriptCount; ++i)
+	{
+		writer.Write(i);
+	}
+
+	writer.Write(static_cast<int32_t>(k_ScriptCount));
+	for (uint32_t i = 0; i < k_ScriptCount; ++i)
+	{
+		writer.Write("script_" + std::to_string(i));
+		writer.Write(std::string("challenge.txt"));
+		writer.Write(ScriptType::Script);
+		writer.Write(0u);
+		writer.Write(static_cast<int32_t>(1));
+		writer.Write(std::string("local"));
+		writer.Write(i);
+		writer.Write(0u);
+		writer.Write(i + 1);
+	}
+
+	const std::string data = "challenge data";
+	writer.Write(static_cast<int32_t>(data.size()));
+	writer.buffer.insert(writer.buffer.end(), data.begin(), data.end());
+	return writer;
+}
+
+/// The challenge with a single task running the last script
+std::vector<uint8_t> LargeSave()
+{
+	auto writer = LargeChallenge();
+
+	VMStack stack;
+	stack.count = 1;
+	stack.values[0] = VMValue(42);
+	stack.types[0] = DataType::Int;
+	writer.Write(stack.count);
+	writer.Write(stack.pushCount);
+	writer.Write(stack.popCount);
+	writer.Write(stack.values[0]);
+	writer.Write(stack.types[0]);
+
+	writer.Write(k_VariableCount);
+	for (uint32_t i = 0; i < k_VariableCount; ++i)
+	{
+		writer.Write(static_cast<uint8_t>(DataType::Float));
+		writer.Write(VMValue(static_cast<float>(i)));
+		writer.Write("global_" + std::to_string(i));
+	}
+
+	writer.Write(1u);
+	writer.Write(0u);                // local variables
+	writer.Write(7u);                // id
+	writer.Write(k_ScriptCount - 1); // instruction address
+	for (uint32_t i = 0; i < 5; ++i)
+	{
+		writer.Write(0u); // previous address, waiting task, variables offset, exception handler index, ticks
+	}
+	writer.Write(k_ScriptCount); // script id
+	writer.Write(ScriptType::Script);
+	writer.Write(std::array<bool, 4> {});
+	writer.Write(0u); // stack count
+	writer.Write(0u);
+	writer.Write(0u);
+	writer.Write(0u); // exception handlers
+
+	for (const uint32_t value : {100u, 0u, 7u, k_ScriptCount, 1234u})
+	{
+		writer.Write(value); // ticks, line, highest task id, highest script id, executed instructions
+	}
+	return writer.buffer;
+}
+} // namespace
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(LHVMFile, parseLargeChallenge)
+{
+	const auto buffer = LargeChallenge().buffer;
+	LHVMFile file;
+	file.Open(buffer);
+
+	ASSERT_TRUE(file.IsLoaded());
+	ASSERT_FALSE(file.HasStatus());
+	ASSERT_EQ(file.GetVariablesNames().size(), k_VariableCount);
+	ASSERT_EQ(file.GetVariablesNames().back(), "global_4999");
+	ASSERT_EQ(file.GetInstructions().size(), k_ScriptCount);
+	ASSERT_EQ(file.GetInstructions().back().line, k_ScriptCount - 1);
+	ASSERT_EQ(file.GetAutostart().size(), k_ScriptCount);
+	ASSERT_EQ(file.GetScripts().size(), k_ScriptCount);
+	ASSERT_EQ(file.GetScripts()[12].name, "script_12");
+	ASSERT_EQ(file.GetScripts()[12].filename, "challenge.txt");
+	ASSERT_EQ(file.GetScripts()[12].variables, std::vector<std::string> {"local"});
+	ASSERT_EQ(file.GetScripts()[12].scriptId, 13);
+	ASSERT_EQ(std::string(file.GetData().begin(), file.GetData().end()), "challenge data");
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(LHVMFile, truncatedFilesAreRejected)
+{
+	const auto buffer = LargeChallenge().buffer;
+	for (const size_t size : {size_t {0}, size_t {8}, size_t {100}, buffer.size() / 2, buffer.size() - 1})
+	{
+		LHVMFile file;
+		file.Open(std::span(buffer.data(), size));
+		ASSERT_FALSE(file.IsLoaded()) << size;
+	}
+
+	// A name missing its terminator must not be read past the end of the buffer
+	auto unterminated = std::vector<uint8_t>(buffer.begin(), buffer.begin() + 16);
+	std::memset(unterminated.data() + 12, 'x', 4);
+	LHVMFile file;
+	file.Open(unterminated);
+	ASSERT_FALSE(file.IsLoaded());
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(LHVMFile, loadAndRestoreFromBuffer)
+{
+	LHVM vm;
+	ASSERT_EQ(vm.LoadBinary(LargeChallenge().buffer), EXIT_SUCCESS);
+	ASSERT_EQ(vm.GetScripts().size(), k_ScriptCount);
+	ASSERT_EQ(vm.GetTasks().size(), k_ScriptCount);
+	ASSERT_EQ(vm.GetVariables().size(), k_VariableCount + 1);
+	ASSERT_EQ(vm.RestoreState(LargeChallenge().buffer), EXIT_FAILURE);
+
+	ASSERT_EQ(vm.RestoreState(LargeSave()), EXIT_SUCCESS);
+	ASSERT_EQ(vm.GetVariables().size(), k_VariableCount);
+	ASSERT_EQ(vm.GetVariables()[10].value.floatVal, 10.0f);
+	ASSERT_EQ(vm.GetTasks().size(), 1);
+	const auto& task = vm.GetTasks().at(7);
+	ASSERT_EQ(task.name, "script_1999");
+	ASSERT_EQ(task.instructionAddress, k_ScriptCount - 1);
+}
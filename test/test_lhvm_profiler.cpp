@@ -0,0 +1,61 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <sstream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <LHVMProfiler.h>
+
+using namespace openblack::lhvm;
+using namespace std::chrono_literals;
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(LHVMProfiler, nativeTimeIsSubtractedFromScripts)
+{
+	const std::vector<VMScript> scripts = {
+	    {"LandControlAll", "test.txt", ScriptType::Script, 0, {}, 0, 0, 1},
+	    {"Tutorial", "test.txt", ScriptType::Help, 0, {}, 0, 0, 2},
+	};
+	const std::vector<NativeFunction> functions = {
+	    {nullptr, 0, 0, "NONE"},
+	    {nullptr, 0, 0, "GET_PROPERTY"},
+	    {nullptr, 0, 0, "SET_CAMERA_POSITION"},
+	};
+	VMTask land({}, 1, 1, 0, 0, {}, "LandControlAll", "test.txt", ScriptType::Script);
+	VMTask tutorial({}, 2, 2, 0, 0, {}, "Tutorial", "test.txt", ScriptType::Help);
+	VMTask secondLand({}, 1, 3, 0, 0, {}, "LandControlAll", "test.txt", ScriptType::Script);
+
+	LHVMProfiler profiler;
+	profiler.AddNativeCall(&land, 1, 300us);
+	profiler.AddNativeCall(&land, 2, 200us);
+	profiler.AddTaskRun(land, 40, 1000us);
+	profiler.AddNativeCall(&tutorial, 1, 50us);
+	profiler.AddTaskRun(tutorial, 5, 50us);
+	profiler.AddTaskRun(secondLand, 10, 100us);
+
+	ASSERT_EQ(profiler.GetScripts().at(1).calls, 2);
+	ASSERT_EQ(profiler.GetScripts().at(1).instructions, 50);
+	ASSERT_EQ(profiler.GetScripts().at(1).SelfTime(), 600us);
+	ASSERT_EQ(profiler.GetTasks().at(3).time, 100us);
+	ASSERT_EQ(profiler.GetNativeFunctions().at(1).calls, 2);
+	ASSERT_EQ(profiler.GetNativeFunctions().at(1).time, 350us);
+
+	std::ostringstream stream;
+	profiler.WriteCollapsedStacks(stream, scripts, &functions);
+	ASSERT_EQ(stream.str(), "LHVM;LandControlAll 600\n"
+	                        "LHVM;LandControlAll;GET_PROPERTY 300\n"
+	                        "LHVM;LandControlAll;SET_CAMERA_POSITION 200\n"
+	                        "LHVM;Tutorial;GET_PROPERTY 50\n");
+
+	profiler.Reset();
+	ASSERT_TRUE(profiler.GetScripts().empty());
+	ASSERT_TRUE(profiler.GetNativeFunctions().empty());
+}
@@ -0,0 +1,217 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <LHVM.h>
+
+using namespace openblack::lhvm;
+
+namespace
+{
+/// Gives access to the program and to the LookIn which scanned every task each turn, as a reference
+class TestLHVM: public LHVM
+{
+public:
+	explicit TestLHVM(std::vector<std::string>& log)
+	{
+		_natives.emplace_back(nullptr, 0, 0, "NONE");
+		_natives.emplace_back([this, &log] { log.emplace_back("log " + std::to_string(Pop().intVal)); }, 1, 0, "LOG");
+		_natives.emplace_back([this] { StopScripts([](const auto& name, const auto&) { return name == "child"; }); }, 0, 0,
+		                      "STOP_CHILD");
+		const auto stopTask = [&log](uint32_t taskNumber) { log.emplace_back("stop " + std::to_string(taskNumber)); };
+		Initialise(&_natives, nullptr, nullptr, stopTask, nullptr, nullptr, nullptr);
+	}
+
+	void Load(std::vector<VMInstruction> instructions, std::vector<VMScript> scripts)
+	{
+		_instructions = std::move(instructions);
+		_scripts = std::move(scripts);
+		_variables.emplace_back(DataType::Float, VMValue(0.0f), "Null variable");
+		for (const auto& script : _scripts)
+		{
+			StartScript(script.name, ScriptType::All);
+		}
+	}
+
+	void LookInAllTasks(const ScriptType allowedScriptTypesMask)
+	{
+		for (auto& [id, task] : _tasks)
+		{
+			if (task.type & allowedScriptTypesMask)
+			{
+				_currentStack = &task.stack;
+				if (task.inExceptionHandler)
+				{
+					CpuLoop(task);
+				}
+				else if (task.waitingTaskId == 0)
+				{
+					task.currentExceptionHandlerIndex = 0;
+					if (GetExceptionHandlersCount() > 0)
+					{
+						task.pevInstructionAddress = task.instructionAddress;
+						task.instructionAddress = GetCurrentExceptionHandlerIp(task.currentExceptionHandlerIndex);
+						task.inExceptionHandler = true;
+						CpuLoop(task);
+					}
+				}
+			}
+		}
+		for (auto& [id, task] : _tasks)
+		{
+			if (task.type & allowedScriptTypesMask)
+			{
+				_currentStack = &task.stack;
+				if (!task.inExceptionHandler)
+				{
+					CpuLoop(task);
+				}
+			}
+		}
+		for (auto iter = _tasks.begin(); iter != _tasks.end();)
+		{
+			auto& task = (*iter++).second;
+			if (task.stop)
+			{
+				StopTask(task.id);
+			}
+		}
+		_stoppedTasks.clear();
+		for (auto& [id, task] : _tasks)
+		{
+			if (task.type & allowedScriptTypesMask)
+			{
+				task.ticks++;
+				if (task.waitingTaskId != 0 && !TaskExists(task.waitingTaskId))
+				{
+					task.waitingTaskId = 0;
+					task.instructionAddress++;
+				}
+			}
+		}
+		_ticks++;
+		_currentStack = &_mainStack;
+	}
+
+	void Settle() { SettleParkedTasks(); }
+
+	[[nodiscard]] size_t ReadyCount() const { return _readyTasks.size(); }
+	[[nodiscard]] uint32_t ExecutedInstructions() const { return _executedInstructions; }
+
+private:
+	std::vector<NativeFunction> _natives;
+};
+
+VMInstruction Push(float value)
+{
+	return {Opcode::Push, VMMode::Immediate, DataType::Float, VMValue(value), 0};
+}
+
+VMInstruction Pushi(int32_t value)
+{
+	return {Opcode::Push, VMMode::Immediate, DataType::Int, VMValue(value), 0};
+}
+
+VMInstruction Op(Opcode code, VMMode mode = VMMode::Immediate, uint32_t data = 0)
+{
+	return {code, mode, DataType::Int, VMValue(data), 0};
+}
+
+/// Main waits for child, which is stopped by short before the end of its last wait
+std::vector<VMInstruction> Instructions()
+{
+	return {
+	    // main
+	    Push(1.5f), Op(Opcode::Sleep), Op(Opcode::Wait, VMMode::Backward, 0), Pushi(1), Op(Opcode::Sys, {}, 1),
+	    Op(Opcode::Run, VMMode::Sync, 2), Push(0.3f), Op(Opcode::Sleep), Op(Opcode::Wait, VMMode::Backward, 6), Pushi(10),
+	    Op(Opcode::Sys, {}, 1), Op(Opcode::Jmp, VMMode::Backward, 0),
+	    // child
+	    Push(0.5f), Op(Opcode::Sleep), Op(Opcode::Wait, VMMode::Backward, 12), Pushi(2), Op(Opcode::Sys, {}, 1),
+	    Op(Opcode::Run, VMMode::Async, 4), Push(5.0f), Op(Opcode::Sleep), Op(Opcode::Wait, VMMode::Backward, 18),
+	    Op(Opcode::End),
+	    // busy
+	    Pushi(3), Op(Opcode::Sys, {}, 1), Op(Opcode::Jmp, VMMode::Backward, 22),
+	    // short
+	    Push(0.2f), Op(Opcode::Sleep), Op(Opcode::Wait, VMMode::Backward, 25), Op(Opcode::Sys, {}, 2), Op(Opcode::End),
+	};
+}
+
+std::vector<VMScript> Scripts()
+{
+	return {
+	    {"main", "test.txt", ScriptType::Script, 0, {}, 0, 0, 1},
+	    {"child", "test.txt", ScriptType::Help, 0, {}, 12, 0, 2},
+	    {"busy", "test.txt", ScriptType::Help, 0, {}, 22, 0, 3},
+	    {"short", "test.txt", ScriptType::Script, 0, {}, 25, 0, 4},
+	};
+}
+} // namespace
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(LHVMScheduler, sameOrderAsScanningEveryTask)
+{
+	std::vector<std::string> log;
+	std::vector<std::string> referenceLog;
+	TestLHVM vm(log);
+	TestLHVM reference(referenceLog);
+	vm.Load(Instructions(), Scripts());
+	reference.Load(Instructions(), Scripts());
+
+	const std::array<ScriptType, 4> masks = {ScriptType::All, ScriptType::Script, ScriptType::All, ScriptType::Help};
+	for (uint32_t turn = 0; turn < 2000; ++turn)
+	{
+		const auto mask = masks.at((turn / 7) % masks.size());
+		vm.LookIn(mask);
+		reference.LookInAllTasks(mask);
+		ASSERT_EQ(log, referenceLog) << "turn " << turn;
+	}
+
+	vm.Settle();
+	ASSERT_EQ(vm.ExecutedInstructions(), reference.ExecutedInstructions());
+	ASSERT_EQ(vm.GetTasks().size(), reference.GetTasks().size());
+	for (const auto& [id, task] : reference.GetTasks())
+	{
+		const auto& other = vm.GetTasks().at(id);
+		ASSERT_EQ(other.instructionAddress, task.instructionAddress);
+		ASSERT_EQ(other.ticks, task.ticks);
+		ASSERT_EQ(other.waitingTaskId, task.waitingTaskId);
+		ASSERT_EQ(other.stack.count, task.stack.count);
+		ASSERT_EQ(other.stack.pushCount, task.stack.pushCount);
+		ASSERT_EQ(other.stack.popCount, task.stack.popCount);
+	}
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(LHVMScheduler, sleepingTasksAreNotVisited)
+{
+	std::vector<std::string> log;
+	TestLHVM vm(log);
+	vm.Load({Push(100.0f), Op(Opcode::Sleep), Op(Opcode::Wait, VMMode::Backward, 0), Op(Opcode::End)},
+	        {{"sleeper", "test.txt", ScriptType::Script, 0, {}, 0, 0, 1}});
+
+	vm.LookIn(ScriptType::All);
+	ASSERT_EQ(vm.ReadyCount(), 0);
+	const auto executed = vm.ExecutedInstructions();
+	for (uint32_t turn = 1; turn < 1000; ++turn)
+	{
+		vm.LookIn(ScriptType::All);
+	}
+	ASSERT_EQ(vm.ReadyCount(), 0);
+	ASSERT_EQ(vm.ExecutedInstructions(), executed);
+	ASSERT_EQ(vm.GetTasks().size(), 1);
+
+	vm.LookIn(ScriptType::All);
+	ASSERT_TRUE(vm.GetTasks().empty());
+	ASSERT_EQ(log, std::vector<std::string> {"stop 1"});
+}
@@ -0,0 +1,183 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <filesystem>
+#include <vector>
+
+#include <ECS/Components/LivingAction.h>
+#include <ECS/Components/Villager.h>
+#include <ECS/Registry.h>
+#include <ECS/Systems/LivingActionSystemInterface.h>
+#include <Game.h>
+#include <Locator.h>
+#include <gtest/gtest.h>
+
+using namespace openblack;
+using namespace openblack::ecs::components;
+
+class LivingActionTransitions: public ::testing::Test
+{
+protected:
+	struct StateChange
+	{
+		entt::entity entity;
+		VillagerStates src;
+		VillagerStates dst;
+
+		bool operator==(const StateChange&) const = default;
+	};
+
+	void SetUp() override
+	{
+		static const auto mockGamePath = std::filesystem::path(TEST_BINARY_DIR) / "mock";
+		auto args = openblack::Arguments {
+		    .rendererType = bgfx::RendererType::Enum::Noop,
+		    .gamePath = mockGamePath.string(),
+		    .logFile = "stdout",
+		};
+		std::fill_n(args.logLevels.begin(), args.logLevels.size(), spdlog::level::warn);
+		_game = std::make_unique<openblack::Game>(std::move(args));
+		ASSERT_TRUE(_game->Initialize());
+		Locator::entitiesRegistry::value().Reset();
+
+		Locator::livingActionSystem::value().SetStateChangeCallback(
+		    [this](const LivingAction& action, LivingAction::Index index, VillagerStates src, VillagerStates dst) {
+			    if (index == LivingAction::Index::Top)
+			    {
+				    _stateChanges.push_back({Locator::entitiesRegistry::value().ToEntity(action), src, dst});
+			    }
+		    });
+	}
+
+	void TearDown() override
+	{
+		Locator::livingActionSystem::value().SetStateChangeCallback(nullptr);
+		_game.reset();
+	}
+
+	std::unique_ptr<openblack::Game> _game;
+	/// Changes of the top state, in the order they were applied
+	std::vector<StateChange> _stateChanges;
+};
+
+// Villagers are processed grouped by state, transitions must still happen in the order of the registry as when each
+// villager was processed one after the other
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(LivingActionTransitions, transitionOrderMatchesRegistryOrder)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	auto& actionSystem = Locator::livingActionSystem::value();
+
+	// Villagers deciding what to do go home, their state comes after Created in the table so they are processed last
+	actionSystem.SetStateFunction(VillagerStates::DecideWhatToDo, [](LivingAction& action) -> uint32_t {
+		Locator::livingActionSystem::value().VillagerSetState(action, LivingAction::Index::Top, VillagerStates::GoHome, false);
+		return 0;
+	});
+
+	// Interleave villagers which change state on different turns with villagers in a later state of the table
+	constexpr uint16_t k_VillagerCount = 64;
+	constexpr uint16_t k_Turns = 5;
+	for (uint16_t i = 0; i < k_VillagerCount; ++i)
+	{
+		const auto entity = registry.Create();
+		registry.Assign<Villager>(entity);
+		if (i % 3 == 0)
+		{
+			registry.Assign<LivingAction>(entity, VillagerStates::DecideWhatToDo, uint16_t {0});
+		}
+		else
+		{
+			registry.Assign<LivingAction>(entity, VillagerStates::Created, static_cast<uint16_t>((i * 7) % k_Turns));
+		}
+	}
+
+	size_t transitionCount = 0;
+	size_t mixedTurns = 0;
+	for (uint16_t turn = 0; turn < k_Turns + 2; ++turn)
+	{
+		// Expected transitions if villagers were processed one at a time in registry order
+		std::vector<StateChange> expected;
+		registry.Each<const Villager, const LivingAction>(
+		    [&expected](entt::entity entity, const Villager& /*unused*/, const LivingAction& action) {
+			    const auto state = static_cast<VillagerStates>(action.states[static_cast<size_t>(LivingAction::Index::Top)]);
+			    if (state == VillagerStates::Created && action.turnsUntilStateChange == 0)
+			    {
+				    expected.push_back({entity, VillagerStates::Created, VillagerStates::DecideWhatToDo});
+			    }
+			    else if (state == VillagerStates::DecideWhatToDo)
+			    {
+				    expected.push_back({entity, VillagerStates::DecideWhatToDo, VillagerStates::GoHome});
+			    }
+		    });
+		// Without sorting, the changes would be applied one state after the other
+		const auto isSorted = std::ranges::is_sorted(
+		    expected, [](const StateChange& lhs, const StateChange& rhs) { return lhs.src < rhs.src; });
+		mixedTurns += isSorted ? 0 : 1;
+
+		_stateChanges.clear();
+		actionSystem.Update();
+
+		ASSERT_EQ(_stateChanges, expected) << "on turn " << turn;
+		transitionCount += _stateChanges.size();
+	}
+	ASSERT_GT(mixedTurns, 0);
+	const auto decidingCount = (k_VillagerCount + 2) / 3;
+	ASSERT_EQ(transitionCount, decidingCount + 2 * (k_VillagerCount - decidingCount));
+
+	registry.Each<const LivingAction>([&actionSystem](const LivingAction& action) {
+		ASSERT_EQ(actionSystem.VillagerGetState(action, LivingAction::Index::Top), VillagerStates::GoHome);
+	});
+}
+
+// The new state is written so that the villager is handled by the function of that state from the next turn on
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(LivingActionTransitions, stateChangeTakesEffect)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	auto& actionSystem = Locator::livingActionSystem::value();
+
+	const auto entity = registry.Create();
+	registry.Assign<Villager>(entity);
+	const auto& action = registry.Assign<LivingAction>(entity, VillagerStates::Created, uint16_t {0});
+
+	actionSystem.Update();
+	const std::vector<StateChange> expected {{entity, VillagerStates::Created, VillagerStates::DecideWhatToDo}};
+	ASSERT_EQ(_stateChanges, expected);
+	ASSERT_EQ(actionSystem.VillagerGetState(action, LivingAction::Index::Top), VillagerStates::DecideWhatToDo);
+
+	// Created is not run again, which would request the same transition every turn
+	actionSystem.Update();
+	actionSystem.Update();
+	ASSERT_EQ(_stateChanges, expected);
+	ASSERT_EQ(action.turnsSinceStateChange, 2);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(LivingActionTransitions, setStateOutsideOfUpdateIsImmediate)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	auto& actionSystem = Locator::livingActionSystem::value();
+
+	const auto entity = registry.Create();
+	registry.Assign<Villager>(entity);
+	auto& action = registry.Assign<LivingAction>(entity, VillagerStates::Created, uint16_t {10});
+	action.turnsSinceStateChange = 5;
+
+	actionSystem.VillagerSetState(action, LivingAction::Index::Top, VillagerStates::DecideWhatToDo, true);
+	ASSERT_EQ(actionSystem.VillagerGetState(action, LivingAction::Index::Top), VillagerStates::DecideWhatToDo);
+	ASSERT_EQ(action.turnsSinceStateChange, 0);
+	const std::vector<StateChange> expected {{entity, VillagerStates::Created, VillagerStates::DecideWhatToDo}};
+	ASSERT_EQ(_stateChanges, expected);
+
+	actionSystem.VillagerSetState(action, LivingAction::Index::Final, VillagerStates::Created, false);
+	ASSERT_EQ(actionSystem.VillagerGetState(action, LivingAction::Index::Final), VillagerStates::Created);
+	ASSERT_EQ(actionSystem.VillagerGetState(action, LivingAction::Index::Top), VillagerStates::DecideWhatToDo);
+	ASSERT_EQ(action.turnsSinceStateChange, 0);
+}
@@ -0,0 +1,139 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include <Log.h>
+#include <gtest/gtest.h>
+#include <spdlog/sinks/ostream_sink.h>
+
+using namespace openblack;
+using namespace std::chrono_literals;
+
+namespace
+{
+size_t CountLines(const std::string& text)
+{
+	return static_cast<size_t>(std::count(text.begin(), text.end(), '\n'));
+}
+
+void LogRepeatedError(spdlog::logger* logger, int turn)
+{
+	OPENBLACK_LOG_RATE_LIMITED(logger, spdlog::level::err, "Repeated error on turn {}", turn);
+}
+} // namespace
+
+TEST(TestLogging, RateLimiter)
+{
+	LogRateLimiter limiter(1s);
+	const auto start = LogRateLimiter::Clock::now();
+
+	ASSERT_EQ(limiter.Allow(start), 0);
+	ASSERT_FALSE(limiter.Allow(start + 100ms).has_value());
+	ASSERT_FALSE(limiter.Allow(start + 999ms).has_value());
+	ASSERT_EQ(limiter.Allow(start + 1s), 2);
+	ASSERT_FALSE(limiter.Allow(start + 1500ms).has_value());
+	ASSERT_EQ(limiter.Allow(start + 5s), 1);
+	ASSERT_EQ(limiter.Allow(start + 7s), 0);
+}
+
+TEST(TestLogging, RateLimitedCallSite)
+{
+	std::ostringstream output;
+	auto logger = std::make_shared<spdlog::logger>("rate-limited", std::make_shared<spdlog::sinks::ostream_sink_mt>(output));
+
+	for (int turn = 0; turn < 1000; ++turn)
+	{
+		LogRepeatedError(logger.get(), turn);
+	}
+	ASSERT_EQ(CountLines(output.str()), 1);
+	ASSERT_NE(output.str().find("Repeated error on turn 0"), std::string::npos);
+
+	// Messages below the level of the logger do not count as suppressed
+	logger->set_level(spdlog::level::critical);
+	LogRepeatedError(logger.get(), 1000);
+	ASSERT_EQ(CountLines(output.str()), 1);
+}
+
+TEST(TestLogging, CachedLoggers)
+{
+	const auto logFile = std::filesystem::temp_directory_path() / "openblack_test_logging.log";
+	LoggingLevels levels;
+	levels.fill(spdlog::level::info);
+	levels.at(static_cast<size_t>(LoggingSubsystem::scripting)) = spdlog::level::err;
+	InitializeLoggers(logFile.string(), levels, false);
+
+	auto* scripting = GetLogger(LoggingSubsystem::scripting);
+	ASSERT_NE(scripting, nullptr);
+	ASSERT_EQ(scripting, spdlog::get("scripting").get());
+	ASSERT_EQ(scripting->level(), spdlog::level::err);
+	// All subsystems share the same sink so the file is only opened once
+	ASSERT_EQ(scripting->sinks().front(), GetLogger(LoggingSubsystem::game)->sinks().front());
+
+	ShutDownLoggers();
+	ASSERT_EQ(GetLogger(LoggingSubsystem::scripting), nullptr);
+	std::filesystem::remove(logFile);
+}
+
+/// Cost of the logging done in a turn where scripts poll unimplemented natives and systems log filtered debug messages
+TEST(TestLogging, TurnCostBenchmark)
+{
+	constexpr int k_Turns = 100;
+	constexpr int k_CallsPerTurn = 2000;
+	const auto logFile = std::filesystem::temp_directory_path() / "openblack_test_logging_benchmark.log";
+
+	for (const auto async : {false, true})
+	{
+		LoggingLevels levels;
+		levels.fill(spdlog::level::info);
+		InitializeLoggers(logFile.string(), levels, async);
+
+		const auto measure = [](auto&& logCall) {
+			const auto start = std::chrono::steady_clock::now();
+			for (int turn = 0; turn < k_Turns; ++turn)
+			{
+				for (int call = 0; call < k_CallsPerTurn; ++call)
+				{
+					logCall(turn, call);
+				}
+			}
+			const auto elapsed = std::chrono::steady_clock::now() - start;
+			return static_cast<int>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / k_Turns);
+		};
+
+		const auto lookup = measure([](int turn, int call) {
+			SPDLOG_LOGGER_CALL(spdlog::get("scripting"), spdlog::level::debug, "Filtered message {} {}", turn, call);
+		});
+		const auto cached = measure([](int turn, int call) {
+			SPDLOG_LOGGER_CALL(GetLogger(LoggingSubsystem::scripting), spdlog::level::debug, "Filtered message {} {}", turn,
+			                   call);
+		});
+		const auto unlimited = measure([](int turn, int call) {
+			SPDLOG_LOGGER_ERROR(GetLogger(LoggingSubsystem::scripting), "Not implemented {} {}", turn, call);
+		});
+		const auto rateLimited = measure([](int turn, int call) {
+			OPENBLACK_LOG_RATE_LIMITED(GetLogger(LoggingSubsystem::scripting), spdlog::level::err, "Not implemented {} {}",
+			                           turn, call);
+		});
+
+		ShutDownLoggers();
+
+		const std::string mode = async ? "async_" : "sync_";
+		RecordProperty(mode + "lookup_ns_per_turn", lookup);
+		RecordProperty(mode + "cached_ns_per_turn", cached);
+		RecordProperty(mode + "unlimited_ns_per_turn", unlimited);
+		RecordProperty(mode + "rate_limited_ns_per_turn", rateLimited);
+	}
+	std::filesystem::remove(logFile);
+}
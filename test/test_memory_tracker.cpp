@@ -0,0 +1,109 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <cstdint>
+#include <cstring>
+
+#include <memory>
+#include <thread>
+
+#include <Common/MemoryTracker.h>
+#include <gtest/gtest.h>
+
+using namespace openblack;
+
+namespace
+{
+const MemoryTracker::Counters& GetCounters(const MemoryTracker::Snapshot& snapshot, MemoryTag tag)
+{
+	return snapshot[static_cast<size_t>(tag)];
+}
+} // namespace
+
+TEST(TestMemoryTracker, Scopes)
+{
+	ASSERT_EQ(MemoryTracker::GetTag(), MemoryTag::Untagged);
+	{
+		const MemoryTracker::Scope terrain(MemoryTag::Terrain);
+		ASSERT_EQ(MemoryTracker::GetTag(), MemoryTag::Terrain);
+		{
+			const MemoryTracker::Scope physics(MemoryTag::Physics);
+			ASSERT_EQ(MemoryTracker::GetTag(), MemoryTag::Physics);
+		}
+		ASSERT_EQ(MemoryTracker::GetTag(), MemoryTag::Terrain);
+
+		// The tag belongs to the thread which opened the scope
+		MemoryTag otherTag = MemoryTag::_count;
+		std::thread([&otherTag]() { otherTag = MemoryTracker::GetTag(); }).join();
+		ASSERT_EQ(otherTag, MemoryTag::Untagged);
+	}
+	ASSERT_EQ(MemoryTracker::GetTag(), MemoryTag::Untagged);
+}
+
+TEST(TestMemoryTracker, Allocate)
+{
+	const auto before = MemoryTracker::GetSnapshot();
+
+	auto* pointer = static_cast<uint8_t*>(MemoryTracker::Allocate(100, 64, MemoryTag::Audio));
+	ASSERT_NE(pointer, nullptr);
+	ASSERT_EQ(reinterpret_cast<uintptr_t>(pointer) % 64, 0);
+	std::memset(pointer, 0xAB, 100);
+
+	pointer = static_cast<uint8_t*>(MemoryTracker::Reallocate(pointer, 300, 64, MemoryTag::Audio));
+	ASSERT_NE(pointer, nullptr);
+	ASSERT_EQ(reinterpret_cast<uintptr_t>(pointer) % 64, 0);
+	ASSERT_EQ(pointer[0], 0xAB);
+	ASSERT_EQ(pointer[99], 0xAB);
+	MemoryTracker::Free(pointer);
+
+	const auto difference = MemoryTracker::GetDifference(MemoryTracker::GetSnapshot(), before);
+	const auto& audio = GetCounters(difference, MemoryTag::Audio);
+	ASSERT_EQ(audio.allocations, 2);
+	ASSERT_EQ(audio.allocatedBytes, 400);
+	ASSERT_EQ(audio.frees, 2);
+	ASSERT_EQ(audio.freedBytes, 400);
+	ASSERT_EQ(audio.GetLiveBytes(), 0);
+
+	const auto total = MemoryTracker::GetTotal(difference);
+	ASSERT_GE(total.allocations, audio.allocations);
+	ASSERT_GE(total.allocatedBytes, audio.allocatedBytes);
+}
+
+TEST(TestMemoryTracker, FreeCountsAgainstAllocationTag)
+{
+	const auto before = MemoryTracker::GetSnapshot();
+	auto* pointer = MemoryTracker::Allocate(32, 0, MemoryTag::Scripting);
+	{
+		const MemoryTracker::Scope audio(MemoryTag::Audio);
+		MemoryTracker::Free(pointer);
+	}
+
+	const auto difference = MemoryTracker::GetDifference(MemoryTracker::GetSnapshot(), before);
+	ASSERT_EQ(GetCounters(difference, MemoryTag::Scripting).frees, 1);
+	ASSERT_EQ(GetCounters(difference, MemoryTag::Scripting).freedBytes, 32);
+}
+
+TEST(TestMemoryTracker, OperatorNew)
+{
+	if constexpr (!MemoryTracker::k_Enabled)
+	{
+		GTEST_SKIP() << "Built without OPENBLACK_TRACK_ALLOCATIONS";
+	}
+
+	const auto before = MemoryTracker::GetSnapshot();
+	{
+		const MemoryTracker::Scope graphics(MemoryTag::Graphics);
+		auto buffer = std::make_unique<uint8_t[]>(1000);
+		ASSERT_NE(buffer, nullptr);
+	}
+
+	const auto difference = MemoryTracker::GetDifference(MemoryTracker::GetSnapshot(), before);
+	ASSERT_GE(GetCounters(difference, MemoryTag::Graphics).allocatedBytes, 1000);
+	ASSERT_GE(GetCounters(difference, MemoryTag::Graphics).freedBytes, 1000);
+}
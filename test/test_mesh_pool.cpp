@@ -0,0 +1,107 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <cstdint>
+
+#include <memory>
+
+#include <Graphics/MeshPool.h>
+#include <bgfx/bgfx.h>
+#include <gtest/gtest.h>
+
+using namespace openblack::graphics;
+
+class TestMeshPool: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		bgfx::Init init {};
+		init.type = bgfx::RendererType::Noop;
+		ASSERT_TRUE(bgfx::init(init));
+		_pool = std::make_unique<MeshPool>(
+		    "TestMeshPool", VertexDecl {{VertexAttrib::Attribute::Position, 3, VertexAttrib::Type::Float}}, 100, 300);
+	}
+
+	void TearDown() override
+	{
+		_pool.reset();
+		bgfx::shutdown();
+	}
+
+	MeshPool::Allocation Allocate(uint32_t vertexCount, uint32_t indexCount)
+	{
+		auto allocation = _pool->Allocate(bgfx::alloc(vertexCount * _pool->GetStrideBytes()),
+		                                  bgfx::alloc(indexCount * static_cast<uint32_t>(sizeof(uint16_t))));
+		EXPECT_TRUE(allocation.has_value());
+		return allocation.value_or(MeshPool::Allocation {});
+	}
+
+	std::unique_ptr<MeshPool> _pool;
+};
+
+TEST_F(TestMeshPool, freedSpaceIsReused)
+{
+	const auto first = Allocate(40, 120);
+	const auto second = Allocate(40, 120);
+	ASSERT_EQ(second.page, first.page);
+	ASSERT_EQ(second.vertexOffset, 40);
+	ASSERT_EQ(second.indexOffset, 120);
+	ASSERT_EQ(_pool->GetSizeInBytes(second), 40 * _pool->GetStrideBytes() + 120 * sizeof(uint16_t));
+
+	_pool->Free(first);
+	const auto third = Allocate(30, 90);
+	ASSERT_EQ(third.page, first.page);
+	ASSERT_EQ(third.vertexOffset, 0);
+	ASSERT_EQ(third.indexOffset, 0);
+
+	const auto stats = _pool->GetStats();
+	ASSERT_EQ(stats.pageCount, 1);
+	ASSERT_EQ(stats.allocationCount, 2);
+	ASSERT_EQ(stats.vertexCount, 70);
+	ASSERT_EQ(stats.indexCount, 210);
+}
+
+TEST_F(TestMeshPool, adjacentFreeRangesAreMerged)
+{
+	const auto first = Allocate(30, 90);
+	const auto second = Allocate(30, 90);
+	const auto third = Allocate(30, 90);
+
+	// Neither range alone fits 60 vertices, both together do
+	_pool->Free(second);
+	_pool->Free(first);
+	const auto merged = Allocate(60, 180);
+	ASSERT_EQ(merged.page, third.page);
+	ASSERT_EQ(merged.vertexOffset, 0);
+	ASSERT_EQ(merged.indexOffset, 0);
+	ASSERT_EQ(_pool->GetStats().pageCount, 1);
+}
+
+TEST_F(TestMeshPool, emptyPagesAreDestroyed)
+{
+	const auto first = Allocate(60, 180);
+	const auto second = Allocate(60, 180);
+	ASSERT_NE(second.page, first.page);
+	ASSERT_EQ(_pool->GetStats().pageCount, 2);
+
+	// Loading and unloading the same meshes over and over does not grow the pool
+	for (int i = 0; i < 10; ++i)
+	{
+		_pool->Free(Allocate(60, 180));
+	}
+	ASSERT_EQ(_pool->GetStats().pageCount, 2);
+
+	_pool->Free(first);
+	_pool->Free(second);
+	const auto stats = _pool->GetStats();
+	ASSERT_EQ(stats.pageCount, 0);
+	ASSERT_EQ(stats.allocationCount, 0);
+	ASSERT_EQ(stats.vertexCapacity, 0);
+}
@@ -0,0 +1,265 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <filesystem>
+#include <map>
+#include <set>
+#include <tuple>
+#include <vector>
+
+#include <ECS/Archetypes/FeatureArchetype.h>
+#include <ECS/Components/Abode.h>
+#include <ECS/Components/Footpath.h>
+#include <ECS/Components/LivingAction.h>
+#include <ECS/Components/Mesh.h>
+#include <ECS/Components/RigidBody.h>
+#include <ECS/Components/Stream.h>
+#include <ECS/Components/Town.h>
+#include <ECS/Components/Transform.h>
+#include <ECS/Components/Villager.h>
+#include <ECS/Components/WallHug.h>
+#include <ECS/Registry.h>
+#include <ECS/RoutePlanner.h>
+#include <ECS/Systems/PathfindingSystemInterface.h>
+#include <ECS/Systems/SpatialQuerySystemInterface.h>
+#include <FileSystem/FileSystemInterface.h>
+#include <Game.h>
+#include <InfoConstants.h>
+#include <L3DCookedFile.h>
+#include <L3DFile.h>
+#include <Locator.h>
+#include <Resources/ResourcesInterface.h>
+#include <bgfx/bgfx.h>
+#include <gtest/gtest.h>
+
+using namespace openblack;
+using namespace openblack::ecs::components;
+
+namespace
+{
+/// Comparable copy of the parts of the registry a level script creates
+struct RegistryDigest
+{
+	std::map<entt::entity, std::tuple<glm::vec3, glm::mat3, glm::vec3>> transforms;
+	std::map<entt::entity, entt::id_type> meshes;
+	std::map<entt::entity, std::tuple<uint32_t, uint32_t, entt::entity, entt::entity, VillagerNumber>> villagers;
+	std::map<entt::entity, std::tuple<uint8_t, uint16_t, uint16_t>> livingActions;
+	std::map<entt::entity, std::tuple<AbodeNumber, uint32_t, std::set<entt::entity>>> abodes;
+	std::map<entt::entity,
+	         std::tuple<uint32_t, PlayerNames, std::set<entt::entity>, std::set<entt::entity>, std::set<entt::entity>>>
+	    towns;
+	std::map<entt::entity, std::vector<glm::vec3>> footpaths;
+	std::map<entt::entity, size_t> streams;
+	std::map<uint32_t, entt::entity> contextTowns;
+	std::map<Footpath::Id, entt::entity> contextFootpaths;
+
+	bool operator==(const RegistryDigest&) const = default;
+};
+
+RegistryDigest Digest(ecs::Registry& registry)
+{
+	RegistryDigest digest;
+	registry.Each<const Transform>([&digest](entt::entity entity, const Transform& transform) {
+		digest.transforms.emplace(entity, std::make_tuple(transform.position, transform.rotation, transform.scale));
+	});
+	registry.Each<const Mesh>([&digest](entt::entity entity, const Mesh& mesh) { digest.meshes.emplace(entity, mesh.id); });
+	registry.Each<const Villager>([&digest](entt::entity entity, const Villager& villager) {
+		digest.villagers.emplace(
+		    entity, std::make_tuple(villager.age, villager.health, villager.town, villager.abode, villager.number));
+	});
+	registry.Each<const LivingAction>([&digest](entt::entity entity, const LivingAction& action) {
+		digest.livingActions.emplace(
+		    entity, std::make_tuple(action.states[0], action.turnsUntilStateChange, action.turnsSinceStateChange));
+	});
+	registry.Each<const Abode>([&digest](entt::entity entity, const Abode& abode) {
+		digest.abodes.emplace(entity, std::make_tuple(abode.type, abode.townId, abode.inhabitants));
+	});
+	registry.Each<const Town>([&digest](entt::entity entity, const Town& town) {
+		digest.towns.emplace(entity, std::make_tuple(town.id, town.owner, town.homelessVillagers, town.abodes,
+		                                             town.abodesWithVacancy));
+	});
+	registry.Each<const Footpath>([&digest](entt::entity entity, const Footpath& footpath) {
+		auto& nodes = digest.footpaths[entity];
+		for (const auto& node : footpath.nodes)
+		{
+			nodes.push_back(node.position);
+		}
+	});
+	registry.Each<const Stream>(
+	    [&digest](entt::entity entity, const Stream& stream) { digest.streams.emplace(entity, stream.nodes.size()); });
+	const auto& context = registry.Context();
+	digest.contextTowns.insert(context.towns.begin(), context.towns.end());
+	digest.contextFootpaths.insert(context.footpaths.begin(), context.footpaths.end());
+	return digest;
+}
+} // namespace
+
+class RegistrySnapshot: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		static const auto mockGamePath = std::filesystem::path(TEST_BINARY_DIR) / "mock";
+		auto args = openblack::Arguments {
+		    .rendererType = bgfx::RendererType::Enum::Noop,
+		    .gamePath = mockGamePath.string(),
+		    .numFramesToSimulate = 0,
+		    .logFile = "stdout",
+		    .startLevel = "Land1.txt",
+		};
+		std::fill_n(args.logLevels.begin(), args.logLevels.size(), spdlog::level::warn);
+		_game = std::make_unique<openblack::Game>(std::move(args));
+		ASSERT_TRUE(_game->Initialize());
+	}
+
+	void TearDown() override { _game.reset(); }
+
+	std::unique_ptr<openblack::Game> _game;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(RegistrySnapshot, roundTripMatchesScriptLoad)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	const auto expected = Digest(registry);
+	ASSERT_FALSE(expected.transforms.empty());
+
+	const auto snapshot = registry.SaveSnapshot();
+	registry.Reset();
+	ASSERT_TRUE(Digest(registry).transforms.empty());
+
+	ASSERT_TRUE(registry.LoadSnapshot(snapshot));
+	const auto actual = Digest(registry);
+	ASSERT_EQ(actual.transforms, expected.transforms);
+	ASSERT_EQ(actual.meshes, expected.meshes);
+	ASSERT_EQ(actual.villagers, expected.villagers);
+	ASSERT_EQ(actual.livingActions, expected.livingActions);
+	ASSERT_EQ(actual.abodes, expected.abodes);
+	ASSERT_EQ(actual.towns, expected.towns);
+	ASSERT_EQ(actual.footpaths, expected.footpaths);
+	ASSERT_EQ(actual.streams, expected.streams);
+	ASSERT_EQ(actual.contextTowns, expected.contextTowns);
+	ASSERT_EQ(actual.contextFootpaths, expected.contextFootpaths);
+
+	// Saving what was loaded gives back the same amount of data
+	ASSERT_EQ(registry.SaveSnapshot().size(), snapshot.size());
+
+	// New entities must not reuse identifiers of restored ones
+	const auto entity = registry.Create();
+	ASSERT_FALSE(expected.transforms.contains(entity));
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(RegistrySnapshot, restartMatchesScriptLoad)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	const auto expected = Digest(registry);
+
+	// Disturb the level so that restarting has something to undo
+	registry.Each<Transform>([](Transform& transform) { transform.position += glm::vec3(1.0f); });
+	registry.Destroy(expected.transforms.begin()->first);
+
+	ASSERT_TRUE(_game->RestartLevel());
+	ASSERT_TRUE(Digest(registry) == expected);
+	ASSERT_EQ(_game->GetTurn(), 0);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(RegistrySnapshot, loadRebuildsRigidBodies)
+{
+	// The mock meshes have no physics, give a feature one which does
+	l3d::L3DFile l3d;
+	l3d::L3DSubmeshHeader header {};
+	header.flags.isPhysics = 1;
+	header.numPrimitives = 1;
+	l3d.AddSubmesh(header);
+	l3d::L3DPrimitiveHeader primitive {};
+	primitive.numVertices = 4;
+	primitive.numTriangles = 2;
+	l3d.AddPrimitives({primitive});
+	l3d.AddVertices({{{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}},
+	                 {{1.0f, 0.0f, 0.0f}, {1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}},
+	                 {{1.0f, 1.0f, 1.0f}, {1.0f, 1.0f}, {0.0f, 0.0f, 1.0f}},
+	                 {{0.0f, 1.0f, 1.0f}, {0.0f, 1.0f}, {0.0f, 0.0f, 1.0f}}});
+	l3d.AddIndices({0, 1, 2, 0, 2, 3});
+	l3d::L3DCookedFile cooked;
+	ASSERT_EQ(cooked.Cook(l3d, 0), l3d::L3DResult::Success);
+
+	const auto type = FeatureInfo::AztcOlmechead;
+	const auto meshId = resources::HashIdentifier(Locator::infoConstants::value().feature.at(static_cast<size_t>(type)).meshId);
+	auto& meshes = Locator::resources::value().GetMeshes();
+	meshes.Erase(meshId);
+	meshes.Load(meshId, resources::L3DLoader::FromCookedTag {}, "physics", cooked);
+	ASSERT_TRUE(meshes.Handle(meshId)->HasPhysicsMesh());
+
+	auto& registry = Locator::entitiesRegistry::value();
+	const auto feature = ecs::archetypes::FeatureArchetype::Create(glm::vec3(1.0f, 2.0f, 3.0f), type, 0.0f, 1.0f);
+	ASSERT_TRUE(registry.AllOf<RigidBody>(feature));
+	_game->QuickSave();
+
+	ASSERT_TRUE(_game->QuickLoad());
+	ASSERT_TRUE(registry.AllOf<RigidBody>(feature));
+	ASSERT_EQ(registry.Get<RigidBody>(feature).handle.getWorldTransform().getOrigin(), btVector3(1.0f, 2.0f, 3.0f));
+	ASSERT_TRUE(registry.Get<RigidBody>(feature).handle.isInWorld());
+
+	// Restarting drops the feature along with its body, loading the quick save brings both back
+	ASSERT_TRUE(_game->RestartLevel());
+	ASSERT_EQ(registry.Size<RigidBody>(), 0);
+	ASSERT_TRUE(_game->QuickLoad());
+	ASSERT_TRUE(registry.Get<RigidBody>(feature).handle.isInWorld());
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(RegistrySnapshot, rejectsIncompatibleSnapshots)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	const auto expected = Digest(registry);
+	auto snapshot = registry.SaveSnapshot();
+
+	// Unknown version leaves the registry untouched
+	auto wrongVersion = snapshot;
+	wrongVersion[4] ^= 0xFF;
+	ASSERT_FALSE(registry.LoadSnapshot(wrongVersion));
+	ASSERT_TRUE(Digest(registry) == expected);
+
+	// Truncated data is detected before anything is replaced
+	snapshot.resize(snapshot.size() / 2);
+	ASSERT_FALSE(registry.LoadSnapshot(snapshot));
+	ASSERT_TRUE(Digest(registry) == expected);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(RegistrySnapshot, restoreResetsDerivedState)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	auto& pathfinding = Locator::pathfindingSystem::value();
+	auto& spatialQueries = Locator::spatialQuerySystem::value();
+	const auto findAll = [&spatialQueries] {
+		auto entities = spatialQueries.FindInBox(glm::vec2(-1e6f), glm::vec2(1e6f), {});
+		std::ranges::sort(entities);
+		return entities;
+	};
+	const auto expected = findAll();
+	ASSERT_EQ(expected.size(), registry.Size<Transform>());
+
+	// Plan a route so that the planner is built from the level
+	const auto villager = registry.Front<const Villager, const WallHug>();
+	ASSERT_NE(villager, entt::null);
+	const auto& position = registry.Get<const Transform>(villager).position;
+	pathfinding.MoveTo(villager, glm::vec2(position.x + 100.0f, position.z));
+	ASSERT_TRUE(pathfinding.GetRoutePlanner().IsBuilt());
+
+	registry.Destroy(villager);
+	ASSERT_EQ(findAll().size(), expected.size() - 1);
+
+	ASSERT_TRUE(_game->RestartLevel());
+	ASSERT_FALSE(pathfinding.GetRoutePlanner().IsBuilt());
+	ASSERT_EQ(findAll(), expected);
+}
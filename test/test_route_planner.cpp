@@ -0,0 +1,120 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <vector>
+
+#include <ECS/Components/Fixed.h>
+#include <ECS/Components/Footpath.h>
+#include <ECS/Components/Stream.h>
+#include <ECS/Registry.h>
+#include <ECS/RoutePlanner.h>
+#include <gtest/gtest.h>
+
+using namespace openblack;
+using namespace openblack::ecs::components;
+
+namespace
+{
+entt::entity CreateFootpath(ecs::Registry& registry, const std::vector<glm::vec2>& points)
+{
+	const auto entity = registry.Create();
+	auto& footpath = registry.Assign<Footpath>(entity);
+	for (const auto& point : points)
+	{
+		footpath.nodes.push_back({glm::vec3(point.x, 0.0f, point.y)});
+	}
+	return entity;
+}
+
+/// Wall of obstacles along x = 200 with a footpath going around it from one side to the other
+void CreateWall(ecs::Registry& registry)
+{
+	for (float y = 20.0f; y < 470.0f; y += 20.0f)
+	{
+		registry.Assign<Fixed>(registry.Create(), glm::vec2(200.0f, y), 12.0f);
+	}
+	const auto west = CreateFootpath(registry, {{150.0f, 100.0f}, {150.0f, 300.0f}, {150.0f, 490.0f}, {195.0f, 490.0f}});
+	const auto east = CreateFootpath(registry, {{205.0f, 490.0f}, {250.0f, 490.0f}, {250.0f, 300.0f}, {250.0f, 100.0f}});
+	registry.Assign<FootpathLink>(registry.Create(), glm::vec3(200.0f, 0.0f, 490.0f),
+	                              std::vector<Footpath::Id> {static_cast<Footpath::Id>(west), static_cast<Footpath::Id>(east)});
+}
+} // namespace
+
+TEST(TestRoutePlanner, RouteAroundObstacles)
+{
+	ecs::Registry registry;
+	CreateWall(registry);
+
+	ecs::RoutePlanner planner;
+	planner.Build(registry);
+
+	const auto route = planner.FindRoute({100.0f, 100.0f}, {300.0f, 100.0f});
+	ASSERT_NE(route, nullptr);
+	ASSERT_EQ(route->waypoints.size(), 9);
+	ASSERT_EQ(route->waypoints.front(), glm::vec2(150.0f, 100.0f));
+	ASSERT_EQ(route->waypoints[4], glm::vec2(200.0f, 490.0f));
+	ASSERT_EQ(route->waypoints.back(), glm::vec2(250.0f, 100.0f));
+
+	const auto stats = planner.GetStats();
+	ASSERT_EQ(stats.nodes, 9);
+	ASSERT_EQ(stats.edges, 8);
+	ASSERT_EQ(stats.obstacles, 23);
+}
+
+TEST(TestRoutePlanner, RoutesAreSharedWithinRegions)
+{
+	ecs::Registry registry;
+	CreateWall(registry);
+
+	ecs::RoutePlanner planner;
+	planner.Build(registry);
+
+	const auto first = planner.FindRoute({100.0f, 100.0f}, {300.0f, 100.0f});
+	const auto second = planner.FindRoute({110.0f, 90.0f}, {310.0f, 120.0f});
+	ASSERT_NE(first, nullptr);
+	ASSERT_EQ(first, second);
+	ASSERT_EQ(planner.GetStats().hits, 1);
+	ASSERT_EQ(planner.GetStats().misses, 1);
+
+	planner.Invalidate();
+	ASSERT_FALSE(planner.IsBuilt());
+	ASSERT_EQ(planner.FindRoute({100.0f, 100.0f}, {300.0f, 100.0f}), nullptr);
+	ASSERT_EQ(planner.GetStats().cachedRoutes, 0);
+}
+
+TEST(TestRoutePlanner, NoRouteWhenWalkable)
+{
+	ecs::Registry registry;
+	CreateWall(registry);
+
+	ecs::RoutePlanner planner;
+	planner.Build(registry);
+
+	ASSERT_EQ(planner.FindRoute({100.0f, 100.0f}, {100.0f, 400.0f}), nullptr);
+	ASSERT_EQ(planner.FindRoute({100.0f, 100.0f}, {120.0f, 110.0f}), nullptr);
+}
+
+TEST(TestRoutePlanner, StreamsAreCrossedOnFootpaths)
+{
+	ecs::Registry registry;
+	auto& stream = registry.Assign<Stream>(registry.Create());
+	for (const auto x : {0.0f, 90.0f, 180.0f, 270.0f})
+	{
+		const auto previous = stream.nodes;
+		stream.nodes.emplace_back(glm::vec3(x, 0.0f, 180.0f), previous);
+	}
+	CreateFootpath(registry, {{140.0f, 120.0f}, {140.0f, 240.0f}});
+
+	ecs::RoutePlanner planner;
+	planner.Build(registry);
+
+	const auto route = planner.FindRoute({100.0f, 100.0f}, {100.0f, 260.0f});
+	ASSERT_NE(route, nullptr);
+	ASSERT_EQ(route->waypoints, (std::vector<glm::vec2> {{140.0f, 120.0f}, {140.0f, 240.0f}}));
+}
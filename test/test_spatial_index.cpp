@@ -0,0 +1,156 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <ECS/SpatialIndex.h>
+#include <gtest/gtest.h>
+
+using namespace openblack;
+
+namespace
+{
+ecs::SpatialIndex::Object MakeObject(uint32_t id, const glm::vec2& position,
+                                     script::ObjectType type = script::ObjectType::Villager, int32_t subtype = 0)
+{
+	return {static_cast<entt::entity>(id), position, type, subtype, std::nullopt, false};
+}
+
+std::vector<entt::entity> Entities(std::initializer_list<uint32_t> ids)
+{
+	std::vector<entt::entity> result;
+	for (const auto id : ids)
+	{
+		result.push_back(static_cast<entt::entity>(id));
+	}
+	return result;
+}
+
+std::vector<entt::entity> Sorted(std::vector<entt::entity> entities)
+{
+	std::sort(entities.begin(), entities.end());
+	return entities;
+}
+} // namespace
+
+TEST(TestSpatialIndex, RadiusAnnulusAndBox)
+{
+	ecs::SpatialIndex index;
+	index.Set(MakeObject(1, {100.0f, 100.0f}));
+	index.Set(MakeObject(2, {130.0f, 100.0f}));
+	index.Set(MakeObject(3, {200.0f, 100.0f}));
+	index.Set(MakeObject(4, {100.0f, 300.0f}));
+
+	ASSERT_EQ(Sorted(index.FindInRadius({100.0f, 100.0f}, 50.0f, {})), Entities({1, 2}));
+	ASSERT_EQ(Sorted(index.FindInAnnulus({100.0f, 100.0f}, 50.0f, 250.0f, {})), Entities({3, 4}));
+	ASSERT_EQ(Sorted(index.FindInBox({90.0f, 90.0f}, {210.0f, 110.0f}, {})), Entities({1, 2, 3}));
+}
+
+TEST(TestSpatialIndex, Filters)
+{
+	ecs::SpatialIndex index;
+	index.Set(MakeObject(1, {100.0f, 100.0f}, script::ObjectType::Villager, 2));
+	index.Set(MakeObject(2, {110.0f, 100.0f}, script::ObjectType::Villager, 3));
+	index.Set(MakeObject(3, {120.0f, 100.0f}, script::ObjectType::Abode, 2));
+	auto town = MakeObject(4, {130.0f, 100.0f}, script::ObjectType::Town);
+	town.owner = PlayerNames::PLAYER_TWO;
+	index.Set(town);
+	auto scripted = MakeObject(5, {140.0f, 100.0f}, script::ObjectType::Villager, 2);
+	scripted.scripted = true;
+	index.Set(scripted);
+
+	const glm::vec2 center {100.0f, 100.0f};
+	ecs::SpatialQueryFilter filter;
+	filter.type = script::ObjectType::Villager;
+	ASSERT_EQ(Sorted(index.FindInRadius(center, 100.0f, filter)), Entities({1, 2, 5}));
+	filter.subtype = 2;
+	ASSERT_EQ(Sorted(index.FindInRadius(center, 100.0f, filter)), Entities({1, 5}));
+	filter.excludeScripted = true;
+	ASSERT_EQ(index.FindInRadius(center, 100.0f, filter), Entities({1}));
+
+	ecs::SpatialQueryFilter owned;
+	owned.owner = PlayerNames::PLAYER_TWO;
+	ASSERT_EQ(index.FindInRadius(center, 100.0f, owned), Entities({4}));
+	owned.owner = PlayerNames::PLAYER_ONE;
+	ASSERT_TRUE(index.FindInRadius(center, 100.0f, owned).empty());
+
+	ecs::SpatialQueryFilter predicate;
+	predicate.predicate = [](entt::entity entity) { return entity == static_cast<entt::entity>(3); };
+	ASSERT_EQ(index.FindInRadius(center, 100.0f, predicate), Entities({3}));
+}
+
+TEST(TestSpatialIndex, MoveAndRemove)
+{
+	ecs::SpatialIndex index;
+	for (uint32_t i = 0; i < 10; ++i)
+	{
+		index.Set(MakeObject(i, {100.0f + static_cast<float>(i), 100.0f}));
+	}
+
+	index.Move(static_cast<entt::entity>(3), {1000.0f, 1000.0f});
+	index.Remove(static_cast<entt::entity>(0));
+	index.Remove(static_cast<entt::entity>(7));
+	index.Remove(static_cast<entt::entity>(42));
+	ASSERT_EQ(index.Size(), 8);
+	ASSERT_EQ(index.Find(static_cast<entt::entity>(0)), nullptr);
+	ASSERT_EQ(index.Find(static_cast<entt::entity>(9))->position, glm::vec2(109.0f, 100.0f));
+
+	ASSERT_EQ(Sorted(index.FindInRadius({100.0f, 100.0f}, 20.0f, {})), Entities({1, 2, 4, 5, 6, 8, 9}));
+	ASSERT_EQ(index.FindInRadius({1000.0f, 1000.0f}, 1.0f, {}), Entities({3}));
+
+	// Replacing an object keeps a single entry for its entity
+	index.Set(MakeObject(9, {1000.0f, 1001.0f}, script::ObjectType::Abode));
+	ASSERT_EQ(index.Size(), 8);
+	ASSERT_EQ(Sorted(index.FindInRadius({1000.0f, 1000.0f}, 2.0f, {})), Entities({3, 9}));
+}
+
+TEST(TestSpatialIndex, NearestMatchesBruteForce)
+{
+	std::mt19937 random(7);
+	std::uniform_real_distribution<float> coordinate(-100.0f, 5200.0f);
+	ecs::SpatialIndex index;
+	std::vector<ecs::SpatialIndex::Object> objects;
+	for (uint32_t i = 0; i < 2000; ++i)
+	{
+		objects.push_back(MakeObject(i, {coordinate(random), coordinate(random)},
+		                             i % 3 == 0 ? script::ObjectType::Abode : script::ObjectType::Villager));
+		index.Set(objects.back());
+	}
+
+	ecs::SpatialQueryFilter abodes;
+	abodes.type = script::ObjectType::Abode;
+	for (int query = 0; query < 100; ++query)
+	{
+		const glm::vec2 center {coordinate(random), coordinate(random)};
+		const auto minRadius = query % 2 == 0 ? 0.0f : 300.0f;
+		const auto maxRadius = query % 4 < 2 ? 2000.0f : std::numeric_limits<float>::infinity();
+		const auto result = index.FindNearest(center, 5, abodes, minRadius, maxRadius);
+
+		std::vector<std::pair<float, entt::entity>> expected;
+		for (const auto& object : objects)
+		{
+			const auto distance2 = glm::distance2(center, object.position);
+			if (object.type == script::ObjectType::Abode && distance2 >= minRadius * minRadius &&
+			    distance2 <= maxRadius * maxRadius)
+			{
+				expected.emplace_back(distance2, object.entity);
+			}
+		}
+		std::sort(expected.begin(), expected.end());
+		expected.resize(std::min<size_t>(expected.size(), 5));
+
+		ASSERT_EQ(result.size(), expected.size());
+		for (size_t i = 0; i < result.size(); ++i)
+		{
+			ASSERT_EQ(result[i], expected[i].second) << "query " << query << " rank " << i;
+		}
+	}
+}
@@ -0,0 +1,166 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Graphics/MipChain.h>
+#include <Graphics/Texture2D.h>
+#include <Graphics/TextureResidency.h>
+#include <bgfx/bgfx.h>
+#include <gtest/gtest.h>
+
+using namespace openblack::graphics;
+
+namespace
+{
+std::unique_ptr<Texture2D> CreateTexture(const std::string& name, uint16_t size)
+{
+	const std::vector<uint8_t> pixels(static_cast<size_t>(size) * size * 4, 0x80);
+	auto texture = std::make_unique<Texture2D>(name);
+	texture->Create(Wrapping::Repeat, Filter::Linear,
+	                std::make_unique<MipChain>(MipChain::Generate(size, size, Format::RGBA8, pixels)));
+	return texture;
+}
+
+void Draw(const std::vector<std::unique_ptr<Texture2D>>& textures, std::initializer_list<size_t> used)
+{
+	for (const auto i : used)
+	{
+		textures[i]->MarkUsed();
+	}
+}
+} // namespace
+
+class TestTextureResidency: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		bgfx::Init init {};
+		init.type = bgfx::RendererType::Noop;
+		ASSERT_TRUE(bgfx::init(init));
+	}
+
+	void TearDown() override { bgfx::shutdown(); }
+};
+
+TEST(TestMipChain, Generate)
+{
+	// 4x2 RGB8, each texel of the first level is its index in every channel
+	std::vector<uint8_t> pixels;
+	for (uint8_t i = 0; i < 8; ++i)
+	{
+		pixels.insert(pixels.end(), {i, i, i});
+	}
+	const auto chain = MipChain::Generate(4, 2, Format::RGB8, pixels);
+
+	ASSERT_EQ(chain.GetLevelCount(), 3);
+	ASSERT_EQ(chain.GetWidth(1), 2);
+	ASSERT_EQ(chain.GetHeight(1), 1);
+	ASSERT_EQ(chain.GetSize(), 24 + 6 + 3);
+	ASSERT_EQ(chain.GetSize(1), 6 + 3);
+	const auto levels = chain.GetLevels(1);
+	// (0 + 1 + 4 + 5) / 4 and (2 + 3 + 6 + 7) / 4, rounded
+	ASSERT_EQ(levels[0], 3);
+	ASSERT_EQ(levels[3], 5);
+	// (3 + 5) / 2, the single row is sampled twice
+	ASSERT_EQ(levels[6], 4);
+
+	ASSERT_EQ(MipChain::CountLevels(40, 40), 6);
+	ASSERT_EQ(MipChain::CountLevels(1024, 6), 11);
+	ASSERT_THROW(MipChain::Generate(4, 4, Format::BlockCompression1, pixels), std::runtime_error);
+}
+
+TEST(TestMipChain, StoredLevels)
+{
+	// BC1 is 8 bytes per 4x4 block, levels smaller than a block still take one
+	const std::vector<uint8_t> data(32 + 8 + 8 + 8);
+	const MipChain complete(8, 8, Format::BlockCompression1, data, 4);
+	ASSERT_EQ(complete.GetLevelCount(), 4);
+	ASSERT_EQ(complete.GetSize(2), 16);
+
+	const MipChain partial(8, 8, Format::BlockCompression1, data, 2);
+	ASSERT_EQ(partial.GetLevelCount(), 1);
+	ASSERT_EQ(partial.GetSize(), 32);
+
+	ASSERT_THROW(MipChain(8, 8, Format::BlockCompression1, std::vector<uint8_t>(16), 1), std::runtime_error);
+}
+
+TEST_F(TestTextureResidency, DropAndRestore)
+{
+	std::vector<std::unique_ptr<Texture2D>> textures;
+	std::vector<Texture2D*> pointers;
+	for (int i = 0; i < 4; ++i)
+	{
+		textures.push_back(CreateTexture("texture" + std::to_string(i), 256));
+		pointers.push_back(textures.back().get());
+	}
+	const uint64_t fullSize = textures[0]->GetMipChain()->GetSize();
+	ASSERT_EQ(textures[0]->GetSize(), fullSize);
+	ASSERT_EQ(textures[0]->GetMipCount(), 9);
+
+	TextureResidency residency;
+	uint64_t budget = fullSize * 7 / 2;
+	residency.Update(pointers, budget);
+	ASSERT_EQ(residency.GetStats().residentSize, fullSize * 4);
+	ASSERT_EQ(residency.GetStats().droppedMips, 0);
+
+	// Texture 3 goes unused first, then texture 2
+	for (int i = 0; i < 10; ++i)
+	{
+		Draw(textures, {0, 1, 2});
+		residency.Update(pointers, budget);
+	}
+	for (uint32_t i = 11; i < TextureResidency::k_UnusedFrames; ++i)
+	{
+		Draw(textures, {0, 1});
+		residency.Update(pointers, budget);
+		ASSERT_EQ(residency.GetStats().droppedMips, 0);
+	}
+	Draw(textures, {0, 1});
+	residency.Update(pointers, budget);
+	ASSERT_EQ(textures[3]->GetFirstResidentMip(), 1);
+	ASSERT_EQ(textures[3]->GetWidth(), 128);
+	ASSERT_TRUE(bgfx::isValid(textures[3]->GetNativeHandle()));
+	ASSERT_EQ(textures[2]->GetFirstResidentMip(), 0);
+	ASSERT_LE(residency.GetStats().residentSize, budget);
+	ASSERT_EQ(residency.GetStats().fullSize, fullSize * 4);
+	ASSERT_EQ(residency.GetStats().reducedCount, 1);
+
+	// Once texture 2 is unused for long enough as well, the least recently used texture goes down to the smallest level
+	// allowed before the next one is reduced
+	budget = fullSize * 5 / 2;
+	for (int i = 0; i < 10; ++i)
+	{
+		Draw(textures, {0, 1});
+		residency.Update(pointers, budget);
+	}
+	ASSERT_EQ(textures[3]->GetWidth(), TextureResidency::k_MinDimension);
+	ASSERT_EQ(textures[2]->GetFirstResidentMip(), 1);
+	ASSERT_EQ(textures[0]->GetFirstResidentMip(), 0);
+	ASSERT_LE(residency.GetStats().residentSize, budget);
+
+	// A texture drawn again gets one level back per update while it fits
+	Draw(textures, {0, 1, 3});
+	residency.Update(pointers, budget);
+	ASSERT_EQ(textures[3]->GetWidth(), TextureResidency::k_MinDimension * 2);
+	budget = fullSize * 4;
+	for (int i = 0; i < 4; ++i)
+	{
+		Draw(textures, {0, 1, 2, 3});
+		residency.Update(pointers, budget);
+	}
+	ASSERT_EQ(textures[3]->GetFirstResidentMip(), 0);
+	ASSERT_EQ(textures[2]->GetFirstResidentMip(), 0);
+	ASSERT_EQ(residency.GetStats().residentSize, fullSize * 4);
+	ASSERT_EQ(residency.GetStats().reducedCount, 0);
+}
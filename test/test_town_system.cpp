@@ -0,0 +1,121 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <set>
+
+#include <ECS/Archetypes/AbodeArchetype.h>
+#include <ECS/Archetypes/TownArchetype.h>
+#include <ECS/Archetypes/VillagerArchetype.h>
+#include <ECS/Components/Abode.h>
+#include <ECS/Components/Town.h>
+#include <ECS/Components/Villager.h>
+#include <ECS/Registry.h>
+#include <ECS/Systems/TownSystemInterface.h>
+#include <Game.h>
+#include <InfoConstants.h>
+#include <InfoConstantsIndex.h>
+#include <Locator.h>
+#include <gtest/gtest.h>
+
+using namespace openblack;
+using namespace openblack::ecs::archetypes;
+using namespace openblack::ecs::components;
+
+class TownSystem: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		static const auto mockGamePath = std::filesystem::path(TEST_BINARY_DIR) / "mock";
+		auto args = Arguments {
+		    .rendererType = bgfx::RendererType::Enum::Noop,
+		    .gamePath = mockGamePath.string(),
+		    .numFramesToSimulate = 0,
+		    .logFile = "stdout",
+		};
+		std::fill_n(args.logLevels.begin(), args.logLevels.size(), spdlog::level::warn);
+		_game = std::make_unique<Game>(std::move(args));
+		ASSERT_TRUE(_game->Initialize());
+
+		// The mock abodes have no room for villagers
+		auto infoConstants = std::make_unique<InfoConstants>(Locator::infoConstants::value());
+		infoConstants->abode.at(static_cast<size_t>(AbodeInfo::CelticHut)).maxVillagersInAbode = 2;
+		Locator::infoConstants::reset(infoConstants.release());
+		Locator::infoConstantsIndex::emplace<InfoConstantsIndex>(Locator::infoConstants::value());
+	}
+	void TearDown() override { _game.reset(); }
+	std::unique_ptr<Game> _game;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TownSystem, villagersAreRecordedInTheirAbode)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	const glm::vec3 position(1000.0f, 0.0f, 1000.0f);
+	const auto town = TownArchetype::Create(0, position, PlayerNames::PLAYER_ONE, Tribe::CELTIC);
+	const auto abode = AbodeArchetype::Create(0, position, AbodeInfo::CelticHut, 0.0f, 1.0f, 0, 0);
+	ASSERT_TRUE(registry.Get<const Town>(town).abodes.contains(abode));
+	ASSERT_EQ(Locator::townSystem::value().FindAbodeWithSpace(town), abode);
+
+	const auto first = VillagerArchetype::Create(position, position, VillagerInfo::CelticHousewifeFemale, 20);
+	const auto second = VillagerArchetype::Create(position, position, VillagerInfo::CelticForesterMale, 20);
+	ASSERT_EQ(registry.Get<const Villager>(first).abode, abode);
+	ASSERT_EQ(registry.Get<const Villager>(second).abode, abode);
+	ASSERT_EQ(registry.Get<const Abode>(abode).inhabitants, (std::set {first, second}));
+
+	// The abode is full, the next villager is left without one
+	ASSERT_EQ(Locator::townSystem::value().FindAbodeWithSpace(town), entt::null);
+	const auto third = VillagerArchetype::Create(position, position, VillagerInfo::CelticFishermanMale, 20);
+	ASSERT_EQ(registry.Get<const Villager>(third).abode, entt::null);
+	ASSERT_EQ(registry.Get<const Villager>(third).town, town);
+
+	Locator::townSystem::value().RemoveVillagerFromAbode(abode, first);
+	ASSERT_EQ(registry.Get<const Villager>(first).abode, entt::null);
+	ASSERT_EQ(Locator::townSystem::value().FindAbodeWithSpace(town), abode);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TownSystem, destroyedAbodeLeavesItsTown)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	const glm::vec3 position(1000.0f, 0.0f, 1000.0f);
+	const auto town = TownArchetype::Create(0, position, PlayerNames::PLAYER_ONE, Tribe::CELTIC);
+	const auto abode = AbodeArchetype::Create(0, position, AbodeInfo::CelticHut, 0.0f, 1.0f, 0, 0);
+	const auto villager = VillagerArchetype::Create(position, position, VillagerInfo::CelticHousewifeFemale, 20);
+	ASSERT_EQ(registry.Get<const Villager>(villager).abode, abode);
+
+	registry.Destroy(abode);
+	const auto& component = registry.Get<const Town>(town);
+	ASSERT_FALSE(component.abodes.contains(abode));
+	ASSERT_FALSE(component.abodesWithVacancy.contains(abode));
+	ASSERT_EQ(Locator::townSystem::value().FindAbodeWithSpace(town), entt::null);
+	ASSERT_EQ(registry.Get<const Villager>(villager).abode, entt::null);
+	ASSERT_TRUE(component.homelessVillagers.contains(villager));
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TownSystem, closestTownUsesDistance)
+{
+	const glm::vec3 point(1000.0f, 0.0f, 1000.0f);
+	// The town with the same x as the point is not the closest one, and the one closest to the origin has the smallest
+	// dot product with it
+	const auto alongX = TownArchetype::Create(0, glm::vec3(1000.0f, 0.0f, 1300.0f), PlayerNames::PLAYER_ONE, Tribe::CELTIC);
+	const auto origin = TownArchetype::Create(1, glm::vec3(10.0f, 0.0f, 10.0f), PlayerNames::PLAYER_ONE, Tribe::CELTIC);
+	const auto closest = TownArchetype::Create(2, glm::vec3(1150.0f, 0.0f, 1100.0f), PlayerNames::PLAYER_ONE, Tribe::CELTIC);
+	const auto east = TownArchetype::Create(3, glm::vec3(3000.0f, 0.0f, 900.0f), PlayerNames::PLAYER_ONE, Tribe::CELTIC);
+
+	auto& townSystem = Locator::townSystem::value();
+	ASSERT_EQ(townSystem.FindClosestTown(point), closest);
+	ASSERT_EQ(townSystem.FindClosestTown(glm::vec3(1000.0f, 0.0f, 1290.0f)), alongX);
+	ASSERT_EQ(townSystem.FindClosestTown(glm::vec3(0.0f)), origin);
+	ASSERT_EQ(townSystem.FindClosestTown(glm::vec3(2900.0f, 0.0f, 0.0f)), east);
+}